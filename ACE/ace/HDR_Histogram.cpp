@@ -0,0 +1,437 @@
+#include "ace/HDR_Histogram.h"
+
+#if !defined (__ACE_INLINE__)
+#include "ace/HDR_Histogram.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Log_Category.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_string.h"
+
+#if defined (ACE_HAS_ALLOC_HOOKS)
+# include "ace/Malloc_Base.h"
+#endif /* ACE_HAS_ALLOC_HOOKS */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// First bytes of an encoded histogram, the second one is the
+  /// version of the format.
+  unsigned char const encoding_magic = 'H';
+  unsigned char const encoding_version = 1;
+
+  unsigned int const max_precision = 16;
+
+  /// Writes unsigned LEB128 integers, counting the bytes even when
+  /// there is no room left for them.
+  class Encoder
+  {
+  public:
+    Encoder (char *buffer, size_t length)
+      : buffer_ (buffer)
+      , length_ (buffer == 0 ? 0 : length)
+      , size_ (0)
+    {
+    }
+
+    void write (ACE_UINT64 value)
+    {
+      do
+        {
+          unsigned char byte = static_cast<unsigned char> (value & 0x7f);
+          value >>= 7;
+          if (value != 0)
+            byte |= 0x80;
+          if (this->size_ < this->length_)
+            this->buffer_[this->size_] = static_cast<char> (byte);
+          ++this->size_;
+        }
+      while (value != 0);
+    }
+
+    size_t size () const
+    {
+      return this->size_;
+    }
+
+  private:
+    char *buffer_;
+    size_t length_;
+    size_t size_;
+  };
+
+  /// Reads what Encoder writes.
+  class Decoder
+  {
+  public:
+    Decoder (const char *buffer, size_t length)
+      : buffer_ (buffer)
+      , length_ (buffer == 0 ? 0 : length)
+      , offset_ (0)
+    {
+    }
+
+    bool read (ACE_UINT64 &value)
+    {
+      value = 0;
+      for (unsigned int shift = 0; shift < 64; shift += 7)
+        {
+          if (this->offset_ == this->length_)
+            return false;
+
+          unsigned char const byte =
+            static_cast<unsigned char> (this->buffer_[this->offset_++]);
+          value |= static_cast<ACE_UINT64> (byte & 0x7f) << shift;
+          if ((byte & 0x80) == 0)
+            return true;
+        }
+      return false;
+    }
+
+    bool at_end () const
+    {
+      return this->offset_ == this->length_;
+    }
+
+  private:
+    const char *buffer_;
+    size_t length_;
+    size_t offset_;
+  };
+}
+
+ACE_HDR_Histogram::ACE_HDR_Histogram (unsigned int precision,
+                                      ACE_UINT64 highest_value)
+  : precision_ (precision < 1 ? 1
+                : precision > max_precision ? max_precision
+                : precision)
+  , highest_value_ (highest_value)
+  , buckets_ (index_of (highest_value, precision_) + 1)
+  , counts_ (0)
+  , samples_count_ (0)
+  , min_ (0)
+  , max_ (0)
+  , sum_ (0)
+{
+#if defined (ACE_HAS_ALLOC_HOOKS)
+  ACE_ALLOCATOR (this->counts_, static_cast<ACE_UINT64*>(ACE_Allocator::instance()->malloc(sizeof(ACE_UINT64) * this->buckets_)));
+#else
+  ACE_NEW (this->counts_, ACE_UINT64[this->buckets_]);
+#endif /* ACE_HAS_ALLOC_HOOKS */
+
+  if (this->counts_ != 0)
+    ACE_OS::memset (this->counts_, 0, sizeof (ACE_UINT64) * this->buckets_);
+}
+
+ACE_HDR_Histogram::~ACE_HDR_Histogram ()
+{
+#if defined (ACE_HAS_ALLOC_HOOKS)
+  ACE_Allocator::instance()->free(this->counts_);
+#else
+  delete[] this->counts_;
+#endif /* ACE_HAS_ALLOC_HOOKS */
+}
+
+ACE_UINT64
+ACE_HDR_Histogram::bucket_lowest (size_t index, unsigned int precision)
+{
+  size_t const top = index >> precision;
+  if (top < 2)
+    return index;
+
+  // Undo index_of(): the bucket holds the values whose bits above
+  // the shift are the low bits of the index.
+  unsigned int const shift = static_cast<unsigned int> (top - 1);
+  ACE_UINT64 const bits =
+    index - (static_cast<size_t> (shift) << precision);
+  return bits << shift;
+}
+
+ACE_UINT64
+ACE_HDR_Histogram::bucket_highest (size_t index, unsigned int precision)
+{
+  size_t const top = index >> precision;
+  if (top < 2)
+    return index;
+
+  unsigned int const shift = static_cast<unsigned int> (top - 1);
+  return bucket_lowest (index, precision)
+    + ((static_cast<ACE_UINT64> (1) << shift) - 1);
+}
+
+void
+ACE_HDR_Histogram::sample (ACE_UINT64 value, ACE_UINT64 count)
+{
+  if (count == 0)
+    return;
+
+  this->add (value, count);
+
+  if (this->samples_count_ == 0 || value < this->min_)
+    this->min_ = value;
+  if (value > this->max_)
+    this->max_ = value;
+  this->samples_count_ += count;
+  this->sum_ += value * count;
+}
+
+void
+ACE_HDR_Histogram::accumulate (const ACE_HDR_Histogram &rhs)
+{
+  if (rhs.samples_count_ == 0)
+    return;
+
+  // The largest value of a bucket falls in the bucket of the same
+  // values at this precision, or in a wider one that contains it, so
+  // the percentiles stay upper bounds.
+  for (size_t i = 0; i != rhs.buckets_; ++i)
+    {
+      if (rhs.counts_[i] == 0)
+        continue;
+
+      ACE_UINT64 const value = bucket_highest (i, rhs.precision_);
+      this->add (value < rhs.max_ ? value : rhs.max_, rhs.counts_[i]);
+    }
+
+  if (this->samples_count_ == 0 || rhs.min_ < this->min_)
+    this->min_ = rhs.min_;
+  if (rhs.max_ > this->max_)
+    this->max_ = rhs.max_;
+  this->samples_count_ += rhs.samples_count_;
+  this->sum_ += rhs.sum_;
+}
+
+void
+ACE_HDR_Histogram::reset ()
+{
+  ACE_OS::memset (this->counts_, 0, sizeof (ACE_UINT64) * this->buckets_);
+  this->samples_count_ = 0;
+  this->min_ = 0;
+  this->max_ = 0;
+  this->sum_ = 0;
+}
+
+double
+ACE_HDR_Histogram::mean () const
+{
+  if (this->samples_count_ == 0)
+    return 0.0;
+
+  return static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (this->sum_))
+    / static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (this->samples_count_));
+}
+
+ACE_UINT64
+ACE_HDR_Histogram::percentile (double percent) const
+{
+  if (this->samples_count_ == 0)
+    return 0;
+
+  // The rank of the sample, counting from 1, as when the samples are
+  // sorted.
+  double const count =
+    static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (this->samples_count_));
+  double const exact = percent * count / 100.0;
+  ACE_UINT64 rank = static_cast<ACE_UINT64> (exact);
+  if (static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (rank)) < exact)
+    ++rank;
+  if (rank == 0)
+    rank = 1;
+  if (rank > this->samples_count_)
+    rank = this->samples_count_;
+
+  ACE_UINT64 seen = 0;
+  for (size_t i = 0; i != this->buckets_; ++i)
+    {
+      seen += this->counts_[i];
+      if (seen >= rank)
+        {
+          ACE_UINT64 const value = bucket_highest (i, this->precision_);
+          return i + 1 == this->buckets_ || value > this->max_
+            ? this->max_
+            : value;
+        }
+    }
+
+  return this->max_;
+}
+
+void
+ACE_HDR_Histogram::dump_results (
+    const ACE_TCHAR *msg,
+    ACE_HDR_Histogram::scale_factor_type sf) const
+{
+#ifndef ACE_NLOGGING
+  if (this->samples_count_ == 0)
+    {
+      ACELIB_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%s : no data collected\n"), msg));
+      return;
+    }
+
+  double const scale = static_cast<double> (sf);
+
+  ACELIB_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%s latency   : %.2f/%.2f/%.2f (min/avg/max)\n"),
+              msg,
+              static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (this->min_)) / scale,
+              this->mean () / scale,
+              static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (this->max_)) / scale));
+
+  static double const percentiles[] = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+  for (size_t i = 0; i != sizeof percentiles / sizeof percentiles[0]; ++i)
+    {
+      ACE_UINT64 const value = this->percentile (percentiles[i]);
+      ACELIB_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%s latency p%.2f: %.2f\n"),
+                  msg,
+                  percentiles[i],
+                  static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (value)) / scale));
+    }
+#else
+  ACE_UNUSED_ARG (msg);
+  ACE_UNUSED_ARG (sf);
+#endif /* ACE_NLOGGING */
+}
+
+void
+ACE_HDR_Histogram::dump_buckets (
+    const ACE_TCHAR *msg,
+    ACE_HDR_Histogram::scale_factor_type sf) const
+{
+#ifndef ACE_NLOGGING
+  double const scale = static_cast<double> (sf);
+
+  for (size_t i = 0; i != this->buckets_; ++i)
+    {
+      if (this->counts_[i] == 0)
+        continue;
+
+      ACE_UINT64 const value = bucket_highest (i, this->precision_);
+      ACELIB_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("%s: %.2f\t%Q\n"),
+                  msg,
+                  static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (value)) / scale,
+                  this->counts_[i]));
+    }
+#else
+  ACE_UNUSED_ARG (msg);
+  ACE_UNUSED_ARG (sf);
+#endif /* ACE_NLOGGING */
+}
+
+size_t
+ACE_HDR_Histogram::encode (char *buffer, size_t length) const
+{
+  Encoder encoder (buffer, length);
+
+  encoder.write (encoding_magic);
+  encoder.write (encoding_version);
+  encoder.write (this->precision_);
+  encoder.write (this->highest_value_);
+  encoder.write (this->samples_count_);
+  encoder.write (this->min_);
+  encoder.write (this->max_);
+  encoder.write (this->sum_);
+
+  ACE_UINT64 used = 0;
+  for (size_t i = 0; i != this->buckets_; ++i)
+    {
+      if (this->counts_[i] != 0)
+        ++used;
+    }
+  encoder.write (used);
+
+  // Each used bucket as the number of empty buckets before it and
+  // its count.
+  size_t next = 0;
+  for (size_t i = 0; i != this->buckets_; ++i)
+    {
+      if (this->counts_[i] == 0)
+        continue;
+
+      encoder.write (i - next);
+      encoder.write (this->counts_[i]);
+      next = i + 1;
+    }
+
+  return encoder.size ();
+}
+
+int
+ACE_HDR_Histogram::decode (const char *buffer, size_t length)
+{
+  // Check the whole encoding before adding anything, so a bad one
+  // leaves the histogram alone.
+  for (int pass = 0; pass != 2; ++pass)
+    {
+      Decoder decoder (buffer, length);
+
+      ACE_UINT64 magic = 0;
+      ACE_UINT64 version = 0;
+      ACE_UINT64 precision = 0;
+      ACE_UINT64 highest_value = 0;
+      ACE_UINT64 samples_count = 0;
+      ACE_UINT64 min = 0;
+      ACE_UINT64 max = 0;
+      ACE_UINT64 sum = 0;
+      ACE_UINT64 used = 0;
+
+      if (!decoder.read (magic) || magic != encoding_magic
+          || !decoder.read (version) || version != encoding_version
+          || !decoder.read (precision)
+          || precision < 1 || precision > max_precision
+          || !decoder.read (highest_value)
+          || !decoder.read (samples_count)
+          || !decoder.read (min)
+          || !decoder.read (max)
+          || !decoder.read (sum)
+          || !decoder.read (used))
+        return -1;
+
+      unsigned int const p = static_cast<unsigned int> (precision);
+      ACE_UINT64 const buckets = index_of (highest_value, p) + 1;
+
+      ACE_UINT64 index = 0;
+      ACE_UINT64 total = 0;
+      for (ACE_UINT64 i = 0; i != used; ++i)
+        {
+          ACE_UINT64 gap = 0;
+          ACE_UINT64 count = 0;
+          if (!decoder.read (gap) || !decoder.read (count)
+              || gap >= buckets - index || count == 0)
+            return -1;
+
+          index += gap;
+          total += count;
+
+          if (pass == 1)
+            {
+              ACE_UINT64 const value =
+                bucket_highest (static_cast<size_t> (index), p);
+              this->add (value < max ? value : max, count);
+            }
+
+          ++index;
+        }
+
+      if (!decoder.at_end () || total != samples_count
+          || (samples_count != 0 && min > max))
+        return -1;
+
+      if (pass == 1 && samples_count != 0)
+        {
+          if (this->samples_count_ == 0 || min < this->min_)
+            this->min_ = min;
+          if (max > this->max_)
+            this->max_ = max;
+          this->samples_count_ += samples_count;
+          this->sum_ += sum;
+        }
+    }
+
+  return 0;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,184 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    HDR_Histogram.h
+ *
+ *  Log-linear histogram of samples, with bounded relative error and
+ *  constant space.
+ */
+//=============================================================================
+
+#ifndef ACE_HDR_HISTOGRAM_H
+#define ACE_HDR_HISTOGRAM_H
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/config-all.h"
+#include "ace/Basic_Types.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/// Count samples in log-linear buckets to report their percentiles
+/**
+ * The values below 2^(precision + 1) are counted exactly.  Above
+ * that, each power of two is split in 2^precision buckets of equal
+ * width, so a value is known to within 2^-precision of itself: the
+ * default precision of 7 keeps percentiles within 0.8% of the exact
+ * sample, in about 60KB for the whole 64-bit range.  Space does not
+ * grow with the number of samples, and recording one is a few shifts
+ * and an increment.
+ *
+ * Like ACE_Basic_Stats the histogram does no locking.  Give every
+ * thread its own histogram and accumulate() them when the threads
+ * are done, or encode() them in one process and decode() them in
+ * another.
+ */
+class ACE_Export ACE_HDR_Histogram
+{
+public:
+#if !defined (ACE_WIN32)
+   typedef ACE_UINT32 scale_factor_type;
+#else
+   typedef ACE_UINT64 scale_factor_type;
+#endif
+
+  /// Constructor
+  /**
+   * @param precision Number of bits of the values kept, between 1
+   *        and 16.  The percentiles are within 2^-precision of the
+   *        samples.
+   * @param highest_value The largest value the histogram tells apart.
+   *        Larger samples are counted with it, although max() still
+   *        reports them exactly.  Lower it to save space.
+   */
+  ACE_HDR_Histogram (unsigned int precision = 7,
+                     ACE_UINT64 highest_value = ~static_cast<ACE_UINT64> (0));
+
+  /// Destructor
+  ~ACE_HDR_Histogram ();
+
+  /// Record one sample.
+  void sample (ACE_UINT64 value);
+
+  /// Record @a count samples of @a value.
+  void sample (ACE_UINT64 value, ACE_UINT64 count);
+
+  /// Add the samples counted by @a rhs, which may have a different
+  /// precision.
+  void accumulate (const ACE_HDR_Histogram &rhs);
+
+  /// Forget all the samples.
+  void reset ();
+
+  /// The number of samples received so far
+  ACE_UINT64 samples_count () const;
+
+  /// The smallest and largest samples, exactly
+  //@{
+  ACE_UINT64 min () const;
+  ACE_UINT64 max () const;
+  //@}
+
+  /// The average of the samples
+  double mean () const;
+
+  /// The value at or below which @a percent of the samples fall
+  /**
+   * Returns a value between the exact sample at that rank and
+   * 2^-precision above it, or 0 when there are no samples.
+   */
+  ACE_UINT64 percentile (double percent) const;
+
+  unsigned int precision () const;
+
+  ACE_UINT64 highest_value () const;
+
+  /// Dump the percentiles
+  /**
+   * Prints out the minimum, average and maximum of the samples and
+   * their 50th, 90th, 99th, 99.9th and 99.99th percentiles, using
+   * @a msg as a prefix for each message and scaling all the numbers
+   * by @a scale_factor.
+   */
+  void dump_results (const ACE_TCHAR *msg,
+                     scale_factor_type scale_factor) const;
+
+  /// Dump the buckets
+  /**
+   * Prints out the value and count of every bucket that counted a
+   * sample, scaled as in dump_results(), to plot the distribution.
+   */
+  void dump_buckets (const ACE_TCHAR *msg,
+                     scale_factor_type scale_factor) const;
+
+  /// Write the histogram in a compact, portable format
+  /**
+   * Only the buckets that counted samples are written, as variable
+   * length integers.  Returns the number of bytes the encoding takes,
+   * and only writes to @a buffer if @a length is at least that much,
+   * so calling it with a null @a buffer returns the size to allocate.
+   */
+  size_t encode (char *buffer, size_t length) const;
+
+  /// Add the samples of a histogram written by encode()
+  /**
+   * Returns 0 on success, -1 if @a buffer does not hold a valid
+   * encoding, in which case nothing is added.
+   */
+  int decode (const char *buffer, size_t length);
+
+private:
+  ACE_HDR_Histogram (const ACE_HDR_Histogram &) = delete;
+  ACE_HDR_Histogram &operator= (const ACE_HDR_Histogram &) = delete;
+
+  /// The bucket @a value is counted in, at @a precision.
+  static size_t index_of (ACE_UINT64 value, unsigned int precision);
+
+  /// The smallest and largest value counted in bucket @a index, at
+  /// @a precision.
+  //@{
+  static ACE_UINT64 bucket_lowest (size_t index, unsigned int precision);
+  static ACE_UINT64 bucket_highest (size_t index, unsigned int precision);
+  //@}
+
+  /// Count @a count samples in the bucket of @a value, without
+  /// updating the totals.
+  void add (ACE_UINT64 value, ACE_UINT64 count);
+
+  /// Number of bits kept of the values
+  unsigned int precision_;
+
+  /// The largest value told apart
+  ACE_UINT64 highest_value_;
+
+  /// The number of buckets
+  size_t buckets_;
+
+  /// The count of samples in each bucket
+  ACE_UINT64 *counts_;
+
+  /// The number of samples
+  ACE_UINT64 samples_count_;
+
+  /// The minimum value
+  ACE_UINT64 min_;
+
+  /// The maximum value
+  ACE_UINT64 max_;
+
+  /// The sum of all the values
+  ACE_UINT64 sum_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/HDR_Histogram.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+#endif /* ACE_HDR_HISTOGRAM_H */
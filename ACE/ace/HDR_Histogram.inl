@@ -0,0 +1,73 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE size_t
+ACE_HDR_Histogram::index_of (ACE_UINT64 value, unsigned int precision)
+{
+  // Position of the highest bit set.
+  unsigned int msb = 0;
+  for (unsigned int shift = 32; shift != 0; shift >>= 1)
+    {
+      if ((value >> msb) >= (static_cast<ACE_UINT64> (1) << shift))
+        msb += shift;
+    }
+
+  // The values with no more bits than the precision, plus one, are
+  // their own bucket.  Larger ones drop the bits below the precision.
+  unsigned int const shift = msb > precision ? msb - precision : 0;
+  return (static_cast<size_t> (shift) << precision)
+    + static_cast<size_t> (value >> shift);
+}
+
+ACE_INLINE void
+ACE_HDR_Histogram::add (ACE_UINT64 value, ACE_UINT64 count)
+{
+  size_t const index = value < this->highest_value_
+    ? index_of (value, this->precision_)
+    : this->buckets_ - 1;
+  this->counts_[index] += count;
+}
+
+ACE_INLINE void
+ACE_HDR_Histogram::sample (ACE_UINT64 value)
+{
+  this->add (value, 1);
+
+  if (this->samples_count_++ == 0 || value < this->min_)
+    this->min_ = value;
+  if (value > this->max_)
+    this->max_ = value;
+  this->sum_ += value;
+}
+
+ACE_INLINE ACE_UINT64
+ACE_HDR_Histogram::samples_count () const
+{
+  return this->samples_count_;
+}
+
+ACE_INLINE ACE_UINT64
+ACE_HDR_Histogram::min () const
+{
+  return this->min_;
+}
+
+ACE_INLINE ACE_UINT64
+ACE_HDR_Histogram::max () const
+{
+  return this->max_;
+}
+
+ACE_INLINE unsigned int
+ACE_HDR_Histogram::precision () const
+{
+  return this->precision_;
+}
+
+ACE_INLINE ACE_UINT64
+ACE_HDR_Histogram::highest_value () const
+{
+  return this->highest_value_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
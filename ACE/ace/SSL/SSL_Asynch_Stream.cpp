@@ -1,4 +1,5 @@
 #include "SSL_Asynch_Stream.h"
+#include "sslconf.h"
 
 // This only works on platforms with Asynchronous IO support.
 #if OPENSSL_VERSION_NUMBER > 0x0090581fL && (defined (ACE_WIN32) || (defined (ACE_HAS_AIO_CALLS)))
@@ -12,6 +13,7 @@
 #include "ace/OS_NS_string.h"
 #include "ace/Proactor.h"
 #include "ace/Truncate.h"
+#include "ace/Min_Max.h"
 
 #if !defined(__ACE_INLINE__)
 #include "SSL_Asynch_Stream.inl"
@@ -19,6 +21,8 @@
 
 #include <openssl/err.h>
 
+#include <utility>
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 ACE_SSL_Asynch_Write_Stream_Result::ACE_SSL_Asynch_Write_Stream_Result
@@ -29,7 +33,8 @@ ACE_SSL_Asynch_Write_Stream_Result::ACE_SSL_Asynch_Write_Stream_Result
    const void *        act,
    ACE_HANDLE          event,
    int                 priority,
-   int                 signal_number
+   int                 signal_number,
+   bool                chain
  )
   : AWS_RESULT (handler.proxy (),
                 handle,
@@ -39,8 +44,43 @@ ACE_SSL_Asynch_Write_Stream_Result::ACE_SSL_Asynch_Write_Stream_Result
                 event,
                 priority,
                 signal_number
-                )
+                ),
+    chain_ (chain)
+{
+}
+
+void
+ACE_SSL_Asynch_Write_Stream_Result::complete (size_t bytes_transferred,
+                                              int success,
+                                              const void *completion_key,
+                                              u_long error)
 {
+  // The base class moves the read pointer of the first block by all
+  // the bytes transferred.  Move those of the continuation blocks
+  // here and take back from the first block what they account for.
+  if (this->chain_)
+    {
+      ACE_Message_Block & first = this->message_block ();
+      size_t const first_len = first.length ();
+
+      if (bytes_transferred > first_len)
+        {
+          size_t left = bytes_transferred - first_len;
+
+          for (ACE_Message_Block * mb = first.cont ();
+               mb != 0 && left > 0;
+               mb = mb->cont ())
+            {
+              size_t const part = ACE_MIN (mb->length (), left);
+              mb->rd_ptr (part);
+              left -= part;
+            }
+
+          first.rd_ptr (-static_cast<ssize_t> (bytes_transferred - first_len));
+        }
+    }
+
+  AWS_RESULT::complete (bytes_transferred, success, completion_key, error);
 }
 
 ACE_SSL_Asynch_Read_Stream_Result::ACE_SSL_Asynch_Read_Stream_Result
@@ -51,7 +91,8 @@ ACE_SSL_Asynch_Read_Stream_Result::ACE_SSL_Asynch_Read_Stream_Result
    const void *         act,
    ACE_HANDLE           event,
    int                  priority,
-   int                  signal_number
+   int                  signal_number,
+   bool                 chain
  )
   : ARS_RESULT (handler.proxy (),
                 handle,
@@ -61,10 +102,45 @@ ACE_SSL_Asynch_Read_Stream_Result::ACE_SSL_Asynch_Read_Stream_Result
                 event,
                 priority,
                 signal_number
-                )
+                ),
+    chain_ (chain)
 {
 }
 
+void
+ACE_SSL_Asynch_Read_Stream_Result::complete (size_t bytes_transferred,
+                                             int success,
+                                             const void *completion_key,
+                                             u_long error)
+{
+  // The base class moves the write pointer of the first block by all
+  // the bytes transferred.  Move those of the continuation blocks
+  // here and take back from the first block what they account for.
+  if (this->chain_)
+    {
+      ACE_Message_Block & first = this->message_block ();
+      size_t const first_space = first.space ();
+
+      if (bytes_transferred > first_space)
+        {
+          size_t left = bytes_transferred - first_space;
+
+          for (ACE_Message_Block * mb = first.cont ();
+               mb != 0 && left > 0;
+               mb = mb->cont ())
+            {
+              size_t const part = ACE_MIN (mb->space (), left);
+              mb->wr_ptr (part);
+              left -= part;
+            }
+
+          first.wr_ptr (-static_cast<ssize_t> (bytes_transferred - first_space));
+        }
+    }
+
+  ARS_RESULT::complete (bytes_transferred, success, completion_key, error);
+}
+
 ACE_SSL_Asynch_Result::ACE_SSL_Asynch_Result (ACE_Handler & handler)
   : A_RESULT (handler.proxy (),
               0,          // act,
@@ -97,6 +173,7 @@ ACE_SSL_Asynch_Stream::ACE_SSL_Asynch_Stream (
     ext_handler_  (0),
     ext_read_result_ (0),
     ext_write_result_(0),
+    ext_write_done_(0),
     flags_        (0),
     ssl_          (0),
     handshake_complete_(false),
@@ -106,7 +183,8 @@ ACE_SSL_Asynch_Stream::ACE_SSL_Asynch_Stream (
     bio_inp_errno_(0),
     bio_inp_flag_ (0),
     bio_ostream_  (),
-    bio_out_msg_  (),
+    bio_out_msg_  (&this->bio_out_buffers_[0]),
+    bio_out_next_ (&this->bio_out_buffers_[1]),
     bio_out_errno_(0),
     bio_out_flag_ (0),
     mutex_ ()
@@ -285,6 +363,23 @@ ACE_SSL_Asynch_Stream::open (ACE_Handler & handler,
 
   ::SSL_set_bio (this->ssl_ , this->bio_ , this->bio_);
 
+  // Let SSL take all the records buffered from the socket at once, and
+  // return from SSL_write() as soon as one record of a large write is
+  // done so the next one can be gathered while the first is written.
+  ::SSL_set_read_ahead (this->ssl_, 1);
+  ::SSL_set_mode (this->ssl_,
+                  SSL_MODE_ENABLE_PARTIAL_WRITE
+                  | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+  if (this->bio_inp_msg_.size (ACE_SSL_ASYNCH_STREAM_BUFFER_SIZE) != 0
+      || this->bio_out_buffers_[0].size (ACE_SSL_ASYNCH_STREAM_BUFFER_SIZE) != 0
+      || this->bio_out_buffers_[1].size (ACE_SSL_ASYNCH_STREAM_BUFFER_SIZE) != 0)
+    ACELIB_ERROR_RETURN
+      ((LM_ERROR,
+        ACE_TEXT ("(%P|%t) ACE_SSL_Asynch_Stream::open() %p\n"),
+        ACE_TEXT ("- cannot allocate BIO buffers")),
+       -1);
+
   switch (this->type_)
     {
     case ST_CLIENT:
@@ -321,6 +416,37 @@ ACE_SSL_Asynch_Stream::read (ACE_Message_Block & message_block,
                              const void * act,
                              int priority,
                              int signal_number)
+{
+  return this->read_i (message_block,
+                       bytes_to_read,
+                       act,
+                       priority,
+                       signal_number,
+                       false);
+}
+
+int
+ACE_SSL_Asynch_Stream::readv (ACE_Message_Block & message_block,
+                              size_t bytes_to_read,
+                              const void * act,
+                              int priority,
+                              int signal_number)
+{
+  return this->read_i (message_block,
+                       bytes_to_read,
+                       act,
+                       priority,
+                       signal_number,
+                       true);
+}
+
+int
+ACE_SSL_Asynch_Stream::read_i (ACE_Message_Block & message_block,
+                               size_t bytes_to_read,
+                               const void * act,
+                               int priority,
+                               int signal_number,
+                               bool chain)
 {
   ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
 
@@ -346,7 +472,8 @@ ACE_SSL_Asynch_Stream::read (ACE_Message_Block & message_block,
                     act,
                     this->proactor_->get_handle(),
                     priority,
-                    signal_number),
+                    signal_number,
+                    chain),
                   -1);
 
   this->do_SSL_state_machine (); // ignore return code
@@ -364,6 +491,37 @@ ACE_SSL_Asynch_Stream::write (ACE_Message_Block & message_block,
                               const void * act,
                               int priority,
                               int signal_number)
+{
+  return this->write_i (message_block,
+                        bytes_to_write,
+                        act,
+                        priority,
+                        signal_number,
+                        false);
+}
+
+int
+ACE_SSL_Asynch_Stream::writev (ACE_Message_Block & message_block,
+                               size_t bytes_to_write,
+                               const void * act,
+                               int priority,
+                               int signal_number)
+{
+  return this->write_i (message_block,
+                        bytes_to_write,
+                        act,
+                        priority,
+                        signal_number,
+                        true);
+}
+
+int
+ACE_SSL_Asynch_Stream::write_i (ACE_Message_Block & message_block,
+                                size_t bytes_to_write,
+                                const void * act,
+                                int priority,
+                                int signal_number,
+                                bool chain)
 {
   ACE_MT (ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->mutex_, -1));
 
@@ -389,9 +547,12 @@ ACE_SSL_Asynch_Stream::write (ACE_Message_Block & message_block,
                     act,
                     this->proactor_->get_handle(),
                     priority,
-                    signal_number),
+                    signal_number,
+                    chain),
                   -1);
 
+  this->ext_write_done_ = 0;
+
   this->do_SSL_state_machine ();
 
   return 0;
@@ -556,7 +717,7 @@ ACE_SSL_Asynch_Stream::post_handshake_check ()
 }
 
 // ************************************************************
-// Perform SSL_read call if necessary and notify user
+// Perform SSL_read calls if necessary and notify user
 // ************************************************************
 int
 ACE_SSL_Asynch_Stream::do_SSL_read ()
@@ -572,22 +733,59 @@ ACE_SSL_Asynch_Stream::do_SSL_read ()
       return -1;
     }
 
-  ACE_Message_Block & mb = this->ext_read_result_->message_block ();
-  size_t bytes_req = this->ext_read_result_->bytes_to_read ();
+  // Decrypt as many of the buffered records as fit straight into the
+  // user's block(s).  The pointers of the blocks are left alone, the
+  // result moves them on completion.
+  ACE_Message_Block * mb = &this->ext_read_result_->message_block ();
+  size_t const bytes_req = this->ext_read_result_->bytes_to_read ();
+  bool const chain = this->ext_read_result_->chain_;
+
+  size_t bytes_done = 0;
+  size_t offset = 0;     // into the current block
+  int status = SSL_ERROR_NONE;
+  int bytes_trn = 0;
+
+  while (mb != 0 && bytes_done < bytes_req)
+    {
+      size_t const space =
+        chain ? mb->space () - offset : bytes_req - bytes_done;
+
+      if (space == 0)
+        {
+          mb = mb->cont ();
+          offset = 0;
+          continue;
+        }
+
+      ERR_clear_error ();
+
+      bytes_trn =
+        ::SSL_read (this->ssl_,
+                    mb->wr_ptr () + offset,
+                    ACE_Utils::truncate_cast<int> (ACE_MIN (space,
+                                                            bytes_req - bytes_done)));
+
+      status = ::SSL_get_error (this->ssl_, bytes_trn);
 
-  ERR_clear_error ();
+      if (status != SSL_ERROR_NONE)
+        break;
 
-  const int bytes_trn =
-    ::SSL_read (this->ssl_,
-                mb.wr_ptr (),
-                ACE_Utils::truncate_cast<int> (bytes_req));
+      bytes_done += bytes_trn;
+      offset += bytes_trn;
+    }
 
-  int const status = ::SSL_get_error (this->ssl_, bytes_trn);
+  // Deliver what was read, an error or end of stream shows on the
+  // next read.
+  if (bytes_done > 0)
+    {
+      this->notify_read (ACE_Utils::truncate_cast<int> (bytes_done), 0);
+      return 1;
+    }
 
   switch (status)
     {
     case SSL_ERROR_NONE:
-      this->notify_read (bytes_trn, 0);
+      this->notify_read (0, 0);
       return 1;
 
     case SSL_ERROR_WANT_READ:
@@ -618,7 +816,7 @@ ACE_SSL_Asynch_Stream::do_SSL_read ()
 }
 
 // ************************************************************
-// Perform SSL_write call if necessary  and notify user
+// Perform SSL_write calls if necessary and notify user
 // ************************************************************
 int
 ACE_SSL_Asynch_Stream::do_SSL_write ()
@@ -634,22 +832,58 @@ ACE_SSL_Asynch_Stream::do_SSL_write ()
       return -1;
     }
 
-  ACE_Message_Block & mb = this->ext_write_result_->message_block ();
-  size_t       bytes_req = this->ext_write_result_->bytes_to_write ();
+  // Encrypt straight from the user's block(s), one record per
+  // SSL_write() call.  What was passed to SSL so far survives the
+  // calls that have to wait for the socket in <ext_write_done_>.
+  ACE_Message_Block * mb = &this->ext_write_result_->message_block ();
+  size_t const bytes_req = this->ext_write_result_->bytes_to_write ();
+  bool const chain = this->ext_write_result_->chain_;
+
+  size_t skip = this->ext_write_done_;
+
+  if (chain)
+    while (mb != 0 && skip >= mb->length ())
+      {
+        skip -= mb->length ();
+        mb = mb->cont ();
+      }
+
+  int status = SSL_ERROR_NONE;
+
+  while (mb != 0 && this->ext_write_done_ < bytes_req)
+    {
+      size_t const avail =
+        chain ? mb->length () - skip : bytes_req - this->ext_write_done_;
+
+      if (avail == 0)
+        {
+          mb = mb->cont ();
+          skip = 0;
+          continue;
+        }
+
+      ERR_clear_error ();
+
+      int const bytes_trn =
+        ::SSL_write (this->ssl_,
+                     mb->rd_ptr () + skip,
+                     ACE_Utils::truncate_cast<int> (
+                       ACE_MIN (avail, bytes_req - this->ext_write_done_)));
 
-  ERR_clear_error ();
+      status = ::SSL_get_error (this->ssl_, bytes_trn);
 
-  const int bytes_trn =
-    ::SSL_write (this->ssl_,
-                 mb.rd_ptr (),
-                 ACE_Utils::truncate_cast<int> (bytes_req));
+      if (status != SSL_ERROR_NONE)
+        break;
 
-  int const status = ::SSL_get_error (this->ssl_, bytes_trn);
+      this->ext_write_done_ += bytes_trn;
+      skip += bytes_trn;
+    }
 
   switch (status)
     {
     case SSL_ERROR_NONE:
-      this->notify_write (bytes_trn, 0);
+      this->notify_write (
+        ACE_Utils::truncate_cast<int> (this->ext_write_done_), 0);
       return 1;
 
     case SSL_ERROR_WANT_READ:
@@ -657,7 +891,8 @@ ACE_SSL_Asynch_Stream::do_SSL_write ()
       return 0;
 
     case SSL_ERROR_ZERO_RETURN:
-      this->notify_write (bytes_trn, 0);
+      this->notify_write (
+        ACE_Utils::truncate_cast<int> (this->ext_write_done_), 0);
       return 1;
 
     case SSL_ERROR_SYSCALL:
@@ -852,7 +1087,10 @@ ACE_SSL_Asynch_Stream::ssl_bio_read (char * buf,
       return -1;
     }
 
-  if (this->bio_inp_msg_.size (len) != 0)
+  // Read whatever the peer has sent, up to the whole buffer, rather
+  // than just the <len> bytes SSL asked for.
+  if (this->bio_inp_msg_.size () < len
+      && this->bio_inp_msg_.size (len) != 0)
     {
       ACELIB_ERROR
         ((LM_ERROR,
@@ -864,17 +1102,14 @@ ACE_SSL_Asynch_Stream::ssl_bio_read (char * buf,
       return -1;
     }
 
-  char * base = this->bio_inp_msg_.base ();
-
-  this->bio_inp_msg_.rd_ptr (base);
-  this->bio_inp_msg_.wr_ptr (base);
+  this->bio_inp_msg_.reset ();
 
   if (this->bio_istream_.read (
-        bio_inp_msg_,  // message block
-        len,           // priority
-        0,             // act
-        0,             // priority
-        ACE_SIGRTMIN   // default signal
+        bio_inp_msg_,                 // message block
+        this->bio_inp_msg_.space (),  // bytes to read
+        0,                            // act
+        0,                            // priority
+        ACE_SIGRTMIN                  // default signal
         ) == -1)
     {
       ACELIB_ERROR
@@ -904,54 +1139,70 @@ ACE_SSL_Asynch_Stream::ssl_bio_write (const char * buf,
 
   errval = 0;
 
-  if (this->bio_out_flag_ & BF_AIO)  // sorry, we are busy
-    {
-      errval = EINPROGRESS;   // try later
-      return -1;
-    }
-
   if (this->bio_out_errno_ != 0)      // no recovery
     {
       errval = this->bio_out_errno_;
       return -1;
     }
 
-  if (this->bio_out_msg_.size (len) != 0)
+  // Gather the records in <bio_out_next_> while a write is in
+  // progress; they go out together when it completes.
+  ACE_Message_Block * const next = this->bio_out_next_;
+
+  if (next->length () == 0)
     {
-      ACELIB_ERROR
-        ((LM_ERROR,
-          ACE_TEXT ("%N:%l ((%P|%t) ACE_SSL_Asynch_Stream %p\n"),
-          ACE_TEXT ("error in ACE_Message_Block::size() ")
-          ));
+      next->reset ();
 
-      errval = EINVAL;
-      return -1;
+      if (next->space () < len && next->size (len) != 0)
+        {
+          ACELIB_ERROR
+            ((LM_ERROR,
+              ACE_TEXT ("%N:%l ((%P|%t) ACE_SSL_Asynch_Stream %p\n"),
+              ACE_TEXT ("error in ACE_Message_Block::size() ")
+              ));
+
+          errval = EINVAL;
+          return -1;
+        }
     }
 
-  char * base = this->bio_out_msg_.base ();
-
-  this->bio_out_msg_.rd_ptr (base);
-  this->bio_out_msg_.wr_ptr (base);
+  size_t const n = ACE_MIN (next->space (), len);
 
-  if (this->bio_out_msg_.copy (buf, len) == -1)
+  if (n == 0)                         // sorry, we are full
     {
-      ACELIB_ERROR
-        ((LM_ERROR,
-          ACE_TEXT ("%N:%l ((%P|%t) ACE_SSL_Asynch_Stream %p\n"),
-          ACE_TEXT ("error in ACE_Message_Block::copy() ")
-          ));
+      errval = EINPROGRESS;           // try later
+      return -1;
+    }
 
-      errval = EINVAL;
+  next->copy (buf, n);
+
+  if (this->start_bio_write () == -1)
+    {
+      errval = this->bio_out_errno_;
       return -1;
     }
 
+  return ACE_Utils::truncate_cast<int> (n);
+}
+
+int
+ACE_SSL_Asynch_Stream::start_bio_write ()
+{
+  if (this->bio_out_flag_ & BF_AIO)   // the next batch waits for it
+    return 0;
+
+  if (this->bio_out_next_->length () == 0)
+    return 0;
+
+  std::swap (this->bio_out_msg_, this->bio_out_next_);
+  this->bio_out_next_->reset ();
 
   if (this->bio_ostream_.write (
-        this->bio_out_msg_, // message block
-        len,          // priority
-        0,            // act
-        0,            // priority
-        ACE_SIGRTMIN  // default signal
+        *this->bio_out_msg_,           // message block
+        this->bio_out_msg_->length (), // bytes to write
+        0,                             // act
+        0,                             // priority
+        ACE_SIGRTMIN                   // default signal
         ) == -1)
     {
       ACELIB_ERROR
@@ -960,14 +1211,13 @@ ACE_SSL_Asynch_Stream::ssl_bio_write (const char * buf,
           ACE_TEXT ("attempt write failed")
           ));
 
-      errval = EINVAL;  // may be leave EINPROGRESS ??
-      return -1;        // to try later
+      this->bio_out_errno_ = EINVAL;
+      return -1;
     }
 
   this->bio_out_flag_ |= BF_AIO;  // AIO is active
-  errval = 0;               // Ok, go ahead
 
-  return ACE_Utils::truncate_cast<int> (len);
+  return 0;
 }
 
 // ************************************************************
@@ -1013,6 +1263,8 @@ ACE_SSL_Asynch_Stream::handle_write_stream (
 
       this->bio_out_errno_ = EINVAL;
     }
+  else
+    this->start_bio_write ();         // records gathered meanwhile
 
   this->do_SSL_state_machine ();
 
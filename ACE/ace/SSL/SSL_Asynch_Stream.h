@@ -73,6 +73,13 @@ class ACE_SSL_Asynch_Read_Stream_Result : public ARS_RESULT
   /// Factory class will have special permissions.
   friend class ACE_SSL_Asynch_Stream;
 
+public:
+  /// Move the write pointers of the blocks that received data.
+  virtual void complete (size_t bytes_transferred,
+                         int success,
+                         const void *completion_key,
+                         u_long error);
+
 protected:
   ACE_SSL_Asynch_Read_Stream_Result (ACE_Handler &handler,
                                      ACE_HANDLE handle,
@@ -81,7 +88,12 @@ protected:
                                      const void* act,
                                      ACE_HANDLE event,
                                      int priority,
-                                     int signal_number);
+                                     int signal_number,
+                                     bool chain = false);
+
+  /// Data is read into the continuation blocks of the message block
+  /// as well.
+  bool chain_;
 };
 
 /**
@@ -95,6 +107,13 @@ class ACE_SSL_Asynch_Write_Stream_Result : public AWS_RESULT
   /// Factory class will have special permissions.
   friend class ACE_SSL_Asynch_Stream;
 
+public:
+  /// Move the read pointers of the blocks whose data was sent.
+  virtual void complete (size_t bytes_transferred,
+                         int success,
+                         const void *completion_key,
+                         u_long error);
+
 protected:
   ACE_SSL_Asynch_Write_Stream_Result (ACE_Handler &handler,
                                       ACE_HANDLE handle,
@@ -103,7 +122,12 @@ protected:
                                       const void* act,
                                       ACE_HANDLE event,
                                       int priority,
-                                      int signal_number);
+                                      int signal_number,
+                                      bool chain = false);
+
+  /// Data is taken from the continuation blocks of the message block
+  /// as well.
+  bool chain_;
 };
 
 
@@ -138,6 +162,13 @@ struct ACE_SSL_Asynch_Stream_Accessor;
  * can be started using this class.  The handler object (derived from
  * ACE_Handler) specified in open() will receive completion events for the
  * operations initiated via this class.
+ *
+ * The records are decrypted straight into, and encrypted straight
+ * from, the message blocks of the user's operations, as many per
+ * operation as they hold.  Underneath, every read of the socket takes
+ * all the records that arrived, up to ACE_SSL_ASYNCH_STREAM_BUFFER_SIZE
+ * bytes, and the records produced while a write of the socket is in
+ * progress are gathered and written together once it completes.
  */
 class ACE_SSL_Export ACE_SSL_Asynch_Stream
   : public ACE_Asynch_Operation,
@@ -273,6 +304,31 @@ public:
              int priority = 0,
              int signal_number = ACE_SIGRTMIN);
 
+  /**
+   * Same as read(), but the data is read into the chain of message
+   * blocks starting with @a message_block, each filled up to its
+   * end before the next one (see ACE_Message_Block::cont()).  The
+   * write pointers of all the blocks that received data are updated
+   * when the operation completes.
+   */
+  int readv (ACE_Message_Block &message_block,
+             size_t num_bytes_to_read,
+             const void *act = 0,
+             int priority = 0,
+             int signal_number = ACE_SIGRTMIN);
+
+  /**
+   * Same as write(), but the data is taken from the chain of message
+   * blocks starting with @a message_block.  The operation completes
+   * once all @a bytes_to_write bytes are passed to the SSL session,
+   * and the read pointers of all the blocks sent are updated.
+   */
+  int writev (ACE_Message_Block &message_block,
+              size_t bytes_to_write,
+              const void *act = 0,
+              int priority = 0,
+              int signal_number = ACE_SIGRTMIN);
+
 protected:
   /// Virtual from ACE_Asynch_Operation. Since this class is essentially an
   /// implementation class, simply return 0.
@@ -365,6 +421,25 @@ protected:
   int ssl_bio_write (const char * buf, size_t len, int & errval);
   //@}
 
+  /// Start writing the records gathered in <bio_out_next_>.
+  int start_bio_write ();
+
+  /// Common part of read() and readv().
+  int read_i (ACE_Message_Block &message_block,
+              size_t num_bytes_to_read,
+              const void *act,
+              int priority,
+              int signal_number,
+              bool chain);
+
+  /// Common part of write() and writev().
+  int write_i (ACE_Message_Block &message_block,
+               size_t bytes_to_write,
+               const void *act,
+               int priority,
+               int signal_number,
+               bool chain);
+
 private:
   ACE_SSL_Asynch_Stream (ACE_SSL_Asynch_Stream const &) = delete;
   ACE_SSL_Asynch_Stream & operator= (ACE_SSL_Asynch_Stream const &) = delete;
@@ -385,6 +460,9 @@ protected:
   /// External, i.e. write result faked for user
   ACE_SSL_Asynch_Write_Stream_Result * ext_write_result_ ;
 
+  /// Bytes of the user's write passed to SSL so far.
+  size_t ext_write_done_;
+
   /// Stream state/flags
   enum Stream_Flag
     {
@@ -432,11 +510,16 @@ protected:
   //@}
 
   /**
-   * @name Internal stream, buffer and info for BIO write
+   * @name Internal stream, buffers and info for BIO write
+   *
+   * The two buffers take turns: while one is written to the socket,
+   * the other gathers the records SSL produces meanwhile.
    */
   //@{
   ACE_Asynch_Write_Stream bio_ostream_;
-  ACE_Message_Block       bio_out_msg_;
+  ACE_Message_Block       bio_out_buffers_[2];
+  ACE_Message_Block *     bio_out_msg_;
+  ACE_Message_Block *     bio_out_next_;
   int                     bio_out_errno_;
   int                     bio_out_flag_;
   //@}
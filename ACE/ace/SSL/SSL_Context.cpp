@@ -46,6 +46,15 @@ namespace
 
   // @@ This should also be managed by a singleton.
 #endif /* ACE_HAS_THREADS && OPENSSL_VERSION_NUMBER < 0x10100000L */
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+  /// Index of the ACE_SSL_Context in the ex_data of its SSL_CTX.
+  int ssl_context_index = -1;
+
+  /// Index of the peer address of a connection resuming sessions in
+  /// the ex_data of its SSL.
+  int ssl_peer_index = -1;
+#endif /* OPENSSL_VERSION_NUMBER >= 0x10101000L */
 }
 
 #if defined (ACE_HAS_THREADS) && (OPENSSL_VERSION_NUMBER < 0x10100000L)
@@ -96,6 +105,54 @@ extern "C"
 }
 #endif  /* ACE_HAS_THREADS && (OPENSSL_VERSION_NUMBER < 0x10100000L) */
 
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+
+# if (defined (ACE_HAS_VERSIONED_NAMESPACE) && ACE_HAS_VERSIONED_NAMESPACE == 1)
+#  define ACE_SSL_NEW_SESSION_CALLBACK_NAME ACE_PREPROC_CONCATENATE(ACE_VERSIONED_NAMESPACE_NAME, _ACE_SSL_new_session_callback)
+#  define ACE_SSL_FREE_PEER_NAME ACE_PREPROC_CONCATENATE(ACE_VERSIONED_NAMESPACE_NAME, _ACE_SSL_free_peer)
+# else
+#  define ACE_SSL_NEW_SESSION_CALLBACK_NAME ACE_SSL_new_session_callback
+#  define ACE_SSL_FREE_PEER_NAME ACE_SSL_free_peer
+# endif  /* ACE_HAS_VERSIONED_NAMESPACE == 1 */
+
+extern "C"
+{
+  // Called by OpenSSL for every session a client establishes.  With
+  // TLS 1.3 that happens when the session tickets arrive, after the
+  // handshake is done.
+  int
+  ACE_SSL_NEW_SESSION_CALLBACK_NAME (SSL *ssl, SSL_SESSION *session)
+  {
+    ACE_VERSIONED_NAMESPACE_NAME::ACE_INET_Addr *peer =
+      static_cast<ACE_VERSIONED_NAMESPACE_NAME::ACE_INET_Addr *> (
+        ::SSL_get_ex_data (ssl, ssl_peer_index));
+
+    ACE_VERSIONED_NAMESPACE_NAME::ACE_SSL_Context *context =
+      static_cast<ACE_VERSIONED_NAMESPACE_NAME::ACE_SSL_Context *> (
+        ::SSL_CTX_get_ex_data (::SSL_get_SSL_CTX (ssl), ssl_context_index));
+
+    if (peer == 0 || context == 0)
+      return 0;
+
+    return context->cache_session (*peer, session);
+  }
+
+  // -------------------------------
+
+  // Release the peer address attached to an SSL structure.
+  void
+  ACE_SSL_FREE_PEER_NAME (void * /* parent */,
+                          void *ptr,
+                          CRYPTO_EX_DATA * /* ad */,
+                          int /* idx */,
+                          long /* argl */,
+                          void * /* argp */)
+  {
+    delete static_cast<ACE_VERSIONED_NAMESPACE_NAME::ACE_INET_Addr *> (ptr);
+  }
+}
+#endif  /* OPENSSL_VERSION_NUMBER >= 0x10101000L */
+
 
 // ****************************************************************
 
@@ -121,6 +178,8 @@ ACE_SSL_Context::~ACE_SSL_Context ()
 {
   ACE_TRACE ("ACE_SSL_Context::~ACE_SSL_Context");
 
+  this->flush_sessions ();
+
   if (this->context_)
     {
       ::SSL_CTX_free (this->context_);
@@ -206,6 +265,17 @@ ACE_SSL_Context::ssl_library_init ()
           (void) this->seed_file (rand_file);
         }
 
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+      // The ex_data indices outlive the library initialization, so
+      // they are only allocated once.
+      if (ssl_context_index == -1)
+        ssl_context_index =
+          ::SSL_CTX_get_ex_new_index (0, 0, 0, 0, 0);
+      if (ssl_peer_index == -1)
+        ssl_peer_index =
+          ::SSL_get_ex_new_index (0, 0, 0, 0, ACE_SSL_FREE_PEER_NAME);
+#endif /* OPENSSL_VERSION_NUMBER >= 0x10101000L */
+
       // Initialize the mutexes that will be used by the SSL and
       // crypto library.
     }
@@ -283,6 +353,11 @@ ACE_SSL_Context::set_mode (int mode)
 
   this->mode_ = mode;
 
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+  // Let the new session callback find its way back to this context.
+  (void) ::SSL_CTX_set_ex_data (this->context_, ssl_context_index, this);
+#endif /* OPENSSL_VERSION_NUMBER >= 0x10101000L */
+
   // Load the trusted certificate authority (default) certificate
   // locations. But do not return -1 on error, doing so confuses CTX
   // allocation (severe error) with the less important loading of CA
@@ -812,6 +887,277 @@ ACE_SSL_Context::dh_params (const char *file_name,
   return 0;
 }
 
+int
+ACE_SSL_Context::session_cache_mode (long mode)
+{
+  ACE_TRACE ("ACE_SSL_Context::session_cache_mode");
+
+  this->check_context ();
+
+  if (this->context_ == 0)
+    return -1;
+
+  (void) ::SSL_CTX_set_session_cache_mode (this->context_, mode);
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+  ::SSL_CTX_sess_set_new_cb (this->context_,
+                             ACE_BIT_ENABLED (mode, SSL_SESS_CACHE_CLIENT)
+                               ? ACE_SSL_NEW_SESSION_CALLBACK_NAME
+                               : 0);
+#endif /* OPENSSL_VERSION_NUMBER >= 0x10101000L */
+
+  return 0;
+}
+
+long
+ACE_SSL_Context::session_cache_mode () const
+{
+  if (this->context_ == 0)
+    return SSL_SESS_CACHE_SERVER;
+
+  return ::SSL_CTX_get_session_cache_mode (this->context_);
+}
+
+int
+ACE_SSL_Context::session_cache_size (long size)
+{
+  ACE_TRACE ("ACE_SSL_Context::session_cache_size");
+
+  this->check_context ();
+
+  if (this->context_ == 0)
+    return -1;
+
+  (void) ::SSL_CTX_sess_set_cache_size (this->context_, size);
+  return 0;
+}
+
+int
+ACE_SSL_Context::session_timeout (long seconds)
+{
+  ACE_TRACE ("ACE_SSL_Context::session_timeout");
+
+  this->check_context ();
+
+  if (this->context_ == 0)
+    return -1;
+
+  (void) ::SSL_CTX_set_timeout (this->context_, seconds);
+  return 0;
+}
+
+int
+ACE_SSL_Context::session_tickets (bool enable)
+{
+  ACE_TRACE ("ACE_SSL_Context::session_tickets");
+
+  this->check_context ();
+
+  if (this->context_ == 0)
+    return -1;
+
+  if (enable)
+    ::SSL_CTX_clear_options (this->context_, SSL_OP_NO_TICKET);
+  else
+    ::SSL_CTX_set_options (this->context_, SSL_OP_NO_TICKET);
+
+  return 0;
+}
+
+int
+ACE_SSL_Context::session_id_context (const unsigned char *sid_ctx,
+                                     unsigned int len)
+{
+  ACE_TRACE ("ACE_SSL_Context::session_id_context");
+
+  this->check_context ();
+
+  // Note that this function returns 1, if the operation succeeded.
+  // See SSL_CTX_set_session_id_context(3)
+  if (this->context_ == 0
+      || ::SSL_CTX_set_session_id_context (this->context_, sid_ctx, len) != 1)
+    return -1;
+
+  return 0;
+}
+
+int
+ACE_SSL_Context::resume_session (SSL *ssl, const ACE_INET_Addr &peer)
+{
+  ACE_TRACE ("ACE_SSL_Context::resume_session");
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+  SSL_CTX *ssl_ctx = ::SSL_get_SSL_CTX (ssl);
+
+  ACE_SSL_Context *context =
+    static_cast<ACE_SSL_Context *> (
+      ::SSL_CTX_get_ex_data (ssl_ctx, ssl_context_index));
+
+  if (context == 0
+      || ACE_BIT_DISABLED (::SSL_CTX_get_session_cache_mode (ssl_ctx),
+                           SSL_SESS_CACHE_CLIENT))
+    return 0;
+
+  // A session belongs to the credentials it was established with, so
+  // connections using credentials of their own neither offer nor
+  // cache sessions.
+  if (::SSL_get_certificate (ssl) != ::SSL_CTX_get0_certificate (ssl_ctx))
+    return 0;
+
+  if (::SSL_get_ex_data (ssl, ssl_peer_index) == 0)
+    {
+      ACE_INET_Addr *key = 0;
+      ACE_NEW_RETURN (key, ACE_INET_Addr (peer), -1);
+
+      if (::SSL_set_ex_data (ssl, ssl_peer_index, key) == 0)
+        {
+          delete key;
+          return -1;
+        }
+    }
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, context->sessions_lock_, -1);
+
+  SSL_SESSION *session = 0;
+  if (context->sessions_.find (peer, session) == 0
+      && ::SSL_set_session (ssl, session) != 1)
+    return -1;
+#else
+  ACE_UNUSED_ARG (ssl);
+  ACE_UNUSED_ARG (peer);
+#endif /* OPENSSL_VERSION_NUMBER >= 0x10101000L */
+
+  return 0;
+}
+
+void
+ACE_SSL_Context::remove_session (SSL *ssl)
+{
+  ACE_TRACE ("ACE_SSL_Context::remove_session");
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+  ACE_INET_Addr *peer =
+    static_cast<ACE_INET_Addr *> (::SSL_get_ex_data (ssl, ssl_peer_index));
+
+  ACE_SSL_Context *context =
+    static_cast<ACE_SSL_Context *> (
+      ::SSL_CTX_get_ex_data (::SSL_get_SSL_CTX (ssl), ssl_context_index));
+
+  if (peer == 0 || context == 0)
+    return;
+
+  ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, context->sessions_lock_);
+
+  SSL_SESSION *session = 0;
+  if (context->sessions_.unbind (*peer, session) == 0)
+    ::SSL_SESSION_free (session);
+#else
+  ACE_UNUSED_ARG (ssl);
+#endif /* OPENSSL_VERSION_NUMBER >= 0x10101000L */
+}
+
+int
+ACE_SSL_Context::cache_session (const ACE_INET_Addr &peer,
+                                SSL_SESSION *session)
+{
+  ACE_TRACE ("ACE_SSL_Context::cache_session");
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+  if (!::SSL_SESSION_is_resumable (session))
+    return 0;
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->sessions_lock_, 0);
+
+  // Only the most recent session with a server is worth offering.
+  SSL_SESSION *old_session = 0;
+  if (this->sessions_.find (peer, old_session) == 0)
+    {
+      if (this->sessions_.rebind (peer, session, old_session) == -1)
+        return 0;
+
+      ::SSL_SESSION_free (old_session);
+      return 1;
+    }
+
+  // Make room for a new server by dropping an arbitrary one.
+  long const limit = ::SSL_CTX_sess_get_cache_size (this->context_);
+  if (limit > 0
+      && this->sessions_.current_size () >= static_cast<size_t> (limit))
+    {
+      ACE_INET_Addr const victim ((*this->sessions_.begin ()).ext_id_);
+      if (this->sessions_.unbind (victim, old_session) == 0)
+        ::SSL_SESSION_free (old_session);
+    }
+
+  return this->sessions_.bind (peer, session) == 0 ? 1 : 0;
+#else
+  ACE_UNUSED_ARG (peer);
+  ACE_UNUSED_ARG (session);
+  return 0;
+#endif /* OPENSSL_VERSION_NUMBER >= 0x10101000L */
+}
+
+void
+ACE_SSL_Context::flush_sessions ()
+{
+  ACE_TRACE ("ACE_SSL_Context::flush_sessions");
+
+  ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->sessions_lock_);
+
+  for (SESSION_MAP::iterator i = this->sessions_.begin ();
+       i != this->sessions_.end ();
+       ++i)
+    ::SSL_SESSION_free ((*i).int_id_);
+
+  this->sessions_.unbind_all ();
+}
+
+size_t
+ACE_SSL_Context::cached_sessions () const
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->sessions_lock_, 0);
+
+  return this->sessions_.current_size ();
+}
+
+int
+ACE_SSL_Context::ktls (bool enable)
+{
+  ACE_TRACE ("ACE_SSL_Context::ktls");
+
+#if defined (ACE_SSL_HAS_KTLS)
+  this->check_context ();
+
+  if (this->context_ == 0)
+    return -1;
+
+  if (enable)
+    ::SSL_CTX_set_options (this->context_, SSL_OP_ENABLE_KTLS);
+  else
+    ::SSL_CTX_clear_options (this->context_, SSL_OP_ENABLE_KTLS);
+
+  return 0;
+#else
+  if (!enable)
+    return 0;
+
+  errno = ENOTSUP;
+  return -1;
+#endif /* ACE_SSL_HAS_KTLS */
+}
+
+bool
+ACE_SSL_Context::ktls () const
+{
+#if defined (ACE_SSL_HAS_KTLS)
+  return this->context_ != 0
+    && ACE_BIT_ENABLED (::SSL_CTX_get_options (this->context_),
+                        SSL_OP_ENABLE_KTLS);
+#else
+  return false;
+#endif /* ACE_SSL_HAS_KTLS */
+}
+
 // ****************************************************************
 ACE_SINGLETON_TEMPLATE_INSTANTIATE(ACE_Unmanaged_Singleton, ACE_SSL_Context, ACE_SYNCH_MUTEX)
 
@@ -20,16 +20,21 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "ace/SString.h"
-
-#ifdef ACE_HAS_THREADS
-# include "ace/Synch_Traits.h"
-#endif  /* ACE_HAS_THREADS */
+#include "ace/INET_Addr.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Null_Mutex.h"
+#include "ace/Synch_Traits.h"
 
 #include <openssl/ssl.h>
 
-ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+// Kernel TLS offload needs OpenSSL 3.0 built with KTLS support, which
+// OpenSSL only does on platforms that have it.
+#if !defined (ACE_SSL_LACKS_KTLS) && defined (SSL_OP_ENABLE_KTLS) \
+    && !defined (OPENSSL_NO_KTLS)
+# define ACE_SSL_HAS_KTLS
+#endif /* !ACE_SSL_LACKS_KTLS && SSL_OP_ENABLE_KTLS && !OPENSSL_NO_KTLS */
 
-class ACE_INET_Addr;
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class ACE_SSL_Export ACE_SSL_Data_File
 {
@@ -365,6 +370,77 @@ public:
   int dh_params_file_type () const;
   //@}
 
+  /**
+   * @name TLS Session Resumption
+   *
+   * Resuming a session skips the certificate exchange and the public
+   * key operations of a full handshake.  Servers cache the sessions
+   * they establish by default and issue session tickets to clients
+   * that ask for them.  Clients only resume sessions once
+   * SSL_SESS_CACHE_CLIENT is part of the session cache mode; the
+   * ACE_SSL_SOCK_Connector then offers the last session established
+   * with a server address when it connects to that address again.
+   *
+   * A client session is only offered by connections that use the
+   * certificate of the context, never by those given credentials of
+   * their own.
+   */
+  //@{
+  /// Set the session cache mode, a combination of the OpenSSL
+  /// SSL_SESS_CACHE_* flags.  The OpenSSL default is
+  /// SSL_SESS_CACHE_SERVER.
+  int session_cache_mode (long mode);
+  long session_cache_mode () const;
+
+  /// Set the largest number of sessions cached, by the server and by
+  /// the client each.  0 means no limit.
+  int session_cache_size (long size);
+
+  /// Set the number of seconds a session may be resumed for.
+  int session_timeout (long seconds);
+
+  /// Enable or disable RFC 5077 session tickets, enabled by default.
+  /// Without tickets a server can only resume the sessions in its
+  /// own cache.
+  int session_tickets (bool enable);
+
+  /// Set the context servers check resumed sessions against.
+  /// Servers that verify client certificates refuse to resume
+  /// sessions without one.
+  int session_id_context (const unsigned char *sid_ctx, unsigned int len);
+
+  /// Prepare @a ssl to offer the session cached for @a peer and to
+  /// cache the session it establishes.  Does nothing unless @a ssl
+  /// was created from an ACE_SSL_Context caching client sessions.
+  static int resume_session (SSL *ssl, const ACE_INET_Addr &peer);
+
+  /// Forget the session cached for the peer @a ssl connected to,
+  /// e.g. after a failed handshake.
+  static void remove_session (SSL *ssl);
+
+  /// Cache @a session for @a peer.  Returns 1 if the cache took
+  /// over the reference to @a session, 0 otherwise.
+  int cache_session (const ACE_INET_Addr &peer, SSL_SESSION *session);
+
+  /// Forget all the cached client sessions.
+  void flush_sessions ();
+
+  /// The number of cached client sessions.
+  size_t cached_sessions () const;
+  //@}
+
+  /**
+   * Enable or disable kernel TLS offload.  Once the handshake is
+   * done the record encryption of connections using a cipher the
+   * kernel supports is passed to the kernel, so that
+   * ACE_SSL_SOCK_Stream::sendv() and sendfile() hand the plaintext
+   * straight to the socket.  Other connections are unaffected.
+   * Returns -1 with errno ENOTSUP when ACE_SSL_HAS_KTLS is not
+   * defined.
+   */
+  int ktls (bool enable);
+  bool ktls () const;
+
 private:
   /// Verify if the context has been initialized or not.
   void check_context ();
@@ -397,6 +473,19 @@ private:
   /// count of successful CA load attempts
   int have_ca_;
 
+  typedef ACE_Hash_Map_Manager_Ex<ACE_INET_Addr,
+                                  SSL_SESSION *,
+                                  ACE_Hash<ACE_INET_Addr>,
+                                  ACE_Equal_To<ACE_INET_Addr>,
+                                  ACE_Null_Mutex> SESSION_MAP;
+
+  /// The last session established with each server, when caching
+  /// client sessions.
+  SESSION_MAP sessions_;
+
+  /// Serialize access to <sessions_>.
+  mutable ACE_SYNCH_MUTEX sessions_lock_;
+
 #if defined(ACE_HAS_THREADS) && (OPENSSL_VERSION_NUMBER < 0x10100000L)
   /// Array of mutexes used internally by OpenSSL when the SSL
   /// application is multithreaded.
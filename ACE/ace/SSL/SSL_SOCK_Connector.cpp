@@ -37,7 +37,15 @@ ACE_SSL_SOCK_Connector::ssl_connect (ACE_SSL_SOCK_Stream &new_stream,
   // Check if a connection is already pending for the given SSL
   // structure.
   if (!SSL_in_connect_init (ssl))
-    ::SSL_set_connect_state (ssl);
+    {
+      ::SSL_set_connect_state (ssl);
+
+      // Offer the session last established with this server, if the
+      // context caches client sessions.
+      ACE_INET_Addr peer_addr;
+      if (new_stream.peer ().get_remote_addr (peer_addr) == 0)
+        (void) ACE_SSL_Context::resume_session (ssl, peer_addr);
+    }
 
   ACE_HANDLE handle = new_stream.get_handle ();
 
@@ -181,6 +189,10 @@ ACE_SSL_SOCK_Connector::ssl_connect (ACE_SSL_SOCK_Stream &new_stream,
       ACE::clr_flags (handle, ACE_NONBLOCK);
     }
 
+  // Do not offer a session the server may have choked on again.
+  if (status == -1)
+    ACE_SSL_Context::remove_session (ssl);
+
   return (status == -1 ? -1 : 0);
 }
 
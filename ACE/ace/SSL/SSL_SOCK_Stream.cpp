@@ -4,10 +4,12 @@
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_sys_select.h"
 #include "ace/OS_Memory.h"
+#include "ace/OS_NS_unistd.h"
 
 #include <openssl/err.h>
 
 #include "SSL_SOCK_Stream.h"
+#include "sslconf.h"
 
 #if !defined (__ACE_INLINE__)
 #include "SSL_SOCK_Stream.inl"
@@ -56,6 +58,13 @@ ACE_SSL_SOCK_Stream::sendv (const iovec iov[],
 {
   ACE_TRACE ("ACE_SSL_SOCK_Stream::sendv");
 
+#if defined (ACE_SSL_HAS_KTLS)
+  // The kernel encrypts what is written to the socket, so the
+  // scatter write needs no emulation.
+  if (this->ktls_send ())
+    return this->stream_.sendv (iov, static_cast<int> (n), max_wait_time);
+#endif /* ACE_SSL_HAS_KTLS */
+
   // There is subtle problem in this method that occurs when using
   // non-blocking IO.  The semantics of a non-blocking scatter write
   // (sendv()) are not possible to retain with the emulation in this
@@ -483,6 +492,11 @@ ACE_SSL_SOCK_Stream::sendv_n (const iovec iov[], size_t iovcnt) const
 {
   ACE_TRACE ("ACE_SSL_SOCK_Stream::sendv_n");
 
+#if defined (ACE_SSL_HAS_KTLS)
+  if (this->ktls_send ())
+    return this->stream_.sendv_n (iov, static_cast<int> (iovcnt));
+#endif /* ACE_SSL_HAS_KTLS */
+
   ssize_t bytes_sent = 0;
 
   for (size_t i = 0; i < iovcnt; ++i)
@@ -516,6 +530,81 @@ ACE_SSL_SOCK_Stream::sendv_n (const iovec iov[], size_t iovcnt) const
   return bytes_sent;
 }
 
+ssize_t
+ACE_SSL_SOCK_Stream::sendfile (ACE_HANDLE in_fd,
+                               ACE_OFF_T offset,
+                               size_t count) const
+{
+  ACE_TRACE ("ACE_SSL_SOCK_Stream::sendfile");
+
+#if defined (ACE_SSL_HAS_KTLS)
+  if (this->ktls_send ())
+    {
+      ossl_ssize_t const result =
+        ::SSL_sendfile (this->ssl_, in_fd, offset, count, 0);
+
+      if (result >= 0)
+        return result;
+
+      switch (::SSL_get_error (this->ssl_, static_cast<int> (result)))
+        {
+        case SSL_ERROR_WANT_WRITE:
+        case SSL_ERROR_WANT_READ:
+          errno = EWOULDBLOCK;
+          break;
+
+        case SSL_ERROR_SYSCALL:
+          ACE_OS::set_errno_to_last_error ();
+          break;
+
+        default:
+          ACE_SSL_Context::report_error ();
+          break;
+        }
+
+      return -1;
+    }
+#endif /* ACE_SSL_HAS_KTLS */
+
+  char buf[ACE_DEFAULT_SSL_SENDFILE_CHUNK];
+  ssize_t bytes_sent = 0;
+
+  while (count > 0)
+    {
+      size_t const len = count < sizeof buf ? count : sizeof buf;
+      ssize_t const n = ACE_OS::pread (in_fd, buf, len, offset);
+
+      if (n <= 0)
+        break;
+
+      ssize_t const result = this->send (buf, static_cast<size_t> (n));
+
+      if (result == -1)
+        return bytes_sent > 0 ? bytes_sent : -1;
+
+      bytes_sent += result;
+      offset += result;
+      count -= static_cast<size_t> (result);
+
+      // A short write means the socket cannot take more right now.
+      if (result < n)
+        break;
+    }
+
+  return bytes_sent;
+}
+
+bool
+ACE_SSL_SOCK_Stream::ktls_send () const
+{
+#if defined (ACE_SSL_HAS_KTLS)
+  return this->ssl_ != 0
+    && BIO_get_ktls_send (::SSL_get_wbio (this->ssl_));
+#else
+  return false;
+#endif /* ACE_SSL_HAS_KTLS */
+}
+
 ssize_t
 ACE_SSL_SOCK_Stream::recvv_n (iovec iov[], size_t iovcnt) const
 {
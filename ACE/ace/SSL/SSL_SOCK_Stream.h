@@ -106,7 +106,9 @@ public:
   /**
    * Note that it is not possible to perform a "scattered" write with
    * the underlying OpenSSL implementation.  As such, the expected
-   * semantics are not fully reproduced with this implementation.
+   * semantics are not fully reproduced with this implementation,
+   * unless the kernel encrypts the records (see ktls_send()), in
+   * which case the iovec is written to the socket at once.
    */
   ssize_t sendv (const iovec iov[],
                  size_t n,
@@ -258,6 +260,23 @@ public:
   ssize_t recvv_n (iovec iov[],
                    size_t n) const;
 
+  /**
+   * Send up to @a count bytes of the file @a in_fd, starting at
+   * @a offset, using the semantics of sendfile(2).  When the kernel
+   * encrypts the records the file is sent without being copied to
+   * user space, otherwise it is read and sent in chunks.  Returns the
+   * number of bytes sent or -1 if none could be.
+   */
+  ssize_t sendfile (ACE_HANDLE in_fd,
+                    ACE_OFF_T offset,
+                    size_t count) const;
+
+  /// True if the records sent on this stream are encrypted by the
+  /// kernel, which is the case once the handshake of a connection
+  /// created from an ACE_SSL_Context with ktls() enabled is done and
+  /// the kernel supports the negotiated cipher.
+  bool ktls_send () const;
+
   /**
    * Selectively close endpoints.
    */
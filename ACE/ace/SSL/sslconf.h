@@ -46,6 +46,18 @@
 #define ACE_SSL_EGD_FILE_ENV  "SSL_EGD_FILE"
 #endif /* ACE_SSL_EGD_FILE_ENV */
 
+#if !defined (ACE_DEFAULT_SSL_SENDFILE_CHUNK)
+// Size of the chunks ACE_SSL_SOCK_Stream::sendfile() reads a file in
+// when the kernel does not encrypt the records.  One TLS record.
+#define ACE_DEFAULT_SSL_SENDFILE_CHUNK 16384
+#endif /* ACE_DEFAULT_SSL_SENDFILE_CHUNK */
+
+#if !defined (ACE_SSL_ASYNCH_STREAM_BUFFER_SIZE)
+// Size of the buffers ACE_SSL_Asynch_Stream reads records from the
+// socket into and gathers the records it writes in.
+#define ACE_SSL_ASYNCH_STREAM_BUFFER_SIZE 65536
+#endif /* ACE_SSL_ASYNCH_STREAM_BUFFER_SIZE */
+
 #if !defined (ACE_SSL_RAND_FILE_ENV)
 #define ACE_SSL_RAND_FILE_ENV  "SSL_RAND_FILE"
 #endif /* ACE_SSL_RAND_FILE_ENV */
@@ -0,0 +1,636 @@
+#include "ace/Slab_Allocator.h"
+
+#if !defined (__ACE_INLINE__)
+#include "ace/Slab_Allocator.inl"
+#endif /* __ACE_INLINE__ */
+
+#include "ace/Guard_T.h"
+#include "ace/Log_Category.h"
+#include "ace/Malloc.h"
+#include "ace/OS_Memory.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_ALLOC_HOOK_DEFINE (ACE_Slab_Allocator)
+
+namespace
+{
+  /// Precedes every block handed out.  @c owner_ is the cache that
+  /// handed out a block of size class @c info_, or 0 for a block
+  /// obtained from ACE_OS::malloc() with @c info_ usable bytes.
+  struct Block_Header
+  {
+    void *owner_;
+    size_t info_;
+  };
+
+  size_t const header_size =
+    ACE_MALLOC_ROUNDUP (sizeof (Block_Header), ACE_MALLOC_ALIGN);
+
+  /// Size class limit of the lookup table entries.
+  size_t const max_classes = 255;
+
+  inline Block_Header *
+  header_of (const void *ptr)
+  {
+    return reinterpret_cast<Block_Header *> (
+      const_cast<char *> (static_cast<const char *> (ptr)) - header_size);
+  }
+}
+
+/// A free block, linked through its first bytes.
+struct ACE_Slab_Allocator::Free_Block
+{
+  Free_Block *next_;
+};
+
+/**
+ * @class ACE_Slab_Allocator::Cache
+ *
+ * Free blocks of one thread.  A cache outlives the thread it belongs
+ * to so that blocks freed by other threads always have a cache to go
+ * back to.
+ */
+class ACE_Slab_Allocator::Cache
+{
+public:
+  explicit Cache (size_t classes);
+  ~Cache ();
+
+  /// Free list and its length, for each class; only touched by the
+  /// owning thread.
+  Free_Block **free_;
+  size_t *count_;
+
+  /// Blocks of each class freed by other threads.
+  std::atomic<Free_Block *> *remote_;
+
+  /// Next in the list of all caches, and in the list of idle ones.
+  Cache *next_;
+  Cache *next_idle_;
+};
+
+ACE_Slab_Allocator::Cache::Cache (size_t classes)
+  : free_ (0),
+    count_ (0),
+    remote_ (0),
+    next_ (0),
+    next_idle_ (0)
+{
+  ACE_NEW_NORETURN (this->free_, Free_Block *[classes]);
+  ACE_NEW_NORETURN (this->count_, size_t[classes]);
+  ACE_NEW_NORETURN (this->remote_, std::atomic<Free_Block *>[classes]);
+  if (this->free_ == 0 || this->count_ == 0 || this->remote_ == 0)
+    return;
+
+  for (size_t c = 0; c != classes; ++c)
+    {
+      this->free_[c] = 0;
+      this->count_[c] = 0;
+      this->remote_[c].store (0, std::memory_order_relaxed);
+    }
+}
+
+ACE_Slab_Allocator::Cache::~Cache ()
+{
+  delete [] this->remote_;
+  delete [] this->count_;
+  delete [] this->free_;
+}
+
+/******************************************************************************/
+
+ACE_Slab_Allocator::Thread_Cache::Thread_Cache ()
+  : allocator_ (0),
+    cache_ (0)
+{
+}
+
+ACE_Slab_Allocator::Thread_Cache::~Thread_Cache ()
+{
+  if (this->cache_ != 0 && !this->allocator_->closing_)
+    this->allocator_->release_cache (this->cache_);
+}
+
+/******************************************************************************/
+
+ACE_Slab_Allocator::ACE_Slab_Allocator (size_t max_size, size_t slab_size)
+  : max_size_ (0),
+    slab_size_ (slab_size),
+    classes_ (0),
+    class_size_ (0),
+    batch_ (0),
+    limit_ (0),
+    lookup_ (0),
+    central_ (0),
+    central_count_ (0),
+    slabs_ (0),
+    slab_bytes_ (0),
+    caches_ (0),
+    idle_caches_ (0),
+    closing_ (false),
+    tss_ (new Thread_Cache)
+{
+  ACE_TRACE ("ACE_Slab_Allocator::ACE_Slab_Allocator");
+
+  // Multiples of 16 bytes up to 128 bytes, then four classes for each
+  // power of two, which wastes at most a fifth of a block.
+  size_t sizes[max_classes];
+  size_t classes = 0;
+  for (size_t size = 16; size <= 128; size += 16)
+    {
+      sizes[classes++] = size;
+      if (size >= max_size)
+        break;
+    }
+  for (size_t base = 128;
+       sizes[classes - 1] < max_size && classes + 4 <= max_classes;
+       base *= 2)
+    for (size_t step = 1; step <= 4; ++step)
+      sizes[classes++] = base + step * (base / 4);
+
+  size_t const top = sizes[classes - 1];
+  size_t const entries = top / 16 + 1;
+
+  ACE_NEW (this->class_size_, size_t[classes]);
+  ACE_NEW (this->batch_, size_t[classes]);
+  ACE_NEW (this->limit_, size_t[classes]);
+  ACE_NEW (this->lookup_, unsigned char[entries]);
+  ACE_NEW (this->central_, Free_Block *[classes]);
+  ACE_NEW (this->central_count_, size_t[classes]);
+
+  for (size_t c = 0; c != classes; ++c)
+    {
+      size_t const stride =
+        ACE_MALLOC_ROUNDUP (header_size + sizes[c], ACE_MALLOC_ALIGN);
+      size_t batch = slab_size / stride;
+      if (batch == 0)
+        batch = 1;
+      else if (batch > ACE_SLAB_ALLOCATOR_BATCH)
+        batch = ACE_SLAB_ALLOCATOR_BATCH;
+
+      this->class_size_[c] = sizes[c];
+      this->batch_[c] = batch;
+      this->limit_[c] = 2 * batch;
+      this->central_[c] = 0;
+      this->central_count_[c] = 0;
+    }
+
+  // Entry i holds the smallest class of at least 16 * i bytes.
+  size_t c = 0;
+  for (size_t i = 0; i != entries; ++i)
+    {
+      while (sizes[c] < 16 * i)
+        ++c;
+      this->lookup_[i] = static_cast<unsigned char> (c);
+    }
+
+  this->classes_ = classes;
+  this->max_size_ = top;
+}
+
+ACE_Slab_Allocator::~ACE_Slab_Allocator ()
+{
+  ACE_TRACE ("ACE_Slab_Allocator::~ACE_Slab_Allocator");
+
+  // Keeps the calling thread's Thread_Cache, destroyed with tss_ after
+  // this, from returning its cache.
+  this->closing_ = true;
+
+  while (this->caches_ != 0)
+    {
+      Cache * const next = this->caches_->next_;
+      delete this->caches_;
+      this->caches_ = next;
+    }
+
+  while (this->slabs_ != 0)
+    {
+      void * const next = *static_cast<void **> (this->slabs_);
+      ACE_OS::free (this->slabs_);
+      this->slabs_ = next;
+    }
+
+  delete [] this->central_count_;
+  delete [] this->central_;
+  delete [] this->lookup_;
+  delete [] this->limit_;
+  delete [] this->batch_;
+  delete [] this->class_size_;
+}
+
+void *
+ACE_Slab_Allocator::malloc (size_t nbytes)
+{
+  if (nbytes > this->max_size_ || this->classes_ == 0)
+    return this->malloc_large (nbytes);
+
+  size_t const c = this->lookup_[(nbytes + 15) / 16];
+
+  Cache * const cache = this->cache ();
+  if (cache == 0)
+    return 0;
+
+  Free_Block *block = cache->free_[c];
+  if (block == 0)
+    {
+      block = this->refill (cache, c);
+      if (block == 0)
+        return 0;
+    }
+
+  cache->free_[c] = block->next_;
+  --cache->count_[c];
+
+  Block_Header * const header = header_of (block);
+  header->owner_ = cache;
+  header->info_ = c;
+  return block;
+}
+
+void *
+ACE_Slab_Allocator::calloc (size_t nbytes, char initial_value)
+{
+  void * const ptr = this->malloc (nbytes);
+  if (ptr != 0)
+    ACE_OS::memset (ptr, initial_value, nbytes);
+  return ptr;
+}
+
+void *
+ACE_Slab_Allocator::calloc (size_t n_elem, size_t elem_size, char initial_value)
+{
+  return this->calloc (n_elem * elem_size, initial_value);
+}
+
+void
+ACE_Slab_Allocator::free (void *ptr)
+{
+  if (ptr == 0)
+    return;
+
+  Block_Header * const header = header_of (ptr);
+  Cache * const owner = static_cast<Cache *> (header->owner_);
+  if (owner == 0)
+    {
+      ACE_OS::free (header);
+      return;
+    }
+
+  size_t const c = header->info_;
+  Free_Block * const block = static_cast<Free_Block *> (ptr);
+
+  Cache * const cache = this->cache ();
+  if (cache == owner)
+    {
+      block->next_ = cache->free_[c];
+      cache->free_[c] = block;
+      if (++cache->count_[c] > this->limit_[c])
+        this->flush (cache, c);
+      return;
+    }
+
+  // Another thread's block: push it onto the owner's stack.  The
+  // owner only ever takes the whole stack, so there is no ABA hazard.
+  Free_Block *head = owner->remote_[c].load (std::memory_order_relaxed);
+  do
+    block->next_ = head;
+  while (!owner->remote_[c].compare_exchange_weak (head,
+                                                   block,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed));
+}
+
+size_t
+ACE_Slab_Allocator::block_size (const void *ptr) const
+{
+  Block_Header const * const header = header_of (ptr);
+  return header->owner_ == 0
+    ? header->info_
+    : this->class_size_[header->info_];
+}
+
+size_t
+ACE_Slab_Allocator::slab_bytes () const
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX,
+                    ace_mon,
+                    const_cast<ACE_SYNCH_MUTEX &> (this->lock_),
+                    0);
+  return this->slab_bytes_;
+}
+
+ACE_Slab_Allocator::Cache *
+ACE_Slab_Allocator::cache ()
+{
+  Thread_Cache * const tc = this->tss_;
+  if (tc == 0)
+    return 0;
+
+  if (tc->cache_ == 0)
+    {
+      tc->cache_ = this->acquire_cache ();
+      tc->allocator_ = this;
+    }
+
+  return tc->cache_;
+}
+
+ACE_Slab_Allocator::Cache *
+ACE_Slab_Allocator::acquire_cache ()
+{
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+
+  Cache *cache = this->idle_caches_;
+  if (cache != 0)
+    {
+      this->idle_caches_ = cache->next_idle_;
+      cache->next_idle_ = 0;
+      return cache;
+    }
+
+  ACE_NEW_RETURN (cache, Cache (this->classes_), 0);
+  if (cache->remote_ == 0)
+    {
+      delete cache;
+      errno = ENOMEM;
+      return 0;
+    }
+
+  cache->next_ = this->caches_;
+  this->caches_ = cache;
+  return cache;
+}
+
+void
+ACE_Slab_Allocator::release_cache (Cache *cache)
+{
+  ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  for (size_t c = 0; c != this->classes_; ++c)
+    {
+      Free_Block *list =
+        cache->remote_[c].exchange (0, std::memory_order_acquire);
+      while (list != 0)
+        {
+          Free_Block * const next = list->next_;
+          list->next_ = this->central_[c];
+          this->central_[c] = list;
+          ++this->central_count_[c];
+          list = next;
+        }
+
+      list = cache->free_[c];
+      while (list != 0)
+        {
+          Free_Block * const next = list->next_;
+          list->next_ = this->central_[c];
+          this->central_[c] = list;
+          list = next;
+        }
+      this->central_count_[c] += cache->count_[c];
+      cache->free_[c] = 0;
+      cache->count_[c] = 0;
+    }
+
+  cache->next_idle_ = this->idle_caches_;
+  this->idle_caches_ = cache;
+}
+
+ACE_Slab_Allocator::Free_Block *
+ACE_Slab_Allocator::refill (Cache *cache, size_t c)
+{
+  // Blocks other threads freed come back first, without a lock.
+  Free_Block *list = cache->remote_[c].exchange (0, std::memory_order_acquire);
+  if (list != 0)
+    {
+      size_t count = 0;
+      for (Free_Block *b = list; b != 0; b = b->next_)
+        ++count;
+      cache->free_[c] = list;
+      cache->count_[c] = count;
+      return list;
+    }
+
+  ACE_GUARD_RETURN (ACE_SYNCH_MUTEX, ace_mon, this->lock_, 0);
+
+  if (this->central_[c] == 0)
+    {
+      // Reclaim what was freed to the caches of exited threads before
+      // carving a new slab.
+      for (Cache *idle = this->idle_caches_; idle != 0; idle = idle->next_idle_)
+        {
+          list = idle->remote_[c].exchange (0, std::memory_order_acquire);
+          while (list != 0)
+            {
+              Free_Block * const next = list->next_;
+              list->next_ = this->central_[c];
+              this->central_[c] = list;
+              ++this->central_count_[c];
+              list = next;
+            }
+        }
+
+      if (this->central_[c] == 0 && this->carve (c) == -1)
+        return 0;
+    }
+
+  Free_Block * const head = this->central_[c];
+  Free_Block *tail = head;
+  size_t count = 1;
+  while (count < this->batch_[c] && tail->next_ != 0)
+    {
+      tail = tail->next_;
+      ++count;
+    }
+
+  this->central_[c] = tail->next_;
+  this->central_count_[c] -= count;
+  tail->next_ = 0;
+
+  cache->free_[c] = head;
+  cache->count_[c] = count;
+  return head;
+}
+
+void
+ACE_Slab_Allocator::flush (Cache *cache, size_t c)
+{
+  ACE_GUARD (ACE_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  Free_Block * const head = cache->free_[c];
+  Free_Block *tail = head;
+  size_t count = 1;
+  while (count < this->batch_[c] && tail->next_ != 0)
+    {
+      tail = tail->next_;
+      ++count;
+    }
+
+  cache->free_[c] = tail->next_;
+  cache->count_[c] -= count;
+
+  tail->next_ = this->central_[c];
+  this->central_[c] = head;
+  this->central_count_[c] += count;
+}
+
+int
+ACE_Slab_Allocator::carve (size_t c)
+{
+  size_t const stride =
+    ACE_MALLOC_ROUNDUP (header_size + this->class_size_[c], ACE_MALLOC_ALIGN);
+
+  // The slab starts with the link to the previous one, padded like a
+  // block header, and holds at least a batch of blocks.
+  size_t size = header_size + this->batch_[c] * stride;
+  if (size < this->slab_size_)
+    size = this->slab_size_;
+  size_t const count = (size - header_size) / stride;
+
+  char * const slab = static_cast<char *> (ACE_OS::malloc (size));
+  if (slab == 0)
+    return -1;
+
+  *reinterpret_cast<void **> (slab) = this->slabs_;
+  this->slabs_ = slab;
+  this->slab_bytes_ += size;
+
+  // Push the blocks last to first so that they are handed out in
+  // address order.
+  for (size_t i = count; i != 0; --i)
+    {
+      Free_Block * const block = reinterpret_cast<Free_Block *> (
+        slab + header_size + (i - 1) * stride + header_size);
+      block->next_ = this->central_[c];
+      this->central_[c] = block;
+    }
+  this->central_count_[c] += count;
+
+  return 0;
+}
+
+void *
+ACE_Slab_Allocator::malloc_large (size_t nbytes)
+{
+  if (nbytes > static_cast<size_t> (-1) - header_size)
+    {
+      errno = ENOMEM;
+      return 0;
+    }
+
+  Block_Header * const header =
+    static_cast<Block_Header *> (ACE_OS::malloc (header_size + nbytes));
+  if (header == 0)
+    return 0;
+
+  header->owner_ = 0;
+  header->info_ = nbytes;
+  return reinterpret_cast<char *> (header) + header_size;
+}
+
+int
+ACE_Slab_Allocator::remove ()
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::bind (const char *, void *, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::trybind (const char *, void *&)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::find (const char *, void *&)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::find (const char *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::unbind (const char *)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::unbind (const char *, void *&)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::sync (ssize_t, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::sync (void *, size_t, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::protect (ssize_t, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+int
+ACE_Slab_Allocator::protect (void *, size_t, int)
+{
+  ACE_NOTSUP_RETURN (-1);
+}
+
+#if defined (ACE_HAS_MALLOC_STATS)
+void
+ACE_Slab_Allocator::print_stats () const
+{
+  ACE_GUARD (ACE_SYNCH_MUTEX,
+             ace_mon,
+             const_cast<ACE_SYNCH_MUTEX &> (this->lock_));
+
+  ACELIB_DEBUG ((LM_DEBUG,
+                 ACE_TEXT ("(%P|%t) slab bytes = %B\n"),
+                 this->slab_bytes_));
+  for (size_t c = 0; c != this->classes_; ++c)
+    if (this->central_count_[c] != 0)
+      ACELIB_DEBUG ((LM_DEBUG,
+                     ACE_TEXT ("(%P|%t) class %B bytes, %B central\n"),
+                     this->class_size_[c],
+                     this->central_count_[c]));
+}
+#endif /* ACE_HAS_MALLOC_STATS */
+
+void
+ACE_Slab_Allocator::dump () const
+{
+#if defined (ACE_HAS_DUMP)
+  ACE_TRACE ("ACE_Slab_Allocator::dump");
+
+  ACELIB_DEBUG ((LM_DEBUG, ACE_BEGIN_DUMP, this));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nmax_size_ = %B"), this->max_size_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nslab_size_ = %B"), this->slab_size_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nclasses_ = %B"), this->classes_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_TEXT ("\nslab_bytes_ = %B\n"), this->slab_bytes_));
+  ACELIB_DEBUG ((LM_DEBUG, ACE_END_DUMP));
+#endif /* ACE_HAS_DUMP */
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
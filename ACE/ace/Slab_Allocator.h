@@ -0,0 +1,230 @@
+// -*- C++ -*-
+
+//==========================================================================
+/**
+ *  @file   Slab_Allocator.h
+ *
+ *  Size class allocator with per-thread caches.
+ */
+//==========================================================================
+
+#ifndef ACE_SLAB_ALLOCATOR_H
+#define ACE_SLAB_ALLOCATOR_H
+
+#include /**/ "ace/pre.h"
+
+#include /**/ "ace/ACE_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "ace/Malloc_Base.h"
+#include "ace/Synch_Traits.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/TSS_T.h"
+
+#include <atomic>
+
+/// Largest request, in bytes, an ACE_Slab_Allocator serves from its
+/// size classes by default.  Larger ones go to ACE_OS::malloc().
+#if !defined (ACE_SLAB_ALLOCATOR_MAX_SIZE)
+#  define ACE_SLAB_ALLOCATOR_MAX_SIZE 65536
+#endif /* ACE_SLAB_ALLOCATOR_MAX_SIZE */
+
+/// Default size, in bytes, of the slabs an ACE_Slab_Allocator carves
+/// its blocks from.
+#if !defined (ACE_SLAB_ALLOCATOR_SLAB_SIZE)
+#  define ACE_SLAB_ALLOCATOR_SLAB_SIZE 65536
+#endif /* ACE_SLAB_ALLOCATOR_SLAB_SIZE */
+
+/// Most blocks a thread cache moves from or to the central free list
+/// of a size class at a time.
+#if !defined (ACE_SLAB_ALLOCATOR_BATCH)
+#  define ACE_SLAB_ALLOCATOR_BATCH 32
+#endif /* ACE_SLAB_ALLOCATOR_BATCH */
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class ACE_Slab_Allocator
+ *
+ * @brief An ACE_Allocator that serves requests from per size class
+ * slabs through per-thread caches.
+ *
+ * Requests up to the maximum size are rounded up to one of a set of
+ * size classes: multiples of 16 bytes up to 128 bytes, then four
+ * classes per power of two.  Each class has a central free list,
+ * refilled by carving slabs obtained from ACE_OS::malloc(), and every
+ * thread using the allocator has a cache holding a few free blocks
+ * of each class.  malloc() and free() by the thread that owns a block
+ * only touch that thread's cache; the central lists are locked only
+ * when a cache runs empty or grows past its limit, and then a batch
+ * of blocks moves at once.
+ *
+ * A block freed by a thread other than the one whose cache handed it
+ * out is pushed onto a lock-free stack of the owning cache, which the
+ * owner takes back in one go when it next runs out of blocks of that
+ * class.  This keeps the common pattern of one thread allocating a
+ * buffer and another one releasing it free of locks.
+ *
+ * The cache of a thread that exits is returned to the central lists
+ * and reused by the next thread that starts using the allocator.
+ * Slabs are only returned to the system when the allocator is
+ * destroyed, which must not happen while blocks are still in use.
+ *
+ * Requests larger than the maximum size are passed on to
+ * ACE_OS::malloc().  As with ACE_New_Allocator, only malloc(),
+ * calloc() and free() are supported; all other methods return -1
+ * and set @c errno to @c ENOTSUP.
+ */
+class ACE_Export ACE_Slab_Allocator : public ACE_Allocator
+{
+public:
+  /**
+   * Serve requests of up to @a max_size bytes from size classes,
+   * carving blocks from slabs of @a slab_size bytes.  @a max_size is
+   * rounded up to the size class that holds it.
+   */
+  ACE_Slab_Allocator (size_t max_size = ACE_SLAB_ALLOCATOR_MAX_SIZE,
+                      size_t slab_size = ACE_SLAB_ALLOCATOR_SLAB_SIZE);
+
+  /// Release all slabs and thread caches.
+  virtual ~ACE_Slab_Allocator ();
+
+  /// These methods are defined.
+  virtual void *malloc (size_t nbytes);
+  virtual void *calloc (size_t nbytes, char initial_value = '\0');
+  virtual void *calloc (size_t n_elem, size_t elem_size, char initial_value = '\0');
+  virtual void free (void *ptr);
+
+  /// These methods are no-ops.
+  virtual int remove ();
+  virtual int bind (const char *name, void *pointer, int duplicates = 0);
+  virtual int trybind (const char *name, void *&pointer);
+  virtual int find (const char *name, void *&pointer);
+  virtual int find (const char *name);
+  virtual int unbind (const char *name);
+  virtual int unbind (const char *name, void *&pointer);
+  virtual int sync (ssize_t len = -1, int flags = MS_SYNC);
+  virtual int sync (void *addr, size_t len, int flags = MS_SYNC);
+  virtual int protect (ssize_t len = -1, int prot = PROT_RDWR);
+  virtual int protect (void *addr, size_t len, int prot = PROT_RDWR);
+#if defined (ACE_HAS_MALLOC_STATS)
+  virtual void print_stats () const;
+#endif /* ACE_HAS_MALLOC_STATS */
+  virtual void dump () const;
+
+  /// Largest request served from a size class.
+  size_t max_size () const;
+
+  /// Number of size classes.
+  size_t size_classes () const;
+
+  /// Number of bytes usable in the block at @a ptr, which must have
+  /// been returned by malloc() or calloc() of this allocator.
+  size_t block_size (const void *ptr) const;
+
+  /// Number of slab bytes obtained from the system so far.
+  size_t slab_bytes () const;
+
+  ACE_ALLOC_HOOK_DECLARE;
+
+private:
+  class Cache;
+  struct Free_Block;
+
+  /// Per-thread handle on a Cache, returning it to the allocator
+  /// when the thread exits.
+  class Thread_Cache
+  {
+  public:
+    Thread_Cache ();
+    ~Thread_Cache ();
+
+    ACE_Slab_Allocator *allocator_;
+    Cache *cache_;
+  };
+
+  /// Return the calling thread's cache, getting one on first use.
+  Cache *cache ();
+
+  /// Get a cache for a thread, reusing one a thread left behind.
+  Cache *acquire_cache ();
+
+  /// Return the blocks of an exiting thread's @a cache to the
+  /// central lists and keep @a cache for the next thread.
+  void release_cache (Cache *cache);
+
+  /// Refill the empty list of class @a c in @a cache.  Returns 0 if
+  /// memory is exhausted.
+  Free_Block *refill (Cache *cache, size_t c);
+
+  /// Move a batch of blocks of class @a c from @a cache to the
+  /// central list.
+  void flush (Cache *cache, size_t c);
+
+  /// Carve a new slab into the central list of class @a c; called
+  /// with @c lock_ held.
+  int carve (size_t c);
+
+  /// Serve a request larger than max_size().
+  void *malloc_large (size_t nbytes);
+
+  /// Maximum size served from a size class.
+  size_t max_size_;
+
+  /// Size of the slabs the blocks are carved from.
+  size_t slab_size_;
+
+  /// Number of size classes.
+  size_t classes_;
+
+  /// Usable size of each class.
+  size_t *class_size_;
+
+  /// Blocks moved between a cache and the central list at a time,
+  /// for each class.
+  size_t *batch_;
+
+  /// Blocks of each class a cache keeps before it flushes a batch.
+  size_t *limit_;
+
+  /// Size class of requests, indexed by (bytes + 15) / 16.
+  unsigned char *lookup_;
+
+  /// Protects the central lists, the slab list and the caches lists.
+  ACE_SYNCH_MUTEX lock_;
+
+  /// Central free list and its length, for each class.
+  Free_Block **central_;
+  size_t *central_count_;
+
+  /// Slabs obtained from the system.
+  void *slabs_;
+
+  /// Bytes in @c slabs_.
+  size_t slab_bytes_;
+
+  /// All caches, and those left behind by threads that exited.
+  Cache *caches_;
+  Cache *idle_caches_;
+
+  /// Set while the allocator is being destroyed.
+  bool closing_;
+
+  /// Handle on the calling thread's cache.  Its key is created by the
+  /// constructor rather than on first use by some thread, and it is
+  /// declared last so that it is destroyed first.
+  ACE_TSS<Thread_Cache> tss_;
+};
+
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+#include "ace/Slab_Allocator.inl"
+#endif /* __ACE_INLINE__ */
+
+#include /**/ "ace/post.h"
+
+#endif /* ACE_SLAB_ALLOCATOR_H */
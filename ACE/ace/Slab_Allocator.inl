@@ -0,0 +1,16 @@
+// -*- C++ -*-
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE size_t
+ACE_Slab_Allocator::max_size () const
+{
+  return this->max_size_;
+}
+
+ACE_INLINE size_t
+ACE_Slab_Allocator::size_classes () const
+{
+  return this->classes_;
+}
+
+ACE_END_VERSIONED_NAMESPACE_DECL
@@ -59,7 +59,7 @@ void
 ACE_Throughput_Stats::dump_throughput (const ACE_TCHAR *msg,
                                        ACE_Basic_Stats::scale_factor_type sf,
                                        ACE_UINT64 elapsed_time,
-                                       ACE_UINT32 samples_count)
+                                       ACE_UINT64 samples_count)
 {
 #ifndef ACE_NLOGGING
   double seconds =
@@ -69,7 +69,9 @@ ACE_Throughput_Stats::dump_throughput (const ACE_TCHAR *msg,
   double t_avg = 0.0;
   if (seconds > 0.0)
     {
-      t_avg = samples_count / seconds;
+      t_avg =
+        static_cast<double> (ACE_UINT64_DBLCAST_ADAPTER (samples_count))
+        / seconds;
     }
 
   ACELIB_DEBUG ((LM_DEBUG,
@@ -59,7 +59,7 @@ public:
   static void dump_throughput (const ACE_TCHAR *msg,
                                scale_factor_type scale_factor,
                                ACE_UINT64 elapsed_time,
-                               ACE_UINT32 samples_count);
+                               ACE_UINT64 samples_count);
 private:
   /// The last throughput measurement.
   ACE_UINT64 throughput_last_ {};
@@ -144,6 +144,14 @@
 # define ACE_HAS_SCHED_SETAFFINITY 1
 #endif
 
+// sendmmsg()/recvmmsg() need both kernel and C library support
+#if defined (__GLIBC__) && !defined (ACE_LACKS_NETWORKING) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)) && \
+    (LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0))
+# define ACE_HAS_SENDMMSG 1
+# define ACE_HAS_RECVMMSG 1
+#endif
+
 // This is ghastly, but as long as there are platforms supported
 // which define the right POSIX macros but lack actual support
 // we have no choice.
@@ -0,0 +1,331 @@
+// This program compares the time ACE_New_Allocator, the locked
+// ACE_Malloc free list used for TAO's local memory pool,
+// ACE_Dynamic_Cached_Allocator (the run time sized
+// ACE_Cached_Allocator) and ACE_Slab_Allocator take per malloc()/free()
+// pair under three allocation heavy workloads:
+//
+// fixed --
+//    Every thread allocates and at once frees blocks of one size.
+//
+// mixed --
+//    Every thread keeps a window of live blocks of sizes between 16
+//    bytes and the maximum size and replaces the oldest one on each
+//    iteration.
+//
+// handoff --
+//    Pairs of threads pass blocks of assorted sizes through a ring
+//    buffer: one thread allocates them and the other one frees them,
+//    as the reactor and worker threads of a server do with the
+//    buffers of requests.
+//
+// The cached allocator only has chunks of the maximum size and is
+// given enough of them for all the live blocks of a run.
+//
+// Usage: test_allocator [-n iterations] [-t threads] [-s fixed size]
+//                       [-m max size] [-w window]
+//
+// The following are the results on a single CPU Linux virtual
+// machine, in nanoseconds per malloc()/free() pair:
+//
+// ./test_allocator
+// 1000000 iterations, 4 threads, fixed 64 bytes, mixed up to 4096 bytes, window 1024
+// nsec per malloc/free         fixed        mixed      handoff
+// new                28.1        186.6        180.2
+// malloc             58.2      20040.8        240.6
+// cached             60.8         73.2         75.3
+// slab               21.0         32.4         53.0
+//
+// ./test_allocator -s 1024 -m 65536 -w 256 -n 300000
+// new                22.6        331.1        191.3
+// malloc             45.1       4955.6        165.2
+// cached             46.0         48.9         56.2
+// slab               20.7         33.8         43.9
+//
+// The first fit free list of ACE_Malloc degrades with the number of
+// free blocks of assorted sizes, and ACE_Dynamic_Cached_Allocator
+// takes a lock for every call and needs a chunk of the maximum size
+// for every live block.  With a single CPU the threads never contend
+// for a lock, so these figures are the lower bound of what locking
+// costs.
+
+#include "ace/Log_Msg.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Malloc_Allocator.h"
+#include "ace/Malloc_T.h"
+#include "ace/Local_Memory_Pool.h"
+#include "ace/Slab_Allocator.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_main.h"
+
+#include <atomic>
+
+#if defined (ACE_HAS_THREADS)
+
+typedef ACE_Allocator_Adapter<ACE_Malloc<ACE_LOCAL_MEMORY_POOL, ACE_Thread_Mutex> >
+  LOCKED_MALLOC;
+typedef ACE_Dynamic_Cached_Allocator<ACE_Thread_Mutex> CACHED_ALLOCATOR;
+
+static size_t iterations = 1000000;
+static size_t n_threads = 4;
+static size_t fixed_size = 64;
+static size_t max_size = 4096;
+static size_t window = 1024;
+
+static size_t const ring_size = 256;
+
+// Sizes spread over [16, max_size], small ones more likely, like CDR
+// buffers.
+static size_t
+next_size (ACE_UINT32 &seed)
+{
+  seed = seed * 1103515245u + 12345u;
+  size_t const r = (seed >> 8) % 1024;
+  return 16 + (r * r / 1024) * (max_size - 16) / 1023;
+}
+
+template <typename ALLOCATOR>
+struct Run
+{
+  ALLOCATOR *allocator_;
+  size_t threads_;
+  std::atomic<size_t> next_id_;
+  std::atomic<size_t> failures_;
+
+  /// One ring per pair of handoff threads.
+  struct Ring
+  {
+    void *slots_[ring_size];
+    std::atomic<size_t> head_;
+    std::atomic<size_t> tail_;
+  } *rings_;
+};
+
+template <typename ALLOCATOR>
+static void *
+fixed_worker (Run<ALLOCATOR> *run)
+{
+  ALLOCATOR &allocator = *run->allocator_;
+  size_t const n = iterations / run->threads_;
+  for (size_t i = 0; i != n; ++i)
+    {
+      void *ptr = allocator.malloc (fixed_size);
+      if (ptr == 0)
+        {
+          ++run->failures_;
+          continue;
+        }
+      *static_cast<char *> (ptr) = 0;
+      allocator.free (ptr);
+    }
+  return 0;
+}
+
+template <typename ALLOCATOR>
+static void *
+mixed_worker (Run<ALLOCATOR> *run)
+{
+  ALLOCATOR &allocator = *run->allocator_;
+  ACE_UINT32 seed = static_cast<ACE_UINT32> (run->next_id_++);
+  void **live = new void *[window]();
+  size_t const n = iterations / run->threads_;
+  for (size_t i = 0; i != n; ++i)
+    {
+      void *&slot = live[i % window];
+      if (slot != 0)
+        allocator.free (slot);
+      slot = allocator.malloc (next_size (seed));
+      if (slot == 0)
+        ++run->failures_;
+      else
+        *static_cast<char *> (slot) = 0;
+    }
+  for (size_t i = 0; i != window; ++i)
+    if (live[i] != 0)
+      allocator.free (live[i]);
+  delete [] live;
+  return 0;
+}
+
+template <typename ALLOCATOR>
+static void *
+handoff_worker (Run<ALLOCATOR> *run)
+{
+  ALLOCATOR &allocator = *run->allocator_;
+  size_t const id = run->next_id_++;
+  typename Run<ALLOCATOR>::Ring &ring = run->rings_[id / 2];
+  size_t const n = iterations / (run->threads_ / 2);
+
+  if (id % 2 == 0)
+    {
+      ACE_UINT32 seed = static_cast<ACE_UINT32> (id);
+      for (size_t i = 0; i != n; ++i)
+        {
+          void *ptr = allocator.malloc (next_size (seed));
+          if (ptr == 0)
+            ++run->failures_;
+          else
+            *static_cast<char *> (ptr) = 0;
+
+          size_t const tail = ring.tail_.load (std::memory_order_relaxed);
+          while (tail - ring.head_.load (std::memory_order_acquire) == ring_size)
+            ACE_OS::thr_yield ();
+          ring.slots_[tail % ring_size] = ptr;
+          ring.tail_.store (tail + 1, std::memory_order_release);
+        }
+    }
+  else
+    {
+      for (size_t i = 0; i != n; ++i)
+        {
+          size_t const head = ring.head_.load (std::memory_order_relaxed);
+          while (ring.tail_.load (std::memory_order_acquire) == head)
+            ACE_OS::thr_yield ();
+          void *ptr = ring.slots_[head % ring_size];
+          ring.head_.store (head + 1, std::memory_order_release);
+          if (ptr != 0)
+            allocator.free (ptr);
+        }
+    }
+  return 0;
+}
+
+template <typename ALLOCATOR>
+static double
+time_run (ALLOCATOR &allocator, ACE_THR_FUNC worker, size_t threads)
+{
+  Run<ALLOCATOR> run;
+  run.allocator_ = &allocator;
+  run.threads_ = threads;
+  run.next_id_ = 0;
+  run.failures_ = 0;
+  run.rings_ = new typename Run<ALLOCATOR>::Ring[threads / 2 + 1];
+  for (size_t i = 0; i != threads / 2 + 1; ++i)
+    {
+      run.rings_[i].head_ = 0;
+      run.rings_[i].tail_ = 0;
+    }
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+  if (ACE_Thread_Manager::instance ()->spawn_n (threads,
+                                                worker,
+                                                &run,
+                                                THR_NEW_LWP | THR_JOINABLE) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 0.0);
+  ACE_Thread_Manager::instance ()->wait ();
+  timer.stop ();
+
+  delete [] run.rings_;
+
+  if (run.failures_ != 0)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("%B allocations failed\n"),
+                run.failures_.load ()));
+
+  ACE_hrtime_t nsec;
+  timer.elapsed_time (nsec);
+  return static_cast<double> (nsec) / iterations;
+}
+
+template <typename ALLOCATOR>
+static void
+time_allocator (const ACE_TCHAR *name, ALLOCATOR &allocator)
+{
+  double const fixed =
+    time_run (allocator, (ACE_THR_FUNC) fixed_worker<ALLOCATOR>, n_threads);
+  double const mixed =
+    time_run (allocator, (ACE_THR_FUNC) mixed_worker<ALLOCATOR>, n_threads);
+  double const handoff =
+    time_run (allocator,
+              (ACE_THR_FUNC) handoff_worker<ALLOCATOR>,
+              n_threads < 2 ? 2 : n_threads & ~size_t (1));
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%-10s %12.1f %12.1f %12.1f\n"),
+              name, fixed, mixed, handoff));
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("n:t:s:m:w:"));
+  int c;
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        iterations = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 't':
+        n_threads = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 's':
+        fixed_size = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'm':
+        max_size = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      case 'w':
+        window = ACE_OS::atoi (get_opt.opt_arg ());
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-n iterations] [-t threads] ")
+                           ACE_TEXT ("[-s fixed size] [-m max size] [-w window]\n"),
+                           argv[0]),
+                          -1);
+      }
+
+  if (n_threads == 0 || window == 0 || max_size < 16 || fixed_size > max_size)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("invalid arguments\n")), -1);
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) == -1)
+    return 1;
+
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("%B iterations, %B threads, fixed %B bytes, ")
+              ACE_TEXT ("mixed up to %B bytes, window %B\n"),
+              iterations, n_threads, fixed_size, max_size, window));
+  ACE_DEBUG ((LM_DEBUG,
+              ACE_TEXT ("nsec per malloc/free  %12s %12s %12s\n"),
+              ACE_TEXT ("fixed"), ACE_TEXT ("mixed"), ACE_TEXT ("handoff")));
+
+  {
+    ACE_New_Allocator allocator;
+    time_allocator (ACE_TEXT ("new"), allocator);
+  }
+  {
+    LOCKED_MALLOC allocator;
+    time_allocator (ACE_TEXT ("malloc"), allocator);
+  }
+  {
+    CACHED_ALLOCATOR allocator (n_threads * window + n_threads * ring_size,
+                                max_size);
+    time_allocator (ACE_TEXT ("cached"), allocator);
+  }
+  {
+    ACE_Slab_Allocator allocator;
+    time_allocator (ACE_TEXT ("slab"), allocator);
+  }
+
+  return 0;
+}
+
+#else
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR_RETURN ((LM_ERROR,
+                     ACE_TEXT ("threads not supported on this platform\n")),
+                    0);
+}
+#endif /* ACE_HAS_THREADS */
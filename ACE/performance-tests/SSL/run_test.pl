@@ -0,0 +1,30 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+
+$SV = new PerlACE::Process ("ssl_test", "-n 200 -b 64");
+
+$test = $SV->SpawnWaitKill (300);
+
+if ($test != 0) {
+    print "ERROR: ssl_test returned $test\n";
+    $status = 1;
+}
+
+$AS = new PerlACE::Process ("ssl_asynch_test", "-m 64");
+
+$test = $AS->SpawnWaitKill (300);
+
+if ($test != 0) {
+    print "ERROR: ssl_asynch_test returned $test\n";
+    $status = 1;
+}
+
+exit $status;
@@ -0,0 +1,461 @@
+//=============================================================================
+/**
+ *  @file   ssl_asynch_test.cpp
+ *
+ * Measures the bulk throughput of ACE_SSL_Asynch_Stream over the
+ * loopback interface with the proactor, for single message blocks
+ * (read() and write()) and for chains of message blocks (readv() and
+ * writev()), and checks the data received.  The proactor
+ * implementation can be chosen on POSIX platforms.
+ */
+//=============================================================================
+
+#include "ace/SSL/SSL_Asynch_Stream.h"
+
+#if defined (ACE_WIN32) || defined (ACE_HAS_AIO_CALLS)
+
+#include "ace/SSL/SSL_Context.h"
+#include "ace/SOCK_Acceptor.h"
+#include "ace/SOCK_Connector.h"
+#include "ace/SOCK_Stream.h"
+#include "ace/INET_Addr.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Message_Block.h"
+#include "ace/Proactor.h"
+#if defined (ACE_WIN32)
+#  include "ace/WIN32_Proactor.h"
+#else
+#  include "ace/POSIX_Proactor.h"
+#  include "ace/POSIX_CB_Proactor.h"
+#endif /* ACE_WIN32 */
+#include "ace/Log_Msg.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_ctype.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/os_include/netinet/os_tcp.h"
+
+static const ACE_TCHAR *certificate = ACE_TEXT ("server_cert.pem");
+static const ACE_TCHAR *private_key = ACE_TEXT ("server_key.pem");
+static size_t total_bytes = 256u * 1024u * 1024u;
+static size_t block_size = 16384u;
+static size_t chain_length = 4u;
+static ACE_TCHAR proactor_type = ACE_TEXT ('d');
+
+// Every block sent holds the same bytes, and every write is of whole
+// blocks but the last, so the stream repeats them.
+static char
+pattern (size_t offset)
+{
+  return static_cast<char> ((offset % block_size) % 251);
+}
+
+// Chain of <count> message blocks of <block_size> bytes.
+static ACE_Message_Block *
+make_chain (size_t count)
+{
+  ACE_Message_Block *head = 0;
+  for (size_t i = count; i != 0; --i)
+    {
+      ACE_Message_Block *mb = 0;
+      ACE_NEW_RETURN (mb, ACE_Message_Block (block_size), 0);
+      mb->cont (head);
+      head = mb;
+    }
+  return head;
+}
+
+class Sender : public ACE_Handler
+{
+public:
+  Sender (ACE_SSL_Context &context, size_t blocks)
+    : stream_ (ACE_SSL_Asynch_Stream::ST_CLIENT, &context),
+      chain_ (make_chain (blocks)),
+      chained_ (blocks > 1),
+      sent_ (0),
+      closed_ (false),
+      failed_ (false)
+  {
+    for (ACE_Message_Block *mb = this->chain_; mb != 0; mb = mb->cont ())
+      {
+        for (size_t i = 0; i != block_size; ++i)
+          mb->wr_ptr ()[i] = pattern (i);
+        mb->wr_ptr (block_size);
+      }
+  }
+
+  ~Sender ()
+  {
+    this->chain_->release ();
+  }
+
+  int open (ACE_HANDLE handle)
+  {
+    if (this->stream_.open (*this, handle) != 0)
+      return -1;
+    return this->send ();
+  }
+
+  int send ()
+  {
+    for (ACE_Message_Block *mb = this->chain_; mb != 0; mb = mb->cont ())
+      mb->rd_ptr (mb->base ());
+
+    size_t const left = total_bytes - this->sent_;
+    size_t const n = this->chained_ ? this->chain_->total_length () : block_size;
+    if (this->chained_)
+      return this->stream_.writev (*this->chain_, left < n ? left : n);
+    return this->stream_.write (*this->chain_, left < n ? left : n);
+  }
+
+  void handle_write_stream (const ACE_Asynch_Write_Stream::Result &result) override
+  {
+    if (!result.success () || result.bytes_transferred () == 0)
+      {
+        errno = result.error ();
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("write")));
+        this->failed_ = true;
+        return;
+      }
+
+    this->sent_ += result.bytes_transferred ();
+    if (this->sent_ < total_bytes && this->send () != 0)
+      this->failed_ = true;
+  }
+
+  void handle_wakeup () override
+  {
+    this->closed_ = true;
+  }
+
+  ACE_SSL_Asynch_Stream stream_;
+  ACE_Message_Block *chain_;
+  bool chained_;
+  size_t sent_;
+  bool closed_;
+  bool failed_;
+};
+
+class Receiver : public ACE_Handler
+{
+public:
+  Receiver (ACE_SSL_Context &context, size_t blocks)
+    : stream_ (ACE_SSL_Asynch_Stream::ST_SERVER, &context),
+      chain_ (make_chain (blocks)),
+      chained_ (blocks > 1),
+      received_ (0),
+      reads_ (0),
+      corrupt_ (0),
+      closed_ (false),
+      failed_ (false)
+  {
+  }
+
+  ~Receiver ()
+  {
+    this->chain_->release ();
+  }
+
+  int open (ACE_HANDLE handle)
+  {
+    if (this->stream_.open (*this, handle) != 0)
+      return -1;
+    return this->receive ();
+  }
+
+  int receive ()
+  {
+    for (ACE_Message_Block *mb = this->chain_; mb != 0; mb = mb->cont ())
+      mb->reset ();
+
+    if (this->chained_)
+      return this->stream_.readv (*this->chain_,
+                                  this->chain_->total_size ());
+    return this->stream_.read (*this->chain_, block_size);
+  }
+
+  void handle_read_stream (const ACE_Asynch_Read_Stream::Result &result) override
+  {
+    if (!result.success () || result.bytes_transferred () == 0)
+      {
+        errno = result.error ();
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("read")));
+        this->failed_ = true;
+        return;
+      }
+
+    ++this->reads_;
+
+    // The result moved the write pointers of all the blocks filled.
+    size_t got = 0;
+    for (ACE_Message_Block *mb = this->chain_; mb != 0; mb = mb->cont ())
+      for (const char *p = mb->rd_ptr (); p != mb->wr_ptr (); ++p, ++got)
+        if (*p != pattern (this->received_ + got))
+          ++this->corrupt_;
+
+    if (got != result.bytes_transferred ())
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("read %B bytes, blocks hold %B\n"),
+                    result.bytes_transferred (),
+                    got));
+        this->failed_ = true;
+        return;
+      }
+
+    this->received_ += got;
+    if (this->received_ < total_bytes && this->receive () != 0)
+      this->failed_ = true;
+  }
+
+  void handle_wakeup () override
+  {
+    this->closed_ = true;
+  }
+
+  ACE_SSL_Asynch_Stream stream_;
+  ACE_Message_Block *chain_;
+  bool chained_;
+  size_t received_;
+  size_t reads_;
+  size_t corrupt_;
+  bool closed_;
+  bool failed_;
+};
+
+// Like TAO, which disables Nagle's algorithm by default once a
+// connection is established.
+static int
+set_nodelay (ACE_SOCK_Stream &stream)
+{
+  int nodelay = 1;
+  return stream.set_option (ACE_IPPROTO_TCP,
+                            TCP_NODELAY,
+                            &nodelay,
+                            sizeof nodelay);
+}
+
+static int
+run (const char *name,
+     size_t blocks,
+     ACE_SSL_Context &client_context,
+     ACE_SSL_Context &server_context,
+     ACE_SOCK_Acceptor &acceptor,
+     const ACE_INET_Addr &server_addr)
+{
+  ACE_SOCK_Stream client;
+  ACE_SOCK_Stream server;
+  ACE_SOCK_Connector connector;
+  if (connector.connect (client, server_addr) == -1
+      || acceptor.accept (server) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("connect")), -1);
+  set_nodelay (client);
+  set_nodelay (server);
+
+  ACE_Proactor *proactor = ACE_Proactor::instance ();
+  Sender sender (client_context, blocks);
+  Receiver receiver (server_context, blocks);
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  if (receiver.open (server.get_handle ()) != 0
+      || sender.open (client.get_handle ()) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), -1);
+
+  // handle_events() may return without dispatching anything, so
+  // give up only when nothing moved for a while.
+  ACE_Time_Value wait (5);
+  size_t progress = 0;
+  while (receiver.received_ < total_bytes
+         && !receiver.failed_
+         && !sender.failed_)
+    {
+      if (proactor->handle_events (wait) == -1
+          || wait == ACE_Time_Value::zero)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("stalled after %B bytes\n"),
+                      receiver.received_));
+          break;
+        }
+
+      if (receiver.received_ + sender.sent_ != progress)
+        {
+          progress = receiver.received_ + sender.sent_;
+          wait.set (5, 0);
+        }
+    }
+
+  timer.stop ();
+
+  // Exchange the close notifications and wait until both streams
+  // have no operations left in progress.
+  sender.stream_.close ();
+  receiver.stream_.close ();
+  for (int i = 0; i != 100 && (!sender.closed_ || !receiver.closed_); ++i)
+    {
+      ACE_Time_Value wait (0, 100000);
+      proactor->handle_events (wait);
+    }
+  client.close ();
+  server.close ();
+
+  ACE_Time_Value elapsed;
+  timer.elapsed_time (elapsed);
+  double const seconds =
+    elapsed.sec () + elapsed.usec () / 1000000.0;
+
+  ACE_OS::printf ("%-28s %10.1f %10.1f %9lu\n",
+                  name,
+                  seconds > 0 ? receiver.received_ / seconds / (1024 * 1024) : 0.0,
+                  receiver.reads_ > 0
+                    ? static_cast<double> (receiver.received_) / receiver.reads_
+                    : 0.0,
+                  static_cast<unsigned long> (receiver.corrupt_));
+
+  if (receiver.failed_ || sender.failed_
+      || receiver.received_ != total_bytes
+      || receiver.corrupt_ != 0)
+    return -1;
+  return 0;
+}
+
+// The proactor chosen with -t, as in tests/Proactor_Test.cpp.
+static int
+make_proactor ()
+{
+#if defined (ACE_WIN32)
+  return 0;
+#else
+  ACE_POSIX_Proactor *impl = 0;
+
+  switch (ACE_OS::ace_toupper (proactor_type))
+    {
+    case ACE_TEXT ('D'):
+      return 0;
+    case ACE_TEXT ('A'):
+      ACE_NEW_RETURN (impl, ACE_POSIX_AIOCB_Proactor, -1);
+      break;
+#  if defined (ACE_HAS_POSIX_REALTIME_SIGNALS)
+    case ACE_TEXT ('I'):
+      ACE_NEW_RETURN (impl, ACE_POSIX_SIG_Proactor, -1);
+      break;
+#  endif /* ACE_HAS_POSIX_REALTIME_SIGNALS */
+#  if !defined (ACE_HAS_BROKEN_SIGEVENT_STRUCT)
+    case ACE_TEXT ('C'):
+      ACE_NEW_RETURN (impl, ACE_POSIX_CB_Proactor, -1);
+      break;
+#  endif /* !ACE_HAS_BROKEN_SIGEVENT_STRUCT */
+    default:
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("unknown proactor type %c\n"),
+                         proactor_type),
+                        -1);
+    }
+
+  ACE_Proactor *proactor = 0;
+  ACE_NEW_RETURN (proactor, ACE_Proactor (impl, true), -1);
+  ACE_Proactor::instance (proactor, true);
+  return 0;
+#endif /* ACE_WIN32 */
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("m:z:l:t:c:k:"));
+  int c;
+
+  while ((c = get_opt ()) != -1)
+    switch (c)
+      {
+      case 'm':
+        total_bytes =
+          static_cast<size_t> (ACE_OS::atoi (get_opt.opt_arg ())) * 1024u * 1024u;
+        break;
+      case 'z':
+        block_size = static_cast<size_t> (ACE_OS::atoi (get_opt.opt_arg ()));
+        break;
+      case 'l':
+        chain_length = static_cast<size_t> (ACE_OS::atoi (get_opt.opt_arg ()));
+        break;
+      case 't':
+        proactor_type = *get_opt.opt_arg ();
+        break;
+      case 'c':
+        certificate = get_opt.opt_arg ();
+        break;
+      case 'k':
+        private_key = get_opt.opt_arg ();
+        break;
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage: %s [-m <MB>] [-z <block size>] ")
+                           ACE_TEXT ("[-l <blocks per chain>] ")
+                           ACE_TEXT ("[-t <d|a|i|c proactor>] ")
+                           ACE_TEXT ("[-c <certificate>] [-k <private key>]\n"),
+                           argv[0]),
+                          -1);
+      }
+
+  if (total_bytes == 0 || block_size == 0 || chain_length < 2)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("-m and -z must be positive, -l at least 2\n")),
+                      -1);
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0 || make_proactor () != 0)
+    return 1;
+
+  ACE_SSL_Context server_context;
+  if (server_context.certificate (ACE_TEXT_ALWAYS_CHAR (certificate)) != 0
+      || server_context.private_key (ACE_TEXT_ALWAYS_CHAR (private_key)) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("cannot load %s and %s\n"),
+                       certificate,
+                       private_key),
+                      1);
+  ACE_SSL_Context client_context;
+
+  ACE_SOCK_Acceptor acceptor;
+  ACE_INET_Addr server_addr (static_cast<u_short> (0), ACE_LOCALHOST);
+  if (acceptor.open (server_addr, 1) == -1
+      || acceptor.get_local_addr (server_addr) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+
+  ACE_OS::printf ("%lu MB, %lu byte blocks, %lu blocks per chain\n",
+                  static_cast<unsigned long> (total_bytes / (1024u * 1024u)),
+                  static_cast<unsigned long> (block_size),
+                  static_cast<unsigned long> (chain_length));
+  ACE_OS::printf ("%-28s %10s %10s %9s\n",
+                  "operations", "MB/s", "bytes/read", "corrupt");
+
+  int status = 0;
+  if (run ("read, write", 1,
+           client_context, server_context, acceptor, server_addr) != 0)
+    status = 1;
+  if (run ("readv, writev", chain_length,
+           client_context, server_context, acceptor, server_addr) != 0)
+    status = 1;
+
+  acceptor.close ();
+  return status;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *[])
+{
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("This platform does not support asynchronous I/O\n")));
+  return 0;
+}
+
+#endif /* ACE_WIN32 || ACE_HAS_AIO_CALLS */
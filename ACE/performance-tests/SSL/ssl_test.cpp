@@ -0,0 +1,408 @@
+//=============================================================================
+/**
+ *  @file   ssl_test.cpp
+ *
+ * Measures the rate of TLS handshakes over the loopback interface,
+ * with and without session resumption, and the bulk throughput of
+ * ACE_SSL_SOCK_Stream::sendv() and sendfile(), with and without
+ * kernel TLS offload.
+ */
+//=============================================================================
+
+#include "ace/SSL/SSL_Context.h"
+#include "ace/SSL/SSL_SOCK_Acceptor.h"
+#include "ace/SSL/SSL_SOCK_Connector.h"
+#include "ace/SSL/SSL_SOCK_Stream.h"
+#include "ace/INET_Addr.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Thread_Manager.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_main.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Truncate.h"
+#include "ace/os_include/netinet/os_tcp.h"
+
+static const ACE_TCHAR *certificate = ACE_TEXT ("server_cert.pem");
+static const ACE_TCHAR *private_key = ACE_TEXT ("server_key.pem");
+static const ACE_TCHAR *versions = 0;
+static int connections = 500;
+static size_t bulk_bytes = 256u * 1024u * 1024u;
+static size_t chunk_size = 64u * 1024u;
+
+// The operations a connection asks the server for.
+static const char OP_HANDSHAKE = 'h';
+static const char OP_BULK = 'b';
+static const char OP_TICKETS_ON = 'T';
+static const char OP_TICKETS_OFF = 't';
+static const char OP_QUIT = 'q';
+
+static const char FILE_NAME[] = "ssl_test.dat";
+
+// Like TAO, which disables Nagle's algorithm by default once a
+// connection is established.
+static int
+set_nodelay (ACE_SSL_SOCK_Stream &stream)
+{
+  int nodelay = 1;
+  return stream.peer ().set_option (ACE_IPPROTO_TCP,
+                                    TCP_NODELAY,
+                                    &nodelay,
+                                    sizeof nodelay);
+}
+
+struct Server
+{
+  ACE_SSL_Context context;
+  ACE_SSL_SOCK_Acceptor acceptor;
+};
+
+static ACE_THR_FUNC_RETURN
+server_loop (void *arg)
+{
+  Server *server = static_cast<Server *> (arg);
+  char *buffer = new char[chunk_size];
+
+  for (bool done = false; !done; )
+    {
+      // The SSL structure of the stream is created here, so a
+      // change of the context made by the previous connection
+      // applies to this one.
+      ACE_SSL_SOCK_Stream stream (&server->context);
+      if (server->acceptor.accept (stream) == -1)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("accept")));
+          continue;
+        }
+
+      (void) set_nodelay (stream);
+
+      char op = 0;
+      if (stream.recv_n (&op, 1) != 1)
+        continue;
+
+      switch (op)
+        {
+        case OP_BULK:
+          {
+            ACE_UINT64 length = 0;
+            if (stream.recv_n (&length, sizeof length) != sizeof length)
+              break;
+
+            while (length > 0)
+              {
+                ssize_t const n = stream.recv (buffer, chunk_size);
+                if (n <= 0)
+                  break;
+                length -= static_cast<ACE_UINT64> (n);
+              }
+          }
+          break;
+
+        case OP_TICKETS_ON:
+        case OP_TICKETS_OFF:
+          server->context.session_tickets (op == OP_TICKETS_ON);
+          break;
+
+        case OP_QUIT:
+          done = true;
+          break;
+        }
+
+      // Tell the client the operation is done.  For a handshake this
+      // also makes the client read the session tickets the server
+      // sent after the handshake.
+      (void) stream.send_n (&op, 1);
+      stream.close ();
+    }
+
+  delete [] buffer;
+  return 0;
+}
+
+static int
+request (ACE_SSL_Context &context,
+         const ACE_INET_Addr &server_addr,
+         char op,
+         bool *resumed = 0)
+{
+  ACE_SSL_SOCK_Connector connector;
+  ACE_SSL_SOCK_Stream stream (&context);
+
+  char ack = 0;
+  if (connector.connect (stream, server_addr) == -1
+      || set_nodelay (stream) == -1
+      || stream.send_n (&op, 1) != 1
+      || stream.recv_n (&ack, 1) != 1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("request")), -1);
+
+  if (resumed != 0)
+    *resumed = ::SSL_session_reused (stream.ssl ()) == 1;
+
+  stream.close ();
+  return 0;
+}
+
+static int
+handshakes (const char *name,
+            ACE_SSL_Context &context,
+            const ACE_INET_Addr &server_addr)
+{
+  int resumed = 0;
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  for (int i = 0; i != connections; ++i)
+    {
+      bool reused = false;
+      if (request (context, server_addr, OP_HANDSHAKE, &reused) != 0)
+        return -1;
+
+      if (reused)
+        ++resumed;
+    }
+
+  timer.stop ();
+
+  ACE_hrtime_t usecs = 0;
+  timer.elapsed_microseconds (usecs);
+
+  ACE_OS::printf ("%-34s %10.1f %9d\n",
+                  name,
+                  connections * 1e6 / (usecs == 0 ? 1 : usecs),
+                  resumed);
+  return 0;
+}
+
+static int
+bulk (const char *name,
+      ACE_SSL_Context &context,
+      const ACE_INET_Addr &server_addr,
+      ACE_HANDLE file,
+      size_t file_size)
+{
+  ACE_SSL_SOCK_Connector connector;
+  ACE_SSL_SOCK_Stream stream (&context);
+
+  char op = OP_BULK;
+  ACE_UINT64 length = bulk_bytes;
+  if (connector.connect (stream, server_addr) == -1
+      || set_nodelay (stream) == -1
+      || stream.send_n (&op, 1) != 1
+      || stream.send_n (&length, sizeof length) != sizeof length)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("bulk")), -1);
+
+  char *buffer = new char[chunk_size];
+  ACE_OS::memset (buffer, 'x', chunk_size);
+
+  ACE_High_Res_Timer timer;
+  timer.start ();
+
+  size_t sent = 0;
+  while (sent < bulk_bytes)
+    {
+      size_t const left = bulk_bytes - sent;
+      ssize_t n = 0;
+
+      if (file == ACE_INVALID_HANDLE)
+        {
+          // Two halves, so sendv() has an actual vector to write.
+          size_t const len = left < chunk_size ? left : chunk_size;
+          iovec iov[2];
+          iov[0].iov_base = buffer;
+          iov[0].iov_len = ACE_Utils::truncate_cast<u_long> (len / 2);
+          iov[1].iov_base = buffer + len / 2;
+          iov[1].iov_len = ACE_Utils::truncate_cast<u_long> (len - len / 2);
+          n = stream.sendv (iov, 2);
+        }
+      else
+        {
+          ACE_OFF_T const offset =
+            static_cast<ACE_OFF_T> (sent % file_size);
+          size_t const len = file_size - static_cast<size_t> (offset);
+          n = stream.sendfile (file, offset, left < len ? left : len);
+        }
+
+      if (n <= 0)
+        {
+          ACE_ERROR ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("send")));
+          break;
+        }
+
+      sent += static_cast<size_t> (n);
+    }
+
+  char ack = 0;
+  (void) stream.recv_n (&ack, 1);
+
+  timer.stop ();
+
+  ACE_hrtime_t usecs = 0;
+  timer.elapsed_microseconds (usecs);
+
+  ACE_OS::printf ("%-34s %10.1f %9s\n",
+                  name,
+                  sent / (usecs == 0 ? 1.0 : static_cast<double> (usecs)),
+                  stream.ktls_send () ? "yes" : "no");
+
+  delete [] buffer;
+  stream.close ();
+  return sent == bulk_bytes ? 0 : -1;
+}
+
+static int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("c:k:n:b:z:V:"));
+
+  int c;
+  while ((c = get_opt ()) != -1)
+    {
+      switch (c)
+        {
+        case 'c':
+          certificate = get_opt.opt_arg ();
+          break;
+        case 'k':
+          private_key = get_opt.opt_arg ();
+          break;
+        case 'n':
+          connections = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+        case 'b':
+          bulk_bytes = ACE_OS::atoi (get_opt.opt_arg ()) * 1024u * 1024u;
+          break;
+        case 'z':
+          chunk_size = ACE_OS::atoi (get_opt.opt_arg ());
+          break;
+        case 'V':
+          versions = get_opt.opt_arg ();
+          break;
+        default:
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("usage: %s [-c <certificate>] ")
+                             ACE_TEXT ("[-k <private key>] [-n <handshakes>] ")
+                             ACE_TEXT ("[-b <bulk MB>] [-z <chunk size>] ")
+                             ACE_TEXT ("[-V <TLS versions>]\n"),
+                             argv[0]),
+                            -1);
+        }
+    }
+
+  if (connections <= 0 || bulk_bytes == 0 || chunk_size < 2)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("invalid arguments\n")), -1);
+
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  Server server;
+  if (server.context.certificate (ACE_TEXT_ALWAYS_CHAR (certificate)) != 0
+      || server.context.private_key (ACE_TEXT_ALWAYS_CHAR (private_key)) != 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       ACE_TEXT ("cannot load %s and %s\n"),
+                       certificate,
+                       private_key),
+                      1);
+
+  static const unsigned char sid_ctx[] = "ssl_test";
+  server.context.session_id_context (sid_ctx, sizeof sid_ctx - 1);
+
+  ACE_SSL_Context full_client;
+  ACE_SSL_Context resuming_client;
+  full_client.session_cache_mode (SSL_SESS_CACHE_OFF);
+  resuming_client.session_cache_mode (SSL_SESS_CACHE_CLIENT);
+
+  ACE_SSL_Context ktls_client;
+  bool const have_ktls = ktls_client.ktls (true) == 0;
+
+  if (versions != 0)
+    {
+      server.context.filter_versions (ACE_TEXT_ALWAYS_CHAR (versions));
+      full_client.filter_versions (ACE_TEXT_ALWAYS_CHAR (versions));
+      resuming_client.filter_versions (ACE_TEXT_ALWAYS_CHAR (versions));
+      ktls_client.filter_versions (ACE_TEXT_ALWAYS_CHAR (versions));
+    }
+
+  ACE_INET_Addr server_addr (static_cast<u_short> (0),
+                             ACE_LOCALHOST);
+  if (server.acceptor.open (server_addr, 1) == -1
+      || server.acceptor.get_local_addr (server_addr) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+
+  if (ACE_Thread_Manager::instance ()->spawn (server_loop, &server) == -1)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+
+  // A file for sendfile() to send over and over.
+  size_t const file_size = chunk_size * 64u;
+  ACE_HANDLE const file =
+    ACE_OS::open (FILE_NAME, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (file == ACE_INVALID_HANDLE)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("open")), 1);
+  {
+    char *buffer = new char[chunk_size];
+    ACE_OS::memset (buffer, 'x', chunk_size);
+    for (size_t i = 0; i != file_size / chunk_size; ++i)
+      (void) ACE_OS::write (file, buffer, chunk_size);
+    delete [] buffer;
+  }
+
+  int status = 0;
+
+  ACE_OS::printf ("%d handshakes, %lu MB in %lu byte chunks\n",
+                  connections,
+                  static_cast<unsigned long> (bulk_bytes / (1024u * 1024u)),
+                  static_cast<unsigned long> (chunk_size));
+  ACE_OS::printf ("%-34s %10s %9s\n", "handshakes", "conn/s", "resumed");
+
+  if (handshakes ("full", full_client, server_addr) != 0)
+    status = 1;
+
+  if (handshakes ("resumed, session tickets",
+                  resuming_client,
+                  server_addr) != 0)
+    status = 1;
+
+  // Without tickets the server has to find the sessions in its cache.
+  resuming_client.flush_sessions ();
+  if (request (full_client, server_addr, OP_TICKETS_OFF) != 0
+      || handshakes ("resumed, server session cache",
+                     resuming_client,
+                     server_addr) != 0
+      || request (full_client, server_addr, OP_TICKETS_ON) != 0)
+    status = 1;
+
+  ACE_OS::printf ("%-34s %10s %9s\n", "bulk", "MB/s", "ktls");
+
+  if (bulk ("sendv", full_client, server_addr,
+            ACE_INVALID_HANDLE, 0) != 0
+      || bulk ("sendfile", full_client, server_addr,
+               file, file_size) != 0)
+    status = 1;
+
+  if (!have_ktls)
+    ACE_OS::printf ("kernel TLS is not supported by this build\n");
+  else if (bulk ("sendv, ktls", ktls_client, server_addr,
+                 ACE_INVALID_HANDLE, 0) != 0
+           || bulk ("sendfile, ktls", ktls_client, server_addr,
+                    file, file_size) != 0)
+    status = 1;
+
+  (void) request (full_client, server_addr, OP_QUIT);
+  ACE_Thread_Manager::instance ()->wait ();
+
+  ACE_OS::close (file);
+  ACE_OS::unlink (FILE_NAME);
+
+  return status;
+}
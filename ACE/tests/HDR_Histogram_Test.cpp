@@ -0,0 +1,440 @@
+//=============================================================================
+/**
+ *  @file    HDR_Histogram_Test.cpp
+ *
+ *  Test of ACE_HDR_Histogram: the percentiles it reports must be
+ *  within its precision of the exact ones, for several distributions
+ *  and precisions, after accumulating per-thread histograms and after
+ *  an encode/decode round trip.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/HDR_Histogram.h"
+#include "ace/Thread_Manager.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  typedef std::vector<ACE_UINT64> Samples;
+
+  double const percents[] =
+    { 0.0, 1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 99.99, 100.0 };
+  size_t const n_percents = sizeof percents / sizeof percents[0];
+
+  /// Deterministic generator, so a failure can be reproduced.
+  class Random
+  {
+  public:
+    explicit Random (ACE_UINT64 seed)
+      : state_ (seed * 2 + 1)
+    {
+    }
+
+    ACE_UINT64 next ()
+    {
+      this->state_ ^= this->state_ << 13;
+      this->state_ ^= this->state_ >> 7;
+      this->state_ ^= this->state_ << 17;
+      return this->state_;
+    }
+
+  private:
+    ACE_UINT64 state_;
+  };
+
+  enum Distribution
+  {
+    SMALL,        // Counted exactly
+    UNIFORM,      // Latencies in nanoseconds, up to a millisecond
+    LONG_TAIL,    // Spread over the whole 64-bit range
+    LARGE,        // Near the top of the range
+    DISTRIBUTIONS
+  };
+
+  const ACE_TCHAR *const names[] =
+    {
+      ACE_TEXT ("small"),
+      ACE_TEXT ("uniform"),
+      ACE_TEXT ("long tail"),
+      ACE_TEXT ("large")
+    };
+
+  ACE_UINT64
+  draw (Random &random, Distribution distribution)
+  {
+    switch (distribution)
+      {
+      case SMALL:
+        return random.next () % 200;
+      case UNIFORM:
+        return 20000 + random.next () % 1000000;
+      case LONG_TAIL:
+        return random.next () >> (random.next () % 64);
+      default:
+        return random.next () | (static_cast<ACE_UINT64> (1) << 63);
+      }
+  }
+
+  /// The exact sample at the rank ACE_HDR_Histogram::percentile()
+  /// looks for.
+  ACE_UINT64
+  exact_percentile (const Samples &sorted, double percent)
+  {
+    double const exact = percent * static_cast<double> (sorted.size ()) / 100.0;
+    size_t rank = static_cast<size_t> (exact);
+    if (static_cast<double> (rank) < exact)
+      ++rank;
+    if (rank == 0)
+      rank = 1;
+    if (rank > sorted.size ())
+      rank = sorted.size ();
+    return sorted[rank - 1];
+  }
+
+  /// Check every percentile of @a histogram against the exact ones,
+  /// allowing for @a precision bits.
+  int
+  check_percentiles (const ACE_TCHAR *what,
+                     const ACE_HDR_Histogram &histogram,
+                     const Samples &sorted,
+                     unsigned int precision)
+  {
+    int errors = 0;
+
+    if (histogram.samples_count () != sorted.size ())
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%s: %Q samples, expected %B\n"),
+                    what, histogram.samples_count (), sorted.size ()));
+        ++errors;
+      }
+
+    if (histogram.min () != sorted.front ()
+        || histogram.max () != sorted.back ())
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("%s: min/max %Q/%Q, expected %Q/%Q\n"),
+                    what, histogram.min (), histogram.max (),
+                    sorted.front (), sorted.back ()));
+        ++errors;
+      }
+
+    for (size_t i = 0; i != n_percents; ++i)
+      {
+        ACE_UINT64 const exact = exact_percentile (sorted, percents[i]);
+        ACE_UINT64 const reported = histogram.percentile (percents[i]);
+
+        // Never below the exact sample, and above it by less than
+        // 2^-precision of it.
+        if (reported < exact || reported - exact > (exact >> precision))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("%s: p%.2f is %Q, exact %Q, precision %u\n"),
+                        what, percents[i], reported, exact, precision));
+            ++errors;
+          }
+      }
+
+    return errors;
+  }
+
+  int
+  test_error_bounds ()
+  {
+    int errors = 0;
+    unsigned int const precisions[] = { 1, 3, 7, 12 };
+    size_t const n_samples = 100000;
+
+    for (int d = 0; d != DISTRIBUTIONS; ++d)
+      {
+        Random random (d);
+        Samples samples;
+        samples.reserve (n_samples);
+        for (size_t i = 0; i != n_samples; ++i)
+          samples.push_back (draw (random, static_cast<Distribution> (d)));
+
+        Samples sorted (samples);
+        std::sort (sorted.begin (), sorted.end ());
+
+        for (size_t p = 0; p != sizeof precisions / sizeof precisions[0]; ++p)
+          {
+            ACE_HDR_Histogram histogram (precisions[p]);
+            for (size_t i = 0; i != samples.size (); ++i)
+              histogram.sample (samples[i]);
+
+            errors += check_percentiles (names[d], histogram, sorted,
+                                         precisions[p]);
+          }
+      }
+
+    // Values counted several at a time.
+    ACE_HDR_Histogram histogram;
+    Samples sorted;
+    for (ACE_UINT64 value = 1; value < 1000000000; value *= 3)
+      {
+        histogram.sample (value, value % 7 + 1);
+        sorted.insert (sorted.end (), value % 7 + 1, value);
+      }
+    histogram.sample (42, 0);
+    errors += check_percentiles (ACE_TEXT ("counted"), histogram, sorted,
+                                 histogram.precision ());
+
+    histogram.reset ();
+    if (histogram.samples_count () != 0 || histogram.percentile (50.0) != 0)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("reset histogram is not empty\n")));
+        ++errors;
+      }
+
+    return errors;
+  }
+
+  /// The samples of one thread, and the histogram it records them in.
+  struct Recorder
+  {
+    Recorder ()
+      : seed_ (0)
+    {
+    }
+
+    ACE_UINT64 seed_;
+    Samples samples_;
+    ACE_HDR_Histogram histogram_;
+  };
+
+  ACE_THR_FUNC_RETURN
+  record (void *arg)
+  {
+    Recorder *recorder = static_cast<Recorder *> (arg);
+    Random random (recorder->seed_);
+
+    for (int i = 0; i != 50000; ++i)
+      {
+        ACE_UINT64 const value =
+          draw (random, static_cast<Distribution> (i % DISTRIBUTIONS));
+        recorder->samples_.push_back (value);
+        recorder->histogram_.sample (value);
+      }
+
+    return 0;
+  }
+
+  int
+  test_accumulate ()
+  {
+    int errors = 0;
+    size_t const n_threads = 4;
+    Recorder recorders[n_threads];
+
+    for (size_t i = 0; i != n_threads; ++i)
+      {
+        recorders[i].seed_ = 100 + i;
+#if defined (ACE_HAS_THREADS)
+        if (ACE_Thread_Manager::instance ()->spawn (record,
+                                                    &recorders[i]) == -1)
+          ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn")), 1);
+#else
+        record (&recorders[i]);
+#endif /* ACE_HAS_THREADS */
+      }
+
+#if defined (ACE_HAS_THREADS)
+    ACE_Thread_Manager::instance ()->wait ();
+#endif /* ACE_HAS_THREADS */
+
+    // The same precision adds up exactly, a coarser one keeps its own
+    // bound and a finer one the bound of the recorders.
+    ACE_HDR_Histogram same;
+    ACE_HDR_Histogram coarser (4);
+    ACE_HDR_Histogram finer (10);
+    ACE_HDR_Histogram all;
+    Samples sorted;
+
+    for (size_t i = 0; i != n_threads; ++i)
+      {
+        same.accumulate (recorders[i].histogram_);
+        coarser.accumulate (recorders[i].histogram_);
+        finer.accumulate (recorders[i].histogram_);
+
+        const Samples &samples = recorders[i].samples_;
+        sorted.insert (sorted.end (), samples.begin (), samples.end ());
+        for (size_t j = 0; j != samples.size (); ++j)
+          all.sample (samples[j]);
+      }
+    std::sort (sorted.begin (), sorted.end ());
+
+    errors += check_percentiles (ACE_TEXT ("same precision"), same, sorted,
+                                 same.precision ());
+    errors += check_percentiles (ACE_TEXT ("coarser"), coarser, sorted,
+                                 coarser.precision ());
+    errors += check_percentiles (ACE_TEXT ("finer"), finer, sorted,
+                                 same.precision ());
+
+    for (size_t i = 0; i != n_percents; ++i)
+      {
+        if (same.percentile (percents[i]) != all.percentile (percents[i]))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("accumulated p%.2f is %Q, not %Q\n"),
+                        percents[i], same.percentile (percents[i]),
+                        all.percentile (percents[i])));
+            ++errors;
+          }
+      }
+
+    if (same.mean () != all.mean ())
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("accumulated mean is %f, not %f\n"),
+                    same.mean (), all.mean ()));
+        ++errors;
+      }
+
+    same.dump_results (ACE_TEXT ("Accumulated"), 1);
+
+    return errors;
+  }
+
+  int
+  test_encoding ()
+  {
+    int errors = 0;
+    Random random (7);
+    ACE_HDR_Histogram histogram (5);
+    Samples sorted;
+
+    for (int i = 0; i != 200000; ++i)
+      {
+        ACE_UINT64 const value = draw (random, LONG_TAIL);
+        histogram.sample (value);
+        sorted.push_back (value);
+      }
+    std::sort (sorted.begin (), sorted.end ());
+
+    size_t const size = histogram.encode (0, 0);
+    std::vector<char> buffer (size);
+    if (histogram.encode (&buffer[0], buffer.size ()) != size)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("encode changed its size\n")));
+        ++errors;
+      }
+
+    ACE_DEBUG ((LM_DEBUG,
+                ACE_TEXT ("%Q samples encoded in %B bytes\n"),
+                histogram.samples_count (), size));
+
+    // Decoded into the default precision, twice.
+    ACE_HDR_Histogram decoded;
+    if (decoded.decode (&buffer[0], buffer.size ()) != 0
+        || decoded.decode (&buffer[0], buffer.size ()) != 0)
+      ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("cannot decode\n")), errors + 1);
+
+    Samples twice;
+    for (size_t i = 0; i != sorted.size (); ++i)
+      twice.insert (twice.end (), 2, sorted[i]);
+    errors += check_percentiles (ACE_TEXT ("decoded"), decoded, twice,
+                                 histogram.precision ());
+
+    if (decoded.mean () != histogram.mean ())
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("decoded mean is %f, not %f\n"),
+                    decoded.mean (), histogram.mean ()));
+        ++errors;
+      }
+
+    // Truncated or damaged encodings are refused and add nothing.
+    ACE_HDR_Histogram empty;
+    for (size_t length = 0; length < size; length += 1 + length / 8)
+      {
+        if (empty.decode (&buffer[0], length) != -1)
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("decoded %B of %B bytes\n"),
+                        length, size));
+            ++errors;
+          }
+      }
+
+    buffer[0] = 'X';
+    if (empty.decode (&buffer[0], buffer.size ()) != -1)
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("decoded a bad header\n")));
+        ++errors;
+      }
+
+    if (empty.samples_count () != 0)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("failed decodes added %Q samples\n"),
+                    empty.samples_count ()));
+        ++errors;
+      }
+
+    return errors;
+  }
+
+  int
+  test_highest_value ()
+  {
+    int errors = 0;
+    ACE_HDR_Histogram histogram (7, 1000);
+    Samples sorted;
+
+    for (ACE_UINT64 value = 0; value != 999; ++value)
+      {
+        histogram.sample (value);
+        sorted.push_back (value);
+      }
+    histogram.sample (1000000);
+    sorted.push_back (1000000);
+
+    // Only the largest sample is past the highest value.
+    for (size_t i = 0; i != n_percents; ++i)
+      {
+        if (percents[i] > 99.9)
+          continue;
+
+        ACE_UINT64 const exact = exact_percentile (sorted, percents[i]);
+        ACE_UINT64 const reported = histogram.percentile (percents[i]);
+        if (reported < exact || reported - exact > (exact >> 7))
+          {
+            ACE_ERROR ((LM_ERROR,
+                        ACE_TEXT ("clamped p%.2f is %Q, exact %Q\n"),
+                        percents[i], reported, exact));
+            ++errors;
+          }
+      }
+
+    if (histogram.max () != 1000000 || histogram.percentile (100.0) != 1000000)
+      {
+        ACE_ERROR ((LM_ERROR,
+                    ACE_TEXT ("clamped max is %Q, p100 %Q\n"),
+                    histogram.max (), histogram.percentile (100.0)));
+        ++errors;
+      }
+
+    return errors;
+  }
+}
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("HDR_Histogram_Test"));
+
+  int status = test_error_bounds ();
+  status += test_accumulate ();
+  status += test_encoding ();
+  status += test_highest_value ();
+
+  if (status != 0)
+    ACE_ERROR ((LM_ERROR, ACE_TEXT ("%d errors\n"), status));
+
+  ACE_END_TEST;
+  return status != 0;
+}
@@ -0,0 +1,320 @@
+//=============================================================================
+/**
+ *  @file    Slab_Allocator_Test.cpp
+ *
+ *  Test of ACE_Slab_Allocator: size classes, large blocks, reuse of
+ *  freed blocks, message blocks and blocks freed by threads other
+ *  than the one that allocated them.
+ */
+//=============================================================================
+
+
+#include "test_config.h"
+#include "ace/Slab_Allocator.h"
+#include "ace/Malloc.h"
+#include "ace/Message_Block.h"
+#include "ace/Barrier.h"
+#include "ace/Thread_Manager.h"
+#include "ace/OS_NS_string.h"
+
+#include <atomic>
+
+static char
+pattern (const void *block, size_t i)
+{
+  return static_cast<char> ((reinterpret_cast<size_t> (block) >> 4) + i);
+}
+
+static void
+fill (void *block, size_t size)
+{
+  char *p = static_cast<char *> (block);
+  for (size_t i = 0; i != size; ++i)
+    p[i] = pattern (block, i);
+}
+
+static bool
+check (const void *block, size_t size)
+{
+  const char *p = static_cast<const char *> (block);
+  for (size_t i = 0; i != size; ++i)
+    if (p[i] != pattern (block, i))
+      return false;
+  return true;
+}
+
+static int
+test_sizes ()
+{
+  int status = 0;
+  ACE_Slab_Allocator allocator (65536);
+
+  if (allocator.max_size () < 65536)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("max_size %B below 65536\n"),
+                  allocator.max_size ()));
+      status = 1;
+    }
+
+  size_t previous = 0;
+  for (size_t size = 0; size <= allocator.max_size () + 4096; size += 7)
+    {
+      void *ptr = allocator.malloc (size);
+      if (ptr == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("malloc (%B) failed\n"),
+                           size),
+                          1);
+
+      size_t const usable = allocator.block_size (ptr);
+      if (usable < size || usable < previous)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("malloc (%B) gave %B bytes, previous %B\n"),
+                      size, usable, previous));
+          status = 1;
+        }
+      if (size <= allocator.max_size () && size >= 128 && usable > size + size / 4)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("malloc (%B) wastes %B bytes\n"),
+                      size, usable - size));
+          status = 1;
+        }
+      if (reinterpret_cast<size_t> (ptr) % ACE_MALLOC_ALIGN != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("malloc (%B) misaligned at %@\n"),
+                      size, ptr));
+          status = 1;
+        }
+      previous = usable;
+
+      fill (ptr, usable);
+      if (!check (ptr, usable))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("block of %B bytes overwritten\n"),
+                      size));
+          status = 1;
+        }
+      allocator.free (ptr);
+    }
+
+  // A freed block is handed out again by the next request of its class.
+  void *first = allocator.malloc (100);
+  allocator.free (first);
+  void *second = allocator.malloc (110);
+  if (first != second)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  ACE_TEXT ("freed block %@ not reused, got %@\n"),
+                  first, second));
+      status = 1;
+    }
+  allocator.free (second);
+
+  char *zeroed = static_cast<char *> (allocator.calloc (10, 30, 'x'));
+  if (zeroed == 0)
+    ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("calloc failed\n")), 1);
+  for (size_t i = 0; i != 300; ++i)
+    if (zeroed[i] != 'x')
+      {
+        ACE_ERROR ((LM_ERROR, ACE_TEXT ("calloc byte %B not set\n"), i));
+        status = 1;
+        break;
+      }
+  allocator.free (zeroed);
+  allocator.free (0);
+
+  void *name = 0;
+  if (allocator.find ("name", name) != -1 || errno != ENOTSUP)
+    {
+      ACE_ERROR ((LM_ERROR, ACE_TEXT ("find should not be supported\n")));
+      status = 1;
+    }
+
+  return status;
+}
+
+static int
+test_message_blocks ()
+{
+  int status = 0;
+  ACE_Slab_Allocator allocator;
+
+  for (size_t size = 1; size <= 32768; size *= 2)
+    {
+      ACE_Message_Block *mb = 0;
+      ACE_NEW_RETURN (mb,
+                      ACE_Message_Block (size,
+                                         ACE_Message_Block::MB_DATA,
+                                         0,
+                                         0,
+                                         &allocator,
+                                         0,
+                                         ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
+                                         ACE_Time_Value::zero,
+                                         ACE_Time_Value::max_time,
+                                         &allocator),
+                      1);
+      if (mb->size () != size)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("message block of %B bytes has %B\n"),
+                      size, mb->size ()));
+          status = 1;
+        }
+
+      ACE_OS::memset (mb->wr_ptr (), 'm', size);
+      mb->wr_ptr (size);
+
+      ACE_Message_Block *copy = mb->clone ();
+      if (copy == 0 || ACE_OS::memcmp (copy->rd_ptr (), mb->rd_ptr (), size) != 0)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("clone of %B bytes differs\n"),
+                      size));
+          status = 1;
+        }
+      if (copy != 0)
+        copy->release ();
+      mb->release ();
+    }
+
+  return status;
+}
+
+#if defined (ACE_HAS_THREADS)
+
+static size_t const n_threads = 4;
+static size_t const n_rounds = 200;
+static size_t const n_blocks = 256;
+
+struct Ring
+{
+  Ring (ACE_Slab_Allocator &allocator)
+    : allocator_ (allocator),
+      barrier_ (n_threads),
+      next_id_ (0),
+      errors_ (0)
+  {
+  }
+
+  ACE_Slab_Allocator &allocator_;
+  ACE_Barrier barrier_;
+  std::atomic<size_t> next_id_;
+  std::atomic<int> errors_;
+
+  /// Blocks each thread allocated in the current round.
+  void *blocks_[n_threads][n_blocks];
+};
+
+// Each round every thread allocates blocks of assorted sizes, then
+// checks and frees those its neighbour allocated.
+
+static void *
+ring_worker (Ring *ring)
+{
+  size_t const id = ring->next_id_++;
+  size_t const neighbour = (id + 1) % n_threads;
+
+  for (size_t round = 0; round != n_rounds; ++round)
+    {
+      for (size_t i = 0; i != n_blocks; ++i)
+        {
+          size_t const size = 8 + ((i * 131 + round * 17 + id) % 2048);
+          void *ptr = ring->allocator_.malloc (size);
+          if (ptr == 0)
+            {
+              ++ring->errors_;
+              ring->blocks_[id][i] = 0;
+              continue;
+            }
+          fill (ptr, size);
+          ring->blocks_[id][i] = ptr;
+        }
+
+      ring->barrier_.wait ();
+
+      for (size_t i = 0; i != n_blocks; ++i)
+        {
+          void *ptr = ring->blocks_[neighbour][i];
+          size_t const size = 8 + ((i * 131 + round * 17 + neighbour) % 2048);
+          if (ptr != 0 && !check (ptr, size))
+            {
+              ACE_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%t) round %B block %B corrupt\n"),
+                          round, i));
+              ++ring->errors_;
+            }
+          ring->allocator_.free (ptr);
+        }
+
+      ring->barrier_.wait ();
+    }
+
+  return 0;
+}
+
+static int
+test_threads ()
+{
+  int status = 0;
+  ACE_Slab_Allocator allocator;
+
+  for (int pass = 0; pass != 3; ++pass)
+    {
+      Ring ring (allocator);
+      if (ACE_Thread_Manager::instance ()->spawn_n
+          (n_threads,
+           (ACE_THR_FUNC) ring_worker,
+           (void *) &ring,
+           THR_NEW_LWP | THR_JOINABLE) == -1)
+        ACE_ERROR_RETURN ((LM_ERROR, ACE_TEXT ("%p\n"), ACE_TEXT ("spawn_n")), 1);
+
+      ACE_Thread_Manager::instance ()->wait ();
+
+      size_t const bytes = allocator.slab_bytes ();
+      ACE_DEBUG ((LM_DEBUG,
+                  ACE_TEXT ("pass %d: %d errors, %B slab bytes\n"),
+                  pass, ring.errors_.load (), bytes));
+      if (ring.errors_ != 0)
+        status = 1;
+
+      // The threads of a pass take over the caches of the previous
+      // one, so memory in use must not grow with the passes.  Each
+      // round holds at most n_threads * n_blocks blocks of up to 2 kB.
+      if (bytes > 4 * n_threads * n_blocks * 2048)
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("pass %d: %B slab bytes, freed blocks not reused\n"),
+                      pass, bytes));
+          status = 1;
+        }
+    }
+
+  return status;
+}
+
+#endif /* ACE_HAS_THREADS */
+
+int
+run_main (int, ACE_TCHAR *[])
+{
+  ACE_START_TEST (ACE_TEXT ("Slab_Allocator_Test"));
+
+  int status = test_sizes ();
+  status += test_message_blocks ();
+
+#if defined (ACE_HAS_THREADS)
+  status += test_threads ();
+#else
+  ACE_ERROR ((LM_INFO,
+              ACE_TEXT ("threads not supported on this platform\n")));
+#endif /* ACE_HAS_THREADS */
+
+  ACE_END_TEST;
+  return status;
+}
@@ -187,6 +187,31 @@ int be_visitor_union_cs::visit_union (be_union *node)
 
   *os << be_uidt_nl << "}" << be_nl_2;
 
+  // Move constructor.  Every branch that owns memory keeps it behind
+  // a pointer in u_.  Start out empty with the default discriminator,
+  // as the default constructor does but without creating the branch,
+  // and swap with the source, which is left in that state and
+  // releases nothing when it is reset or destroyed.
+  *os << node->name () << "::" << node->local_name ()
+      << " (::" << node->name () << " &&u) noexcept" << be_nl
+      << "{" << be_idt_nl
+      << "ACE_OS::memset (&this->u_, 0, sizeof (this->u_));" << be_nl
+      << "this->disc_ = ";
+
+  if (test)
+    {
+      ub->gen_label_value (os);
+    }
+  else
+    {
+      ub->gen_default_label_value (os, node);
+    }
+
+  *os << ";" << be_nl
+      << "std::swap (this->disc_, u.disc_);" << be_nl
+      << "std::swap (this->u_, u.u_);" << be_uidt_nl
+      << "}" << be_nl_2;
+
   *os << node->name () << "::~" << node->local_name ()
       << " ()" << be_nl
       << "{" << be_idt_nl
@@ -262,6 +287,21 @@ int be_visitor_union_cs::visit_union (be_union *node)
   *os << be_nl << "return *this;" << be_uidt_nl;
   *os << "}" << be_nl_2;
 
+  // Move assignment operator.  The old contents end up in the
+  // temporary, whose destructor resets them.
+  *os << node->name () << " &" << be_nl;
+  *os << node->name () << "::operator= (::"
+      << node->name () << " &&u) noexcept" << be_nl;
+  *os << "{" << be_idt_nl;
+  *os << "if (std::addressof(u) != this)" << be_idt_nl
+      << "{" << be_idt_nl
+      << "::" << node->name () << " tmp (std::move (u));" << be_nl
+      << "std::swap (this->disc_, tmp.disc_);" << be_nl
+      << "std::swap (this->u_, tmp.u_);" << be_uidt_nl
+      << "}" << be_uidt_nl << be_nl;
+  *os << "return *this;" << be_uidt_nl;
+  *os << "}" << be_nl_2;
+
   // The reset method.
   this->ctx_->state (TAO_CodeGen::TAO_UNION_PUBLIC_RESET_CS);
 
@@ -756,6 +756,81 @@ AsyncAccessManager::send_start_request ()
       return false;
     }
 
+  StartQueue &queue = this->locator_.start_queue ();
+  if (!queue.send (startup->activator, this))
+    {
+      if (ImR_Locator_i::debug () > 4)
+        {
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                          ACE_TEXT ("(%P|%t) AsyncAccessManager(%@)::send_start_request, server <%C> queued for activator <%C>\n"),
+                          this, this->info_->ping_id(), startup->activator.c_str ()));
+        }
+      this->update_status (ImplementationRepository::AAM_WAIT_FOR_RUNNING);
+      return true;
+    }
+
+  ACE_CString const activator = startup->activator;
+  try
+    {
+      if (this->send_start_request_i ())
+        {
+          this->update_status (ImplementationRepository::AAM_WAIT_FOR_RUNNING);
+          return true;
+        }
+    }
+  catch (const CORBA::Exception &)
+    {
+      queue.done (activator);
+      throw;
+    }
+  queue.done (activator);
+  return false;
+}
+
+bool
+AsyncAccessManager::send_queued_start ()
+{
+  if (this->status_ != ImplementationRepository::AAM_WAIT_FOR_RUNNING)
+    {
+      if (ImR_Locator_i::debug () > 4)
+        {
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                          ACE_TEXT ("(%P|%t) AsyncAccessManager(%@)::send_queued_start, server <%C> no longer waited for, status <%C>\n"),
+                          this, this->info_->ping_id(), status_name (this->status_)));
+        }
+      return false;
+    }
+
+  try
+    {
+      if (this->send_start_request_i ())
+        {
+          return true;
+        }
+    }
+  catch (const CORBA::Exception &ex)
+    {
+      if (ImR_Locator_i::debug () > 1)
+        {
+          ex._tao_print_exception ("AsyncAccessManager::send_queued_start");
+        }
+      this->status (ImplementationRepository::AAM_NO_ACTIVATOR);
+    }
+  this->final_state ();
+  return false;
+}
+
+void
+AsyncAccessManager::start_request_done (const char *activator)
+{
+  this->locator_.start_queue ().done (activator);
+}
+
+bool
+AsyncAccessManager::send_start_request_i ()
+{
+  const Server_Info *startup = this->info_->active_info ();
+
   Activator_Info_Ptr ainfo =
     this->locator_.get_activator (startup->activator);
 
@@ -771,8 +846,8 @@ AsyncAccessManager::send_start_request ()
       return false;
     }
 
-  PortableServer::ServantBase_var callback = new ActivatorReceiver (this,
-                                                                    this->poa_.in());
+  PortableServer::ServantBase_var callback =
+    new ActivatorReceiver (this, this->poa_.in(), startup->activator.c_str ());
   PortableServer::ObjectId_var oid = this->poa_->activate_object (callback.in());
   CORBA::Object_var obj = this->poa_->id_to_reference (oid.in());
   ImplementationRepository::AMI_ActivatorHandler_var cb =
@@ -798,7 +873,6 @@ AsyncAccessManager::send_start_request ()
                                         startup->cmdline.c_str (),
                                         startup->dir.c_str (),
                                         startup->env_vars);
-  this->update_status (ImplementationRepository::AAM_WAIT_FOR_RUNNING);
   return true;
 }
 
@@ -829,9 +903,11 @@ AsyncAccessManager::_remove_ref ()
 //---------------------------------------------------------------------------
 
 ActivatorReceiver::ActivatorReceiver (AsyncAccessManager *aam,
-                                      PortableServer::POA_ptr poa)
+                                      PortableServer::POA_ptr poa,
+                                      const char *activator)
   :aam_ (aam->_add_ref ()),
-   poa_ (PortableServer::POA::_duplicate (poa))
+   poa_ (PortableServer::POA::_duplicate (poa)),
+   activator_ (activator)
 {
 }
 
@@ -849,6 +925,8 @@ ActivatorReceiver::start_server ()
                       this));
     }
 
+  this->aam_->start_request_done (this->activator_.c_str ());
+
   PortableServer::ObjectId_var oid = this->poa_->servant_to_id (this);
   poa_->deactivate_object (oid.in());
 }
@@ -863,6 +941,8 @@ ActivatorReceiver::start_server_excep (Messaging::ExceptionHolder *holder)
                       this));
     }
 
+  this->aam_->start_request_done (this->activator_.c_str ());
+
   try
     {
       holder->raise_exception ();
@@ -985,3 +1065,113 @@ AccessLiveListener::status_changed (LiveStatus status)
     }
   return true;
 }
+
+//---------------------------------------------------------------------------
+//---------------------------------------------------------------------------
+
+StartQueue::StartQueue ()
+  :limit_ (0),
+   queues_ (),
+   lock_ ()
+{
+  this->metrics_.sent_ = 0;
+  this->metrics_.queued_ = 0;
+  this->metrics_.max_queued_ = 0;
+}
+
+StartQueue::~StartQueue ()
+{
+  this->reset ();
+}
+
+void
+StartQueue::limit (int max)
+{
+  this->limit_ = max > 0 ? max : 0;
+}
+
+bool
+StartQueue::send (const ACE_CString &activator, AsyncAccessManager *aam)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, mon, this->lock_, true);
+  if (this->limit_ == 0)
+    {
+      ++this->metrics_.sent_;
+      return true;
+    }
+
+  Activator_Queue *queue = 0;
+  if (this->queues_.find (activator, queue) != 0)
+    {
+      ACE_NEW_RETURN (queue, Activator_Queue, true);
+      queue->in_flight_ = 0;
+      this->queues_.bind (activator, queue);
+    }
+
+  if (queue->in_flight_ < this->limit_)
+    {
+      ++queue->in_flight_;
+      ++this->metrics_.sent_;
+      return true;
+    }
+
+  AsyncAccessManager_ptr aam_ptr (aam->_add_ref ());
+  queue->pending_.enqueue_tail (aam_ptr);
+  ++this->metrics_.queued_;
+  if (queue->pending_.size () > this->metrics_.max_queued_)
+    {
+      this->metrics_.max_queued_ = queue->pending_.size ();
+    }
+  return false;
+}
+
+void
+StartQueue::done (const ACE_CString &activator)
+{
+  for (;;)
+    {
+      AsyncAccessManager_ptr next;
+      {
+        ACE_GUARD (TAO_SYNCH_MUTEX, mon, this->lock_);
+        Activator_Queue *queue = 0;
+        if (this->queues_.find (activator, queue) != 0)
+          {
+            return;
+          }
+        if (queue->pending_.dequeue_head (next) != 0)
+          {
+            --queue->in_flight_;
+            return;
+          }
+      }
+
+      // The slot of the request answered goes to the next one queued,
+      // or to the one after if that server is no longer waited for.
+      if (next->send_queued_start ())
+        {
+          ACE_GUARD (TAO_SYNCH_MUTEX, mon, this->lock_);
+          ++this->metrics_.sent_;
+          return;
+        }
+    }
+}
+
+void
+StartQueue::reset ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, mon, this->lock_);
+  for (Queue_Map::iterator i = this->queues_.begin ();
+       i != this->queues_.end ();
+       ++i)
+    {
+      delete (*i).int_id_;
+    }
+  this->queues_.unbind_all ();
+}
+
+StartQueue::Metrics
+StartQueue::metrics () const
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, mon, this->lock_, this->metrics_);
+  return this->metrics_;
+}
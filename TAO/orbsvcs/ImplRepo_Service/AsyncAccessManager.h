@@ -13,6 +13,8 @@
 #include "ImR_ActivatorS.h" // ImR_Activator_AMIS.h
 #include "ace/Vector_T.h"
 #include "ace/SString.h"
+#include "ace/Unbounded_Queue.h"
+#include "ace/Hash_Map_Manager.h"
 
 #include "Forwarder.h"
 
@@ -82,6 +84,13 @@ class Locator_Export AsyncAccessManager
   static bool is_final (ImplementationRepository::AAM_Status s);
   void update_prev_pid ();
 
+  /// Send the start request held back by the StartQueue. Returns false
+  /// if no request was sent, the server no longer being waited for.
+  bool send_queued_start ();
+
+  /// The activator replied to the start request sent to it.
+  void start_request_done (const char *activator);
+
  private:
   void report (const char* operation) const;
   void final_state (bool active = true);
@@ -90,6 +99,7 @@ class Locator_Export AsyncAccessManager
   void status (ImplementationRepository::AAM_Status s);
   void update_status (ImplementationRepository::AAM_Status s);
   bool send_start_request ();
+  bool send_start_request_i ();
 
   UpdateableServerInfo info_;
   bool manual_start_;
@@ -124,7 +134,8 @@ class ActivatorReceiver :
 {
 public:
   ActivatorReceiver (AsyncAccessManager *aam,
-                     PortableServer::POA_ptr poa);
+                     PortableServer::POA_ptr poa,
+                     const char *activator);
   virtual ~ActivatorReceiver ();
 
   void start_server ();
@@ -139,6 +150,70 @@ public:
 private:
   AsyncAccessManager_ptr aam_;
   PortableServer::POA_var poa_;
+  ACE_CString activator_;
+};
+
+//----------------------------------------------------------------------------
+/*
+ * @class StartQueue
+ *
+ * @brief bounds the number of start requests outstanding per activator
+ *
+ * When many servers are started at once, such as the AUTO_START servers
+ * of a restarted locator, sending all the start requests at once has
+ * every server start, register and get pinged at the same time. The
+ * queue lets a limited number of start requests be outstanding on each
+ * activator, and sends the next one as each reply comes in.
+ */
+class Locator_Export StartQueue
+{
+ public:
+  StartQueue ();
+  ~StartQueue ();
+
+  /// The number of start requests outstanding per activator, 0 for no
+  /// bound.
+  void limit (int max);
+
+  /// Returns true if @a aam may send its start request to @a activator
+  /// now, else queues it until a reply frees a slot.
+  bool send (const ACE_CString &activator, AsyncAccessManager *aam);
+
+  /// Called as the reply to a start request sent to @a activator comes in.
+  void done (const ACE_CString &activator);
+
+  /// Drop the queued requests.
+  void reset ();
+
+  /// Counters reported when the locator shuts down.
+  struct Metrics
+  {
+    /// Start requests sent.
+    unsigned long sent_;
+    /// Start requests that had to wait for a slot.
+    unsigned long queued_;
+    /// The most start requests waiting on an activator at once.
+    size_t max_queued_;
+  };
+  Metrics metrics () const;
+
+ private:
+  struct Activator_Queue
+  {
+    int in_flight_;
+    ACE_Unbounded_Queue<AsyncAccessManager_ptr> pending_;
+  };
+
+  typedef ACE_Hash_Map_Manager_Ex<ACE_CString,
+                                  Activator_Queue *,
+                                  ACE_Hash<ACE_CString>,
+                                  ACE_Equal_To<ACE_CString>,
+                                  ACE_Null_Mutex> Queue_Map;
+
+  int limit_;
+  Queue_Map queues_;
+  Metrics metrics_;
+  mutable TAO_SYNCH_MUTEX lock_;
 };
 
 //----------------------------------------------------------------------------
@@ -7,6 +7,7 @@
 
 #include "Locator_Repository.h"
 #include "Config_Backing_Store.h"
+#include "Journal_Backing_Store.h"
 #include "Shared_Backing_Store.h"
 #include "XML_Backing_Store.h"
 
@@ -86,6 +87,8 @@ ImR_Locator_i::init_with_orb (CORBA::ORB_ptr orb)
   this->dsi_forwarder_.init (orb);
   this->adapter_.init (& this->dsi_forwarder_);
   this->pinger_.init (orb, this->opts_->ping_interval ());
+  this->pinger_.max_pings (this->opts_->ping_concurrency ());
+  this->start_queue_.limit (this->opts_->start_concurrency ());
 
   this->opts_->pinger (&this->pinger_);
 
@@ -126,6 +129,11 @@ ImR_Locator_i::init_with_orb (CORBA::ORB_ptr orb)
         repository_.reset(new XML_Backing_Store(*this->opts_, orb));
         break;
       }
+    case Options::REPO_JOURNAL_FILE:
+      {
+        repository_.reset(new Journal_Backing_Store(*this->opts_, orb));
+        break;
+      }
     case Options::REPO_SHARED_FILES:
       {
         repository_.reset(new Shared_Backing_Store(*this->opts_, orb, this));
@@ -278,6 +286,7 @@ ImR_Locator_i::shutdown
  CORBA::Boolean activators, CORBA::Boolean servers)
 {
   this->pinger_.shutdown ();
+  this->start_queue_.reset ();
   this->aam_active_.reset ();
   this->aam_terminating_.reset ();
   if (servers != 0 && this->repository_->servers ().current_size () > 0)
@@ -366,6 +375,24 @@ ImR_Locator_i::fini ()
       if (debug_ > 1)
         ORBSVCS_DEBUG ((LM_DEBUG, ACE_TEXT ("(%P|%t) ImR: Shutting down...\n")));
 
+      if (debug_ > 0)
+        {
+          LiveCheck::Metrics const pings = this->pinger_.metrics ();
+          StartQueue::Metrics const starts = this->start_queue_.metrics ();
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                          ACE_TEXT ("(%P|%t) ImR: <%u> pings sent, at most <%d> at once, ")
+                          ACE_TEXT ("held back <%u> times\n"),
+                          static_cast<unsigned int> (pings.pings_sent_),
+                          pings.max_in_flight_,
+                          static_cast<unsigned int> (pings.pings_held_)));
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                          ACE_TEXT ("(%P|%t) ImR: <%u> start requests sent, <%u> queued, ")
+                          ACE_TEXT ("at most <%u> waiting on an activator\n"),
+                          static_cast<unsigned int> (starts.sent_),
+                          static_cast<unsigned int> (starts.queued_),
+                          static_cast<unsigned int> (starts.max_queued_)));
+        }
+
       this->root_poa_->destroy (1, 1);
 
       this->orb_->destroy ();
@@ -1662,6 +1689,12 @@ ImR_Locator_i::pinger ()
   return this->pinger_;
 }
 
+StartQueue&
+ImR_Locator_i::start_queue ()
+{
+  return this->start_queue_;
+}
+
 PortableServer::POA_ptr
 ImR_Locator_i::root_poa ()
 {
@@ -161,6 +161,7 @@ public:
   // interfaces to aid with collaboration
 
   LiveCheck &pinger ();
+  StartQueue &start_queue ();
   PortableServer::POA_ptr root_poa ();
   Activator_Info_Ptr get_activator (const ACE_CString& name);
 
@@ -225,6 +226,9 @@ private:
   /// The asynch server ping adapter
   LiveCheck pinger_;
 
+  /// The start requests held back per activator
+  StartQueue start_queue_;
+
   /// A collection of asynch activator instances
   typedef ACE_Unbounded_Set<AsyncAccessManager_ptr> AAM_Set;
   AAM_Set aam_active_;
@@ -0,0 +1,791 @@
+#include "orbsvcs/Log_Macros.h"
+#include "Journal_Backing_Store.h"
+#include "Server_Info.h"
+#include "Activator_Info.h"
+#include "tao/CDR.h"
+#include "ace/ACE.h"
+#include "ace/Message_Block.h"
+#include "ace/Vector_T.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_unistd.h"
+
+namespace {
+  /// "IMRJ"
+  const ACE_UINT32 JOURNAL_MAGIC = 0x494d524aU;
+  const ACE_UINT32 JOURNAL_VERSION = 1;
+
+  /// The header holds the magic, version and generation, and each
+  /// record is framed by its body length, the CRC-32 of the body and
+  /// its kind, all in network byte order.  Both are a multiple of
+  /// ACE_CDR::MAX_ALIGNMENT and bodies are padded to one, so every
+  /// body can be decoded in place from a buffer holding the journal.
+  const size_t HEADER_SIZE = 16;
+  const size_t FRAME_SIZE = 16;
+
+  /// Superseded and remove records are only compacted away once they
+  /// outweigh the live ones and amount to at least this many bytes.
+  const ACE_UINT64 COMPACT_THRESHOLD = 64 * 1024;
+
+  size_t padded (size_t len)
+  {
+    return ACE_align_binary (len, ACE_CDR::MAX_ALIGNMENT);
+  }
+
+  void put_u32 (char *buf, ACE_UINT32 value)
+  {
+    value = ACE_HTONL (value);
+    ACE_OS::memcpy (buf, &value, sizeof value);
+  }
+
+  ACE_UINT32 get_u32 (const char *buf)
+  {
+    ACE_UINT32 value;
+    ACE_OS::memcpy (&value, buf, sizeof value);
+    return ACE_NTOHL (value);
+  }
+
+  int read_fully (ACE_HANDLE handle, char *buf, size_t len, ACE_OFF_T offset)
+  {
+    while (len > 0)
+      {
+        ssize_t const n = ACE_OS::pread (handle, buf, len, offset);
+        if (n <= 0)
+          {
+            return -1;
+          }
+        buf += n;
+        len -= n;
+        offset += n;
+      }
+    return 0;
+  }
+
+  int write_fully (ACE_HANDLE handle, const char *buf, size_t len, ACE_OFF_T offset)
+  {
+    while (len > 0)
+      {
+        ssize_t const n = ACE_OS::pwrite (handle, buf, len, offset);
+        if (n <= 0)
+          {
+            return -1;
+          }
+        buf += n;
+        len -= n;
+        offset += n;
+      }
+    return 0;
+  }
+
+  int write_header (ACE_HANDLE handle, ACE_UINT32 generation)
+  {
+    char header[HEADER_SIZE];
+    ACE_OS::memset (header, 0, sizeof header);
+    put_u32 (header, JOURNAL_MAGIC);
+    put_u32 (header + 4, JOURNAL_VERSION);
+    put_u32 (header + 8, generation);
+    return write_fully (handle, header, sizeof header, 0);
+  }
+
+  void encode (TAO_OutputCDR& out, const Server_Info& info)
+  {
+    out << ACE_OutputCDR::from_boolean (ACE_CDR_BYTE_ORDER);
+    out << info.key_name_;
+    out << info.server_id;
+    out << info.poa_name;
+    out << ACE_OutputCDR::from_boolean (info.is_jacorb);
+    out << info.activator;
+    out << info.cmdline;
+    out << info.env_vars.length ();
+    for (CORBA::ULong i = 0; i < info.env_vars.length (); ++i)
+      {
+        out << info.env_vars[i].name.in ();
+        out << info.env_vars[i].value.in ();
+      }
+    out << info.dir;
+    out << static_cast<CORBA::ULong> (info.activation_mode_);
+    out << static_cast<CORBA::Long> (info.start_limit_);
+    out << info.partial_ior;
+    out << info.ior;
+    out << ACE_OutputCDR::from_boolean (!CORBA::is_nil (info.server.in ()));
+    out << static_cast<CORBA::Long> (info.pid);
+    out << info.peers.length ();
+    for (CORBA::ULong i = 0; i < info.peers.length (); ++i)
+      {
+        out << info.peers[i].in ();
+      }
+    out << (info.alt_info_.null () ? ACE_CString () : info.alt_info_->key_name_);
+  }
+
+  bool decode (TAO_InputCDR& in, Server_Info& info, bool& started, ACE_CString& altkey)
+  {
+    CORBA::ULong len = 0;
+    CORBA::ULong mode = 0;
+    CORBA::Long limit = 0;
+    CORBA::Long pid = 0;
+    ACE_CString name;
+    ACE_CString value;
+
+    if (!(in >> info.key_name_ &&
+          in >> info.server_id &&
+          in >> info.poa_name &&
+          in >> ACE_InputCDR::to_boolean (info.is_jacorb) &&
+          in >> info.activator &&
+          in >> info.cmdline &&
+          in >> len))
+      {
+        return false;
+      }
+    info.env_vars.length (len);
+    for (CORBA::ULong i = 0; i < len; ++i)
+      {
+        if (!(in >> name && in >> value))
+          {
+            return false;
+          }
+        info.env_vars[i].name = name.c_str ();
+        info.env_vars[i].value = value.c_str ();
+      }
+    if (!(in >> info.dir &&
+          in >> mode &&
+          in >> limit &&
+          in >> info.partial_ior &&
+          in >> info.ior &&
+          in >> ACE_InputCDR::to_boolean (started) &&
+          in >> pid &&
+          in >> len))
+      {
+        return false;
+      }
+    info.activation_mode_ =
+      static_cast<ImplementationRepository::ActivationMode> (mode);
+    info.start_limit_ = limit;
+    info.pid = pid;
+    info.peers.length (len);
+    for (CORBA::ULong i = 0; i < len; ++i)
+      {
+        if (!(in >> name))
+          {
+            return false;
+          }
+        info.peers[i] = name.c_str ();
+      }
+    return static_cast<bool> (in >> altkey);
+  }
+}
+
+Journal_Backing_Store::Journal_Backing_Store (const Options& opts,
+                                              CORBA::ORB_ptr orb)
+: Locator_Repository (opts, orb),
+  filename_ (opts.persist_file_name ()),
+  lock_ (ACE_INVALID_HANDLE, false),
+  handle_ (ACE_INVALID_HANDLE),
+  generation_ (0),
+  read_offset_ (0),
+  server_index_ (),
+  activator_index_ (),
+  live_bytes_ (0),
+  dead_bytes_ (0),
+  inode_ (0)
+{
+  if (opts.repository_erase ())
+    {
+      ACE_OS::unlink (this->filename_.c_str ());
+    }
+}
+
+Journal_Backing_Store::~Journal_Backing_Store ()
+{
+  if (this->handle_ != ACE_INVALID_HANDLE)
+    {
+      ACE_OS::close (this->handle_);
+    }
+}
+
+const ACE_TCHAR*
+Journal_Backing_Store::repo_mode () const
+{
+  return this->filename_.c_str ();
+}
+
+int
+Journal_Backing_Store::init_repo (PortableServer::POA_ptr)
+{
+  const ACE_TString lock_name = this->filename_ + ACE_TEXT (".lock");
+  if (this->lock_.open (lock_name.c_str (), O_RDWR | O_CREAT,
+                        ACE_DEFAULT_FILE_PERMS) != 0)
+    {
+      ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("(%P|%t) Couldn't open journal lock %s\n"),
+                             lock_name.c_str ()),
+                            -1);
+    }
+
+  ACE_Time_Value const start = ACE_OS::gettimeofday ();
+
+  ACE_WRITE_GUARD_RETURN (ACE_File_Lock, guard, this->lock_, -1);
+  if (this->open_journal (true) != 0)
+    {
+      return -1;
+    }
+  int const err = this->replay (true);
+  if (err == 0 &&
+      this->dead_bytes_ > this->live_bytes_ &&
+      this->dead_bytes_ >= COMPACT_THRESHOLD)
+    {
+      this->compact ();
+    }
+
+  if (this->opts_.debug () > 0)
+    {
+      ACE_Time_Value const elapsed = ACE_OS::gettimeofday () - start;
+      ORBSVCS_DEBUG ((LM_INFO,
+                      ACE_TEXT ("(%P|%t) Journal <%s> loaded %B servers and ")
+                      ACE_TEXT ("%B activators in %d msec\n"),
+                      this->filename_.c_str (),
+                      this->servers ().current_size (),
+                      this->activators ().current_size (),
+                      static_cast<int> (elapsed.msec ())));
+    }
+  return err;
+}
+
+int
+Journal_Backing_Store::open_journal (bool create)
+{
+  if (this->handle_ != ACE_INVALID_HANDLE)
+    {
+      ACE_OS::close (this->handle_);
+    }
+
+  int const flags = O_RDWR | O_BINARY | (create ? O_CREAT : 0);
+  this->handle_ = ACE_OS::open (this->filename_.c_str (), flags,
+                                ACE_DEFAULT_FILE_PERMS);
+  if (this->handle_ == ACE_INVALID_HANDLE)
+    {
+      ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("(%P|%t) Couldn't open journal %s\n"),
+                             this->filename_.c_str ()),
+                            -1);
+    }
+
+  ACE_stat st;
+  if (ACE_OS::fstat (this->handle_, &st) == 0)
+    {
+      this->inode_ = static_cast<ACE_UINT64> (st.st_ino);
+    }
+
+  if (ACE_OS::filesize (this->handle_) == 0)
+    {
+      this->generation_ = 1;
+      if (write_header (this->handle_, this->generation_) != 0)
+        {
+          ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                 ACE_TEXT ("(%P|%t) Couldn't write to journal %s\n"),
+                                 this->filename_.c_str ()),
+                                -1);
+        }
+    }
+  else
+    {
+      char header[HEADER_SIZE];
+      if (read_fully (this->handle_, header, sizeof header, 0) != 0 ||
+          get_u32 (header) != JOURNAL_MAGIC ||
+          get_u32 (header + 4) != JOURNAL_VERSION)
+        {
+          ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                 ACE_TEXT ("(%P|%t) %s is not an ImR journal\n"),
+                                 this->filename_.c_str ()),
+                                -1);
+        }
+      this->generation_ = get_u32 (header + 8);
+    }
+
+  this->read_offset_ = HEADER_SIZE;
+  return 0;
+}
+
+bool
+Journal_Backing_Store::replaced () const
+{
+  ACE_stat st;
+  return ACE_OS::stat (this->filename_.c_str (), &st) == 0 &&
+    static_cast<ACE_UINT64> (st.st_ino) != this->inode_;
+}
+
+int
+Journal_Backing_Store::full_load ()
+{
+  this->server_index_.unbind_all ();
+  this->activator_index_.unbind_all ();
+  this->live_bytes_ = 0;
+  this->dead_bytes_ = 0;
+  this->read_offset_ = HEADER_SIZE;
+
+  int const err = this->replay (false);
+  if (err != 0)
+    {
+      return err;
+    }
+
+  // Entries are updated in place, so anything held onto elsewhere
+  // stays current; only drop what the journal no longer has.
+  ACE_Vector<ACE_CString> gone;
+  Locator_Repository::SIMap::ENTRY* sientry = 0;
+  Locator_Repository::SIMap::ITERATOR siit (this->servers ());
+  for (; siit.next (sientry); siit.advance ())
+    {
+      if (this->server_index_.find (sientry->ext_id_) != 0)
+        {
+          gone.push_back (sientry->ext_id_);
+        }
+    }
+  for (size_t i = 0; i < gone.size (); ++i)
+    {
+      this->servers ().unbind (gone[i]);
+    }
+
+  gone.clear ();
+  Locator_Repository::AIMap::ENTRY* aientry = 0;
+  Locator_Repository::AIMap::ITERATOR aiit (this->activators ());
+  for (; aiit.next (aientry); aiit.advance ())
+    {
+      if (this->activator_index_.find (aientry->ext_id_) != 0)
+        {
+          gone.push_back (aientry->ext_id_);
+        }
+    }
+  for (size_t i = 0; i < gone.size (); ++i)
+    {
+      this->activators ().unbind (gone[i]);
+    }
+  return 0;
+}
+
+int
+Journal_Backing_Store::replay (bool repair)
+{
+  ACE_OFF_T const end = ACE_OS::filesize (this->handle_);
+  if (end < this->read_offset_)
+    {
+      // cut short by another locator repairing a torn tail
+      return this->full_load ();
+    }
+  if (end == this->read_offset_)
+    {
+      return 0;
+    }
+
+  size_t const len = static_cast<size_t> (end - this->read_offset_);
+  ACE_Message_Block block (len + ACE_CDR::MAX_ALIGNMENT);
+  ACE_CDR::mb_align (&block);
+  char * const buf = block.wr_ptr ();
+  if (read_fully (this->handle_, buf, len, this->read_offset_) != 0)
+    {
+      ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("(%P|%t) Couldn't read journal %s\n"),
+                             this->filename_.c_str ()),
+                            -1);
+    }
+
+  size_t pos = 0;
+  while (len - pos >= FRAME_SIZE)
+    {
+      ACE_UINT32 const size = get_u32 (buf + pos);
+      ACE_UINT32 const crc = get_u32 (buf + pos + 4);
+      ACE_UINT32 const kind = get_u32 (buf + pos + 8);
+      size_t const record = FRAME_SIZE + padded (size);
+      if (size == 0 || record > len - pos)
+        {
+          break;
+        }
+      const char * const body = buf + pos + FRAME_SIZE;
+      if (ACE::crc32 (body, size) != crc)
+        {
+          break;
+        }
+
+      TAO_InputCDR in (body, size);
+      CORBA::Boolean byte_order;
+      if (!(in >> ACE_InputCDR::to_boolean (byte_order)))
+        {
+          break;
+        }
+      in.reset_byte_order (static_cast<int> (byte_order));
+      if (this->apply (kind, in, this->read_offset_ + pos,
+                       static_cast<ACE_UINT32> (record)) != 0)
+        {
+          break;
+        }
+      pos += record;
+    }
+
+  this->read_offset_ += pos;
+  if (pos != len)
+    {
+      if (repair)
+        {
+          ORBSVCS_ERROR ((LM_WARNING,
+                          ACE_TEXT ("(%P|%t) Dropping %B bytes of torn or ")
+                          ACE_TEXT ("corrupt records from journal %s\n"),
+                          len - pos, this->filename_.c_str ()));
+          ACE_OS::ftruncate (this->handle_, this->read_offset_);
+        }
+      else
+        {
+          ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                 ACE_TEXT ("(%P|%t) Corrupt record at offset ")
+                                 ACE_TEXT ("%q of journal %s\n"),
+                                 static_cast<ACE_INT64> (this->read_offset_),
+                                 this->filename_.c_str ()),
+                                -1);
+        }
+    }
+  return 0;
+}
+
+int
+Journal_Backing_Store::apply (ACE_UINT32 kind,
+                              TAO_InputCDR& body,
+                              ACE_OFF_T offset,
+                              ACE_UINT32 size)
+{
+  switch (kind)
+    {
+    case SERVER_UPDATE:
+      {
+        Server_Info *info = 0;
+        ACE_NEW_RETURN (info, Server_Info, -1);
+        Server_Info_Ptr decoded (info);
+        bool started = false;
+        ACE_CString altkey;
+        if (!decode (body, *info, started, altkey))
+          {
+            return -1;
+          }
+
+        if (altkey.length () > 0 &&
+            this->servers ().find (altkey, info->alt_info_) != 0)
+          {
+            Server_Info *base_si = 0;
+            ACE_NEW_RETURN (base_si, Server_Info, -1);
+            base_si->key_name_ = altkey;
+            info->alt_info_.reset (base_si);
+            this->servers ().bind (altkey, info->alt_info_);
+          }
+
+        // Update an existing entry in place, it may be the base of
+        // peers already loaded or be in use by the locator.
+        Server_Info_Ptr si;
+        if (this->servers ().find (info->key_name_, si) == 0)
+          {
+            *si.get () = *info;
+          }
+        else
+          {
+            si = decoded;
+            this->servers ().bind (info->key_name_, si);
+          }
+
+        si->server = ImplementationRepository::ServerObject::_nil ();
+        if (started && !si->ior.is_empty ())
+          {
+            CORBA::Object_var obj =
+              this->orb_->string_to_object (si->ior.c_str ());
+            if (!CORBA::is_nil (obj.in ()))
+              {
+                si->server =
+                  ImplementationRepository::ServerObject::_unchecked_narrow (obj.in ());
+                si->last_ping = ACE_Time_Value::zero;
+              }
+          }
+        this->index_update (this->server_index_, si->key_name_,
+                            offset, size, false);
+        return 0;
+      }
+    case ACTIVATOR_UPDATE:
+      {
+        ACE_CString name;
+        CORBA::Long token = 0;
+        ACE_CString ior;
+        if (!(body >> name && body >> token && body >> ior))
+          {
+            return -1;
+          }
+        Activator_Info *ai = 0;
+        ACE_NEW_RETURN (ai, Activator_Info (name, token, ior), -1);
+        Activator_Info_Ptr info (ai);
+        ACE_CString const key = lcase (name);
+        this->activators ().rebind (key, info);
+        this->index_update (this->activator_index_, key, offset, size, false);
+        return 0;
+      }
+    case SERVER_REMOVE:
+    case ACTIVATOR_REMOVE:
+      {
+        ACE_CString key;
+        if (!(body >> key))
+          {
+            return -1;
+          }
+        if (kind == SERVER_REMOVE)
+          {
+            this->servers ().unbind (key);
+            this->index_update (this->server_index_, key, offset, size, true);
+          }
+        else
+          {
+            this->activators ().unbind (key);
+            this->index_update (this->activator_index_, key, offset, size, true);
+          }
+        return 0;
+      }
+    default:
+      return -1;
+    }
+}
+
+void
+Journal_Backing_Store::index_update (Index& index,
+                                     const ACE_CString& key,
+                                     ACE_OFF_T offset,
+                                     ACE_UINT32 size,
+                                     bool remove)
+{
+  Record_Loc loc;
+  if (index.find (key, loc) == 0)
+    {
+      this->live_bytes_ -= loc.size;
+      this->dead_bytes_ += loc.size;
+    }
+
+  if (remove)
+    {
+      index.unbind (key);
+      this->dead_bytes_ += size;
+    }
+  else
+    {
+      loc.offset = offset;
+      loc.size = size;
+      index.rebind (key, loc);
+      this->live_bytes_ += size;
+    }
+}
+
+int
+Journal_Backing_Store::sync_load ()
+{
+  if (this->handle_ == ACE_INVALID_HANDLE)
+    {
+      return 0;
+    }
+
+  ACE_READ_GUARD_RETURN (ACE_File_Lock, guard, this->lock_, -1);
+  if (this->replaced ())
+    {
+      if (this->open_journal (false) != 0)
+        {
+          return -1;
+        }
+      return this->full_load ();
+    }
+  return this->replay (false);
+}
+
+int
+Journal_Backing_Store::append (ACE_UINT32 kind,
+                               const ACE_CString& key,
+                               const TAO_OutputCDR& body)
+{
+  ACE_Message_Block data;
+  if (ACE_CDR::consolidate (&data, body.begin ()) != 0)
+    {
+      return -1;
+    }
+  size_t const size = data.length ();
+  size_t const record = FRAME_SIZE + padded (size);
+
+  ACE_Message_Block frame (record);
+  char * const buf = frame.wr_ptr ();
+  ACE_OS::memset (buf, 0, record);
+  put_u32 (buf, static_cast<ACE_UINT32> (size));
+  put_u32 (buf + 4, ACE::crc32 (data.rd_ptr (), size));
+  put_u32 (buf + 8, kind);
+  ACE_OS::memcpy (buf + FRAME_SIZE, data.rd_ptr (), size);
+
+  ACE_WRITE_GUARD_RETURN (ACE_File_Lock, guard, this->lock_, -1);
+
+  // pick up whatever other locators appended, so this record goes
+  // at the end
+  int err = 0;
+  if (this->replaced ())
+    {
+      err = this->open_journal (false);
+      if (err == 0)
+        {
+          err = this->full_load ();
+        }
+    }
+  else
+    {
+      err = this->replay (false);
+    }
+  if (err != 0)
+    {
+      return err;
+    }
+
+  if (write_fully (this->handle_, buf, record, this->read_offset_) != 0)
+    {
+      ACE_OS::ftruncate (this->handle_, this->read_offset_);
+      ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("(%P|%t) Couldn't write to journal %s\n"),
+                             this->filename_.c_str ()),
+                            -1);
+    }
+
+  bool const server = (kind == SERVER_UPDATE || kind == SERVER_REMOVE);
+  bool const remove = (kind == SERVER_REMOVE || kind == ACTIVATOR_REMOVE);
+  this->index_update (server ? this->server_index_ : this->activator_index_,
+                      key, this->read_offset_,
+                      static_cast<ACE_UINT32> (record), remove);
+  this->read_offset_ += record;
+
+  if (this->dead_bytes_ > this->live_bytes_ &&
+      this->dead_bytes_ >= COMPACT_THRESHOLD)
+    {
+      this->compact ();
+    }
+  return 0;
+}
+
+int
+Journal_Backing_Store::compact ()
+{
+  const ACE_TString tmp_name = this->filename_ + ACE_TEXT (".tmp");
+  ACE_HANDLE const tmp = ACE_OS::open (tmp_name.c_str (),
+                                       O_RDWR | O_BINARY | O_CREAT | O_TRUNC,
+                                       ACE_DEFAULT_FILE_PERMS);
+  if (tmp == ACE_INVALID_HANDLE)
+    {
+      ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("(%P|%t) Couldn't open %s\n"),
+                             tmp_name.c_str ()),
+                            -1);
+    }
+
+  // Copy the live records as they are; the new offsets are only put
+  // into the index once the new journal has replaced the old one.
+  ACE_Vector<ACE_OFF_T> offsets;
+  ACE_OFF_T offset = HEADER_SIZE;
+  int err = write_header (tmp, this->generation_ + 1);
+  ACE_Message_Block block (ACE_DEFAULT_CDR_BUFSIZE);
+  Index * const indexes[] = { &this->server_index_, &this->activator_index_ };
+  for (size_t i = 0; err == 0 && i < 2; ++i)
+    {
+      Index::ENTRY* entry = 0;
+      Index::ITERATOR it (*indexes[i]);
+      for (; err == 0 && it.next (entry); it.advance ())
+        {
+          size_t const size = entry->int_id_.size;
+          block.reset ();
+          if (block.size () < size)
+            {
+              block.size (size);
+            }
+          err = read_fully (this->handle_, block.wr_ptr (), size,
+                            entry->int_id_.offset);
+          if (err == 0)
+            {
+              err = write_fully (tmp, block.wr_ptr (), size, offset);
+            }
+          offsets.push_back (offset);
+          offset += size;
+        }
+    }
+
+  if (err == 0)
+    {
+      err = ACE_OS::fsync (tmp);
+    }
+  if (err == 0)
+    {
+      err = ACE_OS::rename (tmp_name.c_str (), this->filename_.c_str ());
+    }
+  if (err != 0)
+    {
+      // keep using the old journal
+      ACE_OS::close (tmp);
+      ACE_OS::unlink (tmp_name.c_str ());
+      ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                             ACE_TEXT ("(%P|%t) Couldn't compact journal %s\n"),
+                             this->filename_.c_str ()),
+                            -1);
+    }
+
+  size_t n = 0;
+  for (size_t i = 0; i < 2; ++i)
+    {
+      Index::ENTRY* entry = 0;
+      Index::ITERATOR it (*indexes[i]);
+      for (; it.next (entry); it.advance ())
+        {
+          entry->int_id_.offset = offsets[n++];
+        }
+    }
+
+  if (this->opts_.debug () > 0)
+    {
+      ORBSVCS_DEBUG ((LM_INFO,
+                      ACE_TEXT ("(%P|%t) Compacted journal <%s> from %q ")
+                      ACE_TEXT ("to %q bytes\n"),
+                      this->filename_.c_str (),
+                      static_cast<ACE_INT64> (this->read_offset_),
+                      static_cast<ACE_INT64> (offset)));
+    }
+
+  ACE_OS::close (this->handle_);
+  this->handle_ = tmp;
+  ACE_stat st;
+  if (ACE_OS::fstat (this->handle_, &st) == 0)
+    {
+      this->inode_ = static_cast<ACE_UINT64> (st.st_ino);
+    }
+  ++this->generation_;
+  this->read_offset_ = offset;
+  this->dead_bytes_ = 0;
+  return 0;
+}
+
+int
+Journal_Backing_Store::persistent_update (const Server_Info_Ptr& info, bool)
+{
+  TAO_OutputCDR out;
+  encode (out, *info);
+  return this->append (SERVER_UPDATE, info->key_name_, out);
+}
+
+int
+Journal_Backing_Store::persistent_update (const Activator_Info_Ptr& info, bool)
+{
+  TAO_OutputCDR out;
+  out << ACE_OutputCDR::from_boolean (ACE_CDR_BYTE_ORDER);
+  out << info->name;
+  out << info->token;
+  out << info->ior;
+  return this->append (ACTIVATOR_UPDATE, lcase (info->name), out);
+}
+
+int
+Journal_Backing_Store::persistent_remove (const ACE_CString& name, bool activator)
+{
+  ACE_CString const key = activator ? lcase (name) : name;
+  TAO_OutputCDR out;
+  out << ACE_OutputCDR::from_boolean (ACE_CDR_BYTE_ORDER);
+  out << key;
+  return this->append (activator ? ACTIVATOR_REMOVE : SERVER_REMOVE, key, out);
+}
@@ -0,0 +1,156 @@
+/* -*- C++ -*- */
+
+//=============================================================================
+/**
+*  @file Journal_Backing_Store.h
+*
+*  This class defines an append-only binary journal backing store.
+*/
+//=============================================================================
+
+#ifndef JOURNAL_BACKING_STORE_H
+#define JOURNAL_BACKING_STORE_H
+
+#include "ace/config-lite.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "Locator_Repository.h"
+
+#include "ace/File_Lock.h"
+#include "ace/Hash_Map_Manager.h"
+#include "ace/Null_Mutex.h"
+
+class TAO_InputCDR;
+class TAO_OutputCDR;
+
+/**
+* @class Journal_Backing_Store
+*
+* @brief Binary journal backing store containing all ImR persistent
+* information.
+*
+* Every server or activator update appends one CDR encoded record,
+* framed by its length and CRC-32, to the journal file, so an update
+* costs one write instead of rewriting the whole repository.  On load
+* the records are replayed in order, and a record torn by a crash is
+* cut off.  An index of the live record of each server and activator
+* is kept so the journal can be compacted once superseded records
+* outweigh the live ones.
+*
+* Several locators may share one journal.  Appends are made under a
+* lock file, and each locator replays only the records appended by the
+* others since its last read, falling back to a full load when another
+* locator has compacted the journal.
+*/
+class Journal_Backing_Store : public Locator_Repository
+{
+public:
+  Journal_Backing_Store (const Options& opts,
+                         CORBA::ORB_ptr orb);
+
+  virtual ~Journal_Backing_Store ();
+
+  /// indicate the journal filename as the persistence mode for the
+  /// repository
+  virtual const ACE_TCHAR* repo_mode () const;
+
+  /// record kinds stored in the journal
+  enum RecordKind
+  {
+    SERVER_UPDATE = 1,
+    ACTIVATOR_UPDATE = 2,
+    SERVER_REMOVE = 3,
+    ACTIVATOR_REMOVE = 4
+  };
+
+protected:
+  /// open the journal and load servers and activators from it
+  virtual int init_repo (PortableServer::POA_ptr imr_poa);
+
+  /// replay records appended by other locators sharing the journal
+  virtual int sync_load ();
+
+  /// perform server persistent update
+  virtual int persistent_update (const Server_Info_Ptr& info, bool add);
+
+  /// perform activator persistent update
+  virtual int persistent_update (const Activator_Info_Ptr& info, bool add);
+
+  /// perform persistent remove
+  virtual int persistent_remove (const ACE_CString& name, bool activator);
+
+private:
+  /// location of the live record for a server or activator
+  struct Record_Loc
+  {
+    ACE_OFF_T offset;
+    ACE_UINT32 size;
+  };
+
+  typedef ACE_Hash_Map_Manager_Ex<ACE_CString,
+    Record_Loc,
+    ACE_Hash<ACE_CString>,
+    ACE_Equal_To<ACE_CString>,
+    ACE_Null_Mutex> Index;
+
+  /// open the journal file, creating it with a new header if needed
+  int open_journal (bool create);
+
+  /// drop all servers and activators and replay the whole journal
+  int full_load ();
+
+  /// replay the records from read_offset_ to the end of the journal,
+  /// truncating a torn or corrupt tail if @a repair is set
+  int replay (bool repair);
+
+  /// apply one decoded record to the repository and the index
+  int apply (ACE_UINT32 kind,
+             TAO_InputCDR& body,
+             ACE_OFF_T offset,
+             ACE_UINT32 size);
+
+  /// append one record, holding the write lock
+  int append (ACE_UINT32 kind,
+              const ACE_CString& key,
+              const TAO_OutputCDR& body);
+
+  /// account for a record that supersedes or removes @a key
+  void index_update (Index& index,
+                     const ACE_CString& key,
+                     ACE_OFF_T offset,
+                     ACE_UINT32 size,
+                     bool remove);
+
+  /// rewrite the journal with only the live records, holding the
+  /// write lock
+  int compact ();
+
+  /// true if the journal on disk is no longer the one open
+  bool replaced () const;
+
+  /// the journal filename
+  const ACE_TString filename_;
+  /// the lock file serializing locators sharing the journal
+  ACE_File_Lock lock_;
+  /// the open journal
+  ACE_HANDLE handle_;
+  /// the generation in the journal header, bumped by compaction
+  ACE_UINT32 generation_;
+  /// the offset up to which the journal has been replayed
+  ACE_OFF_T read_offset_;
+  /// index of the live server records
+  Index server_index_;
+  /// index of the live activator records
+  Index activator_index_;
+  /// bytes in live records
+  ACE_UINT64 live_bytes_;
+  /// bytes in superseded and remove records
+  ACE_UINT64 dead_bytes_;
+  /// identity of the open journal, to notice it being replaced
+  ACE_UINT64 inode_;
+};
+
+#endif /* JOURNAL_BACKING_STORE_H */
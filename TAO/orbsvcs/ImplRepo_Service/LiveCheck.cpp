@@ -60,6 +60,7 @@ LiveListener::_remove_ref ()
 
 const int LiveEntry::reping_msec_[] = {10, 100, 500, 1000, 1000, 2000, 2000, 5000, 5000};
 int LiveEntry::reping_limit_ = sizeof (LiveEntry::reping_msec_) / sizeof (int);
+const int LiveEntry::max_backoff_ = 4;
 
 const char *
 LiveEntry::status_name (LiveStatus s)
@@ -133,6 +134,7 @@ LiveEntry::LiveEntry (LiveCheck *owner,
     repings_ (0),
     max_retry_ (LiveEntry::reping_limit_),
     may_ping_ (may_ping),
+    timeouts_ (0),
     listeners_ (),
     lock_ (),
     callback_ (0),
@@ -155,13 +157,18 @@ LiveEntry::~LiveEntry ()
         {
           rec->cancel ();
         }
+      this->owner_->ping_done ();
     }
 }
 
 void
 LiveEntry::release_callback ()
 {
-  this->callback_ = 0;
+  if (this->callback_.in () != 0)
+    {
+      this->callback_ = 0;
+      this->owner_->ping_done ();
+    }
 }
 
 void
@@ -277,6 +284,16 @@ LiveEntry::status (LiveStatus l)
       {
         ACE_Time_Value now (ACE_OS::gettimeofday());
         this->next_check_ = now + owner_->ping_interval();
+        this->timeouts_ = 0;
+      }
+    if (l == LS_TIMEDOUT)
+      {
+        if (this->timeouts_ < LiveEntry::max_backoff_)
+          {
+            ++this->timeouts_;
+          }
+        ACE_Time_Value now (ACE_OS::gettimeofday());
+        this->next_check_ = now + this->backoff_interval ();
       }
     if (l == LS_TRANSIENT && !this->reping_available())
       {
@@ -336,6 +353,29 @@ LiveEntry::may_ping () const
   return this->may_ping_;
 }
 
+ACE_Time_Value
+LiveEntry::backoff_interval () const
+{
+  ACE_Time_Value interval = this->owner_->ping_interval ();
+  if (this->timeouts_ > 0)
+    {
+      interval *= 1 << this->timeouts_;
+    }
+  return interval;
+}
+
+bool
+LiveEntry::ping_due () const
+{
+  if (this->liveliness_ == LS_PING_AWAY ||
+      this->liveliness_ == LS_DEAD ||
+      this->listeners_.is_empty ())
+    {
+      return false;
+    }
+  return this->next_check_ <= ACE_OS::gettimeofday ();
+}
+
 bool
 LiveEntry::has_pid (int pid) const
 {
@@ -387,12 +427,19 @@ LiveEntry::validate_ping (bool &want_reping, ACE_Time_Value& next)
     case LS_INIT:
       break;
     case LS_ALIVE:
-    case LS_TIMEDOUT:
       {
         ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, mon, this->lock_, false);
         this->next_check_ = now + owner_->ping_interval();
       }
       break;
+    case LS_TIMEDOUT:
+      {
+        // A server timing out, as it would when overloaded by a mass
+        // restart, is left alone a little longer each time.
+        ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, mon, this->lock_, false);
+        this->next_check_ = now + this->backoff_interval ();
+      }
+      break;
     case LS_TRANSIENT:
     case LS_LAST_TRANSIENT:
       {
@@ -446,7 +493,9 @@ LiveEntry::validate_ping (bool &want_reping, ACE_Time_Value& next)
 void
 LiveEntry::do_ping (PortableServer::POA_ptr poa)
 {
+  this->release_callback ();
   this->callback_ = new PingReceiver (this, poa);
+  this->owner_->ping_sent ();
   PortableServer::ObjectId_var oid = poa->activate_object (this->callback_.in());
   CORBA::Object_var obj = poa->id_to_reference (oid.in());
   ImplementationRepository::AMI_ServerObjectHandler_var cb =
@@ -698,8 +747,15 @@ LiveCheck::LiveCheck ()
    token_ (100),
    handle_timeout_busy_ (0),
    want_timeout_ (false),
-   deferred_timeout_ (ACE_Time_Value::zero)
+   deferred_timeout_ (ACE_Time_Value::zero),
+   max_pings_ (0),
+   pings_in_flight_ (0),
+   pings_held_ (false),
+   lock_ ()
 {
+  this->metrics_.pings_sent_ = 0;
+  this->metrics_.pings_held_ = 0;
+  this->metrics_.max_in_flight_ = 0;
 }
 
 LiveCheck::~LiveCheck ()
@@ -761,6 +817,86 @@ LiveCheck::ping_interval () const
   return this->ping_interval_;
 }
 
+void
+LiveCheck::max_pings (int max)
+{
+  this->max_pings_ = max > 0 ? max : 0;
+}
+
+void
+LiveCheck::ping_sent ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, mon, this->lock_);
+  ++this->metrics_.pings_sent_;
+  if (++this->pings_in_flight_ > this->metrics_.max_in_flight_)
+    {
+      this->metrics_.max_in_flight_ = this->pings_in_flight_;
+    }
+}
+
+void
+LiveCheck::ping_done ()
+{
+  int in_flight = 0;
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, mon, this->lock_);
+    in_flight = --this->pings_in_flight_;
+    if (!this->pings_held_ || !this->running_)
+      {
+        return;
+      }
+    this->pings_held_ = false;
+  }
+  if (ImR_Locator_i::debug () > 4)
+    {
+      ORBSVCS_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("(%P|%t) LiveCheck::ping_done, ")
+                      ACE_TEXT ("<%d> pings in flight, sending held pings\n"),
+                      in_flight));
+    }
+  this->request_timeout ();
+}
+
+bool
+LiveCheck::ping_allowed ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, mon, this->lock_, true);
+  if (this->max_pings_ == 0 || this->pings_in_flight_ < this->max_pings_)
+    {
+      return true;
+    }
+  if (!this->pings_held_)
+    {
+      ++this->metrics_.pings_held_;
+      this->pings_held_ = true;
+    }
+  return false;
+}
+
+void
+LiveCheck::request_timeout ()
+{
+  if (!this->in_handle_timeout ())
+    {
+      ++this->token_;
+      this->reactor()->schedule_timer (this,
+                                       reinterpret_cast<void *>(this->token_),
+                                       ACE_Time_Value::zero);
+    }
+  else
+    {
+      this->want_timeout_ = true;
+      this->deferred_timeout_ = ACE_Time_Value::zero;
+    }
+}
+
+LiveCheck::Metrics
+LiveCheck::metrics () const
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, mon, this->lock_, this->metrics_);
+  return this->metrics_;
+}
+
 int
 LiveCheck::handle_timeout (const ACE_Time_Value &,
                            const void * tok)
@@ -786,6 +922,12 @@ LiveCheck::handle_timeout (const ACE_Time_Value &,
        ++le)
     {
       LiveEntry *entry = le->item ();
+      if (entry->ping_due () && !this->ping_allowed ())
+        {
+          // Held back until a reply comes in, the other entries
+          // are still looked at.
+          continue;
+        }
       if (entry->validate_ping (this->want_timeout_, this->deferred_timeout_))
         {
           entry->do_ping (poa_.in ());
@@ -817,7 +959,9 @@ LiveCheck::handle_timeout (const ACE_Time_Value &,
       LiveEntry *entry = *pe;
       if (entry != 0)
         {
-          if (entry->validate_ping (this->want_timeout_, this->deferred_timeout_))
+          bool const held = entry->ping_due () && !this->ping_allowed ();
+          if (!held &&
+              entry->validate_ping (this->want_timeout_, this->deferred_timeout_))
             {
               entry->do_ping (poa_.in ());
             }
@@ -1076,19 +1220,7 @@ LiveCheck::add_per_client_listener (LiveListener *l,
   if (this->per_client_.insert_tail(entry) == 0)
     {
       entry->add_listener (l);
-
-      if (!this->in_handle_timeout ())
-        {
-          ++this->token_;
-          this->reactor()->schedule_timer (this,
-                                           reinterpret_cast<void *>(this->token_),
-                                           ACE_Time_Value::zero);
-        }
-      else
-        {
-          this->want_timeout_ = true;
-          this->deferred_timeout_ = ACE_Time_Value::zero;
-        }
+      this->request_timeout ();
       return true;
     }
   return false;
@@ -142,7 +142,14 @@ class Locator_Export LiveEntry
   int pid () const;
   bool may_ping () const;
 
+  /// True if validate_ping would find a ping, or a reping, due now.
+  bool ping_due () const;
+
  private:
+  /// The time to wait before the next periodic ping, the ping interval
+  /// doubled for each ping timed out in a row, up to max_backoff_ times.
+  ACE_Time_Value backoff_interval () const;
+
   LiveCheck *owner_;
   ACE_CString server_;
   ImplementationRepository::ServerObject_var ref_;
@@ -151,6 +158,7 @@ class Locator_Export LiveEntry
   int repings_;
   int max_retry_;
   bool may_ping_;
+  int timeouts_;
 
   typedef ACE_Unbounded_Set<LiveListener_ptr> Listen_Set;
   Listen_Set listeners_;
@@ -160,6 +168,7 @@ class Locator_Export LiveEntry
 
   static const int reping_msec_ [];
   static int reping_limit_;
+  static const int max_backoff_;
 };
 
 //---------------------------------------------------------------------------
@@ -243,6 +252,10 @@ class Locator_Export LC_TimeoutGuard
  * needs to determine the liveliness of a server, registers a LiveListener
  * for the desired server. A ping to the server is then scheduled, based on the
  * limits determined by the entry's state.
+ *
+ * The number of pings awaiting a reply may be bounded, so that a mass
+ * restart of servers does not open connections to all of them at once.
+ * The pings held back are sent as replies come in.
  */
 class Locator_Export LiveCheck : public ACE_Event_Handler
 {
@@ -274,12 +287,38 @@ class Locator_Export LiveCheck : public ACE_Event_Handler
   LiveStatus is_alive (const char *server);
   const ACE_Time_Value &ping_interval () const;
 
+  /// Bound the number of pings awaiting a reply, 0 for no bound.
+  void max_pings (int max);
+
+  /// Called by the entries as a ping is sent and as its reply, or its
+  /// cancellation, comes in.
+  void ping_sent ();
+  void ping_done ();
+
+  /// Counters reported when the locator shuts down.
+  struct Metrics
+  {
+    /// Pings sent.
+    unsigned long pings_sent_;
+    /// Times pings were held back because of the bound.
+    unsigned long pings_held_;
+    /// The most pings awaiting a reply at once.
+    int max_in_flight_;
+  };
+  Metrics metrics () const;
+
  private:
   void enter_handle_timeout ();
   void exit_handle_timeout ();
   bool in_handle_timeout ();
   void remove_deferred_servers ();
 
+  /// True if a ping may be sent now, else remember that one was held.
+  bool ping_allowed ();
+
+  /// Ask for a timeout as soon as possible.
+  void request_timeout ();
+
   typedef ACE_Hash_Map_Manager_Ex<ACE_CString,
                                   LiveEntry *,
                                   ACE_Hash<ACE_CString>,
@@ -303,6 +342,15 @@ class Locator_Export LiveCheck : public ACE_Event_Handler
   /// Contains a list of servers which got removed during the handle_timeout,
   /// these will be removed at the end of the handle_timeout.
   NamePidStack removed_entries_;
+  /// The bound on, and the number of, pings awaiting a reply.
+  int max_pings_;
+  int pings_in_flight_;
+  /// Set when a ping was held back because of max_pings_, the entries
+  /// are looked at again once a reply comes in.
+  bool pings_held_;
+  Metrics metrics_;
+  /// Guards the counters above, ping replies come in on any ORB thread.
+  mutable TAO_SYNCH_MUTEX lock_;
 };
 
 #endif /* IMR_LIVECHECK_H_  */
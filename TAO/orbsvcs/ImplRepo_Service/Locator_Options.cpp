@@ -32,6 +32,8 @@ Options::Options ()
 , ping_external_ (false)
 , ping_interval_ (DEFAULT_PING_INTERVAL)
 , ping_timeout_ (DEFAULT_PING_TIMEOUT)
+, ping_concurrency_ (0)
+, start_concurrency_ (0)
 , startup_timeout_ (DEFAULT_START_TIMEOUT)
 , readonly_ (false)
 , service_command_ (SC_NONE)
@@ -54,6 +56,7 @@ Options::parse_args (int &argc, ACE_TCHAR *argv[])
   bool binary_persistence_used = false;
   bool xml_persistence_used = false;
   bool directory_persistence_used = false;
+  bool journal_persistence_used = false;
 
   while (shifter.is_anything_left ())
     {
@@ -224,6 +227,23 @@ Options::parse_args (int &argc, ACE_TCHAR *argv[])
             }
           directory_persistence_used = true;
         }
+      else if (ACE_OS::strcasecmp (shifter.get_current (),
+                                   ACE_TEXT ("--journal")) == 0)
+        {
+          shifter.consume_arg ();
+
+          if (!shifter.is_anything_left () || shifter.get_current ()[0] == '-')
+            {
+              ORBSVCS_ERROR ((LM_ERROR,
+                ACE_TEXT ("Error: --journal option needs a filename\n")));
+              this->print_usage ();
+              return -1;
+            }
+
+          this->persist_file_name_ = shifter.get_current ();
+          this->repo_mode_ = REPO_JOURNAL_FILE;
+          journal_persistence_used = true;
+        }
       else if (ACE_OS::strcasecmp (shifter.get_current (),
                                    ACE_TEXT ("-e")) == 0)
         {
@@ -279,6 +299,34 @@ Options::parse_args (int &argc, ACE_TCHAR *argv[])
           this->ping_timeout_ =
             ACE_Time_Value (0, 1000 * ACE_OS::atoi (shifter.get_current ()));
         }
+      else if (ACE_OS::strcasecmp (shifter.get_current (),
+                                   ACE_TEXT ("--pingconcurrency")) == 0)
+        {
+          shifter.consume_arg ();
+
+          if (!shifter.is_anything_left () || shifter.get_current ()[0] == '-')
+            {
+              ORBSVCS_ERROR ((LM_ERROR,
+                          ACE_TEXT ("Error: --pingconcurrency option needs a value\n")));
+              this->print_usage ();
+              return -1;
+            }
+          this->ping_concurrency_ = ACE_OS::atoi (shifter.get_current ());
+        }
+      else if (ACE_OS::strcasecmp (shifter.get_current (),
+                                   ACE_TEXT ("--startconcurrency")) == 0)
+        {
+          shifter.consume_arg ();
+
+          if (!shifter.is_anything_left () || shifter.get_current ()[0] == '-')
+            {
+              ORBSVCS_ERROR ((LM_ERROR,
+                          ACE_TEXT ("Error: --startconcurrency option needs a value\n")));
+              this->print_usage ();
+              return -1;
+            }
+          this->start_concurrency_ = ACE_OS::atoi (shifter.get_current ());
+        }
       else if (ACE_OS::strcasecmp (shifter.get_current (),
                                    ACE_TEXT ("--ftendpoint")) == 0)
         {
@@ -328,7 +376,7 @@ Options::parse_args (int &argc, ACE_TCHAR *argv[])
     }
 
   if ((binary_persistence_used + directory_persistence_used +
-       xml_persistence_used)
+       xml_persistence_used + journal_persistence_used)
       > 1)
     {
       ORBSVCS_ERROR ((LM_ERROR,
@@ -373,7 +421,8 @@ Options::print_usage () const
     ACE_TEXT ("Usage:\n")
     ACE_TEXT ("\n")
     ACE_TEXT ("ImplRepo_Service [-c cmd] [-d 0..5] [-e] [-m] [-o file]\n")
-    ACE_TEXT (" [-r|-p file|-x file|--directory dir [--primary|--backup] ]\n")
+    ACE_TEXT (" [-r|-p file|-x file|--journal file|\n")
+    ACE_TEXT ("  --directory dir [--primary|--backup] ]\n")
     ACE_TEXT (" [-s] [-t secs] [-v msecs]\n")
     ACE_TEXT ("  -c command      Runs nt service commands ('install' or 'remove')\n")
     ACE_TEXT ("  -d level        Sets the debug level (default 0)\n")
@@ -383,6 +432,8 @@ Options::print_usage () const
     ACE_TEXT ("  -o file         Outputs the ImR's IOR to a file\n")
     ACE_TEXT ("  -p file         Use file for storing/loading settings\n")
     ACE_TEXT ("  -x file         Use XML file for storing/loading settings\n")
+    ACE_TEXT ("  --journal file  Use a binary journal file for storing/loading\n")
+    ACE_TEXT ("                  settings, may be shared by several ImRs\n")
     ACE_TEXT ("  --directory dir Use individual XML files for storing/loading\n")
     ACE_TEXT ("                  settings in the provided directory\n")
     ACE_TEXT ("  --primary       Replicate the ImplRepo as the primary ImR\n")
@@ -393,6 +444,9 @@ Options::print_usage () const
     ACE_TEXT ("  -v msecs        Server verification interval.(Default = %dms)\n")
     ACE_TEXT ("  -n msecs        Ping request timeout.(Default = %dms)\n")
     ACE_TEXT ("  -i              Ping servers started without activators too.\n")
+    ACE_TEXT ("  --pingconcurrency n  Limit the pings awaiting a reply to n (Default = no limit)\n")
+    ACE_TEXT ("  --startconcurrency n Limit the start requests awaiting a reply\n")
+    ACE_TEXT ("                  from each activator to n (Default = no limit)\n")
     ACE_TEXT ("  --lockout       Prevent excessive restart attempts until manual reset.\n")
     ACE_TEXT ("  --UnregisterIfAddressReused,\n")
     ACE_TEXT ("  -u              Unregister server if its endpoint is used by another\n"),
@@ -729,6 +783,18 @@ Options::ping_timeout () const
   return this->ping_timeout_;
 }
 
+int
+Options::ping_concurrency () const
+{
+  return this->ping_concurrency_;
+}
+
+int
+Options::start_concurrency () const
+{
+  return this->start_concurrency_;
+}
+
 LiveCheck *
 Options::pinger () const
 {
@@ -79,7 +79,8 @@ public:
     REPO_XML_FILE,
     REPO_SHARED_FILES,
     REPO_HEAP_FILE,
-    REPO_REGISTRY
+    REPO_REGISTRY,
+    REPO_JOURNAL_FILE
   };
   RepoMode repository_mode () const;
 
@@ -108,6 +109,13 @@ public:
   /// When pinging, this is the timeout
   ACE_Time_Value ping_timeout () const;
 
+  /// The most pings awaiting a reply at once, 0 for no bound.
+  int ping_concurrency () const;
+
+  /// The most start requests awaiting a reply from an activator at
+  /// once, 0 for no bound.
+  int start_concurrency () const;
+
   LiveCheck *pinger () const;
   void pinger (LiveCheck *);
 
@@ -164,6 +172,12 @@ private:
   /// The amount of time to wait for a "are you started yet?" ping reply.
   ACE_Time_Value ping_timeout_;
 
+  /// The most pings outstanding at once.
+  int ping_concurrency_;
+
+  /// The most start requests outstanding on an activator at once.
+  int start_concurrency_;
+
   /// The amount of time to wait for a server to response after starting it.
   ACE_Time_Value startup_timeout_;
 
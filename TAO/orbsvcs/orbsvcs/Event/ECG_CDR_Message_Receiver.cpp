@@ -39,20 +39,47 @@ TAO_ECG_UDP_Request_Entry (CORBA::Boolean byte_order,
   , request_id_ (request_id)
   , request_size_ (request_size)
   , fragment_count_ (fragment_count)
+  , received_fragments_ (default_received_fragments_)
+  , own_received_fragments_ (0)
+  , received_fragments_size_ (0)
+  , received_fragments_capacity_ (ECG_DEFAULT_FRAGMENT_BUFSIZ)
 {
+  this->reset (byte_order, request_id, request_size, fragment_count);
+}
+
+void
+TAO_ECG_UDP_Request_Entry::reset (CORBA::Boolean byte_order,
+                                  CORBA::ULong request_id,
+                                  CORBA::ULong request_size,
+                                  CORBA::ULong fragment_count)
+{
+  this->byte_order_ = byte_order;
+  this->request_id_ = request_id;
+  this->request_size_ = request_size;
+  this->fragment_count_ = fragment_count;
+
+  // Keep the buffer from the previous request if it is big enough.
+  ACE_CDR::mb_align (&this->payload_);
   ACE_CDR::grow (&this->payload_, this->request_size_);
   this->payload_.wr_ptr (request_size_);
 
-  this->received_fragments_ = this->default_received_fragments_;
-  this->own_received_fragments_ = 0;
   const int bits_per_ulong = sizeof(CORBA::ULong) * CHAR_BIT;
   this->received_fragments_size_ =
     this->fragment_count_ / bits_per_ulong + 1;
-  if (this->received_fragments_size_ > ECG_DEFAULT_FRAGMENT_BUFSIZ)
+  if (this->received_fragments_size_ > this->received_fragments_capacity_)
     {
+      if (this->own_received_fragments_)
+        {
+          this->own_received_fragments_ = 0;
+          delete[] this->received_fragments_;
+        }
+      this->received_fragments_ = this->default_received_fragments_;
+      this->received_fragments_capacity_ = ECG_DEFAULT_FRAGMENT_BUFSIZ;
+
       ACE_NEW (this->received_fragments_,
                CORBA::ULong[this->received_fragments_size_]);
       this->own_received_fragments_ = 1;
+      this->received_fragments_capacity_ = this->received_fragments_size_;
     }
 
   for (CORBA::ULong i = 0; i < this->received_fragments_size_; ++i)
@@ -62,6 +89,12 @@ TAO_ECG_UDP_Request_Entry (CORBA::Boolean byte_order,
   this->received_fragments_[idx] = (0xFFFFFFFF << bit);
 }
 
+size_t
+TAO_ECG_UDP_Request_Entry::capacity () const
+{
+  return this->payload_.size ();
+}
+
 int
 TAO_ECG_UDP_Request_Entry::validate_fragment (CORBA::Boolean byte_order,
                                               CORBA::ULong request_size,
@@ -140,6 +173,10 @@ TAO_ECG_CDR_Message_Receiver::Requests::init (size_t size,
                   TAO_ECG_UDP_Request_Entry*[size],
                   -1);
 
+  ACE_NEW_RETURN (this->arena_,
+                  TAO_ECG_UDP_Request_Entry*[size],
+                  -1);
+
   this->size_ = size;
   this->id_range_low_ = 0;
   this->id_range_high_ = size - 1;
@@ -148,6 +185,7 @@ TAO_ECG_CDR_Message_Receiver::Requests::init (size_t size,
   for (size_t i = 0; i < size; ++i)
     {
       this->fragmented_requests_[i] = nullptr;
+      this->arena_[i] = nullptr;
     }
 
   return 0;
@@ -155,17 +193,16 @@ TAO_ECG_CDR_Message_Receiver::Requests::init (size_t size,
 
 TAO_ECG_CDR_Message_Receiver::Requests::~Requests ()
 {
+  // The entries in <fragmented_requests_> are owned by the arena.
   for (size_t i = 0; i < this->size_; ++i)
     {
-      TAO_ECG_UDP_Request_Entry* request =
-        this->fragmented_requests_[i];
-
-      if (request != &TAO_ECG_CDR_Message_Receiver::Request_Completed_)
-        delete request;
+      delete this->arena_[i];
     }
 
+  delete [] this->arena_;
   delete [] this->fragmented_requests_;
 
+  this->arena_ = nullptr;
   this->fragmented_requests_ = nullptr;
   this->size_ = 0;
   this->id_range_low_ = 0;
@@ -212,19 +249,62 @@ TAO_ECG_CDR_Message_Receiver::Requests::get_request (CORBA::ULong request_id)
 }
 
 
+TAO_ECG_UDP_Request_Entry *
+TAO_ECG_CDR_Message_Receiver::Requests::allocate_request (
+                                            CORBA::Boolean byte_order,
+                                            CORBA::ULong request_id,
+                                            CORBA::ULong request_size,
+                                            CORBA::ULong fragment_count)
+{
+  size_t const index = request_id % this->size_;
+  TAO_ECG_UDP_Request_Entry *& entry = this->arena_[index];
+
+  if (entry == nullptr)
+    {
+      ACE_NEW_RETURN (entry,
+                      TAO_ECG_UDP_Request_Entry (byte_order,
+                                                 request_id,
+                                                 request_size,
+                                                 fragment_count),
+                      nullptr);
+    }
+  else
+    {
+      entry->reset (byte_order, request_id, request_size, fragment_count);
+    }
+
+  this->fragmented_requests_[index] = entry;
+  return entry;
+}
+
+void
+TAO_ECG_CDR_Message_Receiver::Requests::complete_request (
+                                            CORBA::ULong request_id)
+{
+  size_t const index = request_id % this->size_;
+
+  // Do not hold on to unusually large reassembly buffers.
+  if (this->arena_[index] != nullptr
+      && this->arena_[index]->capacity ()
+           > TAO_ECG_CDR_Message_Receiver::ECG_MAX_CACHED_REQUEST_SIZE)
+    {
+      delete this->arena_[index];
+      this->arena_[index] = nullptr;
+    }
+
+  this->fragmented_requests_[index] =
+    &TAO_ECG_CDR_Message_Receiver::Request_Completed_;
+}
+
 void
 TAO_ECG_CDR_Message_Receiver::Requests::purge_requests (
                                             CORBA::ULong purge_first,
                                             CORBA::ULong purge_last)
 {
+  // The entries stay in the arena, ready for the next request.
   for (CORBA::ULong i = purge_first; i <= purge_last; ++i)
     {
       size_t index = i % this->size_;
-      if (this->fragmented_requests_[index]
-          != &TAO_ECG_CDR_Message_Receiver::Request_Completed_)
-        {
-          delete this->fragmented_requests_[index];
-        }
       this->fragmented_requests_[index] = nullptr;
     }
 }
@@ -422,14 +502,14 @@ TAO_ECG_CDR_Message_Receiver::process_fragment (
       return 0;
     }
   if (*request == nullptr)
-    // Entry for this request has not yet been allocated.
+    // Entry for this request has not yet been set up.
     {
-      ACE_NEW_RETURN (*request,
-                      TAO_ECG_UDP_Request_Entry (header.byte_order,
-                                                 header.request_id,
-                                                 header.request_size,
-                                                 header.fragment_count),
-                      -1);
+      if (source_entry->int_id_->allocate_request (header.byte_order,
+                                                   header.request_id,
+                                                   header.request_size,
+                                                   header.fragment_count)
+          == nullptr)
+        return -1;
     }
 
   // Validate the fragment.
@@ -472,14 +552,17 @@ TAO_ECG_CDR_Message_Receiver::process_fragment (
   if (cdr_processor->decode (cdr) == -1)
     return -1;
 
-  delete *request;
-  *request = &Request_Completed_;
+  source_entry->int_id_->complete_request (header.request_id);
   return 1;
 }
 
 TAO_ECG_CDR_Message_Receiver::Request_Map::ENTRY*
 TAO_ECG_CDR_Message_Receiver::get_source_entry (const ACE_INET_Addr &from)
 {
+  if (this->last_source_entry_ != nullptr
+      && this->last_source_ == from)
+    return this->last_source_entry_;
+
   // Get the entry for <from> from the <request_map_>.
   Request_Map::ENTRY * entry = nullptr;
 
@@ -502,6 +585,8 @@ TAO_ECG_CDR_Message_Receiver::get_source_entry (const ACE_INET_Addr &from)
       requests_aptr.release ();
     }
 
+  this->last_source_ = from;
+  this->last_source_entry_ = entry;
   return entry;
 }
 
@@ -519,6 +604,7 @@ TAO_ECG_CDR_Message_Receiver::shutdown ()
       (*i).int_id_ = 0;
     }
 
+  this->last_source_entry_ = nullptr;
   this->ignore_from_.reset ();
 }
 
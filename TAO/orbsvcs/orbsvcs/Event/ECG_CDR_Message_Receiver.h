@@ -65,6 +65,15 @@ public:
 
   ~TAO_ECG_UDP_Request_Entry ();
 
+  /// Reuse the entry (and its buffers) for a new request.
+  void reset (CORBA::Boolean byte_order,
+              CORBA::ULong request_id,
+              CORBA::ULong request_size,
+              CORBA::ULong fragment_count);
+
+  /// The capacity of the reassembly buffer.
+  size_t capacity () const;
+
   /// Validate a fragment, it should be rejected if it is invalid..
   int validate_fragment (CORBA::Boolean byte_order,
                          CORBA::ULong request_size,
@@ -103,6 +112,8 @@ private:
   CORBA::ULong* received_fragments_;
   int own_received_fragments_;
   CORBA::ULong received_fragments_size_;
+  /// Number of elements allocated in <received_fragments_>
+  CORBA::ULong received_fragments_capacity_;
   CORBA::ULong default_received_fragments_[ECG_DEFAULT_FRAGMENT_BUFSIZ];
 };
 
@@ -135,7 +146,13 @@ private:
  * basis.  If the counter reaches a maximum value the message is
  * dropped.
  * Once all the fragments have been received the message is sent
- * up to the calling classes, and the memory reclaimed.
+ * up to the calling classes.
+ * The entries are preallocated per source, one for each slot of the
+ * request id window, and reused for the following requests that map
+ * to the same slot, so in steady state reassembly does not allocate
+ * memory.  Only reassembly buffers larger than
+ * ECG_MAX_CACHED_REQUEST_SIZE are released once the request is
+ * complete.
  */
 class TAO_RTEvent_Serv_Export TAO_ECG_CDR_Message_Receiver
 {
@@ -177,7 +194,8 @@ public:
 private:
   enum {
     ECG_DEFAULT_MAX_FRAGMENTED_REQUESTS = 1024,
-    ECG_DEFAULT_FRAGMENTED_REQUESTS_MIN_PURGE_COUNT = 32
+    ECG_DEFAULT_FRAGMENTED_REQUESTS_MIN_PURGE_COUNT = 32,
+    ECG_MAX_CACHED_REQUEST_SIZE = 64 * 1024
   };
 
   struct Mcast_Header;
@@ -212,6 +230,11 @@ private:
   /// partially received.
   Request_Map request_map_;
 
+  /// Cache the last source looked up in <request_map_>, the
+  /// fragments of a request arrive back to back.
+  ACE_INET_Addr last_source_;
+  Request_Map::ENTRY *last_source_entry_;
+
   /// Serializes use of <request_map_>.
   //  ACE_Lock* lock_;
 
@@ -268,6 +291,17 @@ public:
    */
   TAO_ECG_UDP_Request_Entry ** get_request (CORBA::ULong request_id);
 
+  /// Return the preallocated entry for the slot of @a request_id,
+  /// reset for a new request.
+  TAO_ECG_UDP_Request_Entry * allocate_request (CORBA::Boolean byte_order,
+                                                CORBA::ULong request_id,
+                                                CORBA::ULong request_size,
+                                                CORBA::ULong fragment_count);
+
+  /// The request in the slot for @a request_id is complete, mark it
+  /// as such and recycle its entry.
+  void complete_request (CORBA::ULong request_id);
+
 private:
   /// Delete any outstanding requests with ids in the range
   /// [<purge_first>, <purge_last>] from <fragmented_requests> and
@@ -284,6 +318,10 @@ private:
   /// and processed) for a range of request ids.
   TAO_ECG_UDP_Request_Entry** fragmented_requests_;
 
+  /// The entries used by <fragmented_requests_>, one per slot.  They
+  /// are allocated on first use and recycled afterwards.
+  TAO_ECG_UDP_Request_Entry** arena_;
+
   /// Size of <fragmented_requests_> array.
   size_t size_;
 
@@ -4,6 +4,7 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 ACE_INLINE
 TAO_ECG_CDR_Message_Receiver::Requests::Requests ()
   : fragmented_requests_ (0)
+  , arena_ (0)
   , size_ (0)
   , id_range_low_ (0)
   , id_range_high_ (0)
@@ -17,6 +18,7 @@ ACE_INLINE
 TAO_ECG_CDR_Message_Receiver::TAO_ECG_CDR_Message_Receiver (CORBA::Boolean crc)
   : ignore_from_ ()
   , request_map_ ()
+  , last_source_entry_ (0)
   /* , lock_ (0) */
   , max_requests_ (ECG_DEFAULT_MAX_FRAGMENTED_REQUESTS)
   , min_purge_count_ (ECG_DEFAULT_FRAGMENTED_REQUESTS_MIN_PURGE_COUNT)
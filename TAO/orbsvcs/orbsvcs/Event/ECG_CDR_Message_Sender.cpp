@@ -4,6 +4,8 @@
 #include "ace/SOCK_Dgram.h"
 #include "ace/INET_Addr.h"
 #include "ace/ACE.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_socket.h"
 
 #if !defined(__ACE_INLINE__)
 #include "orbsvcs/Event/ECG_CDR_Message_Sender.inl"
@@ -12,6 +14,45 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+#if defined (ACE_HAS_SENDMMSG)
+/**
+ * @class TAO_ECG_CDR_Message_Sender::Fragment_Batch
+ *
+ * @brief Fragments waiting to be sent with a single sendmmsg() call.
+ *
+ * The headers of the fragments are marshaled in the batch itself,
+ * the payload iovecs point to the buffers of the message being sent.
+ */
+class TAO_ECG_CDR_Message_Sender::Fragment_Batch
+{
+public:
+  Fragment_Batch ()
+    : count_ (0),
+      iov_used_ (0)
+  {
+  }
+
+  /// Number of fragments in the batch
+  int count_;
+
+  /// Number of entries used in <iov_>
+  int iov_used_;
+
+  /// The message descriptors passed to sendmmsg()
+  mmsghdr msgs_[ECG_SEND_BATCH];
+
+  /// The number of bytes each fragment should send
+  size_t expected_[ECG_SEND_BATCH];
+
+  /// The iovecs for all the fragments, the first entry of each
+  /// fragment points to its header
+  iovec iov_[ECG_SEND_BATCH_IOV];
+
+  /// Storage for the fragment headers
+  char headers_[ECG_SEND_BATCH][ECG_HEADER_SIZE + ACE_CDR::MAX_ALIGNMENT];
+};
+#endif /* ACE_HAS_SENDMMSG */
+
 void
 TAO_ECG_CDR_Message_Sender::init (
       TAO_ECG_Refcounted_Endpoint endpoint_rptr)
@@ -59,6 +100,14 @@ TAO_ECG_CDR_Message_Sender::send_message  (const TAO_OutputCDR &cdr,
 
   CORBA::ULong request_id = this->endpoint_rptr_->next_request_id ();
 
+#if defined (ACE_HAS_SENDMMSG)
+  // Single fragment messages gain nothing from batching.
+  Fragment_Batch batch_storage;
+  Fragment_Batch *batch = fragment_count > 1 ? &batch_storage : nullptr;
+#else
+  Fragment_Batch *batch = nullptr;
+#endif /* ACE_HAS_SENDMMSG */
+
   // Reserve the first iovec for the header...
   int iovcnt = 1;
   CORBA::ULong fragment_id = 0;
@@ -85,7 +134,8 @@ TAO_ECG_CDR_Message_Sender::send_message  (const TAO_OutputCDR &cdr,
             max_fragment_payload - (fragment_size - l);
           iov[iovcnt - 1].iov_len = last_mb_length;
 
-          this->send_fragment (addr,
+          this->emit_fragment (batch,
+                               addr,
                                request_id,
                                total_length,
                                max_fragment_payload,
@@ -111,7 +161,8 @@ TAO_ECG_CDR_Message_Sender::send_message  (const TAO_OutputCDR &cdr,
           // We filled a fragment, but this time it was filled
           // exactly, the treatment is a little different from the
           // loop above...
-          this->send_fragment (addr,
+          this->emit_fragment (batch,
+                               addr,
                                request_id,
                                total_length,
                                max_fragment_payload,
@@ -130,7 +181,8 @@ TAO_ECG_CDR_Message_Sender::send_message  (const TAO_OutputCDR &cdr,
         {
           // Now we ran out of space in the iovec, we must send a
           // fragment to work around that....
-          this->send_fragment (addr,
+          this->emit_fragment (batch,
+                               addr,
                                request_id,
                                total_length,
                                fragment_size,
@@ -152,7 +204,8 @@ TAO_ECG_CDR_Message_Sender::send_message  (const TAO_OutputCDR &cdr,
     {
       // Now we ran out of space in the iovec, we must send a
       // fragment to work around that....
-      this->send_fragment (addr,
+      this->emit_fragment (batch,
+                           addr,
                            request_id,
                            total_length,
                            fragment_size,
@@ -168,27 +221,29 @@ TAO_ECG_CDR_Message_Sender::send_message  (const TAO_OutputCDR &cdr,
       // iovcnt = 1;
       // fragment_size = 0;
     }
+
+#if defined (ACE_HAS_SENDMMSG)
+  if (batch != nullptr)
+    this->flush_batch (*batch);
+#endif /* ACE_HAS_SENDMMSG */
   // ACE_ASSERT (total_length == fragment_offset);
   // ACE_ASSERT (fragment_id == fragment_count);
 }
 
 
 void
-TAO_ECG_CDR_Message_Sender::send_fragment (const ACE_INET_Addr &addr,
-                                           CORBA::ULong request_id,
-                                           CORBA::ULong request_size,
-                                           CORBA::ULong fragment_size,
-                                           CORBA::ULong fragment_offset,
-                                           CORBA::ULong fragment_id,
-                                           CORBA::ULong fragment_count,
-                                           iovec iov[],
-                                           int iovcnt)
+TAO_ECG_CDR_Message_Sender::write_header (char *header_buf,
+                                          size_t header_buf_size,
+                                          CORBA::ULong request_id,
+                                          CORBA::ULong request_size,
+                                          CORBA::ULong fragment_size,
+                                          CORBA::ULong fragment_offset,
+                                          CORBA::ULong fragment_id,
+                                          CORBA::ULong fragment_count,
+                                          iovec iov[],
+                                          int iovcnt)
 {
-  CORBA::ULong header[TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE
-                     / sizeof(CORBA::ULong)
-                     + ACE_CDR::MAX_ALIGNMENT];
-  char* buf = reinterpret_cast<char*> (header);
-  TAO_OutputCDR cdr (buf, sizeof(header));
+  TAO_OutputCDR cdr (header_buf, header_buf_size);
   cdr.write_boolean (TAO_ENCAP_BYTE_ORDER);
   // Insert some known values in the padding bytes, so we can smoke
   // test the message on the receiving end.
@@ -230,8 +285,36 @@ TAO_ECG_CDR_Message_Sender::send_fragment (const ACE_INET_Addr &addr,
    //End MRH
   cdr.write_octet_array (padding, 4);
 
+  // The stream does not own <header_buf>, the data remains valid
+  // after <cdr> is destroyed.
   iov[0].iov_base = cdr.begin ()->rd_ptr ();
   iov[0].iov_len  = cdr.begin ()->length ();
+}
+
+void
+TAO_ECG_CDR_Message_Sender::send_fragment (const ACE_INET_Addr &addr,
+                                           CORBA::ULong request_id,
+                                           CORBA::ULong request_size,
+                                           CORBA::ULong fragment_size,
+                                           CORBA::ULong fragment_offset,
+                                           CORBA::ULong fragment_id,
+                                           CORBA::ULong fragment_count,
+                                           iovec iov[],
+                                           int iovcnt)
+{
+  CORBA::ULong header[TAO_ECG_CDR_Message_Sender::ECG_HEADER_SIZE
+                     / sizeof(CORBA::ULong)
+                     + ACE_CDR::MAX_ALIGNMENT];
+  this->write_header (reinterpret_cast<char*> (header),
+                      sizeof(header),
+                      request_id,
+                      request_size,
+                      fragment_size,
+                      fragment_offset,
+                      fragment_id,
+                      fragment_count,
+                      iov,
+                      iovcnt);
 
   ssize_t n = this->dgram ().send (iov,
                                    iovcnt,
@@ -239,6 +322,13 @@ TAO_ECG_CDR_Message_Sender::send_fragment (const ACE_INET_Addr &addr,
   size_t expected_n = 0;
   for (int i = 0; i < iovcnt; ++i)
     expected_n += iov[i].iov_len;
+
+  this->check_send_result (n, expected_n);
+}
+
+void
+TAO_ECG_CDR_Message_Sender::check_send_result (ssize_t n, size_t expected_n)
+{
   if (n > 0 && size_t(n) != expected_n)
     {
       ORBSVCS_ERROR ((LM_ERROR, ("Sent only %d out of %d bytes "
@@ -266,6 +356,108 @@ TAO_ECG_CDR_Message_Sender::send_fragment (const ACE_INET_Addr &addr,
     }
 }
 
+void
+TAO_ECG_CDR_Message_Sender::emit_fragment (Fragment_Batch *batch,
+                                           const ACE_INET_Addr &addr,
+                                           CORBA::ULong request_id,
+                                           CORBA::ULong request_size,
+                                           CORBA::ULong fragment_size,
+                                           CORBA::ULong fragment_offset,
+                                           CORBA::ULong fragment_id,
+                                           CORBA::ULong fragment_count,
+                                           iovec iov[],
+                                           int iovcnt)
+{
+#if defined (ACE_HAS_SENDMMSG)
+  if (batch != nullptr)
+    {
+      if (batch->count_ == ECG_SEND_BATCH
+          || batch->iov_used_ + iovcnt > ECG_SEND_BATCH_IOV)
+        this->flush_batch (*batch);
+
+      if (iovcnt <= ECG_SEND_BATCH_IOV)
+        {
+          iovec *msg_iov = batch->iov_ + batch->iov_used_;
+          for (int i = 1; i < iovcnt; ++i)
+            msg_iov[i] = iov[i];
+
+          this->write_header (batch->headers_[batch->count_],
+                              sizeof (batch->headers_[batch->count_]),
+                              request_id,
+                              request_size,
+                              fragment_size,
+                              fragment_offset,
+                              fragment_id,
+                              fragment_count,
+                              msg_iov,
+                              iovcnt);
+
+          size_t expected_n = 0;
+          for (int i = 0; i < iovcnt; ++i)
+            expected_n += msg_iov[i].iov_len;
+
+          mmsghdr &msg = batch->msgs_[batch->count_];
+          ACE_OS::memset (&msg, 0, sizeof (msg));
+          msg.msg_hdr.msg_name = addr.get_addr ();
+          msg.msg_hdr.msg_namelen = addr.get_size ();
+          msg.msg_hdr.msg_iov = msg_iov;
+          msg.msg_hdr.msg_iovlen = iovcnt;
+
+          batch->expected_[batch->count_] = expected_n;
+          batch->iov_used_ += iovcnt;
+          ++batch->count_;
+          return;
+        }
+      // else the fragment does not fit in an empty batch, send it on
+      // its own.
+    }
+#else
+  ACE_UNUSED_ARG (batch);
+#endif /* ACE_HAS_SENDMMSG */
+
+  this->send_fragment (addr,
+                       request_id,
+                       request_size,
+                       fragment_size,
+                       fragment_offset,
+                       fragment_id,
+                       fragment_count,
+                       iov,
+                       iovcnt);
+}
+
+void
+TAO_ECG_CDR_Message_Sender::flush_batch (Fragment_Batch &batch)
+{
+#if defined (ACE_HAS_SENDMMSG)
+  int sent = 0;
+  while (sent < batch.count_)
+    {
+      int const n = ::sendmmsg (this->dgram ().get_handle (),
+                                batch.msgs_ + sent,
+                                batch.count_ - sent,
+                                0);
+      if (n <= 0)
+        {
+          // Report the fragment that could not be sent, and move on
+          // to the next one, just like the unbatched path does.
+          this->check_send_result (n, batch.expected_[sent]);
+          ++sent;
+          continue;
+        }
+
+      for (int i = sent; i < sent + n; ++i)
+        this->check_send_result (batch.msgs_[i].msg_len,
+                                 batch.expected_[i]);
+      sent += n;
+    }
+
+  batch.count_ = 0;
+  batch.iov_used_ = 0;
+#else
+  ACE_UNUSED_ARG (batch);
+#endif /* ACE_HAS_SENDMMSG */
+}
 
 CORBA::ULong
 TAO_ECG_CDR_Message_Sender::compute_fragment_count (const ACE_Message_Block* begin,
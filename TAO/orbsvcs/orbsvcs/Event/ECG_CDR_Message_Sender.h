@@ -77,7 +77,11 @@ public:
     ECG_HEADER_SIZE = 32,
     ECG_MIN_MTU = 32 + 8,
     ECG_MAX_MTU = 65536, // Really optimistic...
-    ECG_DEFAULT_MTU = 1024
+    ECG_DEFAULT_MTU = 1024,
+    /// Maximum number of fragments sent with one sendmmsg() call
+    ECG_SEND_BATCH = 32,
+    /// Number of iovec entries shared by the fragments in one batch
+    ECG_SEND_BATCH_IOV = 8 * ECG_SEND_BATCH
   };
 
   /// Initialization and termination methods.
@@ -124,14 +128,59 @@ public:
    * fragments, i.e. never sending more than a prescribed number of
    * bytes per-second, sleeping before sending more or queueing them
    * to send later via the reactor.
+   *
+   * On platforms with sendmmsg() (ACE_HAS_SENDMMSG) the fragments are
+   * collected in batches of up to ECG_SEND_BATCH datagrams, and each
+   * batch is handed to the kernel with a single system call.  The
+   * fragments always point into the buffers of @a cdr, the payload
+   * is never copied.
    */
   void send_message (const TAO_OutputCDR &cdr,
                      const ACE_INET_Addr &addr);
 
 private:
+  class Fragment_Batch;
+
   /// Return the datagram...
   ACE_SOCK_Dgram& dgram ();
 
+  /**
+   * Marshal the header of a fragment into @a header_buf, which must
+   * have room for ECG_HEADER_SIZE bytes plus ACE_CDR::MAX_ALIGNMENT,
+   * and point the first entry in the iovec to it.  The rest of the
+   * iovec array must already contain the payload, it is used to
+   * compute the checksum.
+   */
+  void write_header (char *header_buf,
+                     size_t header_buf_size,
+                     CORBA::ULong request_id,
+                     CORBA::ULong request_size,
+                     CORBA::ULong fragment_size,
+                     CORBA::ULong fragment_offset,
+                     CORBA::ULong fragment_id,
+                     CORBA::ULong fragment_count,
+                     iovec iov[],
+                     int iovcnt);
+
+  /// Report the result of sending a datagram of @a expected_n bytes.
+  void check_send_result (ssize_t n, size_t expected_n);
+
+  /// Send the fragment immediately, or queue it in @a batch if it is
+  /// not null.
+  void emit_fragment (Fragment_Batch *batch,
+                      const ACE_INET_Addr &addr,
+                      CORBA::ULong request_id,
+                      CORBA::ULong request_size,
+                      CORBA::ULong fragment_size,
+                      CORBA::ULong fragment_offset,
+                      CORBA::ULong fragment_id,
+                      CORBA::ULong fragment_count,
+                      iovec iov[],
+                      int iovcnt);
+
+  /// Send all the fragments queued in @a batch.
+  void flush_batch (Fragment_Batch &batch);
+
   /**
    * Send one fragment, the first entry in the iovec is used to send
    * the header, the rest of the iovec array should contain pointers
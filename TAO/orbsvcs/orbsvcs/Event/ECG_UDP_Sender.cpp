@@ -165,6 +165,16 @@ TAO_ECG_UDP_Sender::push (const RtecEventComm::EventSet &events)
       return;
     }
 
+  // All the events are marshaled into the same stream, reset for each
+  // one of them, so the stack buffer is reused and sets of small
+  // events do not allocate memory.
+#if defined(ACE_INITIALIZE_MEMORY_BEFORE_USE)
+  char buffer[ACE_CDR::DEFAULT_BUFSIZE] = { 0 };
+#else
+  char buffer[ACE_CDR::DEFAULT_BUFSIZE];
+#endif /* ACE_INITIALIZE_MEMORY_BEFORE_USE */
+  TAO_OutputCDR cdr (buffer, sizeof buffer);
+
   // Send each event in a separate message.
   // @@ TODO It is interesting to group events destined to the
   // same mcast group in a single message.
@@ -184,7 +194,7 @@ TAO_ECG_UDP_Sender::push (const RtecEventComm::EventSet &events)
       header.ttl--;
 
       // Start building the message
-      TAO_OutputCDR cdr;
+      cdr.reset ();
 
       // Marshal as if it was a sequence of one element, notice how we
       // marshal a modified version of the header, but the payload is
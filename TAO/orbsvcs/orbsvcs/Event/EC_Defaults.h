@@ -101,6 +101,10 @@
 # define TAO_EC_DEFAULT_DISPATCHING_THREADS_FORCE_ACTIVE 1
 #endif /* TAO_EC_DEFAULT_DISPATCHING_THREADS_FORCE_ACTIVE */
 
+#ifndef TAO_EC_DEFAULT_DISPATCHING_CPU_AFFINITY
+# define TAO_EC_DEFAULT_DISPATCHING_CPU_AFFINITY 1 /* bind partitions to CPUs */
+#endif /* TAO_EC_DEFAULT_DISPATCHING_CPU_AFFINITY */
+
 #ifndef TAO_EC_DEFAULT_ORB_ID
 # define TAO_EC_DEFAULT_ORB_ID "" /* */
 #endif /* TAO_EC_DEFAULT_ORB_ID */
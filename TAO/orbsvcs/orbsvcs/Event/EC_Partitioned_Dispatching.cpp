@@ -0,0 +1,183 @@
+#include "orbsvcs/Log_Macros.h"
+#include "orbsvcs/Event/EC_Partitioned_Dispatching.h"
+
+#include "ace/OS_NS_Thread.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Basic_Types.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_EC_Partition_Task::TAO_EC_Partition_Task (
+    ACE_Thread_Manager *thr_manager,
+    TAO_EC_Queue_Full_Service_Object *so,
+    int cpu)
+  :  TAO_EC_Dispatching_Task (thr_manager, so),
+     cpu_ (cpu)
+{
+}
+
+int
+TAO_EC_Partition_Task::svc ()
+{
+  if (this->cpu_ >= 0)
+    {
+#if defined (ACE_HAS_CPU_SET_T) && \
+    (defined (ACE_HAS_PTHREAD_SETAFFINITY_NP) || defined (ACE_HAS_SCHED_SETAFFINITY))
+      cpu_set_t mask;
+      CPU_ZERO (&mask);
+      CPU_SET (this->cpu_, &mask);
+
+# if defined (ACE_HAS_PTHREAD_SETAFFINITY_NP)
+      ACE_hthread_t self;
+      ACE_OS::thr_self (self);
+# else
+      // sched_setaffinity() binds the calling thread when given 0
+      ACE_hthread_t self = 0;
+# endif /* ACE_HAS_PTHREAD_SETAFFINITY_NP */
+
+      if (ACE_OS::thr_set_affinity (self, sizeof (mask), &mask) == -1)
+        ORBSVCS_DEBUG ((LM_DEBUG,
+                        "EC (%P|%t) cannot bind dispatching thread "
+                        "to CPU %d\n",
+                        this->cpu_));
+#else
+      ORBSVCS_DEBUG ((LM_DEBUG,
+                      "EC (%P|%t) CPU binding of dispatching threads "
+                      "not supported on this platform\n"));
+#endif
+    }
+
+  return this->TAO_EC_Dispatching_Task::svc ();
+}
+
+// ****************************************************************
+
+TAO_EC_Partitioned_Dispatching::TAO_EC_Partitioned_Dispatching (
+    int npartitions,
+    int thread_creation_flags,
+    int thread_priority,
+    int force_activate,
+    int bind_to_cpu,
+    TAO_EC_Queue_Full_Service_Object* so)
+  :  npartitions_ (npartitions),
+     thread_creation_flags_ (thread_creation_flags),
+     thread_priority_ (thread_priority),
+     force_activate_ (force_activate),
+     bind_to_cpu_ (bind_to_cpu),
+     queue_full_service_object_ (so),
+     tasks_ (nullptr),
+     active_ (0)
+{
+  long const ncpus = ACE_OS::num_processors_online ();
+
+  if (this->npartitions_ <= 0)
+    this->npartitions_ = ncpus > 0 ? static_cast<int> (ncpus) : 1;
+
+  ACE_NEW (this->tasks_, TAO_EC_Partition_Task*[this->npartitions_]);
+
+  for (int i = 0; i < this->npartitions_; ++i)
+    {
+      int const cpu =
+        (this->bind_to_cpu_ != 0 && ncpus > 0)
+          ? static_cast<int> (i % ncpus)
+          : -1;
+
+      ACE_NEW (this->tasks_[i],
+               TAO_EC_Partition_Task (&this->thread_manager_,
+                                      this->queue_full_service_object_,
+                                      cpu));
+    }
+}
+
+TAO_EC_Partitioned_Dispatching::~TAO_EC_Partitioned_Dispatching ()
+{
+  for (int i = 0; i < this->npartitions_; ++i)
+    delete this->tasks_[i];
+
+  delete[] this->tasks_;
+}
+
+void
+TAO_EC_Partitioned_Dispatching::activate ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  if (this->active_ != 0)
+    return;
+
+  this->active_ = 1;
+
+  for (int i = 0; i < this->npartitions_; ++i)
+    {
+      if (this->tasks_[i]->activate (this->thread_creation_flags_,
+                                     1,
+                                     1,
+                                     this->thread_priority_) == -1)
+        {
+          if (this->force_activate_ != 0)
+            {
+              ORBSVCS_DEBUG ((LM_DEBUG,
+                          "EC (%P|%t) activating dispatching partition %d at"
+                          " default priority\n", i));
+              if (this->tasks_[i]->activate (THR_BOUND, 1) == -1)
+                ORBSVCS_ERROR ((LM_ERROR,
+                            "EC (%P|%t) cannot activate dispatching "
+                            "partition %d.\n", i));
+            }
+        }
+    }
+}
+
+void
+TAO_EC_Partitioned_Dispatching::shutdown ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+  if (this->active_ == 0)
+    return;
+
+  for (int i = 0; i < this->npartitions_; ++i)
+    {
+      this->tasks_[i]->putq (new TAO_EC_Shutdown_Task_Command);
+    }
+  this->thread_manager_.wait ();
+
+  this->active_ = 0;
+}
+
+int
+TAO_EC_Partitioned_Dispatching::partition (TAO_EC_ProxyPushSupplier* proxy) const
+{
+  // The proxies are heap allocated, so the low order bits of the
+  // address carry no information; mix the bits (Fibonacci hashing)
+  // before reducing the value to the partition range.
+  ACE_UINT64 key = reinterpret_cast<uintptr_t> (proxy);
+  key *= ACE_UINT64_LITERAL (0x9E3779B97F4A7C15);
+
+  return static_cast<int> ((key >> 32) % this->npartitions_);
+}
+
+void
+TAO_EC_Partitioned_Dispatching::push (TAO_EC_ProxyPushSupplier* proxy,
+                                      RtecEventComm::PushConsumer_ptr consumer,
+                                      const RtecEventComm::EventSet& event,
+                                      TAO_EC_QOS_Info& qos_info)
+{
+  RtecEventComm::EventSet event_copy = event;
+  this->push_nocopy (proxy, consumer, event_copy, qos_info);
+}
+
+void
+TAO_EC_Partitioned_Dispatching::push_nocopy (TAO_EC_ProxyPushSupplier* proxy,
+                                             RtecEventComm::PushConsumer_ptr consumer,
+                                             RtecEventComm::EventSet& event,
+                                             TAO_EC_QOS_Info&)
+{
+  // Double checked locking....
+  if (this->active_ == 0)
+    this->activate ();
+
+  this->tasks_[this->partition (proxy)]->push (proxy, consumer, event);
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
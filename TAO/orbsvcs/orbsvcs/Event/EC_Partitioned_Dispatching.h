@@ -0,0 +1,135 @@
+// -*- C++ -*-
+
+/**
+ *  @file   EC_Partitioned_Dispatching.h
+ *
+ *  Dispatching strategy that statically partitions the consumers
+ *  across a set of dispatching threads, one queue per thread.
+ */
+
+#ifndef TAO_EC_PARTITIONED_DISPATCHING_H
+#define TAO_EC_PARTITIONED_DISPATCHING_H
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Event/EC_Dispatching.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Event/EC_Dispatching_Task.h"
+
+#include "ace/Thread_Manager.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_EC_Partition_Task
+ *
+ * @brief A dispatching task serviced by exactly one thread,
+ *        optionally bound to a single CPU.
+ */
+class TAO_RTEvent_Serv_Export TAO_EC_Partition_Task
+  : public TAO_EC_Dispatching_Task
+{
+public:
+  /// Constructor, a negative @a cpu disables the CPU binding.
+  TAO_EC_Partition_Task (ACE_Thread_Manager *thr_manager,
+                         TAO_EC_Queue_Full_Service_Object *so,
+                         int cpu);
+
+  /// Bind the thread to its CPU and then process the queue.
+  virtual int svc ();
+
+private:
+  /// The CPU this partition runs on, -1 if not bound.
+  int cpu_;
+};
+
+/**
+ * @class TAO_EC_Partitioned_Dispatching
+ *
+ * @brief Dispatching strategy that partitions the consumers across
+ * per-CPU dispatching threads.
+ *
+ * Each consumer (represented by its ProxyPushSupplier) is mapped to
+ * exactly one partition, and each partition has its own queue that
+ * is serviced by a single thread.  Consequently the events for a
+ * given consumer are always delivered in the order they were
+ * pushed, the suppliers only contend on the lock of the partition
+ * they push to, and the consumer state stays in the cache of the
+ * CPU that services the partition.
+ * When the number of threads is not positive one partition per
+ * online CPU is created.
+ */
+class TAO_RTEvent_Serv_Export TAO_EC_Partitioned_Dispatching
+  : public TAO_EC_Dispatching
+{
+public:
+  /// Constructor
+  /// It will create @a npartitions queues, each one serviced by its
+  /// own thread.  If @a bind_to_cpu is not zero the i-th thread is
+  /// bound to the i-th online CPU (modulo the number of CPUs).
+  TAO_EC_Partitioned_Dispatching (int npartitions,
+                                  int thread_creation_flags,
+                                  int thread_priority,
+                                  int force_activate,
+                                  int bind_to_cpu,
+                                  TAO_EC_Queue_Full_Service_Object* so);
+
+  /// Destructor
+  virtual ~TAO_EC_Partitioned_Dispatching ();
+
+  // = The EC_Dispatching methods.
+  virtual void activate ();
+  virtual void shutdown ();
+  virtual void push (TAO_EC_ProxyPushSupplier* proxy,
+                     RtecEventComm::PushConsumer_ptr consumer,
+                     const RtecEventComm::EventSet& event,
+                     TAO_EC_QOS_Info& qos_info);
+  virtual void push_nocopy (TAO_EC_ProxyPushSupplier* proxy,
+                            RtecEventComm::PushConsumer_ptr consumer,
+                            RtecEventComm::EventSet& event,
+                            TAO_EC_QOS_Info& qos_info);
+
+  /// Return the partition that services @a proxy
+  int partition (TAO_EC_ProxyPushSupplier* proxy) const;
+
+private:
+  /// Use our own thread manager.
+  ACE_Thread_Manager thread_manager_;
+
+  /// The number of partitions (and threads)
+  int npartitions_;
+
+  /// The flags (THR_BOUND, THR_NEW_LWP, etc.) used to create the
+  /// dispatching threads.
+  int thread_creation_flags_;
+
+  /// The priority of the dispatching threads.
+  int thread_priority_;
+
+  /// If activation at the requested priority fails then we fallback on
+  /// the defaults for thread activation.
+  int force_activate_;
+
+  /// Bind each dispatching thread to a CPU
+  int bind_to_cpu_;
+
+  /// The queue full action for the partition queues
+  TAO_EC_Queue_Full_Service_Object* queue_full_service_object_;
+
+  /// The partitions
+  TAO_EC_Partition_Task** tasks_;
+
+  /// Synchronize activation and shutdown
+  TAO_SYNCH_MUTEX lock_;
+
+  /// Are the threads running?
+  int active_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_EC_PARTITIONED_DISPATCHING_H */
@@ -1,8 +1,22 @@
 #include "orbsvcs/LoadBalancing/LB_ClientRequestInterceptor.h"
+#include "orbsvcs/LoadBalancing/LB_LatencyMap.h"
 #include "orbsvcs/CosLoadBalancingC.h"
 
+#include "ace/OS_NS_string.h"
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+namespace
+{
+  /// Key of the member a request is sent to in the latency map.
+  ACE_UINT32
+  member_key (PortableInterceptor::ClientRequestInfo_ptr ri)
+  {
+    CORBA::Object_var target = ri->effective_target ();
+    return target->_hash (ACE_UINT32_MAX);
+  }
+}
+
 char *
 TAO_LB_ClientRequestInterceptor::name ()
 {
@@ -59,6 +73,12 @@ TAO_LB_ClientRequestInterceptor::send_request (
 
   const CORBA::Boolean replace = 0;
   ri->add_request_service_context (service_context, replace);
+
+  // Time the request if a TAO_LB_PowerOfTwo balancer chooses between
+  // members including its target.
+  TAO_LB_LatencyMap * const latency_map = TAO_LB_LatencyMap::instance ();
+  if (latency_map->watching () && ri->response_expected ())
+    latency_map->request_sent (member_key (ri), ri->request_id ());
 }
 
 void
@@ -69,20 +89,41 @@ TAO_LB_ClientRequestInterceptor::send_poll (
 
 void
 TAO_LB_ClientRequestInterceptor::receive_reply (
-    PortableInterceptor::ClientRequestInfo_ptr)
+    PortableInterceptor::ClientRequestInfo_ptr ri)
 {
+  TAO_LB_LatencyMap * const latency_map = TAO_LB_LatencyMap::instance ();
+  if (latency_map->watching ())
+    latency_map->reply_received (member_key (ri), ri->request_id (), false);
 }
 
 void
 TAO_LB_ClientRequestInterceptor::receive_exception (
-    PortableInterceptor::ClientRequestInfo_ptr)
+    PortableInterceptor::ClientRequestInfo_ptr ri)
 {
+  TAO_LB_LatencyMap * const latency_map = TAO_LB_LatencyMap::instance ();
+  if (!latency_map->watching ())
+    return;
+
+  // A user exception is a regular reply, a system exception counts
+  // against the member.
+  CORBA::String_var id = ri->received_exception_id ();
+  static const char system_prefix[] = "IDL:omg.org/CORBA/";
+  const bool failed =
+    ACE_OS::strncmp (id.in (),
+                     system_prefix,
+                     sizeof (system_prefix) - 1) == 0;
+
+  latency_map->reply_received (member_key (ri), ri->request_id (), failed);
 }
 
 void
 TAO_LB_ClientRequestInterceptor::receive_other (
-    PortableInterceptor::ClientRequestInfo_ptr)
+    PortableInterceptor::ClientRequestInfo_ptr ri)
 {
+  // Forwarded, or a oneway: no reply from the member to time.
+  TAO_LB_LatencyMap * const latency_map = TAO_LB_LatencyMap::instance ();
+  if (latency_map->watching ())
+    latency_map->request_abandoned (member_key (ri), ri->request_id ());
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
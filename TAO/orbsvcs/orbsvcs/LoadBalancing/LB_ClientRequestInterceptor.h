@@ -49,6 +49,10 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
  *       mechanism!  A server side-only mechanism can correct this
  *       vulnerability, but at the potential cost of additional
  *       resource overhead.
+ *
+ * The interceptor also times requests to the members a
+ * TAO_LB_PowerOfTwo balancer chooses between, and records the
+ * latencies in the TAO_LB_LatencyMap.
  */
 class TAO_LB_ClientRequestInterceptor
   : public virtual PortableInterceptor::ClientRequestInterceptor,
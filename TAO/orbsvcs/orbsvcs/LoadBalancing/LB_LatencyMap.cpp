@@ -0,0 +1,321 @@
+// -*- C++ -*-
+#include "orbsvcs/LoadBalancing/LB_LatencyMap.h"
+
+#include "ace/Guard_T.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/Vector_T.h"
+
+#include <cmath>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  /// Number of pending requests above which stale ones are looked
+  /// for.
+  const size_t TAO_LB_PENDING_PURGE_SIZE = 4096;
+
+  /// Age, in microseconds, after which a pending request is assumed
+  /// to never be answered, e.g. because it was a timed out AMI call.
+  const ACE_UINT64 TAO_LB_PENDING_MAX_AGE = 60000000;
+
+  inline ACE_UINT64
+  pending_key (ACE_UINT32 member, CORBA::ULong request_id)
+  {
+    return (static_cast<ACE_UINT64> (member) << 32) | request_id;
+  }
+}
+
+TAO_LB_LatencyMap::TAO_LB_LatencyMap (ACE_UINT64 decay_time,
+                                      ACE_UINT64 failure_penalty)
+  : decay_time_ (decay_time == 0 ? 1 : decay_time),
+    failure_penalty_ (failure_penalty),
+    lock_ (),
+    stats_ (),
+    pending_ (),
+    watched_ (0),
+    purged_ (0),
+    seed_ (static_cast<ACE_UINT32> (ACE_OS::gettimeofday ().usec ()) | 1)
+{
+}
+
+TAO_LB_LatencyMap *
+TAO_LB_LatencyMap::instance ()
+{
+  static TAO_LB_LatencyMap map;
+  return &map;
+}
+
+ACE_UINT64
+TAO_LB_LatencyMap::now ()
+{
+  ACE_UINT64 usec = 0;
+  ACE_High_Res_Timer::gettimeofday_hr ().to_usec (usec);
+  return usec;
+}
+
+void
+TAO_LB_LatencyMap::watch (ACE_UINT32 member)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  Stats_Map::ENTRY * entry = 0;
+  if (this->stats_.find (member, entry) == 0)
+    {
+      ++entry->item ().watchers;
+      return;
+    }
+
+  Stats stats = { 1, 0, 0.0, 0 };
+  if (this->stats_.bind (member, stats) == 0)
+    ++this->watched_;
+}
+
+void
+TAO_LB_LatencyMap::unwatch (ACE_UINT32 member)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  Stats_Map::ENTRY * entry = 0;
+  if (this->stats_.find (member, entry) != 0)
+    return;
+
+  if (--entry->item ().watchers == 0)
+    {
+      this->stats_.unbind (entry);
+      --this->watched_;
+    }
+}
+
+bool
+TAO_LB_LatencyMap::watching () const
+{
+  return this->watched_.load (std::memory_order_relaxed) != 0;
+}
+
+void
+TAO_LB_LatencyMap::request_sent (ACE_UINT32 member,
+                                 CORBA::ULong request_id)
+{
+  if (!this->watching ())
+    return;
+
+  const ACE_UINT64 start = TAO_LB_LatencyMap::now ();
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  Stats_Map::ENTRY * entry = 0;
+  if (this->stats_.find (member, entry) != 0)
+    return;
+
+  if (this->pending_.current_size () >= TAO_LB_PENDING_PURGE_SIZE
+      && start > this->purged_ + TAO_LB_PENDING_MAX_AGE / 60)
+    this->purge_pending_i (start);
+
+  ACE_UINT64 old_start = 0;
+  const int result = this->pending_.rebind (pending_key (member, request_id),
+                                            start,
+                                            old_start);
+  if (result == -1)
+    return;
+
+  // A request id reused while an earlier request is still pending
+  // replaces it, the earlier one is no longer outstanding.
+  if (result == 0)
+    ++entry->item ().outstanding;
+}
+
+void
+TAO_LB_LatencyMap::reply_received (ACE_UINT32 member,
+                                   CORBA::ULong request_id,
+                                   bool failed)
+{
+  if (!this->watching ())
+    return;
+
+  const ACE_UINT64 end = TAO_LB_LatencyMap::now ();
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  ACE_UINT64 start = 0;
+  if (this->pending_.unbind (pending_key (member, request_id), start) != 0)
+    return;
+
+  Stats_Map::ENTRY * entry = 0;
+  if (this->stats_.find (member, entry) == 0)
+    this->completed_i (entry->item (), start, end, true, failed);
+}
+
+void
+TAO_LB_LatencyMap::request_abandoned (ACE_UINT32 member,
+                                      CORBA::ULong request_id)
+{
+  if (!this->watching ())
+    return;
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  ACE_UINT64 start = 0;
+  if (this->pending_.unbind (pending_key (member, request_id), start) != 0)
+    return;
+
+  Stats_Map::ENTRY * entry = 0;
+  if (this->stats_.find (member, entry) == 0)
+    this->completed_i (entry->item (), start, start, false, false);
+}
+
+void
+TAO_LB_LatencyMap::dispatched (ACE_UINT32 member)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  Stats_Map::ENTRY * entry = 0;
+  if (this->stats_.find (member, entry) == 0)
+    ++entry->item ().outstanding;
+}
+
+void
+TAO_LB_LatencyMap::completed (ACE_UINT32 member,
+                              ACE_UINT64 start,
+                              ACE_UINT64 now,
+                              bool sample,
+                              bool failed)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  Stats_Map::ENTRY * entry = 0;
+  if (this->stats_.find (member, entry) == 0)
+    this->completed_i (entry->item (), start, now, sample, failed);
+}
+
+void
+TAO_LB_LatencyMap::completed_i (Stats & stats,
+                                ACE_UINT64 start,
+                                ACE_UINT64 now,
+                                bool sample,
+                                bool failed)
+{
+  if (stats.outstanding > 0)
+    --stats.outstanding;
+
+  if (!sample)
+    return;
+
+  double rtt = now > start ? static_cast<double> (now - start) : 0.0;
+  if (failed && rtt < this->failure_penalty_)
+    rtt = static_cast<double> (this->failure_penalty_);
+
+  if (stats.stamp == 0 || rtt > stats.latency)
+    {
+      stats.latency = rtt;
+    }
+  else
+    {
+      // Weigh the old average by the time elapsed since it was last
+      // updated, so the average tracks the member at the same speed
+      // whatever the request rate.
+      const double elapsed =
+        now > stats.stamp ? static_cast<double> (now - stats.stamp) : 0.0;
+      const double w = std::exp (-elapsed / this->decay_time_);
+      stats.latency = stats.latency * w + rtt * (1.0 - w);
+    }
+
+  stats.stamp = now == 0 ? 1 : now;
+}
+
+double
+TAO_LB_LatencyMap::cost (ACE_UINT32 member, ACE_UINT64 now) const
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, 0.0);
+
+  Stats_Map::ENTRY * entry = 0;
+  if (this->stats_.find (member, entry) != 0)
+    return 0.0;
+
+  return this->cost_i (entry->item (), now);
+}
+
+double
+TAO_LB_LatencyMap::cost_i (const Stats & stats, ACE_UINT64 now) const
+{
+  // A member that has not answered yet is tried once, and then
+  // avoided while that probe is outstanding.
+  if (stats.stamp == 0)
+    return static_cast<double> (this->failure_penalty_) * stats.outstanding;
+
+  double latency = stats.latency;
+  if (now > stats.stamp)
+    latency *= std::exp (-static_cast<double> (now - stats.stamp)
+                         / this->decay_time_);
+
+  return latency * (stats.outstanding + 1);
+}
+
+CORBA::ULong
+TAO_LB_LatencyMap::select (const ACE_UINT32 members[],
+                           CORBA::ULong count,
+                           ACE_UINT64 now)
+{
+  if (count < 2)
+    return 0;
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, 0);
+
+  // Draw two distinct members.
+  const CORBA::ULong first = this->random_i () % count;
+  CORBA::ULong second = this->random_i () % (count - 1);
+  if (second >= first)
+    ++second;
+
+  double first_cost = 0.0;
+  double second_cost = 0.0;
+
+  Stats_Map::ENTRY * entry = 0;
+  if (this->stats_.find (members[first], entry) == 0)
+    first_cost = this->cost_i (entry->item (), now);
+  if (this->stats_.find (members[second], entry) == 0)
+    second_cost = this->cost_i (entry->item (), now);
+
+  return second_cost < first_cost ? second : first;
+}
+
+void
+TAO_LB_LatencyMap::purge_pending_i (ACE_UINT64 now)
+{
+  this->purged_ = now;
+
+  ACE_Vector<ACE_UINT64> stale;
+
+  Pending_Map::ITERATOR end = this->pending_.end ();
+  for (Pending_Map::ITERATOR i = this->pending_.begin (); i != end; ++i)
+    {
+      if (now > (*i).item () + TAO_LB_PENDING_MAX_AGE)
+        stale.push_back ((*i).key ());
+    }
+
+  for (size_t n = 0; n < stale.size (); ++n)
+    {
+      this->pending_.unbind (stale[n]);
+
+      Stats_Map::ENTRY * entry = 0;
+      const ACE_UINT32 member = static_cast<ACE_UINT32> (stale[n] >> 32);
+      if (this->stats_.find (member, entry) == 0
+          && entry->item ().outstanding > 0)
+        --entry->item ().outstanding;
+    }
+}
+
+ACE_UINT32
+TAO_LB_LatencyMap::random_i ()
+{
+  // Marsaglia's xorshift, enough to spread choices evenly.
+  ACE_UINT32 x = this->seed_;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  this->seed_ = x;
+  return x;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,207 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ * @file LB_LatencyMap.h
+ *
+ * Client side request latency statistics of object group members.
+ */
+//=============================================================================
+
+#ifndef TAO_LB_LATENCY_MAP_H
+#define TAO_LB_LATENCY_MAP_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/LoadBalancing/LoadBalancing_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/orbconf.h"
+#include "tao/Basic_Types.h"
+
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Null_Mutex.h"
+#include "ace/Thread_Mutex.h"
+
+#include <atomic>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_LB_LatencyMap
+ *
+ * @brief Exponentially weighted request latency and outstanding
+ *        request count of each watched object group member.
+ *
+ * Members are identified by the hash of their object reference.  The
+ * TAO_LB_ClientRequestInterceptor times every request sent to a
+ * watched member and folds the round trip time into a "peak" EWMA: a
+ * sample above the current average replaces it at once, while
+ * samples below it are blended in with a weight that grows with the
+ * time since the previous sample.  A slow member is thus penalized on
+ * its first slow reply and rehabilitated gradually.
+ *
+ * select() implements the "power of two choices": two members are
+ * drawn at random and the one with the lower cost, i.e. average
+ * latency times one plus its outstanding requests, is chosen.  The
+ * average of a member that has not been sampled for a while decays
+ * towards zero so that it is eventually probed again.
+ *
+ * Requests to members nobody watches are not timed, so loading the
+ * client component costs next to nothing until a TAO_LB_PowerOfTwo
+ * balancer is in use.
+ */
+class TAO_LoadBalancing_Export TAO_LB_LatencyMap
+{
+public:
+  /// Constructor.
+  /**
+   * @param decay_time      Time constant, in microseconds, of the
+   *                        EWMA weighting and of the idle decay.
+   * @param failure_penalty Latency, in microseconds, charged for a
+   *                        request that failed with a system
+   *                        exception.
+   */
+  TAO_LB_LatencyMap (ACE_UINT64 decay_time = 10000000,
+                     ACE_UINT64 failure_penalty = 1000000);
+
+  /// The process-wide map fed by the client request interceptor.
+  static TAO_LB_LatencyMap * instance ();
+
+  /// Current time in microseconds on the clock used by the
+  /// interceptor hooks.
+  static ACE_UINT64 now ();
+
+  /**
+   * @name Membership
+   *
+   * Balancers watch the members they choose between.  Each watch
+   * must be matched by an unwatch.
+   */
+  //@{
+  void watch (ACE_UINT32 member);
+  void unwatch (ACE_UINT32 member);
+
+  /// True if any member is watched.
+  bool watching () const;
+  //@}
+
+  /**
+   * @name Interceptor Hooks
+   *
+   * Time a request by its target and request id.  Requests to
+   * members that are not watched are ignored.
+   */
+  //@{
+  void request_sent (ACE_UINT32 member, CORBA::ULong request_id);
+
+  /// The reply arrived; @a failed is set for a system exception.
+  void reply_received (ACE_UINT32 member,
+                       CORBA::ULong request_id,
+                       bool failed);
+
+  /// The request was forwarded or otherwise produced no sample.
+  void request_abandoned (ACE_UINT32 member, CORBA::ULong request_id);
+  //@}
+
+  /**
+   * @name Explicit Accounting
+   *
+   * Used by the hooks above, and by callers keeping their own clock.
+   */
+  //@{
+  /// A request to @a member is outstanding.
+  void dispatched (ACE_UINT32 member);
+
+  /// A request to @a member dispatched at @a start completed at @a
+  /// now.  @a sample is false if it must not be timed.
+  void completed (ACE_UINT32 member,
+                  ACE_UINT64 start,
+                  ACE_UINT64 now,
+                  bool sample,
+                  bool failed);
+  //@}
+
+  /// Choose between @a count members using the power of two choices.
+  /**
+   * @return The index of the chosen member in @a members.
+   */
+  CORBA::ULong select (const ACE_UINT32 members[],
+                       CORBA::ULong count,
+                       ACE_UINT64 now);
+
+  /// The cost select() currently assigns to @a member.
+  double cost (ACE_UINT32 member, ACE_UINT64 now) const;
+
+private:
+  /// Latency statistics of one member.
+  struct Stats
+  {
+    /// Number of balancers watching the member.
+    CORBA::ULong watchers;
+    /// Requests sent but not yet answered.
+    CORBA::ULong outstanding;
+    /// The peak EWMA of the latency in microseconds.
+    double latency;
+    /// Time of the last sample.
+    ACE_UINT64 stamp;
+  };
+
+  typedef ACE_Hash_Map_Manager_Ex<ACE_UINT32,
+                                  Stats,
+                                  ACE_Hash<ACE_UINT32>,
+                                  ACE_Equal_To<ACE_UINT32>,
+                                  ACE_Null_Mutex> Stats_Map;
+
+  /// Send time of outstanding requests, keyed by member and request
+  /// id.
+  typedef ACE_Hash_Map_Manager_Ex<ACE_UINT64,
+                                  ACE_UINT64,
+                                  ACE_Hash<ACE_UINT64>,
+                                  ACE_Equal_To<ACE_UINT64>,
+                                  ACE_Null_Mutex> Pending_Map;
+
+  /// Cost of @a stats at @a now, lock held.
+  double cost_i (const Stats & stats, ACE_UINT64 now) const;
+
+  /// Account for a finished request, lock held.
+  void completed_i (Stats & stats,
+                    ACE_UINT64 start,
+                    ACE_UINT64 now,
+                    bool sample,
+                    bool failed);
+
+  /// Drop pending requests that have been outstanding for longer
+  /// than a reply can be expected, lock held.
+  void purge_pending_i (ACE_UINT64 now);
+
+  /// Next pseudo random number, lock held.
+  ACE_UINT32 random_i ();
+
+  const ACE_UINT64 decay_time_;
+  const ACE_UINT64 failure_penalty_;
+
+  /// Lock serializing access to the maps.
+  mutable TAO_SYNCH_MUTEX lock_;
+
+  Stats_Map stats_;
+  Pending_Map pending_;
+
+  /// Number of watched members, checked without the lock.
+  std::atomic<CORBA::ULong> watched_;
+
+  /// Time of the last purge of stale pending requests.
+  ACE_UINT64 purged_;
+
+  /// State of the xorshift generator used by select().
+  ACE_UINT32 seed_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif  /* TAO_LB_LATENCY_MAP_H */
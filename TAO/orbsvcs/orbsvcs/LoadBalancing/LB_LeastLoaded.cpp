@@ -21,6 +21,8 @@ TAO_LB_LeastLoaded::TAO_LB_LeastLoaded (PortableServer::POA_ptr poa)
   : poa_ (PortableServer::POA::_duplicate (poa)),
     load_map_ (0),
     lock_ (0),
+    least_loaded_lock_ (),
+    least_loaded_ (),
     properties_ (),
     critical_threshold_ (TAO_LB::LL_DEFAULT_CRITICAL_THRESHOLD),
     reject_threshold_ (TAO_LB::LL_DEFAULT_REJECT_THRESHOLD),
@@ -168,6 +170,22 @@ TAO_LB_LeastLoaded::next_member (
   if (CORBA::is_nil (load_manager))
     throw CORBA::BAD_PARAM ();
 
+  // Use the location found by the last analysis of the object group's
+  // loads, if any.
+  PortableGroup::Location cached;
+  if (this->cached_location (object_group, cached))
+    {
+      try
+        {
+          return load_manager->get_member_ref (object_group, cached);
+        }
+      catch (const PortableGroup::MemberNotFound&)
+        {
+          // The member has been removed since the last analysis.
+          this->forget_location (object_group);
+        }
+    }
+
   PortableGroup::Locations_var locations =
     load_manager->locations_of_members (object_group);
 
@@ -222,10 +240,22 @@ TAO_LB_LeastLoaded::analyze_loads (
     load_manager->locations_of_members (object_group);
 
   if (locations->length () == 0)
-    throw CORBA::TRANSIENT ();
+    {
+      this->forget_location (object_group);
+      throw CORBA::TRANSIENT ();
+    }
 
   const CORBA::ULong len = locations->length ();
 
+  // The two least loaded locations that do not reject requests.
+  Least_Loaded least_loaded;
+  least_loaded.object_group =
+    PortableGroup::ObjectGroup::_duplicate (object_group);
+  least_loaded.load = FLT_MAX;
+  least_loaded.runner_up_load = FLT_MAX;
+  least_loaded.has_runner_up = false;
+  CORBA::Boolean found_location = false;
+
   // Iterate through the entire location list to determine which
   // locations require load to be shed.
   for (CORBA::ULong i = 0; i < len; ++i)
@@ -283,6 +313,31 @@ TAO_LB_LeastLoaded::analyze_loads (
                   load_manager->disable_alert (loc);
                 }
             }
+
+          if (ACE::is_equal (this->reject_threshold_, 0.0f)
+              || load.value < this->reject_threshold_)
+            {
+              if (!found_location || load.value < least_loaded.load)
+                {
+                  if (found_location)
+                    {
+                      least_loaded.runner_up = least_loaded.location;
+                      least_loaded.runner_up_load = least_loaded.load;
+                      least_loaded.has_runner_up = true;
+                    }
+
+                  least_loaded.location = loc;
+                  least_loaded.load = load.value;
+                  found_location = true;
+                }
+              else if (!least_loaded.has_runner_up
+                       || load.value < least_loaded.runner_up_load)
+                {
+                  least_loaded.runner_up = loc;
+                  least_loaded.runner_up_load = load.value;
+                  least_loaded.has_runner_up = true;
+                }
+            }
         }
       catch (const CosLoadBalancing::LocationNotFound&)
         {
@@ -290,6 +345,69 @@ TAO_LB_LeastLoaded::analyze_loads (
           // next location.
         }
     }
+
+  if (found_location)
+    this->cache_location (least_loaded);
+  else
+    this->forget_location (object_group);
+}
+
+void
+TAO_LB_LeastLoaded::cache_location (const Least_Loaded & least_loaded)
+{
+  const ACE_UINT32 key =
+    least_loaded.object_group->_hash (ACE_UINT32_MAX);
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->least_loaded_lock_);
+
+  // Two object groups with the same hash take turns, the one not
+  // cached falls back on fetching the loads of all its members.
+  (void) this->least_loaded_.rebind (key, least_loaded);
+}
+
+void
+TAO_LB_LeastLoaded::forget_location (
+  PortableGroup::ObjectGroup_ptr object_group)
+{
+  const ACE_UINT32 key = object_group->_hash (ACE_UINT32_MAX);
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->least_loaded_lock_);
+
+  Least_Loaded_Map::ENTRY * entry = 0;
+  if (this->least_loaded_.find (key, entry) == 0
+      && entry->item ().object_group->_is_equivalent (object_group))
+    this->least_loaded_.unbind (entry);
+}
+
+CORBA::Boolean
+TAO_LB_LeastLoaded::cached_location (
+  PortableGroup::ObjectGroup_ptr object_group,
+  PortableGroup::Location & location)
+{
+  const ACE_UINT32 key = object_group->_hash (ACE_UINT32_MAX);
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->least_loaded_lock_, false);
+
+  Least_Loaded_Map::ENTRY * entry = 0;
+  if (this->least_loaded_.find (key, entry) != 0)
+    return false;
+
+  const Least_Loaded & least_loaded = entry->item ();
+  if (!least_loaded.object_group->_is_equivalent (object_group))
+    return false;
+
+  // Avoid the "thundering herd" described in get_location(): pick
+  // one of two equivalently loaded locations at random.
+  if (least_loaded.has_runner_up
+      && !ACE::is_equal (least_loaded.load, 0.0f)
+      && (least_loaded.runner_up_load / least_loaded.load) - 1
+           <= TAO_LB::LL_DEFAULT_LOAD_PERCENT_DIFF_CUTOFF
+      && ACE_OS::rand () < RAND_MAX / 2)
+    location = least_loaded.runner_up;
+  else
+    location = least_loaded.location;
+
+  return true;
 }
 
 PortableServer::POA_ptr
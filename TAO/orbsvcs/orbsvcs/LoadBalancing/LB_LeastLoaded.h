@@ -22,6 +22,7 @@
 
 #include "orbsvcs/CosLoadBalancingS.h"
 
+#include "ace/Hash_Map_Manager_T.h"
 #include "ace/Synch_Traits.h"
 #include "ace/Thread_Mutex.h"
 
@@ -70,6 +71,12 @@ namespace TAO_LB
  *
  * This load balancing strategy is designed to select an object group
  * member residing at a location with the smallest load.
+ *
+ * Each analysis of the loads of an object group remembers its two
+ * least loaded locations, so that next_member() picks between them
+ * without fetching the loads of every member.  The loads of all
+ * members are only fetched for object groups whose loads have not
+ * been analyzed yet.
  */
 class TAO_LB_LeastLoaded
   : public virtual POA_CosLoadBalancing::Strategy
@@ -137,6 +144,38 @@ protected:
   void extract_float_property (const PortableGroup::Property & property,
                                CORBA::Float & value);
 
+  /// The two least loaded locations of an object group found by its
+  /// last load analysis.
+  struct Least_Loaded
+  {
+    PortableGroup::ObjectGroup_var object_group;
+    PortableGroup::Location location;
+    CORBA::Float load;
+    PortableGroup::Location runner_up;
+    CORBA::Float runner_up_load;
+    CORBA::Boolean has_runner_up;
+  };
+
+  /// Table that maps the hash of an object group to its least loaded
+  /// locations.
+  typedef ACE_Hash_Map_Manager_Ex<ACE_UINT32,
+                                  Least_Loaded,
+                                  ACE_Hash<ACE_UINT32>,
+                                  ACE_Equal_To<ACE_UINT32>,
+                                  ACE_Null_Mutex> Least_Loaded_Map;
+
+  /// Remember the least loaded locations of an object group.
+  void cache_location (const Least_Loaded & least_loaded);
+
+  /// Forget the least loaded locations of @a object_group.
+  void forget_location (PortableGroup::ObjectGroup_ptr object_group);
+
+  /// Retrieve the location remembered by the last load analysis of
+  /// @a object_group, picking one of the two least loaded locations
+  /// at random if their loads are equivalent.
+  CORBA::Boolean cached_location (PortableGroup::ObjectGroup_ptr object_group,
+                                  PortableGroup::Location & location);
+
 private:
   /// This servant's default POA.
   PortableServer::POA_var poa_;
@@ -148,6 +187,12 @@ private:
   /// class.
   TAO_SYNCH_MUTEX * lock_;
 
+  /// Lock used to ensure atomic access to the least loaded locations.
+  TAO_SYNCH_MUTEX least_loaded_lock_;
+
+  /// The least loaded locations of the analyzed object groups.
+  Least_Loaded_Map least_loaded_;
+
   /// Cached set of properties used when initializing this strategy.
   CosLoadBalancing::Properties properties_;
 
@@ -31,11 +31,13 @@ TAO_LB_LoadManager::TAO_LB_LoadManager (int ping_timeout,
     poa_ (),
     root_poa_ (),
     monitor_lock_ (),
-    load_lock_ (),
     load_alert_lock_ (),
     lock_ (),
     monitor_map_ (TAO_PG_MAX_LOCATIONS),
-    load_map_ (TAO_PG_MAX_LOCATIONS),
+    load_table_ (TAO_PG_MAX_LOCATIONS),
+    analysis_lock_ (),
+    pending_analysis_ (),
+    analyzing_ (false),
     load_alert_map_ (TAO_PG_MAX_LOCATIONS),
     object_group_manager_ (),
     property_manager_ (object_group_manager_),
@@ -86,55 +88,123 @@ TAO_LB_LoadManager::push_loads (
   if (loads.length () == 0)
     throw CORBA::BAD_PARAM ();
 
+  if (this->load_table_.push (the_location, loads) != 0)
+    throw CORBA::INTERNAL ();
+
+  // Analyze loads for object groups that have members residing at the
+  // given location.  Loads pushed while another thread is analyzing
+  // are batched: that thread analyzes each of their object groups
+  // once, instead of once per push.
   {
-    ACE_GUARD (TAO_SYNCH_MUTEX,
-               guard,
-               this->load_lock_);
+    ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->analysis_lock_);
 
-    if (this->load_map_.rebind (the_location, loads) == -1)
-      throw CORBA::INTERNAL ();
-  }
+    this->pending_analysis_.push_back (the_location);
 
-  // Analyze loads for object groups that have members residing at the
-  // given location.
-  PortableGroup::ObjectGroups_var groups =
-    this->object_group_manager_.groups_at_location (the_location);
+    if (this->analyzing_)
+      return;
 
-  const CORBA::ULong len = groups->length ();
+    this->analyzing_ = true;
+  }
 
-  for (CORBA::ULong i = 0; i < len; ++i)
+  this->analyze_pending_loads ();
+}
+
+void
+TAO_LB_LoadManager::analyze_pending_loads ()
+{
+  // Bound the batches analyzed on behalf of other pushers, so that
+  // this push returns under a steady stream of pushes.  Loads left
+  // pending are analyzed by the next push.
+  static const int max_batches = 4;
+
+  typedef ACE_Hash_Map_Manager_Ex<void *,
+                                  PortableGroup::ObjectGroup_ptr,
+                                  ACE_Hash<void *>,
+                                  ACE_Equal_To<void *>,
+                                  ACE_Null_Mutex> Group_Set;
+
+  for (int batch = 0; batch < max_batches; ++batch)
     {
-      PortableGroup::ObjectGroup_ptr object_group =
-        groups[i];
+      ACE_Vector<PortableGroup::Location> locations;
+
+      {
+        ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->analysis_lock_);
+
+        if (this->pending_analysis_.size () == 0)
+          break;
+
+        locations.swap (this->pending_analysis_);
+      }
 
       try
         {
-          PortableGroup::Properties_var properties =
-            this->get_properties (object_group);
-
-          PortableGroup::Value value;
-          CosLoadBalancing::Strategy_ptr strategy;
-
-          if ((TAO_PG::get_property_value (
-                 this->built_in_balancing_strategy_name_,
-                 properties.in (),
-                 value)
-               || TAO_PG::get_property_value (
-                    this->custom_balancing_strategy_name_,
-                    properties.in (),
-                    value))
-              && (value >>= strategy)
-              && !CORBA::is_nil (strategy))
+          // The object groups at all locations of the batch, each
+          // once.
+          ACE_Vector<PortableGroup::ObjectGroup_var> groups;
+          Group_Set seen;
+
+          for (size_t i = 0; i < locations.size (); ++i)
             {
-              strategy->analyze_loads (object_group,
-                                       this->lm_ref_.in ());
+              PortableGroup::ObjectGroups_var at_location =
+                this->object_group_manager_.groups_at_location (
+                  locations[i]);
+
+              const CORBA::ULong len = at_location->length ();
+              for (CORBA::ULong j = 0; j < len; ++j)
+                {
+                  PortableGroup::ObjectGroup_ptr group = at_location[j];
+                  if (seen.bind (group, group) == 0)
+                    groups.push_back (
+                      PortableGroup::ObjectGroup::_duplicate (group));
+                }
             }
+
+          for (size_t i = 0; i < groups.size (); ++i)
+            this->analyze_loads (groups[i].in ());
+        }
+      catch (...)
+        {
+          ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->analysis_lock_);
+          this->analyzing_ = false;
+          throw;
         }
-      catch (const CORBA::Exception&)
+    }
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->analysis_lock_);
+  this->analyzing_ = false;
+}
+
+void
+TAO_LB_LoadManager::analyze_loads (
+    PortableGroup::ObjectGroup_ptr object_group)
+{
+  try
+    {
+      PortableGroup::Properties_var properties =
+        this->get_properties (object_group);
+
+      PortableGroup::Value value;
+      CosLoadBalancing::Strategy_ptr strategy;
+
+      if ((TAO_PG::get_property_value (
+             this->built_in_balancing_strategy_name_,
+             properties.in (),
+             value)
+           || TAO_PG::get_property_value (
+                this->custom_balancing_strategy_name_,
+                properties.in (),
+                value))
+          && (value >>= strategy)
+          && !CORBA::is_nil (strategy))
         {
-          // Ignore all exceptions.
+          strategy->analyze_loads (object_group,
+                                   this->lm_ref_.in ());
         }
     }
+  catch (const CORBA::Exception&)
+    {
+      // Ignore all exceptions.
+    }
 }
 
 CosLoadBalancing::LoadList *
@@ -151,12 +221,7 @@ TAO_LB_LoadManager::get_loads (const PortableGroup::Location & the_location)
 
   CosLoadBalancing::LoadList_var loads = tmp;
 
-  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
-                    guard,
-                    this->load_lock_,
-                    0);
-
-  if (this->load_map_.find (the_location, *tmp) == 0)
+  if (this->load_table_.find (the_location, *tmp) == 0)
     return loads._retn ();
   else
     throw CosLoadBalancing::LocationNotFound ();
@@ -22,7 +22,7 @@
 
 #include "orbsvcs/LoadBalancing/LB_LoadAlertMap.h"
 #include "orbsvcs/LoadBalancing/LB_MonitorMap.h"
-#include "orbsvcs/LoadBalancing/LB_LoadListMap.h"
+#include "orbsvcs/LoadBalancing/LB_LoadTable.h"
 #include "orbsvcs/LoadBalancing/LB_Pull_Handler.h"
 
 #include "orbsvcs/PortableGroupC.h"
@@ -31,6 +31,7 @@
 #include "orbsvcs/PortableGroup/PG_GenericFactory.h"
 #include "orbsvcs/PortableGroup/PG_ObjectGroupManager.h"
 #include "ace/Unbounded_Queue.h"
+#include "ace/Vector_T.h"
 #include "ace/Task.h"
 #include "tao/Condition.h"
 
@@ -306,6 +307,15 @@ private:
   CosLoadBalancing::Strategy_ptr make_strategy (
     const CosLoadBalancing::StrategyInfo * info);
 
+  /// Analyze the loads of the object groups with members at the
+  /// locations that pushed loads, until no more loads are pending or
+  /// a bounded number of batches have been analyzed.
+  void analyze_pending_loads ();
+
+  /// Have the balancing strategy of @a object_group analyze its
+  /// loads.
+  void analyze_loads (PortableGroup::ObjectGroup_ptr object_group);
+
 private:
   CORBA::ORB_var orb_;
 
@@ -321,9 +331,6 @@ private:
   /// Mutex that provides synchronization for the LoadMonitor map.
   TAO_SYNCH_MUTEX monitor_lock_;
 
-  /// Mutex that provides synchronization for the LoadMap table.
-  TAO_SYNCH_MUTEX load_lock_;
-
   /// Mutex that provides synchronization for the LoadAlert table.
   TAO_SYNCH_MUTEX load_alert_lock_;
 
@@ -336,7 +343,19 @@ private:
   TAO_LB_MonitorMap monitor_map_;
 
   /// Table that maps location to load list.
-  TAO_LB_LoadListMap load_map_;
+  TAO_LB_LoadTable load_table_;
+
+  /// Mutex that provides synchronization for the pending load
+  /// analysis.
+  TAO_SYNCH_MUTEX analysis_lock_;
+
+  /// Locations whose loads were pushed since their object groups were
+  /// last analyzed.
+  ACE_Vector<PortableGroup::Location> pending_analysis_;
+
+  /// True while a thread analyzes the pending loads.  Loads pushed
+  /// meanwhile are left for it to analyze in its next batch.
+  bool analyzing_;
 
   /// Table that maps object group and location to LoadAlert object.
   TAO_LB_LoadAlertMap load_alert_map_;
@@ -0,0 +1,181 @@
+// -*- C++ -*-
+#include "orbsvcs/LoadBalancing/LB_LoadTable.h"
+
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_string.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_LB_LoadTable::Slot::Slot ()
+  : load (0),
+    has_list (false),
+    lock (),
+    list ()
+{
+}
+
+TAO_LB_LoadTable::TAO_LB_LoadTable (size_t size)
+{
+  for (size_t i = 0; i < SHARD_COUNT; ++i)
+    this->shards_[i].map.open (size / SHARD_COUNT + 1);
+}
+
+TAO_LB_LoadTable::~TAO_LB_LoadTable ()
+{
+  for (size_t i = 0; i < SHARD_COUNT; ++i)
+    {
+      Slot_Map::iterator end = this->shards_[i].map.end ();
+      for (Slot_Map::iterator j = this->shards_[i].map.begin ();
+           j != end;
+           ++j)
+        delete (*j).int_id_;
+    }
+}
+
+int
+TAO_LB_LoadTable::push (const PortableGroup::Location & location,
+                        const CosLoadBalancing::LoadList & loads)
+{
+  const CORBA::ULong len = loads.length ();
+  if (len == 0)
+    return -1;
+
+  Slot * slot = this->find_slot (location);
+
+  if (slot == 0)
+    {
+      Shard & s = this->shard (location);
+
+      ACE_WRITE_GUARD_RETURN (TAO_SYNCH_RW_MUTEX, guard, s.lock, -1);
+
+      // Another monitor at the same location may have won the race.
+      if (s.map.find (location, slot) != 0)
+        {
+          ACE_NEW_RETURN (slot, Slot, -1);
+
+          if (s.map.bind (location, slot) != 0)
+            {
+              delete slot;
+              return -1;
+            }
+        }
+    }
+
+  if (len > 1)
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, slot->lock, -1);
+
+      slot->list = loads;
+      slot->load.store (TAO_LB_LoadTable::pack (loads[0]),
+                        std::memory_order_relaxed);
+      slot->has_list.store (true, std::memory_order_release);
+    }
+  else
+    {
+      slot->load.store (TAO_LB_LoadTable::pack (loads[0]),
+                        std::memory_order_relaxed);
+      if (slot->has_list.load (std::memory_order_relaxed))
+        slot->has_list.store (false, std::memory_order_release);
+    }
+
+  return 0;
+}
+
+int
+TAO_LB_LoadTable::find (const PortableGroup::Location & location,
+                        CosLoadBalancing::LoadList & loads) const
+{
+  Slot * const slot = this->find_slot (location);
+  if (slot == 0)
+    return -1;
+
+  if (slot->has_list.load (std::memory_order_acquire))
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, slot->lock, -1);
+
+      loads = slot->list;
+      return 0;
+    }
+
+  loads.length (1);
+  TAO_LB_LoadTable::unpack (slot->load.load (std::memory_order_relaxed),
+                            loads[0]);
+  return 0;
+}
+
+int
+TAO_LB_LoadTable::find (const PortableGroup::Location & location,
+                        CosLoadBalancing::Load & load) const
+{
+  Slot * const slot = this->find_slot (location);
+  if (slot == 0)
+    return -1;
+
+  TAO_LB_LoadTable::unpack (slot->load.load (std::memory_order_relaxed),
+                            load);
+  return 0;
+}
+
+size_t
+TAO_LB_LoadTable::current_size () const
+{
+  size_t size = 0;
+
+  for (size_t i = 0; i < SHARD_COUNT; ++i)
+    {
+      ACE_READ_GUARD_RETURN (TAO_SYNCH_RW_MUTEX,
+                             guard,
+                             this->shards_[i].lock,
+                             size);
+
+      size += this->shards_[i].map.current_size ();
+    }
+
+  return size;
+}
+
+TAO_LB_LoadTable::Shard &
+TAO_LB_LoadTable::shard (const PortableGroup::Location & location) const
+{
+  // The maps of the shards hash with the low order bits, so pick the
+  // shard with the high order bits of a multiplicative hash.
+  const ACE_UINT32 hash =
+    static_cast<ACE_UINT32> (TAO_PG_Location_Hash () (location));
+  const ACE_UINT32 index = (hash * 2654435761U) >> 28;
+
+  return this->shards_[index % SHARD_COUNT];
+}
+
+TAO_LB_LoadTable::Slot *
+TAO_LB_LoadTable::find_slot (const PortableGroup::Location & location) const
+{
+  Shard & s = this->shard (location);
+
+  ACE_READ_GUARD_RETURN (TAO_SYNCH_RW_MUTEX, guard, s.lock, 0);
+
+  Slot * slot = 0;
+  if (s.map.find (location, slot) != 0)
+    return 0;
+
+  return slot;
+}
+
+ACE_UINT64
+TAO_LB_LoadTable::pack (const CosLoadBalancing::Load & load)
+{
+  ACE_UINT32 value = 0;
+  ACE_OS::memcpy (&value, &load.value, sizeof (value));
+
+  return (static_cast<ACE_UINT64> (load.id) << 32) | value;
+}
+
+void
+TAO_LB_LoadTable::unpack (ACE_UINT64 packed, CosLoadBalancing::Load & load)
+{
+  const ACE_UINT32 value = static_cast<ACE_UINT32> (packed);
+
+  load.id = static_cast<CosLoadBalancing::LoadId> (packed >> 32);
+  ACE_OS::memcpy (&load.value, &value, sizeof (value));
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
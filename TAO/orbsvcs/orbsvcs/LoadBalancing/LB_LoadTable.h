@@ -0,0 +1,140 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    LB_LoadTable.h
+ *
+ *  Table of the loads reported at each location.
+ */
+//=============================================================================
+
+
+#ifndef TAO_LB_LOAD_TABLE_H
+#define TAO_LB_LOAD_TABLE_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/LoadBalancing/LoadBalancing_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/CosLoadBalancingC.h"
+#include "orbsvcs/PortableGroupC.h"
+
+#include "orbsvcs/PortableGroup/PG_Location_Hash.h"
+#include "orbsvcs/PortableGroup/PG_Location_Equal_To.h"
+
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Null_Mutex.h"
+#include "ace/RW_Thread_Mutex.h"
+#include "ace/Thread_Mutex.h"
+
+#include <atomic>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_LB_LoadTable
+ *
+ * @brief Table that maps a location to the loads last reported there.
+ *
+ * The table is split into shards by the hash of the location, each
+ * with its own readers/writer lock that is only held for writing when
+ * a location reports for the first time.  Every location has a slot
+ * that is never moved nor removed, so reporting a load and reading it
+ * back only take the read lock of one shard.
+ *
+ * A single load, which is what the load monitors shipped with TAO
+ * report, is kept packed in one atomic word of the slot.  Lists of
+ * several loads are copied under a lock of their own slot.
+ */
+class TAO_LoadBalancing_Export TAO_LB_LoadTable
+{
+public:
+  /// Constructor.
+  /**
+   * @param size Expected number of locations.
+   */
+  explicit TAO_LB_LoadTable (size_t size);
+
+  /// Destructor.
+  ~TAO_LB_LoadTable ();
+
+  /// Record the loads reported at @a location.
+  /**
+   * @return 0 on success, -1 if @a loads is empty or the location
+   *         could not be added.
+   */
+  int push (const PortableGroup::Location & location,
+            const CosLoadBalancing::LoadList & loads);
+
+  /// Copy the loads last reported at @a location into @a loads.
+  /**
+   * @return 0 on success, -1 if no loads were reported there.
+   */
+  int find (const PortableGroup::Location & location,
+            CosLoadBalancing::LoadList & loads) const;
+
+  /// Return the first load last reported at @a location, without
+  /// allocating a LoadList.
+  int find (const PortableGroup::Location & location,
+            CosLoadBalancing::Load & load) const;
+
+  /// Number of locations that reported loads.
+  size_t current_size () const;
+
+private:
+  /// The loads of one location.
+  struct Slot
+  {
+    Slot ();
+
+    /// The first load, its id in the upper and its value in the
+    /// lower half.
+    std::atomic<ACE_UINT64> load;
+
+    /// Set if more than one load was reported, in which case they are
+    /// in @c list.
+    std::atomic<bool> has_list;
+
+    /// Lock serializing access to @c list.
+    TAO_SYNCH_MUTEX lock;
+
+    CosLoadBalancing::LoadList list;
+  };
+
+  typedef ACE_Hash_Map_Manager_Ex<
+    PortableGroup::Location,
+    Slot *,
+    TAO_PG_Location_Hash,
+    TAO_PG_Location_Equal_To,
+    ACE_Null_Mutex> Slot_Map;
+
+  /// A part of the table.
+  struct Shard
+  {
+    mutable TAO_SYNCH_RW_MUTEX lock;
+    Slot_Map map;
+  };
+
+  enum { SHARD_COUNT = 16 };
+
+  /// The shard @a location belongs to.
+  Shard & shard (const PortableGroup::Location & location) const;
+
+  /// The slot of @a location, zero if it never reported.
+  Slot * find_slot (const PortableGroup::Location & location) const;
+
+  static ACE_UINT64 pack (const CosLoadBalancing::Load & load);
+  static void unpack (ACE_UINT64 packed, CosLoadBalancing::Load & load);
+
+  mutable Shard shards_[SHARD_COUNT];
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif  /* TAO_LB_LOAD_TABLE_H */
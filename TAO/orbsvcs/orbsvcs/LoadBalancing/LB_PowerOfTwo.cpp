@@ -0,0 +1,201 @@
+// -*- C++ -*-
+#include "orbsvcs/LoadBalancing/LB_PowerOfTwo.h"
+#include "orbsvcs/LoadBalancing/LB_LatencyMap.h"
+
+#include "tao/debug.h"
+#include "tao/ORB_Constants.h"
+
+#include "orbsvcs/Log_Macros.h"
+
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_sys_time.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_LB_PowerOfTwo::TAO_LB_PowerOfTwo (
+    CosLoadBalancing::LoadManager_ptr load_manager,
+    PortableGroup::ObjectGroup_ptr object_group,
+    const ACE_Time_Value & refresh_interval,
+    TAO_LB_LatencyMap * latency_map)
+  : load_manager_ (CosLoadBalancing::LoadManager::_duplicate (load_manager)),
+    object_group_ (PortableGroup::ObjectGroup::_duplicate (object_group)),
+    refresh_interval_ (refresh_interval),
+    latency_map_ (latency_map == 0
+                  ? TAO_LB_LatencyMap::instance ()
+                  : latency_map),
+    lock_ (),
+    members_ (),
+    keys_ (),
+    next_refresh_ (ACE_Time_Value::zero),
+    refreshing_ (false)
+{
+  if (CORBA::is_nil (load_manager) || CORBA::is_nil (object_group))
+    throw CORBA::BAD_PARAM ();
+
+  this->refresh ();
+}
+
+TAO_LB_PowerOfTwo::~TAO_LB_PowerOfTwo ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  this->unwatch_i ();
+}
+
+CORBA::Object_ptr
+TAO_LB_PowerOfTwo::next_member ()
+{
+  bool refresh = false;
+
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                      guard,
+                      this->lock_,
+                      CORBA::Object::_nil ());
+
+    if (!this->refreshing_
+        && ACE_OS::gettimeofday () >= this->next_refresh_)
+      {
+        this->refreshing_ = true;
+        refresh = true;
+      }
+  }
+
+  if (refresh)
+    {
+      try
+        {
+          this->refresh ();
+        }
+      catch (const CORBA::Exception& ex)
+        {
+          // Keep balancing over the members already known, the
+          // LoadManager may only be unreachable for a while.
+          if (TAO_debug_level > 0)
+            ex._tao_print_exception (
+              "TAO_LB_PowerOfTwo::next_member - refresh failed");
+
+          ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                            guard,
+                            this->lock_,
+                            CORBA::Object::_nil ());
+
+          this->refreshing_ = false;
+          this->next_refresh_ =
+            ACE_OS::gettimeofday () + this->refresh_interval_;
+
+          if (this->members_.size () == 0)
+            throw;
+        }
+    }
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                    guard,
+                    this->lock_,
+                    CORBA::Object::_nil ());
+
+  const CORBA::ULong count =
+    static_cast<CORBA::ULong> (this->keys_.size ());
+  if (count == 0)
+    throw CORBA::TRANSIENT ();
+
+  const CORBA::ULong i =
+    this->latency_map_->select (this->keys_.begin (),
+                                count,
+                                TAO_LB_LatencyMap::now ());
+
+  return CORBA::Object::_duplicate (this->members_[i].reference.in ());
+}
+
+void
+TAO_LB_PowerOfTwo::refresh ()
+{
+  PortableGroup::Locations_var locations;
+  Member_Array members;
+
+  try
+    {
+      locations =
+        this->load_manager_->locations_of_members (this->object_group_.in ());
+
+      const CORBA::ULong len = locations->length ();
+      members.size (len);
+
+      CORBA::ULong n = 0;
+      for (CORBA::ULong i = 0; i < len; ++i)
+        {
+          try
+            {
+              members[n].reference =
+                this->load_manager_->get_member_ref (this->object_group_.in (),
+                                                     locations[i]);
+            }
+          catch (const PortableGroup::MemberNotFound&)
+            {
+              // Removed since the locations were fetched.
+              continue;
+            }
+
+          members[n].key =
+            members[n].reference->_hash (ACE_UINT32_MAX);
+          ++n;
+        }
+
+      members.size (n);
+    }
+  catch (const CORBA::Exception&)
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+      this->refreshing_ = false;
+      throw;
+    }
+
+  // Watch the new members before the old ones are unwatched, so the
+  // statistics of members in both lists are kept.
+  for (size_t i = 0; i < members.size (); ++i)
+    this->latency_map_->watch (members[i].key);
+
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  this->install_i (members);
+
+  this->refreshing_ = false;
+  this->next_refresh_ = ACE_OS::gettimeofday () + this->refresh_interval_;
+
+  if (TAO_debug_level > 5)
+    ORBSVCS_DEBUG ((LM_DEBUG,
+                    ACE_TEXT ("TAO (%P|%t) - TAO_LB_PowerOfTwo::refresh - ")
+                    ACE_TEXT ("balancing over %u members\n"),
+                    static_cast<unsigned int> (this->members_.size ())));
+}
+
+CORBA::ULong
+TAO_LB_PowerOfTwo::member_count () const
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, 0);
+
+  return static_cast<CORBA::ULong> (this->members_.size ());
+}
+
+void
+TAO_LB_PowerOfTwo::install_i (Member_Array & members)
+{
+  this->unwatch_i ();
+
+  this->members_.swap (members);
+
+  this->keys_.size (this->members_.size ());
+  for (size_t i = 0; i < this->members_.size (); ++i)
+    this->keys_[i] = this->members_[i].key;
+}
+
+void
+TAO_LB_PowerOfTwo::unwatch_i ()
+{
+  for (size_t i = 0; i < this->keys_.size (); ++i)
+    this->latency_map_->unwatch (this->keys_[i]);
+
+  this->keys_.size (0);
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,125 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ * @file LB_PowerOfTwo.h
+ *
+ * Client side latency aware member selection.
+ */
+//=============================================================================
+
+#ifndef TAO_LB_POWER_OF_TWO_H
+#define TAO_LB_POWER_OF_TWO_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/LoadBalancing/LoadBalancing_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/CosLoadBalancingC.h"
+
+#include "ace/Array_Base.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Time_Value.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_LB_LatencyMap;
+
+/**
+ * @class TAO_LB_PowerOfTwo
+ *
+ * @brief "PowerOfTwo" load balancing strategy run in the client.
+ *
+ * The member references of an object group are fetched from the
+ * LoadManager once, and again whenever the refresh interval has
+ * elapsed, instead of asking the LoadManager for every request.
+ * next_member() then picks two members at random and returns the one
+ * whose requests have recently been answered faster, weighted by the
+ * number of requests still outstanding to it.
+ *
+ * Latencies are measured by the TAO_LB_ClientRequestInterceptor, so
+ * the client must load the LB_ClientComponent, e.g.:
+ *
+ *   static LB_ClientComponent ""
+ *
+ * in its `svc.conf' file.  All balancers in a process share the
+ * latency statistics of the members they have in common.
+ */
+class TAO_LoadBalancing_Export TAO_LB_PowerOfTwo
+{
+public:
+  /// Constructor.
+  /**
+   * @param load_manager     LoadManager managing @a object_group.
+   * @param object_group     Object group to balance requests over.
+   * @param refresh_interval How long the member list is used before
+   *                         it is fetched again.
+   * @param latency_map      Latency statistics to use, the process-wide
+   *                         statistics if zero.
+   */
+  TAO_LB_PowerOfTwo (CosLoadBalancing::LoadManager_ptr load_manager,
+                     PortableGroup::ObjectGroup_ptr object_group,
+                     const ACE_Time_Value & refresh_interval =
+                       ACE_Time_Value (30),
+                     TAO_LB_LatencyMap * latency_map = 0);
+
+  /// Destructor.
+  ~TAO_LB_PowerOfTwo ();
+
+  /// Return the member the next request should be sent to.
+  /**
+   * @throw CORBA::TRANSIENT if the object group has no members.
+   */
+  CORBA::Object_ptr next_member ();
+
+  /// Fetch the member references from the LoadManager.
+  void refresh ();
+
+  /// Number of members currently chosen between.
+  CORBA::ULong member_count () const;
+
+private:
+  /// An object group member and its key in the latency map.
+  struct Member
+  {
+    CORBA::Object_var reference;
+    ACE_UINT32 key;
+  };
+
+  typedef ACE_Array_Base<Member> Member_Array;
+  typedef ACE_Array_Base<ACE_UINT32> Key_Array;
+
+  /// Replace the members, unwatching the old ones, lock held.
+  void install_i (Member_Array & members);
+
+  /// Stop watching all members, lock held.
+  void unwatch_i ();
+
+  CosLoadBalancing::LoadManager_var load_manager_;
+  PortableGroup::ObjectGroup_var object_group_;
+  const ACE_Time_Value refresh_interval_;
+  TAO_LB_LatencyMap * const latency_map_;
+
+  /// Lock serializing access to the member list.
+  mutable TAO_SYNCH_MUTEX lock_;
+
+  Member_Array members_;
+  /// Latency map keys of members_, in the same order.
+  Key_Array keys_;
+
+  /// When the member list is next fetched.
+  ACE_Time_Value next_refresh_;
+
+  /// True while a thread is fetching the member list.
+  bool refreshing_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif  /* TAO_LB_POWER_OF_TWO_H */
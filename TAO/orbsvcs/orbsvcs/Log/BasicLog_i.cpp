@@ -54,6 +54,8 @@ TAO_BasicLog_i::copy_with_id (DsLogAdmin::LogId id)
 void
 TAO_BasicLog_i::destroy ()
 {
+  this->log_compaction_handler_.stop ();
+
   // Remove ourselves from the list of logs.
   this->logmgr_i_.remove (this->logid_);
 
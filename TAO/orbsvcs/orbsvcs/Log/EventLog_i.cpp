@@ -71,6 +71,8 @@ TAO_EventLog_i::destroy ()
   // Send event to indicate the log has been deleted.
   notifier_->object_deletion (logid_);
 
+  this->log_compaction_handler_.stop ();
+
   // Remove ourselves from the list of logs.
   this->logmgr_i_.remove (this->logid_);
 
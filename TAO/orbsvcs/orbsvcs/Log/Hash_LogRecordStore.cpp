@@ -32,6 +32,9 @@ TAO_Hash_LogRecordStore::TAO_Hash_LogRecordStore (
     forward_state_ (DsLogAdmin::on),
     log_full_action_ (log_full_action),
     max_record_life_ (0),
+    compaction_end_id_ (0),
+    compaction_last_id_ (0),
+    compaction_resume_ (false),
     reactor_ (logmgr_i_->orb()->orb_core ()->reactor ())
 {
   interval_.start = 0;
@@ -578,6 +581,76 @@ TAO_Hash_LogRecordStore::remove_old_records ()
   return count;
 }
 
+CORBA::ULong
+TAO_Hash_LogRecordStore::remove_old_records (CORBA::ULong max_records,
+                                             bool &done)
+{
+  done = true;
+
+  if (this->max_record_life_ == 0)
+    {
+      this->compaction_end_id_ = 0;
+      return 0;
+    }
+
+  TimeBase::TimeT purge_time (ORBSVCS_Time::to_Absolute_TimeT ((ACE_OS::gettimeofday () - ACE_Time_Value(this->max_record_life_))));
+
+  LOG_RECORD_STORE_ITER iter (rec_map_.begin ());
+  LOG_RECORD_STORE_ITER iter_end (rec_map_.end ());
+
+  if (this->compaction_end_id_ == 0)
+    {
+      // A pass looks at the records logged before it started, it
+      // would never end if it chased the records being logged.
+      this->compaction_end_id_ = this->maxid_;
+      this->compaction_resume_ = false;
+    }
+  else if (this->compaction_resume_)
+    {
+      // Resume after the last record kept, or start over if it has
+      // been deleted since.  The records before it that were too old
+      // are gone already.
+      LOG_RECORD_STORE_ITER last (this->compaction_last_id_, rec_map_);
+      if (!last.done ())
+        {
+          iter = last;
+          ++iter;
+        }
+      else
+        {
+          this->compaction_resume_ = false;
+        }
+    }
+
+  CORBA::ULong count = 0; // count of matches found.
+
+  for (CORBA::ULong i = 0;
+       iter != iter_end && iter->key () <= this->compaction_end_id_;
+       ++i)
+    {
+      if (i == max_records)
+        {
+          done = false;
+          return count;
+        }
+
+      if (iter->item().time < purge_time)
+        {
+          this->remove_i (iter++);
+          ++count;
+        }
+      else
+        {
+          this->compaction_last_id_ = iter->key ();
+          this->compaction_resume_ = true;
+          ++iter;
+        }
+    }
+
+  this->compaction_end_id_ = 0;
+  return count;
+}
+
 ACE_SYNCH_RW_MUTEX&
 TAO_Hash_LogRecordStore::lock()
 {
@@ -216,6 +216,12 @@ public:
 
   virtual CORBA::ULong remove_old_records ();
 
+  /// Looks at the records in id order, resuming after the last record
+  /// kept by the previous call, up to the last record logged when the
+  /// pass started.
+  virtual CORBA::ULong remove_old_records (CORBA::ULong max_records,
+                                           bool &done);
+
   /// Read-Write Lock
   virtual ACE_SYNCH_RW_MUTEX& lock();
 
@@ -307,6 +313,16 @@ protected:
   /// The maximum record lifetime
   CORBA::ULong                          max_record_life_;
 
+  /// The last record looked at by the pass of
+  /// remove_old_records(max_records, done) under way, 0 between
+  /// passes.
+  DsLogAdmin::RecordId                  compaction_end_id_;
+
+  /// The last record kept by the pass under way, valid when
+  /// compaction_resume_ is set.
+  DsLogAdmin::RecordId                  compaction_last_id_;
+  bool                                  compaction_resume_;
+
   /// The days of the week that the log should be operational
   DsLogAdmin::WeekMask      weekmask_;
 
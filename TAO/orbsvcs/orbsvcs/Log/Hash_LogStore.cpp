@@ -6,8 +6,8 @@
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 TAO_Hash_LogStore::TAO_Hash_LogStore(TAO_LogMgr_i* logmgr_i)
-  : next_id_ (0),
-    logmgr_i_ (logmgr_i)
+  : logmgr_i_ (logmgr_i),
+    next_id_ (0)
 {
 }
 
@@ -158,17 +158,8 @@ TAO_Hash_LogStore::create(DsLogAdmin::LogFullActionType full_action,
     ;
   id_out = id;
 
-  TAO_Hash_LogRecordStore* impl = 0;
-  ACE_NEW_THROW_EX (impl,
-                    TAO_Hash_LogRecordStore (this->logmgr_i_,
-                                             id,
-                                             full_action,
-                                             max_size,
-                                             thresholds
-                                             ),
-                    CORBA::NO_MEMORY ());
-
-  std::unique_ptr<TAO_Hash_LogRecordStore> recordstore (impl);
+  std::unique_ptr<TAO_Hash_LogRecordStore> recordstore (
+    this->create_log_record_store (id, full_action, max_size, thresholds));
 
   if (this->hash_map_.bind (id, recordstore.get ()) != 0)
     {
@@ -195,6 +186,25 @@ TAO_Hash_LogStore::create_with_id (DsLogAdmin::LogId id,
       throw DsLogAdmin::LogIdAlreadyExists ();
     }
 
+  std::unique_ptr<TAO_Hash_LogRecordStore> recordstore (
+    this->create_log_record_store (id, full_action, max_size, thresholds));
+
+  if (this->hash_map_.bind (id, recordstore.get ()) != 0)
+    {
+      throw CORBA::INTERNAL ();
+    }
+
+  recordstore.release ();
+}
+
+
+TAO_Hash_LogRecordStore*
+TAO_Hash_LogStore::create_log_record_store (
+  DsLogAdmin::LogId id,
+  DsLogAdmin::LogFullActionType full_action,
+  CORBA::ULongLong max_size,
+  const DsLogAdmin::CapacityAlarmThresholdList* thresholds)
+{
   TAO_Hash_LogRecordStore* impl = 0;
   ACE_NEW_THROW_EX (impl,
                     TAO_Hash_LogRecordStore (this->logmgr_i_,
@@ -205,14 +215,7 @@ TAO_Hash_LogStore::create_with_id (DsLogAdmin::LogId id,
                                              ),
                     CORBA::NO_MEMORY ());
 
-  std::unique_ptr<TAO_Hash_LogRecordStore> recordstore (impl);
-
-  if (this->hash_map_.bind (id, recordstore.get ()) != 0)
-    {
-      throw CORBA::INTERNAL ();
-    }
-
-  recordstore.release ();
+  return impl;
 }
 
 
@@ -88,6 +88,16 @@ public:
   virtual TAO_LogRecordStore*
     get_log_record_store (DsLogAdmin::LogId id);
 
+protected:
+  /// Create the record store of the new log @a id.
+  virtual TAO_Hash_LogRecordStore*
+    create_log_record_store (DsLogAdmin::LogId id,
+                             DsLogAdmin::LogFullActionType full_action,
+                             CORBA::ULongLong max_size,
+                             const DsLogAdmin::CapacityAlarmThresholdList* thresholds);
+
+  TAO_LogMgr_i*         logmgr_i_;
+
 private:
   ACE_SYNCH_RW_MUTEX  lock_;
 
@@ -102,8 +112,6 @@ private:
   /// The next log id to be assigned (if it hasn't already been
   /// taken by create_with_id().
   DsLogAdmin::LogId     next_id_;
-
-  TAO_LogMgr_i*         logmgr_i_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -10,4 +10,11 @@ TAO_LogRecordStore::~TAO_LogRecordStore ()
 {
 }
 
+CORBA::ULong
+TAO_LogRecordStore::remove_old_records (CORBA::ULong, bool &done)
+{
+  done = true;
+  return this->remove_old_records ();
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
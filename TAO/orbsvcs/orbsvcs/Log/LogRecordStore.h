@@ -206,9 +206,17 @@ public:
     delete_records_by_id (const DsLogAdmin::RecordIdList & ids) = 0;
 
 
+  /// Delete the records older than the maximum record life.
   virtual CORBA::ULong
     remove_old_records () = 0;
 
+  /// Delete the records older than the maximum record life, looking at
+  /// no more than @a max_records records, from where the previous call
+  /// stopped.  @a done is set once the whole store has been gone
+  /// through.  The default deletes them all at once.
+  virtual CORBA::ULong
+    remove_old_records (CORBA::ULong max_records, bool &done);
+
   /// Read-Write Lock
   virtual ACE_SYNCH_RW_MUTEX& lock() = 0;
 
@@ -1,58 +1,99 @@
 #include "orbsvcs/Log/Log_Compaction_Handler.h"
 #include "orbsvcs/Log/Log_i.h"
-#include "ace/Reactor.h"
+#include "ace/Reverse_Lock_T.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_Thread.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
-TAO_Log_Compaction_Handler::TAO_Log_Compaction_Handler (ACE_Reactor* reactor,
-                                                        TAO_Log_i* log,
-                                                        const ACE_Time_Value& interval)
-  : timer_id_(-1),
-    reactor_(reactor),
-    log_(log),
-    interval_(interval)
+TAO_Log_Compaction_Handler::TAO_Log_Compaction_Handler (TAO_Log_i* log,
+                                                        const ACE_Time_Value& interval,
+                                                        CORBA::ULong slice)
+  : log_(log),
+    interval_(interval),
+    slice_(slice),
+    wakeup_(lock_),
+    running_(false),
+    stopping_(false)
 {
 }
 
-
 TAO_Log_Compaction_Handler::~TAO_Log_Compaction_Handler ()
 {
-  this->cancel ();
+  this->stop ();
 }
 
-
 void
 TAO_Log_Compaction_Handler::schedule ()
 {
-  this->cancel ();
-  this->timer_id_ =
-    this->reactor_->schedule_timer (this, 0, this->interval_, this->interval_);
-}
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  // A thread asked to stop may not have noticed yet, it goes on.
+  this->stopping_ = false;
 
+  if (this->running_)
+    return;
+
+  // Reap the thread that stopped before.
+  this->wait ();
+
+  if (this->activate (THR_NEW_LWP | THR_JOINABLE, 1) == 0)
+    this->running_ = true;
+}
 
 void
 TAO_Log_Compaction_Handler::cancel ()
 {
-  if (this->timer_id_ != -1)
-    {
-      this->reactor_->cancel_timer (timer_id_);
-      this->timer_id_ = -1;
-    }
+  ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+  this->stopping_ = true;
+  this->wakeup_.signal ();
 }
 
+void
+TAO_Log_Compaction_Handler::stop ()
+{
+  this->cancel ();
+  this->wait ();
+}
 
 int
-TAO_Log_Compaction_Handler::handle_timeout (const ACE_Time_Value&,
-                                            const void *)
+TAO_Log_Compaction_Handler::svc ()
 {
-  try
-    {
-      this->log_->remove_old_records();
-    }
-  catch (const CORBA::Exception&)
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, -1);
+
+  while (!this->stopping_)
     {
+      const ACE_Time_Value deadline =
+        ACE_OS::gettimeofday () + this->interval_;
+
+      while (!this->stopping_ && this->wakeup_.wait (&deadline) == 0)
+        continue;
+
+      // Let the writers in between the slices.
+      bool done = false;
+      while (!done && !this->stopping_)
+        {
+          ACE_Reverse_Lock<TAO_SYNCH_MUTEX> reverse (this->lock_);
+          ACE_GUARD_RETURN (ACE_Reverse_Lock<TAO_SYNCH_MUTEX>,
+                            unlocked,
+                            reverse,
+                            -1);
+
+          try
+            {
+              this->log_->remove_old_records (this->slice_, done);
+            }
+          catch (const CORBA::Exception&)
+            {
+              done = true;
+            }
+
+          ACE_OS::thr_yield ();
+        }
     }
 
+  this->running_ = false;
   return 0;
 }
 
@@ -15,15 +15,12 @@
 # pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
-#include "tao/Versioned_Namespace.h"
+#include "tao/orbconf.h"
+#include "tao/Basic_Types.h"
 
-#include "ace/Event_Handler.h"
+#include "ace/Task.h"
 #include "ace/Time_Value.h"
 
-ACE_BEGIN_VERSIONED_NAMESPACE_DECL
-class ACE_Reactor;
-ACE_END_VERSIONED_NAMESPACE_DECL
-
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 class TAO_Log_i;
@@ -31,31 +28,50 @@ class TAO_Log_i;
 /// @class TAO_Log_Compaction_Handler
 /// @brief Periodically invoke remove_old_records() on Log
 ///
+/// The records are removed from a thread of its own, a slice at a
+/// time, so the write lock of the log is never held for longer than
+/// it takes to look at a slice of the records, whatever the size of
+/// the log.
 class TAO_Log_Serv_Export TAO_Log_Compaction_Handler
-  : public ACE_Event_Handler
+  : public ACE_Task_Base
 {
 public:
-  /// Constructor.
-  TAO_Log_Compaction_Handler (ACE_Reactor* reactor,
-                              TAO_Log_i* log,
-                              const ACE_Time_Value& interval);
+  /// Constructor.  Up to @a slice records are looked at under the
+  /// write lock.
+  TAO_Log_Compaction_Handler (TAO_Log_i* log,
+                              const ACE_Time_Value& interval,
+                              CORBA::ULong slice = 1024);
 
-  /// Destructor.
+  /// Destructor, stops the thread.
   ~TAO_Log_Compaction_Handler ();
 
-  /// Schedule Timer.
+  /// Start the thread, if it is not running.
   void schedule ();
 
-  /// Cancel Timer.
+  /// Ask the thread to stop, without waiting for it: the write lock
+  /// of the log may be held by the caller.
   void cancel ();
 
-  virtual int handle_timeout (const ACE_Time_Value &tv, const void *arg);
+  /// Stop the thread and wait for it, must be called without the
+  /// write lock of the log.
+  void stop ();
+
+  /// Remove the old records every interval.
+  virtual int svc ();
 
 private:
-  long                          timer_id_;
-  ACE_Reactor*                  reactor_;
   TAO_Log_i*                    log_;
   const ACE_Time_Value          interval_;
+  const CORBA::ULong            slice_;
+
+  TAO_SYNCH_MUTEX               lock_;
+  TAO_SYNCH_CONDITION           wakeup_;
+
+  /// Set while the thread runs.
+  bool                          running_;
+
+  /// Set when the thread is to stop.
+  bool                          stopping_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
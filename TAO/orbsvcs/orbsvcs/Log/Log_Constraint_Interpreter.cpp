@@ -39,4 +39,10 @@ TAO_Log_Constraint_Interpreter::evaluate (
   return retval;
 }
 
+ETCL_Constraint*
+TAO_Log_Constraint_Interpreter::root () const
+{
+  return this->root_;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
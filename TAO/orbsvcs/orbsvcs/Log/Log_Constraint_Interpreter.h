@@ -51,6 +51,10 @@ public:
   /// Returns true if the constraint is evaluated successfully by
   /// the evaluator.
   CORBA::Boolean evaluate (TAO_Log_Constraint_Visitor &evaluator);
+
+  /// The root of the expression tree, for the record stores that
+  /// look at the constraint before evaluating it.
+  ETCL_Constraint* root () const;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
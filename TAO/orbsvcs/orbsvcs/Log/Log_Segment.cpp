@@ -0,0 +1,423 @@
+#include "orbsvcs/Log/Log_Segment.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_fcntl.h"
+
+#include <algorithm>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  const char segment_magic[8] = { 'T', 'A', 'O', 'L', 'O', 'G', 'S', '1' };
+
+  /// Set in Header::flags_ while the records are in time order.
+  const ACE_UINT32 time_sorted_flag = 1;
+
+  /// The data region starts with room for this many bytes per
+  /// record, the file is sparse until it is written.
+  const size_t initial_record_size = 256;
+
+  size_t
+  align8 (size_t n)
+  {
+    return (n + 7) & ~static_cast<size_t> (7);
+  }
+}
+
+struct TAO_Log_Segment::Header
+{
+  char magic_[8];
+  ACE_UINT32 sequence_;
+  ACE_UINT32 capacity_;
+  ACE_UINT32 count_;
+  ACE_UINT32 live_;
+  ACE_UINT32 flags_;
+  ACE_UINT32 byte_order_;
+  ACE_UINT64 data_end_;
+  ACE_UINT64 live_bytes_;
+  ACE_UINT64 min_time_;
+  ACE_UINT64 max_time_;
+  ACE_UINT64 min_id_;
+  ACE_UINT64 max_id_;
+};
+
+TAO_Log_Segment::TAO_Log_Segment ()
+{
+}
+
+TAO_Log_Segment::~TAO_Log_Segment ()
+{
+  this->map_.close ();
+}
+
+size_t
+TAO_Log_Segment::data_start (ACE_UINT32 capacity)
+{
+  // Header, ids, times, offsets, lengths, flags.
+  return align8 (align8 (sizeof (Header))
+                 + capacity * (3 * sizeof (ACE_UINT64)
+                               + sizeof (ACE_UINT32)
+                               + sizeof (ACE_UINT8)));
+}
+
+TAO_Log_Segment::Header *
+TAO_Log_Segment::header () const
+{
+  return static_cast<Header *> (this->map_.addr ());
+}
+
+ACE_UINT64 *
+TAO_Log_Segment::ids () const
+{
+  return reinterpret_cast<ACE_UINT64 *> (
+    static_cast<char *> (this->map_.addr ()) + align8 (sizeof (Header)));
+}
+
+ACE_UINT64 *
+TAO_Log_Segment::times () const
+{
+  return this->ids () + this->header ()->capacity_;
+}
+
+ACE_UINT64 *
+TAO_Log_Segment::offsets () const
+{
+  return this->times () + this->header ()->capacity_;
+}
+
+ACE_UINT32 *
+TAO_Log_Segment::lengths () const
+{
+  return reinterpret_cast<ACE_UINT32 *> (
+    this->offsets () + this->header ()->capacity_);
+}
+
+ACE_UINT8 *
+TAO_Log_Segment::flags () const
+{
+  return reinterpret_cast<ACE_UINT8 *> (
+    this->lengths () + this->header ()->capacity_);
+}
+
+char *
+TAO_Log_Segment::data () const
+{
+  return static_cast<char *> (this->map_.addr ())
+    + data_start (this->header ()->capacity_);
+}
+
+int
+TAO_Log_Segment::create (const ACE_TCHAR *path,
+                         ACE_UINT32 sequence,
+                         ACE_UINT32 capacity)
+{
+  if (capacity == 0)
+    return -1;
+
+  size_t const size =
+    data_start (capacity) + capacity * initial_record_size;
+
+  if (this->map_.map (path,
+                      size,
+                      O_RDWR | O_CREAT | O_EXCL,
+                      ACE_DEFAULT_FILE_PERMS,
+                      PROT_RDWR,
+                      ACE_MAP_SHARED) != 0)
+    return -1;
+
+  // The file is zero filled, only the non zero fields are set.
+  Header *header = this->header ();
+  ACE_OS::memcpy (header->magic_, segment_magic, sizeof (segment_magic));
+  header->sequence_ = sequence;
+  header->capacity_ = capacity;
+  header->flags_ = time_sorted_flag;
+  header->byte_order_ = ACE_CDR_BYTE_ORDER;
+  return 0;
+}
+
+int
+TAO_Log_Segment::open (const ACE_TCHAR *path)
+{
+  if (this->map_.map (path,
+                      static_cast<size_t> (-1),
+                      O_RDWR,
+                      ACE_DEFAULT_FILE_PERMS,
+                      PROT_RDWR,
+                      ACE_MAP_SHARED) != 0)
+    return -1;
+
+  size_t const size = this->map_.size ();
+  Header const *header = this->header ();
+
+  // Segments are written in the native byte order, and are not
+  // portable between hosts.
+  if (size < sizeof (Header)
+      || ACE_OS::memcmp (header->magic_,
+                         segment_magic,
+                         sizeof (segment_magic)) != 0
+      || header->byte_order_ != static_cast<ACE_UINT32> (ACE_CDR_BYTE_ORDER)
+      || header->capacity_ == 0
+      || header->count_ > header->capacity_
+      || size < data_start (header->capacity_)
+      || size - data_start (header->capacity_) < header->data_end_)
+    {
+      this->map_.close ();
+      return -1;
+    }
+
+  return 0;
+}
+
+int
+TAO_Log_Segment::remove ()
+{
+  return this->map_.remove ();
+}
+
+int
+TAO_Log_Segment::flush ()
+{
+  return this->map_.sync ();
+}
+
+ACE_UINT32
+TAO_Log_Segment::sequence () const
+{
+  return this->header ()->sequence_;
+}
+
+ACE_UINT32
+TAO_Log_Segment::capacity () const
+{
+  return this->header ()->capacity_;
+}
+
+ACE_UINT32
+TAO_Log_Segment::count () const
+{
+  return this->header ()->count_;
+}
+
+ACE_UINT32
+TAO_Log_Segment::live () const
+{
+  return this->header ()->live_;
+}
+
+ACE_UINT64
+TAO_Log_Segment::live_bytes () const
+{
+  return this->header ()->live_bytes_;
+}
+
+bool
+TAO_Log_Segment::full () const
+{
+  return this->header ()->count_ >= this->header ()->capacity_;
+}
+
+bool
+TAO_Log_Segment::time_sorted () const
+{
+  return (this->header ()->flags_ & time_sorted_flag) != 0;
+}
+
+ACE_UINT64
+TAO_Log_Segment::min_time () const
+{
+  return this->header ()->min_time_;
+}
+
+ACE_UINT64
+TAO_Log_Segment::max_time () const
+{
+  return this->header ()->max_time_;
+}
+
+DsLogAdmin::RecordId
+TAO_Log_Segment::min_id () const
+{
+  return this->header ()->min_id_;
+}
+
+DsLogAdmin::RecordId
+TAO_Log_Segment::max_id () const
+{
+  return this->header ()->max_id_;
+}
+
+DsLogAdmin::RecordId
+TAO_Log_Segment::id (ACE_UINT32 index) const
+{
+  return this->ids ()[index];
+}
+
+ACE_UINT64
+TAO_Log_Segment::time (ACE_UINT32 index) const
+{
+  return this->times ()[index];
+}
+
+bool
+TAO_Log_Segment::deleted (ACE_UINT32 index) const
+{
+  return this->flags ()[index] != 0;
+}
+
+ACE_UINT32
+TAO_Log_Segment::length (ACE_UINT32 index) const
+{
+  return this->lengths ()[index];
+}
+
+bool
+TAO_Log_Segment::find (DsLogAdmin::RecordId id, ACE_UINT32 &index) const
+{
+  // Ids are handed out in increasing order.
+  ACE_UINT64 const *first = this->ids ();
+  ACE_UINT64 const *last = first + this->header ()->count_;
+  ACE_UINT64 const *i = std::lower_bound (first, last, id);
+
+  if (i == last || *i != id)
+    return false;
+
+  index = static_cast<ACE_UINT32> (i - first);
+  return true;
+}
+
+ACE_UINT32
+TAO_Log_Segment::lower_bound (ACE_UINT64 time) const
+{
+  ACE_UINT64 const *first = this->times ();
+  ACE_UINT64 const *last = first + this->header ()->count_;
+
+  return static_cast<ACE_UINT32> (std::lower_bound (first, last, time) - first);
+}
+
+int
+TAO_Log_Segment::grow (size_t size)
+{
+  size_t new_size = 2 * this->map_.size ();
+  if (new_size < size)
+    new_size = size;
+
+  // Remapping in place could fail, let the system pick the address.
+  this->map_.unmap ();
+  return this->map_.map (new_size, PROT_RDWR, ACE_MAP_SHARED);
+}
+
+ACE_INT64
+TAO_Log_Segment::write (const TAO_OutputCDR &cdr)
+{
+  size_t const total = cdr.total_length ();
+  ACE_UINT64 const offset = this->header ()->data_end_;
+  size_t const needed =
+    data_start (this->header ()->capacity_) + offset + total;
+
+  if (needed > this->map_.size () && this->grow (needed) != 0)
+    return -1;
+
+  // The offsets are kept aligned, so the records can be decoded in
+  // place.
+  char *dst = this->data () + offset;
+  for (const ACE_Message_Block *mb = cdr.begin (); mb != 0; mb = mb->cont ())
+    {
+      ACE_OS::memcpy (dst, mb->rd_ptr (), mb->length ());
+      dst += mb->length ();
+    }
+
+  this->header ()->data_end_ = align8 (offset + total);
+  return static_cast<ACE_INT64> (offset);
+}
+
+int
+TAO_Log_Segment::append (DsLogAdmin::RecordId id,
+                         ACE_UINT64 time,
+                         const TAO_OutputCDR &cdr)
+{
+  if (this->full ())
+    return -1;
+
+  ACE_INT64 const offset = this->write (cdr);
+  if (offset < 0)
+    return -1;
+
+  ACE_UINT32 const length = static_cast<ACE_UINT32> (cdr.total_length ());
+  Header *header = this->header ();
+  ACE_UINT32 const index = header->count_;
+
+  this->ids ()[index] = id;
+  this->times ()[index] = time;
+  this->offsets ()[index] = static_cast<ACE_UINT64> (offset);
+  this->lengths ()[index] = length;
+  this->flags ()[index] = 0;
+
+  if (index == 0)
+    {
+      header->min_time_ = header->max_time_ = time;
+      header->min_id_ = header->max_id_ = id;
+    }
+  else
+    {
+      if (time < header->max_time_)
+        header->flags_ &= ~time_sorted_flag;
+
+      header->min_time_ = (std::min) (header->min_time_, time);
+      header->max_time_ = (std::max) (header->max_time_, time);
+      header->min_id_ = (std::min) (header->min_id_, id);
+      header->max_id_ = (std::max) (header->max_id_, id);
+    }
+
+  ++header->live_;
+  header->live_bytes_ += length;
+
+  // Counted last, a record is only visible once it is complete.
+  header->count_ = index + 1;
+  return 0;
+}
+
+int
+TAO_Log_Segment::replace (ACE_UINT32 index, const TAO_OutputCDR &cdr)
+{
+  ACE_INT64 const offset = this->write (cdr);
+  if (offset < 0)
+    return -1;
+
+  ACE_UINT32 const length = static_cast<ACE_UINT32> (cdr.total_length ());
+  if (!this->deleted (index))
+    {
+      this->header ()->live_bytes_ += length;
+      this->header ()->live_bytes_ -= this->lengths ()[index];
+    }
+
+  // The previous encoding is left behind, it is reclaimed with the
+  // segment.
+  this->offsets ()[index] = static_cast<ACE_UINT64> (offset);
+  this->lengths ()[index] = length;
+  return 0;
+}
+
+void
+TAO_Log_Segment::erase (ACE_UINT32 index)
+{
+  if (this->deleted (index))
+    return;
+
+  this->flags ()[index] = 1;
+
+  Header *header = this->header ();
+  --header->live_;
+  header->live_bytes_ -= this->lengths ()[index];
+}
+
+int
+TAO_Log_Segment::decode (ACE_UINT32 index, DsLogAdmin::LogRecord &rec) const
+{
+  TAO_InputCDR cdr (this->data () + this->offsets ()[index],
+                    this->lengths ()[index],
+                    ACE_CDR_BYTE_ORDER);
+
+  return (cdr >> rec) ? 0 : -1;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
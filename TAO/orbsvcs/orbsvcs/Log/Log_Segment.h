@@ -0,0 +1,173 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Log_Segment.h
+ *
+ *  A memory-mapped file holding a partition of the records of a log.
+ */
+//=============================================================================
+
+#ifndef TAO_LOG_SEGMENT_H
+#define TAO_LOG_SEGMENT_H
+
+#include /**/ "ace/pre.h"
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/DsLogAdminC.h"
+#include "orbsvcs/Log/log_serv_export.h"
+#include "tao/CDR.h"
+#include "ace/Mem_Map.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Log_Segment
+ *
+ * @brief A fixed number of LogRecords in a memory-mapped file.
+ *
+ * The file starts with a header holding the number of records and
+ * the smallest and largest id and time of the records ever appended.
+ * It is followed by one column per indexed field: the ids, the times,
+ * the offsets and the lengths of the records, and a deleted flag.
+ * The records themselves are CDR encoded in a data region following
+ * the columns, which grows as needed.
+ *
+ * Looking at the header is enough to tell whether a segment can hold
+ * records of a given time or id range, looking at the columns is
+ * enough to tell whether a record can match, a record is only
+ * decoded once it is known to be wanted.
+ *
+ * Records are never moved, deleting a record only sets its flag;
+ * the owner removes the file once all its records are deleted.  The
+ * segment does no locking of its own.
+ */
+class TAO_Log_Serv_Export TAO_Log_Segment
+{
+public:
+  /// Constructor.
+  TAO_Log_Segment ();
+
+  /// Destructor, unmaps the file.
+  ~TAO_Log_Segment ();
+
+  /// Create the file @a path for a segment of up to @a capacity
+  /// records.  Returns 0 on success, -1 on failure.
+  int create (const ACE_TCHAR *path,
+              ACE_UINT32 sequence,
+              ACE_UINT32 capacity);
+
+  /// Map the existing segment file @a path.  Returns 0 on success,
+  /// -1 if the file is not a valid segment.
+  int open (const ACE_TCHAR *path);
+
+  /// Unmap the file and remove it.
+  int remove ();
+
+  /// Force the file to storage.  Returns 0 on success, -1 on failure.
+  int flush ();
+
+  // = Header
+
+  /// The position of the segment in its log.
+  ACE_UINT32 sequence () const;
+
+  /// Number of records the segment can hold.
+  ACE_UINT32 capacity () const;
+
+  /// Number of records appended, deleted ones included.
+  ACE_UINT32 count () const;
+
+  /// Number of records not deleted.
+  ACE_UINT32 live () const;
+
+  /// Total size of the records not deleted.
+  ACE_UINT64 live_bytes () const;
+
+  /// True once no more records can be appended.
+  bool full () const;
+
+  /// True if the records were appended in time order.
+  bool time_sorted () const;
+
+  /// Bounds of the times and ids of the records ever appended, only
+  /// meaningful when count() is not 0.
+  ACE_UINT64 min_time () const;
+  ACE_UINT64 max_time () const;
+  DsLogAdmin::RecordId min_id () const;
+  DsLogAdmin::RecordId max_id () const;
+
+  // = Columns
+
+  DsLogAdmin::RecordId id (ACE_UINT32 index) const;
+  ACE_UINT64 time (ACE_UINT32 index) const;
+  bool deleted (ACE_UINT32 index) const;
+
+  /// Size of the encoded record.
+  ACE_UINT32 length (ACE_UINT32 index) const;
+
+  /// Find the record @a id.  Returns false if it has never been
+  /// appended.
+  bool find (DsLogAdmin::RecordId id, ACE_UINT32 &index) const;
+
+  /// Index of the first record whose time is not less than @a time,
+  /// only valid if time_sorted().
+  ACE_UINT32 lower_bound (ACE_UINT64 time) const;
+
+  // = Records
+
+  /// Append the record @a id logged at @a time, encoded in @a cdr.
+  /// The segment must not be full.  Returns 0 on success, -1 on
+  /// failure.
+  int append (DsLogAdmin::RecordId id,
+              ACE_UINT64 time,
+              const TAO_OutputCDR &cdr);
+
+  /// Replace the record at @a index by the record encoded in @a cdr,
+  /// which must have the same id and time.  Returns 0 on success, -1
+  /// on failure.
+  int replace (ACE_UINT32 index, const TAO_OutputCDR &cdr);
+
+  /// Mark the record at @a index as deleted.
+  void erase (ACE_UINT32 index);
+
+  /// Decode the record at @a index into @a rec.  Returns 0 on
+  /// success, -1 on failure.
+  int decode (ACE_UINT32 index, DsLogAdmin::LogRecord &rec) const;
+
+private:
+  TAO_Log_Segment (const TAO_Log_Segment &) = delete;
+  TAO_Log_Segment &operator= (const TAO_Log_Segment &) = delete;
+
+  struct Header;
+
+  Header *header () const;
+  ACE_UINT64 *ids () const;
+  ACE_UINT64 *times () const;
+  ACE_UINT64 *offsets () const;
+  ACE_UINT32 *lengths () const;
+  ACE_UINT8 *flags () const;
+  char *data () const;
+
+  /// Offset of the data region in a segment of @a capacity records.
+  static size_t data_start (ACE_UINT32 capacity);
+
+  /// Copy the encoded record to the end of the data region, growing
+  /// the file as needed.  Returns the offset of the record in the data
+  /// region, or -1 on failure.
+  ACE_INT64 write (const TAO_OutputCDR &cdr);
+
+  /// Map the file again with at least @a size bytes.
+  int grow (size_t size);
+
+  ACE_Mem_Map map_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_LOG_SEGMENT_H */
@@ -31,7 +31,7 @@ TAO_Log_i::TAO_Log_i (CORBA::ORB_ptr orb,
     op_state_ (DsLogAdmin::disabled),
     reactor_ (orb->orb_core()->reactor()),
     notifier_ (log_notifier),
-    log_compaction_handler_ (reactor_, this, log_compaction_interval_),
+    log_compaction_handler_ (this, log_compaction_interval_),
     log_flush_handler_ (reactor_, this, log_flush_interval_)
 {
   // TODO: get log parameters from (persistent?) store.
@@ -1053,6 +1053,26 @@ TAO_Log_i::remove_old_records ()
   const CORBA::ULong count =
     this->recordstore_->remove_old_records ();
 
+  this->old_records_removed (count);
+}
+
+void
+TAO_Log_i::remove_old_records (CORBA::ULong max_records, bool &done)
+{
+  ACE_WRITE_GUARD_THROW_EX (ACE_SYNCH_RW_MUTEX,
+                            guard,
+                            this->recordstore_->lock (),
+                            CORBA::INTERNAL ());
+
+  const CORBA::ULong count =
+    this->recordstore_->remove_old_records (max_records, done);
+
+  this->old_records_removed (count);
+}
+
+void
+TAO_Log_i::old_records_removed (CORBA::ULong count)
+{
   if (count > 0)
     {
       if (avail_status_.log_full)
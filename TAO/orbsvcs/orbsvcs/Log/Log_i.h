@@ -235,7 +235,17 @@ public:
   /// Remove records that have exceeded max_record_life_.
   void remove_old_records ();
 
+  /// Remove records that have exceeded max_record_life_, looking at
+  /// no more than @a max_records records under the write lock.
+  /// @a done is set once all the records have been looked at.
+  void remove_old_records (CORBA::ULong max_records, bool &done);
+
 protected:
+  /// Update the availability status and the capacity alarm threshold
+  /// after @a count old records have been removed.
+  /// @note must be called with locks held
+  void old_records_removed (CORBA::ULong count);
+
   /// Get the availability status
   /// @note must be called with locks held
   DsLogAdmin::AvailabilityStatus
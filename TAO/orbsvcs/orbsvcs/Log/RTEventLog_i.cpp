@@ -77,6 +77,8 @@ TAO_RTEventLog_i::destroy ()
 {
   notifier_->object_deletion (logid_);
 
+  this->log_compaction_handler_.stop ();
+
   // Remove ourselves from the list of logs.
   this->logmgr_i_.remove (this->logid_);
 
@@ -0,0 +1,78 @@
+#include "orbsvcs/Log/Segment_Iterator_i.h"
+#include "orbsvcs/DsLogAdminC.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Segment_Iterator_i::TAO_Segment_Iterator_i (
+  PortableServer::POA_ptr poa,
+  ACE_Reactor* reactor,
+  TAO_Segment_LogRecordStore* recordstore,
+  TAO_Segment_LogRecordStore::Filter* filter,
+  const TAO_Segment_LogRecordStore::Position& position,
+  CORBA::ULong start,
+  CORBA::ULong max_rec_list_len)
+  : TAO_Iterator_i(poa, reactor),
+    recordstore_ (recordstore),
+    filter_ (filter),
+    position_ (position),
+    current_position_(start),
+    max_rec_list_len_ (max_rec_list_len)
+{
+}
+
+
+TAO_Segment_Iterator_i::~TAO_Segment_Iterator_i ()
+{
+}
+
+
+DsLogAdmin::RecordList*
+TAO_Segment_Iterator_i::get (CORBA::ULong position, CORBA::ULong how_many)
+{
+  ACE_READ_GUARD_THROW_EX (ACE_SYNCH_RW_MUTEX,
+                           guard,
+                           this->recordstore_->lock (),
+                           CORBA::INTERNAL ());
+
+  if (position < current_position_)
+    {
+      throw DsLogAdmin::InvalidParam ();
+    }
+
+  if (how_many == 0)
+    {
+      how_many = this->max_rec_list_len_;
+    }
+
+  // The records before <position> are skipped.
+  CORBA::ULong const skip =
+    position > this->current_position_ + 1
+      ? position - this->current_position_ - 1
+      : 0;
+  CORBA::ULong left = skip;
+
+  DsLogAdmin::RecordList* rec_list = 0;
+  ACE_NEW_THROW_EX (rec_list,
+                    DsLogAdmin::RecordList (how_many),
+                    CORBA::NO_MEMORY ());
+  DsLogAdmin::RecordList_var safe_rec_list (rec_list);
+
+  CORBA::ULong const count =
+    this->recordstore_->fetch (*this->filter_,
+                               this->position_,
+                               left,
+                               how_many,
+                               *rec_list);
+
+  this->current_position_ += (skip - left) + count;
+
+  if (count == 0 && this->position_.done_)
+    {
+      // destroy this object..
+      this->destroy ();
+    }
+
+  return safe_rec_list._retn ();
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,87 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Segment_Iterator_i.h
+ *
+ *  Implementation of the DsLogAdmin::Iterator interface for the
+ *  TAO_Segment_LogRecordStore.
+ */
+//=============================================================================
+
+#ifndef TAO_TLS_SEGMENT_ITERATOR_H
+#define TAO_TLS_SEGMENT_ITERATOR_H
+
+#include /**/ "ace/pre.h"
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Log/Iterator_i.h"
+#include "orbsvcs/Log/Segment_LogRecordStore.h"
+
+// This is to remove "inherits via dominance" warnings from MSVC.
+// MSVC is being a little too paranoid.
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4250)
+#endif /* _MSC_VER */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Segment_Iterator_i
+ *
+ * @brief Iterator to get LogRecords for the log via a query.
+ *
+ * The iterator keeps the filter of the query, and the position in
+ * the segments where the previous get() stopped.
+ */
+class TAO_Log_Serv_Export TAO_Segment_Iterator_i
+  : public TAO_Iterator_i
+{
+public:
+  /// Constructor, takes ownership of @a filter.
+  TAO_Segment_Iterator_i (PortableServer::POA_ptr poa,
+                          ACE_Reactor* reactor,
+                          TAO_Segment_LogRecordStore* recordstore,
+                          TAO_Segment_LogRecordStore::Filter* filter,
+                          const TAO_Segment_LogRecordStore::Position& position,
+                          CORBA::ULong start,
+                          CORBA::ULong max_rec_list_len);
+
+  /// Destructor.
+  virtual ~TAO_Segment_Iterator_i ();
+
+  /// Gets a list of LogRecords.
+  virtual DsLogAdmin::RecordList* get (CORBA::ULong position,
+                                       CORBA::ULong how_many);
+
+private:
+  /// Pointer to record store
+  TAO_Segment_LogRecordStore* recordstore_;
+
+  /// The records selected.
+  std::unique_ptr<TAO_Segment_LogRecordStore::Filter> filter_;
+
+  /// Where the next get() starts.
+  TAO_Segment_LogRecordStore::Position position_;
+
+  /// Position.
+  CORBA::ULong current_position_;
+
+  /// Max rec list length.
+  CORBA::ULong max_rec_list_len_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif /* _MSC_VER */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_TLS_SEGMENT_ITERATOR_H */
@@ -0,0 +1,1209 @@
+#include "orbsvcs/Log_Macros.h"
+#include "orbsvcs/Log/Segment_LogRecordStore.h"
+#include "orbsvcs/Log/Segment_Iterator_i.h"
+#include "orbsvcs/Log/Log_Constraint_Interpreter.h"
+#include "orbsvcs/Log/Log_Constraint_Visitors.h"
+#include "orbsvcs/Time_Utilities.h"
+#include "ace/ETCL/ETCL_y.h"
+#include "ace/Dirent.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_time.h"
+
+#include <algorithm>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  bool
+  sequence_less (const TAO_Log_Segment *lhs, const TAO_Log_Segment *rhs)
+  {
+    return lhs->sequence () < rhs->sequence ();
+  }
+
+  bool
+  sequence_before (const TAO_Log_Segment *segment, ACE_UINT32 sequence)
+  {
+    return segment->sequence () < sequence;
+  }
+
+  bool
+  max_id_before (const TAO_Log_Segment *segment, DsLogAdmin::RecordId id)
+  {
+    return segment->max_id () < id;
+  }
+
+  /// Copies the records into a RecordList.
+  class Fetch_Action : public TAO_Segment_LogRecordStore::Action
+  {
+  public:
+    Fetch_Action (CORBA::ULong &skip,
+                  CORBA::ULong how_many,
+                  DsLogAdmin::RecordList &records)
+      : skip_ (skip),
+        how_many_ (how_many),
+        records_ (records),
+        count_ (0)
+    {
+    }
+
+    virtual bool needs_record () const
+    {
+      return true;
+    }
+
+    virtual bool apply (TAO_Log_Segment &,
+                        ACE_UINT32,
+                        DsLogAdmin::LogRecord &rec)
+    {
+      if (this->skip_ > 0)
+        {
+          --this->skip_;
+          return true;
+        }
+
+      this->records_[this->count_] = rec;
+      return ++this->count_ < this->how_many_;
+    }
+
+    CORBA::ULong count () const
+    {
+      return this->count_;
+    }
+
+  private:
+    CORBA::ULong &skip_;
+    CORBA::ULong const how_many_;
+    DsLogAdmin::RecordList &records_;
+    CORBA::ULong count_;
+  };
+
+  /// Counts the records.
+  class Match_Action : public TAO_Segment_LogRecordStore::Action
+  {
+  public:
+    Match_Action ()
+      : count_ (0)
+    {
+    }
+
+    virtual bool needs_record () const
+    {
+      return false;
+    }
+
+    virtual bool apply (TAO_Log_Segment &,
+                        ACE_UINT32,
+                        DsLogAdmin::LogRecord &)
+    {
+      ++this->count_;
+      return true;
+    }
+
+    CORBA::ULong count_;
+  };
+}
+
+// ****************************************************************
+
+TAO_Segment_LogRecordStore::Action::~Action ()
+{
+}
+
+// ****************************************************************
+
+TAO_Segment_LogRecordStore::Filter::Filter (const char *constraint)
+  : interpreter_ (new TAO_Log_Constraint_Interpreter (constraint)),
+    windowed_ (false),
+    before_ (false),
+    from_time_ (0)
+{
+  this->collect (this->interpreter_->root ());
+}
+
+TAO_Segment_LogRecordStore::Filter::Filter (DsLogAdmin::TimeT from_time,
+                                            bool before)
+  : windowed_ (true),
+    before_ (before),
+    from_time_ (from_time)
+{
+}
+
+TAO_Segment_LogRecordStore::Filter::~Filter ()
+{
+}
+
+void
+TAO_Segment_LogRecordStore::Filter::collect (ETCL_Constraint *node)
+{
+  ETCL_Binary_Expr *binary = dynamic_cast<ETCL_Binary_Expr *> (node);
+  if (binary == 0)
+    return;
+
+  int op = binary->type ();
+  if (op == ETCL_AND)
+    {
+      this->collect (binary->lhs ());
+      this->collect (binary->rhs ());
+      return;
+    }
+
+  ETCL_Identifier *identifier =
+    dynamic_cast<ETCL_Identifier *> (binary->lhs ());
+  ETCL_Literal_Constraint *literal =
+    dynamic_cast<ETCL_Literal_Constraint *> (binary->rhs ());
+
+  if (identifier == 0)
+    {
+      // <number> <op> <field>, turned around.
+      identifier = dynamic_cast<ETCL_Identifier *> (binary->rhs ());
+      literal = dynamic_cast<ETCL_Literal_Constraint *> (binary->lhs ());
+
+      switch (op)
+        {
+        case ETCL_LT: op = ETCL_GT; break;
+        case ETCL_LE: op = ETCL_GE; break;
+        case ETCL_GT: op = ETCL_LT; break;
+        case ETCL_GE: op = ETCL_LE; break;
+        default: break;
+        }
+    }
+
+  if (identifier == 0 || literal == 0)
+    return;
+
+  switch (op)
+    {
+    case ETCL_LT:
+    case ETCL_LE:
+    case ETCL_GT:
+    case ETCL_GE:
+    case ETCL_EQ:
+      break;
+    default:
+      return;
+    }
+
+  // Only numbers, the names of the literal types are not public.
+  if (literal->expr_type () == ETCL_Literal_Constraint ("").expr_type ()
+      || literal->expr_type () == ETCL_Literal_Constraint (false).expr_type ())
+    return;
+
+  Bound bound;
+  if (ACE_OS::strcmp (identifier->value (), "time") == 0)
+    bound.time_ = true;
+  else if (ACE_OS::strcmp (identifier->value (), "id") == 0)
+    bound.time_ = false;
+  else
+    return;
+
+  bound.op_ = op;
+  bound.value_ = TAO_ETCL_Literal_Constraint (literal);
+  this->bounds_.push_back (bound);
+}
+
+bool
+TAO_Segment_LogRecordStore::Filter::compare (
+  ACE_UINT64 value,
+  int op,
+  const TAO_ETCL_Literal_Constraint &literal)
+{
+  // TAO_Log_Constraint_Visitor binds "id" and "time" as ULongs.
+  TAO_ETCL_Literal_Constraint lhs (static_cast<CORBA::ULong> (value));
+
+  switch (op)
+    {
+    case ETCL_LT:
+      return lhs < literal;
+    case ETCL_LE:
+      return lhs <= literal;
+    case ETCL_GT:
+      return lhs > literal;
+    case ETCL_GE:
+      return lhs >= literal;
+    case ETCL_EQ:
+      return lhs == literal;
+    default:
+      return true;
+    }
+}
+
+bool
+TAO_Segment_LogRecordStore::Filter::covers (
+  const TAO_Log_Segment &segment) const
+{
+  if (segment.live () == 0)
+    return false;
+
+  if (this->windowed_)
+    return this->before_
+      ? segment.min_time () < this->from_time_
+      : segment.max_time () >= this->from_time_;
+
+  for (std::vector<Bound>::const_iterator i = this->bounds_.begin ();
+       i != this->bounds_.end ();
+       ++i)
+    {
+      ACE_UINT64 const lo = i->time_ ? segment.min_time () : segment.min_id ();
+      ACE_UINT64 const hi = i->time_ ? segment.max_time () : segment.max_id ();
+
+      // Unless the bounds agree on the bits above the 31 low ones,
+      // the truncated values are not ordered like the values, as
+      // unsigned or as signed numbers.
+      if ((lo >> 31) != (hi >> 31))
+        continue;
+
+      // The comparison is monotonic between <lo> and <hi>, it is
+      // enough to look at the end it favors.
+      switch (i->op_)
+        {
+        case ETCL_LT:
+        case ETCL_LE:
+          if (!compare (lo, i->op_, i->value_))
+            return false;
+          break;
+        case ETCL_GT:
+        case ETCL_GE:
+          if (!compare (hi, i->op_, i->value_))
+            return false;
+          break;
+        case ETCL_EQ:
+          if (!compare (lo, ETCL_LE, i->value_)
+              || !compare (hi, ETCL_GE, i->value_))
+            return false;
+          break;
+        default:
+          break;
+        }
+    }
+
+  return true;
+}
+
+void
+TAO_Segment_LogRecordStore::Filter::range (const TAO_Log_Segment &segment,
+                                           ACE_UINT32 &first,
+                                           ACE_UINT32 &last) const
+{
+  first = 0;
+  last = segment.count ();
+
+  if (this->windowed_ && segment.time_sorted ())
+    {
+      ACE_UINT32 const bound = segment.lower_bound (this->from_time_);
+      if (this->before_)
+        last = bound;
+      else
+        first = bound;
+    }
+}
+
+bool
+TAO_Segment_LogRecordStore::Filter::accepts (const TAO_Log_Segment &segment,
+                                             ACE_UINT32 index) const
+{
+  if (segment.deleted (index))
+    return false;
+
+  if (this->windowed_)
+    return this->before_
+      ? segment.time (index) < this->from_time_
+      : segment.time (index) >= this->from_time_;
+
+  for (std::vector<Bound>::const_iterator i = this->bounds_.begin ();
+       i != this->bounds_.end ();
+       ++i)
+    {
+      ACE_UINT64 const value =
+        i->time_ ? segment.time (index) : segment.id (index);
+
+      if (!compare (value, i->op_, i->value_))
+        return false;
+    }
+
+  return true;
+}
+
+bool
+TAO_Segment_LogRecordStore::Filter::evaluates () const
+{
+  return this->interpreter_.get () != 0;
+}
+
+bool
+TAO_Segment_LogRecordStore::Filter::evaluate (
+  const DsLogAdmin::LogRecord &rec)
+{
+  if (this->interpreter_.get () == 0)
+    return true;
+
+  TAO_Log_Constraint_Visitor visitor (rec);
+  return this->interpreter_->evaluate (visitor) == 1;
+}
+
+// ****************************************************************
+
+TAO_Segment_LogRecordStore::TAO_Segment_LogRecordStore (
+  TAO_LogMgr_i* logmgr_i,
+  DsLogAdmin::LogId logid,
+  DsLogAdmin::LogFullActionType log_full_action,
+  CORBA::ULongLong max_size,
+  const DsLogAdmin::CapacityAlarmThresholdList* thresholds,
+  const ACE_CString &directory,
+  ACE_UINT32 segment_capacity,
+  ACE_UINT32 segment_duration)
+  : TAO_Hash_LogRecordStore (logmgr_i,
+                             logid,
+                             log_full_action,
+                             max_size,
+                             thresholds),
+    directory_ (directory),
+    segment_capacity_ (segment_capacity),
+    segment_duration_ (static_cast<DsLogAdmin::TimeT> (segment_duration)
+                       * 10000000),
+    next_sequence_ (0),
+    compaction_position_ (),
+    compaction_end_id_ (0),
+    opened_ (false)
+{
+}
+
+TAO_Segment_LogRecordStore::~TAO_Segment_LogRecordStore ()
+{
+  this->close ();
+}
+
+ACE_CString
+TAO_Segment_LogRecordStore::segment_path (ACE_UINT32 sequence) const
+{
+  char name[32];
+  ACE_OS::snprintf (name, sizeof (name), "/%lu-%lu.seg",
+                    static_cast<unsigned long> (this->id_),
+                    static_cast<unsigned long> (sequence));
+
+  return this->directory_ + name;
+}
+
+int
+TAO_Segment_LogRecordStore::open ()
+{
+  if (this->opened_)
+    return 0;
+
+  ACE_Dirent dir;
+  if (dir.open (ACE_TEXT_CHAR_TO_TCHAR (this->directory_.c_str ())) == -1)
+    ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("Segment_LogRecordStore (%P|%t): ")
+                           ACE_TEXT ("cannot open %C: %p\n"),
+                           this->directory_.c_str (),
+                           ACE_TEXT ("opendir")),
+                          -1);
+
+  char prefix[16];
+  ACE_OS::snprintf (prefix, sizeof (prefix), "%lu-",
+                    static_cast<unsigned long> (this->id_));
+  size_t const prefix_len = ACE_OS::strlen (prefix);
+
+  for (ACE_DIRENT *entry = dir.read (); entry != 0; entry = dir.read ())
+    {
+      ACE_CString const name (ACE_TEXT_ALWAYS_CHAR (entry->d_name));
+      if (ACE_OS::strncmp (name.c_str (), prefix, prefix_len) != 0)
+        continue;
+
+      char *end = 0;
+      unsigned long const sequence =
+        ACE_OS::strtoul (name.c_str () + prefix_len, &end, 10);
+      if (end == name.c_str () + prefix_len
+          || ACE_OS::strcmp (end, ".seg") != 0)
+        continue;
+
+      TAO_Log_Segment *segment = 0;
+      ACE_NEW_RETURN (segment, TAO_Log_Segment, -1);
+      std::unique_ptr<TAO_Log_Segment> safe_segment (segment);
+
+      ACE_CString const path = this->segment_path (sequence);
+      if (segment->open (ACE_TEXT_CHAR_TO_TCHAR (path.c_str ())) != 0
+          || segment->sequence () != sequence)
+        {
+          ORBSVCS_ERROR ((LM_ERROR,
+                          ACE_TEXT ("Segment_LogRecordStore (%P|%t): ")
+                          ACE_TEXT ("ignoring %C, not a segment of the log\n"),
+                          path.c_str ()));
+          continue;
+        }
+
+      // A segment is created for a record, an empty one was left by a
+      // failure and would only get in the way of the ordering by id.
+      if (segment->count () == 0)
+        {
+          segment->remove ();
+          continue;
+        }
+
+      this->segments_.push_back (safe_segment.release ());
+    }
+
+  std::sort (this->segments_.begin (), this->segments_.end (), sequence_less);
+
+  for (Segment_List::iterator i = this->segments_.begin ();
+       i != this->segments_.end ();
+       ++i)
+    {
+      this->num_records_ += (*i)->live ();
+      this->current_size_ += (*i)->live_bytes ();
+      this->maxid_ = (std::max) (this->maxid_, (*i)->max_id ());
+      this->next_sequence_ = (*i)->sequence () + 1;
+    }
+
+  this->opened_ = true;
+  return 0;
+}
+
+int
+TAO_Segment_LogRecordStore::close ()
+{
+  int result = this->flush ();
+
+  for (Segment_List::iterator i = this->segments_.begin ();
+       i != this->segments_.end ();
+       ++i)
+    delete *i;
+
+  this->segments_.clear ();
+  this->num_records_ = 0;
+  this->current_size_ = 0;
+  this->opened_ = false;
+  return result;
+}
+
+void
+TAO_Segment_LogRecordStore::remove_segments ()
+{
+  ACE_WRITE_GUARD (ACE_SYNCH_RW_MUTEX, guard, this->lock_);
+
+  for (Segment_List::iterator i = this->segments_.begin ();
+       i != this->segments_.end ();
+       ++i)
+    {
+      (*i)->remove ();
+      delete *i;
+    }
+
+  this->segments_.clear ();
+  this->num_records_ = 0;
+  this->current_size_ = 0;
+}
+
+TAO_Log_Segment *
+TAO_Segment_LogRecordStore::active_segment (DsLogAdmin::TimeT time)
+{
+  if (!this->segments_.empty ())
+    {
+      TAO_Log_Segment *last = this->segments_.back ();
+      if (!last->full ()
+          && (last->count () == 0
+              || time < last->min_time () + this->segment_duration_))
+        return last;
+    }
+
+  TAO_Log_Segment *segment = 0;
+  ACE_NEW_RETURN (segment, TAO_Log_Segment, 0);
+  std::unique_ptr<TAO_Log_Segment> safe_segment (segment);
+
+  ACE_CString const path = this->segment_path (this->next_sequence_);
+  if (segment->create (ACE_TEXT_CHAR_TO_TCHAR (path.c_str ()),
+                       this->next_sequence_,
+                       this->segment_capacity_) != 0)
+    ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("Segment_LogRecordStore (%P|%t): ")
+                           ACE_TEXT ("cannot create %C: %p\n"),
+                           path.c_str (),
+                           ACE_TEXT ("create")),
+                          0);
+
+  ++this->next_sequence_;
+  this->segments_.push_back (segment);
+  return safe_segment.release ();
+}
+
+TAO_Log_Segment *
+TAO_Segment_LogRecordStore::find_segment (DsLogAdmin::RecordId id,
+                                          ACE_UINT32 &index) const
+{
+  // The segments are in id order, the first one whose largest id is
+  // not less than <id> is the only one that can hold it.
+  Segment_List::const_iterator i =
+    std::lower_bound (this->segments_.begin (),
+                      this->segments_.end (),
+                      id,
+                      max_id_before);
+
+  if (i == this->segments_.end ()
+      || !(*i)->find (id, index)
+      || (*i)->deleted (index))
+    return 0;
+
+  return *i;
+}
+
+void
+TAO_Segment_LogRecordStore::erase (TAO_Log_Segment &segment,
+                                   ACE_UINT32 index)
+{
+  --this->num_records_;
+  this->current_size_ -= segment.length (index);
+  segment.erase (index);
+}
+
+void
+TAO_Segment_LogRecordStore::remove_first_segment ()
+{
+  TAO_Log_Segment *segment = this->segments_.front ();
+
+  this->num_records_ -= segment->live ();
+  this->current_size_ -= segment->live_bytes ();
+
+  segment->remove ();
+  delete segment;
+  this->segments_.erase (this->segments_.begin ());
+}
+
+void
+TAO_Segment_LogRecordStore::remove_empty_segments ()
+{
+  if (this->segments_.empty ())
+    return;
+
+  Segment_List::iterator const last = this->segments_.end () - 1;
+  Segment_List::iterator out = this->segments_.begin ();
+
+  for (Segment_List::iterator i = this->segments_.begin (); i != last; ++i)
+    {
+      if ((*i)->live () == 0)
+        {
+          (*i)->remove ();
+          delete *i;
+        }
+      else
+        *out++ = *i;
+    }
+
+  *out++ = *last;
+  this->segments_.erase (out, this->segments_.end ());
+}
+
+int
+TAO_Segment_LogRecordStore::log (const DsLogAdmin::LogRecord &const_rec)
+{
+  // Copy record...
+  DsLogAdmin::LogRecord rec = const_rec;
+
+  rec.id = this->maxid_ + 1;
+  rec.time = ORBSVCS_Time::to_Absolute_TimeT (ACE_OS::gettimeofday ());
+
+  TAO_OutputCDR cdr;
+  if (!(cdr << rec))
+    ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                           "Segment_LogRecordStore (%P|%t): "
+                           "Failed to encode %Q\n",
+                           rec.id),
+                          -1);
+
+  // The size of a record is the size of its encoding.
+  size_t const record_size = cdr.total_length ();
+
+  // Check if we are allowed to write...
+  if (max_size_ !=0 && ((current_size_ + record_size) >= max_size_))
+    return 1; // return code for log rec. full
+
+  TAO_Log_Segment *segment = this->active_segment (rec.time);
+  if (segment == 0 || segment->append (rec.id, rec.time, cdr) != 0)
+    ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                           "Segment_LogRecordStore (%P|%t): "
+                           "Failed to write %Q to a segment\n",
+                           rec.id),
+                          -1);
+
+  ++this->maxid_;
+  ++this->num_records_;
+  this->current_size_ += record_size;
+  this->gauge_ += record_size;
+
+  return 0;
+}
+
+int
+TAO_Segment_LogRecordStore::purge_old_records ()
+{
+  CORBA::ULongLong num_records_to_purge = this->num_records_ * 5U / 100U;
+
+  if (num_records_to_purge < 1)
+    num_records_to_purge = 1;
+
+  CORBA::ULong count = 0;
+
+  while (num_records_to_purge > 0 && !this->segments_.empty ())
+    {
+      TAO_Log_Segment &segment = *this->segments_.front ();
+
+      // Whole segments go at once, the last one stays for its ids.
+      if (segment.live () <= num_records_to_purge
+          && this->segments_.size () > 1)
+        {
+          num_records_to_purge -= segment.live ();
+          count += segment.live ();
+          this->remove_first_segment ();
+          continue;
+        }
+
+      for (ACE_UINT32 i = 0;
+           i < segment.count () && num_records_to_purge > 0;
+           ++i)
+        {
+          if (!segment.deleted (i))
+            {
+              this->erase (segment, i);
+              --num_records_to_purge;
+              ++count;
+            }
+        }
+      break;
+    }
+
+  return count;
+}
+
+void
+TAO_Segment_LogRecordStore::set_record_attribute (
+  DsLogAdmin::RecordId id,
+  const DsLogAdmin::NVList &attr_list)
+{
+  ACE_UINT32 index = 0;
+  TAO_Log_Segment *segment = this->find_segment (id, index);
+
+  DsLogAdmin::LogRecord rec;
+  if (segment == 0 || segment->decode (index, rec) != 0)
+    {
+      throw DsLogAdmin::InvalidRecordId ();
+    }
+
+  rec.attr_list = attr_list;
+  this->update (*segment, index, rec);
+}
+
+void
+TAO_Segment_LogRecordStore::update (TAO_Log_Segment &segment,
+                                    ACE_UINT32 index,
+                                    const DsLogAdmin::LogRecord &rec)
+{
+  TAO_OutputCDR cdr;
+  if (!(cdr << rec))
+    {
+      throw CORBA::PERSIST_STORE ();
+    }
+
+  ACE_UINT32 const old_size = segment.length (index);
+  if (segment.replace (index, cdr) != 0)
+    {
+      throw CORBA::PERSIST_STORE ();
+    }
+
+  this->current_size_ -= old_size;
+  this->current_size_ += segment.length (index);
+}
+
+CORBA::ULong
+TAO_Segment_LogRecordStore::set_records_attribute (
+  const char *grammar,
+  const char *constraint,
+  const DsLogAdmin::NVList &attr_list)
+{
+  this->check_grammar (grammar);
+
+  Filter filter (constraint);
+
+  // The records are rewritten at the end of their segment, not in
+  // the way of the scan.
+  class Set_Attribute_Action : public Action
+  {
+  public:
+    Set_Attribute_Action (TAO_Segment_LogRecordStore &store,
+                          const DsLogAdmin::NVList &attr_list)
+      : store_ (store),
+        attr_list_ (attr_list),
+        count_ (0)
+    {
+    }
+
+    virtual bool needs_record () const
+    {
+      return true;
+    }
+
+    virtual bool apply (TAO_Log_Segment &segment,
+                        ACE_UINT32 index,
+                        DsLogAdmin::LogRecord &rec)
+    {
+      rec.attr_list = this->attr_list_;
+      this->store_.update (segment, index, rec);
+      ++this->count_;
+      return true;
+    }
+
+    TAO_Segment_LogRecordStore &store_;
+    const DsLogAdmin::NVList &attr_list_;
+    CORBA::ULong count_;
+  } action (*this, attr_list);
+
+  Position position = { 0, 0, false };
+  this->scan (filter, position, action);
+
+  return action.count_;
+}
+
+DsLogAdmin::NVList*
+TAO_Segment_LogRecordStore::get_record_attribute (DsLogAdmin::RecordId id)
+{
+  ACE_UINT32 index = 0;
+  TAO_Log_Segment *segment = this->find_segment (id, index);
+
+  DsLogAdmin::LogRecord rec;
+  if (segment == 0 || segment->decode (index, rec) != 0)
+    {
+      throw DsLogAdmin::InvalidRecordId ();
+    }
+
+  DsLogAdmin::NVList* nvlist = 0;
+  ACE_NEW_THROW_EX (nvlist,
+                    DsLogAdmin::NVList (rec.attr_list),
+                    CORBA::NO_MEMORY ());
+
+  return nvlist;
+}
+
+int
+TAO_Segment_LogRecordStore::flush ()
+{
+  int result = 0;
+
+  for (Segment_List::iterator i = this->segments_.begin ();
+       i != this->segments_.end ();
+       ++i)
+    {
+      if ((*i)->flush () != 0)
+        result = -1;
+    }
+
+  return result;
+}
+
+void
+TAO_Segment_LogRecordStore::scan (Filter &filter,
+                                  Position &position,
+                                  Action &action)
+{
+  Segment_List::iterator i =
+    std::lower_bound (this->segments_.begin (),
+                      this->segments_.end (),
+                      position.segment_,
+                      sequence_before);
+
+  // The segment the scan stopped in may have been removed since.
+  ACE_UINT32 start = 0;
+  if (i != this->segments_.end () && (*i)->sequence () == position.segment_)
+    start = position.index_;
+
+  for ( ; i != this->segments_.end (); ++i, start = 0)
+    {
+      TAO_Log_Segment &segment = **i;
+      if (!filter.covers (segment))
+        continue;
+
+      ACE_UINT32 first = 0;
+      ACE_UINT32 last = 0;
+      filter.range (segment, first, last);
+
+      for (ACE_UINT32 index = (std::max) (first, start); index < last; ++index)
+        {
+          if (!filter.accepts (segment, index))
+            continue;
+
+          DsLogAdmin::LogRecord rec;
+          if (filter.evaluates () || action.needs_record ())
+            {
+              if (segment.decode (index, rec) != 0)
+                {
+                  ORBSVCS_ERROR ((LM_ERROR,
+                                  "Segment_LogRecordStore (%P|%t): "
+                                  "Failed to decode %Q\n",
+                                  segment.id (index)));
+                  continue;
+                }
+
+              if (!filter.evaluate (rec))
+                continue;
+            }
+
+          if (!action.apply (segment, index, rec))
+            {
+              position.segment_ = segment.sequence ();
+              position.index_ = index + 1;
+              position.done_ = false;
+              return;
+            }
+        }
+    }
+
+  position.segment_ = this->next_sequence_;
+  position.index_ = 0;
+  position.done_ = true;
+}
+
+CORBA::ULong
+TAO_Segment_LogRecordStore::fetch (Filter &filter,
+                                   Position &position,
+                                   CORBA::ULong &skip,
+                                   CORBA::ULong how_many,
+                                   DsLogAdmin::RecordList &records)
+{
+  records.length (how_many);
+
+  Fetch_Action action (skip, how_many, records);
+  if (how_many > 0)
+    this->scan (filter, position, action);
+
+  records.length (action.count ());
+  return action.count ();
+}
+
+DsLogAdmin::RecordList*
+TAO_Segment_LogRecordStore::query_i (Filter *filter,
+                                     DsLogAdmin::Iterator_out &iter_out,
+                                     CORBA::ULong how_many)
+{
+  std::unique_ptr<Filter> safe_filter (filter);
+
+  DsLogAdmin::RecordList* rec_list = 0;
+  ACE_NEW_THROW_EX (rec_list,
+                    DsLogAdmin::RecordList (how_many),
+                    CORBA::NO_MEMORY ());
+  DsLogAdmin::RecordList_var safe_rec_list (rec_list);
+
+  Position position = { 0, 0, false };
+  CORBA::ULong skip = 0;
+  CORBA::ULong const count =
+    this->fetch (*filter, position, skip, how_many, *rec_list);
+
+  if (!position.done_)          // There are more records to process.
+    {
+      // Create an iterator to pass out.
+      TAO_Segment_Iterator_i *iter_query = 0;
+      ACE_NEW_THROW_EX (iter_query,
+                        TAO_Segment_Iterator_i (this->iterator_poa_.in (),
+                                                this->reactor_,
+                                                this,
+                                                safe_filter.release (),
+                                                position,
+                                                count,
+                                                this->max_rec_list_len_),
+                        CORBA::NO_MEMORY ());
+
+      // Transfer ownership to the POA.
+      PortableServer::ServantBase_var safe_iter_query = iter_query;
+
+      // Activate it.
+      PortableServer::ObjectId_var oid =
+        this->iterator_poa_->activate_object (iter_query);
+      CORBA::Object_var obj =
+        this->iterator_poa_->id_to_reference (oid.in ());
+
+      // Narrow it
+      iter_out = DsLogAdmin::Iterator::_narrow (obj.in ());
+    }
+
+  return safe_rec_list._retn ();
+}
+
+DsLogAdmin::RecordList*
+TAO_Segment_LogRecordStore::query (const char *grammar,
+                                   const char *constraint,
+                                   DsLogAdmin::Iterator_out iter_out)
+{
+  this->check_grammar (grammar);
+
+  Filter *filter = 0;
+  ACE_NEW_THROW_EX (filter,
+                    Filter (constraint),
+                    CORBA::NO_MEMORY ());
+
+  return this->query_i (filter, iter_out, this->max_rec_list_len_);
+}
+
+DsLogAdmin::RecordList*
+TAO_Segment_LogRecordStore::retrieve (DsLogAdmin::TimeT from_time,
+                                      CORBA::Long how_many,
+                                      DsLogAdmin::Iterator_out iter_out)
+{
+  // Unlike the constraint "time >= <from_time>", the window compares
+  // the full times.
+  bool const before = how_many < 0;
+
+  Filter *filter = 0;
+  ACE_NEW_THROW_EX (filter,
+                    Filter (from_time, before),
+                    CORBA::NO_MEMORY ());
+
+  CORBA::ULong const count = before
+    ? static_cast<CORBA::ULong> (-(how_many + 1)) + 1
+    : static_cast<CORBA::ULong> (how_many);
+
+  return this->query_i (filter, iter_out, count);
+}
+
+CORBA::ULong
+TAO_Segment_LogRecordStore::match (const char* grammar,
+                                   const char *constraint)
+{
+  this->check_grammar (grammar);
+
+  Filter filter (constraint);
+  Match_Action action;
+  Position position = { 0, 0, false };
+  this->scan (filter, position, action);
+
+  return action.count_;
+}
+
+CORBA::ULong
+TAO_Segment_LogRecordStore::delete_records (const char *grammar,
+                                            const char *constraint)
+{
+  this->check_grammar (grammar);
+
+  Filter filter (constraint);
+
+  class Delete_Action : public Action
+  {
+  public:
+    explicit Delete_Action (TAO_Segment_LogRecordStore &store)
+      : store_ (store),
+        count_ (0)
+    {
+    }
+
+    virtual bool needs_record () const
+    {
+      return false;
+    }
+
+    virtual bool apply (TAO_Log_Segment &segment,
+                        ACE_UINT32 index,
+                        DsLogAdmin::LogRecord &)
+    {
+      this->store_.erase (segment, index);
+      ++this->count_;
+      return true;
+    }
+
+    TAO_Segment_LogRecordStore &store_;
+    CORBA::ULong count_;
+  } action (*this);
+
+  Position position = { 0, 0, false };
+  this->scan (filter, position, action);
+  this->remove_empty_segments ();
+
+  return action.count_;
+}
+
+CORBA::ULong
+TAO_Segment_LogRecordStore::delete_records_by_id (
+  const DsLogAdmin::RecordIdList &ids)
+{
+  CORBA::ULong count (0);
+
+  for (CORBA::ULong i = 0; i < ids.length (); i++)
+    {
+      ACE_UINT32 index = 0;
+      TAO_Log_Segment *segment = this->find_segment (ids[i], index);
+      if (segment != 0)
+        {
+          this->erase (*segment, index);
+          ++count;
+        }
+    }
+
+  this->remove_empty_segments ();
+
+  return count;
+}
+
+CORBA::ULong
+TAO_Segment_LogRecordStore::remove_old_records ()
+{
+  if (this->max_record_life_ == 0 || this->segments_.empty ()) {
+    return 0;
+  }
+
+  TimeBase::TimeT purge_time (ORBSVCS_Time::to_Absolute_TimeT ((ACE_OS::gettimeofday () - ACE_Time_Value(this->max_record_life_))));
+
+  CORBA::ULong count = 0;
+
+  Segment_List::iterator const last = this->segments_.end () - 1;
+  Segment_List::iterator out = this->segments_.begin ();
+
+  for (Segment_List::iterator i = this->segments_.begin ();
+       i != this->segments_.end ();
+       ++i)
+    {
+      TAO_Log_Segment &segment = **i;
+
+      // Segments entirely too old go at once, the last one stays for
+      // its ids.
+      if (i != last && segment.max_time () < purge_time)
+        {
+          count += segment.live ();
+          this->num_records_ -= segment.live ();
+          this->current_size_ -= segment.live_bytes ();
+          segment.remove ();
+          delete *i;
+          continue;
+        }
+
+      *out++ = *i;
+
+      if (segment.live () == 0 || segment.min_time () >= purge_time)
+        continue;
+
+      for (ACE_UINT32 index = 0; index < segment.count (); ++index)
+        {
+          if (!segment.deleted (index) && segment.time (index) < purge_time)
+            {
+              this->erase (segment, index);
+              ++count;
+            }
+        }
+    }
+
+  this->segments_.erase (out, this->segments_.end ());
+  this->remove_empty_segments ();
+
+  return count;
+}
+
+CORBA::ULong
+TAO_Segment_LogRecordStore::remove_old_records (CORBA::ULong max_records,
+                                                bool &done)
+{
+  done = true;
+
+  if (this->max_record_life_ == 0 || this->segments_.empty ()) {
+    this->compaction_end_id_ = 0;
+    return 0;
+  }
+
+  TimeBase::TimeT purge_time (ORBSVCS_Time::to_Absolute_TimeT ((ACE_OS::gettimeofday () - ACE_Time_Value(this->max_record_life_))));
+
+  Position &position = this->compaction_position_;
+
+  if (this->compaction_end_id_ == 0)
+    {
+      // A pass looks at the records logged before it started, it
+      // would never end if it chased the records being logged.
+      this->compaction_end_id_ = this->maxid_;
+      position.segment_ = 0;
+      position.index_ = 0;
+    }
+
+  // A segment entirely too old goes at once, and makes the slice,
+  // the last one stays for its ids.
+  if (this->segments_.size () > 1
+      && this->segments_.front ()->max_time () < purge_time)
+    {
+      CORBA::ULong const count = this->segments_.front ()->live ();
+      this->remove_first_segment ();
+      done = false;
+      return count;
+    }
+
+  CORBA::ULong count = 0;
+  CORBA::ULong looked = 0;
+
+  Segment_List::iterator i =
+    std::lower_bound (this->segments_.begin (),
+                      this->segments_.end (),
+                      position.segment_,
+                      sequence_before);
+
+  // The segment the previous call stopped in may have been removed
+  // since.
+  if (i == this->segments_.end () || (*i)->sequence () != position.segment_)
+    position.index_ = 0;
+
+  bool finished = false;
+
+  for ( ; i != this->segments_.end () && !finished; ++i)
+    {
+      TAO_Log_Segment &segment = **i;
+
+      if (position.segment_ != segment.sequence ())
+        {
+          position.segment_ = segment.sequence ();
+          position.index_ = 0;
+        }
+
+      if (segment.min_id () > this->compaction_end_id_)
+        break;
+
+      if (looked == max_records)
+        {
+          done = false;
+          break;
+        }
+
+      // The header tells when none of the records is too old.
+      if (segment.live () == 0 || segment.min_time () >= purge_time)
+        {
+          position.index_ = segment.count ();
+          ++looked;
+          finished = segment.max_id () >= this->compaction_end_id_;
+          continue;
+        }
+
+      for ( ; position.index_ < segment.count (); ++position.index_, ++looked)
+        {
+          ACE_UINT32 const index = position.index_;
+          if (segment.id (index) > this->compaction_end_id_)
+            {
+              finished = true;
+              break;
+            }
+
+          if (looked == max_records)
+            {
+              done = false;
+              break;
+            }
+
+          if (!segment.deleted (index) && segment.time (index) < purge_time)
+            {
+              this->erase (segment, index);
+              ++count;
+            }
+        }
+
+      if (!done)
+        break;
+    }
+
+  if (done)
+    this->compaction_end_id_ = 0;
+
+  this->remove_empty_segments ();
+
+  return count;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
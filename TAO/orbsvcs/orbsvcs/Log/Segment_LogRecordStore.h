@@ -0,0 +1,308 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Segment_LogRecordStore.h
+ *
+ *  A LogRecordStore keeping the records in time-partitioned,
+ *  memory-mapped segments.
+ */
+//=============================================================================
+
+#ifndef TAO_SEGMENT_LOG_RECORD_STORE_H
+#define TAO_SEGMENT_LOG_RECORD_STORE_H
+
+#include /**/ "ace/pre.h"
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Log/Hash_LogRecordStore.h"
+#include "orbsvcs/Log/Log_Segment.h"
+#include "tao/ETCL/TAO_ETCL_Constraint.h"
+
+#include <memory>
+#include <vector>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Log_Constraint_Interpreter;
+
+/**
+ * @class TAO_Segment_LogRecordStore
+ *
+ * @brief A LogRecordStore writing the records to a sequence of
+ * TAO_Log_Segment files.
+ *
+ * A new segment is started once the current one is full, or once it
+ * spans more than the configured duration, so each segment covers a
+ * window of time.  retrieve() skips the segments outside of the
+ * window asked for, and binary searches the time column of the
+ * others.  query() and the other constraint based operations skip the
+ * segments, and then the records, that cannot satisfy the comparisons
+ * of "id" and "time" with a number found at the top level of the
+ * constraint, before decoding and evaluating the records left.
+ * remove_old_records() drops whole segments.
+ *
+ * The segments are kept in a directory, as "<log id>-<sequence>.seg"
+ * files.  open() picks up the segments left by a previous run, so a
+ * log created again with the same id finds its records.  The
+ * parameters of the log (the parameters of TAO_Hash_LogRecordStore)
+ * are not persistent.
+ */
+class TAO_Log_Serv_Export TAO_Segment_LogRecordStore
+  : public TAO_Hash_LogRecordStore
+{
+public:
+  /// Constructor.  A segment holds up to @a segment_capacity
+  /// records, logged within @a segment_duration seconds.
+  TAO_Segment_LogRecordStore (TAO_LogMgr_i* logmgr,
+                              DsLogAdmin::LogId id,
+                              DsLogAdmin::LogFullActionType log_full_action,
+                              CORBA::ULongLong max_size,
+                              const DsLogAdmin::CapacityAlarmThresholdList* thresholds,
+                              const ACE_CString &directory,
+                              ACE_UINT32 segment_capacity,
+                              ACE_UINT32 segment_duration);
+
+  /// Destructor.
+  virtual ~TAO_Segment_LogRecordStore ();
+
+  /// Map the segments of the log found in the directory.
+  virtual int open ();
+
+  /// Unmap the segments.
+  virtual int close ();
+
+  /// Remove the segment files, the log is being destroyed.
+  void remove_segments ();
+
+  // = Record logging, retrieval, update and removal methods.
+
+  virtual int log (const DsLogAdmin::LogRecord &rec);
+
+  virtual int purge_old_records ();
+
+  virtual void
+    set_record_attribute (DsLogAdmin::RecordId id,
+                          const DsLogAdmin::NVList & attr_list);
+
+  virtual CORBA::ULong
+    set_records_attribute (const char * grammar,
+                           const char * c,
+                           const DsLogAdmin::NVList & attr_list);
+
+  virtual DsLogAdmin::NVList*
+    get_record_attribute (DsLogAdmin::RecordId id);
+
+  virtual int flush ();
+
+  virtual DsLogAdmin::RecordList*
+    query (const char * grammar,
+           const char * c,
+           DsLogAdmin::Iterator_out i);
+
+  virtual DsLogAdmin::RecordList*
+    retrieve (DsLogAdmin::TimeT from_time,
+              CORBA::Long how_many,
+              DsLogAdmin::Iterator_out i);
+
+  virtual CORBA::ULong match (const char * grammar, const char * c);
+
+  virtual CORBA::ULong
+    delete_records (const char * grammar,
+                    const char * c);
+
+  virtual CORBA::ULong
+    delete_records_by_id (const DsLogAdmin::RecordIdList & ids);
+
+  virtual CORBA::ULong remove_old_records ();
+
+  /// Drops the segments entirely too old first, one per call, then
+  /// looks at the records of the others in id order, up to the last
+  /// record logged when the pass started.
+  virtual CORBA::ULong remove_old_records (CORBA::ULong max_records,
+                                           bool &done);
+
+  /**
+   * @class Filter
+   *
+   * @brief The records selected by a constraint or a time window.
+   *
+   * The comparisons of "id" and "time" are done on the values the
+   * constraint evaluator sees, which are truncated to 32 bits, so a
+   * segment is only skipped when its range of truncated values is
+   * ordered like its range of full values.  The time windows of
+   * retrieve() compare the full times.
+   */
+  class TAO_Log_Serv_Export Filter
+  {
+  public:
+    /// Select the records matching @a constraint.  Throws
+    /// DsLogAdmin::InvalidConstraint.
+    explicit Filter (const char *constraint);
+
+    /// Select the records logged at or after @a from_time, or before
+    /// it if @a before is set.
+    Filter (DsLogAdmin::TimeT from_time, bool before);
+
+    ~Filter ();
+
+    /// False if no record of @a segment can be selected.
+    bool covers (const TAO_Log_Segment &segment) const;
+
+    /// The range of indexes of @a segment holding the records that
+    /// can be selected.
+    void range (const TAO_Log_Segment &segment,
+                ACE_UINT32 &first,
+                ACE_UINT32 &last) const;
+
+    /// False if the record at @a index cannot be selected, judging
+    /// from the columns of @a segment.
+    bool accepts (const TAO_Log_Segment &segment, ACE_UINT32 index) const;
+
+    /// True if accepts() is not the final word, and the record has to
+    /// be evaluated.
+    bool evaluates () const;
+
+    /// True if the decoded record @a rec is selected.
+    bool evaluate (const DsLogAdmin::LogRecord &rec);
+
+  private:
+    Filter (const Filter &) = delete;
+    Filter &operator= (const Filter &) = delete;
+
+    /// A comparison of "id" or "time" with a number.
+    struct Bound
+    {
+      bool time_;
+      int op_;
+      TAO_ETCL_Literal_Constraint value_;
+    };
+
+    /// Collect the bounds in the conjuncts of @a node.
+    void collect (ETCL_Constraint *node);
+
+    /// Evaluate "<value> <op> <literal>" the way the constraint
+    /// evaluator would.
+    static bool compare (ACE_UINT64 value,
+                         int op,
+                         const TAO_ETCL_Literal_Constraint &literal);
+
+    std::unique_ptr<TAO_Log_Constraint_Interpreter> interpreter_;
+    std::vector<Bound> bounds_;
+
+    bool windowed_;
+    bool before_;
+    DsLogAdmin::TimeT from_time_;
+  };
+
+  /// Where a scan stopped: the sequence of a segment and an index in
+  /// it.
+  struct Position
+  {
+    ACE_UINT32 segment_;
+    ACE_UINT32 index_;
+    bool done_;
+  };
+
+  /**
+   * @class Action
+   *
+   * @brief Applied by scan() to the records selected.
+   */
+  class Action
+  {
+  public:
+    virtual ~Action ();
+
+    /// True if apply() needs the decoded record.
+    virtual bool needs_record () const = 0;
+
+    /// Apply to the record at @a index of @a segment, decoded in
+    /// @a rec if needs_record().  Returns false to stop the scan.
+    virtual bool apply (TAO_Log_Segment &segment,
+                        ACE_UINT32 index,
+                        DsLogAdmin::LogRecord &rec) = 0;
+  };
+
+  /**
+   * Copy up to @a how_many records selected by @a filter, from
+   * @a position on, into @a records, after skipping @a skip of them.
+   * @a skip is decreased by the number of records skipped, and
+   * @a position is advanced past the last record looked at.  Returns
+   * the number of records copied.
+   */
+  CORBA::ULong fetch (Filter &filter,
+                      Position &position,
+                      CORBA::ULong &skip,
+                      CORBA::ULong how_many,
+                      DsLogAdmin::RecordList &records);
+
+protected:
+  /// Apply @a action to the records selected by @a filter, in id
+  /// order, from @a position on.
+  void scan (Filter &filter, Position &position, Action &action);
+
+  /// Return the segment the record logged at @a time goes to,
+  /// starting a new one if needed.
+  TAO_Log_Segment *active_segment (DsLogAdmin::TimeT time);
+
+  /// Find the segment holding the record @a id.
+  TAO_Log_Segment *find_segment (DsLogAdmin::RecordId id,
+                                 ACE_UINT32 &index) const;
+
+  /// Replace the record at @a index of @a segment by @a rec.
+  /// Throws CORBA::PERSIST_STORE on failure.
+  void update (TAO_Log_Segment &segment,
+               ACE_UINT32 index,
+               const DsLogAdmin::LogRecord &rec);
+
+  /// Mark the record at @a index of @a segment deleted.
+  void erase (TAO_Log_Segment &segment, ACE_UINT32 index);
+
+  /// Remove the segments whose records are all deleted, except the
+  /// last one, which keeps the last id given.
+  void remove_empty_segments ();
+
+  /// Remove the first segment.
+  void remove_first_segment ();
+
+  /// Return the path of the segment @a sequence.
+  ACE_CString segment_path (ACE_UINT32 sequence) const;
+
+  /// Start the query of the records selected by @a filter, returning
+  /// the first @a how_many and an iterator on the others.
+  DsLogAdmin::RecordList*
+    query_i (Filter *filter,
+             DsLogAdmin::Iterator_out &iter_out,
+             CORBA::ULong how_many);
+
+  const ACE_CString directory_;
+  ACE_UINT32 const segment_capacity_;
+
+  /// The duration of a segment in TimeBase::TimeT units.
+  DsLogAdmin::TimeT const segment_duration_;
+
+  /// The segments, in sequence (so in id) order.
+  typedef std::vector<TAO_Log_Segment *> Segment_List;
+  Segment_List segments_;
+
+  ACE_UINT32 next_sequence_;
+
+  /// Where remove_old_records(max_records, done) stopped, and the
+  /// last record its pass looks at, 0 between passes.
+  Position compaction_position_;
+  DsLogAdmin::RecordId compaction_end_id_;
+
+  /// Set once the segments have been mapped, a log is opened again
+  /// each time its servant is incarnated.
+  bool opened_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_SEGMENT_LOG_RECORD_STORE_H */
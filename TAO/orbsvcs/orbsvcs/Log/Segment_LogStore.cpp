@@ -0,0 +1,68 @@
+#include "orbsvcs/Log/Segment_LogStore.h"
+#include "orbsvcs/Log/Segment_LogRecordStore.h"
+
+#include <memory>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Segment_LogStore::TAO_Segment_LogStore (TAO_LogMgr_i* logmgr_i,
+                                            const ACE_CString &directory,
+                                            ACE_UINT32 segment_capacity,
+                                            ACE_UINT32 segment_duration)
+  : TAO_Hash_LogStore (logmgr_i),
+    directory_ (directory),
+    segment_capacity_ (segment_capacity),
+    segment_duration_ (segment_duration)
+{
+}
+
+
+TAO_Segment_LogStore::~TAO_Segment_LogStore ()
+{
+}
+
+
+int
+TAO_Segment_LogStore::remove (DsLogAdmin::LogId id)
+{
+  TAO_Segment_LogRecordStore* recordstore =
+    dynamic_cast<TAO_Segment_LogRecordStore*> (this->get_log_record_store (id));
+
+  if (recordstore != 0)
+    {
+      recordstore->remove_segments ();
+    }
+
+  return TAO_Hash_LogStore::remove (id);
+}
+
+
+TAO_Hash_LogRecordStore*
+TAO_Segment_LogStore::create_log_record_store (
+  DsLogAdmin::LogId id,
+  DsLogAdmin::LogFullActionType full_action,
+  CORBA::ULongLong max_size,
+  const DsLogAdmin::CapacityAlarmThresholdList* thresholds)
+{
+  TAO_Segment_LogRecordStore* impl = 0;
+  ACE_NEW_THROW_EX (impl,
+                    TAO_Segment_LogRecordStore (this->logmgr_i_,
+                                                id,
+                                                full_action,
+                                                max_size,
+                                                thresholds,
+                                                this->directory_,
+                                                this->segment_capacity_,
+                                                this->segment_duration_),
+                    CORBA::NO_MEMORY ());
+
+  // Pick up the records left by a previous run now, the servant of
+  // the log is only incarnated on its first request.
+  std::unique_ptr<TAO_Segment_LogRecordStore> safe_impl (impl);
+  if (impl->open () != 0)
+    throw CORBA::PERSIST_STORE ();
+
+  return safe_impl.release ();
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,64 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Segment_LogStore.h
+ *
+ *  A LogStore whose logs keep their records in segment files.
+ */
+//=============================================================================
+
+#ifndef TAO_TLS_SEGMENT_LOGSTORE_H
+#define TAO_TLS_SEGMENT_LOGSTORE_H
+
+#include /**/ "ace/pre.h"
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Log/Hash_LogStore.h"
+#include "ace/SString.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Segment_LogStore
+ *
+ * @brief A TAO_Hash_LogStore creating TAO_Segment_LogRecordStores.
+ */
+class TAO_Log_Serv_Export TAO_Segment_LogStore
+  : public TAO_Hash_LogStore
+{
+public:
+  /// Constructor, the logs keep their segments in @a directory.
+  TAO_Segment_LogStore (TAO_LogMgr_i* mgr,
+                        const ACE_CString &directory,
+                        ACE_UINT32 segment_capacity,
+                        ACE_UINT32 segment_duration);
+
+  /// Destructor.
+  virtual ~TAO_Segment_LogStore ();
+
+  /// Remove the log @a id and its segment files.
+  virtual int remove (DsLogAdmin::LogId id);
+
+protected:
+  virtual TAO_Hash_LogRecordStore*
+    create_log_record_store (DsLogAdmin::LogId id,
+                             DsLogAdmin::LogFullActionType full_action,
+                             CORBA::ULongLong max_size,
+                             const DsLogAdmin::CapacityAlarmThresholdList* thresholds);
+
+private:
+  ACE_CString directory_;
+  ACE_UINT32 segment_capacity_;
+  ACE_UINT32 segment_duration_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_TLS_SEGMENT_LOGSTORE_H */
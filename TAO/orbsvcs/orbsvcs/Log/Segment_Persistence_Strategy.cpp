@@ -0,0 +1,78 @@
+#include "orbsvcs/Log_Macros.h"
+#include "orbsvcs/Log/Segment_Persistence_Strategy.h"
+#include "orbsvcs/Log/Segment_LogStore.h"
+#include "ace/Arg_Shifter.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_sys_stat.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Segment_Persistence_Strategy::TAO_Segment_Persistence_Strategy ()
+  : directory_ ("."),
+    segment_capacity_ (262144),
+    segment_duration_ (3600)
+{
+}
+
+
+TAO_Segment_Persistence_Strategy::~TAO_Segment_Persistence_Strategy ()
+{
+}
+
+int
+TAO_Segment_Persistence_Strategy::init (int argc, ACE_TCHAR* argv[])
+{
+  ACE_Arg_Shifter arg_shifter (argc, argv);
+
+  const ACE_TCHAR *current_arg = 0;
+
+  while (arg_shifter.is_anything_left ())
+    {
+      if (0 != (current_arg = arg_shifter.get_the_parameter (ACE_TEXT("-SegmentDirectory"))))
+        {
+          this->directory_ = ACE_TEXT_ALWAYS_CHAR (current_arg);
+          arg_shifter.consume_arg ();
+        }
+      else if (0 != (current_arg = arg_shifter.get_the_parameter (ACE_TEXT("-SegmentRecords"))))
+        {
+          this->segment_capacity_ = ACE_OS::atoi (current_arg);
+          arg_shifter.consume_arg ();
+        }
+      else if (0 != (current_arg = arg_shifter.get_the_parameter (ACE_TEXT("-SegmentSeconds"))))
+        {
+          this->segment_duration_ = ACE_OS::atoi (current_arg);
+          arg_shifter.consume_arg ();
+        }
+      else
+        {
+          ORBSVCS_ERROR ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) Ignoring unknown option <%s>\n"),
+                          arg_shifter.get_current ()));
+          arg_shifter.ignore_arg ();
+        }
+    }
+
+  if (this->segment_capacity_ == 0 || this->segment_duration_ == 0)
+    ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("(%P|%t) -SegmentRecords and ")
+                           ACE_TEXT ("-SegmentSeconds must not be 0\n")),
+                          -1);
+
+  // The directory may already exist.
+  ACE_OS::mkdir (ACE_TEXT_CHAR_TO_TCHAR (this->directory_.c_str ()));
+
+  return 0;
+}
+
+TAO_LogStore *
+TAO_Segment_Persistence_Strategy::create_log_store (TAO_LogMgr_i *logmgr_i)
+{
+  return new TAO_Segment_LogStore (logmgr_i,
+                                   this->directory_,
+                                   this->segment_capacity_,
+                                   this->segment_duration_);
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+ACE_FACTORY_DEFINE (TAO_Log_Serv, TAO_Segment_Persistence_Strategy)
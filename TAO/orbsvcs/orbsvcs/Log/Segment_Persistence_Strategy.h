@@ -0,0 +1,73 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Segment_Persistence_Strategy.h
+ *
+ *  Strategy storing the log records in memory-mapped segment files.
+ */
+//=============================================================================
+
+#ifndef TAO_TLS_SEGMENT_PERSISTENCE_STRATEGY_H
+#define TAO_TLS_SEGMENT_PERSISTENCE_STRATEGY_H
+
+#include /**/ "ace/pre.h"
+#include /**/ "ace/config-all.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "orbsvcs/Log/Log_Persistence_Strategy.h"
+#include "ace/SString.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Segment_Persistence_Strategy
+ *
+ * @brief Concrete Strategy for Log / Log Record Storage
+ *
+ * Stores the log records in time-partitioned segment files, see
+ * TAO_Segment_LogRecordStore.  It is loaded as the "Log_Persistence"
+ * service, for instance with:
+ *
+ * dynamic Log_Persistence Service_Object *
+ *   TAO_DsLogAdmin_Serv:_make_TAO_Segment_Persistence_Strategy ()
+ *   "-SegmentDirectory /var/log/tao -SegmentSeconds 600"
+ *
+ * The options are:
+ *   -SegmentDirectory <dir>  where the segment files go (".")
+ *   -SegmentRecords <n>      records per segment (262144)
+ *   -SegmentSeconds <n>      seconds covered by a segment (3600)
+ */
+class TAO_Log_Serv_Export TAO_Segment_Persistence_Strategy
+  : public TAO_Log_Persistence_Strategy
+{
+public:
+  /// Constructor.
+  TAO_Segment_Persistence_Strategy ();
+
+  /// Destructor.
+  virtual ~TAO_Segment_Persistence_Strategy ();
+
+  /// Parse the options.
+  virtual int init (int argc, ACE_TCHAR* argv[]);
+
+  /// @brief Log Store Factory
+  virtual TAO_LogStore*
+    create_log_store (TAO_LogMgr_i* mgr);
+
+private:
+  ACE_CString directory_;
+  ACE_UINT32 segment_capacity_;
+  ACE_UINT32 segment_duration_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+ACE_FACTORY_DECLARE (TAO_Log_Serv, TAO_Segment_Persistence_Strategy)
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_TLS_SEGMENT_PERSISTENCE_STRATEGY_H */
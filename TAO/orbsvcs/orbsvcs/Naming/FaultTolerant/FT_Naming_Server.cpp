@@ -35,7 +35,6 @@
 
 #include "tao/debug.h"
 #include "tao/default_ports.h"
-#include "tao/Storable_FlatFileStream.h"
 
 #include "tao/debug.h"
 #include "tao/default_ports.h"
@@ -204,18 +203,11 @@ TAO_FT_Naming_Server::init_with_orb (int argc,
                             -1);
         }
 
-      TAO::Storable_Factory * object_group_storable_factory;
-#if defined (ACE_USES_WCHAR)
-      ACE_CString alt_group_dir =
-        ACE_TEXT_ALWAYS_CHAR (this->object_group_dir_.c_str());
-      ACE_NEW_RETURN (object_group_storable_factory,
-                      TAO::Storable_FlatFileFactory (alt_group_dir),
-                      -1);
-#else
-      ACE_NEW_RETURN (object_group_storable_factory,
-                      TAO::Storable_FlatFileFactory (this->object_group_dir_),
-                      -1);
-#endif /* ACE_USES_WCHAR */
+      TAO::Storable_Factory * object_group_storable_factory =
+        this->storable_factory (
+          ACE_TEXT_ALWAYS_CHAR (this->object_group_dir_.c_str()));
+      if (object_group_storable_factory == 0)
+        return -1;
 
       naming_manager_.set_object_group_storable_factory (
         object_group_storable_factory);
@@ -421,7 +413,7 @@ int
 TAO_FT_Naming_Server::parse_args (int argc,
                                   ACE_TCHAR *argv[])
 {
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:c:do:p:s:f:m:z:r:u:v:g:h:l:"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:c:do:p:s:f:m:z:r:u:v:jg:h:l:"));
 
   // Define the arguments for primary and backup
   get_opts.long_option (ACE_TEXT ("primary"), ACE_Get_Opt::NO_ARG);
@@ -520,6 +512,9 @@ TAO_FT_Naming_Server::parse_args (int argc,
         this->object_group_dir_ = get_opts.opt_arg ();
         v_opt_used = 1;
         break;
+      case 'j':
+        this->use_journal_ = true;
+        break;
 
 #endif /* TAO_HAS_MINIMUM_POA == 0 */
 #endif /* !CORBA_E_MICRO */
@@ -585,6 +580,8 @@ TAO_FT_Naming_Server::parse_args (int argc,
                            ACE_TEXT ("-v <storable_object_group_persistence")
                            ACE_TEXT ("_directory>\n")
                            ACE_TEXT ("-r <redundant_persistence_directory>\n")
+                           ACE_TEXT ("-j (journal the -u, -r and -v")
+                           ACE_TEXT (" persistence files)\n")
                            ACE_TEXT ("-z <relative round trip timeout>\n")
                            ACE_TEXT ("\n"),
                            argv [0]),
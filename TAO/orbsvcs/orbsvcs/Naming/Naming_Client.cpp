@@ -1,6 +1,9 @@
 #include "orbsvcs/Naming/Naming_Client.h"
 #include "orbsvcs/CosNamingC.h"
 #include "orbsvcs/Log_Macros.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_sys_time.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -42,8 +45,11 @@ TAO_Naming_Client::init (CORBA::ORB_ptr orb, ACE_Time_Value *timeout)
 }
 
 TAO_Naming_Client::TAO_Naming_Client ()
+  : cache_enabled_ (false),
+    generation_ (0),
+    hits_ (0),
+    misses_ (0)
 {
-  // Do nothing
 }
 
 TAO_Naming_Client::~TAO_Naming_Client ()
@@ -51,4 +57,137 @@ TAO_Naming_Client::~TAO_Naming_Client ()
   // Do nothing
 }
 
+CORBA::Object_ptr
+TAO_Naming_Client::resolve (const CosNaming::Name &n)
+{
+  std::string key;
+  unsigned long generation = 0;
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::Object::_nil ());
+    if (this->cache_enabled_)
+      {
+        key = cache_key (n);
+        Cache::iterator i = this->cache_.find (key);
+        if (i != this->cache_.end ())
+          {
+            if (this->max_age_ == ACE_Time_Value::zero
+                || ACE_OS::gettimeofday () < i->second.expiry_)
+              {
+                ++this->hits_;
+                return CORBA::Object::_duplicate (i->second.object_.in ());
+              }
+            this->cache_.erase (i);
+          }
+        ++this->misses_;
+        generation = this->generation_;
+      }
+  }
+
+  CORBA::Object_var object = this->naming_context_->resolve (n);
+
+  if (!key.empty ())
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                        object._retn ());
+      // An invalidation that came in while the request was out may
+      // be about this binding.
+      if (this->cache_enabled_ && generation == this->generation_)
+        {
+          Cache_Entry &entry = this->cache_[key];
+          entry.name_ = n;
+          entry.object_ = CORBA::Object::_duplicate (object.in ());
+          if (this->max_age_ != ACE_Time_Value::zero)
+            entry.expiry_ = ACE_OS::gettimeofday () + this->max_age_;
+        }
+    }
+
+  return object._retn ();
+}
+
+void
+TAO_Naming_Client::enable_cache (const ACE_Time_Value &max_age)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->cache_enabled_ = true;
+  this->max_age_ = max_age;
+  this->hits_ = 0;
+  this->misses_ = 0;
+}
+
+void
+TAO_Naming_Client::disable_cache ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->cache_enabled_ = false;
+  this->cache_.clear ();
+  ++this->generation_;
+}
+
+void
+TAO_Naming_Client::invalidate (const CosNaming::Name &changed)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  ++this->generation_;
+
+  // The changes are rare next to the resolves, a scan of the cache
+  // is cheaper than an index kept up to date on every miss.
+  CORBA::ULong const changes = changed.length ();
+  for (Cache::iterator i = this->cache_.begin ();
+       i != this->cache_.end ();)
+    {
+      const CosNaming::Name &name = i->second.name_;
+      bool stale = false;
+      for (CORBA::ULong c = 0; c < changes && !stale; ++c)
+        for (CORBA::ULong j = 0; j < name.length () && !stale; ++j)
+          stale =
+            ACE_OS::strcmp (name[j].id.in (), changed[c].id.in ()) == 0
+            && ACE_OS::strcmp (name[j].kind.in (), changed[c].kind.in ()) == 0;
+
+      if (stale)
+        this->cache_.erase (i++);
+      else
+        ++i;
+    }
+}
+
+void
+TAO_Naming_Client::invalidate_all ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  ++this->generation_;
+  this->cache_.clear ();
+}
+
+void
+TAO_Naming_Client::cache_stats (unsigned long &hits,
+                                unsigned long &misses) const
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  hits = this->hits_;
+  misses = this->misses_;
+}
+
+std::string
+TAO_Naming_Client::cache_key (const CosNaming::Name &n)
+{
+  // Length prefixed, so that no two names have the same key.
+  std::string key;
+  char length[16];
+  for (CORBA::ULong i = 0; i < n.length (); ++i)
+    {
+      const char *id = n[i].id.in ();
+      const char *kind = n[i].kind.in ();
+      ACE_OS::snprintf (length, sizeof length, "%lu:",
+                        static_cast<unsigned long> (ACE_OS::strlen (id)));
+      key += length;
+      key += id;
+      ACE_OS::snprintf (length, sizeof length, "%lu:",
+                        static_cast<unsigned long> (ACE_OS::strlen (kind)));
+      key += length;
+      key += kind;
+    }
+  return key;
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
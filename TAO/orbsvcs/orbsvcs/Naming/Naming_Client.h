@@ -20,6 +20,10 @@
 #include "tao/ORB.h"
 #include "orbsvcs/CosNamingC.h"
 #include "orbsvcs/Naming/naming_export.h"
+#include "ace/Time_Value.h"
+
+#include <map>
+#include <string>
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -34,6 +38,11 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
  * <resolve>, etc. can be directly called on a
  * <TAO_Naming_Client> object, and will be forwarded to the root
  * Naming Context.
+ *
+ * The names resolved with resolve() can be cached, see
+ * enable_cache().  The cached names are forgotten once they are too
+ * old, or when the server pushes a change of their bindings to a
+ * TAO_Naming_Client_Observer.
  */
 class TAO_Naming_Export TAO_Naming_Client
 {
@@ -61,9 +70,61 @@ public:
    */
   CosNaming::NamingContext_ptr get_context () const;
 
+  /// Resolve @a n in the root Naming Context, from the cache if it
+  /// is enabled.
+  CORBA::Object_ptr resolve (const CosNaming::Name &n);
+
+  /**
+   * Keep the objects resolved with resolve() for at most @a max_age
+   * (forever if it is zero).  Without a TAO_Naming_Client_Observer,
+   * or when the server does not push the changes of its bindings,
+   * @a max_age bounds how long a stale binding can be returned.
+   */
+  void enable_cache (const ACE_Time_Value &max_age);
+
+  /// Stop caching, and forget the cached names.
+  void disable_cache ();
+
+  /// Forget the cached names with one of the components of
+  /// @a changed.
+  void invalidate (const CosNaming::Name &changed);
+
+  /// Forget all the cached names.
+  void invalidate_all ();
+
+  /// The number of resolve() calls answered from the cache and sent
+  /// to the server since the cache was enabled.
+  void cache_stats (unsigned long &hits, unsigned long &misses) const;
+
 protected:
   /// Reference to the root Naming Context.
   CosNaming::NamingContext_var naming_context_;
+
+private:
+  struct Cache_Entry
+  {
+    CosNaming::Name name_;
+    CORBA::Object_var object_;
+    ACE_Time_Value expiry_;
+  };
+
+  /// The cache key of @a n.
+  static std::string cache_key (const CosNaming::Name &n);
+
+  typedef std::map<std::string, Cache_Entry> Cache;
+  Cache cache_;
+  bool cache_enabled_;
+  ACE_Time_Value max_age_;
+
+  /// Bumped by every invalidation, a resolve() is only cached if no
+  /// invalidation happened while it was sent to the server.
+  unsigned long generation_;
+
+  unsigned long hits_;
+  unsigned long misses_;
+
+  /// Protect the cache.
+  mutable TAO_SYNCH_MUTEX lock_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,107 @@
+#include "orbsvcs/Naming/Naming_Client_Observer.h"
+#include "orbsvcs/Naming/Naming_Client.h"
+#include "orbsvcs/Log_Macros.h"
+#include "tao/debug.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Naming_Client_Observer::TAO_Naming_Client_Observer (
+  TAO_Naming_Client &client)
+  : client_ (client),
+    id_ (0)
+{
+}
+
+TAO_Naming_Client_Observer::~TAO_Naming_Client_Observer ()
+{
+}
+
+int
+TAO_Naming_Client_Observer::subscribe (PortableServer::POA_ptr poa)
+{
+  try
+    {
+      CosNaming::NamingContext_var root = this->client_.get_context ();
+      if (CORBA::is_nil (root.in ()))
+        return -1;
+
+#if (TAO_HAS_MINIMUM_CORBA == 0) && !defined (CORBA_E_COMPACT) && !defined (CORBA_E_MICRO)
+      CORBA::Object_var component = root->_get_component ();
+      this->registry_ =
+        NamingObserver::Registry::_narrow (component.in ());
+#endif /* TAO_HAS_MINIMUM_CORBA == 0 && !CORBA_E_COMPACT && !CORBA_E_MICRO */
+      if (CORBA::is_nil (this->registry_.in ()))
+        {
+          if (TAO_debug_level > 0)
+            ORBSVCS_DEBUG ((LM_DEBUG,
+                            ACE_TEXT ("TAO (%P|%t) - TAO_Naming_Client_Observer::")
+                            ACE_TEXT ("subscribe, the Naming Service does not ")
+                            ACE_TEXT ("push the changes of its bindings\n")));
+          return -1;
+        }
+
+      this->poa_ = PortableServer::POA::_duplicate (poa);
+      PortableServer::ObjectId_var oid = poa->activate_object (this);
+      CORBA::Object_var object = poa->id_to_reference (oid.in ());
+      NamingObserver::BindingObserver_var observer =
+        NamingObserver::BindingObserver::_narrow (object.in ());
+
+      this->id_ = this->registry_->subscribe (observer.in ());
+
+      // Whatever was resolved before now may have changed unseen.
+      this->client_.invalidate_all ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      if (TAO_debug_level > 0)
+        ex._tao_print_exception ("TAO_Naming_Client_Observer::subscribe");
+      this->registry_ = NamingObserver::Registry::_nil ();
+      return -1;
+    }
+
+  return 0;
+}
+
+void
+TAO_Naming_Client_Observer::unsubscribe ()
+{
+  try
+    {
+      if (!CORBA::is_nil (this->registry_.in ()))
+        this->registry_->unsubscribe (this->id_);
+    }
+  catch (const CORBA::Exception&)
+    {
+      // The server may be gone, or may have dropped us already.
+    }
+  this->registry_ = NamingObserver::Registry::_nil ();
+
+  try
+    {
+      if (!CORBA::is_nil (this->poa_.in ()))
+        {
+          PortableServer::ObjectId_var oid =
+            this->poa_->servant_to_id (this);
+          this->poa_->deactivate_object (oid.in ());
+        }
+    }
+  catch (const CORBA::Exception&)
+    {
+      // Ignore, the POA may be gone already.
+    }
+  this->poa_ = PortableServer::POA::_nil ();
+}
+
+void
+TAO_Naming_Client_Observer::bindings_changed (const CosNaming::Name &changed)
+{
+  this->client_.invalidate (changed);
+}
+
+PortableServer::POA_ptr
+TAO_Naming_Client_Observer::_default_POA ()
+{
+  return PortableServer::POA::_duplicate (this->poa_.in ());
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,81 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Naming_Client_Observer.h
+ *
+ *  Keeps the cache of a TAO_Naming_Client up to date with the
+ *  bindings of the server.
+ */
+//=============================================================================
+
+#ifndef TAO_NAMING_CLIENT_OBSERVER_H
+#define TAO_NAMING_CLIENT_OBSERVER_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/NamingObserverS.h"
+#include "orbsvcs/Naming/naming_skel_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+class TAO_Naming_Client;
+
+/**
+ * @class TAO_Naming_Client_Observer
+ *
+ * @brief Forgets the names cached by a TAO_Naming_Client when the
+ * server pushes a change of their bindings.
+ *
+ * The observer lives in the client, in a POA of the client's choice:
+ * @code
+ *   TAO_Naming_Client naming_client;
+ *   naming_client.init (orb);
+ *   naming_client.enable_cache (ACE_Time_Value (60));
+ *
+ *   PortableServer::Servant_var<TAO_Naming_Client_Observer> observer =
+ *     new TAO_Naming_Client_Observer (naming_client);
+ *   observer->subscribe (root_poa.in ());
+ * @endcode
+ * The POA manager has to be active for the changes to come in.
+ */
+class TAO_Naming_Skel_Export TAO_Naming_Client_Observer
+  : public virtual POA_NamingObserver::BindingObserver
+{
+public:
+  explicit TAO_Naming_Client_Observer (TAO_Naming_Client &client);
+
+  virtual ~TAO_Naming_Client_Observer ();
+
+  /**
+   * Activate the observer in @a poa and subscribe it to the server of
+   * the root context of the client.  Returns 0 on success, and -1 if
+   * the server does not push the changes of its bindings, in which
+   * case the cache of the client only relies on its maximum age.
+   */
+  int subscribe (PortableServer::POA_ptr poa);
+
+  /// Unsubscribe from the server and deactivate the observer.
+  void unsubscribe ();
+
+  virtual void bindings_changed (const CosNaming::Name &changed);
+
+  virtual PortableServer::POA_ptr _default_POA ();
+
+private:
+  TAO_Naming_Client &client_;
+
+  PortableServer::POA_var poa_;
+  NamingObserver::Registry_var registry_;
+  NamingObserver::ObserverId id_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_NAMING_CLIENT_OBSERVER_H */
@@ -7,6 +7,7 @@
 //=============================================================================
 
 #include "orbsvcs/Naming/Naming_Context_Interface.h"
+#include "orbsvcs/Naming/Naming_Observer_Registry.h"
 #include "ace/ACE.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_ctype.h"
@@ -33,12 +34,14 @@ void
 TAO_Naming_Context::bind (const CosNaming::Name &n, CORBA::Object_ptr obj)
 {
   impl_->bind (n, obj);
+  this->binding_changed (n);
 }
 
 void
 TAO_Naming_Context::rebind (const CosNaming::Name &n, CORBA::Object_ptr obj)
 {
   impl_->rebind (n, obj);
+  this->binding_changed (n);
 }
 
 void
@@ -46,6 +49,7 @@ TAO_Naming_Context::bind_context (const CosNaming::Name &n,
                                   CosNaming::NamingContext_ptr nc)
 {
   impl_->bind_context (n, nc);
+  this->binding_changed (n);
 }
 
 void
@@ -53,6 +57,7 @@ TAO_Naming_Context::rebind_context (const CosNaming::Name &n,
                                     CosNaming::NamingContext_ptr nc)
 {
   impl_->rebind_context (n, nc);
+  this->binding_changed (n);
 }
 
 CORBA::Object_ptr
@@ -65,6 +70,7 @@ void
 TAO_Naming_Context::unbind (const CosNaming::Name &n)
 {
   impl_->unbind (n);
+  this->binding_changed (n);
 }
 
 CosNaming::NamingContext_ptr
@@ -76,7 +82,9 @@ TAO_Naming_Context::new_context ()
 CosNaming::NamingContext_ptr
 TAO_Naming_Context::bind_new_context (const CosNaming::Name &n)
 {
-  return impl_->bind_new_context (n);
+  CosNaming::NamingContext_var context = impl_->bind_new_context (n);
+  this->binding_changed (n);
+  return context._retn ();
 }
 
 void
@@ -85,6 +93,28 @@ TAO_Naming_Context::destroy ()
   impl_->destroy ();
 }
 
+#if (TAO_HAS_MINIMUM_CORBA == 0) && !defined (CORBA_E_COMPACT) && !defined (CORBA_E_MICRO)
+CORBA::Object_ptr
+TAO_Naming_Context::_get_component ()
+{
+  TAO_Naming_Observer_Registry *registry =
+    TAO_Naming_Observer_Registry::instance ();
+  if (registry == 0)
+    return CORBA::Object::_nil ();
+
+  return registry->reference ();
+}
+#endif /* TAO_HAS_MINIMUM_CORBA == 0 && !CORBA_E_COMPACT && !CORBA_E_MICRO */
+
+void
+TAO_Naming_Context::binding_changed (const CosNaming::Name &n)
+{
+  TAO_Naming_Observer_Registry *registry =
+    TAO_Naming_Observer_Registry::instance ();
+  if (registry != 0)
+    registry->binding_changed (n);
+}
+
 void
 TAO_Naming_Context::list (CORBA::ULong how_many,
                           CosNaming::BindingList_out bl,
@@ -182,7 +182,17 @@ public:
   /// Returns the Default POA of this Servant object
   virtual PortableServer::POA_ptr _default_POA ();
 
+#if (TAO_HAS_MINIMUM_CORBA == 0) && !defined (CORBA_E_COMPACT) && !defined (CORBA_E_MICRO)
+  /// Returns the NamingObserver::Registry of the server, nil if the
+  /// server does not push the changes of its bindings.
+  virtual CORBA::Object_ptr _get_component ();
+#endif /* TAO_HAS_MINIMUM_CORBA == 0 && !CORBA_E_COMPACT && !CORBA_E_MICRO */
+
 private:
+  /// Report a successful change of the binding of @a n to the
+  /// observers of the server.
+  void binding_changed (const CosNaming::Name &n);
+
   enum Hint
     {
       HINT_ID,
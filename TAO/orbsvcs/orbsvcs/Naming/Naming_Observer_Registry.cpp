@@ -0,0 +1,174 @@
+#include "orbsvcs/Naming/Naming_Observer_Registry.h"
+#include "orbsvcs/Log_Macros.h"
+#include "tao/debug.h"
+
+#include <vector>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Naming_Observer_Registry *TAO_Naming_Observer_Registry::instance_ = 0;
+
+TAO_Naming_Observer_Registry::TAO_Naming_Observer_Registry ()
+  : next_id_ (0)
+{
+}
+
+TAO_Naming_Observer_Registry::~TAO_Naming_Observer_Registry ()
+{
+}
+
+NamingObserver::ObserverId
+TAO_Naming_Observer_Registry::subscribe (
+  NamingObserver::BindingObserver_ptr observer)
+{
+  if (CORBA::is_nil (observer))
+    throw CORBA::BAD_PARAM ();
+
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::INTERNAL ());
+
+  NamingObserver::ObserverId const id = ++this->next_id_;
+  this->observers_[id] =
+    NamingObserver::BindingObserver::_duplicate (observer);
+  return id;
+}
+
+void
+TAO_Naming_Observer_Registry::unsubscribe (NamingObserver::ObserverId id)
+{
+  ACE_GUARD_THROW_EX (TAO_SYNCH_MUTEX, ace_mon, this->lock_,
+                      CORBA::INTERNAL ());
+
+  if (this->observers_.erase (id) == 0)
+    throw NamingObserver::UnknownObserver ();
+}
+
+void
+TAO_Naming_Observer_Registry::binding_changed (const CosNaming::Name &n)
+{
+  CORBA::ULong const length = n.length ();
+  if (length == 0)
+    return;
+
+  typedef std::vector<std::pair<NamingObserver::ObserverId,
+                                NamingObserver::BindingObserver_var> >
+    Observers;
+  Observers observers;
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+    if (this->observers_.empty ())
+      return;
+
+    observers.reserve (this->observers_.size ());
+    for (Observer_Map::const_iterator i = this->observers_.begin ();
+         i != this->observers_.end ();
+         ++i)
+      observers.push_back (
+        std::make_pair (i->first,
+                        NamingObserver::BindingObserver::_duplicate (
+                          i->second.in ())));
+  }
+
+  CosNaming::Name changed (1);
+  changed.length (1);
+  changed[0] = n[length - 1];
+
+  // Push without the lock, the observers may be slow to take the
+  // request.
+  std::vector<NamingObserver::ObserverId> failed;
+  for (Observers::iterator i = observers.begin ();
+       i != observers.end ();
+       ++i)
+    {
+      try
+        {
+          i->second->bindings_changed (changed);
+        }
+      catch (const CORBA::Exception& ex)
+        {
+          if (TAO_debug_level > 0)
+            ex._tao_print_exception (
+              "TAO_Naming_Observer_Registry::binding_changed");
+          failed.push_back (i->first);
+        }
+    }
+
+  if (!failed.empty ())
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+      for (size_t i = 0; i < failed.size (); ++i)
+        this->observers_.erase (failed[i]);
+    }
+}
+
+void
+TAO_Naming_Observer_Registry::activate (PortableServer::POA_ptr poa)
+{
+  this->poa_ = PortableServer::POA::_duplicate (poa);
+
+  PortableServer::ObjectId_var id;
+  try
+    {
+      // A stable object key, for a persistent POA.
+      id = PortableServer::string_to_ObjectId ("NameServiceObservers");
+      poa->activate_object_with_id (id.in (), this);
+    }
+  catch (const PortableServer::POA::WrongPolicy&)
+    {
+      id = poa->activate_object (this);
+    }
+
+  this->reference_ = poa->id_to_reference (id.in ());
+}
+
+void
+TAO_Naming_Observer_Registry::deactivate ()
+{
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+    this->observers_.clear ();
+  }
+
+  if (CORBA::is_nil (this->poa_.in ()))
+    return;
+
+  try
+    {
+      PortableServer::ObjectId_var id =
+        this->poa_->servant_to_id (this);
+      this->poa_->deactivate_object (id.in ());
+    }
+  catch (const CORBA::Exception&)
+    {
+      // Ignore, the POA may be gone already.
+    }
+
+  this->poa_ = PortableServer::POA::_nil ();
+  this->reference_ = CORBA::Object::_nil ();
+}
+
+CORBA::Object_ptr
+TAO_Naming_Observer_Registry::reference ()
+{
+  return CORBA::Object::_duplicate (this->reference_.in ());
+}
+
+PortableServer::POA_ptr
+TAO_Naming_Observer_Registry::_default_POA ()
+{
+  return PortableServer::POA::_duplicate (this->poa_.in ());
+}
+
+TAO_Naming_Observer_Registry *
+TAO_Naming_Observer_Registry::instance ()
+{
+  return instance_;
+}
+
+void
+TAO_Naming_Observer_Registry::instance (TAO_Naming_Observer_Registry *registry)
+{
+  instance_ = registry;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
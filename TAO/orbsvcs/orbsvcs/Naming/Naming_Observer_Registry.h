@@ -0,0 +1,96 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file   Naming_Observer_Registry.h
+ *
+ *  The observers of the bindings of a Naming Service.
+ */
+//=============================================================================
+
+#ifndef TAO_NAMING_OBSERVER_REGISTRY_H
+#define TAO_NAMING_OBSERVER_REGISTRY_H
+
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/NamingObserverS.h"
+#include "orbsvcs/Naming/naming_serv_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/orbconf.h"
+
+#include <map>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_Naming_Observer_Registry
+ *
+ * @brief Pushes the changes of the bindings of the naming contexts of
+ * this process to the observers that subscribed.
+ *
+ * The naming contexts return the registry set with instance() from
+ * _get_component(), and report their successful binds, rebinds and
+ * unbinds to it.  Only the last component of a name is pushed, the
+ * observers are expected to forget every name with that component.
+ *
+ * The pushes are oneways, made before the reply to the request that
+ * changed the binding, so a client that resolves a name after the
+ * change has been made has been told about it, unless the oneway is
+ * lost on the way.  Observers whose push fails are dropped.
+ */
+class TAO_Naming_Serv_Export TAO_Naming_Observer_Registry
+  : public virtual POA_NamingObserver::Registry
+{
+public:
+  TAO_Naming_Observer_Registry ();
+
+  virtual ~TAO_Naming_Observer_Registry ();
+
+  virtual NamingObserver::ObserverId
+    subscribe (NamingObserver::BindingObserver_ptr observer);
+
+  virtual void unsubscribe (NamingObserver::ObserverId id);
+
+  /// Tell the observers that the binding of @a n changed.
+  void binding_changed (const CosNaming::Name &n);
+
+  /// Activate the registry in @a poa.
+  void activate (PortableServer::POA_ptr poa);
+
+  /// Deactivate the registry and drop the observers.
+  void deactivate ();
+
+  /// The reference to the registry, nil until activate() is called.
+  CORBA::Object_ptr reference ();
+
+  virtual PortableServer::POA_ptr _default_POA ();
+
+  /// The registry the naming contexts of this process report to, 0
+  /// if there is none.
+  static TAO_Naming_Observer_Registry *instance ();
+  static void instance (TAO_Naming_Observer_Registry *registry);
+
+private:
+  typedef std::map<NamingObserver::ObserverId,
+                   NamingObserver::BindingObserver_var> Observer_Map;
+  Observer_Map observers_;
+  NamingObserver::ObserverId next_id_;
+
+  PortableServer::POA_var poa_;
+  CORBA::Object_var reference_;
+
+  /// Protect <observers_> and <next_id_>.
+  TAO_SYNCH_MUTEX lock_;
+
+  static TAO_Naming_Observer_Registry *instance_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_NAMING_OBSERVER_REGISTRY_H */
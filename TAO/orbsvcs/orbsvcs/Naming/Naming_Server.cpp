@@ -16,8 +16,10 @@
 #include "orbsvcs/Naming/Persistent_Context_Index.h"
 #include "orbsvcs/Naming/Storable_Naming_Context.h"
 #include "orbsvcs/Naming/Storable_Naming_Context_Activator.h"
+#include "orbsvcs/Naming/Naming_Observer_Registry.h"
 
 #include "tao/Storable_FlatFileStream.h"
+#include "tao/Storable_JournalStream.h"
 
 #endif /* CORBA_E_MICRO */
 
@@ -50,12 +52,14 @@ TAO_Naming_Server::TAO_Naming_Server (size_t bsize)
     persistence_dir_ (0),
     base_address_ (TAO_NAMING_BASE_ADDR),
     use_storable_context_ (0),
+    use_journal_ (false),
     use_servant_activator_ (false),
     servant_activator_ (0),
 #endif /* CORBA_E_MICRO */
     use_redundancy_(0),
     round_trip_timeout_ (0),
-    use_round_trip_timeout_ (0)
+    use_round_trip_timeout_ (0),
+    observer_registry_ (0)
 {
   ACE_NEW (iors_, IOR_Bundle[bsize]);
 }
@@ -83,12 +87,14 @@ TAO_Naming_Server::TAO_Naming_Server (CORBA::ORB_ptr orb,
     persistence_dir_ (0),
     base_address_ (TAO_NAMING_BASE_ADDR),
     use_storable_context_ (use_storable_context),
+    use_journal_ (false),
     use_servant_activator_ (false),
     servant_activator_ (0),
 #endif /* CORBA_E_MICRO */
     use_redundancy_(0),
     round_trip_timeout_ (0),
-    use_round_trip_timeout_ (0)
+    use_round_trip_timeout_ (0),
+    observer_registry_ (0)
 {
   ACE_NEW (iors_, IOR_Bundle[bsize]);
   if (this->init (orb,
@@ -129,6 +135,15 @@ TAO_Naming_Server::init (CORBA::ORB_ptr orb,
       this->iors_[i].ref_ = CORBA::Object::_nil();
     }
 
+  if (this->observer_registry_ != 0)
+    {
+      if (TAO_Naming_Observer_Registry::instance () == this->observer_registry_)
+        TAO_Naming_Observer_Registry::instance (0);
+      this->observer_registry_->deactivate ();
+      this->observer_registry_->_remove_ref ();
+      this->observer_registry_ = 0;
+    }
+
   if (resolve_for_existing_naming_service)
     {
       try
@@ -177,7 +192,7 @@ TAO_Naming_Server::parse_args (int argc,
                                ACE_TCHAR *argv[])
 {
 #if (TAO_HAS_MINIMUM_POA == 0) && !defined (CORBA_E_COMPACT)
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:do:p:s:f:m:u:r:z:"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:do:p:s:f:m:u:r:jz:"));
 #else
   ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("b:do:p:s:f:m:z:"));
 #endif /* TAO_HAS_MINIMUM_POA */
@@ -253,6 +268,9 @@ TAO_Naming_Server::parse_args (int argc,
         this->persistence_dir_ = get_opts.opt_arg ();
         u_opt_used = 1;
         break;
+      case 'j':
+        this->use_journal_ = true;
+        break;
 #endif /* TAO_HAS_MINIMUM_POA == 0 */
 #endif /* !CORBA_E_MICRO */
       case 'z':
@@ -269,7 +287,8 @@ TAO_Naming_Server::parse_args (int argc,
 #endif /* CORBA_E_MICRO */
 #if (TAO_HAS_MINIMUM_POA == 0) && !defined (CORBA_E_MICRO)
           ACE_TEXT ("-u <storable_persistence_directory (not used with -f)> ")
-          ACE_TEXT ("-r <redundant_persistence_directory> ");
+          ACE_TEXT ("-r <redundant_persistence_directory> ")
+          ACE_TEXT ("-j (journal the -u or -r persistence files) ");
 #else
           ACE_TEXT ("");
 #endif /* TAO_HAS_MINIMUM_POA && !CORBA_E_MICRO */
@@ -471,6 +490,16 @@ TAO_Naming_Server::init_new_naming (CORBA::ORB_ptr orb,
           this->orb_ = CORBA::ORB::_duplicate (orb);
         }
 
+      // The contexts hand out the registry from _get_component().
+      if (this->observer_registry_ == 0)
+        {
+          ACE_NEW_THROW_EX (this->observer_registry_,
+                            TAO_Naming_Observer_Registry,
+                            CORBA::NO_MEMORY ());
+          this->observer_registry_->activate (poa);
+          TAO_Naming_Observer_Registry::instance (this->observer_registry_);
+        }
+
 #if defined (CORBA_E_MICRO)
       ACE_UNUSED_ARG (persistence_location);
       ACE_UNUSED_ARG (base_addr);
@@ -483,7 +512,8 @@ TAO_Naming_Server::init_new_naming (CORBA::ORB_ptr orb,
           // command line for now.
           TAO::Storable_Factory* pf = 0;
           ACE_CString directory (ACE_TEXT_ALWAYS_CHAR (persistence_location));
-          ACE_NEW_RETURN (pf, TAO::Storable_FlatFileFactory (directory), -1);
+          pf = this->storable_factory (directory);
+          if (pf == 0) return -1;
           std::unique_ptr<TAO::Storable_Factory> persFactory(pf);
 
           // Use an auto_ptr to ensure that we clean up the factory in the case
@@ -762,6 +792,16 @@ TAO_Naming_Server::persistent_naming_context_factory ()
   return new (std::nothrow) TAO_Persistent_Naming_Context_Factory;
 }
 
+TAO::Storable_Factory *
+TAO_Naming_Server::storable_factory (const ACE_CString &directory)
+{
+#if !defined (CORBA_E_MICRO)
+  if (this->use_journal_)
+    return new (std::nothrow) TAO::Storable_JournalFactory (directory);
+#endif /* !CORBA_E_MICRO */
+  return new (std::nothrow) TAO::Storable_FlatFileFactory (directory);
+}
+
 int
 TAO_Naming_Server::fini ()
 {
@@ -779,6 +819,15 @@ TAO_Naming_Server::fini ()
       this->iors_[i].ref_ = CORBA::Object::_nil();
     }
 
+  if (this->observer_registry_ != 0)
+    {
+      if (TAO_Naming_Observer_Registry::instance () == this->observer_registry_)
+        TAO_Naming_Observer_Registry::instance (0);
+      this->observer_registry_->deactivate ();
+      this->observer_registry_->_remove_ref ();
+      this->observer_registry_ = 0;
+    }
+
   // Destroy the child POA ns_poa that is created when initializing
   // the Naming Service
   try
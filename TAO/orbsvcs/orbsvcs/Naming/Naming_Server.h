@@ -33,6 +33,12 @@ class TAO_Storable_Naming_Context_Activator;
 
 class TAO_Storable_Naming_Context_Factory;
 class TAO_Persistent_Naming_Context_Factory;
+class TAO_Naming_Observer_Registry;
+
+namespace TAO
+{
+  class Storable_Factory;
+}
 
 /**
  * @class TAO_Naming_Server
@@ -190,6 +196,12 @@ protected:
   virtual TAO_Persistent_Naming_Context_Factory *
     persistent_naming_context_factory ();
 
+  /* Factory method to create the factory of the files used with the
+   * -u and -r options, in @a directory.
+   */
+  virtual TAO::Storable_Factory *
+    storable_factory (const ACE_CString &directory);
+
   /// The ior_multicast event handler.
   TAO_IOR_Multicast *ior_multicast_;
 
@@ -243,6 +255,10 @@ protected:
   /// If not zero use flat file persistence
   int use_storable_context_;
 
+  /// If set the storable persistence files are journals, see
+  /// TAO::Storable_JournalFactory.
+  bool use_journal_;
+
   /**
    * If not zero use servant activator that uses flat file persistence.
    */
@@ -263,6 +279,10 @@ protected:
   /// If not zero use round trip timeout policy set to value specified
   int round_trip_timeout_;
   int use_round_trip_timeout_;
+
+  /// Pushes the changes of the bindings to the clients that cache
+  /// the names they resolve.
+  TAO_Naming_Observer_Registry *observer_registry_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -2,6 +2,7 @@
 #include "orbsvcs/PortableGroup/UIPMC_Mcast_Transport.h"
 #include "orbsvcs/PortableGroup/miopconf.h"
 #include "orbsvcs/PortableGroup/UIPMC_Transport_Recv_Packet.h"
+#include "orbsvcs/PortableGroup/UIPMC_Recv_Batch.h"
 #include "orbsvcs/PortableGroup/UIPMC_Mcast_Connection_Handler.h"
 #include "orbsvcs/PortableGroup/UIPMC_Wait_Never.h"
 #include "orbsvcs/PortableGroup/Fragments_Cleanup_Strategy.h"
@@ -21,6 +22,10 @@ TAO_UIPMC_Mcast_Transport::TAO_UIPMC_Mcast_Transport (
   : TAO_Transport (IOP::TAG_UIPMC,
                    orb_core)
   , connection_handler_ (handler)
+  , last_hash_ (0)
+  , last_packet_ (0)
+  , recv_batch_ (0)
+  , packet_pool_count_ (0)
 {
   // Replace the default wait strategy with our own
   // since we don't support waiting on anything.
@@ -45,6 +50,11 @@ TAO_UIPMC_Mcast_Transport::~TAO_UIPMC_Mcast_Transport ()
           delete packet;
         }
     }
+
+  for (int i = 0; i < this->packet_pool_count_; ++i)
+    delete this->packet_pool_[i];
+
+  delete this->recv_batch_;
 }
 
 void
@@ -61,6 +71,9 @@ TAO_UIPMC_Mcast_Transport::cleanup_packets (bool expired_only)
         factory->fragments_cleanup_strategy ();
 
       cleanup_strategy->cleanup (this->incomplete_);
+
+      // The strategy may have removed the packet last added to.
+      this->last_packet_ = 0;
     }
   else
     {
@@ -84,7 +97,81 @@ TAO_UIPMC_Mcast_Transport::cleanup_packets (bool expired_only)
           std::unique_ptr<TAO_PG::UIPMC_Recv_Packet> guard ((*cur_iter).item ());
           this->incomplete_.unbind (cur_iter);
         }
+
+      this->last_packet_ = 0;
+    }
+}
+
+TAO_PG::UIPMC_Recv_Packet *
+TAO_UIPMC_Mcast_Transport::acquire_packet ()
+{
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->packet_pool_lock_, 0);
+
+    if (this->packet_pool_count_ > 0)
+      {
+        TAO_PG::UIPMC_Recv_Packet *packet =
+          this->packet_pool_[--this->packet_pool_count_];
+        packet->reset ();
+        return packet;
+      }
+  }
+
+  TAO_PG::UIPMC_Recv_Packet *packet = 0;
+  ACE_NEW_THROW_EX (packet,
+                    TAO_PG::UIPMC_Recv_Packet,
+                    CORBA::NO_MEMORY (
+                      CORBA::SystemException::_tao_minor_code (
+                        TAO::VMCID,
+                        ENOMEM),
+                      CORBA::COMPLETED_NO));
+  return packet;
+}
+
+void
+TAO_UIPMC_Mcast_Transport::release_packet (TAO_PG::UIPMC_Recv_Packet *packet)
+{
+  // Don't hold on to the storage of unusually large messages.
+  if (packet->capacity () <= 16 * MIOP_MAX_DGRAM_SIZE)
+    {
+      ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->packet_pool_lock_);
+
+      if (this->packet_pool_count_ < PACKET_POOL_SIZE)
+        {
+          this->packet_pool_[this->packet_pool_count_++] = packet;
+          return;
+        }
+    }
+
+  delete packet;
+}
+
+TAO_PG::UIPMC_Recv_Packet *
+TAO_UIPMC_Mcast_Transport::find_packet (u_long id_hash)
+{
+  if (this->last_packet_ != 0 && this->last_hash_ == id_hash)
+    return this->last_packet_;
+
+  TAO_PG::UIPMC_Recv_Packet *packet = 0;
+  if (this->incomplete_.find (id_hash, packet) == -1)
+    {
+      packet = this->acquire_packet ();
+
+      if (this->incomplete_.bind (id_hash, packet) != 0)
+        {
+          // Cleanup the packet.
+          this->release_packet (packet);
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
+                      ACE_TEXT ("recv_all, could not queue fragment\n"),
+                      this->id ()));
+          return 0;
+        }
     }
+
+  this->last_hash_ = id_hash;
+  this->last_packet_ = packet;
+  return packet;
 }
 
 ACE_Event_Handler *
@@ -146,24 +233,16 @@ int TAO_UIPMC_Mcast_Transport::send_message (
 }
 
 char *
-TAO_UIPMC_Mcast_Transport::recv_packet (
+TAO_UIPMC_Mcast_Transport::parse_packet (
   char *buf,
   size_t len,
-  ACE_INET_Addr &from_addr,
   CORBA::UShort &packet_length,
   CORBA::ULong &packet_number,
+  CORBA::ULong &number_of_packets,
   bool &stop_packet,
   u_long &id_hash) const
 {
-  // We read the whole MIOP packet which is not longer than MIOP_MAX_DGRAM_SIZE.
-  ssize_t const n =
-    this->connection_handler_->peer ().recv (buf,
-                                             len,
-                                             from_addr);
-
-  // There is nothing left in the socket buffer.
-  if (n <= 0)
-    return 0;
+  ssize_t const n = static_cast<ssize_t> (len);
 
   // Make sure that we at least have a MIOP header.
   if (static_cast<size_t> (n) < MIOP_MIN_HEADER_SIZE)
@@ -172,7 +251,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet of size %d is ")
+                      ACE_TEXT ("parse_packet, packet of size %d is ")
                       ACE_TEXT ("too small\n"),
                       this->id (),
                       n));
@@ -197,7 +276,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet didn't contain ")
+                      ACE_TEXT ("parse_packet, packet didn't contain ")
                       ACE_TEXT ("magic bytes\n"),
                       this->id ()));
         }
@@ -215,7 +294,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet has wrong version ")
+                      ACE_TEXT ("parse_packet, packet has wrong version ")
                       ACE_TEXT ("%d.%d\n"),
                       this->id (),
                       (miop_version >> 4) & 0xf,
@@ -240,8 +319,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
 
   miop_hdr.read_ulong (packet_number);
 
-  // We don't use number_of_packets since it's optional in the spec.
-  CORBA::ULong number_of_packets;
+  // number_of_packets is optional in the spec, zero if not given.
   miop_hdr.read_ulong (number_of_packets);
 
   CORBA::ULong id_length;
@@ -255,7 +333,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, malformed packet\n"),
+                      ACE_TEXT ("parse_packet, malformed packet\n"),
                       this->id ()));
         }
 
@@ -270,7 +348,7 @@ TAO_UIPMC_Mcast_Transport::recv_packet (
         {
           ORBSVCS_ERROR ((LM_ERROR,
                       ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                      ACE_TEXT ("recv_packet, packet not large enough ")
+                      ACE_TEXT ("parse_packet, packet not large enough ")
                       ACE_TEXT ("for padding\n"),
                       this->id ()));
         }
@@ -304,127 +382,130 @@ TAO_UIPMC_Mcast_Transport::recv_all (TAO_Resume_Handle &rh)
       ACE_TEXT ("MIOP_Resource_Factory"));
   const bool eager_dequeue= factory->enable_eager_dequeue ();
 
+  // A completed message this thread processes without queueing it.
+  TAO_PG::UIPMC_Recv_Packet *packet = 0;
+
   // Only one thread will do recv at the same time.
   // FUZZ: disable check_for_ACE_Guard
   ACE_Guard<TAO_SYNCH_MUTEX> recv_guard (this->recv_lock_, 0); // tryacquire
   // FUZZ: enable check_for_ACE_Guard
   if (recv_guard.locked ())
     {
-      // The buffer on the stack which will be used to hold the input
-      // messages.
-      char buf [MIOP_MAX_DGRAM_SIZE + ACE_CDR::MAX_ALIGNMENT];
-      char *aligned_buf = ACE_ptr_align_binary (buf, ACE_CDR::MAX_ALIGNMENT);
-
-#if defined (ACE_INITIALIZE_MEMORY_BEFORE_USE)
-      (void) ACE_OS::memset (buf, '\0', sizeof buf);
-#endif /* ACE_INITIALIZE_MEMORY_BEFORE_USE */
+      if (this->recv_batch_ == 0)
+        {
+          // The buffers which will be used to hold the input
+          // messages, as many as are read with one system call.
+          ACE_NEW_THROW_EX (this->recv_batch_,
+                            TAO_PG::UIPMC_Recv_Batch (
+                              factory->receive_batch (),
+                              MIOP_MAX_DGRAM_SIZE),
+                            CORBA::NO_MEMORY (
+                              CORBA::SystemException::_tao_minor_code (
+                                TAO::VMCID,
+                                ENOMEM),
+                              CORBA::COMPLETED_NO));
+        }
 
-      while (true)
+      bool done = false;
+      while (!done)
         {
-          // This guard will cleanup expired packets each iteration.
+          // This guard will cleanup expired packets each batch.
           TAO_PG::UIPMC_Recv_Packet_Cleanup_Guard guard (this);
 
-          ACE_INET_Addr from_addr;
-          CORBA::UShort packet_length;
-          CORBA::ULong packet_number = 0;
-          bool stop_packet = false;
-          u_long id_hash;
-
-          char *start_data =
-            this->recv_packet (aligned_buf, MIOP_MAX_DGRAM_SIZE, from_addr,
-                               packet_length, packet_number, stop_packet, id_hash);
+          int const count =
+            this->recv_batch_->recv (this->connection_handler_->peer ());
 
           // The socket buffer is empty. Try to do other useful things.
-          if (start_data == 0)
+          if (count <= 0)
             {
               if (errno != EWOULDBLOCK && errno != EAGAIN)
                 {
                   ORBSVCS_DEBUG ((LM_DEBUG,
                               ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                              ACE_TEXT ("recv_all, unexpected failure of recv_packet (Errno: '%m')\n"),
+                              ACE_TEXT ("recv_all, unexpected failure of recv (Errno: '%m')\n"),
                               this->id ()));
                 }
               break;
             }
 
-          if (TAO_debug_level >= 9)
+          // Every datagram read has to be handled before returning,
+          // the reactor won't tell about them again.
+          for (int i = 0; i < count; ++i)
             {
-              char tmp[INET6_ADDRSTRLEN];
-              from_addr.get_host_addr (tmp, sizeof tmp);
-              ORBSVCS_DEBUG ((LM_DEBUG,
-                          ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                          ACE_TEXT ("recv, received %d bytes from <%C:%u> ")
-                          ACE_TEXT ("(hash %d)\n"),
-                          this->id (),
-                          packet_length,
-                          tmp,
-                          from_addr.get_port_number (),
-                          id_hash));
-            }
+              CORBA::UShort packet_length;
+              CORBA::ULong packet_number = 0;
+              CORBA::ULong number_of_packets = 0;
+              bool stop_packet = false;
+              u_long id_hash;
+
+              char *start_data =
+                this->parse_packet (this->recv_batch_->datagram (i),
+                                    this->recv_batch_->length (i),
+                                    packet_length,
+                                    packet_number,
+                                    number_of_packets,
+                                    stop_packet,
+                                    id_hash);
+              if (start_data == 0)
+                continue;
 
-          TAO_PG::UIPMC_Recv_Packet *packet = 0;
-          if (this->incomplete_.find (id_hash, packet) == -1)
-            {
-              ACE_NEW_THROW_EX (packet,
-                                TAO_PG::UIPMC_Recv_Packet,
-                                CORBA::NO_MEMORY (
-                                  CORBA::SystemException::_tao_minor_code (
-                                    TAO::VMCID,
-                                    ENOMEM),
-                                  CORBA::COMPLETED_NO));
-
-              if (this->incomplete_.bind (id_hash, packet) != 0)
+              if (TAO_debug_level >= 9)
                 {
-                  // Cleanup the packet.
-                  delete packet;
+                  ACE_INET_Addr const &from_addr = this->recv_batch_->from (i);
+                  char tmp[INET6_ADDRSTRLEN];
+                  from_addr.get_host_addr (tmp, sizeof tmp);
                   ORBSVCS_DEBUG ((LM_DEBUG,
                               ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                              ACE_TEXT ("recv_all, could not queue fragment\n"),
-                              this->id ()));
-                  continue;
+                              ACE_TEXT ("recv, received %d bytes from <%C:%u> ")
+                              ACE_TEXT ("(hash %d)\n"),
+                              this->id (),
+                              packet_length,
+                              tmp,
+                              from_addr.get_port_number (),
+                              id_hash));
                 }
-            }
 
-          // We have incomplete packet so add the new data to it.
-          // add_fragment returns 1 iff the packet is complete.
-          if (1 == packet->add_fragment (start_data, packet_length,
-                                         packet_number, stop_packet))
-            {
+              TAO_PG::UIPMC_Recv_Packet *incomplete = this->find_packet (id_hash);
+              if (incomplete == 0)
+                continue;
+
+              // We have incomplete packet so add the new data to it.
+              // add_fragment returns 1 iff the packet is complete.
+              if (1 != incomplete->add_fragment (start_data, packet_length,
+                                                 packet_number, stop_packet,
+                                                 number_of_packets))
+                continue;
+
               // Remove this packet from incomplete packets.
               this->incomplete_.unbind (id_hash);
+              this->last_packet_ = 0;
 
-              // If there are no completed message ahead of us AND
-              // we only want a single message, just return it.
-              if (this->complete_.is_empty () && !eager_dequeue)
+              // Stop attempting to queue more messages after this batch
+              // if we are not in eager mode.
+              if (!eager_dequeue)
                 {
-                  if (TAO_debug_level >= 9)
+                  done = true;
+
+                  // If there are no completed message ahead of us AND
+                  // we only want a single message, just return it.
+                  if (packet == 0 && this->complete_.is_empty ())
                     {
-                      ORBSVCS_DEBUG ((LM_DEBUG,
-                                  ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                                  ACE_TEXT ("recv_all, completed MIOP message %@\n"),
-                                  this->id (), static_cast<void *> (packet)));
+                      packet = incomplete;
+                      continue;
                     }
-
-                  return packet;
                 }
+
               ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
-                                guard,
+                                complete_guard,
                                 this->complete_lock_,
-                                packet);
-              if (this->complete_.is_empty () && !eager_dequeue)
+                                incomplete);
+              if (packet == 0 && this->complete_.is_empty () && !eager_dequeue)
                 {
                   // Another thread dequeued the waiting MIOP message before we got
                   // the lock, simply return our single message, don't bother queueing
                   // it after all.
-                  if (TAO_debug_level >= 9)
-                    {
-                      ORBSVCS_DEBUG ((LM_DEBUG,
-                                  ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                                  ACE_TEXT ("recv_all, completed MIOP message %@\n"),
-                                  this->id (), static_cast<void *> (packet)));
-                    }
-
-                  return packet;
+                  packet = incomplete;
+                  continue;
                 }
 
               if (TAO_debug_level >= 9)
@@ -432,44 +513,57 @@ TAO_UIPMC_Mcast_Transport::recv_all (TAO_Resume_Handle &rh)
                   ORBSVCS_DEBUG ((LM_DEBUG,
                               ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
                               ACE_TEXT ("recv_all, completed MIOP message %@ (QUEUED)\n"),
-                              this->id (), static_cast<void *> (packet)));
+                              this->id (), static_cast<void *> (incomplete)));
                 }
 
               // Add it to the complete queue.
-              this->complete_.enqueue_tail (packet);
-
-              // Stop attempting to queue more messages if we are not in eager mode.
-              if (!eager_dequeue)
-                break;
+              this->complete_.enqueue_tail (incomplete);
             }
         }
       recv_guard.release ();
     }
 
+  if (packet != 0)
+    {
+      if (TAO_debug_level >= 9)
+        {
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
+                      ACE_TEXT ("recv_all, completed MIOP message %@\n"),
+                      this->id (), static_cast<void *> (packet)));
+        }
+
+      // More messages may have completed in the same batch.
+      if (this->complete_.is_empty ())
+        return packet;
+    }
+
   // Ok we have received as many packets as we could, now if we have
   // any completed packets queued up, return the first to the caller.
   if (this->complete_.is_empty ())
     return 0;
-  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, complete_guard, this->complete_lock_, 0);
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, complete_guard, this->complete_lock_, packet);
   if (this->complete_.is_empty ())
-    return 0; // Another thread got here first, not a problem.
+    return packet; // Another thread got here first, not a problem.
 
-  TAO_PG::UIPMC_Recv_Packet *packet = 0;
-  if (this->complete_.dequeue_head (packet) == -1)
+  if (packet == 0)
     {
-      ORBSVCS_DEBUG ((LM_DEBUG,
-                  ACE_TEXT ("TAO (%P|%t) - TAO_UIPMC_Mcast_Transport[%d]::recv_all, ")
-                  ACE_TEXT ("unable to dequeue completed message\n"),
-                  this->id ()));
-      return 0;
-    }
+      if (this->complete_.dequeue_head (packet) == -1)
+        {
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - TAO_UIPMC_Mcast_Transport[%d]::recv_all, ")
+                      ACE_TEXT ("unable to dequeue completed message\n"),
+                      this->id ()));
+          return 0;
+        }
 
-  if (TAO_debug_level >= 9)
-    {
-      ORBSVCS_DEBUG ((LM_DEBUG,
-                  ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
-                  ACE_TEXT ("recv_all, completed MIOP message %@ (DEQUEUED)\n"),
-                  this->id (), static_cast<void *> (packet)));
+      if (TAO_debug_level >= 9)
+        {
+          ORBSVCS_DEBUG ((LM_DEBUG,
+                      ACE_TEXT ("TAO (%P|%t) - UIPMC_Mcast_Transport[%d]::")
+                      ACE_TEXT ("recv_all, completed MIOP message %@ (DEQUEUED)\n"),
+                      this->id (), static_cast<void *> (packet)));
+        }
     }
 
   // If there is another message waiting to be processed (in addition
@@ -497,6 +591,31 @@ TAO_UIPMC_Mcast_Transport::recv_all (TAO_Resume_Handle &rh)
   return packet;
 }
 
+/**
+ * @class TAO_UIPMC_Mcast_Transport::Packet_Releaser
+ *
+ * @brief Gives a processed packet back to the pool of its transport.
+ */
+class TAO_UIPMC_Mcast_Transport::Packet_Releaser
+{
+public:
+  Packet_Releaser (TAO_UIPMC_Mcast_Transport *transport,
+                   TAO_PG::UIPMC_Recv_Packet *packet)
+    : transport_ (transport)
+    , packet_ (packet)
+  {
+  }
+
+  ~Packet_Releaser ()
+  {
+    this->transport_->release_packet (this->packet_);
+  }
+
+private:
+  TAO_UIPMC_Mcast_Transport *transport_;
+  TAO_PG::UIPMC_Recv_Packet *packet_;
+};
+
 int
 TAO_UIPMC_Mcast_Transport::handle_input (
   TAO_Resume_Handle &rh,
@@ -514,8 +633,8 @@ TAO_UIPMC_Mcast_Transport::handle_input (
     }
 
   // Grab the next completed MIOP message to process from the FIFO Queue.
-  std::unique_ptr<TAO_PG::UIPMC_Recv_Packet> complete_owner (this->recv_all (rh));
-  if (TAO_PG::UIPMC_Recv_Packet *complete = complete_owner.get ())
+  TAO_PG::UIPMC_Recv_Packet *complete = this->recv_all (rh);
+  if (complete != 0)
     {
       if (TAO_debug_level >= 9)
         {
@@ -525,17 +644,29 @@ TAO_UIPMC_Mcast_Transport::handle_input (
                       this->id (), static_cast<void *> (complete), complete->data_length ()));
         }
 
-      // Create a data block from our dequeued completed message.
-      char *buffer= 0;
-      ACE_NEW_THROW_EX (buffer,
-                        char[complete->data_length () + ACE_CDR::MAX_ALIGNMENT],
-                        CORBA::NO_MEMORY (
-                          CORBA::SystemException::_tao_minor_code (
-                            TAO::VMCID,
-                            ENOMEM),
-                          CORBA::COMPLETED_NO));
-      std::unique_ptr<char[]> owner_buffer (buffer);
-      ACE_Data_Block db (complete->data_length () + ACE_CDR::MAX_ALIGNMENT,
+      // Hand the packet back to the pool once processed.
+      Packet_Releaser releaser (this, complete);
+
+      // If the fragments arrived in order the packet already holds
+      // the message, aligned, otherwise create a data block and
+      // reassemble the message in it.
+      std::unique_ptr<char[]> owner_buffer;
+      char *buffer = complete->contiguous_data ();
+      size_t buffer_size = complete->capacity ();
+      if (buffer == 0)
+        {
+          buffer_size = complete->data_length () + ACE_CDR::MAX_ALIGNMENT;
+          ACE_NEW_THROW_EX (buffer,
+                            char[buffer_size],
+                            CORBA::NO_MEMORY (
+                              CORBA::SystemException::_tao_minor_code (
+                                TAO::VMCID,
+                                ENOMEM),
+                              CORBA::COMPLETED_NO));
+          owner_buffer.reset (buffer);
+        }
+
+      ACE_Data_Block db (buffer_size,
                          ACE_Message_Block::MB_DATA,
                          buffer,
                          this->orb_core_->input_cdr_buffer_allocator (),
@@ -552,7 +683,8 @@ TAO_UIPMC_Mcast_Transport::handle_input (
       // Align the message block.
       ACE_CDR::mb_align (&message_block);
 
-      complete->copy_data (message_block.wr_ptr ());
+      if (owner_buffer)
+        complete->copy_data (message_block.wr_ptr ());
 
       // Set the write pointer in the stack buffer.
       message_block.wr_ptr (complete->data_length ());
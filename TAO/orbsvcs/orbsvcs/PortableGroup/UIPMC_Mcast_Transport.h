@@ -33,6 +33,7 @@ namespace TAO_PG
 {
   class UIPMC_Recv_Packet_Cleanup_Guard;
   class UIPMC_Recv_Packet;
+  class UIPMC_Recv_Batch;
 }
 
 /**
@@ -105,15 +106,27 @@ public:
   //@}
 
 private:
-  /// Receive a UDP message and extract all necessary info from the MIOP
-  /// header. If everything is fine return a pointer to the first byte of
-  /// the non-MIOP data.
-  char *recv_packet (char *buf, size_t len,
-                     ACE_INET_Addr &from_addr,
-                     CORBA::UShort &packet_length,
-                     CORBA::ULong &packet_number,
-                     bool &stop_packet,
-                     u_long &id_hash) const;
+  class Packet_Releaser;
+
+  /// Extract all necessary info from the MIOP header of the @a len
+  /// bytes UDP message at @a buf. If everything is fine return a
+  /// pointer to the first byte of the non-MIOP data.
+  char *parse_packet (char *buf, size_t len,
+                      CORBA::UShort &packet_length,
+                      CORBA::ULong &packet_number,
+                      CORBA::ULong &number_of_packets,
+                      bool &stop_packet,
+                      u_long &id_hash) const;
+
+  /// Return the incomplete packet for @a id_hash, starting a new one
+  /// if there is none.
+  TAO_PG::UIPMC_Recv_Packet *find_packet (u_long id_hash);
+
+  /// Take a packet from the pool, or allocate one.
+  TAO_PG::UIPMC_Recv_Packet *acquire_packet ();
+
+  /// Give a packet that has been processed back to the pool.
+  void release_packet (TAO_PG::UIPMC_Recv_Packet *packet);
 
   /// Return the next complete MIOP packet, possibly dequeueing
   /// as many as are available first from the socket.
@@ -131,15 +144,31 @@ private:
   /// Incomplete packets.
   Packets_Map incomplete_;
 
+  /// The packet fragments were last added to, most fragments belong
+  /// to the same packet as the one before. Only used under recv_lock_.
+  u_long last_hash_;
+  TAO_PG::UIPMC_Recv_Packet *last_packet_;
+
   /// A lock for ensuring that only one thread is doing recv.
   TAO_SYNCH_MUTEX recv_lock_;
 
+  /// The buffers datagrams are read into, only used under recv_lock_.
+  TAO_PG::UIPMC_Recv_Batch *recv_batch_;
+
   /// Complete packets.
   typedef ACE_Unbounded_Queue<TAO_PG::UIPMC_Recv_Packet *> Packets_Queue;
   Packets_Queue complete_;
 
   /// A lock for access synchronization to complete queue.
   TAO_SYNCH_MUTEX complete_lock_;
+
+  /// Packets kept for reuse with their storage.
+  enum { PACKET_POOL_SIZE = 8 };
+  TAO_PG::UIPMC_Recv_Packet *packet_pool_[PACKET_POOL_SIZE];
+  int packet_pool_count_;
+
+  /// A lock for access synchronization to the pool of packets.
+  TAO_SYNCH_MUTEX packet_pool_lock_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
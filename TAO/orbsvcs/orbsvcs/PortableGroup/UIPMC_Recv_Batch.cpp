@@ -0,0 +1,159 @@
+#include "orbsvcs/PortableGroup/UIPMC_Recv_Batch.h"
+
+#include "tao/CDR.h"
+
+#include "ace/SOCK_Dgram.h"
+#include "ace/OS_NS_errno.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_sys_socket.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO_PG
+{
+  UIPMC_Recv_Batch::UIPMC_Recv_Batch (u_long capacity,
+                                      size_t datagram_size)
+    : capacity_ (0)
+    , datagram_size_ (datagram_size)
+    , stride_ (ACE_align_binary (datagram_size, ACE_CDR::MAX_ALIGNMENT))
+    , buffer_ (0)
+    , aligned_ (0)
+    , lengths_ (0)
+    , from_ (0)
+#if defined (ACE_HAS_RECVMMSG)
+    , msgs_ (0)
+    , iov_ (0)
+#endif /* ACE_HAS_RECVMMSG */
+  {
+#if defined (ACE_HAS_RECVMMSG)
+    int const count = capacity == 0u ? 1 : static_cast<int> (capacity);
+#else
+    ACE_UNUSED_ARG (capacity);
+    int const count = 1;
+#endif /* ACE_HAS_RECVMMSG */
+
+    ACE_NEW_NORETURN (this->buffer_,
+                      char[count * this->stride_ + ACE_CDR::MAX_ALIGNMENT]);
+    ACE_NEW_NORETURN (this->lengths_, size_t[count]);
+    ACE_NEW_NORETURN (this->from_, ACE_INET_Addr[count]);
+#if defined (ACE_HAS_RECVMMSG)
+    ACE_NEW_NORETURN (this->msgs_, mmsghdr[count]);
+    ACE_NEW_NORETURN (this->iov_, iovec[count]);
+    if (this->msgs_ == 0 || this->iov_ == 0)
+      return;
+#endif /* ACE_HAS_RECVMMSG */
+    if (this->buffer_ == 0 || this->lengths_ == 0 || this->from_ == 0)
+      return;
+
+    this->aligned_ =
+      ACE_ptr_align_binary (this->buffer_, ACE_CDR::MAX_ALIGNMENT);
+
+#if defined (ACE_INITIALIZE_MEMORY_BEFORE_USE)
+    ACE_OS::memset (this->buffer_,
+                    '\0',
+                    count * this->stride_ + ACE_CDR::MAX_ALIGNMENT);
+#endif /* ACE_INITIALIZE_MEMORY_BEFORE_USE */
+
+#if defined (ACE_HAS_RECVMMSG)
+    ACE_OS::memset (this->msgs_, 0, count * sizeof (mmsghdr));
+    for (int i = 0; i < count; ++i)
+      {
+        this->iov_[i].iov_base = this->aligned_ + i * this->stride_;
+        this->iov_[i].iov_len = this->datagram_size_;
+        this->msgs_[i].msg_hdr.msg_iov = &this->iov_[i];
+        this->msgs_[i].msg_hdr.msg_iovlen = 1;
+      }
+#endif /* ACE_HAS_RECVMMSG */
+
+    this->capacity_ = count;
+  }
+
+  UIPMC_Recv_Batch::~UIPMC_Recv_Batch ()
+  {
+#if defined (ACE_HAS_RECVMMSG)
+    delete [] this->iov_;
+    delete [] this->msgs_;
+#endif /* ACE_HAS_RECVMMSG */
+    delete [] this->from_;
+    delete [] this->lengths_;
+    delete [] this->buffer_;
+  }
+
+  int
+  UIPMC_Recv_Batch::recv (ACE_SOCK_Dgram &socket)
+  {
+    if (this->capacity_ == 0)
+      {
+        errno = ENOMEM;
+        return -1;
+      }
+
+#if defined (ACE_HAS_RECVMMSG)
+    if (this->capacity_ > 1)
+      {
+        for (int i = 0; i < this->capacity_; ++i)
+          {
+            this->msgs_[i].msg_hdr.msg_name = this->from_[i].get_addr ();
+            this->msgs_[i].msg_hdr.msg_namelen = this->from_[i].get_size ();
+          }
+
+        // The socket is nonblocking, so this returns with what is
+        // waiting instead of waiting for a whole batch.
+        int const n = ::recvmmsg (socket.get_handle (),
+                                  this->msgs_,
+                                  this->capacity_,
+                                  0,
+                                  0);
+        if (n <= 0)
+          return n == 0 ? -1 : n;
+
+        for (int i = 0; i < n; ++i)
+          {
+            this->lengths_[i] = this->msgs_[i].msg_len;
+
+            sockaddr const *saddr =
+              static_cast<sockaddr const *> (this->msgs_[i].msg_hdr.msg_name);
+            this->from_[i].set_type (saddr->sa_family);
+            this->from_[i].set_size (this->msgs_[i].msg_hdr.msg_namelen);
+          }
+
+        return n;
+      }
+#endif /* ACE_HAS_RECVMMSG */
+
+    ssize_t const n = socket.recv (this->aligned_,
+                                   this->datagram_size_,
+                                   this->from_[0]);
+    if (n < 0)
+      return -1;
+
+    this->lengths_[0] = static_cast<size_t> (n);
+    return 1;
+  }
+
+  char *
+  UIPMC_Recv_Batch::datagram (int i) const
+  {
+    return this->aligned_ + i * this->stride_;
+  }
+
+  size_t
+  UIPMC_Recv_Batch::length (int i) const
+  {
+    return this->lengths_[i];
+  }
+
+  ACE_INET_Addr const &
+  UIPMC_Recv_Batch::from (int i) const
+  {
+    return this->from_[i];
+  }
+
+  int
+  UIPMC_Recv_Batch::capacity () const
+  {
+    return this->capacity_;
+  }
+} // namespace TAO_PG
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,113 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file     UIPMC_Recv_Batch.h
+ *
+ *  Reading several MIOP datagrams with one system call.
+ */
+//=============================================================================
+
+#ifndef TAO_UIPMC_RECV_BATCH_H
+#define TAO_UIPMC_RECV_BATCH_H
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/PortableGroup/portablegroup_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Versioned_Namespace.h"
+
+#include "ace/INET_Addr.h"
+#include "ace/os_include/sys/os_socket.h"
+#include "ace/os_include/sys/os_uio.h"
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_SOCK_Dgram;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO_PG
+{
+  /**
+   * @class UIPMC_Recv_Batch
+   *
+   * @brief Buffers for the datagrams read from a socket at once.
+   *
+   * Where recvmmsg() is available (ACE_HAS_RECVMMSG) all the
+   * datagrams waiting on the socket, up to the capacity of the batch,
+   * are read with a single system call.  Elsewhere, or if the
+   * capacity is one, a batch holds a single datagram.
+   *
+   * Every datagram is received at an 8 byte boundary, so its MIOP
+   * header can be read with CDR.
+   */
+  class TAO_PortableGroup_Export UIPMC_Recv_Batch
+  {
+  public:
+    /// Constructor.
+    /**
+     * @param capacity      Largest number of datagrams read at once.
+     * @param datagram_size Largest datagram expected.
+     */
+    UIPMC_Recv_Batch (u_long capacity, size_t datagram_size);
+
+    ~UIPMC_Recv_Batch ();
+
+    /// Read the datagrams waiting on @a socket.
+    /**
+     * @return The number of datagrams read, or -1 with errno set if
+     *         none could be read, EWOULDBLOCK for a nonblocking
+     *         socket that has nothing waiting.
+     */
+    int recv (ACE_SOCK_Dgram &socket);
+
+    /// The @a i th datagram read by the last recv().
+    char *datagram (int i) const;
+
+    /// The length of the @a i th datagram read by the last recv().
+    size_t length (int i) const;
+
+    /// The sender of the @a i th datagram read by the last recv().
+    ACE_INET_Addr const &from (int i) const;
+
+    /// The largest number of datagrams read at once.
+    int capacity () const;
+
+  private:
+    UIPMC_Recv_Batch (const UIPMC_Recv_Batch &);
+    UIPMC_Recv_Batch &operator= (const UIPMC_Recv_Batch &);
+
+    int capacity_;
+
+    size_t datagram_size_;
+
+    /// Distance between the starts of two datagrams in <buffer_>.
+    size_t stride_;
+
+    /// Storage for all the datagrams.
+    char *buffer_;
+
+    /// <buffer_> aligned to an 8 byte boundary.
+    char *aligned_;
+
+    size_t *lengths_;
+
+    ACE_INET_Addr *from_;
+
+#if defined (ACE_HAS_RECVMMSG)
+    /// The message descriptors passed to recvmmsg().
+    mmsghdr *msgs_;
+
+    iovec *iov_;
+#endif /* ACE_HAS_RECVMMSG */
+  };
+} // namespace TAO_PG
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif  /* TAO_UIPMC_RECV_BATCH_H */
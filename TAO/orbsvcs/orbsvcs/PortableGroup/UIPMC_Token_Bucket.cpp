@@ -0,0 +1,70 @@
+#include "orbsvcs/PortableGroup/UIPMC_Token_Bucket.h"
+
+#include "ace/High_Res_Timer.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO_PG
+{
+  UIPMC_Token_Bucket::UIPMC_Token_Bucket (ACE_UINT64 rate, ACE_UINT64 burst)
+    : rate_ (0u)
+    , burst_time_ (0.0)
+    , full_at_ (0.0)
+  {
+    this->configure (rate, burst);
+  }
+
+  void
+  UIPMC_Token_Bucket::configure (ACE_UINT64 rate, ACE_UINT64 burst)
+  {
+    this->rate_ = rate;
+    this->burst_time_ = rate == 0u
+      ? 0.0
+      : static_cast<double> (burst) * ACE_ONE_SECOND_IN_USECS / rate;
+    this->full_at_ = 0.0;
+  }
+
+  bool
+  UIPMC_Token_Bucket::enabled () const
+  {
+    return this->rate_ != 0u;
+  }
+
+  ACE_Time_Value
+  UIPMC_Token_Bucket::reserve (size_t bytes)
+  {
+    ACE_UINT64 now = 0u;
+    ACE_High_Res_Timer::gettimeofday_hr ().to_usec (now);
+
+    ACE_UINT64 const wait = this->reserve (bytes, now);
+    if (wait == 0u)
+      return ACE_Time_Value::zero;
+
+    return ACE_Time_Value (
+      static_cast<time_t> (wait / ACE_ONE_SECOND_IN_USECS),
+      static_cast<suseconds_t> (wait % ACE_ONE_SECOND_IN_USECS));
+  }
+
+  ACE_UINT64
+  UIPMC_Token_Bucket::reserve (size_t bytes, ACE_UINT64 now)
+  {
+    if (this->rate_ == 0u)
+      return 0u;
+
+    // An empty bucket, or one that filled up while idle, starts
+    // filling from now.
+    double const current = static_cast<double> (now);
+    if (this->full_at_ < current)
+      this->full_at_ = current;
+
+    this->full_at_ +=
+      static_cast<double> (bytes) * ACE_ONE_SECOND_IN_USECS / this->rate_;
+
+    // The bytes may go as soon as the bucket is less than a burst
+    // away from being full.
+    double const wait = this->full_at_ - this->burst_time_ - current;
+    return wait <= 0.0 ? 0u : static_cast<ACE_UINT64> (wait);
+  }
+} // namespace TAO_PG
+
+TAO_END_VERSIONED_NAMESPACE_DECL
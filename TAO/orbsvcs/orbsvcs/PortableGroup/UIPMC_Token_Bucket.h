@@ -0,0 +1,80 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file     UIPMC_Token_Bucket.h
+ *
+ *  Pacing of the MIOP fragments a client sends.
+ */
+//=============================================================================
+
+#ifndef TAO_UIPMC_TOKEN_BUCKET_H
+#define TAO_UIPMC_TOKEN_BUCKET_H
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/PortableGroup/portablegroup_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Versioned_Namespace.h"
+
+#include "ace/Basic_Types.h"
+#include "ace/Time_Value.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO_PG
+{
+  /**
+   * @class UIPMC_Token_Bucket
+   *
+   * @brief Token bucket limiting the rate at which bytes are sent.
+   *
+   * The bucket fills at @c rate bytes per second up to @c burst
+   * bytes.  Sending a fragment takes its size from the bucket; when
+   * there is not enough in the bucket the sender is told how long to
+   * wait.  The bucket is allowed to go into debt, so a sender woken
+   * late by the scheduler sends its next fragments without delay
+   * and the average rate is kept.
+   *
+   * Not thread safe, the transport owning the bucket serializes its
+   * sends.
+   */
+  class TAO_PortableGroup_Export UIPMC_Token_Bucket
+  {
+  public:
+    /// Constructor, a zero @a rate disables pacing.
+    UIPMC_Token_Bucket (ACE_UINT64 rate = 0u, ACE_UINT64 burst = 0u);
+
+    /// Change the rate in bytes per second and the burst in bytes.
+    void configure (ACE_UINT64 rate, ACE_UINT64 burst);
+
+    /// Is the rate limited at all?
+    bool enabled () const;
+
+    /// Take @a bytes from the bucket, return how long to wait before
+    /// sending them.
+    ACE_Time_Value reserve (size_t bytes);
+
+    /// Take @a bytes from the bucket at @a now (in microseconds of
+    /// any monotonic clock), return the microseconds to wait.
+    ACE_UINT64 reserve (size_t bytes, ACE_UINT64 now);
+
+  private:
+    /// Bytes per second.
+    ACE_UINT64 rate_;
+
+    /// Microseconds it takes to refill the whole bucket.
+    double burst_time_;
+
+    /// The time at which the bucket is full again, in microseconds.
+    double full_at_;
+  };
+} // namespace TAO_PG
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif  /* TAO_UIPMC_TOKEN_BUCKET_H */
@@ -28,6 +28,14 @@ TAO_UIPMC_Transport::TAO_UIPMC_Transport (
   delete this->ws_;
   ACE_NEW (this->ws_, TAO_UIPMC_Wait_Never (this));
 
+  TAO_MIOP_Resource_Factory *const factory =
+    ACE_Dynamic_Service<TAO_MIOP_Resource_Factory>::instance (
+      orb_core->configuration(),
+      ACE_TEXT ("MIOP_Resource_Factory"));
+  if (factory)
+    this->send_pacer_.configure (factory->send_pacing_rate (),
+                                 factory->send_pacing_burst ());
+
   ACE_Utils::UUID uuid;
   ACE_Utils::UUID_GENERATOR::instance ()->generate_UUID (uuid);
 
@@ -318,6 +326,16 @@ TAO_UIPMC_Transport::send (
       if (*packet_number == number_of_packets_required-1uL)
         *flags_field |= 0x02;
 
+      // Wait for the fragment's turn if the send rate is paced.
+      if (this->send_pacer_.enabled ())
+        {
+          ACE_Time_Value const delay =
+            this->send_pacer_.reserve (this_fragment_size +
+                                       MIOP_DEFAULT_HEADER_SIZE);
+          if (delay != ACE_Time_Value::zero)
+            ACE_OS::sleep (delay);
+        }
+
       ssize_t already_sent = 0; // No data sent yet!
       iovec *current_iov= this_fragment_iov;
       for (this_fragment_size+= MIOP_DEFAULT_HEADER_SIZE; // Now includes MIOP header
@@ -18,6 +18,8 @@
 # pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
+#include "orbsvcs/PortableGroup/UIPMC_Token_Bucket.h"
+
 #include "tao/Transport.h"
 
 #include "ace/SOCK_Stream.h"
@@ -106,6 +108,9 @@ private:
   /// transmitted and the time when this was last updated.
   u_long total_bytes_outstanding_;
   ACE_Time_Value time_last_sent_;
+
+  /// Paces the fragments sent to the configured rate, if any.
+  TAO_PG::UIPMC_Token_Bucket send_pacer_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -1,7 +1,12 @@
 #include "orbsvcs/Log_Macros.h"
 #include "orbsvcs/PortableGroup/UIPMC_Transport_Recv_Packet.h"
 #include "orbsvcs/PortableGroup/UIPMC_Mcast_Transport.h"
+#include "orbsvcs/PortableGroup/miopconf.h"
 
+#include "tao/CDR.h"
+#include "tao/debug.h"
+
+#include "ace/OS_NS_string.h"
 #include "ace/OS_NS_sys_time.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -23,36 +28,157 @@ namespace TAO_PG
 
   UIPMC_Recv_Packet::UIPMC_Recv_Packet ()
     : last_fragment_id_ (0)
+    , has_last_ (false)
     , data_length_ (0)
     , started_ (ACE_OS::gettimeofday ())
+    , fragments_ (0)
+    , fragments_size_ (0)
+    , fragment_count_ (0)
+    , in_order_ (true)
+    , slab_ (0)
+    , data_ (0)
+    , slab_size_ (0)
   {
   }
 
   UIPMC_Recv_Packet::~UIPMC_Recv_Packet ()
   {
-    for (Fragments_Map::iterator iter = this->fragments_.begin ();
-         iter != this->fragments_.end ();
-         ++iter)
+    delete [] this->fragments_;
+    delete [] this->slab_;
+  }
+
+  void
+  UIPMC_Recv_Packet::reset ()
+  {
+    for (CORBA::ULong i = 0; i < this->fragments_size_; ++i)
+      this->fragments_[i].present = false;
+
+    this->last_fragment_id_ = 0;
+    this->has_last_ = false;
+    this->data_length_ = 0;
+    this->fragment_count_ = 0;
+    this->in_order_ = true;
+    this->started_ = ACE_OS::gettimeofday ();
+  }
+
+  bool
+  UIPMC_Recv_Packet::reserve_data (size_t size)
+  {
+    if (size <= this->slab_size_)
+      return true;
+
+    size_t new_size = this->slab_size_ * 2;
+    if (new_size < size)
+      new_size = size;
+
+    char *slab = 0;
+    ACE_NEW_RETURN (slab,
+                    char[new_size + ACE_CDR::MAX_ALIGNMENT],
+                    false);
+    char *data = ACE_ptr_align_binary (slab, ACE_CDR::MAX_ALIGNMENT);
+
+    if (this->data_length_ != 0)
+      ACE_OS::memcpy (data, this->data_, this->data_length_);
+
+    delete [] this->slab_;
+    this->slab_ = slab;
+    this->data_ = data;
+    this->slab_size_ = new_size;
+    return true;
+  }
+
+  bool
+  UIPMC_Recv_Packet::reserve_fragments (CORBA::ULong count)
+  {
+    if (count <= this->fragments_size_)
+      return true;
+
+    CORBA::ULong new_size = this->fragments_size_ * 2;
+    if (new_size < count)
+      new_size = count;
+    if (new_size > MIOP_MAX_RECV_FRAGMENTS)
+      new_size = static_cast<CORBA::ULong> (MIOP_MAX_RECV_FRAGMENTS);
+
+    Fragment *fragments = 0;
+    ACE_NEW_RETURN (fragments, Fragment[new_size], false);
+
+    for (CORBA::ULong i = 0; i < new_size; ++i)
       {
-        delete [] (*iter).item ().buf;
+        if (i < this->fragments_size_)
+          fragments[i] = this->fragments_[i];
+        else
+          fragments[i].present = false;
       }
+
+    delete [] this->fragments_;
+    this->fragments_ = fragments;
+    this->fragments_size_ = new_size;
+    return true;
   }
 
   int
   UIPMC_Recv_Packet::add_fragment (char *data,
                                    CORBA::UShort len,
                                    CORBA::ULong id,
-                                   bool is_last)
+                                   bool is_last,
+                                   CORBA::ULong count)
   {
-    Fragment new_data;
-    ACE_NEW_RETURN (new_data.buf,
-                    char[len],
-                    -1);
-    ACE_OS::memcpy (new_data.buf, data, len);
-    new_data.len = len;
+    // A broken packet waits for the cleanup strategy.
+    if (this->started_ == ACE_Time_Value::zero)
+      return -1;
+
+    bool const first = this->fragment_count_ == 0;
+
+    // Size the slab for the whole packet from the first fragment, the
+    // fragments a sender splits a message into all have the length
+    // of the first one but for the last.
+    size_t wanted = this->data_length_ + len;
+    if (first && count > 1 && !is_last)
+      {
+        size_t const whole = static_cast<size_t> (count) * len;
+        size_t const limit = 16 * MIOP_MAX_DGRAM_SIZE;
+        wanted = whole < limit ? whole : limit;
+        if (wanted < len)
+          wanted = len;
+      }
+
+    bool valid =
+      id < MIOP_MAX_RECV_FRAGMENTS
+      && count <= MIOP_MAX_RECV_FRAGMENTS
+      && (count == 0 || id < count)
+      && (!this->has_last_ || id < this->last_fragment_id_);
+
+    // No fragment may follow the last one.
+    if (valid && is_last)
+      for (CORBA::ULong i = id + 1; valid && i < this->fragments_size_; ++i)
+        valid = !this->fragments_[i].present;
+
+    if (!valid
+        || !this->reserve_fragments (id + 1 > count ? id + 1 : count)
+        || this->fragments_[id].present
+        || !this->reserve_data (wanted))
+      {
+        // We've failed to add a new fragment. It's an error no matter
+        // what was the reason. Mark the packet as expired.
+        this->started_ = ACE_Time_Value::zero;
+        return -1;
+      }
+
+    Fragment &f = this->fragments_[id];
+    f.offset = this->data_length_;
+    f.len = len;
+    f.present = true;
+    ACE_OS::memcpy (this->data_ + this->data_length_, data, len);
+
+    if (id != this->fragment_count_)
+      this->in_order_ = false;
+    ++this->fragment_count_;
 
     if (is_last)
-      this->last_fragment_id_ = id;
+      {
+        this->last_fragment_id_ = id;
+        this->has_last_ = true;
+      }
 
     this->data_length_ += len;
 
@@ -65,36 +191,13 @@ namespace TAO_PG
                   len,
                   this->data_length_));
 
-    if (this->fragments_.bind (id, new_data) != 0)
-      {
-        // We've failed to add a new fragment. It's an error no matter
-        // what was the reason. Mark the packet as expired.
-        this->started_ = ACE_Time_Value::zero;
-        delete [] new_data.buf;
-        return -1;
-      }
-
-    // We haven't encountered yet the last fragment.
-    if (!is_last && this->last_fragment_id_ == 0)
-      return 0;
-
-    // We haven't encountered yet all the fragments but the last one is
-    // already in.
-    if (this->last_fragment_id_ + 1 != this->fragments_.current_size ())
+    // Fragments are enumerated from 0 to last_fragment_id_ and
+    // duplicates or ids past the last one were refused above, so the
+    // count tells whether all are in.
+    if (!this->has_last_
+        || this->last_fragment_id_ + 1 != this->fragment_count_)
       return 0;
 
-    // Since fragments are enumerated from 0 to last_fragment_id_ this
-    // is the heaviest but the most reliable check for packet completeness.
-    for (CORBA::ULong id = 0; id <= this->last_fragment_id_; ++id)
-      {
-        if (this->fragments_.find (id) == -1)
-          {
-            // Mark the packet as if it timedout.
-            this->started_ = ACE_Time_Value::zero;
-            return 0;
-          }
-      }
-
     return 1;
   }
 
@@ -110,15 +213,32 @@ namespace TAO_PG
     return this->data_length_;
   }
 
+  char *
+  UIPMC_Recv_Packet::contiguous_data () const
+  {
+    return this->in_order_ ? this->data_ : 0;
+  }
+
+  size_t
+  UIPMC_Recv_Packet::capacity () const
+  {
+    return this->slab_size_;
+  }
+
   void
   UIPMC_Recv_Packet::copy_data (char *buf) const
   {
+    if (this->in_order_)
+      {
+        ACE_OS::memcpy (buf, this->data_, this->data_length_);
+        return;
+      }
+
     for (CORBA::ULong id = 0; id <= this->last_fragment_id_; ++id)
       {
-        Fragment f = { 0, 0 };
-        this->fragments_.find (id, f);
+        Fragment const &f = this->fragments_[id];
 
-        ACE_OS::memcpy (buf, f.buf, f.len);
+        ACE_OS::memcpy (buf, this->data_ + f.offset, f.len);
         buf += f.len;
       }
   }
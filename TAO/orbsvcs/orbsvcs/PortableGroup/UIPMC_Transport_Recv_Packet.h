@@ -18,6 +18,8 @@
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
+#include "orbsvcs/PortableGroup/portablegroup_export.h"
+
 #include "tao/Versioned_Namespace.h"
 #include "tao/corba.h"
 
@@ -46,8 +48,16 @@ namespace TAO_PG
    * @class UIPMC_Recv_Packet
    *
    * @brief A MIOP packet for receiving.
+   *
+   * The data of the fragments is copied, in the order they arrive,
+   * into a single slab that is sized from the number of fragments
+   * announced in the MIOP header.  When the fragments arrive in order
+   * the slab holds the whole message and can be handed to the GIOP
+   * parser without any further copy.  A packet can be reset() and
+   * reused for another message, keeping its slab, so reassembly does
+   * not allocate once the transport's pool of packets is warm.
    */
-  class UIPMC_Recv_Packet
+  class TAO_PortableGroup_Export UIPMC_Recv_Packet
   {
   public:
     /// Constructs a new recv packet.
@@ -55,13 +65,20 @@ namespace TAO_PG
 
     ~UIPMC_Recv_Packet ();
 
+    /// Forget all fragments and restart the expiry time, keeping the
+    /// storage for the next message.
+    void reset ();
+
     /// Adds a new fragment to the packet and if it fails marks the packet
     /// as broken.
     /// Returns 1 if all fragments are in AND if there are no fragments
     /// with unexpected IDs. In case unexpected IDs are encountered the
     /// packet is marked as broken.
+    /// @a count is the number of fragments of the packet from the MIOP
+    /// header, zero if the sender didn't say.
     int add_fragment (char *data, CORBA::UShort len,
-                      CORBA::ULong id, bool is_last);
+                      CORBA::ULong id, bool is_last,
+                      CORBA::ULong count = 0);
 
     /// Returns the time when the first fragment was received or
     /// ACE_Time_Value::zero if the whole packet was not able to
@@ -70,31 +87,63 @@ namespace TAO_PG
 
     CORBA::ULong data_length () const;
 
+    /// Returns the data of the whole packet, aligned on an 8 byte
+    /// boundary, if the fragments arrived in order, otherwise 0.
+    char *contiguous_data () const;
+
+    /// Bytes of storage that contiguous_data() is in.
+    size_t capacity () const;
+
     /// Copies fragments to buf. Caller ensures that the buf is big enough
     /// for all fragments.
     void copy_data (char *buf) const;
 
   private:
+    UIPMC_Recv_Packet (const UIPMC_Recv_Packet &);
+    UIPMC_Recv_Packet &operator= (const UIPMC_Recv_Packet &);
+
+    /// Make room for @a size bytes of data.
+    bool reserve_data (size_t size);
+
+    /// Make room for fragments with ids up to @a count - 1.
+    bool reserve_fragments (CORBA::ULong count);
+
     /// The id of the last fragment.
     CORBA::ULong last_fragment_id_;
 
+    /// Has the last fragment been received?
+    bool has_last_;
+
     /// The length of the data stored in all fragments.
     CORBA::ULong data_length_;
 
     /// The time when the packet will expire.
     mutable ACE_Time_Value started_;
 
-    /// Fragments.
+    /// Where a fragment is in the slab.
     struct Fragment
     {
-      char *buf;
+      CORBA::ULong offset;
       CORBA::UShort len;
+      bool present;
     };
 
-    typedef ACE_Hash_Map_Manager<CORBA::ULong,
-                                 Fragment,
-                                 ACE_SYNCH_NULL_MUTEX> Fragments_Map;
-    Fragments_Map fragments_;
+    /// Fragments indexed by their id.
+    Fragment *fragments_;
+
+    /// Number of entries in <fragments_>.
+    CORBA::ULong fragments_size_;
+
+    /// Number of fragments received.
+    CORBA::ULong fragment_count_;
+
+    /// Did every fragment so far arrive in the order of its id?
+    bool in_order_;
+
+    /// Storage for the data, <data_> is its first aligned byte.
+    char *slab_;
+    char *data_;
+    size_t slab_size_;
   };
 } // namespace TAO_PG
 
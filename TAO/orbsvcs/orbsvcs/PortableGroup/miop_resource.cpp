@@ -5,6 +5,7 @@
 
 #include "tao/debug.h"
 
+#include "ace/OS_NS_stdlib.h"
 #include "ace/OS_NS_strings.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -19,6 +20,9 @@ TAO_MIOP_Resource_Factory::TAO_MIOP_Resource_Factory ()
   , send_hi_water_mark_  (0u) // Zero sets this to actual -ORBSndSock
   , send_buffer_size_    (0u) // Zero is unspecified (-ORBSndSock).
   , receive_buffer_size_ (0u) // Zero is unspecified (-ORBRcvSock).
+  , send_pacing_rate_    (TAO_DEFAULT_MIOP_SEND_PACING_RATE) // Zero is unpaced.
+  , send_pacing_burst_   (0u) // Zero uses max_fragment_size_ instead.
+  , receive_batch_       (TAO_DEFAULT_MIOP_RECEIVE_BATCH)
   , enable_throttling_    (!!(TAO_DEFAULT_MIOP_SEND_THROTTLING))  // Client-side SendRate throttling enabled.
   , enable_eager_dequeue_ (!!(TAO_DEFAULT_MIOP_EAGER_DEQUEUEING)) // Server-side Multiple message dequeueing.
 {
@@ -236,6 +240,78 @@ TAO_MIOP_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
                         ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
                         ACE_TEXT ("-ORBRcvSock missing size in bytes.\n")));
         }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-ORBSendPacingRate")) == 0)
+        {
+          if (++curarg < argc)
+            {
+              ACE_TCHAR *end = 0;
+              ACE_UINT64 const rate =
+                ACE_OS::strtoull (argv[curarg], &end, 10);
+              if (end == argv[curarg] || *end != 0)
+                {
+                  ORBSVCS_DEBUG ((LM_ERROR,
+                              ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
+                              ACE_TEXT ("-ORBSendPacingRate %s is invalid ")
+                              ACE_TEXT ("(not pacing).\n"),
+                              argv[curarg]));
+                  this->send_pacing_rate_= 0u; // Zero is unpaced
+                }
+              else
+                this->send_pacing_rate_= rate;
+            }
+          else
+            ORBSVCS_DEBUG ((LM_ERROR,
+                        ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
+                        ACE_TEXT ("-ORBSendPacingRate missing bytes per second.\n")));
+        }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-ORBSendPacingBurst")) == 0)
+        {
+          if (++curarg < argc)
+            {
+              int const bytes= ACE_OS::atoi (argv[curarg]);
+              if (bytes <= 0)
+                {
+                  ORBSVCS_DEBUG ((LM_ERROR,
+                              ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
+                              ACE_TEXT ("-ORBSendPacingBurst %d is invalid ")
+                              ACE_TEXT ("(using -ORBMaxFragmentSize).\n"),
+                              bytes));
+                  this->send_pacing_burst_= 0u; // Zero uses max_fragment_size_
+                }
+              else
+                this->send_pacing_burst_= static_cast<u_long> (bytes);
+            }
+          else
+            ORBSVCS_DEBUG ((LM_ERROR,
+                        ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
+                        ACE_TEXT ("-ORBSendPacingBurst missing size in bytes.\n")));
+        }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-ORBReceiveBatch")) == 0)
+        {
+          if (++curarg < argc)
+            {
+              int const count= ACE_OS::atoi (argv[curarg]);
+              if (count <= 0 || count > 1024)
+                {
+                  ORBSVCS_DEBUG ((LM_ERROR,
+                              ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
+                              ACE_TEXT ("-ORBReceiveBatch %d is not within ")
+                              ACE_TEXT ("range 1 to 1024 (using %u).\n"),
+                              count,
+                              TAO_DEFAULT_MIOP_RECEIVE_BATCH));
+                  this->receive_batch_= TAO_DEFAULT_MIOP_RECEIVE_BATCH;
+                }
+              else
+                this->receive_batch_= static_cast<u_long> (count);
+            }
+          else
+            ORBSVCS_DEBUG ((LM_ERROR,
+                        ACE_TEXT ("TAO (%P|%t) - MIOP_Resource_Factory ")
+                        ACE_TEXT ("-ORBReceiveBatch missing number of datagrams.\n")));
+        }
       else if (ACE_OS::strcasecmp (argv[curarg],
                                    ACE_TEXT ("-ORBSendThrottling")) == 0 ||
                ACE_OS::strcasecmp (argv[curarg],
@@ -369,6 +445,28 @@ TAO_MIOP_Resource_Factory::receive_buffer_size () const
   return receive_buffer_size_;
 }
 
+ACE_UINT64
+TAO_MIOP_Resource_Factory::send_pacing_rate () const
+{
+  return this->send_pacing_rate_;
+}
+
+u_long
+TAO_MIOP_Resource_Factory::send_pacing_burst () const
+{
+  // If "send_pacing_burst_" is not specified (i.e. zero)
+  // allow a single fragment of the maximum size.
+  return this->send_pacing_burst_ ?
+         this->send_pacing_burst_ :
+         this->max_fragment_size_ ;
+}
+
+u_long
+TAO_MIOP_Resource_Factory::receive_batch () const
+{
+  return this->receive_batch_;
+}
+
 bool
 TAO_MIOP_Resource_Factory::enable_throttling () const
 {
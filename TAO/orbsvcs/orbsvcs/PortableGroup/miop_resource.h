@@ -85,6 +85,15 @@ public:
 
   /// Get the desired socket receive buffer's size in bytes (Zero is unspecified).
   u_long receive_buffer_size () const;
+
+  /// Get the rate in bytes per second fragments are paced to (Zero is unpaced).
+  ACE_UINT64 send_pacing_rate () const;
+
+  /// Get number of bytes that can be sent back to back when paced.
+  u_long send_pacing_burst () const;
+
+  /// Get the largest number of datagrams read from the socket at once.
+  u_long receive_batch () const;
   //@}
 
   /// Get the client-side transmission rate throttling enable flag.
@@ -125,6 +134,15 @@ private:
   /// Get the desired socket receive buffer's size in bytes.
   u_long receive_buffer_size_;
 
+  /// Rate in bytes per second fragments are paced to.
+  ACE_UINT64 send_pacing_rate_;
+
+  /// Number of bytes that can be sent back to back when paced.
+  u_long send_pacing_burst_;
+
+  /// Largest number of datagrams read from the socket at once.
+  u_long receive_batch_;
+
   /// Get the client-side transmission rate throttling enable flag.
   bool enable_throttling_;
 
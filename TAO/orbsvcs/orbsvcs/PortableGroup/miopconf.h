@@ -104,6 +104,20 @@ static bool const TAO_DEFAULT_MIOP_SEND_THROTTLING = true; // Enabled
 static bool const TAO_DEFAULT_MIOP_EAGER_DEQUEUEING = true; // Enabled
 #endif
 
+// Default rate in bytes per second the client paces its fragments to.
+#if !defined (TAO_DEFAULT_MIOP_SEND_PACING_RATE)
+static u_long const TAO_DEFAULT_MIOP_SEND_PACING_RATE = 0u; // Zero is unpaced
+#endif
+
+// Default number of datagrams the server reads from its socket with a
+// single system call, where recvmmsg() is available.
+#if !defined (TAO_DEFAULT_MIOP_RECEIVE_BATCH)
+static u_long const TAO_DEFAULT_MIOP_RECEIVE_BATCH = 8u;
+#endif
+
+// Largest number of fragments a received MIOP message may consist of.
+static u_long const MIOP_MAX_RECV_FRAGMENTS = 65536u;
+
 static CORBA::Octet const miop_magic[4] = {
   0x4d, 0x49, 0x4f, 0x50
 }; // in ASCII this is 'M', 'I', 'O', 'P'
@@ -9,6 +9,7 @@
 #include "ace/OS_NS_stdio.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_stdlib.h"
 #if defined (ACE_WIN32)
 # include <conio.h>
 #elif defined (ACE_HAS_TERMIOS)
@@ -557,6 +558,92 @@ TAO::SSLIOP::Protocol_Factory::init (int argc, ACE_TCHAR* argv[])
               ec_name = static_cast<const char *>(ACE_TEXT_ALWAYS_CHAR(argv[curarg]));
             }
         }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-SSLSessionCache")) == 0)
+        {
+          ++curarg;
+          if (curarg < argc)
+            {
+              long mode = SSL_SESS_CACHE_OFF;
+              if (ACE_OS::strcasecmp (argv[curarg], ACE_TEXT ("NONE")) == 0)
+                {
+                  mode = SSL_SESS_CACHE_OFF;
+                }
+              else if (ACE_OS::strcasecmp (argv[curarg], ACE_TEXT ("SERVER")) == 0)
+                {
+                  mode = SSL_SESS_CACHE_SERVER;
+                }
+              else if (ACE_OS::strcasecmp (argv[curarg], ACE_TEXT ("CLIENT")) == 0)
+                {
+                  mode = SSL_SESS_CACHE_CLIENT;
+                }
+              else if (ACE_OS::strcasecmp (argv[curarg],
+                                           ACE_TEXT ("SERVER_AND_CLIENT")) == 0)
+                {
+                  mode = SSL_SESS_CACHE_BOTH;
+                }
+              else
+                ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                       "ERROR: Invalid -SSLSessionCache "
+                                       "value: %s.\n",
+                                       argv[curarg]),
+                                      -1);
+
+              ssl_ctx->session_cache_mode (mode);
+            }
+        }
+
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-SSLSessionCacheSize")) == 0)
+        {
+          ++curarg;
+          if (curarg < argc)
+            {
+              long const size = ACE_OS::strtol (argv[curarg], 0, 10);
+              if (size < 0)
+                ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                       "ERROR: Invalid -SSLSessionCacheSize "
+                                       "value: %s.\n",
+                                       argv[curarg]),
+                                      -1);
+
+              ssl_ctx->session_cache_size (size);
+            }
+        }
+
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-SSLSessionTimeout")) == 0)
+        {
+          ++curarg;
+          if (curarg < argc)
+            {
+              long const seconds = ACE_OS::strtol (argv[curarg], 0, 10);
+              if (seconds <= 0)
+                ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                       "ERROR: Invalid -SSLSessionTimeout "
+                                       "value: %s.\n",
+                                       argv[curarg]),
+                                      -1);
+
+              ssl_ctx->session_timeout (seconds);
+            }
+        }
+
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-SSLNoSessionTickets")) == 0)
+        {
+          ssl_ctx->session_tickets (false);
+        }
+
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT ("-SSLKTLS")) == 0)
+        {
+          if (ssl_ctx->ktls (true) != 0 && TAO_debug_level > 0)
+            ORBSVCS_DEBUG ((LM_WARNING,
+                            ACE_TEXT ("TAO (%P|%t) - SSLIOP_Factory::init, ")
+                            ACE_TEXT ("kernel TLS is not supported by this ")
+                            ACE_TEXT ("build, -SSLKTLS is ignored\n")));
+        }
     }
 
   if (pem_passwd_.length() > 0)
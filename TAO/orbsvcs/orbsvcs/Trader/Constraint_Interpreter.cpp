@@ -2,8 +2,104 @@
 #include "orbsvcs/Trader/Trader_Constraint_Visitors.h"
 #include "orbsvcs/Trader/Constraint_Tokens.h"
 
+#include <utility>
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+namespace
+{
+  /// Mirror a comparison, for the literal on the left hand side.
+  TAO_Expression_Type
+  mirror_operator (TAO_Expression_Type op)
+  {
+    switch (op)
+      {
+      case TAO_LT: return TAO_GT;
+      case TAO_LE: return TAO_GE;
+      case TAO_GT: return TAO_LT;
+      case TAO_GE: return TAO_LE;
+      default: return op;
+      }
+  }
+
+  /// Extract a numeric or string literal, possibly negated.
+  bool
+  index_literal (TAO_Constraint* node, TAO_Literal_Constraint& literal)
+  {
+    bool negate = false;
+    if (node->expr_type () == TAO_UMINUS)
+      {
+        node = static_cast<TAO_Unary_Constraint*> (node)->operand ();
+        negate = true;
+      }
+
+    switch (node->expr_type ())
+      {
+      case TAO_SIGNED:
+      case TAO_UNSIGNED:
+      case TAO_DOUBLE:
+        break;
+      case TAO_STRING:
+        if (negate)
+          return false;
+        break;
+      default:
+        return false;
+      }
+
+    TAO_Literal_Constraint* value = static_cast<TAO_Literal_Constraint*> (node);
+    if (negate)
+      literal = -(*value);
+    else
+      literal = *value;
+
+    return true;
+  }
+
+  void
+  collect_predicates (TAO_Constraint* node, TAO_Index_Predicates& predicates)
+  {
+    TAO_Expression_Type const op = node->expr_type ();
+
+    if (op == TAO_AND)
+      {
+        TAO_Binary_Constraint* conjunction =
+          static_cast<TAO_Binary_Constraint*> (node);
+        collect_predicates (conjunction->left_operand (), predicates);
+        collect_predicates (conjunction->right_operand (), predicates);
+        return;
+      }
+
+    if (op != TAO_EQ && op != TAO_LT && op != TAO_LE
+        && op != TAO_GT && op != TAO_GE)
+      return;
+
+    TAO_Binary_Constraint* comparison =
+      static_cast<TAO_Binary_Constraint*> (node);
+    TAO_Constraint* property = comparison->left_operand ();
+    TAO_Constraint* value = comparison->right_operand ();
+    TAO_Expression_Type predicate_op = op;
+
+    if (property->expr_type () != TAO_IDENT)
+      {
+        std::swap (property, value);
+        predicate_op = mirror_operator (op);
+      }
+
+    if (property->expr_type () != TAO_IDENT)
+      return;
+
+    TAO_Index_Predicate predicate;
+    if (! index_literal (value, predicate.value_))
+      return;
+
+    predicate.property_ =
+      static_cast<TAO_Property_Constraint*> (property)->name ();
+    predicate.op_ = predicate_op;
+    predicates.push_back (predicate);
+  }
+}
+
 TAO_Constraint_Interpreter::TAO_Constraint_Interpreter (
     const CosTradingRepos::ServiceTypeRepository::TypeStruct& ts,
     const char* constraints
@@ -68,6 +164,16 @@ TAO_Constraint_Interpreter::evaluate (TAO_Constraint_Evaluator& evaluator)
   return evaluator.evaluate_constraint (this->root_);
 }
 
+void
+TAO_Constraint_Interpreter::
+index_predicates (TAO_Index_Predicates& predicates) const
+{
+  if (this->root_ != 0 && this->root_->expr_type () == TAO_CONSTRAINT)
+    collect_predicates (
+      static_cast<TAO_Unary_Constraint*> (this->root_)->operand (),
+      predicates);
+}
+
 TAO_Preference_Interpreter::TAO_Preference_Interpreter (
     const CosTradingRepos::ServiceTypeRepository::TypeStruct& ts,
     const char* preference)
@@ -145,40 +251,56 @@ order_offer (TAO_Constraint_Evaluator& evaluator,
           // correct place in the queue.
           TAO_Expression_Type expr_type = this->root_->expr_type ();
 
+          // An offer that does not beat the current last one goes
+          // straight to the end, which is always the case when the
+          // offers come in preference order.
+          bool const min_max = expr_type == TAO_MIN || expr_type == TAO_MAX;
+          bool const append =
+            min_max
+            && (this->offers_.is_empty ()
+                || (expr_type == TAO_MIN
+                    && pref_info.value_ >= this->tail_value_)
+                || (expr_type == TAO_MAX
+                    && pref_info.value_ <= this->tail_value_));
+
           if (expr_type == TAO_FIRST
+              || append
               || (expr_type == TAO_WITH
                   && ! static_cast<CORBA::Boolean> (pref_info.value_)))
             this->offers_.enqueue_tail (pref_info);
           else
             this->offers_.enqueue_head (pref_info);
 
-          if (expr_type == TAO_MIN || expr_type == TAO_MAX)
+          if (append)
+            this->tail_value_ = pref_info.value_;
+          else if (min_max)
             {
               Ordered_Offers::ITERATOR offer_iter (this->offers_);
 
               // Push the new item down the list until the min/max
-              // criterion is satisfied. Observe the evaluation failed
-              // / evaluation suceeded partion in the list.
+              // criterion is satisfied.  The items are swapped in
+              // place, Ordered_Offers::set() walks the whole list.
+              Preference_Info* previous_offer = 0;
+              offer_iter.next (previous_offer);
               offer_iter.advance ();
 
-              for (int i = 1;
+              for (;
                    offer_iter.done () == 0;
-                   offer_iter.advance (), i++)
+                   offer_iter.advance ())
                 {
                   Preference_Info* current_offer = 0;
                   offer_iter.next (current_offer);
 
-                  // Maintain the sorted order in the first partition.
-                  if (current_offer->evaluated_ == 1
-                      && ((expr_type == TAO_MIN
-                        && pref_info.value_ > current_offer->value_)
-                       || (expr_type == TAO_MAX
-                           && pref_info.value_ < current_offer->value_)))
+                  // Maintain the sorted order.
+                  if ((expr_type == TAO_MIN
+                       && pref_info.value_ > current_offer->value_)
+                      || (expr_type == TAO_MAX
+                          && pref_info.value_ < current_offer->value_))
                     {
                       // Swap the out of order pair
-                      this->offers_.set (*current_offer,
-                                         i - 1);
-                      this->offers_.set (pref_info, i);
+                      *previous_offer = *current_offer;
+                      *current_offer = pref_info;
+                      previous_offer = current_offer;
                     }
                   else
                     break;
@@ -188,9 +310,9 @@ order_offer (TAO_Constraint_Evaluator& evaluator,
       else
         {
           // If the evaluation fails, just tack the sucker onto the
-          // end of the queue.
+          // end of the failed ones.
           pref_info.evaluated_ = 0;
-          this->offers_.enqueue_tail (pref_info);
+          this->failed_offers_.enqueue_tail (pref_info);
         }
     }
 }
@@ -205,6 +327,9 @@ remove_offer (CosTrading::Offer*& offer,
 
   return_value = this->offers_.dequeue_head (pref_info);
 
+  if (return_value != 0)
+    return_value = this->failed_offers_.dequeue_head (pref_info);
+
   if (return_value == 0)
     {
       offer = pref_info.offer_;
@@ -226,7 +351,26 @@ remove_offer (CosTrading::Offer*& offer)
 size_t
 TAO_Preference_Interpreter::num_offers ()
 {
-  return this->offers_.size ();
+  return this->offers_.size () + this->failed_offers_.size ();
+}
+
+const char*
+TAO_Preference_Interpreter::index_property (bool& descending) const
+{
+  if (this->root_ == 0)
+    return 0;
+
+  TAO_Expression_Type const expr_type = this->root_->expr_type ();
+  if (expr_type != TAO_MIN && expr_type != TAO_MAX)
+    return 0;
+
+  TAO_Constraint* operand =
+    static_cast<TAO_Unary_Constraint*> (this->root_)->operand ();
+  if (operand->expr_type () != TAO_IDENT)
+    return 0;
+
+  descending = expr_type == TAO_MAX;
+  return static_cast<TAO_Property_Constraint*> (operand)->name ();
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
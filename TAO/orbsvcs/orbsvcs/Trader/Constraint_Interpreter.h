@@ -15,6 +15,7 @@
 #include "orbsvcs/Trader/Constraint_Nodes.h"
 #include "orbsvcs/Trader/Constraint_Visitors.h"
 #include "orbsvcs/Trader/Interpreter.h"
+#include "orbsvcs/Trader/Offer_Index.h"
 
 #include "orbsvcs/CosTradingS.h"
 #include "orbsvcs/CosTradingReposS.h"
@@ -64,6 +65,15 @@ public:
 
   // Determine whether an offer fits the constraints with which the
   // tree was constructed. This method is thread safe (hopefully).
+
+  /**
+   * Append to @a predicates the top level conjuncts of the constraint
+   * that compare a property with a literal, the ones an offer index
+   * can answer.  An offer that satisfies the constraint satisfies all
+   * of them, so they can be used to discard offers before evaluating
+   * the whole constraint.
+   */
+  void index_predicates (TAO_Index_Predicates& predicates) const;
 };
 
 /**
@@ -116,6 +126,14 @@ public:
   /// Return the number of offers remaining in the ordering.
   size_t num_offers ();
 
+  /**
+   * If the preference is "min <property>" or "max <property>" return
+   * the name of the property, and set @a descending for max.  Feeding
+   * the offers in that order makes order_offer() constant time.
+   * Returns 0 for any other preference.
+   */
+  const char* index_property (bool& descending) const;
+
   struct Preference_Info
   {
     /// True if the preference evaluation didn't return an error for this offer.
@@ -141,6 +159,14 @@ private:
 
   /// The ordered list of offers.
   Ordered_Offers offers_;
+
+  /// The offers whose preference failed to evaluate, they follow the
+  /// ones in <offers_>.
+  Ordered_Offers failed_offers_;
+
+  /// The value of the last offer in <offers_>, so min and max can
+  /// append an offer without walking the queue.
+  TAO_Literal_Constraint tail_value_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
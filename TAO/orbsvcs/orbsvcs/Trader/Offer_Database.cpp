@@ -85,6 +85,7 @@ insert_offer (const char* type, CosTrading::Offer* offer)
   // Add the offer to the service offer table for this service type.
   offer_map_entry->offer_map_->bind (offer_map_entry->counter_,
                                      offer);
+  offer_map_entry->indexes_.insert (offer_map_entry->counter_, *offer);
   return_value = this->generate_offer_id (type,
                                           offer_map_entry->counter_);
   offer_map_entry->counter_++;
@@ -111,6 +112,7 @@ remove_offer (const char* type, CORBA::ULong id)
         return -1;
 
       return_value = offer_map_entry->offer_map_->unbind (id, offer);
+      offer_map_entry->indexes_.remove (id);
       delete offer;
 
       // If the service type has no more offers, free the map, lest
@@ -196,6 +198,31 @@ lookup_offer (const CosTrading::OfferId offer_id)
   return offer;
 }
 
+template <class LOCK_TYPE> void
+TAO_Offer_Database<LOCK_TYPE>::
+reindex_offer (const CosTrading::OfferId offer_id)
+{
+  char* type_name = 0;
+  CORBA::ULong id;
+  this->parse_offer_id (offer_id, type_name, id);
+
+  ACE_READ_GUARD (LOCK_TYPE, ace_mon, this->db_lock_);
+
+  typename Offer_Database::ENTRY* db_entry = 0;
+  CORBA::String_var service_type (static_cast<const char*> (type_name));
+
+  if (this->offer_db_.find (service_type, db_entry) == 0)
+    {
+      Offer_Map_Entry* offer_map_entry = db_entry->int_id_;
+      ACE_WRITE_GUARD (LOCK_TYPE, ace_mon2, offer_map_entry->lock_);
+
+      // TAO_Offer_Indexes::insert() drops the stale entries first.
+      TAO_Offer_Map::ENTRY* offer_entry_ptr = 0;
+      if (offer_map_entry->offer_map_->find (id, offer_entry_ptr) == 0)
+        offer_map_entry->indexes_.insert (id, *offer_entry_ptr->int_id_);
+    }
+}
+
 template <class LOCK_TYPE> CosTrading::Offer*
 TAO_Offer_Database<LOCK_TYPE>::
 lookup_offer (const char* type, CORBA::ULong id)
@@ -367,6 +394,257 @@ TAO_Service_Offer_Iterator<LOCK_TYPE>::next_offer ()
     this->offer_iter_->advance ();
 }
 
+template <class LOCK_TYPE>
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::
+TAO_Indexed_Offer_Iterator (const char* type,
+                            TAO_Offer_Database<LOCK_TYPE>& offer_database,
+                            const TAO_Index_Predicates& predicates,
+                            const char* preference_property,
+                            bool descending)
+  : stm_ (offer_database),
+    lock_ (0),
+    offer_map_ (0),
+    offer_iter_ (0),
+    current_ (0),
+    offer_ (0),
+    type_ (type)
+{
+  CORBA::String_var service_type (type);
+
+  if (this->stm_.db_lock_.acquire_read () == -1)
+    return;
+
+  typename TAO_Offer_Database<LOCK_TYPE>::Offer_Map_Entry* entry = 0;
+  if (this->stm_.offer_db_.find (service_type, entry) == -1)
+    return;
+
+  this->update_indexes (entry, predicates, preference_property);
+
+  if (entry->lock_.acquire_read () == -1)
+    return;
+
+  this->lock_ = &entry->lock_;
+  this->offer_map_ = entry->offer_map_;
+
+  if (this->plan (entry->indexes_,
+                  predicates,
+                  preference_property,
+                  descending))
+    this->settle ();
+  else
+    ACE_NEW (offer_iter_,
+             TAO_Offer_Map::iterator (*this->offer_map_));
+}
+
+template <class LOCK_TYPE>
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::~TAO_Indexed_Offer_Iterator ()
+{
+  this->stm_.db_lock_.release ();
+
+  if (this->lock_ != 0)
+    {
+      this->lock_->release ();
+      delete this->offer_iter_;
+    }
+}
+
+template <class LOCK_TYPE> void
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::
+update_indexes (typename TAO_Offer_Database<LOCK_TYPE>::Offer_Map_Entry* entry,
+                const TAO_Index_Predicates& predicates,
+                const char* preference_property)
+{
+  TAO_Offer_Indexes& indexes = entry->indexes_;
+  bool build = false;
+
+  {
+    ACE_READ_GUARD (LOCK_TYPE, ace_mon, entry->lock_);
+
+    for (TAO_Index_Predicates::const_iterator i = predicates.begin ();
+         i != predicates.end ();
+         ++i)
+      {
+        if (indexes.find (i->property_.in ()) == 0
+            && indexes.record_use (i->property_.in ()))
+          build = true;
+      }
+
+    if (preference_property != 0
+        && indexes.find (preference_property) == 0
+        && indexes.record_use (preference_property))
+      build = true;
+  }
+
+  if (!build)
+    return;
+
+  // Once the use count has reached the threshold record_use() keeps
+  // returning true, so the same test selects the indexes to build.
+  ACE_WRITE_GUARD (LOCK_TYPE, ace_mon, entry->lock_);
+
+  for (TAO_Index_Predicates::const_iterator i = predicates.begin ();
+       i != predicates.end ();
+       ++i)
+    {
+      if (indexes.find (i->property_.in ()) == 0
+          && indexes.record_use (i->property_.in ()))
+        indexes.create (i->property_.in (), *entry->offer_map_);
+    }
+
+  if (preference_property != 0
+      && indexes.find (preference_property) == 0
+      && indexes.record_use (preference_property))
+    indexes.create (preference_property, *entry->offer_map_);
+}
+
+template <class LOCK_TYPE> bool
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::
+plan (TAO_Offer_Indexes& indexes,
+      const TAO_Index_Predicates& predicates,
+      const char* preference_property,
+      bool descending)
+{
+  TAO_Offer_Index* best = 0;
+  TAO_Offer_Index::Range best_range;
+  size_t best_count = 0;
+
+  for (TAO_Index_Predicates::const_iterator i = predicates.begin ();
+       i != predicates.end ();
+       ++i)
+    {
+      const char* property = i->property_.in ();
+      TAO_Offer_Index* index = indexes.find (property);
+      if (index == 0)
+        continue;
+
+      // All the predicates on a property are combined the first time
+      // the property shows up.
+      bool seen = false;
+      for (TAO_Index_Predicates::const_iterator j = predicates.begin ();
+           j != i && !seen;
+           ++j)
+        seen = ACE_OS::strcmp (j->property_.in (), property) == 0;
+      if (seen)
+        continue;
+
+      TAO_Offer_Index::Range range;
+      bool restricted = false;
+      for (TAO_Index_Predicates::const_iterator j = i;
+           j != predicates.end ();
+           ++j)
+        {
+          if (ACE_OS::strcmp (j->property_.in (), property) == 0
+              && index->restrict (range, *j))
+            restricted = true;
+        }
+
+      if (!restricted)
+        continue;
+
+      size_t const count = index->count (range);
+      bool const preferred =
+        preference_property != 0
+        && ACE_OS::strcmp (preference_property, property) == 0;
+
+      if (best == 0
+          || count < best_count
+          || (count == best_count && preferred))
+        {
+          best = index;
+          best_range = range;
+          best_count = count;
+        }
+    }
+
+  TAO_Offer_Index* const preference_index =
+    preference_property != 0 ? indexes.find (preference_property) : 0;
+
+  // Walking most of the offers through an index costs more than
+  // iterating over the map, unless the index order is useful.
+  if (best != 0
+      && best != preference_index
+      && best_count > this->offer_map_->current_size () / 2)
+    best = 0;
+
+  if (best != 0)
+    {
+      best->lookup (best_range,
+                    best == preference_index && descending,
+                    this->ids_);
+      return true;
+    }
+
+  if (preference_index != 0)
+    {
+      preference_index->lookup (TAO_Offer_Index::Range (),
+                                descending,
+                                this->ids_);
+      return true;
+    }
+
+  return false;
+}
+
+template <class LOCK_TYPE> void
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::settle ()
+{
+  this->offer_ = 0;
+
+  for (; this->current_ < this->ids_.size (); ++this->current_)
+    {
+      TAO_Offer_Map::ENTRY* entry = 0;
+      if (this->offer_map_->find (this->ids_[this->current_], entry) == 0)
+        {
+          this->offer_ = entry->int_id_;
+          break;
+        }
+    }
+}
+
+template <class LOCK_TYPE> bool
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::indexed () const
+{
+  return this->offer_map_ != 0 && this->offer_iter_ == 0;
+}
+
+template <class LOCK_TYPE> CosTrading::OfferId
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::get_id ()
+{
+  if (this->offer_iter_ != 0)
+    return TAO_Offer_Database<LOCK_TYPE>::generate_offer_id (this->type_, (**this->offer_iter_).ext_id_);
+
+  return (this->offer_ != 0)
+    ? TAO_Offer_Database<LOCK_TYPE>::generate_offer_id (this->type_, this->ids_[this->current_])
+    : 0;
+}
+
+template <class LOCK_TYPE> int
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::has_more_offers ()
+{
+  if (this->offer_iter_ != 0)
+    return ! this->offer_iter_->done ();
+
+  return this->offer_ != 0;
+}
+
+template <class LOCK_TYPE> CosTrading::Offer*
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::get_offer ()
+{
+  return (this->offer_iter_ != 0) ? (**this->offer_iter_).int_id_ : this->offer_;
+}
+
+template <class LOCK_TYPE> void
+TAO_Indexed_Offer_Iterator<LOCK_TYPE>::next_offer ()
+{
+  if (this->offer_iter_ != 0)
+    this->offer_iter_->advance ();
+  else if (this->offer_ != 0)
+    {
+      ++this->current_;
+      this->settle ();
+    }
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
 
 #endif /* TAO_OFFER_DATABASE_CPP */
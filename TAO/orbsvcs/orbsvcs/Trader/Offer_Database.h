@@ -15,11 +15,13 @@
 
 #include "orbsvcs/Trader/Trader.h"
 #include "orbsvcs/Trader/Offer_Iterators.h"
+#include "orbsvcs/Trader/Offer_Index.h"
 #include "ace/Null_Mutex.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 template <class LOCK_TYPE> class TAO_Service_Offer_Iterator;
+template <class LOCK_TYPE> class TAO_Indexed_Offer_Iterator;
 
 /**
  * @class TAO_Offer_Database
@@ -44,14 +46,20 @@ template <class LOCK_TYPE> class TAO_Service_Offer_Iterator;
  * simple binary mutex! Mutexes will cause deadlock when you try to
  * contruct an iterator (which acquires a read lock on the map under
  * an existing read lock). Just don't do it, ok?
+ *
+ * Each offer map also keeps secondary indexes on the properties
+ * that are frequently used by queries (see TAO_Offer_Indexes), which
+ * are maintained as offers are inserted, removed and modified.
  */
 template <class LOCK_TYPE>
 class TAO_Offer_Database
 {
   friend class TAO_Service_Offer_Iterator<LOCK_TYPE>;
+  friend class TAO_Indexed_Offer_Iterator<LOCK_TYPE>;
 public:
   // Traits
   typedef TAO_Service_Offer_Iterator<LOCK_TYPE> offer_iterator;
+  typedef TAO_Indexed_Offer_Iterator<LOCK_TYPE> indexed_offer_iterator;
 
   /// No arg constructor.
   TAO_Offer_Database ();
@@ -77,6 +85,10 @@ public:
   CosTrading::Offer* lookup_offer (const CosTrading::OfferId offer_id,
                                    char*& type_name);
 
+  /// The properties of the offer whose OfferId is @a offer_id have
+  /// been modified, bring the indexes up to date.
+  void reindex_offer (const CosTrading::OfferId offer_id);
+
   /// Return an iterator that will traverse and return all the offer
   /// ids in the service type map.
   TAO_Offer_Id_Iterator* retrieve_all_offer_ids ();
@@ -86,6 +98,7 @@ public:
     TAO_Offer_Map* offer_map_;
     CORBA::ULong counter_;
     LOCK_TYPE lock_;
+    TAO_Offer_Indexes indexes_;
   };
 
   typedef ACE_Hash_Map_Manager_Ex
@@ -183,6 +196,88 @@ public:
   const char* type_;
 };
 
+/**
+ * @class TAO_Indexed_Offer_Iterator
+ *
+ * @brief TAO_Indexed_Offer_Iterator iterates over the exported offers
+ * for a given type that may satisfy a set of predicates.
+ *
+ * The offers are narrowed down with the most selective of the
+ * indexes that can answer the predicates; the iterator still returns
+ * a superset of the matching offers, which have to be evaluated
+ * against the full constraint. If a preference property is given and
+ * indexed, the offers are returned in preference order whenever that
+ * index is the one used.  Without usable indexes all the offers of
+ * the type are returned, like TAO_Service_Offer_Iterator does.  The
+ * locks are acquired in the constructor, and released in the
+ * destructor.
+ */
+template <class LOCK_TYPE>
+class TAO_Indexed_Offer_Iterator
+{
+public:
+  TAO_Indexed_Offer_Iterator (const char* type,
+                              TAO_Offer_Database<LOCK_TYPE>& offer_database,
+                              const TAO_Index_Predicates& predicates,
+                              const char* preference_property = 0,
+                              bool descending = false);
+
+  /// Release all the locks acquired.
+  ~TAO_Indexed_Offer_Iterator ();
+
+  /// Returns 1 if there are more offers, 0 otherwise.
+  int has_more_offers ();
+
+  /// Get the id for the current offer.
+  CosTrading::OfferId get_id ();
+
+  /// Returns the next offer in the series.
+  CosTrading::Offer* get_offer ();
+
+  /// Advances the iterator 1.
+  void next_offer ();
+
+  /// Returns true if an index narrowed down the offers.
+  bool indexed () const;
+
+private:
+  /// Create the indexes that the predicates have asked for often
+  /// enough.
+  void update_indexes (typename TAO_Offer_Database<LOCK_TYPE>::Offer_Map_Entry* entry,
+                       const TAO_Index_Predicates& predicates,
+                       const char* preference_property);
+
+  /// Choose an index and collect the candidate offers from it.
+  /// Returns false if no index is worth using.
+  bool plan (TAO_Offer_Indexes& indexes,
+             const TAO_Index_Predicates& predicates,
+             const char* preference_property,
+             bool descending);
+
+  /// Skip the ids that no longer map to an offer.
+  void settle ();
+
+  /// Lock the top_level map.
+  TAO_Offer_Database<LOCK_TYPE>& stm_;
+
+  /// Lock for the internal map.
+  LOCK_TYPE* lock_;
+
+  /// The offers of the type.
+  TAO_Offer_Map* offer_map_;
+
+  /// Iterator over the whole offer map, when no index is used.
+  TAO_Offer_Map::iterator* offer_iter_;
+
+  /// The candidate offers, when an index is used.
+  TAO_Offer_Index::Offer_Ids ids_;
+  size_t current_;
+  CosTrading::Offer* offer_;
+
+  /// The name of the type. Used for constructing offer ids.
+  const char* type_;
+};
+
 TAO_END_VERSIONED_NAMESPACE_DECL
 
 #include "orbsvcs/Trader/Offer_Database.cpp"
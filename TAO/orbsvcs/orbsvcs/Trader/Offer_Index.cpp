@@ -0,0 +1,360 @@
+#include "orbsvcs/Trader/Offer_Index.h"
+#include "orbsvcs/Trader/Constraint_Tokens.h"
+
+#include "ace/OS_NS_string.h"
+
+#include <algorithm>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_Offer_Index::Range::Range ()
+  : key_type_ (TAO_UNKNOWN),
+    has_lower_ (false),
+    lower_ (0.0),
+    has_upper_ (false),
+    upper_ (0.0),
+    empty_ (false)
+{
+}
+
+TAO_Offer_Index::TAO_Offer_Index (const char* property)
+  : property_ (property),
+    negative_signed_count_ (0),
+    unsigned_count_ (0)
+{
+}
+
+const char*
+TAO_Offer_Index::property () const
+{
+  return this->property_.c_str ();
+}
+
+void
+TAO_Offer_Index::insert (CORBA::ULong id, const CosTrading::Offer& offer)
+{
+  this->remove (id);
+
+  Location location;
+  location.value_type_ = TAO_UNKNOWN;
+  location.negative_ = false;
+
+  const CosTrading::PropertySeq& props = offer.properties;
+  CORBA::ULong const length = props.length ();
+  for (CORBA::ULong i = 0; i < length; ++i)
+    {
+      if (ACE_OS::strcmp (props[i].name.in (), this->property_.c_str ()) != 0)
+        continue;
+
+      // Dynamic properties are structures, they end up unindexed.
+      CORBA::Any& value = const_cast<CORBA::Any&> (props[i].value);
+      TAO_Literal_Constraint literal (&value);
+
+      switch (literal.expr_type ())
+        {
+        case TAO_SIGNED:
+          location.negative_ =
+            static_cast<CORBA::LongLong> (literal) < 0;
+          if (location.negative_)
+            ++this->negative_signed_count_;
+          ACE_FALLTHROUGH;
+        case TAO_UNSIGNED:
+        case TAO_DOUBLE:
+          location.value_type_ = literal.expr_type ();
+          if (location.value_type_ == TAO_UNSIGNED)
+            ++this->unsigned_count_;
+          location.numeric_ =
+            this->numeric_.insert (
+              Numeric_Keys::value_type (
+                static_cast<CORBA::Double> (literal), id));
+          break;
+        case TAO_STRING:
+          location.value_type_ = TAO_STRING;
+          location.string_ =
+            this->strings_.insert (
+              String_Keys::value_type (
+                static_cast<const char*> (literal), id));
+          break;
+        default:
+          break;
+        }
+      break;
+    }
+
+  if (location.value_type_ == TAO_UNKNOWN)
+    this->unindexed_.insert (id);
+
+  this->locations_[id] = location;
+}
+
+void
+TAO_Offer_Index::remove (CORBA::ULong id)
+{
+  std::unordered_map<CORBA::ULong, Location>::iterator i =
+    this->locations_.find (id);
+  if (i == this->locations_.end ())
+    return;
+
+  Location& location = i->second;
+  switch (location.value_type_)
+    {
+    case TAO_SIGNED:
+      if (location.negative_)
+        --this->negative_signed_count_;
+      this->numeric_.erase (location.numeric_);
+      break;
+    case TAO_UNSIGNED:
+      --this->unsigned_count_;
+      this->numeric_.erase (location.numeric_);
+      break;
+    case TAO_DOUBLE:
+      this->numeric_.erase (location.numeric_);
+      break;
+    case TAO_STRING:
+      this->strings_.erase (location.string_);
+      break;
+    default:
+      this->unindexed_.erase (id);
+      break;
+    }
+
+  this->locations_.erase (i);
+}
+
+bool
+TAO_Offer_Index::restrict (Range& range,
+                           const TAO_Index_Predicate& predicate) const
+{
+  TAO_Expression_Type const literal_type = predicate.value_.expr_type ();
+
+  if (literal_type == TAO_STRING)
+    {
+      // Only equality, string ordering is left to the evaluator.
+      if (predicate.op_ != TAO_EQ || range.key_type_ == TAO_DOUBLE)
+        return false;
+
+      const char* value = static_cast<const char*> (predicate.value_);
+      if (range.key_type_ == TAO_STRING && range.string_ != value)
+        range.empty_ = true;
+
+      range.key_type_ = TAO_STRING;
+      range.string_ = value;
+      return true;
+    }
+
+  if ((literal_type != TAO_SIGNED
+       && literal_type != TAO_UNSIGNED
+       && literal_type != TAO_DOUBLE)
+      || range.key_type_ == TAO_STRING)
+    return false;
+
+  // A negative value and an unsigned value compare as unsigned
+  // values in the evaluator, stay out of its way.
+  if (literal_type == TAO_UNSIGNED && this->negative_signed_count_ != 0)
+    return false;
+
+  if (literal_type == TAO_SIGNED
+      && static_cast<CORBA::LongLong> (predicate.value_) < 0
+      && this->unsigned_count_ != 0)
+    return false;
+
+  CORBA::Double const value = static_cast<CORBA::Double> (predicate.value_);
+
+  switch (predicate.op_)
+    {
+    case TAO_EQ:
+    case TAO_GT:
+    case TAO_GE:
+      if (!range.has_lower_ || range.lower_ < value)
+        range.lower_ = value;
+      range.has_lower_ = true;
+      if (predicate.op_ != TAO_EQ)
+        break;
+      ACE_FALLTHROUGH;
+    case TAO_LT:
+    case TAO_LE:
+      if (!range.has_upper_ || value < range.upper_)
+        range.upper_ = value;
+      range.has_upper_ = true;
+      break;
+    default:
+      return false;
+    }
+
+  range.key_type_ = TAO_DOUBLE;
+  if (range.has_lower_ && range.has_upper_ && range.upper_ < range.lower_)
+    range.empty_ = true;
+
+  return true;
+}
+
+std::pair<TAO_Offer_Index::Numeric_Keys::const_iterator,
+          TAO_Offer_Index::Numeric_Keys::const_iterator>
+TAO_Offer_Index::numeric_range (const Range& range) const
+{
+  Numeric_Keys::const_iterator first =
+    range.has_lower_
+      ? this->numeric_.lower_bound (range.lower_)
+      : this->numeric_.begin ();
+  Numeric_Keys::const_iterator last =
+    range.has_upper_
+      ? this->numeric_.upper_bound (range.upper_)
+      : this->numeric_.end ();
+
+  return std::make_pair (first, last);
+}
+
+size_t
+TAO_Offer_Index::count (const Range& range) const
+{
+  size_t result = this->unindexed_.size ();
+
+  if (range.empty_)
+    return result;
+
+  switch (range.key_type_)
+    {
+    case TAO_DOUBLE:
+      {
+        std::pair<Numeric_Keys::const_iterator,
+                  Numeric_Keys::const_iterator> keys =
+          this->numeric_range (range);
+        result += std::distance (keys.first, keys.second);
+      }
+      break;
+    case TAO_STRING:
+      result += this->strings_.count (range.string_);
+      break;
+    default:
+      result += this->numeric_.size () + this->strings_.size ();
+      break;
+    }
+
+  return result;
+}
+
+void
+TAO_Offer_Index::lookup (const Range& range,
+                         bool descending,
+                         Offer_Ids& ids) const
+{
+  ids.reserve (ids.size () + this->count (range));
+
+  if (!range.empty_)
+    {
+      std::pair<Numeric_Keys::const_iterator,
+                Numeric_Keys::const_iterator> numeric_keys (
+                  this->numeric_.end (), this->numeric_.end ());
+      std::pair<String_Keys::const_iterator,
+                String_Keys::const_iterator> string_keys (
+                  this->strings_.end (), this->strings_.end ());
+
+      switch (range.key_type_)
+        {
+        case TAO_DOUBLE:
+          numeric_keys = this->numeric_range (range);
+          break;
+        case TAO_STRING:
+          string_keys = this->strings_.equal_range (range.string_);
+          break;
+        default:
+          numeric_keys = std::make_pair (this->numeric_.begin (),
+                                         this->numeric_.end ());
+          string_keys = std::make_pair (this->strings_.begin (),
+                                        this->strings_.end ());
+          break;
+        }
+
+      if (descending)
+        {
+          for (Numeric_Keys::const_iterator i = numeric_keys.second;
+               i != numeric_keys.first;)
+            ids.push_back ((--i)->second);
+          for (String_Keys::const_iterator i = string_keys.second;
+               i != string_keys.first;)
+            ids.push_back ((--i)->second);
+        }
+      else
+        {
+          for (Numeric_Keys::const_iterator i = numeric_keys.first;
+               i != numeric_keys.second;
+               ++i)
+            ids.push_back (i->second);
+          for (String_Keys::const_iterator i = string_keys.first;
+               i != string_keys.second;
+               ++i)
+            ids.push_back (i->second);
+        }
+    }
+
+  ids.insert (ids.end (), this->unindexed_.begin (), this->unindexed_.end ());
+}
+
+// *************************************************************
+
+TAO_Offer_Indexes::TAO_Offer_Indexes ()
+{
+}
+
+TAO_Offer_Indexes::~TAO_Offer_Indexes ()
+{
+  for (Index_Map::iterator i = this->indexes_.begin ();
+       i != this->indexes_.end ();
+       ++i)
+    delete i->second;
+}
+
+void
+TAO_Offer_Indexes::insert (CORBA::ULong id, const CosTrading::Offer& offer)
+{
+  for (Index_Map::iterator i = this->indexes_.begin ();
+       i != this->indexes_.end ();
+       ++i)
+    i->second->insert (id, offer);
+}
+
+void
+TAO_Offer_Indexes::remove (CORBA::ULong id)
+{
+  for (Index_Map::iterator i = this->indexes_.begin ();
+       i != this->indexes_.end ();
+       ++i)
+    i->second->remove (id);
+}
+
+TAO_Offer_Index*
+TAO_Offer_Indexes::find (const char* property) const
+{
+  Index_Map::const_iterator i = this->indexes_.find (property);
+  return i == this->indexes_.end () ? 0 : i->second;
+}
+
+bool
+TAO_Offer_Indexes::record_use (const char* property)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->uses_lock_, false);
+
+  unsigned long& uses = this->uses_[property];
+  if (uses < static_cast<unsigned long> (INDEX_THRESHOLD))
+    ++uses;
+
+  return uses >= static_cast<unsigned long> (INDEX_THRESHOLD);
+}
+
+TAO_Offer_Index*
+TAO_Offer_Indexes::create (const char* property, TAO_Offer_Map& offers)
+{
+  TAO_Offer_Index* index = this->find (property);
+  if (index != 0)
+    return index;
+
+  ACE_NEW_RETURN (index, TAO_Offer_Index (property), 0);
+
+  for (TAO_Offer_Map::iterator i (offers); ! i.done (); i++)
+    index->insert ((*i).ext_id_, *(*i).int_id_);
+
+  this->indexes_[property] = index;
+  return index;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
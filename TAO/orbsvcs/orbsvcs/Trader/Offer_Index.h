@@ -0,0 +1,200 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    Offer_Index.h
+ *
+ *  Secondary indexes on the properties of the exported offers, used
+ *  to narrow down the offers a query has to evaluate.
+ */
+//=============================================================================
+
+#ifndef TAO_OFFER_INDEX_H
+#define TAO_OFFER_INDEX_H
+#include /**/ "ace/pre.h"
+
+#include "orbsvcs/Trader/Trader.h"
+#include "orbsvcs/Trader/Constraint_Nodes.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @struct TAO_Index_Predicate
+ *
+ * @brief A conjunct of a constraint with the form
+ * <property> <op> <literal>, which an index on <property> can
+ * answer.
+ */
+struct TAO_Trading_Serv_Export TAO_Index_Predicate
+{
+  /// The name of the property.
+  CORBA::String_var property_;
+
+  /// One of TAO_EQ, TAO_LT, TAO_LE, TAO_GT or TAO_GE, with the
+  /// property as the left operand.
+  TAO_Expression_Type op_;
+
+  /// The literal the property is compared with.
+  TAO_Literal_Constraint value_;
+};
+
+typedef std::vector<TAO_Index_Predicate> TAO_Index_Predicates;
+
+/**
+ * @class TAO_Offer_Index
+ *
+ * @brief An ordered index on one property of the offers of a service
+ * type.
+ *
+ * Numeric values are kept as doubles, strings as they are.  The
+ * offers whose property is missing, dynamic, or of any other type
+ * are kept in a separate set, and are returned by every lookup, so
+ * the index can only ever discard offers that cannot satisfy the
+ * predicate.
+ */
+class TAO_Trading_Serv_Export TAO_Offer_Index
+{
+public:
+  typedef std::vector<CORBA::ULong> Offer_Ids;
+
+  /**
+   * @struct Range
+   *
+   * @brief The keys selected by a set of predicates.  The bounds are
+   * always inclusive, the constraint evaluation takes care of the
+   * strict comparisons.
+   */
+  struct TAO_Trading_Serv_Export Range
+  {
+    Range ();
+
+    /// TAO_UNKNOWN (all keys), TAO_DOUBLE or TAO_STRING
+    TAO_Expression_Type key_type_;
+
+    bool has_lower_;
+    CORBA::Double lower_;
+    bool has_upper_;
+    CORBA::Double upper_;
+
+    /// The only string key selected.
+    std::string string_;
+
+    /// Set if the predicates contradict each other.
+    bool empty_;
+  };
+
+  explicit TAO_Offer_Index (const char* property);
+
+  /// The indexed property.
+  const char* property () const;
+
+  /// Index the offer known as @a id.
+  void insert (CORBA::ULong id, const CosTrading::Offer& offer);
+
+  /// Remove the offer known as @a id from the index.
+  void remove (CORBA::ULong id);
+
+  /// Narrow @a range with @a predicate.  Returns false, leaving
+  /// @a range unchanged, if the index cannot answer @a predicate.
+  bool restrict (Range& range, const TAO_Index_Predicate& predicate) const;
+
+  /// Number of offers a lookup of @a range would return.
+  size_t count (const Range& range) const;
+
+  /// Append the ids of the offers in @a range to @a ids, in key order
+  /// (reversed if @a descending is set), followed by the offers
+  /// without an indexed value.
+  void lookup (const Range& range, bool descending, Offer_Ids& ids) const;
+
+private:
+  typedef std::multimap<CORBA::Double, CORBA::ULong> Numeric_Keys;
+  typedef std::multimap<std::string, CORBA::ULong> String_Keys;
+
+  /// Where an offer is in the index, to remove it without looking at
+  /// the (possibly already modified) offer.
+  struct Location
+  {
+    TAO_Expression_Type value_type_;
+    bool negative_;
+    Numeric_Keys::iterator numeric_;
+    String_Keys::iterator string_;
+  };
+
+  std::pair<Numeric_Keys::const_iterator, Numeric_Keys::const_iterator>
+    numeric_range (const Range& range) const;
+
+  std::string property_;
+
+  Numeric_Keys numeric_;
+  String_Keys strings_;
+  std::set<CORBA::ULong> unindexed_;
+  std::unordered_map<CORBA::ULong, Location> locations_;
+
+  /// The evaluator compares signed and unsigned values without
+  /// widening them, so mixing signedness is only answered from the
+  /// index when it cannot make a difference.
+  size_t negative_signed_count_;
+  size_t unsigned_count_;
+};
+
+/**
+ * @class TAO_Offer_Indexes
+ *
+ * @brief The indexes on the properties of one service type.
+ *
+ * An index is created once a property has been used in
+ * TAO_Offer_Indexes::INDEX_THRESHOLD queries, so only the
+ * properties that are queried frequently pay for one.  The owner of
+ * the indexes is responsible for the locking: insert(), remove() and
+ * create() modify the indexes, find() and the lookups on the indexes
+ * only read them. record_use() is thread safe.
+ */
+class TAO_Trading_Serv_Export TAO_Offer_Indexes
+{
+public:
+  enum { INDEX_THRESHOLD = 4 };
+
+  TAO_Offer_Indexes ();
+  ~TAO_Offer_Indexes ();
+
+  /// Add the offer known as @a id to all the indexes.
+  void insert (CORBA::ULong id, const CosTrading::Offer& offer);
+
+  /// Remove the offer known as @a id from all the indexes.
+  void remove (CORBA::ULong id);
+
+  /// Return the index on @a property, 0 if there is none.
+  TAO_Offer_Index* find (const char* property) const;
+
+  /// Take note of a query that could use an index on @a property.
+  /// Returns true if the property deserves an index.
+  bool record_use (const char* property);
+
+  /// Create (unless it exists) the index on @a property over all the
+  /// offers in @a offers.
+  TAO_Offer_Index* create (const char* property, TAO_Offer_Map& offers);
+
+private:
+  TAO_Offer_Indexes (const TAO_Offer_Indexes&) = delete;
+  TAO_Offer_Indexes& operator= (const TAO_Offer_Indexes&) = delete;
+
+  typedef std::map<std::string, TAO_Offer_Index*> Index_Map;
+  Index_Map indexes_;
+
+  typedef std::map<std::string, unsigned long> Use_Map;
+  Use_Map uses_;
+
+  /// Protect <uses_>, it is updated by concurrent queries.
+  TAO_SYNCH_MUTEX uses_lock_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+#endif /* TAO_OFFER_INDEX_H */
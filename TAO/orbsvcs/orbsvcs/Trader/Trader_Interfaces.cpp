@@ -205,16 +205,27 @@ lookup_one_type (const char* type,
   // @@ Would have used Offer_Database::offer_iterator for less
   // coupling between TAO_Lookup and Offer_Database, but g++ barfs on
   // that.
+  //
+  // The predicates of the constraint and the preference let the
+  // iterator skip the offers an index rules out, and hand over the
+  // rest in preference order when it can.
+  TAO_Index_Predicates predicates;
+  constr_inter.index_predicates (predicates);
+  bool descending = false;
+  const char* preference_property = pref_inter.index_property (descending);
+
 #if defined(_MSC_VER) && !defined (ACE_HAS_CPP20)
-  TAO_Offer_Database<MAP_LOCK_TYPE>::offer_iterator
-    offer_iter (type, offer_database);
+  TAO_Offer_Database<MAP_LOCK_TYPE>::indexed_offer_iterator
+    offer_iter (type, offer_database, predicates,
+                preference_property, descending);
 #else
   // MSVC won't grok this for some reason, but it's necessary for the
   // HP compiler, which seriously requires the typename keyword
   // here. I apologize if this ifdef offends some ACE users'
   // sensibilities --- it certainly offends mine.
-  typename TAO_Offer_Database<MAP_LOCK_TYPE>::offer_iterator
-    offer_iter (type, offer_database);
+  typename TAO_Offer_Database<MAP_LOCK_TYPE>::indexed_offer_iterator
+    offer_iter (type, offer_database, predicates,
+                preference_property, descending);
 #endif
 
   while (offer_filter.ok_to_consider_more () &&
@@ -934,6 +945,9 @@ modify (const char *id,
       // spec says: modify either suceeds completely or fails
       // completely.
       offer_mod.affect_change (modify_list);
+
+      // The new property values move the offer in the indexes.
+      offer_database.reindex_offer (const_cast<CosTrading::OfferId> (id));
     }
 }
 
@@ -958,21 +972,24 @@ withdraw_using_constraint (const char *type,
   // Try to find the map of offers of desired service type.
   // @@ Again, should be Offer_Database::offer_iterator
   {
+    TAO_Trader_Constraint_Validator validator (type_struct.in ());
+    TAO_Constraint_Interpreter constr_inter (validator, constr);
+
+    TAO_Index_Predicates predicates;
+    constr_inter.index_predicates (predicates);
+
 #if defined (_MSC_VER) && !defined (ACE_HAS_CPP20)
-    TAO_Offer_Database<MAP_LOCK_TYPE>::offer_iterator
-      offer_iter (type, offer_database);
+    TAO_Offer_Database<MAP_LOCK_TYPE>::indexed_offer_iterator
+      offer_iter (type, offer_database, predicates);
 #else
     // MSVC won't grok this for some reason, but it's necessary for
     // the HP compiler, which seriously requires the typename keyword
     // here. I apologize if this ifdef offends some ACE users'
     // sensibilities --- it certainly offends mine.
-    typename TAO_Offer_Database<MAP_LOCK_TYPE>::offer_iterator
-      offer_iter (type, offer_database);
+    typename TAO_Offer_Database<MAP_LOCK_TYPE>::indexed_offer_iterator
+      offer_iter (type, offer_database, predicates);
 #endif /* _MSC_VER */
 
-    TAO_Trader_Constraint_Validator validator (type_struct.in ());
-    TAO_Constraint_Interpreter constr_inter (validator, constr);
-
     while (offer_iter.has_more_offers ())
       {
         CosTrading::Offer* offer = offer_iter.get_offer ();
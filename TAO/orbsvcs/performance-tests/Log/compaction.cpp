@@ -0,0 +1,280 @@
+//=============================================================================
+/**
+ *  @file   compaction.cpp
+ *
+ *  Measure the latency of write_recordlist() while the records past
+ *  their maximum life are removed, all at once or a slice at a time.
+ */
+//=============================================================================
+
+#include "orbsvcs/Log/BasicLogFactory_i.h"
+#include "orbsvcs/Log/BasicLog_i.h"
+#include "orbsvcs/Log/LogRecordStore.h"
+#include "orbsvcs/Log_Macros.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Service_Config.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/SString.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_unistd.h"
+
+#include <algorithm>
+#include <vector>
+
+CORBA::ULong preload = 1000000;
+int seconds = 5;
+CORBA::ULong rate = 100000;
+CORBA::ULong slice = 1024;
+const ACE_TCHAR *directory = 0;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:t:r:s:d:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        preload = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 't':
+        seconds = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'r':
+        rate = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 's':
+        slice = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'd':
+        directory = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                               "usage:  %s "
+                               "-n <records> "
+                               "-t <seconds> "
+                               "-r <writes per second> "
+                               "-s <slice, 0 for all at once> "
+                               "-d <segment directory> "
+                               "\n",
+                               argv [0]),
+                              -1);
+      }
+
+  if (seconds <= 0 || rate == 0)
+    ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                           "%s: -t and -r must be positive\n",
+                           argv [0]),
+                          -1);
+  return 0;
+}
+
+/**
+ * @class Compactor
+ *
+ * @brief Remove the old records in a loop, the way
+ * TAO_Log_Compaction_Handler does but without waiting for its
+ * interval.
+ */
+class Compactor : public ACE_Task_Base
+{
+public:
+  explicit Compactor (TAO_Log_i &log)
+    : log_ (log),
+      stopping_ (false),
+      passes_ (0)
+  {
+  }
+
+  virtual int svc ()
+  {
+    while (!this->stopping_)
+      {
+        if (slice == 0)
+          {
+            this->log_.remove_old_records ();
+          }
+        else
+          {
+            bool done = false;
+            while (!done && !this->stopping_)
+              {
+                this->log_.remove_old_records (slice, done);
+                ACE_OS::thr_yield ();
+              }
+          }
+
+        ++this->passes_;
+        ACE_OS::sleep (ACE_Time_Value (0, 100000));
+      }
+    return 0;
+  }
+
+  void stop ()
+  {
+    this->stopping_ = true;
+    this->wait ();
+  }
+
+  unsigned long passes () const
+  {
+    return this->passes_;
+  }
+
+private:
+  TAO_Log_i &log_;
+  volatile bool stopping_;
+  unsigned long passes_;
+};
+
+/// Print the percentile @a p of the sorted @a samples.
+void
+report (const char *what,
+        const std::vector<ACE_hrtime_t> &samples,
+        double p)
+{
+  size_t const i =
+    std::min (samples.size () - 1,
+              static_cast<size_t> (p * samples.size () / 100.0));
+
+  ACE_OS::printf ("%-12s %12.2f usecs\n",
+                  what,
+                  static_cast<double> (samples[i]) / 1000.0);
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      if (directory != 0)
+        {
+          ACE_TString directive =
+            ACE_TEXT ("dynamic Log_Persistence Service_Object * ")
+            ACE_TEXT ("TAO_DsLogAdmin_Serv:_make_TAO_Segment_Persistence_Strategy () ")
+            ACE_TEXT ("\"-SegmentDirectory ");
+          directive += directory;
+          directive += ACE_TEXT ("\"");
+
+          if (ACE_Service_Config::process_directive (directive.c_str ()) != 0)
+            ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                   "Unable to load the segment strategy\n"),
+                                  1);
+        }
+
+      CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa = PortableServer::POA::_narrow (obj.in ());
+      PortableServer::POAManager_var poa_manager = poa->the_POAManager ();
+      poa_manager->activate ();
+
+      TAO_BasicLogFactory_i factory;
+      DsLogAdmin::BasicLogFactory_var factory_ref =
+        factory.activate (orb.in (), poa.in ());
+
+      DsLogAdmin::LogId id;
+      DsLogAdmin::BasicLog_var log_ref =
+        factory.create (DsLogAdmin::wrap, 0, id);
+
+      // The servant is called directly, so the numbers are those of
+      // the log and not of the ORB.
+      TAO_BasicLog_i *log_i = 0;
+      ACE_NEW_RETURN (log_i,
+                      TAO_BasicLog_i (orb.in (),
+                                      factory.log_poa (),
+                                      factory,
+                                      factory_ref.in (),
+                                      id),
+                      1);
+      PortableServer::ServantBase_var safe_log_i (log_i);
+      TAO_Log_i &log = *log_i;
+      log.init ();
+
+      DsLogAdmin::RecordList records (1);
+      records.length (1);
+      records[0].info <<= "a log record of a realistic size, with some text";
+
+      for (CORBA::ULong i = 0; i != preload; ++i)
+        log.write_recordlist (records);
+
+      // Let the records loaded age, then give them a life of one
+      // second so they are all old.  The maximum record life is set on
+      // the record store, so the compaction handler of the log is not
+      // started, the compactor below does its work.
+      ACE_OS::sleep (2);
+
+      TAO_LogRecordStore *store = factory.get_log_record_store (id);
+      store->set_max_record_life (1);
+
+      Compactor compactor (log);
+      compactor.activate (THR_NEW_LWP | THR_JOINABLE, 1);
+
+      std::vector<ACE_hrtime_t> samples;
+      samples.reserve (1000000);
+
+      // The writes are paced, as they would be by the requests of the
+      // clients, a writer calling in a loop would shut the compactor
+      // out.
+      ACE_Time_Value const period (0, 1000000 / rate);
+      ACE_Time_Value next = ACE_OS::gettimeofday ();
+      ACE_Time_Value const end = next + ACE_Time_Value (seconds);
+
+      while (next < end)
+        {
+          while (ACE_OS::gettimeofday () < next)
+            continue;
+          next += period;
+
+          ACE_High_Res_Timer timer;
+          timer.start ();
+          log.write_recordlist (records);
+          timer.stop ();
+
+          ACE_hrtime_t nsecs;
+          timer.elapsed_time (nsecs);
+          samples.push_back (nsecs);
+        }
+
+      compactor.stop ();
+
+      std::sort (samples.begin (), samples.end ());
+
+      ACE_OS::printf ("%s strategy, %s compaction, %u records loaded\n",
+                      directory != 0 ? "Segment" : "Hash",
+                      slice == 0 ? "full" : "sliced",
+                      preload);
+      ACE_OS::printf ("%lu writes, %lu compaction passes, %lu records left\n",
+                      static_cast<unsigned long> (samples.size ()),
+                      compactor.passes (),
+                      static_cast<unsigned long> (log.get_n_records ()));
+      report ("p50", samples, 50.0);
+      report ("p99", samples, 99.0);
+      report ("p99.9", samples, 99.9);
+      report ("max", samples, 100.0);
+
+      factory.remove (id);
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("compaction");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,222 @@
+//=============================================================================
+/**
+ *  @file   segment.cpp
+ *
+ *  Compare the time it takes to log records, and to retrieve or query
+ *  a window of them, with the hash and the segment persistence
+ *  strategies.
+ */
+//=============================================================================
+
+#include "orbsvcs/Log/BasicLogFactory_i.h"
+#include "orbsvcs/Log/LogRecordStore.h"
+#include "orbsvcs/Time_Utilities.h"
+#include "orbsvcs/Log_Macros.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Service_Config.h"
+#include "ace/Get_Opt.h"
+#include "ace/SString.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_sys_time.h"
+
+#include <vector>
+
+CORBA::ULong record_count = 1000000;
+CORBA::ULong window = 1000;
+int iterations = 100;
+const ACE_TCHAR *directory = 0;
+const ACE_TCHAR *segment_records = ACE_TEXT ("65536");
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:w:i:d:r:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        record_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'w':
+        window = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'd':
+        directory = get_opts.opt_arg ();
+        break;
+
+      case 'r':
+        segment_records = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                               "usage:  %s "
+                               "-n <records> "
+                               "-w <window> "
+                               "-i <iterations> "
+                               "-d <segment directory> "
+                               "-r <records per segment> "
+                               "\n",
+                               argv [0]),
+                              -1);
+      }
+
+  if (record_count == 0 || window == 0 || iterations <= 0)
+    ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                           "%s: -n, -w and -i must be positive\n",
+                           argv [0]),
+                          -1);
+  return 0;
+}
+
+/// Print the average time of @a count operations timed by @a timer.
+void
+report (const char *what, ACE_High_Res_Timer &timer, CORBA::ULong count)
+{
+  ACE_hrtime_t usecs;
+  timer.elapsed_microseconds (usecs);
+
+  ACE_OS::printf ("%-28s %12.2f usecs\n",
+                  what,
+                  static_cast<double> (usecs) / count);
+}
+
+/// Release the records past the first window, the way a client done
+/// with them would.
+void
+release (DsLogAdmin::Iterator_var &iter)
+{
+  if (!CORBA::is_nil (iter.in ()))
+    iter->destroy ();
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      if (directory != 0)
+        {
+          ACE_TString directive =
+            ACE_TEXT ("dynamic Log_Persistence Service_Object * ")
+            ACE_TEXT ("TAO_DsLogAdmin_Serv:_make_TAO_Segment_Persistence_Strategy () ")
+            ACE_TEXT ("\"-SegmentDirectory ");
+          directive += directory;
+          directive += ACE_TEXT (" -SegmentRecords ");
+          directive += segment_records;
+          directive += ACE_TEXT ("\"");
+
+          if (ACE_Service_Config::process_directive (directive.c_str ()) != 0)
+            ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                   "Unable to load the segment strategy\n"),
+                                  1);
+        }
+
+      CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var poa = PortableServer::POA::_narrow (obj.in ());
+      PortableServer::POAManager_var poa_manager = poa->the_POAManager ();
+      poa_manager->activate ();
+
+      TAO_BasicLogFactory_i factory;
+      DsLogAdmin::BasicLogFactory_var factory_ref =
+        factory.activate (orb.in (), poa.in ());
+
+      DsLogAdmin::LogId id;
+      DsLogAdmin::BasicLog_var log =
+        factory.create (DsLogAdmin::halt, 0, id);
+
+      TAO_LogRecordStore *store = factory.get_log_record_store (id);
+
+      ACE_OS::printf ("%s strategy, %u records\n",
+                      directory != 0 ? "Segment" : "Hash",
+                      record_count);
+
+      // Log the records, remembering the time of the first record of
+      // each window.
+      DsLogAdmin::LogRecord rec;
+      rec.info <<= "a log record of a realistic size, with some text";
+
+      std::vector<DsLogAdmin::TimeT> times;
+      CORBA::ULong const windows = record_count / window;
+
+      ACE_High_Res_Timer timer;
+      timer.start ();
+      for (CORBA::ULong i = 0; i != record_count; ++i)
+        {
+          if (i % window == 0 && i / window < windows)
+            times.push_back (
+              ORBSVCS_Time::to_Absolute_TimeT (ACE_OS::gettimeofday ()));
+
+          if (store->log (rec) != 0)
+            ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                                   "Unable to log record %u\n", i),
+                                  1);
+        }
+      timer.stop ();
+      report ("log", timer, record_count);
+
+      if (windows == 0)
+        ORBSVCS_ERROR_RETURN ((LM_ERROR, "Fewer records than a window\n"),
+                              1);
+
+      ACE_OS::srand (42);
+
+      // Retrieve a window of records logged from a given time on.
+      timer.reset ();
+      timer.start ();
+      for (int i = 0; i != iterations; ++i)
+        {
+          CORBA::ULong const w = ACE_OS::rand () % windows;
+          DsLogAdmin::Iterator_var iter;
+          DsLogAdmin::RecordList_var records =
+            store->retrieve (times[w], window, iter.out ());
+          release (iter);
+        }
+      timer.stop ();
+      report ("retrieve (time window)", timer, iterations);
+
+      // Query a window of records by id.
+      timer.reset ();
+      timer.start ();
+      for (int i = 0; i != iterations; ++i)
+        {
+          CORBA::ULong const w = ACE_OS::rand () % windows;
+          char constraint[64];
+          ACE_OS::snprintf (constraint, sizeof (constraint),
+                            "id > %u and id <= %u",
+                            w * window, (w + 1) * window);
+
+          DsLogAdmin::Iterator_var iter;
+          DsLogAdmin::RecordList_var records =
+            store->query ("EXTENDED_TCL", constraint, iter.out ());
+          release (iter);
+        }
+      timer.stop ();
+      report ("query (id window)", timer, iterations);
+
+      log->destroy ();
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("segment");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,217 @@
+//=============================================================================
+/**
+ *  @file   resolve.cpp
+ *
+ *  Measure the latency of resolve, and the number of requests it
+ *  makes to the Naming Service, with and without the cache of
+ *  TAO_Naming_Client.
+ */
+//=============================================================================
+
+#include "orbsvcs/Naming/Naming_Server.h"
+#include "orbsvcs/Naming/Naming_Client.h"
+#include "orbsvcs/Naming/Naming_Client_Observer.h"
+#include "orbsvcs/Log_Macros.h"
+#include "tao/PortableServer/Servant_var.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/OS_NS_stdio.h"
+
+int name_count = 100;
+int iterations = 20000;
+int update_interval = 100;
+int max_age = 60;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:i:u:a:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        name_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'u':
+        update_interval = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'a':
+        max_age = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                               "usage:  %s "
+                               "-n <names> "
+                               "-i <iterations> "
+                               "-u <resolves between rebinds> "
+                               "-a <max age of the cached names> "
+                               "\n",
+                               argv [0]),
+                              -1);
+      }
+  return 0;
+}
+
+/// Runs the event loop of the ORB, for the naming service and the
+/// observer.
+class ORB_Task : public ACE_Task_Base
+{
+public:
+  explicit ORB_Task (CORBA::ORB_ptr orb)
+    : orb_ (CORBA::ORB::_duplicate (orb))
+  {
+  }
+
+  virtual int svc ()
+  {
+    try
+      {
+        this->orb_->run ();
+      }
+    catch (const CORBA::Exception&)
+      {
+      }
+    return 0;
+  }
+
+private:
+  CORBA::ORB_var orb_;
+};
+
+void
+make_name (CosNaming::Name &name, int i)
+{
+  char id[32];
+  ACE_OS::snprintf (id, sizeof id, "object%d", i);
+  name.length (2);
+  name[0].id = CORBA::string_dup ("objects");
+  name[1].id = CORBA::string_dup (id);
+}
+
+void
+run (const char *what,
+     TAO_Naming_Client &client,
+     CosNaming::NamingContext_ptr objects)
+{
+  CosNaming::Name name;
+  CosNaming::Name last (1);
+  last.length (1);
+  int rebinds = 0;
+
+  ACE_hrtime_t resolving = 0;
+  ACE_High_Res_Timer timer;
+  for (int i = 0; i < iterations; ++i)
+    {
+      make_name (name, i % name_count);
+
+      timer.start ();
+      CORBA::Object_var obj = client.resolve (name);
+      timer.stop ();
+      ACE_hrtime_t usecs;
+      timer.elapsed_microseconds (usecs);
+      resolving += usecs;
+
+      if (update_interval > 0 && i % update_interval == update_interval - 1)
+        {
+          last[0] = name[1];
+          objects->rebind (last, objects);
+          ++rebinds;
+        }
+    }
+
+  unsigned long hits = 0;
+  unsigned long misses = static_cast<unsigned long> (iterations);
+  client.cache_stats (hits, misses);
+  if (hits + misses == 0)
+    misses = static_cast<unsigned long> (iterations);
+
+  ORBSVCS_DEBUG ((LM_DEBUG,
+                  "%C: %d resolves, %.2f usecs per resolve, "
+                  "%d requests to the server (%d rebinds)\n",
+                  what, iterations,
+                  static_cast<double> (resolving) / iterations,
+                  static_cast<int> (misses), rebinds));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0 || name_count <= 0)
+        return 1;
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      TAO_Naming_Server server;
+      const ACE_TCHAR *args[] = { ACE_TEXT ("resolve") };
+      if (server.init_with_orb (1, const_cast<ACE_TCHAR **> (args),
+                                orb.in ()) != 0)
+        ORBSVCS_ERROR_RETURN ((LM_ERROR, "Cannot start the naming service\n"), 1);
+
+      ORB_Task orb_task (orb.in ());
+      if (orb_task.activate (THR_NEW_LWP | THR_JOINABLE, 1) != 0)
+        ORBSVCS_ERROR_RETURN ((LM_ERROR, "Cannot run the ORB\n"), 1);
+
+      TAO_Naming_Client client;
+      if (client.init (orb.in ()) != 0)
+        return 1;
+
+      CosNaming::Name name (1);
+      name.length (1);
+      name[0].id = CORBA::string_dup ("objects");
+      CosNaming::NamingContext_var objects = client->bind_new_context (name);
+
+      for (int i = 0; i < name_count; ++i)
+        {
+          make_name (name, i);
+          client->bind (name, objects.in ());
+        }
+
+      ORBSVCS_DEBUG ((LM_DEBUG,
+                      "%d names, a rebind every %d resolves\n",
+                      name_count, update_interval));
+
+      run ("no cache", client, objects.in ());
+
+      client.enable_cache (ACE_Time_Value (max_age));
+      run ("cache, max age only", client, objects.in ());
+
+      PortableServer::Servant_var<TAO_Naming_Client_Observer> observer =
+        new TAO_Naming_Client_Observer (client);
+      if (observer->subscribe (root_poa.in ()) != 0)
+        ORBSVCS_ERROR_RETURN ((LM_ERROR, "Cannot subscribe to the changes\n"), 1);
+
+      client.enable_cache (ACE_Time_Value (max_age));
+      run ("cache, pushed invalidations", client, objects.in ());
+
+      observer->unsubscribe ();
+      server.fini ();
+      orb->shutdown (true);
+      orb_task.wait ();
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
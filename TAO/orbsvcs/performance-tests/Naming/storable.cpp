@@ -0,0 +1,241 @@
+//=============================================================================
+/**
+ *  @file   storable.cpp
+ *
+ *  Measure the bind, resolve, rebind and unbind throughput of the
+ *  Naming Service with storable persistence, and the time it takes to
+ *  restart on the files left behind.
+ */
+//=============================================================================
+
+#include "orbsvcs/Naming/Naming_Server.h"
+#include "orbsvcs/Log_Macros.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Get_Opt.h"
+#include "ace/Dirent.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_unistd.h"
+
+const ACE_TCHAR *directory = ACE_TEXT ("naming_db");
+int name_count = 2000;
+int update_count = 0;
+bool use_journal = false;
+bool use_redundancy = false;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("d:n:u:jr"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'd':
+        directory = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        name_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'u':
+        update_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'j':
+        use_journal = true;
+        break;
+
+      case 'r':
+        use_redundancy = true;
+        break;
+
+      case '?':
+      default:
+        ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                               "usage:  %s "
+                               "-d <directory> "
+                               "-n <names> "
+                               "-u <updates> "
+                               "-j (journal) "
+                               "-r (redundant) "
+                               "\n",
+                               argv [0]),
+                              -1);
+      }
+  return 0;
+}
+
+/// Remove the files of a previous run, and return the number of
+/// bytes they used if @a remove is not set.
+ACE_UINT64
+directory_size (bool remove)
+{
+  ACE_UINT64 size = 0;
+  ACE_Dirent dir (directory);
+  for (ACE_DIRENT *entry = dir.read (); entry != 0; entry = dir.read ())
+    {
+      ACE_TString path (directory);
+      path += ACE_TEXT ("/");
+      path += entry->d_name;
+
+      ACE_stat st;
+      if (ACE_OS::stat (path.c_str (), &st) != 0 || (st.st_mode & S_IFREG) == 0)
+        continue;
+      if (remove)
+        ACE_OS::unlink (path.c_str ());
+      else
+        size += st.st_size;
+    }
+  return size;
+}
+
+int
+start_server (TAO_Naming_Server &server, CORBA::ORB_ptr orb)
+{
+  const ACE_TCHAR *args[4];
+  int argc = 0;
+  args[argc++] = ACE_TEXT ("storable");
+  args[argc++] = use_redundancy ? ACE_TEXT ("-r") : ACE_TEXT ("-u");
+  args[argc++] = directory;
+  if (use_journal)
+    args[argc++] = ACE_TEXT ("-j");
+
+  return server.init_with_orb (argc, const_cast<ACE_TCHAR **> (args), orb);
+}
+
+void
+make_name (CosNaming::Name &name, int i)
+{
+  char id[32];
+  ACE_OS::snprintf (id, sizeof id, "object%d", i);
+  name.length (1);
+  name[0].id = CORBA::string_dup (id);
+}
+
+void
+report (const char *what, int count, ACE_High_Res_Timer &timer)
+{
+  ACE_hrtime_t usecs;
+  timer.elapsed_microseconds (usecs);
+  double const seconds = static_cast<double> (usecs) / 1000000.0;
+  ORBSVCS_DEBUG ((LM_DEBUG,
+                  "%C: %d in %.3f secs, %.0f per sec\n",
+                  what, count, seconds,
+                  count / (seconds > 0 ? seconds : 1)));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      // Rebinds and unbinds are made at full size, so their number
+      // can be kept down for large contexts.
+      int const rebinds =
+        update_count > 0 && update_count < name_count ? update_count : name_count;
+      int const unbinds =
+        update_count > 0 && update_count < (name_count + 1) / 2
+          ? update_count : (name_count + 1) / 2;
+
+      ACE_OS::mkdir (directory);
+      directory_size (true);
+
+      ORBSVCS_DEBUG ((LM_DEBUG,
+                      "%d names, %C files%C\n",
+                      name_count,
+                      use_journal ? "journal" : "flat",
+                      use_redundancy ? ", redundant" : ""));
+
+      CosNaming::Name name;
+      ACE_High_Res_Timer timer;
+
+      {
+        TAO_Naming_Server server;
+        if (start_server (server, orb.in ()) != 0)
+          ORBSVCS_ERROR_RETURN ((LM_ERROR, "Cannot start the naming service\n"), 1);
+
+        CosNaming::NamingContext_var root =
+          CosNaming::NamingContext::_duplicate (server.operator-> ());
+
+        timer.start ();
+        for (int i = 0; i < name_count; ++i)
+          {
+            make_name (name, i);
+            root->bind (name, root.in ());
+          }
+        timer.stop ();
+        report ("bind", name_count, timer);
+
+        timer.start ();
+        for (int i = 0; i < name_count; ++i)
+          {
+            make_name (name, i);
+            CORBA::Object_var obj = root->resolve (name);
+          }
+        timer.stop ();
+        report ("resolve", name_count, timer);
+
+        timer.start ();
+        for (int i = 0; i < rebinds; ++i)
+          {
+            make_name (name, i);
+            root->rebind (name, root.in ());
+          }
+        timer.stop ();
+        report ("rebind", rebinds, timer);
+
+        timer.start ();
+        for (int i = 0; i < unbinds; ++i)
+          {
+            make_name (name, 2 * i);
+            root->unbind (name);
+          }
+        timer.stop ();
+        report ("unbind", unbinds, timer);
+
+        server.fini ();
+      }
+
+      ORBSVCS_DEBUG ((LM_DEBUG,
+                      "files: %Q bytes\n",
+                      directory_size (false)));
+
+      {
+        // Restart on the files left behind, and read all the names
+        // back.
+        timer.start ();
+        TAO_Naming_Server server;
+        if (start_server (server, orb.in ()) != 0)
+          ORBSVCS_ERROR_RETURN ((LM_ERROR, "Cannot restart the naming service\n"), 1);
+
+        CosNaming::NamingContext_var root =
+          CosNaming::NamingContext::_duplicate (server.operator-> ());
+        for (int i = 1; i < name_count; i += 2)
+          {
+            make_name (name, i);
+            CORBA::Object_var obj = root->resolve (name);
+          }
+        timer.stop ();
+        report ("restart and resolve", name_count / 2, timer);
+
+        server.fini ();
+      }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
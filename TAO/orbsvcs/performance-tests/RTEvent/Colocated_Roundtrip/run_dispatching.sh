@@ -16,6 +16,11 @@ for n in 2; do
 
   ./driver -ORBSvcConf ec.dispatching_threaded.conf -d -h 10000 -l 10000 -i $ITERATIONS -c $c -n $n > ec_dispatching.threaded.${c}.${n}.txt 2>&1
 
+  date
+  echo partitioned $c $n
+
+  ./driver -ORBSvcConf ec.dispatching_partitioned.conf -d -h 10000 -l 10000 -i $ITERATIONS -c $c -n $n > ec_dispatching.partitioned.${c}.${n}.txt 2>&1
+
   date
   echo reactive $c $n
 
@@ -0,0 +1,213 @@
+//=============================================================================
+/**
+ *  @file   query.cpp
+ *
+ *  Compare the time a query takes when the offers are scanned in full
+ *  and when the offer indexes narrow them down first.
+ */
+//=============================================================================
+
+#include "orbsvcs/Trader/Offer_Database.h"
+#include "orbsvcs/Trader/Constraint_Interpreter.h"
+#include "orbsvcs/Trader/Trader_Constraint_Visitors.h"
+#include "orbsvcs/Log_Macros.h"
+#include "tao/AnyTypeCode/Any.h"
+#include "tao/AnyTypeCode/TypeCode_Constants.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+
+typedef TAO_Offer_Database<ACE_Null_Mutex> Offer_Database;
+
+const char *type_name = "Bench";
+CORBA::ULong offer_count = 1000000;
+int iterations = 10;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        offer_count = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                               "usage:  %s "
+                               "-n <offers> "
+                               "-i <iterations> "
+                               "\n",
+                               argv [0]),
+                              -1);
+      }
+  return 0;
+}
+
+void
+describe_type (CosTradingRepos::ServiceTypeRepository::TypeStruct& type)
+{
+  type.masked = false;
+  type.props.length (3);
+  type.props[0].name = "price";
+  type.props[0].value_type = CORBA::TypeCode::_duplicate (CORBA::_tc_double);
+  type.props[0].mode = CosTradingRepos::ServiceTypeRepository::PROP_NORMAL;
+  type.props[1].name = "id";
+  type.props[1].value_type = CORBA::TypeCode::_duplicate (CORBA::_tc_ulong);
+  type.props[1].mode = CosTradingRepos::ServiceTypeRepository::PROP_NORMAL;
+  type.props[2].name = "region";
+  type.props[2].value_type = CORBA::TypeCode::_duplicate (CORBA::_tc_string);
+  type.props[2].mode = CosTradingRepos::ServiceTypeRepository::PROP_NORMAL;
+}
+
+void
+export_offers (Offer_Database& database)
+{
+  ACE_OS::srand (42);
+
+  for (CORBA::ULong i = 0; i != offer_count; ++i)
+    {
+      CosTrading::Offer* offer = 0;
+      ACE_NEW (offer, CosTrading::Offer);
+
+      char region[16];
+      ACE_OS::snprintf (region, sizeof region, "r%d", ACE_OS::rand () % 100);
+
+      offer->properties.length (3);
+      offer->properties[0].name = "price";
+      offer->properties[0].value <<= (ACE_OS::rand () % 100000) / 100.0;
+      offer->properties[1].name = "id";
+      offer->properties[1].value <<= i;
+      offer->properties[2].name = "region";
+      offer->properties[2].value <<= region;
+
+      CORBA::string_free (database.insert_offer (type_name, offer));
+    }
+}
+
+/// Evaluate and order the offers of the iterator, return the number
+/// of matches.
+template <class ITERATOR> size_t
+run_query (ITERATOR& offer_iter,
+           TAO_Constraint_Interpreter& constr_inter,
+           TAO_Preference_Interpreter& pref_inter)
+{
+  size_t matched = 0;
+
+  for (; offer_iter.has_more_offers (); offer_iter.next_offer ())
+    {
+      CosTrading::Offer* offer = offer_iter.get_offer ();
+      TAO_Trader_Constraint_Evaluator evaluator (offer);
+      if (constr_inter.evaluate (evaluator))
+        {
+          pref_inter.order_offer (evaluator, offer);
+          ++matched;
+        }
+    }
+
+  CosTrading::Offer* offer = 0;
+  while (pref_inter.remove_offer (offer) == 0)
+    continue;
+
+  return matched;
+}
+
+void
+time_query (Offer_Database& database,
+            const CosTradingRepos::ServiceTypeRepository::TypeStruct& type,
+            const char* constraint,
+            const char* preference)
+{
+  TAO_Trader_Constraint_Validator validator (type);
+  TAO_Constraint_Interpreter constr_inter (validator, constraint);
+  TAO_Preference_Interpreter pref_inter (validator, preference);
+
+  ACE_High_Res_Timer timer;
+  ACE_hrtime_t usecs;
+
+  timer.start ();
+  size_t matched = 0;
+  {
+    Offer_Database::offer_iterator offer_iter (type_name, database);
+    matched = run_query (offer_iter, constr_inter, pref_inter);
+  }
+  timer.stop ();
+  timer.elapsed_microseconds (usecs);
+  ACE_hrtime_t const scan_usecs = usecs;
+
+  TAO_Index_Predicates predicates;
+  constr_inter.index_predicates (predicates);
+  bool descending = false;
+  const char* preference_property = pref_inter.index_property (descending);
+
+  ACE_hrtime_t best_usecs = 0;
+  bool indexed = false;
+  for (int i = 0; i != iterations; ++i)
+    {
+      timer.start ();
+      Offer_Database::indexed_offer_iterator offer_iter (type_name,
+                                                         database,
+                                                         predicates,
+                                                         preference_property,
+                                                         descending);
+      indexed = offer_iter.indexed ();
+      size_t const count = run_query (offer_iter, constr_inter, pref_inter);
+      timer.stop ();
+      timer.elapsed_microseconds (usecs);
+
+      if (count != matched)
+        ORBSVCS_ERROR ((LM_ERROR,
+                        "Query <%C> matched %B offers instead of %B\n",
+                        constraint, count, matched));
+
+      if (i == 0 || usecs < best_usecs)
+        best_usecs = usecs;
+    }
+
+  ORBSVCS_DEBUG ((LM_DEBUG,
+                  "<%C> <%C>: %B matches, scan %Q usecs, "
+                  "%C %Q usecs\n",
+                  constraint, preference, matched, scan_usecs,
+                  indexed ? "indexed" : "not indexed", best_usecs));
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  try
+    {
+      CosTradingRepos::ServiceTypeRepository::TypeStruct type;
+      describe_type (type);
+
+      Offer_Database database;
+      export_offers (database);
+
+      time_query (database, type, "price < 10.0", "");
+      time_query (database, type, "price >= 500.0 and price < 501.0", "");
+      time_query (database, type, "region == 'r42'", "");
+      time_query (database, type, "region == 'r42' and id < 1000", "");
+      time_query (database, type, "price < 50.0", "min price");
+      time_query (database, type, "price > 990.0", "max price");
+      time_query (database, type, "price * 2 < 10.0", "");
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("query");
+      return 1;
+    }
+
+  return 0;
+}
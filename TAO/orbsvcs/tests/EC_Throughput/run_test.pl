@@ -25,6 +25,7 @@ my $test = PerlACE::TestTarget::create_target (5) || die "Create target 5 failed
 $nsiorfile = "NameService.ior";
 $ecconffile = "ec$PerlACE::svcconf_ext";
 $ecmtconffile = "ec$PerlACE::svcconf_ext";
+$ecpartconffile = "ec_partitioned$PerlACE::svcconf_ext";
 
 my $ns_nsiorfile = $ns->LocalFile ($nsiorfile);
 my $es_nsiorfile = $es->LocalFile ($nsiorfile);
@@ -33,6 +34,7 @@ my $sup_nsiorfile = $sup->LocalFile ($nsiorfile);
 my $test_ecconffile = $test->LocalFile ($ecconffile);
 my $es_ecconffile = $es->LocalFile ($ecconffile);
 my $test_ecmtconffile = $test->LocalFile ($ecmtconffile);
+my $test_ecpartconffile = $test->LocalFile ($ecpartconffile);
 $ns->DeleteFile ($nsiorfile);
 $es->DeleteFile ($nsiorfile);
 $con->DeleteFile ($nsiorfile);
@@ -62,6 +64,18 @@ if ($T_status != 0) {
     $status = 1;
 }
 
+print STDERR "================ Collocated tests, partitioned dispatching\n";
+
+$T = $test->CreateProcess ("ECT_Throughput",
+                           "-ORBSvcConf $test_ecpartconffile ".
+                           "-u 10000 -n 1 -t 0 -c 4");
+
+$T_status = $T->SpawnWaitKill ($test->ProcessStartWaitInterval()+105);
+if ($T_status != 0) {
+    print STDERR "ERROR: test returned $T_status\n";
+    $status = 1;
+}
+
 print STDERR "================ Remote test\n";
 
 $NS = $ns->CreateProcess ("$ENV{TAO_ROOT}/orbsvcs/Naming_Service/tao_cosnaming",
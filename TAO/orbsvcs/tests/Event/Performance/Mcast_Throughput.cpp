@@ -0,0 +1,194 @@
+//=============================================================================
+/**
+ *  @file   Mcast_Throughput.cpp
+ *
+ *  Measure the throughput and the CPU cost of the UDP/multicast
+ *  federation path (TAO_ECG_CDR_Message_Sender and
+ *  TAO_ECG_CDR_Message_Receiver) over the loopback interface,
+ *  without an event channel in the middle.
+ */
+//=============================================================================
+
+#include "orbsvcs/Event/ECG_CDR_Message_Sender.h"
+#include "orbsvcs/Event/ECG_CDR_Message_Receiver.h"
+#include "orbsvcs/Event/ECG_UDP_Out_Endpoint.h"
+#include "orbsvcs/Log_Macros.h"
+#include "tao/CDR.h"
+#include "tao/OctetSeqC.h"
+#include "ace/SOCK_Dgram_Mcast.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Profile_Timer.h"
+#include "ace/Get_Opt.h"
+#include "ace/ACE.h"
+
+const ACE_TCHAR *mcast_address = ACE_TEXT ("224.9.9.2:12345");
+int iterations = 100000;
+size_t payload_size = 4096;
+CORBA::ULong mtu = 1024;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("a:i:s:m:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'a':
+        mcast_address = get_opts.opt_arg ();
+        break;
+
+      case 'i':
+        iterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 's':
+        payload_size = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'm':
+        mtu = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                               "usage:  %s "
+                               "-a <mcast address> "
+                               "-i <iterations> "
+                               "-s <payload size> "
+                               "-m <mtu> "
+                               "\n",
+                               argv [0]),
+                              -1);
+      }
+  return 0;
+}
+
+/**
+ * @class Counting_Processor
+ *
+ * @brief Count the complete messages delivered by the receiver.
+ */
+class Counting_Processor : public TAO_ECG_CDR_Processor
+{
+public:
+  Counting_Processor ()
+    : count_ (0)
+  {
+  }
+
+  virtual int decode (TAO_InputCDR &cdr)
+  {
+    CORBA::ULong length;
+    if (!(cdr >> length))
+      return -1;
+    ++this->count_;
+    return 0;
+  }
+
+  int count_;
+};
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  ACE_INET_Addr group (mcast_address);
+
+  ACE_SOCK_Dgram_Mcast mcast;
+  if (mcast.join (group) == -1)
+    ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                           "Cannot join multicast group %s\n",
+                           mcast_address),
+                          1);
+
+  TAO_ECG_UDP_Out_Endpoint *endpoint = nullptr;
+  ACE_NEW_RETURN (endpoint, TAO_ECG_UDP_Out_Endpoint, 1);
+  TAO_ECG_Refcounted_Endpoint endpoint_rptr (endpoint);
+  if (endpoint->dgram ().open (ACE_Addr::sap_any) == -1)
+    ORBSVCS_ERROR_RETURN ((LM_ERROR,
+                           "Cannot open send endpoint\n"),
+                          1);
+
+  TAO_ECG_CDR_Message_Sender sender;
+  sender.init (endpoint_rptr);
+  if (sender.mtu (mtu) == -1)
+    ORBSVCS_ERROR_RETURN ((LM_ERROR, "Invalid MTU %u\n", mtu), 1);
+
+  // Do not pass the send endpoint, the messages sent by this process
+  // are exactly the ones we want to receive.
+  TAO_ECG_CDR_Message_Receiver receiver (0);
+  receiver.init (TAO_ECG_Refcounted_Endpoint ());
+
+  Counting_Processor processor;
+
+  CORBA::OctetSeq payload (static_cast<CORBA::ULong> (payload_size));
+  payload.length (static_cast<CORBA::ULong> (payload_size));
+  for (CORBA::ULong j = 0; j != payload.length (); ++j)
+    payload[j] = static_cast<CORBA::Octet> (j);
+
+  TAO_OutputCDR cdr;
+
+  int lost = 0;
+  ACE_Profile_Timer cpu_timer;
+  ACE_High_Res_Timer wall_timer;
+  cpu_timer.start ();
+  wall_timer.start ();
+
+  for (int i = 0; i != iterations; ++i)
+    {
+      cdr.reset ();
+      if (!(cdr.write_ulong (1)) || !(cdr << payload))
+        ORBSVCS_ERROR_RETURN ((LM_ERROR, "Cannot marshal payload\n"), 1);
+
+      sender.send_message (cdr, group);
+
+      // Drain the fragments, a message with a lost fragment is
+      // abandoned once the socket stays quiet for a while.
+      while (processor.count_ + lost <= i)
+        {
+          ACE_Time_Value timeout (1, 0);
+          if (ACE::handle_read_ready (mcast.get_handle (), &timeout) != 1)
+            {
+              ++lost;
+              break;
+            }
+          if (receiver.handle_input (mcast, &processor) == -1)
+            ORBSVCS_ERROR ((LM_ERROR, "Error receiving message\n"));
+        }
+    }
+
+  wall_timer.stop ();
+  cpu_timer.stop ();
+
+  ACE_Profile_Timer::ACE_Elapsed_Time cpu_time;
+  cpu_timer.elapsed_time (cpu_time);
+
+  ACE_hrtime_t usecs;
+  wall_timer.elapsed_microseconds (usecs);
+
+  double const seconds = static_cast<double> (usecs) / 1000000.0;
+  double const received = processor.count_ > 0 ? processor.count_ : 1;
+  double const cpu_usecs =
+    (cpu_time.user_time + cpu_time.system_time) * 1000000.0;
+
+  ORBSVCS_DEBUG ((LM_DEBUG,
+                  "Messages: %d sent, %d received, %d lost\n"
+                  "Payload: %B bytes, MTU: %u bytes\n"
+                  "Throughput: %.0f events/sec\n"
+                  "CPU per event: %.2f usecs (user + system)\n",
+                  iterations, processor.count_, lost,
+                  payload_size, mtu,
+                  processor.count_ / (seconds > 0 ? seconds : 1),
+                  cpu_usecs / received));
+
+  receiver.shutdown ();
+  sender.shutdown ();
+  mcast.leave (group);
+
+  return lost == 0 ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// Register a number of stand-in servers with the ImR, ask for all of
+// them to be activated at once, and report the time it took for all of
+// them to be active.
+
+#include "tao/ImR_Client/ImplRepoC.h"
+#include "tao/ORB.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/Task.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/SString.h"
+
+#include <atomic>
+
+int servers = 100;
+int threads = 32;
+const char *server_cmd = "./server";
+const char *activator = 0;
+const char *prefix = "MassStart";
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:t:s:a:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        servers = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 't':
+        threads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 's':
+        server_cmd = ACE_TEXT_ALWAYS_CHAR (get_opts.opt_arg ());
+        break;
+
+      case 'a':
+        activator = ACE_TEXT_ALWAYS_CHAR (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <servers> "
+                           "-t <threads> "
+                           "-s <server command> "
+                           "-a <activator> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (servers <= 0 || threads <= 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "%s: -n and -t must be positive\n",
+                       argv [0]),
+                      -1);
+  return 0;
+}
+
+ACE_CString
+server_name (int i)
+{
+  char buf[32];
+  ACE_OS::snprintf (buf, sizeof (buf), "%s_%d", prefix, i);
+  return buf;
+}
+
+/**
+ * @class Activator_Task
+ *
+ * @brief Each thread activates the next server not yet asked for, so
+ * up to as many activations as threads are outstanding on the ImR.
+ */
+class Activator_Task : public ACE_Task_Base
+{
+public:
+  explicit Activator_Task (ImplementationRepository::Administration_ptr imr)
+    : imr_ (ImplementationRepository::Administration::_duplicate (imr)),
+      next_ (0),
+      failures_ (0)
+  {
+  }
+
+  virtual int svc ()
+  {
+    for (int i = this->next_++; i < servers; i = this->next_++)
+      {
+        ACE_CString const name = server_name (i);
+        try
+          {
+            this->imr_->activate_server (name.c_str ());
+          }
+        catch (const CORBA::Exception& ex)
+          {
+            ++this->failures_;
+            ACE_ERROR ((LM_ERROR,
+                        "(%P|%t) client: activation of <%C> failed: %C\n",
+                        name.c_str (), ex._info ().c_str ()));
+          }
+      }
+    return 0;
+  }
+
+  int failures () const
+  {
+    return this->failures_;
+  }
+
+private:
+  ImplementationRepository::Administration_var imr_;
+  std::atomic<int> next_;
+  std::atomic<int> failures_;
+};
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var obj =
+        orb->resolve_initial_references ("ImplRepoService");
+      ImplementationRepository::AdministrationExt_var imr =
+        ImplementationRepository::AdministrationExt::_narrow (obj.in ());
+      if (CORBA::is_nil (imr.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) client: no ImplRepoService\n"),
+                          1);
+
+      char host_name[MAXHOSTNAMELEN + 1];
+      if (activator == 0)
+        {
+          ACE_OS::hostname (host_name, MAXHOSTNAMELEN);
+          activator = host_name;
+        }
+
+      for (int i = 0; i != servers; ++i)
+        {
+          ACE_CString const name = server_name (i);
+          ACE_CString cmdline (server_cmd);
+          cmdline += " -ORBUseIMR 1 -p ";
+          cmdline += name;
+
+          ImplementationRepository::StartupOptions options;
+          options.command_line = cmdline.c_str ();
+          options.activation = ImplementationRepository::NORMAL;
+          options.activator = activator;
+          options.start_limit = 1;
+          imr->add_or_update_server (name.c_str (), options);
+        }
+
+      Activator_Task task (imr.in ());
+
+      ACE_High_Res_Timer timer;
+      timer.start ();
+      task.activate (THR_NEW_LWP | THR_JOINABLE, threads);
+      task.wait ();
+      timer.stop ();
+
+      ACE_hrtime_t usecs;
+      timer.elapsed_microseconds (usecs);
+
+      ACE_OS::printf ("%d servers, %d threads: all active in %.3f secs, "
+                      "%d failed\n",
+                      servers,
+                      threads,
+                      static_cast<double> (usecs) / 1000000.0,
+                      task.failures ());
+
+      if (task.failures () != 0)
+        status = 1;
+
+      // An active server can not be removed until it has gone down,
+      // force_remove_server waits for that.
+      for (int i = 0; i != servers; ++i)
+        {
+          ACE_CString const name = server_name (i);
+          imr->force_remove_server (name.c_str (), 0);
+        }
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("client");
+      return 1;
+    }
+
+  return status;
+}
@@ -0,0 +1,147 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+###############################################################################
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '1';
+
+my $servers_count = 20;
+my $threads = 32;
+my $ping_concurrency = 0;
+my $start_concurrency = 0;
+
+sub usage() {
+    print "Usage: run_test.pl [-servers <num=20>] [-threads <num=32>]\n" .
+          "                   [-pingconcurrency <num=0>] [-startconcurrency <num=0>]\n" .
+          "                   [-debug]\n";
+}
+
+for (my $i = 0; $i <= $#ARGV; $i++) {
+    if ($ARGV[$i] eq "-servers") {
+        $i++;
+        $servers_count = $ARGV[$i];
+    }
+    elsif ($ARGV[$i] eq "-threads") {
+        $i++;
+        $threads = $ARGV[$i];
+    }
+    elsif ($ARGV[$i] eq "-pingconcurrency") {
+        $i++;
+        $ping_concurrency = $ARGV[$i];
+    }
+    elsif ($ARGV[$i] eq "-startconcurrency") {
+        $i++;
+        $start_concurrency = $ARGV[$i];
+    }
+    elsif ($ARGV[$i] eq "-debug") {
+        $debug_level = '10';
+    }
+    else {
+        usage();
+        exit 1;
+    }
+}
+
+my $imr = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $act = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+my $cli = PerlACE::TestTarget::create_target (3) || die "Create target 3 failed\n";
+
+$imriorfile = "imr_locator.ior";
+$actiorfile = "imr_activator.ior";
+
+my $imr_imriorfile = $imr->LocalFile ($imriorfile);
+my $act_imriorfile = $act->LocalFile ($imriorfile);
+my $cli_imriorfile = $cli->LocalFile ($imriorfile);
+my $act_actiorfile = $act->LocalFile ($actiorfile);
+
+$IMR = $imr->CreateProcess ("$ENV{TAO_ROOT}/orbsvcs/ImplRepo_Service/tao_imr_locator");
+$ACT = $act->CreateProcess ("$ENV{TAO_ROOT}/orbsvcs/ImplRepo_Service/tao_imr_activator");
+$CLI = $cli->CreateProcess ("client");
+
+my $server_cmd = $act->LocalFile ("server");
+
+$imr->DeleteFile ($imriorfile);
+$act->DeleteFile ($imriorfile);
+$cli->DeleteFile ($imriorfile);
+$act->DeleteFile ($actiorfile);
+
+print "Activating $servers_count servers, ping concurrency $ping_concurrency, " .
+      "start concurrency $start_concurrency\n";
+
+$IMR->Arguments ("-d $debug_level -o $imr_imriorfile " .
+                 "--pingconcurrency $ping_concurrency " .
+                 "--startconcurrency $start_concurrency");
+$IMR_status = $IMR->Spawn ();
+if ($IMR_status != 0) {
+    print STDERR "ERROR: ImplRepo Service returned $IMR_status\n";
+    exit 1;
+}
+if ($imr->WaitForFileTimed ($imriorfile, $imr->ProcessStartWaitInterval()) == -1) {
+    print STDERR "ERROR: cannot find file <$imr_imriorfile>\n";
+    $IMR->Kill (); $IMR->TimedWait (1);
+    exit 1;
+}
+if ($imr->GetFile ($imriorfile) == -1) {
+    print STDERR "ERROR: cannot retrieve file <$imr_imriorfile>\n";
+    $IMR->Kill (); $IMR->TimedWait (1);
+    exit 1;
+}
+if ($act->PutFile ($imriorfile) == -1) {
+    print STDERR "ERROR: cannot set file <$act_imriorfile>\n";
+    $IMR->Kill (); $IMR->TimedWait (1);
+    exit 1;
+}
+if ($cli->PutFile ($imriorfile) == -1) {
+    print STDERR "ERROR: cannot set file <$cli_imriorfile>\n";
+    $IMR->Kill (); $IMR->TimedWait (1);
+    exit 1;
+}
+
+$ACT->Arguments ("-d $debug_level -o $act_actiorfile " .
+                 "-ORBInitRef ImplRepoService=file://$act_imriorfile");
+$ACT_status = $ACT->Spawn ();
+if ($ACT_status != 0) {
+    print STDERR "ERROR: ImR Activator returned $ACT_status\n";
+    $IMR->Kill (); $IMR->TimedWait (1);
+    exit 1;
+}
+if ($act->WaitForFileTimed ($actiorfile, $act->ProcessStartWaitInterval()) == -1) {
+    print STDERR "ERROR: cannot find file <$act_actiorfile>\n";
+    $ACT->Kill (); $ACT->TimedWait (1);
+    $IMR->Kill (); $IMR->TimedWait (1);
+    exit 1;
+}
+
+$CLI->Arguments ("-n $servers_count -t $threads -s $server_cmd " .
+                 "-ORBInitRef ImplRepoService=file://$cli_imriorfile");
+$CLI_status = $CLI->SpawnWaitKill ($cli->ProcessStartWaitInterval() +
+                                   $servers_count);
+if ($CLI_status != 0) {
+    print STDERR "ERROR: client returned $CLI_status\n";
+    $status = 1;
+}
+
+$ACT_status = $ACT->TerminateWaitKill ($act->ProcessStopWaitInterval());
+if ($ACT_status != 0) {
+    print STDERR "ERROR: ImR Activator returned $ACT_status\n";
+    $status = 1;
+}
+
+$IMR_status = $IMR->TerminateWaitKill ($imr->ProcessStopWaitInterval());
+if ($IMR_status != 0) {
+    print STDERR "ERROR: ImR returned $IMR_status\n";
+    $status = 1;
+}
+
+$imr->DeleteFile ($imriorfile);
+$act->DeleteFile ($imriorfile);
+$cli->DeleteFile ($imriorfile);
+$act->DeleteFile ($actiorfile);
+
+exit $status;
@@ -0,0 +1,81 @@
+// A stand-in server: it only creates the persistent POA the ImR knows
+// it by, so it registers as running and answers the pings, and then
+// waits to be shut down.
+
+#include "tao/PortableServer/PortableServer.h"
+#include "tao/ImR_Client/ImR_Client.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/Log_Msg.h"
+
+const char *poa_name = "MassStart";
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("p:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'p':
+        poa_name = ACE_TEXT_ALWAYS_CHAR (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-p <server name> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var obj = orb->resolve_initial_references ("RootPOA");
+      PortableServer::POA_var root_poa = PortableServer::POA::_narrow (obj.in ());
+      PortableServer::POAManager_var poa_manager = root_poa->the_POAManager ();
+
+      CORBA::PolicyList policies (2);
+      policies.length (2);
+      policies[0] =
+        root_poa->create_id_assignment_policy (PortableServer::USER_ID);
+      policies[1] =
+        root_poa->create_lifespan_policy (PortableServer::PERSISTENT);
+
+      // With -ORBUseIMR 1 the ImR is told the server is running as
+      // the POA is created.
+      PortableServer::POA_var poa =
+        root_poa->create_POA (poa_name, poa_manager.in (), policies);
+
+      policies[0]->destroy ();
+      policies[1]->destroy ();
+
+      poa_manager->activate ();
+
+      orb->run ();
+
+      root_poa->destroy (true, true);
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("server");
+      return 1;
+    }
+
+  return 0;
+}
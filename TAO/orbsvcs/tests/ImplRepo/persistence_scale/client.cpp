@@ -0,0 +1,204 @@
+// Register many servers with the ImR and report the latency of each
+// update, or check that all of them were recovered after the ImR was
+// restarted on its persisted repository and remove them again.
+
+#include "tao/ImR_Client/ImplRepoC.h"
+#include "tao/ORB.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/SString.h"
+
+int servers = 1000;
+bool check = false;
+const char *prefix = "PersistScale";
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:c"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'n':
+        servers = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'c':
+        check = true;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-n <servers> "
+                           "-c "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (servers <= 0)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "%s: -n must be positive\n",
+                       argv [0]),
+                      -1);
+  return 0;
+}
+
+ACE_CString
+server_name (int i)
+{
+  char buf[32];
+  ACE_OS::snprintf (buf, sizeof (buf), "%s_%d", prefix, i);
+  return buf;
+}
+
+/// Accumulate the latency of the individual updates.
+class Latency
+{
+public:
+  Latency ()
+    : total_ (0),
+      max_ (0),
+      count_ (0)
+  {
+  }
+
+  void sample (ACE_High_Res_Timer& timer)
+  {
+    ACE_hrtime_t usecs;
+    timer.elapsed_microseconds (usecs);
+    this->total_ += usecs;
+    if (usecs > this->max_)
+      this->max_ = usecs;
+    ++this->count_;
+  }
+
+  void report (const char *what) const
+  {
+    ACE_OS::printf ("%d servers %s: mean %.1f usecs, max %.1f usecs per update\n",
+                    this->count_,
+                    what,
+                    this->count_ == 0 ? 0.0 :
+                      static_cast<double> (this->total_) / this->count_,
+                    static_cast<double> (this->max_));
+  }
+
+private:
+  ACE_hrtime_t total_;
+  ACE_hrtime_t max_;
+  int count_;
+};
+
+int
+register_servers (ImplementationRepository::Administration_ptr imr)
+{
+  Latency latency;
+  for (int i = 0; i != servers; ++i)
+    {
+      ACE_CString const name = server_name (i);
+      ACE_CString cmdline ("server -ORBUseIMR 1 -p ");
+      cmdline += name;
+
+      ImplementationRepository::StartupOptions options;
+      options.command_line = cmdline.c_str ();
+      options.activation = ImplementationRepository::MANUAL;
+      options.start_limit = 1;
+
+      ACE_High_Res_Timer timer;
+      timer.start ();
+      imr->add_or_update_server (name.c_str (), options);
+      timer.stop ();
+      latency.sample (timer);
+    }
+  latency.report ("registered");
+  return 0;
+}
+
+int
+check_servers (ImplementationRepository::Administration_ptr imr)
+{
+  ImplementationRepository::ServerInformationList_var list;
+  ImplementationRepository::ServerInformationIterator_var iter;
+  imr->list (0, false, list.out (), iter.out ());
+
+  size_t const len = ACE_OS::strlen (prefix);
+  int found = 0;
+  for (CORBA::ULong i = 0; i < list->length (); ++i)
+    {
+      if (ACE_OS::strncmp (list[i].server.in (), prefix, len) == 0)
+        ++found;
+    }
+
+  int status = 0;
+  if (found != servers)
+    {
+      ACE_ERROR ((LM_ERROR,
+                  "(%P|%t) client: ERROR: %d of %d servers recovered\n",
+                  found, servers));
+      status = 1;
+    }
+
+  Latency latency;
+  for (int i = 0; i != servers; ++i)
+    {
+      ACE_CString const name = server_name (i);
+      ACE_High_Res_Timer timer;
+      timer.start ();
+      try
+        {
+          imr->remove_server (name.c_str ());
+        }
+      catch (const ImplementationRepository::NotFound&)
+        {
+          // already reported as missing
+        }
+      timer.stop ();
+      latency.sample (timer);
+    }
+  latency.report ("removed");
+  return status;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int status = 0;
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var obj =
+        orb->resolve_initial_references ("ImplRepoService");
+      ImplementationRepository::Administration_var imr =
+        ImplementationRepository::Administration::_narrow (obj.in ());
+      if (CORBA::is_nil (imr.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "(%P|%t) client: no ImplRepoService\n"),
+                          1);
+
+      if (check)
+        status = check_servers (imr.in ());
+      else
+        status = register_servers (imr.in ());
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("client");
+      return 1;
+    }
+
+  return status;
+}
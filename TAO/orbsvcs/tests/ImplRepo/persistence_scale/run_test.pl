@@ -0,0 +1,164 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+###############################################################################
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+use Time::HiRes qw(time);
+
+$status = 0;
+$debug_level = '1';
+
+my $servers_count = 1000;
+my $store = "journal";
+
+sub usage() {
+    print "Usage: run_test.pl [-servers <num=1000>] " .
+          "[-store journal|xml|shared|heap] [-debug]\n";
+}
+
+for (my $i = 0; $i <= $#ARGV; $i++) {
+    if ($ARGV[$i] eq "-servers") {
+        $i++;
+        $servers_count = $ARGV[$i];
+    }
+    elsif ($ARGV[$i] eq "-store") {
+        $i++;
+        $store = $ARGV[$i];
+    }
+    elsif ($ARGV[$i] eq "-debug") {
+        $debug_level = '10';
+    }
+    else {
+        usage();
+        exit 1;
+    }
+}
+
+my %store_flags = ("journal" => "--journal",
+                   "xml" => "-x",
+                   "shared" => "--directory",
+                   "heap" => "-p");
+my %store_files = ("journal" => "imr_backing_store.journal",
+                   "xml" => "imr_backing_store.xml",
+                   "shared" => "imr_backing_store",
+                   "heap" => "imr_backing_store.repo");
+if (!defined($store_flags{$store})) {
+    usage();
+    exit 1;
+}
+
+my $imr = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $cli = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+
+$imriorfile = "imr_locator.ior";
+
+my $imr_imriorfile = $imr->LocalFile ($imriorfile);
+my $cli_imriorfile = $cli->LocalFile ($imriorfile);
+my $imr_storefile = $imr->LocalFile ($store_files{$store});
+
+$IMR = $imr->CreateProcess ("$ENV{TAO_ROOT}/orbsvcs/ImplRepo_Service/tao_imr_locator");
+$CLI = $cli->CreateProcess ("client");
+
+sub cleanup_store {
+    if ($store eq "shared") {
+        $imr->DeleteFile ("$store_files{$store}/imr_listing.xml");
+        $imr->DeleteFile ("$store_files{$store}/imr_listing.xml.bak");
+        foreach my $file (glob ("$imr_storefile/*.xml*")) {
+            unlink $file;
+        }
+        rmdir $imr_storefile;
+    }
+    else {
+        $imr->DeleteFile ($store_files{$store});
+        $imr->DeleteFile ("$store_files{$store}.lock");
+    }
+}
+
+sub start_imr {
+    my $extra = shift;
+    $imr->DeleteFile ($imriorfile);
+    $cli->DeleteFile ($imriorfile);
+    $IMR->Arguments ("-d $debug_level -o $imr_imriorfile " .
+                     "$store_flags{$store} $imr_storefile $extra");
+    my $start = time ();
+    my $IMR_status = $IMR->Spawn ();
+    if ($IMR_status != 0) {
+        print STDERR "ERROR: ImplRepo Service returned $IMR_status\n";
+        return -1;
+    }
+    if ($imr->WaitForFileTimed ($imriorfile,
+                                $imr->ProcessStartWaitInterval() +
+                                $servers_count / 10) == -1) {
+        print STDERR "ERROR: cannot find file <$imr_imriorfile>\n";
+        $IMR->Kill (); $IMR->TimedWait (1);
+        return -1;
+    }
+    my $elapsed = time () - $start;
+    if ($imr->GetFile ($imriorfile) == -1 ||
+        $cli->PutFile ($imriorfile) == -1) {
+        print STDERR "ERROR: cannot transfer file <$imriorfile>\n";
+        $IMR->Kill (); $IMR->TimedWait (1);
+        return -1;
+    }
+    return $elapsed;
+}
+
+sub stop_imr {
+    my $IMR_status = $IMR->TerminateWaitKill ($imr->ProcessStopWaitInterval());
+    if ($IMR_status != 0) {
+        print STDERR "ERROR: ImR returned $IMR_status\n";
+        $status = 1;
+    }
+}
+
+cleanup_store ();
+if ($store eq "shared") {
+    mkdir $imr_storefile;
+}
+
+print "Persisting $servers_count servers with $store_flags{$store}\n";
+
+if (start_imr ("-e") < 0) {
+    cleanup_store ();
+    exit 1;
+}
+
+$CLI->Arguments ("-n $servers_count " .
+                 "-ORBInitRef ImplRepoService=file://$cli_imriorfile");
+$CLI_status = $CLI->SpawnWaitKill ($cli->ProcessStartWaitInterval() +
+                                   $servers_count / 10);
+if ($CLI_status != 0) {
+    print STDERR "ERROR: client returned $CLI_status\n";
+    $status = 1;
+}
+
+stop_imr ();
+
+my $elapsed = start_imr ("");
+if ($elapsed < 0) {
+    cleanup_store ();
+    exit 1;
+}
+printf ("ImR restarted with %d servers in %.2f secs\n",
+        $servers_count, $elapsed);
+
+$CLI->Arguments ("-n $servers_count -c " .
+                 "-ORBInitRef ImplRepoService=file://$cli_imriorfile");
+$CLI_status = $CLI->SpawnWaitKill ($cli->ProcessStartWaitInterval() +
+                                   $servers_count / 10);
+if ($CLI_status != 0) {
+    print STDERR "ERROR: client returned $CLI_status\n";
+    $status = 1;
+}
+
+stop_imr ();
+
+$imr->DeleteFile ($imriorfile);
+$cli->DeleteFile ($imriorfile);
+cleanup_store ();
+
+exit $status;
@@ -656,6 +656,8 @@ sub manual_persistent_restart_test
         $backing_store = ".";
     } elsif ($backing_store_flag eq "-x") {
         $backing_store = "imr_backing_store.xml";
+    } elsif ($backing_store_flag eq "--journal") {
+        $backing_store = "imr_backing_store.journal";
     }
 
     my $imr_imriorfile = $imr->LocalFile ($imriorfile);
@@ -1005,6 +1007,9 @@ sub manual_persistent_restart_test
     }
     else {
         $imr->DeleteFile ($backing_store);
+        if ($backing_store_flag eq "--journal") {
+            $imr->DeleteFile ("$backing_store.lock");
+        }
     }
     $imr->DeleteFile ($imriorfile);
     $act->DeleteFile ($imriorfile);
@@ -1988,6 +1993,8 @@ sub persistent_ir_test
         $backing_store = ".";
     } elsif ($backing_store_flag eq "-x") {
         $backing_store = "imr_backing_store.xml";
+    } elsif ($backing_store_flag eq "--journal") {
+        $backing_store = "imr_backing_store.journal";
     }
 
     my $imr_imriorfile = $imr->LocalFile ($imriorfile);
@@ -2375,6 +2382,9 @@ sub persistent_ir_test
     }
     else {
         $imr->DeleteFile ($backing_store);
+        if ($backing_store_flag eq "--journal") {
+            $imr->DeleteFile ("$backing_store.lock");
+        }
     }
     $imr->DeleteFile ($imriorfile);
     $act->DeleteFile ($imriorfile);
@@ -3571,7 +3581,8 @@ my @tests = ("airplane", "airplane_ir", "nestea", "nestea_ir",
              "persistent_ir_shared", "persistent_ft", "failover",
              "backup_restart", "manual_persistent_restart",
              "manual_persistent_restart_hash",
-             "manual_persistent_restart_shared");
+             "manual_persistent_restart_shared",
+             "persistent_ir_journal", "manual_persistent_restart_journal");
 
 my @nt_tests = ("nt_service_ir", "persistent_ir_registry", "manual_persistent_restart_registry");
 
@@ -3637,6 +3648,9 @@ for ($i = 0; $i <= $#ARGV; $i++) {
     elsif ($ARGV[$i] eq "manual_persistent_restart_shared") {
         $ret = manual_persistent_restart_test ("--directory");
     }
+    elsif ($ARGV[$i] eq "manual_persistent_restart_journal") {
+        $ret = manual_persistent_restart_test ("--journal");
+    }
     elsif ($ARGV[$i] eq "nestea") {
         $ret = nestea_test ();
     }
@@ -3658,6 +3672,9 @@ for ($i = 0; $i <= $#ARGV; $i++) {
     elsif ($ARGV[$i] eq "persistent_ir_shared") {
         $ret = persistent_ir_test ("--directory");
     }
+    elsif ($ARGV[$i] eq "persistent_ir_journal") {
+        $ret = persistent_ir_test ("--journal");
+    }
     elsif ($ARGV[$i] eq "persistent_ft") {
         $ret = persistent_ft_test ();
     }
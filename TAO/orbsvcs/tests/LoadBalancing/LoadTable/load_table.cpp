@@ -0,0 +1,309 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ * @file load_table.cpp
+ *
+ * Benchmark of the LoadManager's load table under many reporting
+ * load monitors.
+ *
+ * Writer threads stand in for the load monitors, each pushing the
+ * load of its own location at a fixed rate, while reader threads
+ * fetch the loads of random locations as the balancing strategies
+ * do.  The sharded TAO_LB_LoadTable is compared with the single lock
+ * map the LoadManager used before.
+ */
+//=============================================================================
+
+#include "orbsvcs/LoadBalancing/LB_LoadTable.h"
+#include "orbsvcs/LoadBalancing/LB_LoadListMap.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/Guard_T.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_sys_time.h"
+#include "ace/OS_NS_time.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/Task.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace
+{
+  int monitors = 5000;
+  int rate = 10;
+  int writers = 8;
+  int readers = 4;
+  int seconds = 3;
+
+  /// The LoadManager's table before TAO_LB_LoadTable: one map, one
+  /// lock.
+  class Locked_Load_Map
+  {
+  public:
+    explicit Locked_Load_Map (size_t size) : map_ (size) {}
+
+    int push (const PortableGroup::Location & location,
+              const CosLoadBalancing::LoadList & loads)
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, -1);
+      return this->map_.rebind (location, loads) == -1 ? -1 : 0;
+    }
+
+    int find (const PortableGroup::Location & location,
+              CosLoadBalancing::LoadList & loads) const
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, -1);
+      return this->map_.find (location, loads);
+    }
+
+  private:
+    mutable TAO_SYNCH_MUTEX lock_;
+    mutable TAO_LB_LoadListMap map_;
+  };
+
+  struct Result
+  {
+    size_t pushes;
+    double push_p50;
+    double push_p99;
+    double push_max;
+    size_t reads;
+  };
+
+  template <typename TABLE>
+  class Bench : public ACE_Task_Base
+  {
+  public:
+    Bench (TABLE & table, bool paced)
+      : table_ (table),
+        paced_ (paced),
+        locations_ (monitors),
+        next_writer_ (0),
+        next_reader_ (0),
+        stop_ (false),
+        reads_ (0),
+        pushes_ (0),
+        latencies_ (writers)
+    {
+      for (int i = 0; i < monitors; ++i)
+        {
+          char id[32];
+          ACE_OS::snprintf (id, sizeof id, "host-%d", i);
+          this->locations_[i].length (1);
+          this->locations_[i][0].id = CORBA::string_dup (id);
+        }
+    }
+
+    Result run ()
+    {
+      this->activate (THR_NEW_LWP | THR_JOINABLE, writers + readers);
+
+      ACE_OS::sleep (ACE_Time_Value (seconds));
+      this->stop_ = true;
+      this->wait ();
+
+      std::vector<double> all;
+      for (int i = 0; i < writers; ++i)
+        all.insert (all.end (),
+                    this->latencies_[i].begin (),
+                    this->latencies_[i].end ());
+      std::sort (all.begin (), all.end ());
+
+      Result r;
+      r.pushes = this->pushes_;
+      r.push_p50 = all.empty () ? 0 : all[all.size () / 2];
+      r.push_p99 = all.empty () ? 0 : all[all.size () * 99 / 100];
+      r.push_max = all.empty () ? 0 : all.back ();
+      r.reads = this->reads_;
+      return r;
+    }
+
+    virtual int svc ()
+    {
+      const int writer = this->next_writer_++;
+      if (writer < writers)
+        this->write (writer);
+      else
+        this->read (this->next_reader_++);
+      return 0;
+    }
+
+  private:
+    void write (int writer)
+    {
+      // The monitors of this writer, each reporting every period,
+      // spread evenly over the period.
+      std::vector<int> mine;
+      for (int m = writer; m < monitors; m += writers)
+        mine.push_back (m);
+
+      const ACE_Time_Value period (0, 1000000 / rate);
+      const ACE_Time_Value start = ACE_OS::gettimeofday ();
+      CosLoadBalancing::LoadList loads (1);
+      loads.length (1);
+      loads[0].id = 1;
+
+      std::vector<double> & latencies = this->latencies_[writer];
+      size_t pushes = 0;
+
+      for (size_t n = 0; !this->stop_; ++n)
+        {
+          const size_t i = n % mine.size ();
+
+          if (this->paced_)
+            {
+              const size_t round = n / mine.size ();
+              ACE_Time_Value due = period * static_cast<double> (round);
+              due += period * (static_cast<double> (i) / mine.size ());
+              due += start;
+
+              const ACE_Time_Value now = ACE_OS::gettimeofday ();
+              if (due > now)
+                ACE_OS::sleep (due - now);
+            }
+
+          loads[0].value = static_cast<CORBA::Float> (n % 100);
+
+          const ACE_hrtime_t t0 = ACE_OS::gethrtime ();
+          this->table_.push (this->locations_[mine[i]], loads);
+          const ACE_hrtime_t t1 = ACE_OS::gethrtime ();
+
+          if (this->paced_)
+            latencies.push_back (
+              static_cast<double> (t1 - t0)
+              / ACE_High_Res_Timer::global_scale_factor ());
+          ++pushes;
+        }
+
+      this->pushes_ += pushes;
+    }
+
+    void read (int reader)
+    {
+      unsigned int seed = reader + 1;
+      CosLoadBalancing::LoadList loads;
+      size_t reads = 0;
+
+      while (!this->stop_)
+        {
+          const int m = ACE_OS::rand_r (&seed) % monitors;
+          this->table_.find (this->locations_[m], loads);
+          ++reads;
+        }
+
+      this->reads_ += reads;
+    }
+
+    TABLE & table_;
+    const bool paced_;
+    std::vector<PortableGroup::Location> locations_;
+    std::atomic<int> next_writer_;
+    std::atomic<int> next_reader_;
+    std::atomic<bool> stop_;
+    std::atomic<size_t> reads_;
+    std::atomic<size_t> pushes_;
+    std::vector<std::vector<double> > latencies_;
+  };
+
+  template <typename TABLE>
+  void
+  report (const char * name, bool paced)
+  {
+    TABLE table (monitors);
+    Bench<TABLE> bench (table, paced);
+    const Result r = bench.run ();
+
+    if (paced)
+      ACE_DEBUG ((LM_INFO,
+                  "%-10C %10.0f %10.2f %10.2f %10.2f %12.0f\n",
+                  name,
+                  r.pushes / static_cast<double> (seconds),
+                  r.push_p50,
+                  r.push_p99,
+                  r.push_max,
+                  r.reads / static_cast<double> (seconds)));
+    else
+      ACE_DEBUG ((LM_INFO,
+                  "%-10C %10.0f %43.0f\n",
+                  name,
+                  r.pushes / static_cast<double> (seconds),
+                  r.reads / static_cast<double> (seconds)));
+  }
+
+  int
+  parse_args (int argc, ACE_TCHAR *argv[])
+  {
+    ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("m:r:w:g:s:"));
+    int c;
+
+    while ((c = get_opts ()) != -1)
+      switch (c)
+        {
+        case 'm':
+          monitors = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case 'r':
+          rate = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case 'w':
+          writers = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case 'g':
+          readers = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case 's':
+          seconds = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case '?':
+        default:
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "usage:  %s "
+                             "-m <monitors> "
+                             "-r <pushes per second per monitor> "
+                             "-w <writer threads> "
+                             "-g <get_loads threads> "
+                             "-s <seconds>"
+                             "\n",
+                             argv [0]),
+                            -1);
+        }
+
+    if (monitors < 1 || rate < 1 || writers < 1 || readers < 0
+        || seconds < 1)
+      ACE_ERROR_RETURN ((LM_ERROR, "invalid arguments\n"), -1);
+
+    return 0;
+  }
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  ACE_High_Res_Timer::calibrate ();
+
+  ACE_DEBUG ((LM_INFO,
+              "%d monitors pushing at %d Hz from %d threads, "
+              "%d get_loads threads\n",
+              monitors, rate, writers, readers));
+  ACE_DEBUG ((LM_INFO,
+              "%-10C %10C %10C %10C %10C %12C\n",
+              "table", "pushes/s", "p50 usec", "p99 usec", "max usec",
+              "get_loads/s"));
+  report<Locked_Load_Map> ("locked", true);
+  report<TAO_LB_LoadTable> ("sharded", true);
+
+  ACE_DEBUG ((LM_INFO, "unpaced:\n"));
+  report<Locked_Load_Map> ("locked", false);
+  report<TAO_LB_LoadTable> ("sharded", false);
+
+  return 0;
+}
@@ -0,0 +1,26 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+my $args = join (' ', @ARGV);
+if ($args eq '') {
+    # A short run, enough to exercise the tables under concurrency.
+    $args = '-s 1';
+}
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+my $BENCH = $test->CreateProcess ("load_table", $args);
+
+my $status = $BENCH->SpawnWaitKill ($test->ProcessStartWaitInterval () + 60);
+
+if ($status != 0) {
+    print STDERR "ERROR: load_table returned $status\n";
+}
+
+exit $status;
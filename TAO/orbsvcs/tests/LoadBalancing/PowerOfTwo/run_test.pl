@@ -0,0 +1,20 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+
+my $SIM = $test->CreateProcess ("simulation", join (' ', @ARGV));
+
+my $status = $SIM->SpawnWaitKill ($test->ProcessStartWaitInterval () + 60);
+
+if ($status != 0) {
+    print STDERR "ERROR: simulation returned $status\n";
+}
+
+exit $status;
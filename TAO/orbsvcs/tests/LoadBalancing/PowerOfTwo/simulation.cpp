@@ -0,0 +1,263 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ * @file simulation.cpp
+ *
+ * Discrete event simulation comparing member selection strategies
+ * over heterogeneous object group members.
+ *
+ * Every member is stood in for by a FIFO queue with exponentially
+ * distributed service times of its own mean.  Requests arrive as a
+ * Poisson process at a fraction of the total capacity of the members
+ * and are dispatched by the "Random", "RoundRobin" and "PowerOfTwo"
+ * strategies, the latter through the same TAO_LB_LatencyMap the
+ * client request interceptor feeds.  Halfway through the run the
+ * fastest member slows down, to show how quickly each strategy
+ * adapts.
+ */
+//=============================================================================
+
+#include "orbsvcs/LoadBalancing/LB_LatencyMap.h"
+
+#include "ace/Get_Opt.h"
+#include "ace/Log_Msg.h"
+#include "ace/OS_NS_stdlib.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // Mean service times of the members in microseconds.
+  const double default_service[] =
+    { 250.0, 500.0, 500.0, 1000.0, 1000.0, 2000.0, 4000.0, 8000.0 };
+
+  size_t request_count = 200000;
+  double utilization = 0.6;
+  double slowdown = 4.0;
+  ACE_UINT64 decay_time = 10000000;
+  unsigned int seed = 42;
+
+  enum Strategy { RANDOM, ROUND_ROBIN, POWER_OF_TWO };
+
+  const char * const strategy_name[] =
+    { "Random", "RoundRobin", "PowerOfTwo" };
+
+  struct Result
+  {
+    double mean;
+    double p50;
+    double p99;
+    double p999;
+  };
+
+  struct Completion
+  {
+    ACE_UINT64 end;
+    ACE_UINT64 start;
+    size_t member;
+
+    bool operator> (const Completion & rhs) const
+    {
+      return this->end > rhs.end;
+    }
+  };
+
+  int
+  parse_args (int argc, ACE_TCHAR *argv[])
+  {
+    ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("n:u:s:d:r:"));
+    int c;
+
+    while ((c = get_opts ()) != -1)
+      switch (c)
+        {
+        case 'n':
+          request_count = ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+          break;
+        case 'u':
+          utilization = ACE_OS::strtod (get_opts.opt_arg (), 0);
+          break;
+        case 's':
+          slowdown = ACE_OS::strtod (get_opts.opt_arg (), 0);
+          break;
+        case 'd':
+          decay_time = ACE_OS::strtoull (get_opts.opt_arg (), 0, 10);
+          break;
+        case 'r':
+          seed = ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+          break;
+        case '?':
+        default:
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "usage:  %s "
+                             "-n <requests> "
+                             "-u <utilization> "
+                             "-s <slowdown> "
+                             "-d <decay usec> "
+                             "-r <seed>"
+                             "\n",
+                             argv [0]),
+                            -1);
+        }
+
+    if (request_count == 0 || utilization <= 0.0 || utilization >= 1.0)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         "need requests > 0 and 0 < utilization < 1\n"),
+                        -1);
+
+    return 0;
+  }
+
+  double
+  percentile (const std::vector<double> & sorted, double p)
+  {
+    const size_t i = static_cast<size_t> (p * (sorted.size () - 1));
+    return sorted[i];
+  }
+
+  Result
+  run (Strategy strategy)
+  {
+    const size_t member_count =
+      sizeof (default_service) / sizeof (default_service[0]);
+
+    std::vector<double> service (default_service,
+                                 default_service + member_count);
+    double capacity = 0.0;
+    for (size_t i = 0; i < member_count; ++i)
+      capacity += 1.0 / service[i];
+
+    // Every strategy sees the same arrivals and service demands.
+    std::mt19937_64 arrivals (seed);
+    std::mt19937_64 demands (seed + 1);
+    std::mt19937 choices (seed + 2);
+    std::exponential_distribution<double> gap (capacity * utilization);
+    std::exponential_distribution<double> work (1.0);
+
+    TAO_LB_LatencyMap latency_map (decay_time);
+    std::vector<ACE_UINT32> keys (member_count);
+    for (size_t i = 0; i < member_count; ++i)
+      {
+        keys[i] = static_cast<ACE_UINT32> (i + 1);
+        latency_map.watch (keys[i]);
+      }
+
+    std::vector<ACE_UINT64> busy_until (member_count, 0);
+    std::priority_queue<Completion,
+                        std::vector<Completion>,
+                        std::greater<Completion> > pending;
+    std::vector<double> latencies;
+    latencies.reserve (request_count);
+
+    double clock = 0.0;
+    size_t next = 0;
+    double total = 0.0;
+
+    for (size_t n = 0; n < request_count; ++n)
+      {
+        clock += gap (arrivals);
+        const ACE_UINT64 now = static_cast<ACE_UINT64> (clock) + 1;
+
+        // The fastest member degrades halfway through.
+        if (n == request_count / 2)
+          service[0] *= slowdown;
+
+        // Deliver the replies received before this request is sent.
+        while (!pending.empty () && pending.top ().end <= now)
+          {
+            const Completion & c = pending.top ();
+            latency_map.completed (keys[c.member], c.start, c.end,
+                                   true, false);
+            pending.pop ();
+          }
+
+        size_t member = 0;
+        switch (strategy)
+          {
+          case RANDOM:
+            member = choices () % member_count;
+            break;
+          case ROUND_ROBIN:
+            member = next++ % member_count;
+            break;
+          case POWER_OF_TWO:
+            member = latency_map.select (&keys[0],
+                                         static_cast<CORBA::ULong> (member_count),
+                                         now);
+            break;
+          }
+
+        const double demand = work (demands) * service[member];
+        const ACE_UINT64 begin = std::max (now, busy_until[member]);
+        const ACE_UINT64 end = begin + static_cast<ACE_UINT64> (demand) + 1;
+        busy_until[member] = end;
+
+        latency_map.dispatched (keys[member]);
+        Completion c = { end, now, member };
+        pending.push (c);
+
+        const double latency = static_cast<double> (end - now);
+        latencies.push_back (latency);
+        total += latency;
+      }
+
+    std::sort (latencies.begin (), latencies.end ());
+
+    Result result;
+    result.mean = total / latencies.size ();
+    result.p50 = percentile (latencies, 0.50);
+    result.p99 = percentile (latencies, 0.99);
+    result.p999 = percentile (latencies, 0.999);
+    return result;
+  }
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  ACE_DEBUG ((LM_INFO,
+              "%u requests at %.0f%% utilization, "
+              "fastest member slows down %.0fx halfway\n",
+              static_cast<unsigned int> (request_count),
+              utilization * 100.0,
+              slowdown));
+  ACE_DEBUG ((LM_INFO,
+              "%-12s %10s %10s %10s %10s  (usec)\n",
+              "strategy", "mean", "p50", "p99", "p99.9"));
+
+  Result results[3];
+  for (int s = RANDOM; s <= POWER_OF_TWO; ++s)
+    {
+      results[s] = run (static_cast<Strategy> (s));
+      ACE_DEBUG ((LM_INFO,
+                  "%-12s %10.0f %10.0f %10.0f %10.0f\n",
+                  strategy_name[s],
+                  results[s].mean,
+                  results[s].p50,
+                  results[s].p99,
+                  results[s].p999));
+    }
+
+  // Strategies blind to the members' speed overload the slow ones.
+  for (int s = RANDOM; s < POWER_OF_TWO; ++s)
+    {
+      if (results[POWER_OF_TWO].mean >= results[s].mean
+          || results[POWER_OF_TWO].p99 >= results[s].p99)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: PowerOfTwo does not beat %C\n",
+                             strategy_name[s]),
+                            1);
+        }
+    }
+
+  return 0;
+}
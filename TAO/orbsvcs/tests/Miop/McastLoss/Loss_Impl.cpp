@@ -0,0 +1,102 @@
+#include "Loss_Impl.h"
+
+#include "ace/OS_NS_sys_resource.h"
+
+namespace
+{
+  CORBA::ULongLong
+  process_cpu_usecs ()
+  {
+    ACE_Rusage usage;
+    ACE_OS::getrusage (RUSAGE_SELF, &usage);
+
+    ACE_Time_Value const cpu =
+      ACE_Time_Value (usage.ru_utime) + ACE_Time_Value (usage.ru_stime);
+
+    ACE_UINT64 usecs = 0;
+    cpu.to_usec (usecs);
+    return usecs;
+  }
+}
+
+Receiver_Impl::Receiver_Impl ()
+  : received_ (0)
+  , corrupt_ (0)
+{
+}
+
+void
+Receiver_Impl::receive (CORBA::ULong id, Test::Octets const &payload)
+{
+  for (CORBA::ULong i = 0; i < payload.length (); ++i)
+    {
+      if (payload[i] != pattern (id, i))
+        {
+          ACE_ERROR ((LM_ERROR,
+                      ACE_TEXT ("ERROR: message %u is corrupt at byte %u\n"),
+                      id, i));
+          ++this->corrupt_;
+          return;
+        }
+    }
+
+  ++this->received_;
+}
+
+void
+Receiver_Impl::reset ()
+{
+  this->received_ = 0;
+  this->corrupt_ = 0;
+}
+
+CORBA::ULong
+Receiver_Impl::received () const
+{
+  return this->received_;
+}
+
+CORBA::ULong
+Receiver_Impl::corrupt () const
+{
+  return this->corrupt_;
+}
+
+Controller_Impl::Controller_Impl (CORBA::ORB_ptr orb,
+                                  Receiver_Impl *receiver,
+                                  Test::Receiver_ptr obj)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+  , receiver_ (receiver)
+  , obj_ (Test::Receiver::_duplicate (obj))
+  , cpu_usecs_ (process_cpu_usecs ())
+{
+}
+
+Test::Receiver_ptr
+Controller_Impl::get_receiver ()
+{
+  return Test::Receiver::_duplicate (this->obj_.in ());
+}
+
+void
+Controller_Impl::reset ()
+{
+  this->receiver_->reset ();
+  this->cpu_usecs_ = process_cpu_usecs ();
+}
+
+void
+Controller_Impl::counts (CORBA::ULong_out received,
+                         CORBA::ULong_out corrupt,
+                         CORBA::ULongLong_out cpu_usecs)
+{
+  received = this->receiver_->received ();
+  corrupt = this->receiver_->corrupt ();
+  cpu_usecs = process_cpu_usecs () - this->cpu_usecs_;
+}
+
+void
+Controller_Impl::shutdown ()
+{
+  this->orb_->shutdown (false);
+}
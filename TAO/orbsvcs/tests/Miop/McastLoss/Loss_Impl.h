@@ -0,0 +1,65 @@
+#ifndef _LOSS_IMPL_H_
+#define _LOSS_IMPL_H_
+
+#include "LossS.h"
+
+#include <atomic>
+
+/// Content of byte @a offset of message @a id.
+inline CORBA::Octet
+pattern (CORBA::ULong id, CORBA::ULong offset)
+{
+  return static_cast<CORBA::Octet> ((id * 31u + offset) & 0xff);
+}
+
+class Receiver_Impl : public virtual POA_Test::Receiver
+{
+public:
+  Receiver_Impl ();
+
+  // The skeleton methods
+  virtual void receive (CORBA::ULong id, Test::Octets const &payload);
+
+  void reset ();
+
+  CORBA::ULong received () const;
+
+  CORBA::ULong corrupt () const;
+
+private:
+  std::atomic<CORBA::ULong> received_;
+
+  std::atomic<CORBA::ULong> corrupt_;
+};
+
+
+class Controller_Impl : public virtual POA_Test::Controller
+{
+public:
+  Controller_Impl (CORBA::ORB_ptr orb,
+                   Receiver_Impl *receiver,
+                   Test::Receiver_ptr obj);
+
+  // The skeleton methods
+  virtual Test::Receiver_ptr get_receiver ();
+
+  virtual void reset ();
+
+  virtual void counts (CORBA::ULong_out received,
+                       CORBA::ULong_out corrupt,
+                       CORBA::ULongLong_out cpu_usecs);
+
+  virtual void shutdown ();
+
+private:
+  CORBA::ORB_var orb_;
+
+  Receiver_Impl *receiver_;
+
+  Test::Receiver_var obj_;
+
+  /// CPU time of the process at the last reset().
+  CORBA::ULongLong cpu_usecs_;
+};
+
+#endif // _LOSS_IMPL_H_
@@ -0,0 +1,154 @@
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_unistd.h"
+
+#include "Loss_Impl.h"
+
+ACE_TCHAR const *ior = ACE_TEXT ("file://test.ior");
+ACE_TCHAR const *label = ACE_TEXT ("orb");
+CORBA::ULong messages = 2000;
+CORBA::ULong payload_length = 16000;
+CORBA::ULong wait_millis = 1000;
+bool do_shutdown = false;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("k:l:n:p:w:x"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'l':
+        label = get_opts.opt_arg ();
+        break;
+
+      case 'n':
+        messages = ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+        break;
+
+      case 'p':
+        payload_length = ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+        break;
+
+      case 'w':
+        wait_millis = ACE_OS::strtoul (get_opts.opt_arg (), 0, 10);
+        break;
+
+      case 'x':
+        do_shutdown = true;
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage:  %s ")
+                           ACE_TEXT ("-k <ior> ")
+                           ACE_TEXT ("-l <label> ")
+                           ACE_TEXT ("-n <messages> ")
+                           ACE_TEXT ("-p <payload_length> ")
+                           ACE_TEXT ("-w <wait_millis> ")
+                           ACE_TEXT ("-x")
+                           ACE_TEXT ("\n"),
+                           argv [0]),
+                          -1);
+      }
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var tmp = orb->string_to_object (ior);
+
+      Test::Controller_var controller =
+        Test::Controller::_narrow (tmp.in ());
+
+      if (CORBA::is_nil (controller.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("ERROR: nil controller reference <%s>\n"),
+                           ior),
+                          1);
+
+      if (do_shutdown)
+        {
+          controller->shutdown ();
+          orb->destroy ();
+          return 0;
+        }
+
+      Test::Receiver_var receiver = controller->get_receiver ();
+
+      controller->reset ();
+
+      Test::Octets payload (payload_length);
+      payload.length (payload_length);
+
+      ACE_hrtime_t const start = ACE_OS::gethrtime ();
+
+      for (CORBA::ULong id = 0; id < messages; ++id)
+        {
+          for (CORBA::ULong i = 0; i < payload_length; ++i)
+            payload[i] = pattern (id, i);
+
+          receiver->receive (id, payload);
+        }
+
+      ACE_hrtime_t const elapsed = ACE_OS::gethrtime () - start;
+
+      // Let the server catch up with the datagrams still queued.
+      ACE_OS::sleep (ACE_Time_Value (0, wait_millis * 1000));
+
+      CORBA::ULong received = 0;
+      CORBA::ULong corrupt = 0;
+      CORBA::ULongLong cpu_usecs = 0;
+      controller->counts (received, corrupt, cpu_usecs);
+
+      double const seconds =
+        static_cast<double> (elapsed) / ACE_High_Res_Timer::global_scale_factor ()
+        / 1e6;
+
+      ACE_DEBUG ((LM_INFO,
+                  ACE_TEXT ("%-24s %9.2f%% %13.2f %12.2f %10u\n"),
+                  label,
+                  100.0 * (messages - received - corrupt) / messages,
+                  received + corrupt == 0
+                    ? 0.0
+                    : static_cast<double> (cpu_usecs) / (received + corrupt),
+                  seconds > 0
+                    ? messages * static_cast<double> (payload_length)
+                      / seconds / 1e6
+                    : 0.0,
+                  corrupt));
+
+      orb->destroy ();
+
+      if (corrupt != 0 || received == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("ERROR: %u of %u messages received, ")
+                           ACE_TEXT ("%u corrupt\n"),
+                           received, messages, corrupt),
+                          1);
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught in client main ():");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,581 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ * @file mcast_loss.cpp
+ *
+ * Benchmark of the loss and receive CPU time of fragmented messages
+ * multicast over the loopback interface.
+ *
+ * A sender thread splits messages into fragments and multicasts them
+ * as fast as it can, or paced by a TAO_PG::UIPMC_Token_Bucket, to a
+ * receiver with a small socket buffer.  The receiver reads them with
+ * a TAO_PG::UIPMC_Recv_Batch of one datagram, as the MIOP listener
+ * used to, or of several with recvmmsg(), and reassembles them either
+ * like the MIOP listener used to (a map of fragments, each in its own
+ * buffer, copied again into the message) or with pooled
+ * TAO_PG::UIPMC_Recv_Packet slabs.
+ */
+//=============================================================================
+
+#include "orbsvcs/PortableGroup/UIPMC_Recv_Batch.h"
+#include "orbsvcs/PortableGroup/UIPMC_Token_Bucket.h"
+#include "orbsvcs/PortableGroup/UIPMC_Transport_Recv_Packet.h"
+
+#include "ace/ACE.h"
+#include "ace/Get_Opt.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Log_Msg.h"
+#include "ace/Null_Mutex.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_sys_resource.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/SOCK_Dgram_Mcast.h"
+#include "ace/Task.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  const ACE_TCHAR *group = ACE_TEXT ("239.255.42.42");
+  u_short port = 24242;
+  ACE_UINT32 messages = 2000;
+  ACE_UINT32 fragments = 8;
+  ACE_UINT32 fragment_size = 8192;
+  ACE_UINT64 rate = 100000000;
+  ACE_UINT64 burst = 65536;
+  int receive_buffer = 262144;
+  u_long batch = 8;
+
+  /// Header of every fragment, in the byte order of the host as the
+  /// datagrams never leave it.
+  struct Header
+  {
+    ACE_UINT32 message;
+    ACE_UINT32 fragment;
+    ACE_UINT32 count;
+    ACE_UINT32 length;
+  };
+
+  /// Content of byte @a offset of message @a message.
+  inline char
+  pattern (ACE_UINT32 message, size_t offset)
+  {
+    return static_cast<char> ((message * 31u + offset) & 0xff);
+  }
+
+  /// Reassembly as the MIOP listener did before the slabs: a map of
+  /// fragments, each copied into a buffer of its own, and the whole
+  /// message copied again into one buffer once complete.
+  class Map_Packet
+  {
+  public:
+    ~Map_Packet ()
+    {
+      for (Fragments_Map::iterator i = this->fragments_.begin ();
+           i != this->fragments_.end ();
+           ++i)
+        delete [] (*i).item ().buf;
+    }
+
+    int add_fragment (char *data, CORBA::UShort len,
+                      CORBA::ULong id, bool is_last)
+    {
+      Fragment f;
+      ACE_NEW_RETURN (f.buf, char[len], -1);
+      ACE_OS::memcpy (f.buf, data, len);
+      f.len = len;
+
+      if (is_last)
+        this->last_ = id;
+      this->length_ += len;
+
+      if (this->fragments_.bind (id, f) != 0)
+        {
+          delete [] f.buf;
+          return -1;
+        }
+
+      if (!is_last && this->last_ == 0)
+        return 0;
+      if (this->last_ + 1 != this->fragments_.current_size ())
+        return 0;
+      for (CORBA::ULong i = 0; i <= this->last_; ++i)
+        if (this->fragments_.find (i) == -1)
+          return 0;
+      return 1;
+    }
+
+    CORBA::ULong data_length () const { return this->length_; }
+
+    void copy_data (char *buf) const
+    {
+      for (CORBA::ULong i = 0; i <= this->last_; ++i)
+        {
+          Fragment f = { 0, 0 };
+          this->fragments_.find (i, f);
+          ACE_OS::memcpy (buf, f.buf, f.len);
+          buf += f.len;
+        }
+    }
+
+  private:
+    struct Fragment
+    {
+      char *buf;
+      CORBA::UShort len;
+    };
+
+    typedef ACE_Hash_Map_Manager<CORBA::ULong,
+                                 Fragment,
+                                 ACE_Null_Mutex> Fragments_Map;
+
+    CORBA::ULong last_ = 0;
+    CORBA::ULong length_ = 0;
+    mutable Fragments_Map fragments_;
+  };
+
+  class Map_Reassembler
+  {
+  public:
+    ~Map_Reassembler ()
+    {
+      for (Packets_Map::iterator i = this->packets_.begin ();
+           i != this->packets_.end ();
+           ++i)
+        delete (*i).item ();
+    }
+
+    /// Returns the reassembled message, or 0.
+    char *add (const Header &h, char *data, ACE_UINT32 &length)
+    {
+      Map_Packet *packet = 0;
+      if (this->packets_.find (h.message, packet) == -1)
+        {
+          packet = new Map_Packet;
+          this->packets_.bind (h.message, packet);
+        }
+
+      if (packet->add_fragment (data,
+                                static_cast<CORBA::UShort> (h.length),
+                                h.fragment,
+                                h.fragment + 1 == h.count) != 1)
+        return 0;
+
+      this->packets_.unbind (h.message);
+      std::unique_ptr<Map_Packet> owner (packet);
+
+      length = packet->data_length ();
+      this->message_.reset (new char[length + ACE_CDR::MAX_ALIGNMENT]);
+      char *buf =
+        ACE_ptr_align_binary (this->message_.get (), ACE_CDR::MAX_ALIGNMENT);
+      packet->copy_data (buf);
+      return buf;
+    }
+
+  private:
+    typedef ACE_Hash_Map_Manager<ACE_UINT32,
+                                 Map_Packet *,
+                                 ACE_Null_Mutex> Packets_Map;
+    Packets_Map packets_;
+    std::unique_ptr<char[]> message_;
+  };
+
+  /// Reassembly as the MIOP listener does now.
+  class Slab_Reassembler
+  {
+  public:
+    ~Slab_Reassembler ()
+    {
+      for (Packets_Map::iterator i = this->packets_.begin ();
+           i != this->packets_.end ();
+           ++i)
+        delete (*i).item ();
+      for (size_t i = 0; i < this->pool_.size (); ++i)
+        delete this->pool_[i];
+      delete this->done_;
+    }
+
+    char *add (const Header &h, char *data, ACE_UINT32 &length)
+    {
+      // The previous message has been processed.
+      if (this->done_ != 0)
+        {
+          this->pool_.push_back (this->done_);
+          this->done_ = 0;
+        }
+
+      TAO_PG::UIPMC_Recv_Packet *packet = this->last_;
+      if (packet == 0 || this->last_message_ != h.message)
+        {
+          if (this->packets_.find (h.message, packet) == -1)
+            {
+              if (this->pool_.empty ())
+                packet = new TAO_PG::UIPMC_Recv_Packet;
+              else
+                {
+                  packet = this->pool_.back ();
+                  this->pool_.pop_back ();
+                  packet->reset ();
+                }
+              this->packets_.bind (h.message, packet);
+            }
+          this->last_ = packet;
+          this->last_message_ = h.message;
+        }
+
+      if (packet->add_fragment (data,
+                                static_cast<CORBA::UShort> (h.length),
+                                h.fragment,
+                                h.fragment + 1 == h.count,
+                                h.count) != 1)
+        return 0;
+
+      this->packets_.unbind (h.message);
+      this->last_ = 0;
+      this->done_ = packet;
+
+      length = packet->data_length ();
+      char *buf = packet->contiguous_data ();
+      if (buf == 0)
+        {
+          this->message_.reset (new char[length + ACE_CDR::MAX_ALIGNMENT]);
+          buf = ACE_ptr_align_binary (this->message_.get (),
+                                      ACE_CDR::MAX_ALIGNMENT);
+          packet->copy_data (buf);
+        }
+      return buf;
+    }
+
+  private:
+    typedef ACE_Hash_Map_Manager<ACE_UINT32,
+                                 TAO_PG::UIPMC_Recv_Packet *,
+                                 ACE_Null_Mutex> Packets_Map;
+    Packets_Map packets_;
+    TAO_PG::UIPMC_Recv_Packet *last_ = 0;
+    ACE_UINT32 last_message_ = 0;
+    TAO_PG::UIPMC_Recv_Packet *done_ = 0;
+    std::vector<TAO_PG::UIPMC_Recv_Packet *> pool_;
+    std::unique_ptr<char[]> message_;
+  };
+
+  struct Result
+  {
+    ACE_UINT64 datagrams;
+    ACE_UINT32 delivered;
+    ACE_UINT32 corrupt;
+    double cpu_usec;
+    double seconds;
+  };
+
+  double
+  thread_cpu_usec ()
+  {
+    ACE_Rusage usage;
+#if defined (RUSAGE_THREAD)
+    ACE_OS::getrusage (RUSAGE_THREAD, &usage);
+#else
+    ACE_OS::getrusage (RUSAGE_SELF, &usage);
+#endif /* RUSAGE_THREAD */
+    ACE_Time_Value const cpu =
+      ACE_Time_Value (usage.ru_utime) + ACE_Time_Value (usage.ru_stime);
+    return cpu.sec () * 1e6 + cpu.usec ();
+  }
+
+  template <typename REASSEMBLER>
+  class Receiver : public ACE_Task_Base
+  {
+  public:
+    Receiver (ACE_SOCK_Dgram_Mcast &socket, u_long batch_size)
+      : socket_ (socket),
+        batch_ (batch_size, sizeof (Header) + fragment_size),
+        sender_done_ (false)
+    {
+      this->result_.datagrams = 0;
+      this->result_.delivered = 0;
+      this->result_.corrupt = 0;
+      this->result_.cpu_usec = 0.0;
+    }
+
+    void sender_done () { this->sender_done_ = true; }
+
+    const Result &result () const { return this->result_; }
+
+    virtual int svc ()
+    {
+      REASSEMBLER reassembler;
+      double const cpu_start = thread_cpu_usec ();
+      ACE_Time_Value const quiet (0, 200000);
+
+      while (true)
+        {
+          ACE_Time_Value timeout (quiet);
+          int const ready =
+            ACE::handle_read_ready (this->socket_.get_handle (), &timeout);
+          if (ready <= 0)
+            {
+              // Nothing came for a while after the sender was done.
+              if (this->sender_done_)
+                break;
+              continue;
+            }
+
+          int count;
+          while ((count = this->batch_.recv (this->socket_)) > 0)
+            {
+              this->result_.datagrams += count;
+              for (int i = 0; i < count; ++i)
+                this->handle (reassembler,
+                              this->batch_.datagram (i),
+                              this->batch_.length (i));
+            }
+        }
+
+      this->result_.cpu_usec = thread_cpu_usec () - cpu_start;
+      return 0;
+    }
+
+  private:
+    void handle (REASSEMBLER &reassembler, char *datagram, size_t length)
+    {
+      if (length < sizeof (Header))
+        {
+          ++this->result_.corrupt;
+          return;
+        }
+
+      Header h;
+      ACE_OS::memcpy (&h, datagram, sizeof h);
+      if (sizeof (Header) + h.length != length)
+        {
+          ++this->result_.corrupt;
+          return;
+        }
+
+      ACE_UINT32 message_length = 0;
+      char const *message =
+        reassembler.add (h, datagram + sizeof (Header), message_length);
+      if (message == 0)
+        return;
+
+      // Check the first and last byte of every fragment.
+      bool good = message_length == fragments * fragment_size;
+      for (ACE_UINT32 f = 0; good && f < fragments; ++f)
+        {
+          size_t const first = f * fragment_size;
+          size_t const last = first + fragment_size - 1;
+          good = message[first] == pattern (h.message, first)
+            && message[last] == pattern (h.message, last);
+        }
+
+      if (good)
+        ++this->result_.delivered;
+      else
+        ++this->result_.corrupt;
+    }
+
+    ACE_SOCK_Dgram_Mcast &socket_;
+    TAO_PG::UIPMC_Recv_Batch batch_;
+    std::atomic<bool> sender_done_;
+    Result result_;
+  };
+
+  int
+  send_all (ACE_SOCK_Dgram &sender,
+            const ACE_INET_Addr &to,
+            ACE_UINT64 pacing_rate)
+  {
+    TAO_PG::UIPMC_Token_Bucket pacer (pacing_rate, burst);
+    std::vector<char> payload (fragment_size);
+
+    for (ACE_UINT32 m = 0; m < messages; ++m)
+      for (ACE_UINT32 f = 0; f < fragments; ++f)
+        {
+          Header h = { m, f, fragments, fragment_size };
+          for (ACE_UINT32 i = 0; i < fragment_size; ++i)
+            payload[i] = pattern (m, f * fragment_size + i);
+
+          if (pacer.enabled ())
+            {
+              ACE_Time_Value const delay =
+                pacer.reserve (sizeof (Header) + fragment_size);
+              if (delay != ACE_Time_Value::zero)
+                ACE_OS::sleep (delay);
+            }
+
+          iovec iov[2];
+          iov[0].iov_base = reinterpret_cast<char *> (&h);
+          iov[0].iov_len = sizeof h;
+          iov[1].iov_base = &payload[0];
+          iov[1].iov_len = fragment_size;
+
+          // A full send buffer is loss too, just like a full receive
+          // buffer.
+          while (sender.send (iov, 2, to) == -1)
+            {
+              if (errno != ENOBUFS && errno != EAGAIN)
+                ACE_ERROR_RETURN ((LM_ERROR,
+                                   ACE_TEXT ("send failed: %m\n")),
+                                  -1);
+              ACE_OS::thr_yield ();
+            }
+        }
+
+    return 0;
+  }
+
+  template <typename REASSEMBLER>
+  int
+  run (const char *name, u_long batch_size, ACE_UINT64 pacing_rate)
+  {
+    ACE_INET_Addr const to (port, group);
+
+    ACE_SOCK_Dgram_Mcast receiver;
+    if (receiver.join (to, 1, ACE_TEXT ("127.0.0.1")) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("join of %s:%u failed: %m\n"),
+                         group, port),
+                        -1);
+    receiver.enable (ACE_NONBLOCK);
+    ACE_OS::setsockopt (receiver.get_handle (),
+                        SOL_SOCKET,
+                        SO_RCVBUF,
+                        reinterpret_cast<const char *> (&receive_buffer),
+                        sizeof receive_buffer);
+
+    ACE_SOCK_Dgram sender;
+    if (sender.open (ACE_Addr::sap_any, AF_INET) == -1
+        || sender.set_nic (ACE_TEXT ("127.0.0.1"), AF_INET) == -1)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("open of the sender failed: %m\n")),
+                        -1);
+
+    Receiver<REASSEMBLER> task (receiver, batch_size);
+    task.activate (THR_NEW_LWP | THR_JOINABLE, 1);
+
+    ACE_Time_Value const start = ACE_High_Res_Timer::gettimeofday_hr ();
+    int const status = send_all (sender, to, pacing_rate);
+    ACE_Time_Value const sent = ACE_High_Res_Timer::gettimeofday_hr ();
+
+    task.sender_done ();
+    task.wait ();
+    sender.close ();
+    receiver.close ();
+
+    if (status != 0)
+      return -1;
+
+    const Result &r = task.result ();
+    double const seconds = (sent - start).msec () / 1000.0;
+    ACE_DEBUG ((LM_INFO,
+                "%-24C %9.2f%% %13.2f %12.2f %10u\n",
+                name,
+                100.0 * (messages - r.delivered) / messages,
+                r.datagrams == 0 ? 0.0 : r.cpu_usec / r.datagrams,
+                seconds == 0.0
+                  ? 0.0
+                  : messages * fragments * (fragment_size / 1e6) / seconds,
+                r.corrupt));
+
+    if (r.corrupt != 0)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("ERROR: %u corrupt messages\n"),
+                         r.corrupt),
+                        -1);
+    if (r.delivered == 0)
+      ACE_ERROR_RETURN ((LM_ERROR,
+                         ACE_TEXT ("ERROR: nothing delivered, is loopback ")
+                         ACE_TEXT ("multicast available?\n")),
+                        -1);
+    return 0;
+  }
+
+  int
+  parse_args (int argc, ACE_TCHAR *argv[])
+  {
+    ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("g:p:n:f:z:r:B:R:b:"));
+    int c;
+
+    while ((c = get_opts ()) != -1)
+      switch (c)
+        {
+        case 'g':
+          group = get_opts.opt_arg ();
+          break;
+        case 'p':
+          port = static_cast<u_short> (ACE_OS::atoi (get_opts.opt_arg ()));
+          break;
+        case 'n':
+          messages = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case 'f':
+          fragments = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case 'z':
+          fragment_size = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case 'r':
+          rate = ACE_OS::strtoull (get_opts.opt_arg (), 0, 10);
+          break;
+        case 'B':
+          burst = ACE_OS::strtoull (get_opts.opt_arg (), 0, 10);
+          break;
+        case 'R':
+          receive_buffer = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case 'b':
+          batch = ACE_OS::atoi (get_opts.opt_arg ());
+          break;
+        case '?':
+        default:
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "usage:  %s "
+                             "-g <group> "
+                             "-p <port> "
+                             "-n <messages> "
+                             "-f <fragments per message> "
+                             "-z <fragment size> "
+                             "-r <paced bytes per second> "
+                             "-B <paced burst bytes> "
+                             "-R <receive buffer> "
+                             "-b <datagrams per recvmmsg>"
+                             "\n",
+                             argv [0]),
+                            -1);
+        }
+
+    if (messages == 0 || fragments == 0 || fragment_size == 0
+        || fragment_size > 60000 || rate == 0 || batch == 0)
+      ACE_ERROR_RETURN ((LM_ERROR, "invalid arguments\n"), -1);
+
+    return 0;
+  }
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  if (parse_args (argc, argv) != 0)
+    return 1;
+
+  ACE_DEBUG ((LM_INFO,
+              "%u messages of %u fragments of %u bytes to %s:%u, "
+              "%d bytes receive buffer\n",
+              messages, fragments, fragment_size, group, port,
+              receive_buffer));
+  ACE_DEBUG ((LM_INFO,
+              "%-24C %10C %13C %12C %10C\n",
+              "receiver", "lost", "usec/dgram", "sent MB/s", "corrupt"));
+
+  int status = 0;
+  status |= run<Map_Reassembler> ("recv, map", 1, 0);
+  status |= run<Slab_Reassembler> ("recv, slab", 1, 0);
+  status |= run<Slab_Reassembler> ("recvmmsg, slab", batch, 0);
+  status |= run<Slab_Reassembler> ("recvmmsg, slab, paced", batch, rate);
+
+  return status == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+my $test = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $server = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+my $client = PerlACE::TestTarget::create_target (3) || die "Create target 3 failed\n";
+
+my $args = join (' ', @ARGV);
+if ($args eq '') {
+    # A short run, enough to check the messages arrive intact.
+    $args = '-n 500';
+}
+$args .= ' -p ' . $test->RandomPort ();
+
+my $BENCH = $test->CreateProcess ("mcast_loss", $args);
+
+my $status = $BENCH->SpawnWaitKill ($test->ProcessStartWaitInterval () + 60);
+
+if ($status != 0) {
+    print STDERR "ERROR: mcast_loss returned $status\n";
+    exit 1;
+}
+
+# The same loss measured through the ORB: oneways multicast over
+# UIPMC to a servant registered with the GOA.
+my $messages = 500;
+my $payload = 16000;
+
+my $uipmc = "corbaloc:miop:1.0\@1.0-loss-1/239.255.42.43:" . $server->RandomPort ();
+
+my $iorbase = "server.ior";
+my $server_iorfile = $server->LocalFile ($iorbase);
+my $client_iorfile = $client->LocalFile ($iorbase);
+my $server_svcconf = $server->LocalFile ("uipmc_server$PerlACE::svcconf_ext");
+my $client_svcconf = $client->LocalFile ("uipmc_client$PerlACE::svcconf_ext");
+my $paced_svcconf = $client->LocalFile ("uipmc_client_paced$PerlACE::svcconf_ext");
+$server->DeleteFile ($iorbase);
+$client->DeleteFile ($iorbase);
+
+my $SV = $server->CreateProcess ("server",
+                                 "-ORBSvcConf $server_svcconf " .
+                                 "-o $server_iorfile -u $uipmc");
+my $CL = $client->CreateProcess ("client");
+
+if ($SV->Spawn () != 0) {
+    print STDERR "ERROR: server failed to start\n";
+    exit 1;
+}
+
+if ($server->WaitForFileTimed ($iorbase,
+                               $server->ProcessStartWaitInterval ()) == -1) {
+    print STDERR "ERROR: cannot find file <$server_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+if ($server->GetFile ($iorbase) == -1) {
+    print STDERR "ERROR: cannot retrieve file <$server_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+if ($client->PutFile ($iorbase) == -1) {
+    print STDERR "ERROR: cannot set file <$client_iorfile>\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+print STDOUT "$messages messages of $payload bytes to $uipmc\n";
+printf STDOUT ("%-24s %10s %13s %12s %10s\n",
+               "client", "lost", "usec/msg", "sent MB/s", "corrupt");
+
+foreach my $run (["orb", $client_svcconf], ["orb, paced", $paced_svcconf]) {
+    my ($label, $svcconf) = @$run;
+    $CL->Arguments ("-ORBSvcConf $svcconf -k file://$client_iorfile " .
+                    "-n $messages -p $payload -l \"$label\"");
+    my $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval () + 60);
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+}
+
+# Shutdown the server.
+$CL->Arguments ("-ORBSvcConf $client_svcconf -k file://$client_iorfile -x");
+my $client_status = $CL->SpawnWaitKill ($client->ProcessStopWaitInterval ());
+if ($client_status != 0) {
+    print STDERR "ERROR: client returned $client_status\n";
+    $SV->Kill (); $SV->TimedWait (1);
+    exit 1;
+}
+
+my $server_status = $SV->WaitKill ($server->ProcessStopWaitInterval ());
+if ($server_status != 0) {
+    print STDERR "ERROR: server returned $server_status\n";
+    $status = 1;
+}
+
+$server->DeleteFile ($iorbase);
+$client->DeleteFile ($iorbase);
+
+exit $status;
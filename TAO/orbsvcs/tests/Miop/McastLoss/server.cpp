@@ -0,0 +1,120 @@
+#include "ace/Get_Opt.h"
+#include "orbsvcs/PortableGroup/GOA.h"
+
+#include "Loss_Impl.h"
+
+ACE_TCHAR const *uipmc_url =
+  ACE_TEXT ("corbaloc:miop:1.0@1.0-loss-1/239.255.42.43:24243");
+ACE_TCHAR const *ior_output_file = ACE_TEXT ("test.ior");
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT ("o:u:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'o':
+        ior_output_file = get_opts.opt_arg ();
+        break;
+
+      case 'u':
+        uipmc_url = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("usage:  %s ")
+                           ACE_TEXT ("-o <iorfile> ")
+                           ACE_TEXT ("-u <uipmc_url>")
+                           ACE_TEXT ("\n"),
+                           argv [0]),
+                          -1);
+      }
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references ("RootPOA");
+
+      PortableGroup::GOA_var root_goa =
+        PortableGroup::GOA::_narrow (poa_object.in ());
+
+      if (CORBA::is_nil (root_goa.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("ERROR: nil RootPOA\n")),
+                          1);
+
+      PortableServer::POAManager_var poa_manager =
+        root_goa->the_POAManager ();
+
+      // Bind the receiver to the multicast group.
+      CORBA::Object_var obj = orb->string_to_object (uipmc_url);
+
+      PortableServer::ObjectId_var id =
+        root_goa->create_id_for_reference (obj.in ());
+
+      Receiver_Impl *receiver_impl = 0;
+      ACE_NEW_RETURN (receiver_impl,
+                      Receiver_Impl,
+                      1);
+      PortableServer::ServantBase_var owner_transfer1 (receiver_impl);
+
+      root_goa->activate_object_with_id (id.in (), receiver_impl);
+
+      Test::Receiver_var receiver =
+        Test::Receiver::_unchecked_narrow (obj.in ());
+
+      Controller_Impl *controller_impl = 0;
+      ACE_NEW_RETURN (controller_impl,
+                      Controller_Impl (orb.in (),
+                                       receiver_impl,
+                                       receiver.in ()),
+                      1);
+      PortableServer::ServantBase_var owner_transfer2 (controller_impl);
+
+      obj = controller_impl->_this ();
+
+      CORBA::String_var ior = orb->object_to_string (obj.in ());
+
+      FILE *output_file= ACE_OS::fopen (ior_output_file, "w");
+      if (output_file == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           ACE_TEXT ("Cannot open output file ")
+                           ACE_TEXT ("for writing IOR: %s\n"),
+                           ior_output_file),
+                          1);
+      ACE_OS::fprintf (output_file, "%s", ior.in ());
+      ACE_OS::fclose (output_file);
+
+      poa_manager->activate ();
+
+      orb->run ();
+
+      root_goa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught in server main ():");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,37 @@
+
+#ifndef ROUNDTRIP_H
+#define ROUNDTRIP_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+#if defined (_MSC_VER)
+# pragma warning(push)
+# pragma warning (disable:4250)
+#endif /* _MSC_VER */
+
+/// Implement the Test::Roundtrip interface
+class Roundtrip
+  : public virtual POA_Test::Roundtrip
+{
+public:
+  /// Constructor
+  Roundtrip (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual Test::Timestamp test_method (Test::Timestamp send_time);
+
+  virtual void shutdown ();
+
+private:
+  /// Use an ORB reference to convert strings to objects and shutdown
+  /// the application.
+  CORBA::ORB_var orb_;
+};
+
+#if defined(_MSC_VER)
+# pragma warning(pop)
+#endif /* _MSC_VER */
+
+#include /**/ "ace/post.h"
+#endif /* ROUNDTRIP_H */
@@ -0,0 +1,39 @@
+#ifndef ROUNDTRIP_HANDLER_H
+#define ROUNDTRIP_HANDLER_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+#include "ace/Basic_Stats.h"
+#include "ace/High_Res_Timer.h"
+
+/// Implement the Test::AMI_RoundtripHandler interface
+class Roundtrip_Handler
+  : public virtual POA_Test::AMI_RoundtripHandler
+{
+public:
+  /// Constructor
+  Roundtrip_Handler ();
+
+  /// Return the number of replies received so far
+  int completed () const;
+
+  /// Dump the results
+  void dump_results (ACE_High_Res_Timer::global_scale_factor_type gsf);
+
+  // = The skeleton methods
+  virtual void test_method (Test::Timestamp send_time);
+  virtual void test_method_excep (::Messaging::ExceptionHolder *holder);
+
+  virtual void shutdown ();
+  virtual void shutdown_excep (::Messaging::ExceptionHolder *holder);
+
+private:
+  /// The number of replies received
+  int completed_;
+
+  /// Collect the latency results
+  ACE_Basic_Stats latency_stats_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* ROUNDTRIP_HANDLER_H */
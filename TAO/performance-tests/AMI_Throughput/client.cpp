@@ -0,0 +1,152 @@
+#include "Roundtrip_Handler.h"
+#include "tao/debug.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Throughput_Stats.h"
+
+const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
+
+int niterations = 100000;
+
+int window = 1000;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("k:i:w:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'w':
+        window = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-i <niterations> "
+                           "-w <requests in flight> "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (window <= 0)
+    ACE_ERROR_RETURN ((LM_ERROR, "window must be positive\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      if (CORBA::is_nil (poa_object.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Unable to initialize the POA.\n"),
+                          1);
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Roundtrip_var roundtrip =
+        Test::Roundtrip::_narrow (object.in ());
+
+      if (CORBA::is_nil (roundtrip.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Nil Test::Roundtrip reference <%s>\n",
+                           ior),
+                          1);
+
+      for (int j = 0; j < 100; ++j)
+        {
+          ACE_hrtime_t start = 0;
+          (void) roundtrip->test_method (start);
+        }
+
+      Roundtrip_Handler *roundtrip_handler_impl;
+      ACE_NEW_RETURN (roundtrip_handler_impl,
+                      Roundtrip_Handler,
+                      1);
+      PortableServer::ServantBase_var owner_transfer(roundtrip_handler_impl);
+
+      Test::AMI_RoundtripHandler_var roundtrip_handler =
+        roundtrip_handler_impl->_this ();
+
+      poa_manager->activate ();
+
+      ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+
+      // Keep <window> requests outstanding, sending a new one as soon
+      // as the reply to an earlier one arrives.
+      int sent = 0;
+      ACE_Time_Value tv (0, 2000);
+      while (roundtrip_handler_impl->completed () != niterations)
+        {
+          while (sent != niterations
+                 && sent - roundtrip_handler_impl->completed () < window)
+            {
+              roundtrip->sendc_test_method (roundtrip_handler.in (),
+                                            ACE_OS::gethrtime ());
+              ++sent;
+            }
+
+          orb->perform_work (tv);
+        }
+
+      ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+      ACE_DEBUG ((LM_DEBUG, "High resolution timer calibration...."));
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+      ACE_DEBUG ((LM_DEBUG, "done\n"));
+
+      roundtrip_handler_impl->dump_results (gsf);
+
+      ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
+                                             test_end - test_start,
+                                             niterations);
+
+      roundtrip->shutdown ();
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught: ");
+      return 1;
+    }
+
+  return 0;
+}
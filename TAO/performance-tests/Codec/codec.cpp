@@ -0,0 +1,263 @@
+//=============================================================================
+/**
+ *  @file   codec.cpp
+ *
+ * Benchmark the throughput of encoding and decoding a service context
+ * with the CDR encapsulation Codec, comparing the IOP::Codec
+ * operations with the TAO-specific variants that reuse the caller's
+ * octet sequence and Any or skip the Any altogether.
+ */
+//=============================================================================
+
+#include "testC.h"
+#include "tao/debug.h"
+#include "tao/AnyTypeCode/Any.h"
+#include "tao/CodecFactory/CodecFactory.h"
+#include "tao/CodecFactory/CDR_Encaps_Codec.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Stats.h"
+#include "ace/Throughput_Stats.h"
+#include "ace/Sample_History.h"
+#include "ace/Sched_Params.h"
+#include "ace/OS_NS_string.h"
+
+namespace
+{
+  /// Time @a n runs of @a operation and print the statistics.
+  template<typename Operation>
+  void
+  run (ACE_TCHAR const * name, int n, Operation operation)
+  {
+    ACE_Sample_History history (n);
+    ACE_hrtime_t const test_start = ACE_OS::gethrtime ();
+
+    for (int j = 0; j != n; ++j)
+      {
+        ACE_hrtime_t const start = ACE_OS::gethrtime ();
+
+        operation ();
+
+        ACE_hrtime_t const now = ACE_OS::gethrtime ();
+        history.sample (now - start);
+      }
+
+    ACE_hrtime_t const test_end = ACE_OS::gethrtime ();
+
+    ACE_DEBUG ((LM_DEBUG,
+                "%s test finished\n",
+                name));
+
+    ACE_High_Res_Timer::global_scale_factor_type gsf =
+      ACE_High_Res_Timer::global_scale_factor ();
+
+    ACE_Basic_Stats stats;
+    history.collect_basic_stats (stats);
+    stats.dump_results (ACE_TEXT("Total"), gsf);
+
+    ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"),
+                                           gsf,
+                                           test_end - test_start,
+                                           stats.samples_count ());
+
+    ACE_DEBUG ((LM_DEBUG, "\n"));
+  }
+
+  bool
+  same_octets (CORBA::OctetSeq const & lhs, CORBA::OctetSeq const & rhs)
+  {
+    return lhs.length () == rhs.length ()
+      && ACE_OS::memcmp (lhs.get_buffer (),
+                         rhs.get_buffer (),
+                         lhs.length ()) == 0;
+  }
+
+  bool
+  operator== (Test::Request_Context const & lhs,
+              Test::Request_Context const & rhs)
+  {
+    return lhs.activity_id == rhs.activity_id
+      && lhs.priority == rhs.priority
+      && lhs.sequence_number == rhs.sequence_number
+      && ACE_OS::strcmp (lhs.origin.in (), rhs.origin.in ()) == 0;
+  }
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  int priority =
+    (ACE_Sched_Params::priority_min (ACE_SCHED_FIFO)
+     + ACE_Sched_Params::priority_max (ACE_SCHED_FIFO)) / 2;
+
+  ACE_OS::sched_params (ACE_Sched_Params (ACE_SCHED_FIFO,
+                                          priority,
+                                          ACE_SCOPE_PROCESS));
+
+  int n = 100000;
+
+  try
+    {
+      CORBA::ORB_var orb = CORBA::ORB_init (argc, argv);
+
+      ACE_Get_Opt get_opt (argc, argv, ACE_TEXT("dn:"));
+      int opt;
+
+      while ((opt = get_opt ()) != EOF)
+        {
+          switch (opt)
+            {
+            case 'd':
+              TAO_debug_level++;
+              break;
+            case 'n':
+              n = ACE_OS::atoi (get_opt.opt_arg ());
+              break;
+            case '?':
+            default:
+              ACE_DEBUG ((LM_DEBUG,
+                          "Usage: %s "
+                          "-d debug "
+                          "-n <num> "
+                          "\n",
+                          argv[0]));
+              return -1;
+            }
+        }
+
+      CORBA::Object_var obj =
+        orb->resolve_initial_references ("CodecFactory");
+
+      IOP::CodecFactory_var codec_factory =
+        IOP::CodecFactory::_narrow (obj.in ());
+
+      IOP::Encoding const encoding = { IOP::ENCODING_CDR_ENCAPS, 1, 2 };
+
+      IOP::Codec_var codec = codec_factory->create_codec (encoding);
+
+      TAO_CDR_Encaps_Codec * const tao_codec =
+        dynamic_cast<TAO_CDR_Encaps_Codec *> (codec.in ());
+
+      if (tao_codec == 0)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: not a CDR encapsulation Codec\n"),
+                            1);
+        }
+
+      Test::Request_Context context;
+      context.activity_id = ACE_UINT64_LITERAL (0x0123456789abcdef);
+      context.priority = 10;
+      context.sequence_number = 42;
+      context.origin = CORBA::string_dup ("client.example.com");
+
+      CORBA::Any source;
+      source <<= context;
+
+      CORBA::OctetSeq_var encoded = codec->encode_value (source);
+
+      // All the variants must agree on the encapsulation.
+      {
+        CORBA::OctetSeq reused;
+        tao_codec->encode_value (source, reused);
+
+        CORBA::OctetSeq typed;
+        tao_codec->tao_encode_value (context, typed);
+
+        if (!same_octets (reused, encoded.in ())
+            || !same_octets (typed, encoded.in ()))
+          {
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "ERROR: encodings differ\n"),
+                              1);
+          }
+
+        Test::Request_Context decoded;
+        tao_codec->tao_decode_value (encoded.in (), decoded);
+
+        CORBA::Any_var any =
+          codec->decode_value (encoded.in (),
+                               Test::_tc_Request_Context);
+
+        Test::Request_Context const * extracted = 0;
+
+        if (!(decoded == context)
+            || !(any.in () >>= extracted)
+            || !(*extracted == context))
+          {
+            ACE_ERROR_RETURN ((LM_ERROR,
+                               "ERROR: decoded value differs\n"),
+                              1);
+          }
+      }
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "High resolution timer calibration...."));
+      ACE_High_Res_Timer::global_scale_factor ();
+      ACE_DEBUG ((LM_DEBUG,
+                  "done\n\n"));
+
+      run (ACE_TEXT ("IOP::Codec::encode_value"), n,
+           [&] ()
+           {
+             CORBA::Any any;
+             any <<= context;
+             CORBA::OctetSeq_var octets = codec->encode_value (any);
+           });
+
+      CORBA::OctetSeq octets;
+
+      run (ACE_TEXT ("Reusing encode_value"), n,
+           [&] ()
+           {
+             CORBA::Any any;
+             any <<= context;
+             tao_codec->encode_value (any, octets);
+           });
+
+      run (ACE_TEXT ("tao_encode_value"), n,
+           [&] ()
+           {
+             tao_codec->tao_encode_value (context, octets);
+           });
+
+      run (ACE_TEXT ("IOP::Codec::decode_value"), n,
+           [&] ()
+           {
+             CORBA::Any_var any =
+               codec->decode_value (encoded.in (),
+                                    Test::_tc_Request_Context);
+             Test::Request_Context const * value = 0;
+             any.in () >>= value;
+           });
+
+      CORBA::Any any;
+
+      run (ACE_TEXT ("Reusing decode_value"), n,
+           [&] ()
+           {
+             tao_codec->decode_value (encoded.in (),
+                                      Test::_tc_Request_Context,
+                                      any);
+             Test::Request_Context const * value = 0;
+             any >>= value;
+           });
+
+      Test::Request_Context value;
+
+      run (ACE_TEXT ("tao_decode_value"), n,
+           [&] ()
+           {
+             tao_codec->tao_decode_value (encoded.in (), value);
+           });
+
+      orb->destroy ();
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Codec benchmark");
+      return 1;
+    }
+
+  return 0;
+}
@@ -3,7 +3,7 @@
 #include /**/ "ace/pre.h"
 
 #include "TestS.h"
-#include "ace/Basic_Stats.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/High_Res_Timer.h"
 
 /// Implement the Test::Roundtrip interface
@@ -32,7 +32,7 @@ private:
   int pending_callbacks_;
 
   /// Collect the latency results
-  ACE_Basic_Stats latency_stats_;
+  ACE_HDR_Histogram latency_stats_;
 };
 
 #include /**/ "ace/post.h"
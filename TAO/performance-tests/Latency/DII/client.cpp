@@ -8,7 +8,7 @@
 #include "ace/Sched_Params.h"
 #include "ace/Stats.h"
 #include "ace/Throughput_Stats.h"
-#include "ace/Sample_History.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/OS_NS_errno.h"
 
 const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
@@ -109,7 +109,7 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
           request->invoke ();
         }
 
-      ACE_Sample_History history (niterations);
+      ACE_HDR_Histogram histogram;
 
       ACE_hrtime_t test_start = ACE_OS::gethrtime ();
       for (int i = 0; i < niterations; ++i)
@@ -126,7 +126,7 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
           request->invoke ();
 
           ACE_hrtime_t now = ACE_OS::gethrtime ();
-          history.sample (now - start);
+          histogram.sample (now - start);
         }
 
       ACE_hrtime_t test_end = ACE_OS::gethrtime ();
@@ -140,16 +140,14 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
 
       if (do_dump_history)
         {
-          history.dump_samples (ACE_TEXT("HISTORY"), gsf);
+          histogram.dump_buckets (ACE_TEXT("HISTOGRAM"), gsf);
         }
 
-      ACE_Basic_Stats stats;
-      history.collect_basic_stats (stats);
-      stats.dump_results (ACE_TEXT("Total"), gsf);
+      histogram.dump_results (ACE_TEXT("Total"), gsf);
 
       ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
                                              test_end - test_start,
-                                             stats.samples_count ());
+                                             histogram.samples_count ());
 
       if (do_shutdown)
         {
@@ -0,0 +1,67 @@
+#include "Client_Interceptor.h"
+#include "ace/OS_NS_string.h"
+
+unsigned long Client_Interceptor::unexpected_calls = 0;
+
+Client_Interceptor::Client_Interceptor (bool filtered)
+  : filtered_ (filtered)
+{
+}
+
+char *
+Client_Interceptor::name ()
+{
+  // Anonymous, so that several of them can be registered.
+  return CORBA::string_dup ("");
+}
+
+void
+Client_Interceptor::destroy ()
+{
+}
+
+void
+Client_Interceptor::send_request (
+  PortableInterceptor::ClientRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Client_Interceptor::send_poll (
+  PortableInterceptor::ClientRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Client_Interceptor::receive_reply (
+  PortableInterceptor::ClientRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Client_Interceptor::receive_exception (
+  PortableInterceptor::ClientRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Client_Interceptor::receive_other (
+  PortableInterceptor::ClientRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Client_Interceptor::check (PortableInterceptor::ClientRequestInfo_ptr ri)
+{
+  CORBA::String_var op = ri->operation ();
+
+  if (ACE_OS::strcmp (op.in (), "shutdown") != 0 && this->filtered_)
+    {
+      ++Client_Interceptor::unexpected_calls;
+    }
+}
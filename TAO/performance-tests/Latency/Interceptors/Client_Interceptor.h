@@ -0,0 +1,68 @@
+// -*- C++ -*-
+#ifndef CLIENT_INTERCEPTOR_H
+#define CLIENT_INTERCEPTOR_H
+#include /**/ "ace/pre.h"
+
+#include "tao/PI/PI.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/LocalObject.h"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4250)
+#endif /* _MSC_VER */
+
+/// A client request interceptor that only cares about the shutdown
+/// operation.
+/**
+ * The interceptor looks at the operation name at every interception
+ * point, as an interceptor that audits a few operations would.  When
+ * it is registered with an OperationFilterPolicy listing "shutdown"
+ * the ORB should never call it for any other operation; such calls
+ * are counted as errors.
+ */
+class Client_Interceptor
+  : public virtual PortableInterceptor::ClientRequestInterceptor,
+    public virtual ::CORBA::LocalObject
+{
+public:
+  /// Constructor
+  Client_Interceptor (bool filtered);
+
+  virtual char * name ();
+
+  virtual void destroy ();
+
+  virtual void send_request (PortableInterceptor::ClientRequestInfo_ptr ri);
+
+  virtual void send_poll (PortableInterceptor::ClientRequestInfo_ptr ri);
+
+  virtual void receive_reply (PortableInterceptor::ClientRequestInfo_ptr ri);
+
+  virtual void receive_exception (
+    PortableInterceptor::ClientRequestInfo_ptr ri);
+
+  virtual void receive_other (PortableInterceptor::ClientRequestInfo_ptr ri);
+
+  /// Number of calls for operations the interceptor was not
+  /// registered for.
+  static unsigned long unexpected_calls;
+
+private:
+  void check (PortableInterceptor::ClientRequestInfo_ptr ri);
+
+private:
+  /// Was the interceptor registered with an OperationFilterPolicy?
+  bool filtered_;
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif /* _MSC_VER */
+
+#include /**/ "ace/post.h"
+#endif /* CLIENT_INTERCEPTOR_H */
@@ -0,0 +1,67 @@
+#include "Server_Interceptor.h"
+#include "ace/OS_NS_string.h"
+
+unsigned long Server_Interceptor::unexpected_calls = 0;
+
+Server_Interceptor::Server_Interceptor (bool filtered)
+  : filtered_ (filtered)
+{
+}
+
+char *
+Server_Interceptor::name ()
+{
+  // Anonymous, so that several of them can be registered.
+  return CORBA::string_dup ("");
+}
+
+void
+Server_Interceptor::destroy ()
+{
+}
+
+void
+Server_Interceptor::receive_request_service_contexts (
+  PortableInterceptor::ServerRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Server_Interceptor::receive_request (
+  PortableInterceptor::ServerRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Server_Interceptor::send_reply (
+  PortableInterceptor::ServerRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Server_Interceptor::send_exception (
+  PortableInterceptor::ServerRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Server_Interceptor::send_other (
+  PortableInterceptor::ServerRequestInfo_ptr ri)
+{
+  this->check (ri);
+}
+
+void
+Server_Interceptor::check (PortableInterceptor::ServerRequestInfo_ptr ri)
+{
+  CORBA::String_var op = ri->operation ();
+
+  if (ACE_OS::strcmp (op.in (), "shutdown") != 0 && this->filtered_)
+    {
+      ++Server_Interceptor::unexpected_calls;
+    }
+}
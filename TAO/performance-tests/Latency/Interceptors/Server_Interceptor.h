@@ -0,0 +1,65 @@
+// -*- C++ -*-
+#ifndef SERVER_INTERCEPTOR_H
+#define SERVER_INTERCEPTOR_H
+#include /**/ "ace/pre.h"
+
+#include "tao/PI/PI.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/PI_Server/PI_Server.h"
+#include "tao/LocalObject.h"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4250)
+#endif /* _MSC_VER */
+
+/// A server request interceptor that only cares about the shutdown
+/// operation.
+/**
+ * The server side counterpart of Client_Interceptor.
+ */
+class Server_Interceptor
+  : public virtual PortableInterceptor::ServerRequestInterceptor,
+    public virtual ::CORBA::LocalObject
+{
+public:
+  /// Constructor
+  Server_Interceptor (bool filtered);
+
+  virtual char * name ();
+
+  virtual void destroy ();
+
+  virtual void receive_request_service_contexts (
+    PortableInterceptor::ServerRequestInfo_ptr ri);
+
+  virtual void receive_request (PortableInterceptor::ServerRequestInfo_ptr ri);
+
+  virtual void send_reply (PortableInterceptor::ServerRequestInfo_ptr ri);
+
+  virtual void send_exception (PortableInterceptor::ServerRequestInfo_ptr ri);
+
+  virtual void send_other (PortableInterceptor::ServerRequestInfo_ptr ri);
+
+  /// Number of calls for operations the interceptor was not
+  /// registered for.
+  static unsigned long unexpected_calls;
+
+private:
+  void check (PortableInterceptor::ServerRequestInfo_ptr ri);
+
+private:
+  /// Was the interceptor registered with an OperationFilterPolicy?
+  bool filtered_;
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif /* _MSC_VER */
+
+#include /**/ "ace/post.h"
+#endif /* SERVER_INTERCEPTOR_H */
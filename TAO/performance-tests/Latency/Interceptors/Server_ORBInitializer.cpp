@@ -0,0 +1,62 @@
+#include "Server_ORBInitializer.h"
+#include "Server_Interceptor.h"
+#include "tao/PI/ORBInitInfo.h"
+#include "tao/AnyTypeCode/StringSeqA.h"
+#include "tao/ORB_Core.h"
+
+Server_ORBInitializer::Server_ORBInitializer (int count, bool filtered)
+  : count_ (count),
+    filtered_ (filtered)
+{
+}
+
+void
+Server_ORBInitializer::pre_init (PortableInterceptor::ORBInitInfo_ptr)
+{
+}
+
+void
+Server_ORBInitializer::post_init (PortableInterceptor::ORBInitInfo_ptr info)
+{
+  CORBA::PolicyList policies;
+
+  if (this->filtered_)
+    {
+      // TAO-Specific way to get to the ORB Core (and thus, the ORB).
+      TAO_ORBInitInfo_var tao_info = TAO_ORBInitInfo::_narrow (info);
+
+      CORBA::ORB_ptr orb = tao_info->orb_core ()->orb ();
+
+      CORBA::StringSeq operations (1);
+      operations.length (1);
+      operations[0] = CORBA::string_dup ("shutdown");
+
+      CORBA::Any any;
+      any <<= operations;
+
+      policies.length (1);
+      policies[0] =
+        orb->create_policy (PortableInterceptor::OPERATION_FILTER_POLICY_TYPE,
+                            any);
+    }
+
+  PortableInterceptor::ORBInitInfo_3_1_var info_3_1 =
+    PortableInterceptor::ORBInitInfo_3_1::_narrow (info);
+
+  for (int i = 0; i != this->count_; ++i)
+    {
+      PortableInterceptor::ServerRequestInterceptor_ptr tmp;
+      ACE_NEW_THROW_EX (tmp,
+                        Server_Interceptor (this->filtered_),
+                        CORBA::NO_MEMORY ());
+      PortableInterceptor::ServerRequestInterceptor_var interceptor = tmp;
+
+      info_3_1->add_server_request_interceptor_with_policy (interceptor.in (),
+                                                            policies);
+    }
+
+  for (CORBA::ULong i = 0; i != policies.length (); ++i)
+    {
+      policies[i]->destroy ();
+    }
+}
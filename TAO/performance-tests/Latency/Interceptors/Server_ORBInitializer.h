@@ -0,0 +1,47 @@
+// -*- C++ -*-
+#ifndef SERVER_ORBINITIALIZER_H
+#define SERVER_ORBINITIALIZER_H
+#include /**/ "ace/pre.h"
+
+#include "tao/PI/PI.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/LocalObject.h"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4250)
+#endif /* _MSC_VER */
+
+/// Register a number of Server_Interceptors with the ORB
+class Server_ORBInitializer
+  : public virtual PortableInterceptor::ORBInitializer,
+    public virtual ::CORBA::LocalObject
+{
+public:
+  /// Constructor
+  /**
+   * @param count    The number of interceptors to register.
+   * @param filtered Register them with an OperationFilterPolicy
+   *                 listing the shutdown operation.
+   */
+  Server_ORBInitializer (int count, bool filtered);
+
+  virtual void pre_init (PortableInterceptor::ORBInitInfo_ptr info);
+
+  virtual void post_init (PortableInterceptor::ORBInitInfo_ptr info);
+
+private:
+  int count_;
+  bool filtered_;
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif /* _MSC_VER */
+
+#include /**/ "ace/post.h"
+#endif /* SERVER_ORBINITIALIZER_H */
@@ -0,0 +1,218 @@
+#include "TestC.h"
+#include "Client_ORBInitializer.h"
+#include "Client_Interceptor.h"
+#include "tao/ORBInitializer_Registry.h"
+#include "ace/Get_Opt.h"
+#include "ace/Arg_Shifter.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Sched_Params.h"
+#include "ace/Stats.h"
+#include "ace/Throughput_Stats.h"
+#include "ace/HDR_Histogram.h"
+#include "ace/OS_NS_errno.h"
+
+#include "tao/Strategies/advanced_resource.h"
+
+const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
+int niterations = 100;
+int do_dump_history = 0;
+int do_shutdown = 1;
+int ninterceptors = 0;
+bool filtered = false;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("hxk:i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'h':
+        do_dump_history = 1;
+        break;
+
+      case 'x':
+        do_shutdown = 0;
+        break;
+
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-i <niterations> "
+                           "-n <ninterceptors> "
+                           "-f (filter the interceptors) "
+                           "-x (disable shutdown) "
+                           "-h (dump histogram) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Remove the options that control the interceptors from the command
+/// line, they must be known before the ORB is initialized.
+void
+parse_interceptor_args (int &argc, ACE_TCHAR *argv[])
+{
+  ACE_Arg_Shifter arg_shifter (argc, argv);
+
+  while (arg_shifter.is_anything_left ())
+    {
+      const ACE_TCHAR *current_arg = 0;
+
+      if (0 != (current_arg = arg_shifter.get_the_parameter (ACE_TEXT("-n"))))
+        {
+          ninterceptors = ACE_OS::atoi (current_arg);
+          arg_shifter.consume_arg ();
+        }
+      else if (0 == arg_shifter.cur_arg_strncasecmp (ACE_TEXT("-f")))
+        {
+          filtered = true;
+          arg_shifter.consume_arg ();
+        }
+      else
+        {
+          arg_shifter.ignore_arg ();
+        }
+    }
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int priority =
+    (ACE_Sched_Params::priority_min (ACE_SCHED_FIFO)
+     + ACE_Sched_Params::priority_max (ACE_SCHED_FIFO)) / 2;
+  // Enable FIFO scheduling
+
+  if (ACE_OS::sched_params (ACE_Sched_Params (ACE_SCHED_FIFO,
+                                              priority,
+                                              ACE_SCOPE_PROCESS)) != 0)
+    {
+      if (ACE_OS::last_error () == EPERM)
+        {
+          ACE_DEBUG ((LM_DEBUG,
+                      "client (%P|%t): user is not superuser, "
+                      "test runs in time-shared class\n"));
+        }
+      else
+        ACE_ERROR ((LM_ERROR,
+                    "client (%P|%t): sched_params failed\n"));
+    }
+
+  try
+    {
+      parse_interceptor_args (argc, argv);
+
+      PortableInterceptor::ORBInitializer_ptr tmp;
+      ACE_NEW_RETURN (tmp,
+                      Client_ORBInitializer (ninterceptors, filtered),
+                      1);
+      PortableInterceptor::ORBInitializer_var initializer = tmp;
+
+      PortableInterceptor::register_orb_initializer (initializer.in ());
+
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Roundtrip_var roundtrip =
+        Test::Roundtrip::_narrow (object.in ());
+
+      if (CORBA::is_nil (roundtrip.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Nil Test::Roundtrip reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      for (int j = 0; j < 100; ++j)
+        {
+          ACE_hrtime_t start = 0;
+          (void) roundtrip->test_method (start);
+        }
+
+      ACE_HDR_Histogram histogram;
+
+      ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+      for (int i = 0; i < niterations; ++i)
+        {
+          ACE_hrtime_t start = ACE_OS::gethrtime ();
+
+          (void) roundtrip->test_method (start);
+
+          ACE_hrtime_t now = ACE_OS::gethrtime ();
+          histogram.sample (now - start);
+        }
+
+      ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+      ACE_DEBUG ((LM_DEBUG, "test finished\n"));
+
+      ACE_DEBUG ((LM_DEBUG,
+                  "client (%P|%t): %d %C client interceptors\n",
+                  ninterceptors,
+                  filtered ? "filtered" : "unfiltered"));
+
+      ACE_DEBUG ((LM_DEBUG, "High resolution timer calibration...."));
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+      ACE_DEBUG ((LM_DEBUG, "done\n"));
+
+      if (do_dump_history)
+        {
+          histogram.dump_buckets (ACE_TEXT("HISTOGRAM"), gsf);
+        }
+
+      histogram.dump_results (ACE_TEXT("Total"), gsf);
+
+      ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
+                                             test_end - test_start,
+                                             histogram.samples_count ());
+
+      if (do_shutdown)
+        {
+          roundtrip->shutdown ();
+        }
+
+      orb->destroy ();
+
+      if (Client_Interceptor::unexpected_calls != 0)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: client interceptors were called "
+                             "%u times for operations they did not "
+                             "ask for\n",
+                             static_cast<unsigned int> (
+                               Client_Interceptor::unexpected_calls)),
+                            1);
+        }
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,184 @@
+#include "Roundtrip.h"
+#include "Server_ORBInitializer.h"
+#include "Server_Interceptor.h"
+#include "tao/ORBInitializer_Registry.h"
+#include "ace/Get_Opt.h"
+#include "ace/Arg_Shifter.h"
+#include "ace/Sched_Params.h"
+#include "ace/OS_NS_errno.h"
+
+#include "tao/Strategies/advanced_resource.h"
+
+const ACE_TCHAR *ior_output_file = ACE_TEXT("test.ior");
+int ninterceptors = 0;
+bool filtered = false;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("o:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'o':
+        ior_output_file = get_opts.opt_arg ();
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-o <iorfile> "
+                           "-n <ninterceptors> "
+                           "-f (filter the interceptors)"
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+/// Remove the options that control the interceptors from the command
+/// line, they must be known before the ORB is initialized.
+void
+parse_interceptor_args (int &argc, ACE_TCHAR *argv[])
+{
+  ACE_Arg_Shifter arg_shifter (argc, argv);
+
+  while (arg_shifter.is_anything_left ())
+    {
+      const ACE_TCHAR *current_arg = 0;
+
+      if (0 != (current_arg = arg_shifter.get_the_parameter (ACE_TEXT("-n"))))
+        {
+          ninterceptors = ACE_OS::atoi (current_arg);
+          arg_shifter.consume_arg ();
+        }
+      else if (0 == arg_shifter.cur_arg_strncasecmp (ACE_TEXT("-f")))
+        {
+          filtered = true;
+          arg_shifter.consume_arg ();
+        }
+      else
+        {
+          arg_shifter.ignore_arg ();
+        }
+    }
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  int priority =
+    (ACE_Sched_Params::priority_min (ACE_SCHED_FIFO)
+     + ACE_Sched_Params::priority_max (ACE_SCHED_FIFO)) / 2;
+  priority = ACE_Sched_Params::next_priority (ACE_SCHED_FIFO,
+                                                  priority);
+  // Enable FIFO scheduling
+
+  if (ACE_OS::sched_params (ACE_Sched_Params (ACE_SCHED_FIFO,
+                                              priority,
+                                              ACE_SCOPE_PROCESS)) != 0)
+    {
+      if (ACE_OS::last_error () == EPERM)
+        {
+          ACE_DEBUG ((LM_DEBUG,
+                      "server (%P|%t): user is not superuser, "
+                      "test runs in time-shared class\n"));
+        }
+      else
+        ACE_ERROR ((LM_ERROR,
+                    "server (%P|%t): sched_params failed\n"));
+    }
+
+  try
+    {
+      parse_interceptor_args (argc, argv);
+
+      PortableInterceptor::ORBInitializer_ptr tmp;
+      ACE_NEW_RETURN (tmp,
+                      Server_ORBInitializer (ninterceptors, filtered),
+                      1);
+      PortableInterceptor::ORBInitializer_var initializer = tmp;
+
+      PortableInterceptor::register_orb_initializer (initializer.in ());
+
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      CORBA::Object_var poa_object =
+        orb->resolve_initial_references("RootPOA");
+
+      if (CORBA::is_nil (poa_object.in ()))
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           " (%P|%t) Unable to initialize the POA.\n"),
+                          1);
+
+      PortableServer::POA_var root_poa =
+        PortableServer::POA::_narrow (poa_object.in ());
+
+      PortableServer::POAManager_var poa_manager =
+        root_poa->the_POAManager ();
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      Roundtrip *roundtrip_impl;
+      ACE_NEW_RETURN (roundtrip_impl,
+                      Roundtrip (orb.in ()),
+                      1);
+      PortableServer::ServantBase_var owner_transfer(roundtrip_impl);
+
+      PortableServer::ObjectId_var id =
+        root_poa->activate_object (roundtrip_impl);
+
+      CORBA::Object_var object = root_poa->id_to_reference (id.in ());
+
+      Test::Roundtrip_var roundtrip =
+        Test::Roundtrip::_narrow (object.in ());
+
+      CORBA::String_var ior =
+        orb->object_to_string (roundtrip.in ());
+
+      // If the ior_output_file exists, output the ior to it
+      FILE *output_file= ACE_OS::fopen (ior_output_file, "w");
+      if (output_file == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Cannot open output file for writing IOR: %s",
+                           ior_output_file),
+                          1);
+      ACE_OS::fprintf (output_file, "%s", ior.in ());
+      ACE_OS::fclose (output_file);
+
+      poa_manager->activate ();
+
+      orb->run ();
+
+      ACE_DEBUG ((LM_DEBUG, "(%P|%t) server - event loop finished\n"));
+
+      root_poa->destroy (true, true);
+
+      orb->destroy ();
+
+      if (Server_Interceptor::unexpected_calls != 0)
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "ERROR: server interceptors were called "
+                             "%u times for operations they did not "
+                             "ask for\n",
+                             static_cast<unsigned int> (
+                               Server_Interceptor::unexpected_calls)),
+                            1);
+        }
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include "Client_Task.h"
+#include "ace/OS_NS_time.h"
+
+Client_Task::Client_Task (Test::Roundtrip_ptr roundtrip,
+                          int niterations)
+  : roundtrip_ (Test::Roundtrip::_duplicate (roundtrip))
+  , niterations_ (niterations)
+{
+}
+
+ACE_HDR_Histogram const &
+Client_Task::histogram () const
+{
+  return this->histogram_;
+}
+
+int
+Client_Task::svc ()
+{
+  try
+    {
+      this->validate_connection ();
+
+      for (int i = 0; i != this->niterations_; ++i)
+        {
+          ACE_hrtime_t start = ACE_OS::gethrtime ();
+
+          (void) this->roundtrip_->test_method (start);
+
+          ACE_hrtime_t now = ACE_OS::gethrtime ();
+          this->histogram_.sample (now - start);
+        }
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Client_Task::svc:");
+      return -1;
+    }
+  return 0;
+}
+
+void
+Client_Task::validate_connection ()
+{
+  CORBA::ULongLong dummy = 0;
+  for (int i = 0; i != 100; ++i)
+    {
+      try
+        {
+          (void) this->roundtrip_->test_method (dummy);
+        }
+      catch (const CORBA::Exception&){}
+    }
+}
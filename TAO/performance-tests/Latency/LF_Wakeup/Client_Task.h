@@ -0,0 +1,39 @@
+#ifndef CLIENT_TASK_H
+#define CLIENT_TASK_H
+#include /**/ "ace/pre.h"
+
+#include "TestC.h"
+#include "ace/Task.h"
+#include "ace/HDR_Histogram.h"
+
+/// Run the requests of one client thread
+class Client_Task : public ACE_Task_Base
+{
+public:
+  /// Constructor
+  Client_Task (Test::Roundtrip_ptr roundtrip,
+               int niterations);
+
+  /// The latency of each request made by this thread
+  ACE_HDR_Histogram const &histogram () const;
+
+  /// The service method
+  virtual int svc ();
+
+private:
+  /// Make sure that the connection is established and warm.
+  void validate_connection ();
+
+private:
+  /// The object reference used for this test
+  Test::Roundtrip_var roundtrip_;
+
+  /// The number of iterations
+  int niterations_;
+
+  /// Keep track of the latency of the requests
+  ACE_HDR_Histogram histogram_;
+};
+
+#include /**/ "ace/post.h"
+#endif /* CLIENT_TASK_H */
@@ -0,0 +1,153 @@
+#include "Client_Task.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/Stats.h"
+#include "ace/Throughput_Stats.h"
+
+#include "tao/ORB_Core.h"
+#include "tao/Leader_Follower.h"
+#include "tao/Strategies/advanced_resource.h"
+
+#include <memory>
+#include <vector>
+
+const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
+int niterations = 1000;
+int nthreads = 8;
+int do_shutdown = 1;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("xk:i:n:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'x':
+        do_shutdown = 0;
+        break;
+
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'n':
+        nthreads = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-i <niterations> "
+                           "-n <nthreads> "
+                           "-x (disable shutdown) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (nthreads <= 0)
+    ACE_ERROR_RETURN ((LM_ERROR, "invalid number of threads\n"), -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  // Unlike the other latency tests this one runs in the time-shared
+  // class: with real-time priorities and a single CPU each client
+  // thread would run all its requests before the next one starts and
+  // no thread would ever wait as a follower.
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Roundtrip_var roundtrip =
+        Test::Roundtrip::_narrow (object.in ());
+
+      if (CORBA::is_nil (roundtrip.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Nil Test::Roundtrip reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      TAO_Leader_Follower &leader_follower =
+        orb->orb_core ()->leader_follower ();
+
+      std::vector<std::unique_ptr<Client_Task> > tasks;
+      for (int i = 0; i != nthreads; ++i)
+        tasks.emplace_back (new Client_Task (roundtrip.in (), niterations));
+
+      ACE_DEBUG ((LM_DEBUG, "Starting %d threads\n", nthreads));
+
+      TAO_Leader_Follower::Statistics const before =
+        leader_follower.statistics ();
+
+      ACE_hrtime_t test_start = ACE_OS::gethrtime ();
+      for (auto const &task : tasks)
+        task->activate (THR_NEW_LWP | THR_JOINABLE);
+      for (auto const &task : tasks)
+        task->wait ();
+      ACE_hrtime_t test_end = ACE_OS::gethrtime ();
+
+      TAO_Leader_Follower::Statistics const after =
+        leader_follower.statistics ();
+
+      ACE_DEBUG ((LM_DEBUG, "Threads finished\n"));
+
+      ACE_DEBUG ((LM_DEBUG, "High resolution timer calibration...."));
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+      ACE_DEBUG ((LM_DEBUG, "done\n"));
+
+      ACE_HDR_Histogram totals;
+      for (auto const &task : tasks)
+        totals.accumulate (task->histogram ());
+
+      totals.dump_results (ACE_TEXT("Total"), gsf);
+
+      ACE_Throughput_Stats::dump_throughput (ACE_TEXT("Total"), gsf,
+                                             test_end - test_start,
+                                             totals.samples_count ());
+
+      ACE_UINT64 const requests = totals.samples_count ();
+      ACE_DEBUG ((LM_DEBUG,
+                  "Leader changes: %Q, reply wake-ups: %Q, "
+                  "spurious wake-ups: %Q (%Q requests)\n",
+                  after.leader_changes - before.leader_changes,
+                  after.event_wakeups - before.event_wakeups,
+                  after.spurious_wakeups - before.spurious_wakeups,
+                  requests));
+
+      if (do_shutdown)
+        {
+          roundtrip->shutdown ();
+        }
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
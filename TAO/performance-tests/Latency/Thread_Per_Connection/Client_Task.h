@@ -4,7 +4,7 @@
 
 #include "TestC.h"
 #include "ace/Task.h"
-#include "ace/Basic_Stats.h"
+#include "ace/HDR_Histogram.h"
 #include "ace/High_Res_Timer.h"
 
 /// Implement the Test::Client_Task interface
@@ -17,7 +17,7 @@ public:
 
   /// Add this thread results to the global numbers and print the
   /// per-thread results.
-  void accumulate_and_dump (ACE_Basic_Stats &totals,
+  void accumulate_and_dump (ACE_HDR_Histogram &totals,
                             const ACE_TCHAR *msg,
                             ACE_High_Res_Timer::global_scale_factor_type gsf);
 
@@ -35,8 +35,9 @@ private:
   /// The number of iterations
   int niterations_;
 
-  /// Keep track of the latency (minimum, average, maximum and jitter)
-  ACE_Basic_Stats latency_;
+  /// Keep track of the latency (minimum, average, maximum and
+  /// percentiles)
+  ACE_HDR_Histogram latency_;
 };
 
 #include /**/ "ace/post.h"
@@ -34,7 +34,7 @@ Client_Task::svc ()
 
 void
 Client_Task::accumulate_and_dump (
-  ACE_Basic_Stats &totals,
+  ACE_HDR_Histogram &totals,
   const ACE_TCHAR *msg,
   ACE_High_Res_Timer::global_scale_factor_type gsf)
 {
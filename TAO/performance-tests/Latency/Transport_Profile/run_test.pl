@@ -0,0 +1,142 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+     & eval 'exec perl -S $0 $argv:q'
+     if 0;
+
+# -*- perl -*-
+
+use lib "$ENV{ACE_ROOT}/bin";
+use PerlACE::TestTarget;
+
+$status = 0;
+$debug_level = '0';
+
+foreach $i (@ARGV) {
+    if ($i eq '-debug') {
+        $debug_level = '10';
+    }
+}
+
+$iteration = 100000;
+
+for ($iter = 0; $iter <= $#ARGV; $iter++) {
+    if ($ARGV[$iter] eq "-h" || $ARGV[$iter] eq "-?") {
+        print "Run_Test Perl script for Transport Profile Latency test\n\n";
+        print "run_test [-n num] [-h] \n";
+        print "\n";
+        print "-n num              -- runs the client num times\n";
+        print "-h                  -- prints this information\n";
+        exit 0;
+    }
+    elsif ($ARGV[$iter] eq "-n") {
+        $iteration = $ARGV[$iter + 1];
+        $i++;
+    }
+}
+
+print STDERR "================ Transport Profile Latency Test\n";
+
+my $server = PerlACE::TestTarget::create_target (1) || die "Create target 1 failed\n";
+my $client = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
+
+my $iorbase = "test.ior";
+my $server_iorfile = $server->LocalFile ($iorbase);
+my $client_iorfile = $client->LocalFile ($iorbase);
+my $server_profilebase = "server.profile";
+my $client_profilebase = "client.profile";
+my $server_profile = $server->LocalFile ($server_profilebase);
+my $client_profile = $client->LocalFile ($client_profilebase);
+$server->DeleteFile($iorbase);
+$client->DeleteFile($iorbase);
+$server->DeleteFile($server_profilebase);
+$client->DeleteFile($client_profilebase);
+
+# Run a server and a client, passing the extra options to both.
+sub run_test {
+    my ($server_args, $client_args) = @_;
+
+    $SV = $server->CreateProcess ("server",
+                                  "-ORBdebuglevel $debug_level " .
+                                  "$server_args -o $server_iorfile");
+
+    $server_status = $SV->Spawn ();
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server returned $server_status\n";
+        exit 1;
+    }
+
+    if ($server->WaitForFileTimed ($iorbase,
+                                   $server->ProcessStartWaitInterval()) == -1) {
+        print STDERR "ERROR: cannot find file <$server_iorfile>\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    if ($server->GetFile ($iorbase) == -1) {
+        print STDERR "ERROR: cannot retrieve file <$server_iorfile>\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    if ($client->PutFile ($iorbase) == -1) {
+        print STDERR "ERROR: cannot set file <$client_iorfile>\n";
+        $SV->Kill (); $SV->TimedWait (1);
+        exit 1;
+    }
+
+    $CL = $client->CreateProcess ("client",
+                                  "$client_args " .
+                                  "-k file://$client_iorfile -i $iteration");
+
+    $client_status = $CL->SpawnWaitKill ($client->ProcessStartWaitInterval() + 105);
+
+    if ($client_status != 0) {
+        print STDERR "ERROR: client returned $client_status\n";
+        $status = 1;
+    }
+
+    $server_status = $SV->WaitKill ($server->ProcessStopWaitInterval());
+
+    if ($server_status != 0) {
+        print STDERR "ERROR: server returned $server_status\n";
+        $status = 1;
+    }
+
+    $server->DeleteFile($iorbase);
+    $client->DeleteFile($iorbase);
+}
+
+print STDERR "================ Without profile\n";
+
+run_test ("", "");
+
+print STDERR "================ With profile\n";
+
+run_test ("-ORBTransportProfile $server_profile",
+          "-ORBTransportProfile $client_profile");
+
+foreach $profile ($server_profile, $client_profile) {
+    if (! -f $profile) {
+        print STDERR "ERROR: no transport profile <$profile>\n";
+        $status = 1;
+    }
+}
+
+if ($status == 0) {
+    print STDERR "================ Suggested options\n";
+
+    $TU = $client->CreateProcess ("$ENV{ACE_ROOT}/bin/tao_transport_tuner",
+                                  "$server_profile $client_profile");
+
+    $tuner_status = $TU->SpawnWaitKill ($client->ProcessStartWaitInterval());
+
+    if ($tuner_status != 0) {
+        print STDERR "ERROR: tao_transport_tuner returned $tuner_status\n";
+        $status = 1;
+    }
+}
+
+$server->DeleteFile($server_profilebase);
+$client->DeleteFile($client_profilebase);
+
+exit $status;
@@ -0,0 +1,19 @@
+#ifndef PEAK_MEMORY_H
+#define PEAK_MEMORY_H
+#include /**/ "ace/pre.h"
+
+#include "ace/OS_NS_sys_resource.h"
+
+/// Peak resident set size of the process, in kilobytes, or 0 where
+/// getrusage() does not report it.
+inline ACE_UINT64
+peak_memory ()
+{
+  rusage usage;
+  if (ACE_OS::getrusage (RUSAGE_SELF, &usage) == -1)
+    return 0;
+  return static_cast<ACE_UINT64> (usage.ru_maxrss);
+}
+
+#include /**/ "ace/post.h"
+#endif /* PEAK_MEMORY_H */
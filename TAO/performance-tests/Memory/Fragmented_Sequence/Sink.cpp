@@ -0,0 +1,22 @@
+#include "Sink.h"
+#include "Peak_Memory.h"
+
+Sink::Sink (CORBA::ORB_ptr orb)
+  : orb_ (CORBA::ORB::_duplicate (orb))
+{
+}
+
+CORBA::ULong
+Sink::consume (const Test::Payload &data)
+{
+  return data.length ();
+}
+
+void
+Sink::shutdown ()
+{
+  ACE_DEBUG ((LM_DEBUG,
+              "server peak memory: %Q KB\n",
+              peak_memory ()));
+  this->orb_->shutdown (false);
+}
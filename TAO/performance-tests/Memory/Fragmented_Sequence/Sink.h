@@ -0,0 +1,35 @@
+#ifndef SINK_H
+#define SINK_H
+#include /**/ "ace/pre.h"
+
+#include "TestS.h"
+
+#if defined (_MSC_VER)
+# pragma warning(push)
+# pragma warning (disable:4250)
+#endif /* _MSC_VER */
+
+/// Implement the Test::Sink interface
+class Sink
+  : public virtual POA_Test::Sink
+{
+public:
+  /// Constructor
+  Sink (CORBA::ORB_ptr orb);
+
+  // = The skeleton methods
+  virtual CORBA::ULong consume (const Test::Payload &data);
+
+  virtual void shutdown ();
+
+private:
+  /// Use an ORB reference to shutdown the application.
+  CORBA::ORB_var orb_;
+};
+
+#if defined(_MSC_VER)
+# pragma warning(pop)
+#endif /* _MSC_VER */
+
+#include /**/ "ace/post.h"
+#endif /* SINK_H */
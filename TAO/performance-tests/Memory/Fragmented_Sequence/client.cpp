@@ -0,0 +1,139 @@
+#include "TestC.h"
+#include "Peak_Memory.h"
+#include "ace/Get_Opt.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/OS_NS_string.h"
+
+const ACE_TCHAR *ior = ACE_TEXT("file://test.ior");
+CORBA::ULong size_mb = 64;
+int niterations = 4;
+int do_shutdown = 1;
+
+int
+parse_args (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("xk:s:i:"));
+  int c;
+
+  while ((c = get_opts ()) != -1)
+    switch (c)
+      {
+      case 'x':
+        do_shutdown = 0;
+        break;
+
+      case 'k':
+        ior = get_opts.opt_arg ();
+        break;
+
+      case 's':
+        size_mb = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case 'i':
+        niterations = ACE_OS::atoi (get_opts.opt_arg ());
+        break;
+
+      case '?':
+      default:
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "usage:  %s "
+                           "-k <ior> "
+                           "-s <payload size in MB> "
+                           "-i <niterations> "
+                           "-x (disable shutdown) "
+                           "\n",
+                           argv [0]),
+                          -1);
+      }
+
+  if (size_mb == 0 || size_mb >= 4096)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "the payload size must be between 1 and 4095 MB\n"),
+                      -1);
+
+  // Indicates successful parsing of the command line
+  return 0;
+}
+
+int
+ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  try
+    {
+      CORBA::ORB_var orb =
+        CORBA::ORB_init (argc, argv);
+
+      if (parse_args (argc, argv) != 0)
+        return 1;
+
+      CORBA::Object_var object =
+        orb->string_to_object (ior);
+
+      Test::Sink_var sink =
+        Test::Sink::_narrow (object.in ());
+
+      if (CORBA::is_nil (sink.in ()))
+        {
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Nil Test::Sink reference <%s>\n",
+                             ior),
+                            1);
+        }
+
+      CORBA::ULong const length = size_mb * 1024 * 1024;
+      Test::Payload payload (length);
+      payload.length (length);
+      ACE_OS::memset (payload.get_buffer (), 'x', length);
+
+      ACE_UINT64 const base_memory = peak_memory ();
+
+      ACE_High_Res_Timer::global_scale_factor_type gsf =
+        ACE_High_Res_Timer::global_scale_factor ();
+
+      int status = 0;
+      for (int i = 0; i != niterations; ++i)
+        {
+          ACE_hrtime_t start = ACE_OS::gethrtime ();
+
+          CORBA::ULong const received = sink->consume (payload);
+
+          ACE_hrtime_t now = ACE_OS::gethrtime ();
+
+          if (received != length)
+            {
+              ACE_ERROR ((LM_ERROR,
+                          "ERROR: server received %u bytes instead of %u\n",
+                          received, length));
+              status = 1;
+            }
+
+          ACE_DEBUG ((LM_DEBUG,
+                      "%u MB sent in %.2f msec\n",
+                      size_mb,
+                      static_cast<double> (now - start) / gsf / 1000.0));
+        }
+
+      ACE_UINT64 const peak = peak_memory ();
+      ACE_DEBUG ((LM_DEBUG,
+                  "client peak memory: %Q KB, %Q KB above the payload\n",
+                  peak,
+                  peak - base_memory));
+
+      if (do_shutdown)
+        {
+          sink->shutdown ();
+        }
+
+      orb->destroy ();
+
+      return status;
+    }
+  catch (const CORBA::Exception& ex)
+    {
+      ex._tao_print_exception ("Exception caught:");
+      return 1;
+    }
+
+  return 0;
+}
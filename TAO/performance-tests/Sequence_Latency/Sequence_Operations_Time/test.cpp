@@ -5,6 +5,8 @@
 #include "ace/OS_NS_strings.h"
 #include "ace/Log_Msg.h"
 
+#include <utility>
+
 
 const char * short_str = "abcdefghijklmnopqrstuvwxyz";
 const char * long_str = "ABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLMNOPQRSTUVWXYZ";
@@ -183,6 +185,76 @@ void big_time_test (CORBA::ULong num_list_loops,
     }
 }
 
+/// Builds the reply of an operation returning a LongSeq the way a
+/// servant does: fill a local sequence and hand the ORB a heap copy of
+/// it, either copying or moving the local one.
+struct Long_Source
+{
+  bool use_move_;
+
+  LongSeq * get_longs (CORBA::ULong length)
+  {
+    LongSeq result;
+    result.length (length);
+    for (CORBA::ULong i = 0; i != length; ++i)
+      result[i] = static_cast<CORBA::Long> (i);
+
+    if (this->use_move_)
+      return new LongSeq (std::move (result));
+    return new LongSeq (result);
+  }
+};
+
+void return_time_test (CORBA::ULong num_loops,
+                       CORBA::ULong length,
+                       bool use_move)
+{
+  ACE_High_Res_Timer timer;
+  ACE_hrtime_t time;
+
+  Long_Source servant;
+  servant.use_move_ = use_move;
+
+  CORBA::ULong total = 0;
+
+  // start timing
+  timer.start();
+
+  for (CORBA::ULong idx = 0; idx < num_loops; ++idx)
+  {
+    LongSeq_var reply = servant.get_longs (length);
+    total += reply->length ();
+  }
+  // end timing
+  timer.stop();
+  timer.elapsed_time(time);
+
+  if (total != num_loops * length)
+    ACE_ERROR ((LM_ERROR,
+                ACE_TEXT ("Returned %u elements, expected %u\n"),
+                total,
+                num_loops * length));
+
+  if (use_csv)
+    {
+      ACE_DEBUG((LM_INFO,
+                 ACE_TEXT("4, 0, %u, %u, %s, %Q\n"),
+                 length,
+                 num_loops,
+                 use_move ? ACE_TEXT("move"): ACE_TEXT("copy"),
+                 time ));
+    }
+  else
+    {
+      ACE_DEBUG((LM_INFO,
+                 ACE_TEXT("Return long seq (%u, %u, %s) = %Q ns\n"),
+                 length,
+                 num_loops,
+                 use_move ? ACE_TEXT("move"): ACE_TEXT("copy"),
+                 time ));
+    }
+}
+
 int
 ACE_TMAIN (int argc, ACE_TCHAR *argv[])
 {
@@ -216,6 +288,9 @@ ACE_TMAIN (int argc, ACE_TCHAR *argv[])
       big_time_test(10, 1, 10, true);
       big_time_test(10, 10, 10, true);
       big_time_test(100, 1, 10, true);
+
+      return_time_test(10, 1000000, false);
+      return_time_test(10, 1000000, true);
     }
   catch (const CORBA::Exception &ex)
     {
@@ -9,6 +9,7 @@
 
 #include "tao/ORB_Core.h"
 #include "tao/CDR.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 #include "tao/SystemException.h"
 #include "tao/AnyTypeCode/TypeCode_Traits.h"
 
@@ -33,7 +34,7 @@ TAO::TypeCode::Alias<StringType,
 
   // Create a CDR encapsulation.
 
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   // Account for the encoded CDR encapsulation length and byte order.
   //
@@ -9,6 +9,7 @@
 
 #include "tao/ORB_Core.h"
 #include "tao/CDR.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 #include "tao/TypeCodeFactory_Adapter.h"
 #include "tao/SystemException.h"
 
@@ -31,7 +32,7 @@ TAO::TypeCode::Alias<char const *,
 
   // Create a CDR encapsulation.
 
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   // Account for the encoded CDR encapsulation length and byte order.
   //
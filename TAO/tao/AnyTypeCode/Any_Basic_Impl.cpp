@@ -90,7 +90,8 @@ namespace TAO
     try
       {
         CORBA::TypeCode_ptr any_tc = any._tao_get_typecode ();
-        CORBA::Boolean const _tao_equiv = any_tc->equivalent (tc);
+        CORBA::Boolean const _tao_equiv =
+          any_tc->tao_equivalent_constant (tc);
 
         if (!_tao_equiv)
           {
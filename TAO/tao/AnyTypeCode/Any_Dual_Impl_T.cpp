@@ -100,7 +100,8 @@ TAO::Any_Dual_Impl_T<T>::extract (const CORBA::Any & any,
   try
     {
       CORBA::TypeCode_ptr any_tc = any._tao_get_typecode ();
-      CORBA::Boolean const _tao_equiv = any_tc->equivalent (tc);
+      CORBA::Boolean const _tao_equiv =
+        any_tc->tao_equivalent_constant (tc);
 
       if (_tao_equiv == false)
         {
@@ -134,8 +135,40 @@ TAO::Any_Dual_Impl_T<T>::extract (const CORBA::Any & any,
         return false;
 
       // We don't want the rd_ptr of unk to move, in case it is
-      // shared by another Any. This copies the state, not the buffer.
-      TAO_InputCDR for_reading (unk->_tao_get_cdr ());
+      // shared by another Any.
+      TAO_InputCDR & unk_cdr = unk->_tao_get_cdr ();
+      ACE_Message_Block const * const mb = unk_cdr.start ();
+
+      if (mb->cont () != 0)
+        {
+          // This copies the state, not the buffer.
+          TAO_InputCDR for_reading (unk_cdr);
+
+          return replace (for_reading, any, destructor, any_tc, _tao_elem);
+        }
+
+      // Read through a view of the buffer instead of a copy of the
+      // stream, which would have to take the global Unknown_IDL_Type
+      // lock to share the data block.  The Any keeps unk, and with it
+      // the data block, alive until replace() has demarshaled the
+      // value.
+      CORBA::Octet major_version;
+      CORBA::Octet minor_version;
+      unk_cdr.get_version (major_version, minor_version);
+
+      TAO_InputCDR for_reading (mb->data_block (),
+                                ACE_Message_Block::DONT_DELETE,
+                                unk_cdr.rd_ptr () - mb->base (),
+                                mb->wr_ptr () - mb->base (),
+                                unk_cdr.byte_order (),
+                                major_version,
+                                minor_version,
+                                unk_cdr.orb_core ());
+      for_reading.char_translator (unk_cdr.char_translator ());
+      for_reading.wchar_translator (unk_cdr.wchar_translator ());
+      for_reading.set_repo_id_map (unk_cdr.get_repo_id_map ());
+      for_reading.set_codebase_url_map (unk_cdr.get_codebase_url_map ());
+      for_reading.set_value_map (unk_cdr.get_value_map ());
 
       return replace (for_reading, any, destructor, any_tc, _tao_elem);
     }
@@ -61,7 +61,8 @@ TAO::Any_Impl_T<T>::extract (const CORBA::Any & any,
   try
     {
       CORBA::TypeCode_ptr any_tc = any._tao_get_typecode ();
-      CORBA::Boolean const _tao_equiv = any_tc->equivalent (tc);
+      CORBA::Boolean const _tao_equiv =
+        any_tc->tao_equivalent_constant (tc);
 
       if (_tao_equiv == false)
         {
@@ -6,6 +6,7 @@
 #include "tao/TypeCodeFactory_Adapter.h"
 #include "tao/ORB_Core.h"
 #include "tao/CDR.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 
 #include "ace/Dynamic_Service.h"
 #include <cstring>
@@ -29,7 +30,7 @@ TAO::TypeCode::Enum<StringType,
   // a CDR encapsulation.
 
   // Create a CDR encapsulation.
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   bool const success =
     (enc << TAO_OutputCDR::from_boolean (TAO_ENCAP_BYTE_ORDER))
@@ -3,6 +3,7 @@
 #include "tao/AnyTypeCode/TypeCode_Traits.h"
 #include "tao/ORB_Core.h"
 #include "tao/CDR.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 #include "tao/TypeCodeFactory_Adapter.h"
 #include "tao/SystemException.h"
 
@@ -28,7 +29,7 @@ TAO::TypeCode::Enum<char const *,
   // a CDR encapsulation.
 
   // Create a CDR encapsulation.
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   bool const success =
     (enc << TAO_OutputCDR::from_boolean (TAO_ENCAP_BYTE_ORDER))
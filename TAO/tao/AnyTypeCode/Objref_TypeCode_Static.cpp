@@ -6,6 +6,7 @@
 #endif  /* !__ACE_INLINE__ */
 
 #include "tao/CDR.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 #include "tao/TypeCodeFactory_Adapter.h"
 #include "tao/ORB_Core.h"
 #include "tao/SystemException.h"
@@ -26,7 +27,7 @@ TAO::TypeCode::Objref<char const *, TAO::Null_RefCount_Policy>::tao_marshal (
   // a CDR encapsulation.
 
   // Create a CDR encapsulation.
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   return
     enc << TAO_OutputCDR::from_boolean (TAO_ENCAP_BYTE_ORDER)
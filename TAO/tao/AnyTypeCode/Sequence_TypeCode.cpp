@@ -3,6 +3,7 @@
 
 #include "tao/AnyTypeCode/Sequence_TypeCode.h"
 #include "tao/CDR.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 #include "tao/AnyTypeCode/TypeCode_Traits.h"
 
 #ifndef __ACE_INLINE__
@@ -25,7 +26,7 @@ TAO::TypeCode::Sequence<TypeCodeType, RefCountPolicy>::tao_marshal (
   // marshaled into a CDR encapsulation.
 
   // Create a CDR encapsulation.
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   // Account for the encoded CDR encapsulation length and byte order.
   //
@@ -1,6 +1,7 @@
 // -*- C++ -*-
 #include "tao/AnyTypeCode/Sequence_TypeCode_Static.h"
 #include "tao/CDR.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 #include "tao/AnyTypeCode/TypeCode_Traits.h"
 
 #include "ace/Truncate.h"
@@ -23,7 +24,7 @@ TAO::TypeCode::Sequence<CORBA::TypeCode_ptr const *,
   // marshaled into a CDR encapsulation.
 
   // Create a CDR encapsulation.
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   // Account for the encoded CDR encapsulation length and byte order.
   //
@@ -7,6 +7,7 @@
 #include "tao/ORB_Core.h"
 #include "tao/TypeCodeFactory_Adapter.h"
 #include "tao/CDR.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 #include "tao/SystemException.h"
 
 
@@ -36,7 +37,7 @@ TAO::TypeCode::Struct<StringType,
   // a CDR encapsulation.
 
   // Create a CDR encapsulation.
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   // Account for the encoded CDR encapsulation length and byte order.
   //
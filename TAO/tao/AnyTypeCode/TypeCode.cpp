@@ -14,6 +14,37 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+namespace
+{
+  /// Does a TypeCode of the given kind support the id() and name()
+  /// operations?  Checking first spares throwing and catching
+  /// CORBA::TypeCode::BadKind for every anonymous type compared.
+  bool
+  has_repository_id (CORBA::TCKind kind)
+  {
+    switch (kind)
+      {
+      case CORBA::tk_objref:
+      case CORBA::tk_struct:
+      case CORBA::tk_union:
+      case CORBA::tk_enum:
+      case CORBA::tk_alias:
+      case CORBA::tk_except:
+      case CORBA::tk_value:
+      case CORBA::tk_value_box:
+      case CORBA::tk_native:
+      case CORBA::tk_abstract_interface:
+      case CORBA::tk_local_interface:
+      case CORBA::tk_component:
+      case CORBA::tk_home:
+      case CORBA::tk_event:
+        return true;
+      default:
+        return false;
+      }
+  }
+}
+
 CORBA::TypeCode::~TypeCode ()
 {
 }
@@ -41,7 +72,10 @@ CORBA::TypeCode::equal (TypeCode_ptr tc) const
   if (tc_kind != this->kind_)
     return false;
 
-  try
+  // Only the TypeCodes of these kinds support the id() and name()
+  // operations.  The others are compared using TypeCode
+  // subclass-specific techniques below.
+  if (has_repository_id (tc_kind))
     {
       char const * const tc_id = tc->id ();
 
@@ -57,13 +91,6 @@ CORBA::TypeCode::equal (TypeCode_ptr tc) const
       if (std::strcmp (this_name, tc_name) != 0)
         return false;
     }
-  catch (const ::CORBA::TypeCode::BadKind&)
-    {
-      // Some TypeCodes do not support the id() and name()
-      // operations.  Ignore the failure, and continue equality
-      // verification using TypeCode subclass-specific techniques
-      // below.
-    }
 
   return this->equal_i (tc);
 }
@@ -92,7 +119,10 @@ CORBA::TypeCode::equivalent (TypeCode_ptr tc) const
   if (tc_kind != this_kind)
     return false;
 
-  try
+  // Only the TypeCodes of these kinds support the id() operation.
+  // The others are compared using TypeCode subclass-specific
+  // techniques.
+  if (has_repository_id (tc_kind))
     {
       char const * const this_id = unaliased_this->id ();
       char const * const tc_id = unaliased_tc->id ();
@@ -103,14 +133,29 @@ CORBA::TypeCode::equivalent (TypeCode_ptr tc) const
           return std::strcmp (this_id, tc_id) == 0;
         }
     }
-  catch (const ::CORBA::TypeCode::BadKind&)
+
+  return unaliased_this->equivalent_i (unaliased_tc.in ());
+}
+
+CORBA::Boolean
+CORBA::TypeCode::tao_equivalent_constant (TypeCode_ptr tc) const
+{
+  if (this == tc
+      || this->equivalent_constant_.load (std::memory_order_relaxed) == tc)
+    {
+      return true;
+    }
+
+  if (!this->equivalent (tc))
     {
-      // Some TypeCodes do not support the id() operation.  Ignore the
-      // failure, and continue equivalence verification using TypeCode
-      // subclass-specific techniques.
+      return false;
     }
 
-  return unaliased_this->equivalent_i (unaliased_tc.in ());
+  // The constant outlives this TypeCode, so the pointer can never
+  // dangle or be reused for another TypeCode.
+  this->equivalent_constant_.store (tc, std::memory_order_relaxed);
+
+  return true;
 }
 
 char const *
@@ -36,6 +36,8 @@
 #include "tao/Arg_Traits_T.h"
 #include "tao/Objref_VarOut_T.h"
 
+#include <atomic>
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace CORBA
@@ -413,6 +415,20 @@ namespace CORBA
     /// Decrease the reference count on this object.
     virtual void tao_release () = 0;
 
+    /// Equivalence check against a @c TypeCode constant.
+    /**
+     * Same as equivalent(), but @a tc must live as long as the
+     * program does, as the @c TypeCode constants generated by the IDL
+     * compiler do.  The last such @c TypeCode found to be equivalent
+     * is remembered, so that checking against it again, as the Any
+     * extraction operators do on every extraction, is a pointer
+     * comparison.
+     *
+     * @note This is a TAO-specific method that is not part of the
+     *       standard @c CORBA::TypeCode interface.
+     */
+    Boolean tao_equivalent_constant (TypeCode_ptr tc) const;
+
     /// Destruction callback for Anys.
     static void _tao_any_destructor (void * x);
 
@@ -477,6 +493,11 @@ namespace CORBA
   protected:
     /// The kind of TypeCode.
     TCKind const kind_;
+
+  private:
+    /// The last @c TypeCode constant found equivalent by
+    /// tao_equivalent_constant().
+    mutable std::atomic<TypeCode const *> equivalent_constant_;
   };
 }  // End namespace CORBA
 
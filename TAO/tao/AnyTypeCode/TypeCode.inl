@@ -15,7 +15,8 @@ CORBA::release<> (CORBA::TypeCode_ptr obj)
 
 ACE_INLINE
 CORBA::TypeCode::TypeCode (CORBA::TCKind k)
-  : kind_ (k)
+  : kind_ (k),
+    equivalent_constant_ (nullptr)
 {
 }
 
@@ -27,7 +27,12 @@
 
 #include "ace/Array_Base.h"
 #include "ace/Value_Ptr.h"
+#include "ace/ACE.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Guard_T.h"
 #include <cstring>
+#include <memory>
+#include <new>
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -1502,9 +1507,248 @@ namespace
 
 // ----------------------------------------------------------------
 
+namespace
+{
+  /// Cache of demarshaled TypeCodes, keyed on their CDR encoding.
+  /**
+   * Every Any of a given type that arrives over the wire carries the
+   * same TypeCode encoding.  Handing out the same TypeCode instance
+   * for all of them saves demarshaling the TypeCode again, and lets
+   * CORBA::TypeCode::tao_equivalent_constant() remember that it is
+   * equivalent to the TypeCode constant the Any is extracted with.
+   *
+   * Only self-contained TypeCodes, i.e. those with a complex
+   * parameter list that contains no indirection, are cached.  The
+   * encoding includes the alignment padding, which TAO always leaves
+   * zero (see Encapsulation_CDR); a sender that leaves garbage there
+   * merely doesn't benefit from the cache.  The cache is direct
+   * mapped; an entry that hashes to an occupied slot replaces the
+   * TypeCode held there.
+   */
+  class TypeCode_Cache
+  {
+  public:
+    /// The encoding of the TypeCode at the read position of a stream.
+    struct Key
+    {
+      /// Start of the TypeCode kind, up to the end of the
+      /// encapsulation.
+      char const * data;
+      size_t length;
+
+      /// Number of bytes to skip in the stream, including alignment.
+      size_t skip;
+
+      /// Stream byte order and GIOP version, which all affect how the
+      /// encoding is interpreted.
+      CORBA::Octet byte_order;
+      CORBA::Octet major;
+      CORBA::Octet minor;
+
+      u_long hash;
+    };
+
+    static TypeCode_Cache & instance ();
+
+    /// Set @a key to the encoding of the TypeCode at the read
+    /// position of @a cdr.
+    /**
+     * @return @c false if the TypeCode must not be cached.
+     */
+    static bool make_key (TAO_InputCDR & cdr, Key & key);
+
+    /// Look up @a key and, if found, skip the TypeCode in @a cdr.
+    bool find (Key const & key, TAO_InputCDR & cdr, CORBA::TypeCode_ptr & tc);
+
+    /// Remember @a tc as the TypeCode encoded by @a key.
+    void bind (Key const & key, CORBA::TypeCode_ptr tc);
+
+  private:
+    /// Number of slots, must be a power of two.
+    static size_t const SLOTS = 256;
+
+    /// TypeCodes with a larger encoding are not cached.
+    static size_t const MAX_LENGTH = 8192;
+
+    struct Slot
+    {
+      Slot () : length (0), byte_order (0), major (0), minor (0), hash (0) {}
+
+      bool matches (Key const & key) const
+      {
+        return this->hash == key.hash
+          && this->length == key.length
+          && this->byte_order == key.byte_order
+          && this->major == key.major
+          && this->minor == key.minor
+          && ACE_OS::memcmp (this->data.get (), key.data, key.length) == 0;
+      }
+
+      std::unique_ptr<char[]> data;
+      size_t length;
+      CORBA::Octet byte_order;
+      CORBA::Octet major;
+      CORBA::Octet minor;
+      u_long hash;
+      CORBA::TypeCode_var tc;
+    };
+
+    TAO_SYNCH_MUTEX lock_;
+    Slot slots_[SLOTS];
+  };
+
+  TypeCode_Cache &
+  TypeCode_Cache::instance ()
+  {
+    // A function local static is created after, and so destroyed
+    // before, the TypeCode constants the cached TypeCodes refer to.
+    static TypeCode_Cache cache;
+    return cache;
+  }
+
+  bool
+  TypeCode_Cache::make_key (TAO_InputCDR & cdr, Key & key)
+  {
+    // Code set translation may change the encoding of identical
+    // TypeCodes, don't bother caching those.
+    if (cdr.char_translator () != 0 || cdr.wchar_translator () != 0)
+      return false;
+
+    char const * const start = cdr.rd_ptr ();
+#if !defined (ACE_LACKS_CDR_ALIGNMENT)
+    char const * const kind_ptr =
+      ACE_ptr_align_binary (start, ACE_CDR::LONG_SIZE);
+#else
+    char const * const kind_ptr = start;
+#endif /* ACE_LACKS_CDR_ALIGNMENT */
+    size_t const header = (kind_ptr - start) + 2 * ACE_CDR::LONG_SIZE;
+
+    if (cdr.length () < header)
+      return false;
+
+    CORBA::ULong kind;
+    CORBA::ULong encap_length;
+    ACE_OS::memcpy (&kind, kind_ptr, sizeof kind);
+    ACE_OS::memcpy (&encap_length,
+                    kind_ptr + ACE_CDR::LONG_SIZE,
+                    sizeof encap_length);
+
+    if (cdr.do_byte_swap ())
+      {
+        ACE_CDR::swap_4 (reinterpret_cast<char const *> (&kind),
+                         reinterpret_cast<char *> (&kind));
+        ACE_CDR::swap_4 (reinterpret_cast<char const *> (&encap_length),
+                         reinterpret_cast<char *> (&encap_length));
+      }
+
+    switch (kind)
+      {
+      case CORBA::tk_objref:
+      case CORBA::tk_struct:
+      case CORBA::tk_union:
+      case CORBA::tk_enum:
+      case CORBA::tk_sequence:
+      case CORBA::tk_array:
+      case CORBA::tk_alias:
+      case CORBA::tk_except:
+      case CORBA::tk_value:
+      case CORBA::tk_value_box:
+      case CORBA::tk_native:
+      case CORBA::tk_abstract_interface:
+      case CORBA::tk_local_interface:
+      case CORBA::tk_component:
+      case CORBA::tk_home:
+      case CORBA::tk_event:
+        break;
+      default:
+        // No complex parameter list.
+        return false;
+      }
+
+    if (encap_length > MAX_LENGTH || cdr.length () - header < encap_length)
+      return false;
+
+    // Indirections are only found on 4 byte boundaries relative to
+    // the start of the encapsulation.  Other data may look like an
+    // indirection too, which merely prevents caching.
+    char const * const body = kind_ptr + 2 * ACE_CDR::LONG_SIZE;
+    for (size_t i = 0;
+         i + ACE_CDR::LONG_SIZE <= encap_length;
+         i += ACE_CDR::LONG_SIZE)
+      {
+        CORBA::ULong word;
+        ACE_OS::memcpy (&word, body + i, sizeof word);
+        if (word == TYPECODE_INDIRECTION)
+          return false;
+      }
+
+    key.data = kind_ptr;
+    key.length = 2 * ACE_CDR::LONG_SIZE + encap_length;
+    key.skip = header + encap_length;
+    key.byte_order = static_cast<CORBA::Octet> (cdr.byte_order ());
+    cdr.get_version (key.major, key.minor);
+    key.hash = ACE::hash_pjw (key.data, key.length);
+
+    return true;
+  }
+
+  bool
+  TypeCode_Cache::find (Key const & key,
+                        TAO_InputCDR & cdr,
+                        CORBA::TypeCode_ptr & tc)
+  {
+    Slot & slot = this->slots_[key.hash & (SLOTS - 1)];
+
+    {
+      ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, guard, this->lock_, false);
+
+      if (!slot.matches (key))
+        return false;
+
+      tc = CORBA::TypeCode::_duplicate (slot.tc.in ());
+    }
+
+    return cdr.skip_bytes (key.skip);
+  }
+
+  void
+  TypeCode_Cache::bind (Key const & key, CORBA::TypeCode_ptr tc)
+  {
+    std::unique_ptr<char[]> data (new (std::nothrow) char[key.length]);
+    if (!data)
+      return;
+
+    ACE_OS::memcpy (data.get (), key.data, key.length);
+
+    CORBA::TypeCode_var old_tc;
+    Slot & slot = this->slots_[key.hash & (SLOTS - 1)];
+
+    ACE_GUARD (TAO_SYNCH_MUTEX, guard, this->lock_);
+
+    slot.data.swap (data);
+    slot.length = key.length;
+    slot.byte_order = key.byte_order;
+    slot.major = key.major;
+    slot.minor = key.minor;
+    slot.hash = key.hash;
+
+    // Release the replaced TypeCode outside the lock.
+    old_tc = slot.tc._retn ();
+    slot.tc = CORBA::TypeCode::_duplicate (tc);
+  }
+}
+
+// ----------------------------------------------------------------
+
 CORBA::Boolean
 operator>> (TAO_InputCDR & cdr, CORBA::TypeCode_ptr & tc)
 {
+  TypeCode_Cache::Key key;
+  bool const cacheable = TypeCode_Cache::make_key (cdr, key);
+
+  if (cacheable && TypeCode_Cache::instance ().find (key, cdr, tc))
+    return true;
+
   TAO::TypeCodeFactory::TC_Info_List indirect_infos;
   TAO::TypeCodeFactory::TC_Info_List direct_infos;
 
@@ -1515,6 +1759,10 @@ operator>> (TAO_InputCDR & cdr, CORBA::TypeCode_ptr & tc)
 
   if (indirect_infos.size() == 0) {
     cleanup_tc_info_list(direct_infos);
+    // Don't trust an encapsulation length that doesn't match what
+    // was actually demarshaled.
+    if (cacheable && cdr.rd_ptr () == key.data + key.length)
+      TypeCode_Cache::instance ().bind (key, tc);
     return true;
   }
 
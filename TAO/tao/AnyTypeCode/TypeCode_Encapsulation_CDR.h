@@ -0,0 +1,73 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file    TypeCode_Encapsulation_CDR.h
+ *
+ *  CDR stream the complex parameter list of a TypeCode is marshaled
+ *  into.
+ */
+//=============================================================================
+
+#ifndef TAO_TYPECODE_ENCAPSULATION_CDR_H
+#define TAO_TYPECODE_ENCAPSULATION_CDR_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/CDR.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  namespace TypeCode
+  {
+    /**
+     * @class Encapsulation_Buffer
+     *
+     * @brief Zero filled storage for an Encapsulation_CDR.
+     *
+     * A separate base so that the buffer is initialized before the
+     * stream that uses it.
+     */
+    class Encapsulation_Buffer
+    {
+    protected:
+      Encapsulation_Buffer () : buffer_ () {}
+
+      char buffer_[ACE_CDR::DEFAULT_BUFSIZE + ACE_CDR::MAX_ALIGNMENT];
+    };
+
+    /**
+     * @class Encapsulation_CDR
+     *
+     * @brief CDR encapsulation of a TypeCode complex parameter list.
+     *
+     * The alignment padding is left zero, so that a TypeCode always
+     * marshals to the same octets, which allows the demarshaling side
+     * to recognize a TypeCode it has seen before.  Typical parameter
+     * lists also fit without a heap allocated buffer.
+     */
+    class Encapsulation_CDR
+      : private Encapsulation_Buffer,
+        public TAO_OutputCDR
+    {
+    public:
+      Encapsulation_CDR ()
+        : Encapsulation_Buffer (),
+          TAO_OutputCDR (this->buffer_, sizeof (this->buffer_))
+      {
+      }
+    };
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif  /* TAO_TYPECODE_ENCAPSULATION_CDR_H */
@@ -3,6 +3,7 @@
 
 #include "tao/AnyTypeCode/Union_TypeCode.h"
 #include "tao/AnyTypeCode/TypeCode_Case_Base_T.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 
 #ifndef __ACE_INLINE__
 # include "tao/AnyTypeCode/Union_TypeCode.inl"
@@ -33,7 +34,7 @@ TAO::TypeCode::Union<StringType,
   // a CDR encapsulation.
 
   // Create a CDR encapsulation.
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   // Account for the encoded CDR encapsulation length and byte order.
   //
@@ -1,6 +1,7 @@
 // -*- C++ -*-
 #include "tao/AnyTypeCode/Union_TypeCode_Static.h"
 #include "tao/AnyTypeCode/TypeCode_Case_Base_T.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 #include "tao/AnyTypeCode/Any.h"
 #include "tao/SystemException.h"
 
@@ -29,7 +30,7 @@ TAO::TypeCode::Union<char const *,
   // a CDR encapsulation.
 
   // Create a CDR encapsulation.
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   // Account for the encoded CDR encapsulation length and byte order.
   //
@@ -4,6 +4,7 @@
 #include "tao/AnyTypeCode/Value_TypeCode.h"
 #include "tao/AnyTypeCode/TypeCode_Value_Field.h"
 #include "tao/CDR.h"
+#include "tao/AnyTypeCode/TypeCode_Encapsulation_CDR.h"
 #include "tao/SystemException.h"
 
 #include "tao/ORB_Core.h"
@@ -36,7 +37,7 @@ TAO::TypeCode::Value<StringType,
   // a CDR encapsulation.
 
   // Create a CDR encapsulation.
-  TAO_OutputCDR enc;
+  Encapsulation_CDR enc;
 
   // Account for the encoded CDR encapsulation length and byte order.
   //
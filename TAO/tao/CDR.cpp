@@ -243,6 +243,295 @@ TAO_OutputCDR::fragment_stream (ACE_CDR::ULong pending_alignment,
   return true;  // Success.
 }
 
+ACE_CDR::ULong
+TAO_OutputCDR::fragment_limit () const
+{
+  if (this->fragmentation_strategy_ == nullptr)
+    return 0;
+
+  // All fragments but the last one are padded to an 8 byte boundary,
+  // the padding has to stay below the threshold as well.
+  return
+    this->fragmentation_strategy_->max_message_size ()
+    & ~static_cast<ACE_CDR::ULong> (ACE_CDR::MAX_ALIGNMENT - 1);
+}
+
+template <typename T>
+ACE_CDR::Boolean
+TAO_OutputCDR::write_array_fragments (
+  ACE_CDR::Boolean (ACE_OutputCDR::*writer) (const T *, ACE_CDR::ULong),
+  const T *x,
+  ACE_CDR::ULong length,
+  size_t alignment,
+  ACE_CDR::ULong limit)
+{
+  while (length != 0)
+    {
+      size_t const used =
+        ACE_align_binary (this->total_length (), alignment);
+      size_t n = used < limit ? (limit - used) / sizeof (T) : 0;
+
+      if (n == 0)
+        {
+          // Not even one more element fits, send what the stream
+          // holds.  Should the strategy not send anything, write the
+          // rest in one go rather than loop forever.
+          size_t const before = this->total_length ();
+          if (!this->fragment_stream (
+                 static_cast<ACE_CDR::ULong> (alignment),
+                 static_cast<ACE_CDR::ULong> (sizeof (T))))
+            return false;
+
+          if (this->total_length () >= before)
+            break;
+
+          continue;
+        }
+
+      if (n > length)
+        n = length;
+
+      if (!(this->*writer) (x, static_cast<ACE_CDR::ULong> (n)))
+        return false;
+
+      x += n;
+      length -= static_cast<ACE_CDR::ULong> (n);
+    }
+
+  return length == 0 || (this->*writer) (x, length);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_boolean_array (const ACE_CDR::Boolean *x,
+                                    ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_boolean_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_boolean_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::OCTET_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_char_array (const ACE_CDR::Char *x,
+                                 ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_char_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_char_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::OCTET_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_octet_array (const ACE_CDR::Octet *x,
+                                  ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_octet_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_octet_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::OCTET_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_short_array (const ACE_CDR::Short *x,
+                                  ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_short_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_short_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::SHORT_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_ushort_array (const ACE_CDR::UShort *x,
+                                   ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_ushort_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_ushort_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::SHORT_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_long_array (const ACE_CDR::Long *x,
+                                 ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_long_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_long_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::LONG_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_ulong_array (const ACE_CDR::ULong *x,
+                                  ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_ulong_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_ulong_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::LONG_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_longlong_array (const ACE_CDR::LongLong *x,
+                                     ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_longlong_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_longlong_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::LONGLONG_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_ulonglong_array (const ACE_CDR::ULongLong *x,
+                                      ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_ulonglong_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_ulonglong_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::LONGLONG_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_float_array (const ACE_CDR::Float *x,
+                                  ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_float_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_float_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::LONG_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_double_array (const ACE_CDR::Double *x,
+                                   ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_double_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_double_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::LONGLONG_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_longdouble_array (const ACE_CDR::LongDouble *x,
+                                       ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_longdouble_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_longdouble_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::LONGDOUBLE_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_int8_array (const ACE_CDR::Int8 *x,
+                                 ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_int8_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_int8_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::OCTET_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_uint8_array (const ACE_CDR::UInt8 *x,
+                                  ACE_CDR::ULong length)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0)
+    return this->ACE_OutputCDR::write_uint8_array (x, length);
+
+  return this->write_array_fragments (&ACE_OutputCDR::write_uint8_array,
+                                      x,
+                                      length,
+                                      ACE_CDR::OCTET_ALIGN,
+                                      limit);
+}
+
+ACE_CDR::Boolean
+TAO_OutputCDR::write_octet_array_mb (const ACE_Message_Block *mb)
+{
+  ACE_CDR::ULong const limit = this->fragment_limit ();
+  if (limit == 0 || this->total_length () + mb->total_length () <= limit)
+    return this->ACE_OutputCDR::write_octet_array_mb (mb);
+
+  for (const ACE_Message_Block *i = mb; i != nullptr; i = i->cont ())
+    {
+      if (!this->write_array_fragments (
+             &ACE_OutputCDR::write_octet_array,
+             reinterpret_cast<const ACE_CDR::Octet *> (i->rd_ptr ()),
+             static_cast<ACE_CDR::ULong> (i->length ()),
+             ACE_CDR::OCTET_ALIGN,
+             limit))
+        return false;
+    }
+
+  return true;
+}
+
 
 int
 TAO_OutputCDR::offset (char* pos)
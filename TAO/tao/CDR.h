@@ -214,6 +214,53 @@ public:
   ACE_Time_Value * timeout () const;
   //@}
 
+  /**
+   * @name Array Writers That Fragment The Stream
+   *
+   * These hide the ACE_OutputCDR methods of the same name.  When the
+   * fragmentation strategy has a size limit they write the array, for
+   * instance the contents of a sequence of a basic type, in pieces
+   * that fit in a GIOP fragment and send each fragment as soon as it
+   * is full.  Marshaling a large sequence then only needs a buffer
+   * the size of a fragment instead of one for the whole message.
+   * Otherwise they just call the ACE_OutputCDR method.
+   */
+  //@{
+  ACE_CDR::Boolean write_boolean_array (const ACE_CDR::Boolean *x,
+                                        ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_char_array (const ACE_CDR::Char *x,
+                                     ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_octet_array (const ACE_CDR::Octet *x,
+                                      ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_short_array (const ACE_CDR::Short *x,
+                                      ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_ushort_array (const ACE_CDR::UShort *x,
+                                       ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_long_array (const ACE_CDR::Long *x,
+                                     ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_ulong_array (const ACE_CDR::ULong *x,
+                                      ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_longlong_array (const ACE_CDR::LongLong *x,
+                                         ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_ulonglong_array (const ACE_CDR::ULongLong *x,
+                                          ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_float_array (const ACE_CDR::Float *x,
+                                      ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_double_array (const ACE_CDR::Double *x,
+                                       ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_longdouble_array (const ACE_CDR::LongDouble *x,
+                                           ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_int8_array (const ACE_CDR::Int8 *x,
+                                     ACE_CDR::ULong length);
+  ACE_CDR::Boolean write_uint8_array (const ACE_CDR::UInt8 *x,
+                                      ACE_CDR::ULong length);
+
+  /// Chains @a mb into the stream without copying it if the whole
+  /// message stays below the fragmentation threshold, otherwise
+  /// copies it in pieces like write_octet_array().
+  ACE_CDR::Boolean write_octet_array_mb (const ACE_Message_Block *mb);
+  //@}
+
   /// These methods are used by valuetype indirection support.
   /// Accessor to the indirect maps.
   Repo_Id_Map_Handle& get_repo_id_map ();
@@ -239,6 +286,23 @@ public:
   /// Calculate the offset between pos and current wr_ptr.
   int offset (char* pos);
 
+private:
+  /// Size at which the fragmentation strategy sends a fragment,
+  /// rounded down to the 8 byte alignment of fragments, or zero if
+  /// the stream is never fragmented.
+  ACE_CDR::ULong fragment_limit () const;
+
+  /// Write @a length elements of @a x with the ACE_OutputCDR method
+  /// @a writer, sending a GIOP fragment each time the stream reaches
+  /// @a limit bytes.
+  template <typename T>
+  ACE_CDR::Boolean write_array_fragments (
+    ACE_CDR::Boolean (ACE_OutputCDR::*writer) (const T *, ACE_CDR::ULong),
+    const T *x,
+    ACE_CDR::ULong length,
+    size_t alignment,
+    ACE_CDR::ULong limit);
+
 private:
   TAO_OutputCDR (const TAO_OutputCDR&rhs) = delete;
   TAO_OutputCDR& operator= (const TAO_OutputCDR&) = delete;
@@ -26,6 +26,7 @@
 #include "ace/iosfwd.h"
 
 #include <algorithm>
+#include <utility>
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -71,6 +72,13 @@ namespace TAO
     {
     }
 
+    /// Move constructor, takes over the string of @a s and leaves it
+    /// null.
+    inline String_var (String_var<charT> &&s) noexcept : ptr_(s.ptr_)
+    {
+      s.ptr_ = 0;
+    }
+
     /// Destructor.
     inline ~String_var ()
     {
@@ -101,6 +109,14 @@ namespace TAO
       return *this;
     }
 
+    /// Move assignment operator.
+    inline String_var &operator= (String_var<character_type> &&s) noexcept
+    {
+      String_var <charT> tmp (std::move (s));
+      std::swap (this->ptr_, tmp.ptr_);
+      return *this;
+    }
+
     /// Spec-defined read/write version.
     inline operator character_type *&()
     {
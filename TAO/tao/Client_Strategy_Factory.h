@@ -68,6 +68,15 @@ public:
   /// Return the size of the reply dispatcher table
   virtual int reply_dispatcher_table_size () const = 0;
 
+  /// Return the number of slots of the request id indexed reply
+  /// dispatcher table of muxed transports, 0 if it is disabled.
+  virtual int reply_dispatcher_slots () const = 0;
+
+  /// Return the longest time, in microseconds, the RW wait strategy
+  /// polls a connection for a reply before blocking, 0 if it does
+  /// not poll.
+  virtual int wait_spin_time () const = 0;
+
   /// Create the correct client wait_for_reply strategy.
   virtual TAO_Wait_Strategy *create_wait_strategy (TAO_Transport *transport) = 0;
 
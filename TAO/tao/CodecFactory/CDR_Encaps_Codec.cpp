@@ -36,66 +36,209 @@ TAO_CDR_Encaps_Codec::~TAO_CDR_Encaps_Codec ()
 {
 }
 
-CORBA::OctetSeq *
-TAO_CDR_Encaps_Codec::encode (const CORBA::Any & data)
+namespace
 {
-  this->check_type_for_encoding (data);
+  /// Where an Input_Buffer of @a data reads from.
+  char *
+  input_buffer (CORBA::OctetSeq const & data,
+                char * stream_buffer,
+                size_t stream_buffer_size,
+                std::unique_ptr<char[]> & heap)
+  {
+    size_t const length = data.length ();
+
+    if (length > 0)
+      {
+        char * const octets =
+          reinterpret_cast<char *> (
+            const_cast<CORBA::Octet *> (data.get_buffer ()));
+
+        if (ACE_ptr_align_binary (octets, ACE_CDR::MAX_ALIGNMENT) == octets)
+          return octets;
+      }
+
+    if (length + ACE_CDR::MAX_ALIGNMENT > stream_buffer_size)
+      {
+        heap.reset (new char[length + ACE_CDR::MAX_ALIGNMENT]);
+        stream_buffer = heap.get ();
+      }
+
+    return ACE_ptr_align_binary (stream_buffer, ACE_CDR::MAX_ALIGNMENT);
+  }
+}
 
-  // ----------------------------------------------------------------
+TAO_CDR_Encaps_Codec::Stream_Buffer::Stream_Buffer ()
+{
+}
 
-  TAO_OutputCDR cdr ((size_t) 0,            // size
-                     (int) TAO_ENCAP_BYTE_ORDER,
-                     (ACE_Allocator *) 0,   // buffer_allocator
-                     (ACE_Allocator *) 0,   // data_block_allocator
-                     (ACE_Allocator *) 0,   // message_block_allocator
-                     0,                     // memcpy_tradeoff
-                     this->major_,
-                     this->minor_);
+TAO_CDR_Encaps_Codec::Output_CDR::Output_CDR (
+  TAO_CDR_Encaps_Codec const & codec)
+  : Stream_Buffer (),
+    TAO_OutputCDR (this->buffer_,
+                   sizeof (this->buffer_),
+                   (int) TAO_ENCAP_BYTE_ORDER,
+                   (ACE_Allocator *) 0,   // buffer_allocator
+                   (ACE_Allocator *) 0,   // data_block_allocator
+                   (ACE_Allocator *) 0,   // message_block_allocator
+                   0,                     // memcpy_tradeoff
+                   codec.major_,
+                   codec.minor_)
+{
+  // Leave the alignment padding zero, so that the same value always
+  // encodes to the same octets.
+  ACE_OS::memset (this->buffer_, 0, sizeof (this->buffer_));
 
-  if (this->char_translator_)
+  if (codec.char_translator_)
     {
-      this->char_translator_->assign (&cdr);
+      codec.char_translator_->assign (this);
     }
-  if (this->wchar_translator_)
+  if (codec.wchar_translator_)
     {
-      this->wchar_translator_->assign (&cdr);
+      codec.wchar_translator_->assign (this);
     }
 
-  if ((cdr << TAO_OutputCDR::from_boolean (TAO_ENCAP_BYTE_ORDER))
-      && (cdr << data))
+  *this << TAO_OutputCDR::from_boolean (TAO_ENCAP_BYTE_ORDER);
+}
+
+void
+TAO_CDR_Encaps_Codec::Output_CDR::copy_to (CORBA::OctetSeq & octets) const
+{
+  CORBA::ULong const length =
+    static_cast<CORBA::ULong> (this->total_length ());
+
+  // Only reuse a buffer the sequence owns; a sequence that refers to
+  // somebody else's buffer or to a message block gets a new one.
+  if (length > octets.maximum () || !octets.release ())
     {
-      CORBA::OctetSeq * octet_seq = 0;
+      CORBA::OctetSeq tmp (length);
+      octets.swap (tmp);
+    }
 
-      ACE_NEW_THROW_EX (octet_seq,
-                        CORBA::OctetSeq,
-                        CORBA::NO_MEMORY (
-                          CORBA::SystemException::_tao_minor_code (
-                            0,
-                            ENOMEM),
-                          CORBA::COMPLETED_NO));
+  octets.length (length);
+  CORBA::Octet *buf = octets.get_buffer ();
 
-      CORBA::OctetSeq_var safe_octet_seq = octet_seq;
+  for (const ACE_Message_Block *i = this->begin ();
+       i != 0;
+       i = i->cont ())
+    {
+      size_t const len = i->length ();
+      ACE_OS::memcpy (buf, i->rd_ptr (), len);
+      buf += len;
+    }
+}
 
-      octet_seq->length (static_cast<CORBA::ULong> (cdr.total_length ()));
-      CORBA::Octet *buf = octet_seq->get_buffer ();
+TAO_CDR_Encaps_Codec::Input_Buffer::Input_Buffer (
+  CORBA::OctetSeq const & data)
+  : Stream_Buffer (),
+    heap_ (),
+    block_ (data.length (),
+            ACE_Message_Block::MB_DATA,
+            input_buffer (data,
+                          this->buffer_,
+                          sizeof (this->buffer_),
+                          this->heap_),
+            (ACE_Allocator *) 0,
+            (ACE_Lock *) 0,
+            ACE_Message_Block::DONT_DELETE,
+            (ACE_Allocator *) 0)
+{
+  if (data.length () > 0
+      && this->block_.base ()
+           != reinterpret_cast<char const *> (data.get_buffer ()))
+    {
+      ACE_OS::memcpy (this->block_.base (),
+                      data.get_buffer (),
+                      data.length ());
+    }
+}
 
-      for (const ACE_Message_Block *i = cdr.begin ();
-           i != 0;
-           i = i->cont ())
-        {
-          size_t const len = i->length ();
-          ACE_OS::memcpy (buf, i->rd_ptr (), len);
-          buf += len;
-        }
+TAO_CDR_Encaps_Codec::Input_CDR::Input_CDR (
+  TAO_CDR_Encaps_Codec const & codec,
+  CORBA::OctetSeq const & data)
+  : Input_Buffer (data),
+    TAO_InputCDR (&this->block_,
+                  ACE_Message_Block::DONT_DELETE,
+                  0,
+                  data.length (),
+                  ACE_CDR_BYTE_ORDER,
+                  codec.major_,
+                  codec.minor_,
+                  codec.orb_core_)
+{
+  if (codec.char_translator_)
+    {
+      codec.char_translator_->assign (this);
+    }
+  if (codec.wchar_translator_)
+    {
+      codec.wchar_translator_->assign (this);
+    }
 
-      return safe_octet_seq._retn ();
+  CORBA::Boolean byte_order;
+  if (*this >> TAO_InputCDR::to_boolean (byte_order))
+    {
+      this->reset_byte_order (static_cast<int> (byte_order));
     }
+}
 
-  throw ::CORBA::MARSHAL ();
+CORBA::OctetSeq *
+TAO_CDR_Encaps_Codec::encode (const CORBA::Any & data)
+{
+  CORBA::OctetSeq * octet_seq = 0;
+
+  ACE_NEW_THROW_EX (octet_seq,
+                    CORBA::OctetSeq,
+                    CORBA::NO_MEMORY (
+                      CORBA::SystemException::_tao_minor_code (
+                        0,
+                        ENOMEM),
+                      CORBA::COMPLETED_NO));
+
+  CORBA::OctetSeq_var safe_octet_seq = octet_seq;
+
+  this->encode (data, *octet_seq);
+
+  return safe_octet_seq._retn ();
+}
+
+void
+TAO_CDR_Encaps_Codec::encode (const CORBA::Any & data,
+                              CORBA::OctetSeq & octets)
+{
+  this->check_type_for_encoding (data);
+
+  // ----------------------------------------------------------------
+
+  Output_CDR cdr (*this);
+
+  if (!cdr.good_bit () || !(cdr << data))
+    throw ::CORBA::MARSHAL ();
+
+  cdr.copy_to (octets);
 }
 
 CORBA::Any *
 TAO_CDR_Encaps_Codec::decode (const CORBA::OctetSeq & data)
+{
+  CORBA::Any * any = 0;
+  ACE_NEW_THROW_EX (any,
+                    CORBA::Any,
+                    CORBA::NO_MEMORY (
+                      CORBA::SystemException::_tao_minor_code (
+                        0,
+                        ENOMEM),
+                      CORBA::COMPLETED_NO));
+
+  CORBA::Any_var safe_any = any;
+
+  this->decode (data, *any);
+
+  return safe_any._retn ();
+}
+
+void
+TAO_CDR_Encaps_Codec::decode (const CORBA::OctetSeq & data,
+                              CORBA::Any & any)
 {
   // @todo How do we check for a format mismatch so that we can throw
   //       a IOP::Codec::FormatMismatch exception?
@@ -105,157 +248,101 @@ TAO_CDR_Encaps_Codec::decode (const CORBA::OctetSeq & data)
   // the octet sequence, and place them into the Any.  We can't just
   // insert the octet sequence into the Any.
 
-  ACE_Message_Block mb (data.length () + 2 * ACE_CDR::MAX_ALIGNMENT);
-  ACE_CDR::mb_align (&mb);
-
-  ACE_OS::memcpy (mb.rd_ptr (), data.get_buffer (), data.length ());
+  Input_CDR cdr (*this, data);
 
-  size_t rd_pos = mb.rd_ptr () - mb.base ();
-  size_t wr_pos = mb.wr_ptr () - mb.base () + data.length ();
-
-  TAO_InputCDR cdr (mb.data_block (),
-                    ACE_Message_Block::DONT_DELETE,
-                    rd_pos,
-                    wr_pos,
-                    ACE_CDR_BYTE_ORDER,
-                    this->major_,
-                    this->minor_,
-                    this->orb_core_);
-
-  if (this->char_translator_)
-    {
-      this->char_translator_->assign (&cdr);
-    }
-  if (this->wchar_translator_)
-    {
-      this->wchar_translator_->assign (&cdr);
-    }
+  if (!cdr.good_bit () || !(cdr >> any))
+    throw IOP::Codec::FormatMismatch ();
+}
 
-  CORBA::Boolean byte_order;
-  if (cdr >> TAO_InputCDR::to_boolean (byte_order))
-    {
-      cdr.reset_byte_order (static_cast<int> (byte_order));
+CORBA::OctetSeq *
+TAO_CDR_Encaps_Codec::encode_value (const CORBA::Any & data)
+{
+  CORBA::OctetSeq * octet_seq = 0;
 
-      CORBA::Any * any = 0;
-      ACE_NEW_THROW_EX (any,
-                        CORBA::Any,
-                        CORBA::NO_MEMORY (
-                          CORBA::SystemException::_tao_minor_code (
+  ACE_NEW_THROW_EX (octet_seq,
+                    CORBA::OctetSeq,
+                    CORBA::NO_MEMORY (
+                        CORBA::SystemException::_tao_minor_code (
                             0,
-                            ENOMEM),
-                          CORBA::COMPLETED_NO));
+                            ENOMEM
+                          ),
+                        CORBA::COMPLETED_NO
+                      ));
 
-      CORBA::Any_var safe_any = any;
+  CORBA::OctetSeq_var safe_octet_seq = octet_seq;
 
-      if (cdr >> (*any))
-        return safe_any._retn ();
-    }
+  this->encode_value (data, *octet_seq);
 
-  throw IOP::Codec::FormatMismatch ();
+  return safe_octet_seq._retn ();
 }
 
-CORBA::OctetSeq *
-TAO_CDR_Encaps_Codec::encode_value (const CORBA::Any & data)
+void
+TAO_CDR_Encaps_Codec::encode_value (const CORBA::Any & data,
+                                    CORBA::OctetSeq & octets)
 {
   this->check_type_for_encoding (data);
 
   // ----------------------------------------------------------------
-  TAO_OutputCDR cdr ((size_t) 0,            // size
-                     (int) TAO_ENCAP_BYTE_ORDER,
-                     (ACE_Allocator *) 0,   // buffer_allocator
-                     (ACE_Allocator *) 0,   // data_block_allocator
-                     (ACE_Allocator *) 0,   // message_block_allocator
-                     0,                     // memcpy_tradeoff
-                     this->major_,
-                     this->minor_);
-
-  if (this->char_translator_)
-    {
-      this->char_translator_->assign (&cdr);
-    }
-  if (this->wchar_translator_)
+  Output_CDR cdr (*this);
+
+  if (!cdr.good_bit ())
+    throw ::CORBA::MARSHAL ();
+
+  TAO::Any_Impl *impl = data.impl ();
+
+  if (impl->encoded ())
     {
-      this->wchar_translator_->assign (&cdr);
-    }
+      TAO::Unknown_IDL_Type * const unk =
+        dynamic_cast<TAO::Unknown_IDL_Type *> (impl);
+
+      if (!unk)
+        throw ::CORBA::INTERNAL ();
 
-  if ((cdr << TAO_OutputCDR::from_boolean (TAO_ENCAP_BYTE_ORDER)))
+      // We don't want unk's rd_ptr to move, in case we are shared by
+      // another Any, so we use this to copy the state, not the buffer.
+      TAO_InputCDR for_reading (unk->_tao_get_cdr ());
+
+      TAO_Marshal_Object::perform_append (data._tao_get_typecode (),
+                                          &for_reading,
+                                          &cdr);
+    }
+  else
     {
-      TAO::Any_Impl *impl = data.impl ();
-
-      if (impl->encoded ())
-        {
-          TAO::Unknown_IDL_Type * const unk =
-            dynamic_cast<TAO::Unknown_IDL_Type *> (impl);
-
-          if (!unk)
-            throw ::CORBA::INTERNAL ();
-
-          // We don't want unk's rd_ptr to move, in case we are shared by
-          // another Any, so we use this to copy the state, not the buffer.
-          TAO_InputCDR for_reading (unk->_tao_get_cdr ());
-
-          TAO_Marshal_Object::perform_append (data._tao_get_typecode (),
-                                              &for_reading,
-                                              &cdr);
-        }
-      else
-        {
-          impl->marshal_value (cdr);
-        }
-
-      // TAO extension: replace the contents of the octet sequence with
-      // the CDR stream.
-      CORBA::OctetSeq * octet_seq = 0;
-
-      ACE_NEW_THROW_EX (octet_seq,
-                        CORBA::OctetSeq,
-                        CORBA::NO_MEMORY (
-                            CORBA::SystemException::_tao_minor_code (
-                                0,
-                                ENOMEM
-                              ),
-                            CORBA::COMPLETED_NO
-                          ));
-
-      CORBA::OctetSeq_var safe_octet_seq = octet_seq;
-
-      octet_seq->length (static_cast<CORBA::ULong> (cdr.total_length ()));
-      CORBA::Octet *buf = octet_seq->get_buffer ();
-
-      for (const ACE_Message_Block *i = cdr.begin ();
-           i != 0;
-           i = i->cont ())
-        {
-          size_t len = i->length ();
-          ACE_OS::memcpy (buf,
-                          i->rd_ptr (),
-                          len);
-          buf += len;
-        }
-
-      return safe_octet_seq._retn ();
+      impl->marshal_value (cdr);
     }
 
-  throw ::CORBA::MARSHAL ();
+  // TAO extension: replace the contents of the octet sequence with
+  // the CDR stream.
+  cdr.copy_to (octets);
 }
 
 CORBA::Any *
 TAO_CDR_Encaps_Codec::decode_value (const CORBA::OctetSeq & data,
                                     CORBA::TypeCode_ptr tc)
 {
-  // The ACE_CDR::mb_align() call can shift the rd_ptr by up
-  // to ACE_CDR::MAX_ALIGNMENT-1 bytes. Similarly, the offset
-  // adjustment can move the rd_ptr by up to the same amount.
-  // We accommodate this by including
-  // 2 * ACE_CDR::MAX_ALIGNMENT bytes of additional space in
-  // the message block.
-  ACE_Message_Block mb (data.length () + 2 * ACE_CDR::MAX_ALIGNMENT);
-  ACE_CDR::mb_align (&mb);
-
-  ACE_OS::memcpy (mb.rd_ptr (),
-                  data.get_buffer (),
-                  data.length ());
+  CORBA::Any * any = 0;
+  ACE_NEW_THROW_EX (any,
+                    CORBA::Any,
+                    CORBA::NO_MEMORY (
+                        CORBA::SystemException::_tao_minor_code (
+                            0,
+                            ENOMEM
+                          ),
+                        CORBA::COMPLETED_NO
+                      ));
+
+  CORBA::Any_var safe_any = any;
+
+  this->decode_value (data, tc, *any);
 
+  return safe_any._retn ();
+}
+
+void
+TAO_CDR_Encaps_Codec::decode_value (const CORBA::OctetSeq & data,
+                                    CORBA::TypeCode_ptr tc,
+                                    CORBA::Any & any)
+{
   // @todo How do we check for a type mismatch so that we can
   //       throw a IOP::Codec::TypeMismatch exception?
   //       @@ I added a check below.  See the comment.  I'm not sure
@@ -269,56 +356,24 @@ TAO_CDR_Encaps_Codec::decode_value (const CORBA::OctetSeq & data,
   //       rather than attempt to extract it from the CDR
   //       encapsulation.
 
-  size_t rd_pos = mb.rd_ptr () - mb.base ();
-  size_t wr_pos = mb.wr_ptr () - mb.base () + data.length ();
+  Input_CDR cdr (*this, data);
 
-  TAO_InputCDR cdr (mb.data_block (),
-                    ACE_Message_Block::DONT_DELETE,
-                    rd_pos,
-                    wr_pos,
-                    ACE_CDR_BYTE_ORDER,
-                    this->major_,
-                    this->minor_,
-                    this->orb_core_);
+  if (!cdr.good_bit ())
+    throw IOP::Codec::FormatMismatch ();
 
-  if (this->char_translator_)
-    {
-      this->char_translator_->assign (&cdr);
-    }
-  if (this->wchar_translator_)
-    {
-      this->wchar_translator_->assign (&cdr);
-    }
-
-  CORBA::Boolean byte_order;
-
-  if (cdr >> TAO_InputCDR::to_boolean (byte_order))
-    {
-      cdr.reset_byte_order (static_cast<int> (byte_order));
-
-      CORBA::Any * any = 0;
-      ACE_NEW_THROW_EX (any,
-                        CORBA::Any,
-                        CORBA::NO_MEMORY (
-                            CORBA::SystemException::_tao_minor_code (
-                                0,
-                                ENOMEM
-                              ),
-                            CORBA::COMPLETED_NO
-                          ));
-
-      CORBA::Any_var safe_any = any;
-
-      // Stick it into the Any.
-      TAO::Unknown_IDL_Type *unk = 0;
-      ACE_NEW_RETURN (unk,
-                      TAO::Unknown_IDL_Type (tc, cdr),
-                      0);
-      any->replace (unk);
-      return safe_any._retn ();
-    }
-
-  throw IOP::Codec::FormatMismatch ();
+  // Stick it into the Any.  The value is copied out of the
+  // encapsulation, which need not outlive the Any.
+  TAO::Unknown_IDL_Type *unk = 0;
+  ACE_NEW_THROW_EX (unk,
+                    TAO::Unknown_IDL_Type (tc, cdr),
+                    CORBA::NO_MEMORY (
+                        CORBA::SystemException::_tao_minor_code (
+                            0,
+                            ENOMEM
+                          ),
+                        CORBA::COMPLETED_NO
+                      ));
+  any.replace (unk);
 }
 
 void
@@ -326,11 +381,14 @@ TAO_CDR_Encaps_Codec::check_type_for_encoding (const CORBA::Any & data)
 {
   // @@ TODO: Are there any other conditions we need to check?
 
-  CORBA::TypeCode_var typecode = data.type ();
-  if (this->major_ == 1
-      && this->minor_ == 0
-      && typecode->equivalent (CORBA::_tc_wstring))
-    throw IOP::Codec::InvalidTypeForEncoding ();
+  // Only GIOP 1.0 restricts the types, so don't bother duplicating
+  // the TypeCode otherwise.
+  if (this->major_ == 1 && this->minor_ == 0)
+    {
+      CORBA::TypeCode_var typecode = data.type ();
+      if (typecode->equivalent (CORBA::_tc_wstring))
+        throw IOP::Codec::InvalidTypeForEncoding ();
+    }
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -20,6 +20,10 @@
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "tao/LocalObject.h"
+#include "tao/CDR.h"
+#include "tao/OctetSeqC.h"
+
+#include <memory>
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -40,8 +44,15 @@ class TAO_Codeset_Translator_Base;
  * @note This Codec should not be used for operations internal to the
  * ORB core since it uses interpretive marshaling rather than compiled
  * marshaling.
+ *
+ * Besides the IOP::Codec operations, which allocate a new octet
+ * sequence or Any on every call, this class offers TAO-specific
+ * variants that reuse storage supplied by the caller.  Those are
+ * meant for interceptors and services that encode or decode a
+ * service context on every request.  Obtain them by a
+ * @c dynamic_cast of the IOP::Codec returned by the CodecFactory.
  */
-class TAO_CDR_Encaps_Codec
+class TAO_CODECFACTORY_Export TAO_CDR_Encaps_Codec
   : public virtual IOP::Codec,
     public virtual ::CORBA::LocalObject
 {
@@ -70,6 +81,107 @@ public:
   virtual CORBA::Any * decode_value (const CORBA::OctetSeq & data,
                                      CORBA::TypeCode_ptr tc);
 
+  /**
+   * @name TAO-specific reusing variants
+   *
+   * The encoding variants reuse the buffer of @a octets when it is
+   * large enough, and the decoding variants replace the value of an
+   * existing Any.  Small encapsulations are encoded and decoded
+   * without any heap allocation besides the Any value.
+   */
+  //@{
+  void encode (const CORBA::Any & data, CORBA::OctetSeq & octets);
+
+  void decode (const CORBA::OctetSeq & data, CORBA::Any & any);
+
+  void encode_value (const CORBA::Any & data, CORBA::OctetSeq & octets);
+
+  void decode_value (const CORBA::OctetSeq & data,
+                     CORBA::TypeCode_ptr tc,
+                     CORBA::Any & any);
+
+  /// Encode @a value, excluding the TypeCode, without going through
+  /// an Any.
+  /**
+   * Uses the compiled marshaling of @c T, so the result is the same
+   * as encode_value() of an Any holding @a value.
+   */
+  template<typename T>
+  void tao_encode_value (const T & value, CORBA::OctetSeq & octets);
+
+  /// Decode the value encoded by tao_encode_value() or
+  /// encode_value() straight into @a value.
+  template<typename T>
+  void tao_decode_value (const CORBA::OctetSeq & data, T & value);
+  //@}
+
+  /// Storage for the first few hundred bytes of Output_CDR and
+  /// Input_CDR.
+  /**
+   * A separate base, so that it is initialized before the stream
+   * that uses it.
+   */
+  class TAO_CODECFACTORY_Export Stream_Buffer
+  {
+  protected:
+    Stream_Buffer ();
+
+    char buffer_[ACE_CDR::DEFAULT_BUFSIZE + ACE_CDR::MAX_ALIGNMENT];
+  };
+
+  /// CDR encapsulation being encoded with the GIOP version and code
+  /// set translators of a Codec.
+  /**
+   * The byte order octet that starts the encapsulation is written on
+   * construction.  The stream can also be handed to
+   * TAO_Service_Context::set_context() directly.
+   */
+  class TAO_CODECFACTORY_Export Output_CDR
+    : private Stream_Buffer,
+      public TAO_OutputCDR
+  {
+  public:
+    explicit Output_CDR (TAO_CDR_Encaps_Codec const & codec);
+
+    /// Copy the encapsulation to @a octets, reusing its buffer when
+    /// it owns a large enough one.
+    void copy_to (CORBA::OctetSeq & octets) const;
+  };
+
+  /// Storage for Input_CDR, which reads an encapsulation in place
+  /// if possible.
+  class TAO_CODECFACTORY_Export Input_Buffer : protected Stream_Buffer
+  {
+  protected:
+    explicit Input_Buffer (CORBA::OctetSeq const & data);
+
+    /// Aligned copy of an encapsulation that fits neither in place
+    /// nor in the stream buffer.
+    std::unique_ptr<char[]> heap_;
+
+    /// Points to the octet sequence, to the stream buffer, or to
+    /// heap_.  It never owns its storage, so a stream reading it never
+    /// shares it beyond the lifetime of the Input_CDR.
+    ACE_Data_Block block_;
+  };
+
+  /// Reads a CDR encapsulation with the GIOP version and code set
+  /// translators of a Codec.
+  /**
+   * The octet sequence is read in place when its buffer is suitably
+   * aligned, and otherwise copied to an aligned buffer.  The byte
+   * order octet has been consumed on construction; the stream's
+   * good_bit() is cleared if there was none.
+   */
+  class TAO_CODECFACTORY_Export Input_CDR
+    : private Input_Buffer,
+      public TAO_InputCDR
+  {
+  public:
+    Input_CDR (TAO_CDR_Encaps_Codec const & codec,
+               CORBA::OctetSeq const & data);
+  };
+
 protected:
   /// Destructor.
   /**
@@ -109,6 +221,30 @@ private:
   TAO_Codeset_Translator_Base * wchar_translator_;
 };
 
+template<typename T>
+void
+TAO_CDR_Encaps_Codec::tao_encode_value (const T & value,
+                                        CORBA::OctetSeq & octets)
+{
+  Output_CDR cdr (*this);
+
+  if (!(cdr << value))
+    throw ::CORBA::MARSHAL ();
+
+  cdr.copy_to (octets);
+}
+
+template<typename T>
+void
+TAO_CDR_Encaps_Codec::tao_decode_value (const CORBA::OctetSeq & data,
+                                        T & value)
+{
+  Input_CDR cdr (*this, data);
+
+  if (!cdr.good_bit () || !(cdr >> value))
+    throw IOP::Codec::FormatMismatch ();
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
 
 #include /**/ "ace/post.h"
@@ -4,3 +4,9 @@
 TAO_GIOP_Fragmentation_Strategy::~TAO_GIOP_Fragmentation_Strategy ()
 {
 }
+
+ACE_CDR::ULong
+TAO_GIOP_Fragmentation_Strategy::max_message_size () const
+{
+  return 0;
+}
@@ -67,6 +67,14 @@ public:
                         ACE_CDR::ULong pending_alignment,
                         ACE_CDR::ULong pending_length) = 0;
 
+  /// Size of the GIOP messages at which the strategy sends a
+  /// fragment, or zero if it never fragments.
+  /**
+   * The CDR stream uses it to split large arrays into pieces that fit
+   * in a fragment, see TAO_OutputCDR::write_octet_array().
+   */
+  virtual ACE_CDR::ULong max_message_size () const;
+
 private:
   TAO_GIOP_Fragmentation_Strategy (TAO_GIOP_Fragmentation_Strategy const &) = delete;
   void operator= (TAO_GIOP_Fragmentation_Strategy const &) = delete;
@@ -1785,11 +1785,6 @@ TAO_GIOP_Message_Base::consolidate_fragmented_message (
   TAO_Queued_Data * qd,
   TAO_Queued_Data *& msg)
 {
-  TAO::Incoming_Message_Stack reverse_stack;
-
-  TAO_Queued_Data *tail = nullptr;
-  TAO_Queued_Data *head = nullptr;
-
   //
   // CONSOLIDATE FRAGMENTED MESSAGE
   //
@@ -1806,8 +1801,10 @@ TAO_GIOP_Message_Base::consolidate_fragmented_message (
       return -1; // error: GIOP-1.0 does not support fragments
     }
 
-  // If this is not the last fragment, push it onto stack for later processing
-  if (qd->more_fragments ())
+  // The first message of a fragmented request or reply starts a new
+  // entry on the stack, the fragments that follow are appended to it
+  // as they arrive rather than all at once after the last one.
+  if (qd->msg_type () != GIOP::Fragment)
     {
       this->fragment_stack_.push (qd);
 
@@ -1815,113 +1812,120 @@ TAO_GIOP_Message_Base::consolidate_fragmented_message (
       return 1;  // status: more messages expected.
     }
 
-  tail = qd;  // init
-
-  // Add the current message block to the end of the chain
-  // after adjusting the read pointer to skip the header(s)
+  // Adjust the read pointer to skip the header(s)
   size_t const header_adjustment =
     this->header_length () +
-    this->fragment_header_length (tail->giop_version ().major_version ());
+    this->fragment_header_length (qd->giop_version ().major_version ());
 
-  if (tail->msg_block ()->length () < header_adjustment)
+  if (qd->msg_block ()->length () < header_adjustment)
     {
       // buffer length not sufficient
       TAO_Queued_Data::release (qd);
       return -1;
     }
 
-  // duplicate code to speed up both processes, for GIOP-1.1 and GIOP-1.2
-  if (tail->giop_version ().major_version () == 1 && tail->giop_version ().minor_version () == 1)
-    {
-      // GIOP-1.1
+  bool const giop11 = qd->giop_version ().major_version () == 1 &&
+                      qd->giop_version ().minor_version () == 1;
 
-      while (this->fragment_stack_.pop (head) != -1)
-        {
-          if (head->more_fragments () &&
-              head->giop_version ().major_version () == 1 &&
-              head->giop_version ().minor_version () == 1 &&
-              head->msg_block ()->length () >= header_adjustment)
-            {
-              // adjust the read-pointer, skip the fragment header
-              tail->msg_block ()->rd_ptr(header_adjustment);
-
-              head->msg_block ()->cont (tail->msg_block ());
+  CORBA::ULong request_id = 0;
+  if (!giop11 && this->parse_request_id (qd, request_id) == -1)
+    {
+      TAO_Queued_Data::release (qd);
+      return -1;
+    }
 
-              tail->msg_block (nullptr);
+  // Look for the message this fragment belongs to, GIOP-1.1 fragments
+  // carry no request id and belong to the last GIOP-1.1 message.
+  TAO_Queued_Data *head = nullptr;
+  this->fragment_stack_.top (head);
 
-              TAO_Queued_Data::release (tail);
+  for (; head != nullptr; head = head->next ())
+    {
+      if (!head->more_fragments ())
+        {
+          continue;
+        }
 
-              tail = head;
+      if (giop11)
+        {
+          if (head->giop_version ().major_version () == 1 &&
+              head->giop_version ().minor_version () == 1)
+            {
+              break;
             }
-          else
+        }
+      else
+        {
+          CORBA::ULong head_request_id = 0;
+
+          if (head->giop_version ().major_version () >= 1 &&
+              head->giop_version ().minor_version () >= 2 &&
+              this->parse_request_id (head, head_request_id) != -1 &&
+              request_id == head_request_id)
             {
-              reverse_stack.push (head);
+              break;
             }
         }
     }
-  else
-    {
-      // > GIOP-1.2
 
-      CORBA::ULong tmp_request_id = 0;
-      if (this->parse_request_id (tail, tmp_request_id) == -1)
+  if (head == nullptr)
+    {
+      // No message to append to, keep the fragment as it is.
+      if (qd->more_fragments ())
         {
-          return -1;
+          this->fragment_stack_.push (qd);
+
+          msg = nullptr;
+          return 1;
         }
 
-      CORBA::ULong const request_id = tmp_request_id;
+      msg = qd;
+      return 0;
+    }
 
-      while (this->fragment_stack_.pop (head) != -1)
-        {
-          CORBA::ULong head_request_id = 0;
-          int parse_status = 0;
+  qd->msg_block ()->rd_ptr (header_adjustment);
 
-          if (head->more_fragments () &&
-              head->giop_version ().major_version () >= 1 &&
-              head->giop_version ().minor_version () >= 2 &&
-              head->msg_block ()->length () >= header_adjustment &&
-              (parse_status = this->parse_request_id (head, head_request_id)) != -1 &&
-              request_id == head_request_id)
-            {
-              // adjust the read-pointer, skip the fragment header
-              tail->msg_block ()->rd_ptr(header_adjustment);
+  if (head->append (*qd->msg_block ()) == -1)
+    {
+      // memory allocation failed
+      TAO_Queued_Data::release (qd);
+      return -1;
+    }
 
-              head->msg_block ()->cont (tail->msg_block ());
+  bool const more_fragments = qd->more_fragments ();
 
-              tail->msg_block (nullptr);
+  TAO_Queued_Data::release (qd);
 
-              TAO_Queued_Data::release (tail);
+  if (more_fragments)
+    {
+      msg = nullptr;   // no consolidated message available yet
+      return 1;  // status: more messages expected.
+    }
 
-              tail = head;
-            }
-          else
-            {
-              if (parse_status == -1)
-                {
-                  TAO_Queued_Data::release (head);
-                  return -1;
-                }
+  // This was the last fragment, take the message off the stack.
+  TAO::Incoming_Message_Stack reverse_stack;
+  TAO_Queued_Data *entry = nullptr;
 
-              reverse_stack.push (head);
-            }
-        }
+  while (this->fragment_stack_.pop (entry) != -1 && entry != head)
+    {
+      reverse_stack.push (entry);
     }
 
   // restore stack
-  while (reverse_stack.pop (head) != -1)
+  while (reverse_stack.pop (entry) != -1)
     {
-      this->fragment_stack_.push (head);
+      this->fragment_stack_.push (entry);
     }
 
-  if (tail->consolidate () == -1)
+  if (head->consolidate () == -1)
     {
       // memory allocation failed
-      TAO_Queued_Data::release (tail);
+      TAO_Queued_Data::release (head);
       return -1;
     }
 
   // set out value
-  msg = tail;
+  msg = head;
 
   return 0;
 }
@@ -130,11 +130,11 @@ public:
   TAO_OutputCDR &out_stream ();
 
   /// Consolidate fragmented message with associated fragments, being
-  /// stored within this class.  If reliable transport is used (like
-  /// TCP) fragments are partially ordered on stack, last fragment on
-  /// top. Otherwise If un-reliable transport is used (like UDP)
-  /// fragments may be dis-ordered, and must be ordered before
-  /// consolidation.  @return 0 on success and @a msg points to
+  /// stored within this class.  The body of each fragment is appended
+  /// to the message it belongs to as soon as it arrives, so only one
+  /// buffer per message is kept on the stack.  Fragments are expected
+  /// in order, as a reliable transport (like TCP) delivers them.
+  /// @return 0 on success and @a msg points to
   /// consolidated message, 1 if there are still fragments outstanding,
   /// in case of error -1 is being returned. In any case @a qd must be
   /// released by method implementation.
@@ -251,8 +251,8 @@ private:
   /// All the implementations of GIOP message generator and parsers
   TAO_GIOP_Message_Generator_Parser_Impl tao_giop_impl_;
 
-  /// All Fragments being received are stored on stack in reverse
-  /// order, last top
+  /// Messages whose fragments are being received, most recent on
+  /// top
   TAO::Incoming_Message_Stack fragment_stack_;
 
 protected:
@@ -58,6 +58,7 @@
 #include "ace/checked_iterator.h"
 
 #include <algorithm>
+#include <utility>
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -131,6 +132,20 @@ public:
     swap(tmp);
   }
 
+  /// Move constructor, takes over the buffer of @a rhs and leaves it
+  /// an empty sequence without a buffer.
+  generic_sequence(generic_sequence && rhs) noexcept
+    : maximum_(rhs.maximum_)
+    , length_(rhs.length_)
+    , buffer_(rhs.buffer_)
+    , release_(rhs.release_)
+  {
+    rhs.maximum_ = allocation_traits::default_maximum();
+    rhs.length_ = 0;
+    rhs.buffer_ = 0;
+    rhs.release_ = false;
+  }
+
   /// Assignment operator
   generic_sequence & operator=(generic_sequence const & rhs)
   {
@@ -139,6 +154,15 @@ public:
     return * this;
   }
 
+  /// Move assignment operator, the old buffer of this sequence is
+  /// released before this returns.
+  generic_sequence & operator=(generic_sequence && rhs) noexcept
+  {
+    generic_sequence tmp(std::move(rhs));
+    swap(tmp);
+    return * this;
+  }
+
   /// Destructor.
   ~generic_sequence()
   {
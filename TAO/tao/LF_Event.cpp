@@ -29,8 +29,12 @@ TAO_LF_Event::state_changed (LFS_STATE new_state, TAO_Leader_Follower &lf)
     {
       this->state_changed_i (new_state);
 
-      /// Sort of double-checked optimization..
-      if (this->follower_ != nullptr)
+      /// Sort of double-checked optimization..  Only wake up the
+      /// bound follower when it can stop waiting, any other change
+      /// would just send it back to sleep.  A follower bound to a
+      /// TAO_LF_Multi_Event is bound to each of its events too, and
+      /// the multi event only stops waiting when one of them does.
+      if (this->follower_ != nullptr && !this->keep_waiting_i ())
         this->follower_->signal ();
     }
 }
@@ -84,9 +84,19 @@ TAO_Leader_Follower::elect_new_leader_i ()
               follower));
 #endif /* TAO_DEBUG_LEADER_FOLLOWER */
 
+  this->elected_follower_ = follower;
+  ++this->statistics_.leader_changes;
+
   return follower->signal ();
 }
 
+TAO_Leader_Follower::Statistics
+TAO_Leader_Follower::statistics ()
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock (), this->statistics_);
+  return this->statistics_;
+}
+
 int
 TAO_Leader_Follower::wait_for_client_leader_to_complete (ACE_Time_Value *max_wait_time)
 {
@@ -289,9 +299,10 @@ TAO_Leader_Follower::wait_for_event (TAO_LF_Event *event,
            && result != -1)
     { // Scope #2: threads here alternate between being leader/followers
 
-      // Check if there is a leader.  Note that it cannot be us since we
-      // gave up our leadership when we became a client.
-      if (this->leader_available ())
+      // Check if there is a leader, or a follower about to take
+      // over.  Note that it cannot be us since we gave up our
+      // leadership when we became a client.
+      if (this->leader_expected ())
       { // Scope #3: threads here are followers
         // = Wait as a follower.
 
@@ -310,8 +321,11 @@ TAO_Leader_Follower::wait_for_event (TAO_LF_Event *event,
         // get a signal when the event terminates
         TAO_LF_Event_Binder event_binder (event, follower.get ());
 
+        // Set when we wake up promoted to the leader role.
+        bool elected = false;
+
         while (event->keep_waiting_i () &&
-               this->leader_available ())
+               this->leader_expected ())
         { // Scope #4: this loop handles spurious wake-ups
           // Add ourselves to the list, do it everytime we wake up
           // from the CV loop. Because:
@@ -349,9 +363,11 @@ TAO_Leader_Follower::wait_for_event (TAO_LF_Event *event,
                               ACE_TEXT (" (follower) [no timer, cond failed]\n"),
                               t_id));
 
-                // @@ Michael: What is our error handling in this case?
-                //             We could be elected as leader and
-                //             no leader would come in?
+                // Pass on the leader role if we were promoted, so
+                // the remaining followers are not left without a
+                // leader.
+                if (this->take_election (follower.get ()))
+                  (void) this->elect_new_leader ();
                 return -1;
               }
           }
@@ -375,7 +391,8 @@ TAO_Leader_Follower::wait_for_event (TAO_LF_Event *event,
                     // We have timedout
                     event->set_state (TAO_LF_Event::LFS_TIMEOUT);
 
-                if (!event->successful_i ())
+                if (this->take_election (follower.get ())
+                    || !event->successful_i ())
                 {
                   // Remove follower can fail because either
                   // 1) the condition was satisfied (i.e. reply
@@ -406,6 +423,16 @@ TAO_Leader_Follower::wait_for_event (TAO_LF_Event *event,
               return -1;
             }
           }
+
+          // Withdraw a pending promotion before anybody else looks
+          // at leader_expected(): if our event completed or another
+          // thread took over in the meantime, we do not lead.
+          elected = this->take_election (follower.get ());
+
+          if (!event->keep_waiting_i ())
+            ++this->statistics_.event_wakeups;
+          else if (this->leader_expected ())
+            ++this->statistics_.spurious_wakeups;
         } // End Scope #4: loop to handle spurious wakeups
 
         countdown.update ();
@@ -426,6 +453,11 @@ TAO_Leader_Follower::wait_for_event (TAO_LF_Event *event,
         // Now somebody woke us up to become a leader or to handle our
         // input. We are already removed from the follower queue.
 
+        // If our reply arrived just as we were promoted, hand the
+        // leader role to the next follower.
+        if (elected && !event->keep_waiting_i ())
+          (void) this->elect_new_leader ();
+
         if (event->successful_i ())
           return 0;
 
@@ -70,6 +70,10 @@ public:
   /// Is there any thread running as a leader?
   bool leader_available () const;
 
+  /// Is there any thread running as a leader, or a follower promoted
+  /// to take over the leader role that has not woken up yet?
+  bool leader_expected () const;
+
   /// A server thread is making a request.
   void set_client_thread ();
 
@@ -196,6 +200,24 @@ public:
   /// returns false).
   int defer_event (ACE_Event_Handler*);
 
+  /// Counters of the wake-ups in the Leader/Followers set.
+  struct Statistics
+  {
+    /// Followers promoted to the leader role.
+    ACE_UINT64 leader_changes;
+
+    /// Followers woken up because the event they wait for completed,
+    /// i.e. replies handed over by the thread that read them.
+    ACE_UINT64 event_wakeups;
+
+    /// Followers that woke up to find their event still pending and
+    /// another thread leading, so they had to wait again.
+    ACE_UINT64 spurious_wakeups;
+  };
+
+  /// Return a snapshot of the wake-up counters.
+  Statistics statistics ();
+
 private:
   /// Shortcut to obtain the TSS resources of the orb core.
   TAO_ORB_Core_TSS_Resources *get_tss_resources () const;
@@ -223,6 +245,10 @@ private:
    */
   int elect_new_leader_i ();
 
+  /// Return true if @a follower was the one promoted by
+  /// elect_new_leader_i(), withdrawing its pending promotion.
+  bool take_election (TAO_LF_Follower *follower);
+
   //@}
 
   /// Method to allow the Leader_Follower to resume deferred events
@@ -246,6 +272,18 @@ private:
   /// Use a free list to allocate and release Follower objects
   Follower_Set follower_free_list_;
 
+  /**
+   * The follower signaled to take over the leader role that has not
+   * woken up yet.  While it is set no other follower is elected and
+   * new client threads wait as followers instead of running the
+   * reactor themselves, so the promoted thread does not wake up to
+   * find its place taken.
+   */
+  TAO_LF_Follower *elected_follower_;
+
+  /// Wake-up counters, protected by @c lock_.
+  Statistics statistics_;
+
   /**
    * Count the number of active leaders.
    * There could be many leaders in the thread pool (i.e. calling
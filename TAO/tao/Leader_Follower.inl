@@ -11,6 +11,8 @@ TAO_Leader_Follower::TAO_Leader_Follower (TAO_ORB_Core* orb_core,
                                           TAO_New_Leader_Generator *new_leader_generator)
   : orb_core_ (orb_core),
     reverse_lock_ (lock_),
+    elected_follower_ (nullptr),
+    statistics_ (),
     leaders_ (0),
     clients_ (0),
     reactor_ (0),
@@ -57,6 +59,12 @@ TAO_Leader_Follower::elect_new_leader ()
         {
           return this->event_loop_threads_condition_.broadcast ();
         }
+      else if (this->elected_follower_ != nullptr)
+        {
+          // A follower is already on its way to take over, waking up
+          // another one would only send it back to sleep.
+          return 0;
+        }
       else if (this->follower_available ())
         {
           return this->elect_new_leader_i ();
@@ -163,6 +171,12 @@ TAO_Leader_Follower::leader_available () const
   return this->leaders_ != 0;
 }
 
+ACE_INLINE bool
+TAO_Leader_Follower::leader_expected () const
+{
+  return this->leaders_ != 0 || this->elected_follower_ != nullptr;
+}
+
 ACE_INLINE void
 TAO_Leader_Follower::set_client_leader_thread ()
 {
@@ -206,6 +220,16 @@ TAO_Leader_Follower::remove_follower (TAO_LF_Follower *follower)
   this->follower_set_.remove (follower);
 }
 
+ACE_INLINE bool
+TAO_Leader_Follower::take_election (TAO_LF_Follower *follower)
+{
+  if (this->elected_follower_ != follower)
+    return false;
+
+  this->elected_follower_ = nullptr;
+  return true;
+}
+
 ACE_INLINE ACE_Reverse_Lock<TAO_SYNCH_MUTEX> &
 TAO_Leader_Follower::reverse_lock ()
 {
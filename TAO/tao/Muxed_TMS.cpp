@@ -7,12 +7,51 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+namespace
+{
+  // States of a slot, kept in the lower 32 bits of its tag.
+  ACE_UINT64 const SLOT_FREE = 0;
+  ACE_UINT64 const SLOT_BUSY = 1;
+  ACE_UINT64 const SLOT_BOUND = 2;
+  ACE_UINT64 const SLOT_STATE_MASK = 0xffffffffu;
+
+  // Slot tables are never made larger than this.
+  CORBA::ULong const SLOT_COUNT_MAX = 1u << 20;
+
+  ACE_UINT64
+  slot_tag (CORBA::ULong request_id, ACE_UINT64 state)
+  {
+    return (static_cast<ACE_UINT64> (request_id) << 32) | state;
+  }
+
+  CORBA::ULong
+  slot_count (int slots)
+  {
+    if (slots <= 0)
+      return 0;
+
+    CORBA::ULong count = 1;
+    while (count < static_cast<CORBA::ULong> (slots) && count < SLOT_COUNT_MAX)
+      count <<= 1;
+    return count;
+  }
+}
+
+TAO_Muxed_TMS::Slot::Slot ()
+  : tag_ (slot_tag (0, SLOT_FREE))
+  , rd_ (nullptr)
+{
+}
+
 TAO_Muxed_TMS::TAO_Muxed_TMS (TAO_Transport *transport)
   : TAO_Transport_Mux_Strategy (transport)
     , lock_ (nullptr)
     , request_id_generator_ (0)
     , orb_core_ (transport->orb_core ())
     , dispatcher_table_ (this->orb_core_->client_factory ()->reply_dispatcher_table_size ())
+    , slot_count_ (slot_count (this->orb_core_->client_factory ()->reply_dispatcher_slots ()))
+    , slots_ (nullptr)
+    , bound_slots_ (0)
 {
   this->lock_ =
     this->orb_core_->client_factory ()->create_transport_mux_strategy_lock ();
@@ -20,22 +59,113 @@ TAO_Muxed_TMS::TAO_Muxed_TMS (TAO_Transport *transport)
 
 TAO_Muxed_TMS::~TAO_Muxed_TMS ()
 {
+  Slot * const slots = this->slots_.load ();
+  if (slots != nullptr)
+    {
+      for (CORBA::ULong i = 0; i != this->slot_count_; ++i)
+        if ((slots[i].tag_.load () & SLOT_STATE_MASK) == SLOT_BOUND)
+          TAO_Reply_Dispatcher::intrusive_remove_ref (slots[i].rd_);
+      delete [] slots;
+    }
+
   delete this->lock_;
 }
 
-// Generate and return an unique request id for the current
-// invocation.
-CORBA::ULong
-TAO_Muxed_TMS::request_id ()
+TAO_Muxed_TMS::Slot *
+TAO_Muxed_TMS::slots ()
+{
+  Slot *slots = this->slots_.load (std::memory_order_acquire);
+  if (slots != nullptr || this->slot_count_ == 0)
+    return slots;
+
+  ACE_NEW_NORETURN (slots, Slot[this->slot_count_]);
+  if (slots == nullptr)
+    return nullptr;
+
+  // Another thread may have beaten us to it, use its table then.
+  Slot *expected = nullptr;
+  if (!this->slots_.compare_exchange_strong (expected,
+                                             slots,
+                                             std::memory_order_acq_rel))
+    {
+      delete [] slots;
+      slots = expected;
+    }
+  return slots;
+}
+
+bool
+TAO_Muxed_TMS::bind_slot (CORBA::ULong request_id, TAO_Reply_Dispatcher *rd)
+{
+  Slot * const slots = this->slots ();
+  if (slots == nullptr)
+    return false;
+
+  Slot &slot = slots[request_id & (this->slot_count_ - 1)];
+  ACE_UINT64 tag = slot.tag_.load (std::memory_order_relaxed);
+  if ((tag & SLOT_STATE_MASK) != SLOT_FREE
+      || !slot.tag_.compare_exchange_strong (tag,
+                                             slot_tag (request_id, SLOT_BUSY),
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed))
+    return false;
+
+  TAO_Reply_Dispatcher::intrusive_add_ref (rd);
+  slot.rd_ = rd;
+  ++this->bound_slots_;
+  slot.tag_.store (slot_tag (request_id, SLOT_BOUND),
+                   std::memory_order_release);
+  return true;
+}
+
+TAO_Reply_Dispatcher *
+TAO_Muxed_TMS::take_slot (CORBA::ULong request_id)
+{
+  Slot * const slots = this->slots_.load (std::memory_order_acquire);
+  if (slots == nullptr)
+    return nullptr;
+
+  Slot &slot = slots[request_id & (this->slot_count_ - 1)];
+  ACE_UINT64 tag = slot_tag (request_id, SLOT_BOUND);
+  if (!slot.tag_.compare_exchange_strong (tag,
+                                          slot_tag (request_id, SLOT_BUSY),
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed))
+    return nullptr;
+
+  TAO_Reply_Dispatcher * const rd = slot.rd_;
+  slot.rd_ = nullptr;
+  --this->bound_slots_;
+  slot.tag_.store (slot_tag (request_id, SLOT_FREE),
+                   std::memory_order_release);
+  return rd;
+}
+
+int
+TAO_Muxed_TMS::unbind_i (CORBA::ULong request_id,
+                         ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> &rd)
 {
-  // @@ What is a good error return value?
+  TAO_Reply_Dispatcher * const slot_rd = this->take_slot (request_id);
+  if (slot_rd != nullptr)
+    {
+      // Adopt the reference the slot held.
+      rd = ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> (slot_rd, false);
+      return 0;
+    }
+
   ACE_GUARD_RETURN (ACE_Lock,
                     ace_mon,
                     *this->lock_,
-                    0);
+                    -1);
 
-  ++this->request_id_generator_;
+  return this->dispatcher_table_.unbind (request_id, rd);
+}
 
+// Generate and return an unique request id for the current
+// invocation.
+CORBA::ULong
+TAO_Muxed_TMS::request_id ()
+{
   // if TAO_Transport::bidirectional_flag_
   //  ==  1 --> originating side
   //  ==  0 --> other side
@@ -44,17 +174,21 @@ TAO_Muxed_TMS::request_id ()
   // side must have an odd request ID.  Make sure that is the case.
   int const bidir_flag = this->transport_->bidirectional_flag ();
 
-  if ((bidir_flag == 1 && ACE_ODD (this->request_id_generator_))
-       || (bidir_flag == 0 && ACE_EVEN (this->request_id_generator_)))
-    ++this->request_id_generator_;
+  CORBA::ULong id = 0;
+  do
+    {
+      id = ++this->request_id_generator_;
+    }
+  while ((bidir_flag == 1 && ACE_ODD (id))
+         || (bidir_flag == 0 && ACE_EVEN (id)));
 
   if (TAO_debug_level > 4)
     TAOLIB_DEBUG ((LM_DEBUG,
                 "TAO (%P|%t) - Muxed_TMS[%d]::request_id, [%d]\n",
                 this->transport_->id (),
-                this->request_id_generator_));
+                id));
 
-  return this->request_id_generator_;
+  return id;
 }
 
 /// Bind the dispatcher with the request id.
@@ -62,11 +196,6 @@ int
 TAO_Muxed_TMS::bind_dispatcher (CORBA::ULong request_id,
                                 ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd)
 {
-  ACE_GUARD_RETURN (ACE_Lock,
-                    ace_mon,
-                    *this->lock_,
-                    -1);
-
   if (rd == nullptr)
     {
       if (TAO_debug_level > 0)
@@ -78,6 +207,14 @@ TAO_Muxed_TMS::bind_dispatcher (CORBA::ULong request_id,
       return 0;
     }
 
+  if (this->bind_slot (request_id, rd.get ()))
+    return 0;
+
+  ACE_GUARD_RETURN (ACE_Lock,
+                    ace_mon,
+                    *this->lock_,
+                    -1);
+
   int const result = this->dispatcher_table_.bind (request_id, rd);
 
   if (result != 0)
@@ -97,17 +234,16 @@ TAO_Muxed_TMS::bind_dispatcher (CORBA::ULong request_id,
 int
 TAO_Muxed_TMS::unbind_dispatcher (CORBA::ULong request_id)
 {
-  ACE_GUARD_RETURN (ACE_Lock,
-                    ace_mon,
-                    *this->lock_,
-                    -1);
-
-  return this->dispatcher_table_.unbind (request_id);
+  ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd (nullptr);
+  return this->unbind_i (request_id, rd);
 }
 
 bool
 TAO_Muxed_TMS::has_request ()
 {
+  if (this->bound_slots_.load () > 0)
+    return true;
+
   ACE_GUARD_RETURN (ACE_Lock,
                     ace_mon,
                     *this->lock_,
@@ -123,13 +259,7 @@ TAO_Muxed_TMS::dispatch_reply (TAO_Pluggable_Reply_Params &params)
   ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd(nullptr);
 
   // Grab the reply dispatcher for this id.
-  {
-    ACE_GUARD_RETURN (ACE_Lock,
-                      ace_mon,
-                      *this->lock_,
-                      -1);
-    result = this->dispatcher_table_.unbind (params.request_id_, rd);
-  }
+  result = this->unbind_i (params.request_id_, rd);
 
     if (result == 0 && rd)
       {
@@ -170,14 +300,7 @@ TAO_Muxed_TMS::reply_timed_out (CORBA::ULong request_id)
   ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> rd(nullptr);
 
   // Grab the reply dispatcher for this id.
-  {
-    ACE_GUARD_RETURN (ACE_Lock,
-                      ace_mon,
-                      *this->lock_,
-                      -1);
-
-    result = this->dispatcher_table_.unbind (request_id, rd);
-  }
+  result = this->unbind_i (request_id, rd);
 
   if (result == 0 && rd)
     {
@@ -253,14 +376,33 @@ TAO_Muxed_TMS::connection_closed ()
 int
 TAO_Muxed_TMS::clear_cache_i ()
 {
-  if (this->dispatcher_table_.current_size () == 0)
+  if (this->dispatcher_table_.current_size () == 0
+      && this->bound_slots_.load () == 0)
     return -1;
 
+  ACE_Unbounded_Stack <ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> > ubs;
+
+  // Take the dispatchers of the bound slots; any reply or time out
+  // racing with us finds its slot free.
+  Slot * const slots = this->slots_.load (std::memory_order_acquire);
+  if (slots != nullptr)
+    {
+      for (CORBA::ULong k = 0; k != this->slot_count_; ++k)
+        {
+          ACE_UINT64 const tag = slots[k].tag_.load (std::memory_order_relaxed);
+          if ((tag & SLOT_STATE_MASK) != SLOT_BOUND)
+            continue;
+
+          TAO_Reply_Dispatcher * const rd =
+            this->take_slot (static_cast<CORBA::ULong> (tag >> 32));
+          if (rd != nullptr)
+            ubs.push (ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> (rd, false));
+        }
+    }
+
   REQUEST_DISPATCHER_TABLE::ITERATOR const end =
     this->dispatcher_table_.end ();
 
-  ACE_Unbounded_Stack <ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> > ubs;
-
   for (REQUEST_DISPATCHER_TABLE::ITERATOR i =
          this->dispatcher_table_.begin ();
        i != end;
@@ -23,6 +23,8 @@
 #include "ace/Hash_Map_Manager_T.h"
 #include "ace/Null_Mutex.h"
 
+#include <atomic>
+
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 template <class X> class ACE_Intrusive_Auto_Ptr;
 ACE_END_VERSIONED_NAMESPACE_DECL
@@ -38,11 +40,21 @@ class TAO_Reply_Dispatcher;
  *
  * Using this strategy a single connection can have multiple
  * outstanding requests.
- * @@ Can the performance of the demuxer be made more predictable,
- * for example, using the request id as an active demux key?
- * @note Check the OMG resolutions about bidirectional
- * connections, it is possible that the request ids can only
- * assume even or odd values.
+ *
+ * The reply dispatchers of outstanding requests are kept in a fixed
+ * size table of slots indexed by the low bits of the request id,
+ * which binding and dispatching claim and release with atomic
+ * operations rather than under the lock.  Every slot records the
+ * full request id it holds, which serves as the generation of the
+ * slot: a late reply or time out for a request whose slot has since
+ * been reused does not match.  A request whose slot is still held by
+ * an older one, which only happens with more requests outstanding
+ * than there are slots, goes to a hash map protected by the lock.
+ * The slot table is allocated when the first dispatcher is bound, so
+ * transports that never send requests do not pay for it.
+ *
+ * @note On bidirectional connections request ids only take even or
+ * odd values, so only half of the slots are used.
  */
 class TAO_Export TAO_Muxed_TMS : public TAO_Transport_Mux_Strategy
 {
@@ -75,13 +87,44 @@ private:
   void operator= (const TAO_Muxed_TMS &);
   TAO_Muxed_TMS (const TAO_Muxed_TMS &);
 
+  /// One entry of the slot table.  @c tag_ holds the request id of
+  /// the slot in its upper and the state of the slot in its lower 32
+  /// bits; @c rd_ holds a reference to the dispatcher while the slot
+  /// is bound and is only accessed by the thread that claimed the
+  /// slot.
+  struct Slot
+  {
+    Slot ();
+
+    std::atomic<ACE_UINT64> tag_;
+    TAO_Reply_Dispatcher *rd_;
+  };
+
+  /// Return the slot table, allocating it if needed.  Returns 0 if
+  /// the table is disabled or cannot be allocated.
+  Slot *slots ();
+
+  /// Bind @a rd to the slot of @a request_id.  Returns false if the
+  /// slot is held by another request.
+  bool bind_slot (CORBA::ULong request_id, TAO_Reply_Dispatcher *rd);
+
+  /// Take the dispatcher bound to the slot of @a request_id, along
+  /// with the reference the slot held.  Returns 0 if the slot does
+  /// not hold @a request_id.
+  TAO_Reply_Dispatcher *take_slot (CORBA::ULong request_id);
+
+  /// Remove the dispatcher of @a request_id from the slot table or,
+  /// failing that, the hash map and return it in @a rd.
+  int unbind_i (CORBA::ULong request_id,
+                ACE_Intrusive_Auto_Ptr<TAO_Reply_Dispatcher> &rd);
+
 private:
-  /// Lock to protect the state of the object
+  /// Lock to protect the hash map
   ACE_Lock *lock_;
 
   /// Used to generate a different request_id on each call to
   /// request_id().
-  CORBA::ULong request_id_generator_;
+  std::atomic<CORBA::ULong> request_id_generator_;
 
   /// Keep track of the orb core pointer. We need to this to create the
   /// Reply Dispatchers.
@@ -94,9 +137,20 @@ private:
                                    ACE_Null_Mutex>
     REQUEST_DISPATCHER_TABLE;
 
-  /// Table of <Request ID, Reply Dispatcher> pairs.
+  /// Table of <Request ID, Reply Dispatcher> pairs of the requests
+  /// that did not get a slot.
   REQUEST_DISPATCHER_TABLE dispatcher_table_;
 
+  /// Number of slots, a power of two, or 0 if the slot table is
+  /// disabled.
+  CORBA::ULong const slot_count_;
+
+  /// The slot table.
+  std::atomic<Slot *> slots_;
+
+  /// Number of bound slots.
+  std::atomic<size_t> bound_slots_;
+
   int clear_cache_i ();
 };
 
@@ -37,6 +37,7 @@
 #include "tao/ORBInitializer_Registry_Adapter.h"
 #include "tao/Codeset_Manager.h"
 #include "tao/GIOP_Fragmentation_Strategy.h"
+#include "tao/Transport_Profile.h"
 #include "tao/SystemException.h"
 
 #include "tao/Valuetype_Adapter.h"
@@ -64,6 +65,7 @@
 
 #include "ace/OS_NS_strings.h"
 #include "ace/OS_NS_string.h"
+#include "ace/OS_NS_stdio.h"
 #include "ace/Message_Block.h"
 #include <cstring>
 #include <memory>
@@ -263,6 +265,9 @@ TAO_ORB_Core::TAO_ORB_Core (const char *orbid,
     ziop_enabled_ (false),
     flushing_strategy_ (nullptr),
     codeset_manager_ (nullptr),
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+    transport_profile_ (nullptr),
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
     config_ (gestalt),
     sync_scope_hook_ (nullptr),
     default_sync_scope_ (Messaging::SYNC_WITH_TRANSPORT),
@@ -299,6 +304,29 @@ TAO_ORB_Core::~TAO_ORB_Core ()
 {
   delete this->thread_lane_resources_manager_;
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  // The transports are gone now, and have added their samples to the
+  // profile.
+  if (this->transport_profile_ != nullptr)
+    {
+      FILE *file =
+        ACE_OS::fopen (this->orb_params_.transport_profile (), "w");
+
+      if (file == nullptr || this->transport_profile_->write (file) != 0)
+        {
+          TAOLIB_ERROR ((LM_ERROR,
+                         ACE_TEXT ("TAO (%P|%t) - ORB_Core::~ORB_Core, ")
+                         ACE_TEXT ("cannot write transport profile <%C>\n"),
+                         this->orb_params_.transport_profile ()));
+        }
+
+      if (file != nullptr)
+        ACE_OS::fclose (file);
+
+      delete this->transport_profile_;
+    }
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   delete this->flushing_strategy_;
 
   ACE_OS::free (this->orbid_);
@@ -1084,6 +1112,16 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
         {
           this->orb_params_.max_message_size (ACE_OS::atoi (current_arg));
 
+          arg_shifter.consume_arg ();
+        }
+      else if (nullptr != (current_arg = arg_shifter.get_the_parameter
+                (ACE_TEXT("-ORBTransportProfile"))))
+        {
+          // Profile the transports and write the profile to the given
+          // file when the ORB is destroyed.
+          this->orb_params_.transport_profile (
+            ACE_TEXT_ALWAYS_CHAR (current_arg));
+
           arg_shifter.consume_arg ();
         }
       else if (nullptr != (current_arg = arg_shifter.get_the_parameter
@@ -1444,6 +1482,33 @@ TAO_ORB_Core::init (int &argc, char *argv[] )
   // Initialize the flushing strategy
   this->flushing_strategy_ = trf->create_flushing_strategy ();
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  if (this->orb_params_.transport_profile () != nullptr)
+    {
+      ACE_NEW_THROW_EX (this->transport_profile_,
+                        TAO::Transport::Profile,
+                        CORBA::NO_MEMORY (
+                          CORBA::SystemException::_tao_minor_code (
+                            TAO_ORB_CORE_INIT_LOCATION_CODE,
+                            ENOMEM),
+                          CORBA::COMPLETED_NO));
+
+      // Record what the profile was captured with, so the tuner can
+      // tell what to change.
+      TAO::Transport::Profile &profile = *this->transport_profile_;
+      profile.setting (TAO::Transport::Profile::SNDSOCK,
+                       this->orb_params_.sock_sndbuf_size ());
+      profile.setting (TAO::Transport::Profile::RCVSOCK,
+                       this->orb_params_.sock_rcvbuf_size ());
+      profile.setting (TAO::Transport::Profile::MAX_MESSAGE_SIZE,
+                       this->orb_params_.max_message_size ());
+      profile.setting (TAO::Transport::Profile::CONNECTION_CACHE_MAX,
+                       trf->cache_maximum ());
+      profile.setting (TAO::Transport::Profile::WAIT_SPIN_TIME,
+                       this->client_factory ()->wait_spin_time ());
+    }
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   // Initialize the default sync scope value
   this->default_sync_scope_ = this->client_factory()->sync_scope ();
 
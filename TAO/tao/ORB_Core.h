@@ -107,6 +107,13 @@ namespace TAO
   class PolicyFactory_Registry_Adapter;
   class ORBInitializer_Registry_Adapter;
   class Transport_Queueing_Strategy;
+
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  namespace Transport
+  {
+    class Profile;
+  }
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
 }
 
 namespace CORBA
@@ -876,6 +883,12 @@ public:
   /// Get Code Set Manager
   TAO_Codeset_Manager *codeset_manager ();
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  /// Return the profile the transports of this ORB record into, 0
+  /// unless -ORBTransportProfile was given.
+  TAO::Transport::Profile *transport_profile () const;
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   typedef ACE_Array_Map<ACE_CString, ACE_CString> InitRefMap;
 
   /// Return a pointer to the -ORBInitRef map.
@@ -1258,6 +1271,12 @@ protected:
   /// Code Set Manager, received from the Resource Factory
   TAO_Codeset_Manager *codeset_manager_;
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  /// Transport profile, written to the -ORBTransportProfile file when
+  /// the ORB Core is destroyed.
+  TAO::Transport::Profile *transport_profile_;
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   /// ORB's service configuration
   ACE_Intrusive_Auto_Ptr<ACE_Service_Gestalt> config_;
 
@@ -72,6 +72,14 @@ TAO_ORB_Core::flushing_strategy ()
   return this->flushing_strategy_;
 }
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+ACE_INLINE TAO::Transport::Profile *
+TAO_ORB_Core::transport_profile () const
+{
+  return this->transport_profile_;
+}
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
 ACE_INLINE TAO_Protocols_Hooks *
 TAO_ORB_Core::get_protocols_hooks ()
 {
@@ -93,3 +93,10 @@ TAO_On_Demand_Fragmentation_Strategy::fragment (
 
   return 0;
 }
+
+ACE_CDR::ULong
+TAO_On_Demand_Fragmentation_Strategy::max_message_size () const
+{
+  // Without a transport nothing is ever sent.
+  return this->transport_ == nullptr ? 0 : this->max_message_size_;
+}
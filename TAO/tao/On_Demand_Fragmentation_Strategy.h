@@ -50,6 +50,7 @@ public:
   virtual int fragment (TAO_OutputCDR & cdr,
                         ACE_CDR::ULong pending_alignment,
                         ACE_CDR::ULong pending_length);
+  virtual ACE_CDR::ULong max_message_size () const;
 
 private:
   TAO_On_Demand_Fragmentation_Strategy (TAO_On_Demand_Fragmentation_Strategy const &) = delete;
@@ -1,5 +1,6 @@
 #include "tao/PI/ClientRequestDetails.h"
 #include "tao/SystemException.h"
+#include "ace/OS_NS_string.h"
 
 #if TAO_HAS_INTERCEPTORS == 1
 
@@ -14,8 +15,10 @@ namespace TAO
   void
   ClientRequestDetails::apply_policies (const CORBA::PolicyList &policies)
   {
-    // Flag to check for duplicate ProcessingModePolicy objects in the list.
+    // Flags to check for duplicate ProcessingModePolicy and
+    // OperationFilterPolicy objects in the list.
     bool processing_mode_applied = false;
+    bool operation_filter_applied = false;
 
     const CORBA::ULong plen = policies.length ();
 
@@ -53,6 +56,23 @@ namespace TAO
             // Save the value of the ProcessingModePolicy in our data member.
             this->processing_mode_ = pm_policy->processing_mode ();
           }
+        else if (policy_type == PortableInterceptor::OPERATION_FILTER_POLICY_TYPE)
+          {
+            if (operation_filter_applied)
+              {
+                throw ::CORBA::INV_POLICY ();
+              }
+
+            operation_filter_applied = true;
+
+            PortableInterceptor::OperationFilterPolicy_var of_policy =
+              PortableInterceptor::OperationFilterPolicy::_narrow (policy.in ());
+
+            CORBA::StringSeq_var operations = of_policy->operations ();
+
+            this->operations_ = operations.in ();
+            this->filter_operations_ = true;
+          }
         else
           {
             // We don't support the current policy type.
@@ -60,6 +80,22 @@ namespace TAO
           }
       }
   }
+
+  bool
+  ClientRequestDetails::lists_operation (const char *operation) const
+  {
+    CORBA::ULong const len = this->operations_.length ();
+
+    for (CORBA::ULong i = 0; i < len; ++i)
+      {
+        if (ACE_OS::strcmp (this->operations_[i], operation) == 0)
+          {
+            return true;
+          }
+      }
+
+    return false;
+  }
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
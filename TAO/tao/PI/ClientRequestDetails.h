@@ -56,13 +56,25 @@ namespace TAO
     /// Returns true if the ProcessingMode setting permits the "firing"
     /// of the associated client request interceptor based upon the
     /// remote vs. collocated nature of the current servant request
-    /// that is being dispatched.
-    bool should_be_processed (bool is_remote_request) const;
+    /// that is being dispatched, and the OperationFilterPolicy, if
+    /// any, lists @a operation.
+    bool should_be_processed (bool is_remote_request,
+                              const char *operation) const;
 
   private:
+    /// Returns true if @a operation is one of @c operations_.
+    bool lists_operation (const char *operation) const;
+
     /// The ProcessingMode setting that can be adjusted via the
     /// PortableInterceptor::ProcessingModePolicy.
     PortableInterceptor::ProcessingMode processing_mode_;
+
+    /// True if the interceptor was registered with a
+    /// PortableInterceptor::OperationFilterPolicy.
+    bool filter_operations_;
+
+    /// The operations named by the OperationFilterPolicy.
+    CORBA::StringSeq operations_;
   };
 }
 
@@ -5,19 +5,22 @@ namespace TAO
 {
   ACE_INLINE
   ClientRequestDetails::ClientRequestDetails ()
-    : processing_mode_(PortableInterceptor::LOCAL_AND_REMOTE)
+    : processing_mode_(PortableInterceptor::LOCAL_AND_REMOTE),
+      filter_operations_ (false)
   {
   }
 
   ACE_INLINE
   bool
-  ClientRequestDetails::should_be_processed (bool is_remote_request) const
+  ClientRequestDetails::should_be_processed (bool is_remote_request,
+                                             const char *operation) const
   {
     return ((this->processing_mode_ == PortableInterceptor::LOCAL_AND_REMOTE) ||
             ((this->processing_mode_ == PortableInterceptor::REMOTE_ONLY) &&
              (is_remote_request)) ||
             ((this->processing_mode_ == PortableInterceptor::LOCAL_ONLY) &&
-             (!is_remote_request)));
+             (!is_remote_request))) &&
+           (!this->filter_operations_ || this->lists_operation (operation));
   }
 }
 
@@ -9,6 +9,7 @@
 #include "tao/PI/ClientRequestInfo.h"
 
 #include "tao/Invocation_Base.h"
+#include "tao/operation_details.h"
 #include "tao/ORB_Core.h"
 #include "tao/ORB_Core_TSS_Resources.h"
 #include "tao/PortableInterceptorC.h"
@@ -25,17 +26,32 @@ namespace TAO
     // interception point.
 
     bool const is_remote_request = invocation.is_remote_request();
+    const char *operation = invocation.operation_details ().opname ();
+    size_t const count = this->interceptor_list_.size ();
+
+    // If none of the registered interceptors is interested in this
+    // request don't bother setting up the request info, just push them
+    // all on to the flow stack so that the "ending" interception points
+    // stay balanced.
+    if (!this->interceptor_list_.should_be_processed (count,
+                                                      is_remote_request,
+                                                      operation))
+      {
+        invocation.stack_size () += count;
+        return;
+      }
 
     try
       {
         TAO_ClientRequestInfo ri (&invocation);
 
-        for (size_t i = 0 ; i < this->interceptor_list_.size (); ++i)
+        for (size_t i = 0 ; i < count; ++i)
           {
             ClientRequestInterceptor_List::RegisteredInterceptor& registered =
               this->interceptor_list_.registered_interceptor (i);
 
-            if (registered.details_.should_be_processed (is_remote_request))
+            if (registered.details_.should_be_processed (is_remote_request,
+                                                         operation))
               {
                 registered.interceptor_->send_request (&ri);
               }
@@ -59,6 +75,16 @@ namespace TAO
     // interceptors pushed on to the flow stack.
 
     bool const is_remote_request = invocation.is_remote_request();
+    const char *operation = invocation.operation_details ().opname ();
+
+    // Nothing to do if none of the interceptors on the flow stack is
+    // interested in this request.
+    if (!this->interceptor_list_.should_be_processed (
+          invocation.stack_size (), is_remote_request, operation))
+      {
+        invocation.stack_size () = 0;
+        return;
+      }
 
     // Notice that the interceptors are processed in the opposite order
     // they were pushed onto the stack since this is an "ending"
@@ -80,7 +106,8 @@ namespace TAO
           this->interceptor_list_.registered_interceptor (
             invocation.stack_size ());
 
-        if (registered.details_.should_be_processed (is_remote_request))
+        if (registered.details_.should_be_processed (is_remote_request,
+                                                     operation))
           {
             registered.interceptor_->receive_reply (&ri);
           }
@@ -99,6 +126,16 @@ namespace TAO
     // interceptors pushed on to the flow stack.
 
     bool const is_remote_request = invocation.is_remote_request();
+    const char *operation = invocation.operation_details ().opname ();
+
+    // Nothing to do if none of the interceptors on the flow stack is
+    // interested in this request.
+    if (!this->interceptor_list_.should_be_processed (
+          invocation.stack_size (), is_remote_request, operation))
+      {
+        invocation.stack_size () = 0;
+        return;
+      }
 
     // Notice that the interceptors are processed in the opposite order
     // they were pushed onto the stack since this is an "ending"
@@ -121,7 +158,8 @@ namespace TAO
               this->interceptor_list_.registered_interceptor (
                 invocation.stack_size ());
 
-            if (registered.details_.should_be_processed (is_remote_request))
+            if (registered.details_.should_be_processed (is_remote_request,
+                                                         operation))
               {
                 registered.interceptor_->receive_exception (&ri);
               }
@@ -167,6 +205,16 @@ namespace TAO
     // interceptors pushed on to the flow stack.
 
     bool const is_remote_request = invocation.is_remote_request();
+    const char *operation = invocation.operation_details ().opname ();
+
+    // Nothing to do if none of the interceptors on the flow stack is
+    // interested in this request.
+    if (!this->interceptor_list_.should_be_processed (
+          invocation.stack_size (), is_remote_request, operation))
+      {
+        invocation.stack_size () = 0;
+        return;
+      }
 
     // Notice that the interceptors are processed in the opposite order
     // they were pushed onto the stack since this is an "ending"
@@ -190,7 +238,8 @@ namespace TAO
             this->interceptor_list_.registered_interceptor (
               invocation.stack_size ());
 
-          if (registered.details_.should_be_processed (is_remote_request))
+          if (registered.details_.should_be_processed (is_remote_request,
+                                                       operation))
             {
               registered.interceptor_->receive_other (&ri);
             }
@@ -37,6 +37,25 @@ namespace TAO
     return this->interceptors_.size ();
   }
 
+  template <typename InterceptorType, typename DetailsType>
+  bool
+  Interceptor_List<InterceptorType,DetailsType>::should_be_processed (
+    size_t count,
+    bool is_remote_request,
+    const char *operation) const
+  {
+    for (size_t i = 0; i < count; ++i)
+      {
+        if (this->interceptors_[i].details_.should_be_processed (
+              is_remote_request, operation))
+          {
+            return true;
+          }
+      }
+
+    return false;
+  }
+
   template <typename InterceptorType, typename DetailsType>
   void
   Interceptor_List<InterceptorType,DetailsType>::add_interceptor (
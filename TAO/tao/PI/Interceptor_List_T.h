@@ -78,6 +78,14 @@ namespace TAO
 
     size_t size () const;
 
+    /// Return true if at least one of the first @a count registered
+    /// interceptors should be called for a request to @a operation.
+    /// Interception points use this to skip building the RequestInfo
+    /// when none of them is.
+    bool should_be_processed (size_t count,
+                              bool is_remote_request,
+                              const char *operation) const;
+
   private:
     typedef ACE_Array_Base<RegisteredInterceptor > RegisteredArray;
 
@@ -0,0 +1,52 @@
+#include "tao/PI/OperationFilterPolicy.h"
+
+#if TAO_HAS_INTERCEPTORS == 1
+
+#include "tao/PortableInterceptorC.h"
+#include "tao/SystemException.h"
+#include "ace/CORBA_macros.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+TAO_OperationFilterPolicy::TAO_OperationFilterPolicy (
+  const CORBA::StringSeq &operations)
+  : operations_ (operations)
+{
+}
+
+CORBA::Policy_ptr
+TAO_OperationFilterPolicy::copy ()
+{
+  TAO_OperationFilterPolicy *copy {};
+  ACE_NEW_THROW_EX (copy,
+                    TAO_OperationFilterPolicy (this->operations_),
+                    CORBA::NO_MEMORY ());
+
+  return copy;
+}
+
+void
+TAO_OperationFilterPolicy::destroy ()
+{
+}
+
+CORBA::StringSeq *
+TAO_OperationFilterPolicy::operations ()
+{
+  CORBA::StringSeq *operations {};
+  ACE_NEW_THROW_EX (operations,
+                    CORBA::StringSeq (this->operations_),
+                    CORBA::NO_MEMORY ());
+
+  return operations;
+}
+
+CORBA::PolicyType
+TAO_OperationFilterPolicy::policy_type ()
+{
+  return PortableInterceptor::OPERATION_FILTER_POLICY_TYPE;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* TAO_HAS_INTERCEPTORS == 1 */
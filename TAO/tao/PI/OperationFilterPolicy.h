@@ -0,0 +1,67 @@
+/* -*- C++ -*- */
+
+//=============================================================================
+/**
+ *  @file   OperationFilterPolicy.h
+ */
+//=============================================================================
+
+#ifndef TAO_OPERATION_FILTER_POLICY_H
+#define TAO_OPERATION_FILTER_POLICY_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/orbconf.h"
+
+#if TAO_HAS_INTERCEPTORS == 1
+
+#include "tao/PI/pi_export.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/LocalObject.h"
+#include "tao/PI/PI_includeC.h"
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+/**
+ * @class TAO_OperationFilterPolicy
+ *
+ * @brief Implementation class for Portable Interceptor
+ * OperationFilterPolicy.
+ *
+ * This policy is used to name the operations whose requests should
+ * cause a Portable Interceptor to be used.  Requests to any other
+ * operation skip the interceptor, and when no interceptor is left
+ * for a request the ORB does not even build its RequestInfo.
+ */
+class TAO_PI_Export TAO_OperationFilterPolicy
+  : public PortableInterceptor::OperationFilterPolicy,
+    public ::CORBA::LocalObject
+{
+public:
+  /// Constructor.
+  TAO_OperationFilterPolicy (const CORBA::StringSeq &operations);
+
+  virtual CORBA::StringSeq *operations ();
+
+  virtual CORBA::PolicyType policy_type ();
+
+  virtual CORBA::Policy_ptr copy ();
+
+  virtual void destroy ();
+
+private:
+  /// The attribute
+  CORBA::StringSeq operations_;
+};
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif  /* TAO_HAS_INTERCEPTORS == 1 */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_OPERATION_FILTER_POLICY_H */
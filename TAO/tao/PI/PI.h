@@ -53,6 +53,7 @@ TAO_END_VERSIONED_NAMESPACE_DECL
 #include "tao/PI/ClientRequestInterceptorC.h"
 #include "tao/PI/PICurrentC.h"
 #include "tao/PI/ProcessingModePolicyC.h"
+#include "tao/PI/OperationFilterPolicyC.h"
 #undef TAO_PI_SAFE_INCLUDE
 
 #endif  /* TAO_PI_H */
@@ -5,6 +5,7 @@
 
 #include "tao/PI/PI_PolicyFactory.h"
 #include "tao/PI/ProcessingModePolicyC.h"
+#include "tao/PI/OperationFilterPolicyC.h"
 #include "tao/ORB_Core.h"
 #include "tao/PI/ORBInitInfoC.h"
 #include "ace/CORBA_macros.h"
@@ -48,7 +49,8 @@ TAO_PI_ORBInitializer::register_policy_factories (
   // types since a single policy factory is used to create each of the
   // different types of PortableInterceptor policies.
   CORBA::PolicyType type[] = {
-    PortableInterceptor::PROCESSING_MODE_POLICY_TYPE
+    PortableInterceptor::PROCESSING_MODE_POLICY_TYPE,
+    PortableInterceptor::OPERATION_FILTER_POLICY_TYPE
   };
 
   const CORBA::PolicyType *end = type + sizeof (type) / sizeof (type[0]);
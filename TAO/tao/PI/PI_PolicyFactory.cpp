@@ -3,6 +3,8 @@
 #if TAO_HAS_INTERCEPTORS == 1
 
 #include "tao/PI/ProcessingModePolicy.h"
+#include "tao/PI/OperationFilterPolicy.h"
+#include "tao/AnyTypeCode/StringSeqA.h"
 #include "tao/ORB_Constants.h"
 #include "tao/SystemException.h"
 #include "ace/CORBA_macros.h"
@@ -32,6 +34,24 @@ TAO_PI_PolicyFactory::create_policy (
       return processing_mode_policy;
     }
 
+  if (type == PortableInterceptor::OPERATION_FILTER_POLICY_TYPE)
+    {
+      TAO_OperationFilterPolicy *operation_filter_policy = 0;
+      const CORBA::StringSeq *policy_value = 0;
+
+      if ((value >>= policy_value) == 0)
+        {
+          throw ::CORBA::PolicyError (CORBA::BAD_POLICY_VALUE);
+        }
+
+      ACE_NEW_THROW_EX (operation_filter_policy,
+                        TAO_OperationFilterPolicy (*policy_value),
+                        CORBA::NO_MEMORY (TAO::VMCID,
+                                          CORBA::COMPLETED_NO));
+
+      return operation_filter_policy;
+    }
+
   throw ::CORBA::PolicyError (CORBA::BAD_POLICY_TYPE);
 }
 
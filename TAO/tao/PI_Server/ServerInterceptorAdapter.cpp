@@ -50,7 +50,8 @@ TAO::ServerRequestInterceptor_Adapter_Impl::tao_ft_interception_point (
           ServerRequestInterceptor_List::RegisteredInterceptor& registered =
             this->interceptor_list_.registered_interceptor (i);
 
-          if (registered.details_.should_be_processed (is_remote_request))
+          if (registered.details_.should_be_processed (
+                is_remote_request, server_request.operation ()))
             {
               registered.interceptor_->
                 tao_ft_interception_point (&request_info, oc);
@@ -112,6 +113,17 @@ TAO::ServerRequestInterceptor_Adapter_Impl::receive_request_service_contexts (
       throw ::CORBA::INTERNAL ();
     }
 
+  if (!this->interceptor_list_.should_be_processed (
+        server_request.interceptor_count (),
+        !server_request.collocated (),
+        server_request.operation ()))
+    {
+      // The RSC still has to be copied to the TSC for the upcall.
+      TAO::PICurrent_Guard const pi_guard (server_request,
+                                           false /* Copy RSC to TSC */);
+      return;
+    }
+
   try
     {
       // Copy the request scope current (RSC) to the thread scope
@@ -134,7 +146,8 @@ TAO::ServerRequestInterceptor_Adapter_Impl::receive_request_service_contexts (
           ServerRequestInterceptor_List::RegisteredInterceptor& registered =
             this->interceptor_list_.registered_interceptor (i);
 
-          if (registered.details_.should_be_processed (is_remote_request))
+          if (registered.details_.should_be_processed (
+                is_remote_request, server_request.operation ()))
             {
               registered.interceptor_->
                 receive_request_service_contexts (&request_info);
@@ -172,6 +185,22 @@ TAO::ServerRequestInterceptor_Adapter_Impl::receive_request_service_contexts (
   // This method implements one of the "starting" server side
   // interception point if extended interceptors are not in place.
 
+  size_t const count = this->interceptor_list_.size ();
+
+  // If none of the registered interceptors is interested in this
+  // request don't bother setting up the request info, just push them
+  // all on to the flow stack so that the intermediate and "ending"
+  // interception points stay balanced.
+  if (!this->interceptor_list_.should_be_processed (
+        count, !server_request.collocated (), server_request.operation ()))
+    {
+      // The RSC still has to be copied to the TSC for the upcall.
+      TAO::PICurrent_Guard const pi_guard (server_request,
+                                           false /* Copy RSC to TSC */);
+      server_request.interceptor_count () += count;
+      return;
+    }
+
   try
     {
       // Copy the request scope current (RSC) to the thread scope
@@ -195,7 +224,8 @@ TAO::ServerRequestInterceptor_Adapter_Impl::receive_request_service_contexts (
           ServerRequestInterceptor_List::RegisteredInterceptor& registered =
             this->interceptor_list_.registered_interceptor (i);
 
-          if (registered.details_.should_be_processed (is_remote_request))
+          if (registered.details_.should_be_processed (
+                is_remote_request, server_request.operation ()))
             {
               registered.interceptor_->
                 receive_request_service_contexts (&request_info);
@@ -248,6 +278,14 @@ TAO::ServerRequestInterceptor_Adapter_Impl::receive_request (
       throw ::CORBA::INTERNAL ();
     }
 
+  if (!this->interceptor_list_.should_be_processed (
+        server_request.interceptor_count (),
+        !server_request.collocated (),
+        server_request.operation ()))
+    {
+      return;
+    }
+
   TAO::ServerRequestInfo request_info (server_request,
                                        args,
                                        nargs,
@@ -264,7 +302,8 @@ TAO::ServerRequestInterceptor_Adapter_Impl::receive_request (
           ServerRequestInterceptor_List::RegisteredInterceptor& registered =
             this->interceptor_list_.registered_interceptor (i);
 
-          if (registered.details_.should_be_processed (is_remote_request))
+          if (registered.details_.should_be_processed (
+                is_remote_request, server_request.operation ()))
             {
               registered.interceptor_->receive_request (&request_info);
             }
@@ -303,6 +342,17 @@ TAO::ServerRequestInterceptor_Adapter_Impl::send_reply (
 
   bool const is_remote_request = !server_request.collocated ();
 
+  // Nothing to do if none of the interceptors on the flow stack is
+  // interested in this request.
+  if (!this->interceptor_list_.should_be_processed (
+        server_request.interceptor_count (),
+        is_remote_request,
+        server_request.operation ()))
+    {
+      server_request.interceptor_count () = 0;
+      return;
+    }
+
   // Notice that the interceptors are processed in the opposite order
   // they were pushed onto the stack since this is an "ending"
   // interception point.
@@ -328,7 +378,8 @@ TAO::ServerRequestInterceptor_Adapter_Impl::send_reply (
         this->interceptor_list_.registered_interceptor (
           server_request.interceptor_count ());
 
-      if (registered.details_.should_be_processed (is_remote_request))
+      if (registered.details_.should_be_processed (
+            is_remote_request, server_request.operation ()))
         {
           registered.interceptor_->send_reply (&request_info);
         }
@@ -352,6 +403,17 @@ TAO::ServerRequestInterceptor_Adapter_Impl::send_exception (
   // process the interceptors pushed on to the flow stack.
   bool const is_remote_request = !server_request.collocated ();
 
+  // Nothing to do if none of the interceptors on the flow stack is
+  // interested in this request.
+  if (!this->interceptor_list_.should_be_processed (
+        server_request.interceptor_count (),
+        is_remote_request,
+        server_request.operation ()))
+    {
+      server_request.interceptor_count () = 0;
+      return;
+    }
+
   // Notice that the interceptors are processed in the opposite order
   // they were pushed onto the stack since this is an "ending" server
   // side interception point.
@@ -379,7 +441,8 @@ TAO::ServerRequestInterceptor_Adapter_Impl::send_exception (
             this->interceptor_list_.registered_interceptor (
               server_request.interceptor_count ());
 
-          if (registered.details_.should_be_processed (is_remote_request))
+          if (registered.details_.should_be_processed (
+                is_remote_request, server_request.operation ()))
             {
               registered.interceptor_->send_exception (&request_info);
             }
@@ -443,6 +506,17 @@ TAO::ServerRequestInterceptor_Adapter_Impl::send_other (
   // process the interceptors pushed on to the flow stack.
   bool const is_remote_request = !server_request.collocated ();
 
+  // Nothing to do if none of the interceptors on the flow stack is
+  // interested in this request.
+  if (!this->interceptor_list_.should_be_processed (
+        server_request.interceptor_count (),
+        is_remote_request,
+        server_request.operation ()))
+    {
+      server_request.interceptor_count () = 0;
+      return;
+    }
+
   TAO::ServerRequestInfo request_info (server_request,
                                        args,
                                        nargs,
@@ -470,7 +544,8 @@ TAO::ServerRequestInterceptor_Adapter_Impl::send_other (
             this->interceptor_list_.registered_interceptor (
               server_request.interceptor_count ());
 
-          if (registered.details_.should_be_processed (is_remote_request))
+          if (registered.details_.should_be_processed (
+                is_remote_request, server_request.operation ()))
             {
               registered.interceptor_->send_other (&request_info);
             }
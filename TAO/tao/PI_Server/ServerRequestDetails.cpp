@@ -8,6 +8,7 @@
 #endif /* defined INLINE */
 
 #include "tao/SystemException.h"
+#include "ace/OS_NS_string.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -16,8 +17,10 @@ namespace TAO
   void
   ServerRequestDetails::apply_policies (const CORBA::PolicyList &policies)
   {
-    // Flag to check for duplicate ProcessingModePolicy objects in the list.
+    // Flags to check for duplicate ProcessingModePolicy and
+    // OperationFilterPolicy objects in the list.
     bool processing_mode_applied = false;
+    bool operation_filter_applied = false;
 
     CORBA::ULong const plen = policies.length ();
 
@@ -54,6 +57,23 @@ namespace TAO
             // Save the value of the ProcessingModePolicy in our data member.
             this->processing_mode_ = pm_policy->processing_mode ();
           }
+        else if (policy_type == PortableInterceptor::OPERATION_FILTER_POLICY_TYPE)
+          {
+            if (operation_filter_applied)
+              {
+                throw ::CORBA::INV_POLICY ();
+              }
+
+            operation_filter_applied = true;
+
+            PortableInterceptor::OperationFilterPolicy_var of_policy =
+              PortableInterceptor::OperationFilterPolicy::_narrow (policy.in ());
+
+            CORBA::StringSeq_var operations = of_policy->operations ();
+
+            this->operations_ = operations.in ();
+            this->filter_operations_ = true;
+          }
         else
           {
             // We don't support the current policy type.
@@ -61,6 +81,22 @@ namespace TAO
           }
       }
   }
+
+  bool
+  ServerRequestDetails::lists_operation (const char *operation) const
+  {
+    CORBA::ULong const len = this->operations_.length ();
+
+    for (CORBA::ULong i = 0; i < len; ++i)
+      {
+        if (ACE_OS::strcmp (this->operations_[i], operation) == 0)
+          {
+            return true;
+          }
+      }
+
+    return false;
+  }
 }
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -11,65 +11,6 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
-/*!
- * @brief Allocate and return a new empty message block of size \a span_size
- * mimicking parameters of \a mb.
- *
- * This function allocates a new aligned message block using the same
- * allocators and flags as found in \a mb.  The size of the new message
- * block is at least \a span_size; the size may be adjusted up in order
- * to accomodate alignment requirements and still fit \a span_size bytes
- * into the aligned buffer.
- *
- * @param mb message block whose parameters should be mimicked
- * @param span_size size of the new message block (will be adjusted for proper
- * alignment)
- * @return an aligned message block with rd_ptr sitting at correct
- * alignment spot, 0 on failure
- */
-static ACE_Message_Block*
-clone_mb_nocopy_size (ACE_Message_Block *mb, size_t span_size)
-{
-  // Calculate the required size of the cloned block with alignment
-  size_t const aligned_size = ACE_CDR::first_size (span_size + ACE_CDR::MAX_ALIGNMENT);
-
-  // Get the allocators
-  ACE_Allocator *data_allocator = nullptr;
-  ACE_Allocator *data_block_allocator = nullptr;
-  ACE_Allocator *message_block_allocator = nullptr;
-  mb->access_allocators (data_allocator,
-                         data_block_allocator,
-                         message_block_allocator);
-
-  // Create a new Message Block
-  ACE_Message_Block *nb = nullptr;
-  ACE_NEW_MALLOC_RETURN (nb,
-                         static_cast<ACE_Message_Block*> (
-                                         message_block_allocator->malloc (
-                                           sizeof (ACE_Message_Block))),
-                         ACE_Message_Block(aligned_size,
-                                           mb->msg_type(),
-                                           mb->cont(),
-                                           nullptr, //we want the data block created
-                                           data_allocator,
-                                           mb->locking_strategy(),
-                                           mb->msg_priority(),
-                                           mb->msg_execution_time (),
-                                           mb->msg_deadline_time (),
-                                           data_block_allocator,
-                                           message_block_allocator),
-                         nullptr);
-
-  ACE_CDR::mb_align (nb);
-
-  // Copy the flags over, but be SURE to clear the DONT_DELETE flag, since
-  // we just dynamically allocated the two things.
-  nb->set_flags (mb->flags());
-  nb->clr_flags (ACE_Message_Block::DONT_DELETE);
-
-  return nb;
-}
-
 /*static*/
 TAO_Queued_Data *
 TAO_Queued_Data::make_queued_data (ACE_Allocator *message_buffer_alloc,
@@ -205,36 +146,122 @@ TAO_Queued_Data::consolidate ()
   // Is this a chain of fragments?
   if (this->state_.more_fragments () && this->msg_block_->cont () != nullptr)
     {
-      // Create a message block big enough to hold the entire chain
-      ACE_Message_Block *dest = clone_mb_nocopy_size (
-                                      this->msg_block_,
-                                      this->msg_block_->total_length ());
-
-      if (nullptr == dest)
+      // Create a message block big enough to hold the entire chain.  It
+      // is taken from the heap like the blocks of the chain.  A memory
+      // pool used as the input CDR allocator cannot reuse the space of
+      // a message this large once it has handed out part of it again,
+      // and would keep growing.
+      size_t const span = this->msg_block_->total_length ()
+                          + ACE_CDR::MAX_ALIGNMENT;
+      ACE_Message_Block *dest = nullptr;
+      ACE_NEW_RETURN (dest,
+                      ACE_Message_Block (span,
+                                         this->msg_block_->msg_type (),
+                                         nullptr,
+                                         nullptr,
+                                         nullptr,
+                                         this->msg_block_->locking_strategy ()),
+                      -1);
+
+      if (dest->size () < span)
         {
           // out of memory
+          dest->release ();
           return -1;
         }
+
+      ACE_CDR::mb_align (dest);
+      dest->set_flags (this->msg_block_->flags ());
+      dest->clr_flags (ACE_Message_Block::DONT_DELETE);
+
       // Memory allocation succeeded, the new message block can hold the consolidated
       // message. The following code just copies all the data into this new message block.
       // No further memory allocation will take place.
 
-      // Reset the cont() parameter.  We have cloned the message
-      // block but not the chain as we will no longer have chain.
-      dest->cont (nullptr);
-
-      // Use ACE_CDR to consolidate the chain for us
-      ACE_CDR::consolidate (dest, this->msg_block_);
-
-      // free the original message block chain
-      this->msg_block_->release ();
+#if !defined (ACE_CDR_IGNORE_ALIGNMENT)
+      // Keep the alignment of the data, as ACE_CDR::consolidate () does.
+      ptrdiff_t offset =
+        ptrdiff_t (this->msg_block_->rd_ptr ()) % ACE_CDR::MAX_ALIGNMENT -
+        ptrdiff_t (dest->rd_ptr ()) % ACE_CDR::MAX_ALIGNMENT;
+      if (offset < 0)
+        offset += ACE_CDR::MAX_ALIGNMENT;
+      dest->rd_ptr (static_cast<size_t> (offset));
+      dest->wr_ptr (dest->rd_ptr ());
+#endif /* ACE_CDR_IGNORE_ALIGNMENT */
+
+      // Release each block of the chain as soon as it is copied, so the
+      // message is not held twice while it is consolidated.
+      ACE_Message_Block *chain = this->msg_block_;
+      int result = 0;
+
+      while (chain != nullptr)
+        {
+          ACE_Message_Block *next = chain->cont ();
+          chain->cont (nullptr);
+          if (result == 0)
+            result = dest->copy (chain->rd_ptr (), chain->length ());
+          chain->release ();
+          chain = next;
+        }
 
       // Set the message block to the new consolidated message block
       this->msg_block_ = dest;
       this->state_.more_fragments (false);
+
+      if (result == -1)
+        {
+          return -1;
+        }
     }
 
   return 0;
 }
 
+int
+TAO_Queued_Data::append (const ACE_Message_Block &mb)
+{
+  size_t const length = mb.length ();
+
+  ACE_Message_Block *tail = this->msg_block_;
+  while (tail->cont () != nullptr)
+    {
+      tail = tail->cont ();
+    }
+
+  // The first block may still be shared with the buffer the message
+  // was read into, so the fragments always go to blocks of their own.
+  if (tail == this->msg_block_ || tail->space () < length)
+    {
+      // Each new block is as large as what has been received so far,
+      // up to TAO_FRAGMENT_BLOCK_MAX, which keeps the chain short.  The
+      // space left unused at the end of the last block is never
+      // touched.  The blocks are large enough for the heap to give
+      // them back as soon as consolidate () has copied them.
+      size_t span = this->msg_block_->total_length ();
+      if (span > TAO_FRAGMENT_BLOCK_MAX)
+        span = TAO_FRAGMENT_BLOCK_MAX;
+      if (span < ACE_CDR::LINEAR_GROWTH_CHUNK)
+        span = ACE_CDR::LINEAR_GROWTH_CHUNK;
+      if (span < length)
+        span = length;
+
+      ACE_Message_Block *nb = nullptr;
+      ACE_NEW_RETURN (nb,
+                      ACE_Message_Block (span),
+                      -1);
+
+      if (nb->size () < span)
+        {
+          // out of memory
+          nb->release ();
+          return -1;
+        }
+
+      tail->cont (nb);
+      tail = nb;
+    }
+
+  return tail->copy (mb.rd_ptr (), length);
+}
+
 TAO_END_VERSIONED_NAMESPACE_DECL
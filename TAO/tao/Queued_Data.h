@@ -71,6 +71,15 @@ public:
   /// @return -1 if consolidation failed, eg out or memory, otherwise 0
   int consolidate ();
 
+  /// Append the data of @a mb, the body of the next fragment of this
+  /// message, to the chain of message blocks.  Each new block is as
+  /// large as the message received so far, up to
+  /// TAO_FRAGMENT_BLOCK_MAX.  Call consolidate () once the last
+  /// fragment has been appended, it copies the chain into one block of
+  /// the final size.
+  /// @return -1 if out of memory, otherwise 0
+  int append (const ACE_Message_Block &mb);
+
   /// Get missing data
   size_t missing_data () const;
 
@@ -86,6 +95,9 @@ public:
   /// Get more fragments
   CORBA::Boolean more_fragments () const;
 
+  /// Set more fragments
+  void more_fragments (CORBA::Boolean fragment);
+
   /// Get message type
   GIOP::MsgType msg_type () const;
 
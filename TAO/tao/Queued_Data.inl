@@ -81,6 +81,12 @@ TAO_Queued_Data::more_fragments () const
   return this->state_.more_fragments ();
 }
 
+ACE_INLINE void
+TAO_Queued_Data::more_fragments (CORBA::Boolean fragment)
+{
+  this->state_.more_fragments (fragment);
+}
+
 ACE_INLINE GIOP::MsgType
 TAO_Queued_Data::msg_type () const
 {
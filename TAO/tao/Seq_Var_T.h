@@ -21,6 +21,8 @@
 
 #include "tao/Basic_Types.h"
 
+#include <utility>
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 /**
@@ -37,6 +39,7 @@ public:
   TAO_Seq_Var_Base_T ();
   TAO_Seq_Var_Base_T (T *);
   TAO_Seq_Var_Base_T (const TAO_Seq_Var_Base_T<T> &);
+  TAO_Seq_Var_Base_T (TAO_Seq_Var_Base_T<T> &&) noexcept;
 
   ~TAO_Seq_Var_Base_T ();
 
@@ -81,12 +84,14 @@ public:
   TAO_FixedSeq_Var_T ();
   TAO_FixedSeq_Var_T (T *);
   TAO_FixedSeq_Var_T (const TAO_FixedSeq_Var_T<T> &);
+  TAO_FixedSeq_Var_T (TAO_FixedSeq_Var_T<T> &&) noexcept;
 
   // Fixed-size base types only.
   TAO_FixedSeq_Var_T (const T &);
 
   TAO_FixedSeq_Var_T & operator= (T *);
   TAO_FixedSeq_Var_T & operator= (const TAO_FixedSeq_Var_T<T> &);
+  TAO_FixedSeq_Var_T & operator= (TAO_FixedSeq_Var_T<T> &&) noexcept;
 
   T_elem operator[] (CORBA::ULong index);
   T_const_elem operator[] (CORBA::ULong index) const;
@@ -111,9 +116,11 @@ public:
   TAO_VarSeq_Var_T ();
   TAO_VarSeq_Var_T (T *);
   TAO_VarSeq_Var_T (const TAO_VarSeq_Var_T<T> &);
+  TAO_VarSeq_Var_T (TAO_VarSeq_Var_T<T> &&) noexcept;
 
   TAO_VarSeq_Var_T & operator= (T *);
   TAO_VarSeq_Var_T & operator= (const TAO_VarSeq_Var_T<T> &);
+  TAO_VarSeq_Var_T & operator= (TAO_VarSeq_Var_T<T> &&) noexcept;
 
   T_elem operator[] (CORBA::ULong index);
   T_const_elem operator[] (CORBA::ULong index) const;
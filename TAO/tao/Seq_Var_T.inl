@@ -15,6 +15,14 @@ TAO_Seq_Var_Base_T<T>::TAO_Seq_Var_Base_T (T * p)
   : ptr_ (p)
 {}
 
+template<typename T>
+ACE_INLINE
+TAO_Seq_Var_Base_T<T>::TAO_Seq_Var_Base_T (TAO_Seq_Var_Base_T<T> && p) noexcept
+  : ptr_ (p.ptr_)
+{
+  p.ptr_ = nullptr;
+}
+
 template<typename T>
 ACE_INLINE
 TAO_Seq_Var_Base_T<T>::~TAO_Seq_Var_Base_T ()
@@ -122,6 +130,13 @@ TAO_FixedSeq_Var_T<T>::TAO_FixedSeq_Var_T (const TAO_FixedSeq_Var_T<T> & p)
 {
 }
 
+template<typename T>
+ACE_INLINE
+TAO_FixedSeq_Var_T<T>::TAO_FixedSeq_Var_T (TAO_FixedSeq_Var_T<T> && p) noexcept
+  : TAO_Seq_Var_Base_T<T> (std::move (p))
+{
+}
+
 // Fixed-size base types only.
 template<typename T>
 ACE_INLINE
@@ -141,6 +156,20 @@ TAO_FixedSeq_Var_T<T>::operator= (T * p)
   return *this;
 }
 
+template<typename T>
+ACE_INLINE
+TAO_FixedSeq_Var_T<T> &
+TAO_FixedSeq_Var_T<T>::operator= (TAO_FixedSeq_Var_T<T> && p) noexcept
+{
+  if (this != &p)
+    {
+      delete this->ptr_;
+      this->ptr_ = p.ptr_;
+      p.ptr_ = nullptr;
+    }
+  return *this;
+}
+
 template<typename T>
 ACE_INLINE
 typename TAO_FixedSeq_Var_T<T>::T_elem
@@ -178,6 +207,13 @@ TAO_VarSeq_Var_T<T>::TAO_VarSeq_Var_T (const TAO_VarSeq_Var_T<T> & p)
 {
 }
 
+template<typename T>
+ACE_INLINE
+TAO_VarSeq_Var_T<T>::TAO_VarSeq_Var_T (TAO_VarSeq_Var_T<T> && p) noexcept
+  : TAO_Seq_Var_Base_T<T> (std::move (p))
+{
+}
+
 template<typename T>
 ACE_INLINE
 TAO_VarSeq_Var_T<T> &
@@ -188,6 +224,20 @@ TAO_VarSeq_Var_T<T>::operator= (T * p)
   return *this;
 }
 
+template<typename T>
+ACE_INLINE
+TAO_VarSeq_Var_T<T> &
+TAO_VarSeq_Var_T<T>::operator= (TAO_VarSeq_Var_T<T> && p) noexcept
+{
+  if (this != &p)
+    {
+      delete this->ptr_;
+      this->ptr_ = p.ptr_;
+      p.ptr_ = nullptr;
+    }
+  return *this;
+}
+
 // Variable-size types only
 template<typename T>
 ACE_INLINE
@@ -0,0 +1,1406 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ * @file  Storable_JournalStream.cpp
+ *
+ * The journal file starts with a header, the magic string followed by
+ * the generation of the file, and holds a sequence of records:
+ *
+ *   u8 type, 3 pad bytes, u32 crc32 of the payload, u64 payload size
+ *
+ * A checkpoint ('C') record holds the whole contents.  A delta ('D')
+ * record holds the new size of the contents followed by operations
+ * building the new contents, either a copy of a range of the previous
+ * contents ('c', offset, size) or literal bytes ('l', size, bytes).
+ * All the integers are little endian.
+ *
+ * The ranges are found by cutting the contents into chunks at content
+ * defined boundaries, using a gear rolling hash, so an insertion only
+ * changes the chunks around it.  Most changes are found without them,
+ * by comparing the contents sequentially and resynchronizing after
+ * small insertions, deletions and replacements, so the chunks are only
+ * cut when that fails.
+ *
+ * A new checkpoint is first written to a separate file and synced, the
+ * journal is then rewritten in place with a new generation.  A valid
+ * checkpoint file found when loading means the rewrite was interrupted
+ * and is completed.
+ */
+//=============================================================================
+
+#include "tao/Storable_JournalStream.h"
+
+#include "ace/ACE.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_unistd.h"
+#include "ace/OS_NS_fcntl.h"
+#include "ace/OS_NS_sys_stat.h"
+#include "ace/OS_NS_string.h"
+#include "ace/Truncate.h"
+#include "tao/debug.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  const char journal_magic[] = "TAOJRNL1";
+  const size_t header_size = 16;
+  const size_t record_header_size = 16;
+
+  const char checkpoint_record = 'C';
+  const char delta_record = 'D';
+  const char copy_op = 'c';
+  const char literal_op = 'l';
+
+  /// Chunks are between min_chunk and max_chunk bytes, about
+  /// min_chunk + chunk_mask + 1 on average.
+  const size_t min_chunk = 64;
+  const size_t max_chunk = 4096;
+  const ACE_UINT64 chunk_mask = 0xff;
+
+  /// A checkpoint is not worth it below that many appended bytes.
+  const size_t min_checkpoint_size = 4096;
+
+  void put_le (std::string & out, ACE_UINT64 value, size_t size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      {
+        out += static_cast<char> (value & 0xff);
+        value >>= 8;
+      }
+  }
+
+  ACE_UINT64 get_le (const char * in, size_t size)
+  {
+    ACE_UINT64 value = 0;
+    for (size_t i = size; i > 0; --i)
+      value = (value << 8) | static_cast<unsigned char> (in[i - 1]);
+    return value;
+  }
+
+  /// Random values for the gear hash, from a fixed seed so all the
+  /// processes cut the same chunks.
+  struct Gear_Table
+  {
+    Gear_Table ()
+    {
+      ACE_UINT64 seed = ACE_UINT64_LITERAL (0x9e3779b97f4a7c15);
+      for (size_t i = 0; i < 256; ++i)
+        {
+          // splitmix64
+          ACE_UINT64 z = (seed += ACE_UINT64_LITERAL (0x9e3779b97f4a7c15));
+          z = (z ^ (z >> 30)) * ACE_UINT64_LITERAL (0xbf58476d1ce4e5b9);
+          z = (z ^ (z >> 27)) * ACE_UINT64_LITERAL (0x94d049bb133111eb);
+          this->values_[i] = z ^ (z >> 31);
+        }
+    }
+
+    ACE_UINT64 values_[256];
+  };
+
+  const Gear_Table & gear_table ()
+  {
+    static const Gear_Table table;
+    return table;
+  }
+
+  /// Size of the chunk starting at @a data, and a key for it in
+  /// @a key.  The key mixes the rolling hash at the end of the chunk,
+  /// which covers its last 64 bytes, with its size and first bytes, the
+  /// chunks with the same key are told apart by comparing them.
+  size_t next_chunk (const char * data, size_t size, ACE_UINT64 & key)
+  {
+    const ACE_UINT64 * const gear = gear_table ().values_;
+    size_t const limit = size < max_chunk ? size : max_chunk;
+    size_t const start = limit <= min_chunk ? 0 : min_chunk;
+    size_t end = limit;
+    ACE_UINT64 hash = 0;
+    for (size_t i = start; i < limit; ++i)
+      {
+        hash = (hash << 1) + gear[static_cast<unsigned char> (data[i])];
+        if ((hash & chunk_mask) == 0)
+          {
+            end = i + 1;
+            break;
+          }
+      }
+
+    ACE_UINT64 head = 0;
+    ACE_OS::memcpy (&head, data, end < sizeof head ? end : sizeof head);
+    key = (hash ^ (head * ACE_UINT64_LITERAL (0x9e3779b97f4a7c15)))
+      + end;
+    return end;
+  }
+
+  struct Chunk
+  {
+    size_t offset_;
+    size_t size_;
+  };
+
+  /// The chunks of the contents, by key.
+  typedef std::unordered_map<ACE_UINT64, Chunk> Chunk_Index;
+
+  void index_chunks (const std::string & contents, Chunk_Index & index)
+  {
+    index.clear ();
+    const char * const data = contents.data ();
+    for (size_t offset = 0; offset < contents.size (); )
+      {
+        ACE_UINT64 key = 0;
+        size_t const size =
+          next_chunk (data + offset, contents.size () - offset, key);
+        index.emplace (key, Chunk {offset, size});
+        offset += size;
+      }
+  }
+
+  /// Length of the common prefix of @a a and @a b, at most @a size.
+  size_t common_length (const char * a, const char * b, size_t size)
+  {
+    size_t n = 0;
+    while (size - n >= 64 && ACE_OS::memcmp (a + n, b + n, 64) == 0)
+      n += 64;
+    while (n < size && a[n] == b[n])
+      ++n;
+    return n;
+  }
+
+  /// Builds the operations of a delta record, merging the contiguous
+  /// ones.
+  class Delta_Encoder
+  {
+  public:
+    Delta_Encoder (const char * data, size_t size, std::string & payload)
+      : data_ (data)
+      , payload_ (payload)
+      , op_ (0)
+      , op_offset_ (0)
+      , op_size_ (0)
+    {
+      payload_.clear ();
+      put_le (payload_, size, 8);
+    }
+
+    /// Copy @a size bytes of the previous contents at @a offset.
+    void copy (size_t offset, size_t size)
+    {
+      this->add (copy_op, offset, size);
+    }
+
+    /// Copy @a size bytes of the new contents at @a offset.
+    void literal (size_t offset, size_t size)
+    {
+      this->add (literal_op, offset, size);
+    }
+
+    void flush ()
+    {
+      if (this->op_ == copy_op)
+        {
+          this->payload_ += copy_op;
+          put_le (this->payload_, this->op_offset_, 8);
+          put_le (this->payload_, this->op_size_, 8);
+        }
+      else if (this->op_ == literal_op)
+        {
+          this->payload_ += literal_op;
+          put_le (this->payload_, this->op_size_, 8);
+          this->payload_.append (this->data_ + this->op_offset_, this->op_size_);
+        }
+      this->op_ = 0;
+    }
+
+  private:
+    void add (char op, size_t offset, size_t size)
+    {
+      if (size == 0)
+        return;
+      if (op != this->op_ || offset != this->op_offset_ + this->op_size_)
+        {
+          this->flush ();
+          this->op_ = op;
+          this->op_offset_ = offset;
+          this->op_size_ = 0;
+        }
+      this->op_size_ += size;
+    }
+
+    const char * data_;
+    std::string & payload_;
+    char op_;
+    size_t op_offset_;
+    size_t op_size_;
+  };
+
+  /// Copies shorter than that are not worth an operation.
+  const size_t min_match = 32;
+
+  /// How far a small edit is looked for before falling back to the
+  /// chunks.
+  const size_t resync_window = 4096;
+
+  /**
+   * Encode @a contents as operations on @a previous.  The previous
+   * contents are followed sequentially, a mismatch is first taken as
+   * a small replacement, insertion or deletion, then looked up in the
+   * chunks of @a previous, which are cut into @a index on first use.
+   */
+  void encode_delta (const std::string & previous,
+                     Chunk_Index & index,
+                     bool & indexed,
+                     const std::string & contents,
+                     std::string & payload)
+  {
+    const char * const old_data = previous.data ();
+    size_t const old_size = previous.size ();
+    const char * const data = contents.data ();
+    size_t const size = contents.size ();
+
+    Delta_Encoder encoder (data, size, payload);
+
+    // True if the new contents at i line up with the old ones at j.
+    auto matches = [&] (size_t i, size_t j) -> bool
+      {
+        return i + min_match <= size
+          && j + min_match <= old_size
+          && ACE_OS::memcmp (data + i, old_data + j, min_match) == 0;
+      };
+
+    size_t pos = 0;
+    size_t old_pos = 0;
+    while (pos < size)
+      {
+        size_t const length =
+          old_pos < old_size
+            ? common_length (data + pos,
+                             old_data + old_pos,
+                             std::min (size - pos, old_size - old_pos))
+            : 0;
+        if (length >= min_match || (length > 0 && pos + length == size))
+          {
+            encoder.copy (old_pos, length);
+            pos += length;
+            old_pos += length;
+            continue;
+          }
+
+        bool found = false;
+        for (size_t d = 1; d <= resync_window && !found; ++d)
+          {
+            if (matches (pos + d, old_pos + d))        // replaced
+              {
+                encoder.literal (pos, d);
+                pos += d;
+                old_pos += d;
+                found = true;
+              }
+            else if (matches (pos + d, old_pos))       // inserted
+              {
+                encoder.literal (pos, d);
+                pos += d;
+                found = true;
+              }
+            else if (matches (pos, old_pos + d))       // deleted
+              {
+                old_pos += d;
+                found = true;
+              }
+          }
+        if (found)
+          continue;
+
+        if (!indexed)
+          {
+            index_chunks (previous, index);
+            indexed = true;
+          }
+
+        ACE_UINT64 key = 0;
+        size_t const chunk = next_chunk (data + pos, size - pos, key);
+        Chunk_Index::const_iterator const chunk_found = index.find (key);
+        if (chunk_found != index.end ()
+            && chunk_found->second.size_ == chunk
+            && ACE_OS::memcmp (old_data + chunk_found->second.offset_,
+                               data + pos,
+                               chunk) == 0)
+          {
+            encoder.copy (chunk_found->second.offset_, chunk);
+            old_pos = chunk_found->second.offset_ + chunk;
+          }
+        else
+          {
+            encoder.literal (pos, chunk);
+            old_pos += chunk;
+          }
+        pos += chunk;
+      }
+
+    encoder.flush ();
+  }
+
+  void encode_record (char type, const std::string & payload, std::string & record)
+  {
+    record.clear ();
+    record.reserve (record_header_size + payload.size ());
+    record += type;
+    record.append (3, '\0');
+    put_le (record, ACE::crc32 (payload.data (), payload.size ()), 4);
+    put_le (record, payload.size (), 8);
+    record += payload;
+  }
+
+  void encode_header (ACE_UINT64 generation, std::string & header)
+  {
+    header.assign (journal_magic, 8);
+    put_le (header, generation, 8);
+  }
+
+  /// A range of bytes of the contents being rebuilt.
+  struct Piece
+  {
+    const char * data_;
+    size_t size_;
+  };
+
+  typedef std::vector<Piece> Pieces;
+
+  void append_piece (Pieces & pieces, const char * data, size_t size)
+  {
+    if (size == 0)
+      return;
+    if (!pieces.empty ()
+        && pieces.back ().data_ + pieces.back ().size_ == data)
+      pieces.back ().size_ += size;
+    else
+      pieces.push_back (Piece {data, size});
+  }
+
+  /// Past that many pieces, replaying a delta costs more than copying
+  /// the contents once.
+  const size_t max_pieces = 64;
+
+  /// Copy the contents described by @a pieces into @a buffer, and
+  /// make it the only piece.
+  void flatten (Pieces & pieces, std::string & buffer)
+  {
+    size_t total = 0;
+    for (Pieces::const_iterator i = pieces.begin (); i != pieces.end (); ++i)
+      total += i->size_;
+
+    std::string result;
+    result.reserve (total);
+    for (Pieces::const_iterator i = pieces.begin (); i != pieces.end (); ++i)
+      result.append (i->data_, i->size_);
+
+    buffer.swap (result);
+    pieces.clear ();
+    append_piece (pieces, buffer.data (), buffer.size ());
+  }
+
+  /// Apply the delta @a payload to @a pieces, without copying any
+  /// data.  Returns false if the delta does not fit the contents.
+  bool apply_delta (Pieces & pieces, const char * payload, size_t size)
+  {
+    if (size < 8)
+      return false;
+    ACE_UINT64 const new_size = get_le (payload, 8);
+
+    // Where each piece starts in the contents.
+    std::vector<ACE_UINT64> starts;
+    starts.reserve (pieces.size ());
+    ACE_UINT64 old_size = 0;
+    for (Pieces::const_iterator i = pieces.begin (); i != pieces.end (); ++i)
+      {
+        starts.push_back (old_size);
+        old_size += i->size_;
+      }
+
+    Pieces result;
+    ACE_UINT64 result_size = 0;
+    for (size_t pos = 8; pos < size; )
+      {
+        char const op = payload[pos++];
+        if (op == copy_op && size - pos >= 16)
+          {
+            ACE_UINT64 offset = get_le (payload + pos, 8);
+            ACE_UINT64 length = get_le (payload + pos + 8, 8);
+            pos += 16;
+            if (offset > old_size || length > old_size - offset)
+              return false;
+            result_size += length;
+
+            size_t p = std::upper_bound (starts.begin (), starts.end (), offset)
+                       - starts.begin () - 1;
+            while (length > 0)
+              {
+                size_t const skip = static_cast<size_t> (offset - starts[p]);
+                size_t const take =
+                  static_cast<size_t> (
+                    std::min<ACE_UINT64> (pieces[p].size_ - skip, length));
+                append_piece (result, pieces[p].data_ + skip, take);
+                offset += take;
+                length -= take;
+                ++p;
+              }
+          }
+        else if (op == literal_op && size - pos >= 8)
+          {
+            ACE_UINT64 const length = get_le (payload + pos, 8);
+            pos += 8;
+            if (length > size - pos)
+              return false;
+            append_piece (result, payload + pos, static_cast<size_t> (length));
+            result_size += length;
+            pos += static_cast<size_t> (length);
+          }
+        else
+          return false;
+      }
+
+    if (result_size != new_size)
+      return false;
+
+    pieces.swap (result);
+    return true;
+  }
+
+  /// Read @a size bytes at @a offset of @a handle into @a data.
+  bool read_at (ACE_HANDLE handle, ACE_OFF_T offset, size_t size, std::string & data)
+  {
+    data.resize (size);
+    size_t done = 0;
+    while (done < size)
+      {
+        ssize_t const n = ACE_OS::pread (handle,
+                                         &data[done],
+                                         size - done,
+                                         offset + static_cast<ACE_OFF_T> (done));
+        if (n <= 0)
+          return false;
+        done += static_cast<size_t> (n);
+      }
+    return true;
+  }
+
+  bool write_at (ACE_HANDLE handle, ACE_OFF_T offset, const std::string & data)
+  {
+    size_t done = 0;
+    while (done < data.size ())
+      {
+        ssize_t const n = ACE_OS::pwrite (handle,
+                                          data.data () + done,
+                                          data.size () - done,
+                                          offset + static_cast<ACE_OFF_T> (done));
+        if (n <= 0)
+          return false;
+        done += static_cast<size_t> (n);
+      }
+    return true;
+  }
+
+  bool file_size (ACE_HANDLE handle, ACE_OFF_T & size)
+  {
+    ACE_stat st;
+    if (ACE_OS::fstat (handle, &st) != 0)
+      return false;
+    size = st.st_size;
+    return true;
+  }
+}
+
+namespace TAO
+{
+  /**
+   * @brief The contents of a journal file, shared by all the streams
+   * on the file.
+   *
+   * The streams must hold the file lock, or be the only users of the
+   * file, when they refresh or commit.
+   */
+  class Storable_Journal
+  {
+  public:
+    Storable_Journal (const ACE_CString & path, unsigned int checkpoint_ratio);
+
+    const ACE_CString & path () const;
+
+    /// Catch up with the file open as @a handle, and return its
+    /// contents in @a contents.  @a writer is set if the caller holds
+    /// the write lock.
+    int refresh (ACE_HANDLE handle,
+                 bool writer,
+                 std::shared_ptr<const std::string> & contents);
+
+    /// Append the changes from the current contents to @a contents.
+    /// The caller holds the write lock.
+    int commit (ACE_HANDLE handle,
+                const std::string & contents,
+                bool sync,
+                std::shared_ptr<const std::string> & committed);
+
+    /// The file was removed.
+    void forget ();
+
+  private:
+    int refresh_i (ACE_HANDLE handle, bool writer);
+
+    /// Replay the records in @a data, read at @a offset of the file,
+    /// on top of the current contents, or from scratch if @a reload is
+    /// set.
+    void replay (const std::string & data, ACE_OFF_T offset, bool reload);
+
+    /// Check for an interrupted checkpoint.  Returns 1 if the
+    /// contents were taken from the checkpoint file.
+    int recover_checkpoint (ACE_HANDLE handle, bool writer);
+
+    /// Rewrite the file as a single checkpoint.
+    int checkpoint (ACE_HANDLE handle);
+
+    ACE_CString path_;
+    ACE_CString checkpoint_path_;
+    unsigned int checkpoint_ratio_;
+
+    TAO_SYNCH_MUTEX lock_;
+
+    std::shared_ptr<const std::string> contents_;
+
+    /// Chunks of <contents_>, cut on demand, valid if <indexed_> is
+    /// set.
+    Chunk_Index index_;
+    bool indexed_;
+
+    /// The generation and end of the last valid record of the file
+    /// <contents_> were read from, <loaded_> is cleared if they do
+    /// not match the file.
+    ACE_UINT64 generation_;
+    ACE_OFF_T end_;
+    bool loaded_;
+
+    /// Bytes of records appended since the last checkpoint.
+    ACE_UINT64 appended_;
+
+    /// The file is not a journal.
+    bool foreign_;
+  };
+}
+
+TAO::Storable_Journal::Storable_Journal (const ACE_CString & path,
+                                         unsigned int checkpoint_ratio)
+  : path_ (path)
+  , checkpoint_path_ (path + ".ckpt")
+  , checkpoint_ratio_ (checkpoint_ratio == 0 ? 1 : checkpoint_ratio)
+  , contents_ (std::make_shared<const std::string> ())
+  , indexed_ (false)
+  , generation_ (0)
+  , end_ (0)
+  , loaded_ (false)
+  , appended_ (0)
+  , foreign_ (false)
+{
+}
+
+const ACE_CString &
+TAO::Storable_Journal::path () const
+{
+  return this->path_;
+}
+
+void
+TAO::Storable_Journal::forget ()
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->contents_ = std::make_shared<const std::string> ();
+  this->indexed_ = false;
+  this->generation_ = 0;
+  this->end_ = 0;
+  this->loaded_ = false;
+  this->appended_ = 0;
+  this->foreign_ = false;
+}
+
+int
+TAO::Storable_Journal::refresh (ACE_HANDLE handle,
+                                bool writer,
+                                std::shared_ptr<const std::string> & contents)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, -1);
+  int const result = this->refresh_i (handle, writer);
+  contents = this->contents_;
+  return result;
+}
+
+int
+TAO::Storable_Journal::refresh_i (ACE_HANDLE handle, bool writer)
+{
+  if (ACE_OS::access (this->checkpoint_path_.c_str (), F_OK) == 0
+      && this->recover_checkpoint (handle, writer) == 1)
+    return 0;
+
+  ACE_OFF_T size = 0;
+  if (!file_size (handle, size))
+    return -1;
+
+  if (size == 0)
+    {
+      if (this->end_ != 0 || !this->contents_->empty ())
+        {
+          this->contents_ = std::make_shared<const std::string> ();
+          this->indexed_ = false;
+        }
+      this->generation_ = 0;
+      this->end_ = 0;
+      this->appended_ = 0;
+      this->loaded_ = true;
+      this->foreign_ = false;
+      return 0;
+    }
+
+  std::string header;
+  if (size < static_cast<ACE_OFF_T> (header_size)
+      || !read_at (handle, 0, header_size, header)
+      || ACE_OS::memcmp (header.data (), journal_magic, 8) != 0)
+    {
+      if (!this->foreign_)
+        TAOLIB_ERROR ((LM_ERROR,
+                       ACE_TEXT ("TAO (%P|%t) - Storable_Journal::refresh, ")
+                       ACE_TEXT ("%C is not a journal file\n"),
+                       this->path_.c_str ()));
+      this->foreign_ = true;
+      return -1;
+    }
+  this->foreign_ = false;
+
+  ACE_UINT64 const generation = get_le (header.data () + 8, 8);
+  bool const reload = !this->loaded_
+    || generation != this->generation_
+    || size < this->end_;
+  ACE_OFF_T const offset =
+    reload ? static_cast<ACE_OFF_T> (header_size) : this->end_;
+
+  if (size == offset)
+    return 0;
+
+  std::string data;
+  if (!read_at (handle, offset, static_cast<size_t> (size - offset), data))
+    return -1;
+
+  this->generation_ = generation;
+  this->replay (data, offset, reload);
+  return 0;
+}
+
+void
+TAO::Storable_Journal::replay (const std::string & data,
+                               ACE_OFF_T offset,
+                               bool reload)
+{
+  Pieces pieces;
+  std::string buffer;
+  if (!reload)
+    append_piece (pieces, this->contents_->data (), this->contents_->size ());
+  else
+    this->appended_ = 0;
+
+  size_t pos = 0;
+  bool changed = false;
+  while (data.size () - pos >= record_header_size)
+    {
+      const char * const record = data.data () + pos;
+      ACE_UINT64 const size = get_le (record + 8, 8);
+      if (size > data.size () - pos - record_header_size)
+        break;
+
+      const char * const payload = record + record_header_size;
+      size_t const payload_size = static_cast<size_t> (size);
+      if (get_le (record + 4, 4) != ACE::crc32 (payload, payload_size))
+        break;
+
+      if (record[0] == checkpoint_record)
+        {
+          pieces.clear ();
+          append_piece (pieces, payload, payload_size);
+        }
+      else if (record[0] != delta_record
+               || !apply_delta (pieces, payload, payload_size))
+        break;
+
+      if (pieces.size () > max_pieces)
+        flatten (pieces, buffer);
+
+      // The first checkpoint of the file does not count.
+      if (pos != 0 || offset != static_cast<ACE_OFF_T> (header_size))
+        this->appended_ += record_header_size + payload_size;
+
+      pos += record_header_size + payload_size;
+      changed = true;
+    }
+
+  // A torn or corrupted record is the end of the journal, the next
+  // commit overwrites it.
+  if (pos != data.size () && TAO_debug_level > 0)
+    TAOLIB_DEBUG ((LM_DEBUG,
+                   ACE_TEXT ("TAO (%P|%t) - Storable_Journal::replay, ")
+                   ACE_TEXT ("ignoring %B bytes at the end of %C\n"),
+                   data.size () - pos, this->path_.c_str ()));
+
+  this->end_ = offset + static_cast<ACE_OFF_T> (pos);
+  this->loaded_ = true;
+
+  if (changed || reload)
+    {
+      flatten (pieces, buffer);
+      this->contents_ = std::make_shared<const std::string> (std::move (buffer));
+      this->indexed_ = false;
+    }
+}
+
+int
+TAO::Storable_Journal::recover_checkpoint (ACE_HANDLE handle, bool writer)
+{
+  ACE_HANDLE const checkpoint =
+    ACE_OS::open (this->checkpoint_path_.c_str (), O_RDONLY);
+  if (checkpoint == ACE_INVALID_HANDLE)
+    return 0;
+
+  ACE_OFF_T size = 0;
+  std::string data;
+  bool valid = file_size (checkpoint, size)
+    && size >= static_cast<ACE_OFF_T> (header_size + record_header_size)
+    && read_at (checkpoint, 0, static_cast<size_t> (size), data)
+    && ACE_OS::memcmp (data.data (), journal_magic, 8) == 0
+    && data[header_size] == checkpoint_record
+    && get_le (data.data () + header_size + 8, 8)
+         == data.size () - header_size - record_header_size
+    && get_le (data.data () + header_size + 4, 4)
+         == ACE::crc32 (data.data () + header_size + record_header_size,
+                        data.size () - header_size - record_header_size);
+  ACE_OS::close (checkpoint);
+
+  if (!writer)
+    {
+      if (!valid)
+        return 0;
+
+      // Use the checkpoint until a writer completes it.
+      this->contents_ = std::make_shared<const std::string> (
+        data, header_size + record_header_size);
+      this->indexed_ = false;
+      this->loaded_ = false;
+      return 1;
+    }
+
+  if (valid)
+    {
+      if (TAO_debug_level > 0)
+        TAOLIB_DEBUG ((LM_DEBUG,
+                       ACE_TEXT ("TAO (%P|%t) - Storable_Journal::")
+                       ACE_TEXT ("recover_checkpoint, completing the ")
+                       ACE_TEXT ("checkpoint of %C\n"),
+                       this->path_.c_str ()));
+      if (!write_at (handle, 0, data)
+          || ACE_OS::ftruncate (handle, static_cast<ACE_OFF_T> (data.size ())) != 0
+          || ACE_OS::fsync (handle) != 0)
+        return -1;
+      this->loaded_ = false;
+    }
+
+  ACE_OS::unlink (this->checkpoint_path_.c_str ());
+  return 0;
+}
+
+int
+TAO::Storable_Journal::commit (ACE_HANDLE handle,
+                               const std::string & contents,
+                               bool sync,
+                               std::shared_ptr<const std::string> & committed)
+{
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, -1);
+
+  // Another process may have appended since the caller read the file.
+  if (this->refresh_i (handle, true) != 0)
+    return -1;
+
+  if (*this->contents_ == contents)
+    {
+      committed = this->contents_;
+      return sync && ACE_OS::fsync (handle) != 0 ? -1 : 0;
+    }
+
+  std::string data;
+  if (this->end_ == 0)
+    {
+      // A new file.
+      this->generation_ = 1;
+      encode_header (this->generation_, data);
+    }
+
+  std::string payload;
+  encode_delta (*this->contents_, this->index_, this->indexed_,
+                contents, payload);
+
+  std::string record;
+  if (payload.size () < contents.size ())
+    encode_record (delta_record, payload, record);
+  else
+    encode_record (checkpoint_record, contents, record);
+  data += record;
+
+  ACE_OFF_T const offset = this->end_ == 0 ? 0 : this->end_;
+  ACE_OFF_T size = 0;
+  if (!file_size (handle, size)
+      || (size > offset && ACE_OS::ftruncate (handle, offset) != 0)
+      || !write_at (handle, offset, data))
+    {
+      TAOLIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("TAO (%P|%t) - Storable_Journal::commit, ")
+                     ACE_TEXT ("cannot append to %C: %p\n"),
+                     this->path_.c_str (), ACE_TEXT ("pwrite")));
+      return -1;
+    }
+
+  if (this->end_ != 0)
+    this->appended_ += record.size ();
+  this->end_ = offset + static_cast<ACE_OFF_T> (data.size ());
+  this->loaded_ = true;
+  this->contents_ = std::make_shared<const std::string> (contents);
+  this->index_.clear ();
+  this->indexed_ = false;
+
+  size_t const threshold =
+    std::max (this->contents_->size (), min_checkpoint_size);
+  if (this->appended_ > static_cast<ACE_UINT64> (threshold) * this->checkpoint_ratio_)
+    this->checkpoint (handle);
+
+  committed = this->contents_;
+  return sync && ACE_OS::fsync (handle) != 0 ? -1 : 0;
+}
+
+int
+TAO::Storable_Journal::checkpoint (ACE_HANDLE handle)
+{
+  std::string data;
+  encode_header (this->generation_ + 1, data);
+  std::string record;
+  encode_record (checkpoint_record, *this->contents_, record);
+  data += record;
+
+  ACE_HANDLE const checkpoint =
+    ACE_OS::open (this->checkpoint_path_.c_str (),
+                  O_WRONLY | O_CREAT | O_TRUNC,
+                  0666);
+  if (checkpoint == ACE_INVALID_HANDLE)
+    TAOLIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("TAO (%P|%t) - Storable_Journal::checkpoint, ")
+                          ACE_TEXT ("cannot create %C: %p\n"),
+                          this->checkpoint_path_.c_str (), ACE_TEXT ("open")),
+                         -1);
+
+  bool const saved = write_at (checkpoint, 0, data)
+    && ACE_OS::fsync (checkpoint) == 0;
+  ACE_OS::close (checkpoint);
+  if (!saved)
+    {
+      // The journal is still complete, try again on the next commit.
+      ACE_OS::unlink (this->checkpoint_path_.c_str ());
+      return -1;
+    }
+
+  // From now on the checkpoint file is used if the rewrite fails.
+  if (!write_at (handle, 0, data)
+      || ACE_OS::ftruncate (handle, static_cast<ACE_OFF_T> (data.size ())) != 0
+      || ACE_OS::fsync (handle) != 0)
+    {
+      this->loaded_ = false;
+      TAOLIB_ERROR_RETURN ((LM_ERROR,
+                            ACE_TEXT ("TAO (%P|%t) - Storable_Journal::checkpoint, ")
+                            ACE_TEXT ("cannot rewrite %C: %p\n"),
+                            this->path_.c_str (), ACE_TEXT ("pwrite")),
+                           -1);
+    }
+
+  ACE_OS::unlink (this->checkpoint_path_.c_str ());
+
+  ++this->generation_;
+  this->end_ = static_cast<ACE_OFF_T> (data.size ());
+  this->appended_ = 0;
+  return 0;
+}
+
+//------------------------------------------------
+
+TAO::Storable_JournalStream::Storable_JournalStream (Storable_Journal & journal,
+                                                     const char * mode,
+                                                     bool use_backup,
+                                                     bool retry_on_ebadf)
+  : Storable_Base (use_backup, retry_on_ebadf)
+  , journal_ (journal)
+  , filelock_ ()
+  , mode_ (mode)
+  , dirty_ (false)
+  , refreshed_ (false)
+  , position_ (0)
+{
+  // filelock_ will be completely initialized in call to open ().
+  filelock_.handle_ = ACE_INVALID_HANDLE;
+  filelock_.lockname_ = nullptr;
+}
+
+TAO::Storable_JournalStream::~Storable_JournalStream ()
+{
+  if (this->filelock_.handle_ != ACE_INVALID_HANDLE)
+    this->close ();
+}
+
+void
+TAO::Storable_JournalStream::do_remove ()
+{
+  this->journal_.forget ();
+  ACE_OS::unlink (this->journal_.path ().c_str ());
+  ACE_OS::unlink ((this->journal_.path () + ".ckpt").c_str ());
+}
+
+int
+TAO::Storable_JournalStream::exists ()
+{
+  return ! ACE_OS::access (this->journal_.path ().c_str (), F_OK);
+}
+
+int
+TAO::Storable_JournalStream::open ()
+{
+  // The file is always read and written with pread/pwrite, only
+  // creation and locking depend on the mode.
+  int flags = ACE_OS::strchr (this->mode_.c_str (), 'w') ? O_RDWR : O_RDONLY;
+  if (ACE_OS::strchr (this->mode_.c_str (), 'c'))
+    flags |= O_CREAT;
+
+#ifndef ACE_WIN32
+  if (ACE_OS::flock_init (&this->filelock_, flags,
+                          ACE_TEXT_CHAR_TO_TCHAR (this->journal_.path ().c_str ()),
+                          0666) != 0)
+#else
+  if ((this->filelock_.handle_ =
+         ACE_OS::open (this->journal_.path ().c_str (), flags, 0666))
+      == ACE_INVALID_HANDLE)
+#endif
+    TAOLIB_ERROR_RETURN ((LM_ERROR,
+                          ACE_TEXT ("(%P|%t) Storable_JournalStream::open ")
+                          ACE_TEXT ("Cannot open file %C for mode %C: %p\n"),
+                          this->journal_.path ().c_str (),
+                          this->mode_.c_str (),
+                          ACE_TEXT ("open")),
+                         -1);
+
+  this->committed_.reset ();
+  this->contents_.clear ();
+  this->dirty_ = false;
+  this->refreshed_ = false;
+  this->position_ = 0;
+  this->clear ();
+  return 0;
+}
+
+int
+TAO::Storable_JournalStream::close ()
+{
+  if (this->filelock_.handle_ == ACE_INVALID_HANDLE)
+    return 0;
+
+  int const result = this->commit (false);
+
+#ifndef ACE_WIN32
+  ACE_OS::flock_destroy (&this->filelock_, 0);
+#else
+  ACE_OS::close (this->filelock_.handle_);
+#endif
+  this->filelock_.handle_ = ACE_INVALID_HANDLE;
+  this->committed_.reset ();
+  this->contents_.clear ();
+  return result;
+}
+
+int
+TAO::Storable_JournalStream::flock (int whence, int start, int len)
+{
+#if defined (ACE_WIN32)
+  ACE_UNUSED_ARG (whence);
+  ACE_UNUSED_ARG (start);
+  ACE_UNUSED_ARG (len);
+#else
+  bool const shared = ACE_OS::strcmp (this->mode_.c_str (), "r") == 0;
+  int const result = shared ?
+    ACE_OS::flock_rdlock (&this->filelock_, whence, start, len) :
+    ACE_OS::flock_wrlock (&this->filelock_, whence, start, len);
+  if (result != 0)
+    {
+      if (TAO_debug_level > 0)
+        {
+          TAOLIB_ERROR ((LM_ERROR,
+                         ACE_TEXT ("TAO (%P|%t) - ")
+                         ACE_TEXT ("Storable_JournalStream::flock, ")
+                         ACE_TEXT ("File %C, %p\n"),
+                         this->journal_.path ().c_str (),
+                         (shared ? ACE_TEXT ("rdlock") : ACE_TEXT ("wrlock"))));
+        }
+      return result;
+    }
+#endif
+
+  // Whatever was read before the lock was acquired may be stale.
+  if (!this->dirty_)
+    this->refreshed_ = false;
+  this->refresh ();
+  return 0;
+}
+
+int
+TAO::Storable_JournalStream::funlock (int whence, int start, int len)
+{
+  // The changes must be in the file before another process gets in.
+  int result = this->commit (false);
+
+#if defined (ACE_WIN32)
+  ACE_UNUSED_ARG (whence);
+  ACE_UNUSED_ARG (start);
+  ACE_UNUSED_ARG (len);
+#else
+  if (ACE_OS::flock_unlock (&this->filelock_, whence, start, len) != 0)
+    {
+      if (TAO_debug_level > 0)
+        {
+          TAOLIB_ERROR ((LM_ERROR,
+                         ACE_TEXT ("TAO (%P|%t) - ")
+                         ACE_TEXT ("Storable_JournalStream::funlock, ")
+                         ACE_TEXT ("File %C, %p\n"),
+                         this->journal_.path ().c_str (),
+                         ACE_TEXT ("unlock")));
+        }
+      result = -1;
+    }
+#endif
+  return result;
+}
+
+time_t
+TAO::Storable_JournalStream::last_changed ()
+{
+  ACE_stat st;
+  int const result = this->filelock_.handle_ == ACE_INVALID_HANDLE
+    ? ACE_OS::stat (this->journal_.path ().c_str (), &st)
+    : ACE_OS::fstat (this->filelock_.handle_, &st);
+  if (result != 0)
+    {
+      TAOLIB_ERROR ((LM_ERROR,
+                     ACE_TEXT ("TAO (%P|%t) - ")
+                     ACE_TEXT ("Storable_JournalStream::last_changed, ")
+                     ACE_TEXT ("Error getting file information for %C, %p\n"),
+                     this->journal_.path ().c_str (), ACE_TEXT ("fstat")));
+      throw Storable_Exception (this->journal_.path ());
+    }
+
+  return st.st_mtime;
+}
+
+void
+TAO::Storable_JournalStream::rewind ()
+{
+  this->position_ = 0;
+}
+
+bool
+TAO::Storable_JournalStream::flush ()
+{
+  // Like fflush, 0 on success.  Nothing reaches the file before the
+  // stream commits.
+  return false;
+}
+
+int
+TAO::Storable_JournalStream::sync ()
+{
+  return this->commit (true) == 0 ? 0 : EOF;
+}
+
+int
+TAO::Storable_JournalStream::create_backup ()
+{
+  // Every record is checked when it is read back, commit now so a
+  // failure is reported while the object can still tell.
+  return this->commit (false);
+}
+
+void
+TAO::Storable_JournalStream::remove_backup ()
+{
+}
+
+int
+TAO::Storable_JournalStream::restore_backup ()
+{
+  return -1;
+}
+
+void
+TAO::Storable_JournalStream::refresh ()
+{
+  if (this->refreshed_ || this->filelock_.handle_ == ACE_INVALID_HANDLE)
+    return;
+
+  bool const writer = ACE_OS::strchr (this->mode_.c_str (), 'w') != nullptr;
+  if (this->journal_.refresh (this->filelock_.handle_,
+                              writer,
+                              this->committed_) != 0)
+    this->setstate (badbit);
+  this->refreshed_ = true;
+}
+
+int
+TAO::Storable_JournalStream::commit (bool sync)
+{
+  if (!this->dirty_)
+    return sync ? ACE_OS::fsync (this->filelock_.handle_) : 0;
+
+  if (this->journal_.commit (this->filelock_.handle_,
+                             this->contents_,
+                             sync,
+                             this->committed_) != 0)
+    return -1;
+
+  this->contents_.clear ();
+  this->dirty_ = false;
+  return 0;
+}
+
+const std::string &
+TAO::Storable_JournalStream::contents ()
+{
+  this->refresh ();
+  if (this->dirty_ || !this->committed_)
+    return this->contents_;
+  return *this->committed_;
+}
+
+void
+TAO::Storable_JournalStream::put (const char * bytes, size_t size)
+{
+  if (!this->dirty_)
+    {
+      this->refresh ();
+      if (this->committed_)
+        this->contents_ = *this->committed_;
+      this->dirty_ = true;
+    }
+
+  // Like a FILE opened with "w+", the bytes past the end of what is
+  // written are kept.
+  if (this->position_ + size > this->contents_.size ())
+    this->contents_.resize (this->position_ + size);
+  this->contents_.replace (this->position_, size, bytes, size);
+  this->position_ += size;
+}
+
+bool
+TAO::Storable_JournalStream::get (char * bytes, size_t size)
+{
+  const std::string & contents = this->contents ();
+  if (contents.size () < this->position_
+      || contents.size () - this->position_ < size)
+    return false;
+  ACE_OS::memcpy (bytes, contents.data () + this->position_, size);
+  this->position_ += size;
+  return true;
+}
+
+void
+TAO::Storable_JournalStream::put_uint64 (ACE_UINT64 i, size_t size)
+{
+  char bytes[8];
+  for (size_t n = 0; n < size; ++n, i >>= 8)
+    bytes[n] = static_cast<char> (i & 0xff);
+  this->put (bytes, size);
+}
+
+ACE_UINT64
+TAO::Storable_JournalStream::get_uint64 (size_t size)
+{
+  if (!this->good ())
+    this->throw_on_read_error (badbit);
+
+  char bytes[8];
+  if (!this->get (bytes, size))
+    this->throw_on_read_error (eofbit);
+  return get_le (bytes, size);
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator << (const ACE_CString& str)
+{
+  this->put_uint64 (str.length (), 4);
+  this->put (str.c_str (), str.length ());
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator >> (ACE_CString& str)
+{
+  size_t const size = static_cast<size_t> (this->get_uint64 (4));
+  const std::string & contents = this->contents ();
+  if (contents.size () - this->position_ < size)
+    this->throw_on_read_error (eofbit);
+  str.set (contents.data () + this->position_, size, true);
+  this->position_ += size;
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator << (ACE_UINT32 i)
+{
+  this->put_uint64 (i, 4);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator >> (ACE_UINT32 &i)
+{
+  i = static_cast<ACE_UINT32> (this->get_uint64 (4));
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator << (ACE_UINT64 i)
+{
+  this->put_uint64 (i, 8);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator >> (ACE_UINT64 &i)
+{
+  i = this->get_uint64 (8);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator << (ACE_INT32 i)
+{
+  this->put_uint64 (static_cast<ACE_UINT32> (i), 4);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator >> (ACE_INT32 &i)
+{
+  i = static_cast<ACE_INT32> (static_cast<ACE_UINT32> (this->get_uint64 (4)));
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator << (ACE_INT64 i)
+{
+  this->put_uint64 (static_cast<ACE_UINT64> (i), 8);
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator >> (ACE_INT64 &i)
+{
+  i = static_cast<ACE_INT64> (this->get_uint64 (8));
+  return *this;
+}
+
+TAO::Storable_Base &
+TAO::Storable_JournalStream::operator << (const TAO_OutputCDR & cdr)
+{
+  unsigned int const length =
+    ACE_Utils::truncate_cast<unsigned int> (cdr.total_length ());
+  *this << length;
+  for (const ACE_Message_Block *i = cdr.begin (); i != nullptr; i = i->cont ())
+    this->put (i->rd_ptr (), i->length ());
+  return *this;
+}
+
+size_t
+TAO::Storable_JournalStream::write (size_t size, const char * bytes)
+{
+  this->put (bytes, size);
+  return 1;
+}
+
+size_t
+TAO::Storable_JournalStream::read (size_t size, char * bytes)
+{
+  return this->get (bytes, size) ? 1 : 0;
+}
+
+void
+TAO::Storable_JournalStream::throw_on_read_error (Storable_State state)
+{
+  this->setstate (state);
+
+  if (!this->good ())
+    {
+      throw Storable_Read_Exception (this->rdstate (), this->journal_.path ());
+    }
+}
+
+//------------------------------------------------
+
+TAO::Storable_JournalFactory::Storable_JournalFactory (const ACE_CString & directory,
+                                                       bool use_backup,
+                                                       unsigned int checkpoint_ratio)
+  : Storable_Factory ()
+  , directory_ (directory)
+  , use_backup_ (use_backup)
+  , checkpoint_ratio_ (checkpoint_ratio)
+{
+}
+
+TAO::Storable_JournalFactory::~Storable_JournalFactory ()
+{
+  for (Journal_Map::iterator i = this->journals_.begin ();
+       i != this->journals_.end ();
+       ++i)
+    delete (*i).int_id_;
+}
+
+const ACE_CString &
+TAO::Storable_JournalFactory::get_directory () const
+{
+  return this->directory_;
+}
+
+TAO::Storable_Base *
+TAO::Storable_JournalFactory::create_stream (const ACE_CString & file,
+                                             const char * mode,
+                                             bool )
+{
+  ACE_CString path = this->directory_ + "/" + file;
+
+  Storable_Journal *journal = nullptr;
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, nullptr);
+    if (this->journals_.find (path, journal) != 0)
+      {
+        ACE_NEW_RETURN (journal,
+                        Storable_Journal (path, this->checkpoint_ratio_),
+                        nullptr);
+        this->journals_.bind (path, journal);
+      }
+  }
+
+  TAO::Storable_Base *stream = nullptr;
+  ACE_NEW_RETURN (stream,
+                  TAO::Storable_JournalStream (*journal,
+                                               mode,
+                                               this->use_backup_),
+                  nullptr);
+  return stream;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
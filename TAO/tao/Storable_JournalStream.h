@@ -0,0 +1,204 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ * @file  Storable_JournalStream.h
+ *
+ * A Storable_Base that keeps its file as an append-only journal of
+ * the changes made to it, with periodic checkpoints.
+ */
+//=============================================================================
+
+#ifndef STORABLE_JOURNALSTREAM_H
+#define STORABLE_JOURNALSTREAM_H
+
+#include /**/ "ace/pre.h"
+#include "ace/config-lite.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "tao/Storable_Base.h"
+#include "tao/Storable_Factory.h"
+#include "tao/orbconf.h"
+#include "ace/Hash_Map_Manager_T.h"
+#include "ace/Null_Mutex.h"
+#include "ace/OS_NS_stdio.h"
+
+#include <memory>
+#include <string>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  class Storable_Journal;
+
+  /**
+   * @brief A Storable_Base derived class whose file is a journal.
+   *
+   * The stream is read and written in memory.  When it is closed (or
+   * synced) after a write, the new contents are compared with the
+   * contents last committed and only the difference is appended to
+   * the file, so rewriting a large object after a small change costs
+   * a small write.  Once the differences appended since the last
+   * checkpoint outgrow the contents, the file is replaced by a new
+   * checkpoint.
+   *
+   * Every record carries a checksum; a torn record at the end of the
+   * file, left by a crash, is ignored and overwritten by the next
+   * commit.  The records are self-checking, so create_backup() only
+   * commits and restore_backup() has nothing to restore.
+   *
+   * The contents are cached by the Storable_JournalFactory, a stream
+   * only reads the records appended since the file was last seen.
+   */
+  class TAO_Export Storable_JournalStream : public Storable_Base
+  {
+  public:
+    Storable_JournalStream (Storable_Journal & journal,
+                            const char * mode,
+                            bool use_backup = Storable_Base::use_backup_default,
+                            bool retry_on_ebadf = Storable_Base::retry_on_ebadf_default);
+
+    virtual ~Storable_JournalStream ();
+
+    /// Check if a file exists on disk (file is not open)
+    virtual int exists ();
+
+    /// Open a file (the remaining methods below all require an open file)
+    virtual int open ();
+
+    /// Commit the changes and close the file
+    virtual int close ();
+
+    /// Acquire a file lock, and catch up with the changes made by
+    /// other processes.
+    virtual int flock (int whence, int start, int len);
+
+    /// Release a file lock
+    virtual int funlock (int whence, int start, int len);
+
+    /// Returns the last time an open file was changed
+    virtual time_t last_changed ();
+
+    virtual void rewind ();
+
+    virtual bool flush ();
+
+    /// Commit the changes and force them to storage.
+    /// Returns 0 on success, otherwise EOF
+    virtual int sync ();
+
+    virtual Storable_Base& operator << (const ACE_CString&);
+    virtual Storable_Base& operator >> (ACE_CString&);
+    virtual Storable_Base& operator << (ACE_UINT32 );
+    virtual Storable_Base& operator >> (ACE_UINT32 &);
+    virtual Storable_Base& operator << (ACE_UINT64 );
+    virtual Storable_Base& operator >> (ACE_UINT64 &);
+    virtual Storable_Base& operator << (ACE_INT32 );
+    virtual Storable_Base& operator >> (ACE_INT32 &);
+    virtual Storable_Base& operator << (ACE_INT64 );
+    virtual Storable_Base& operator >> (ACE_INT64 &);
+
+    virtual Storable_Base& operator << (const TAO_OutputCDR & cdr);
+
+    virtual size_t write (size_t size, const char * bytes);
+
+    virtual size_t read (size_t size, char * bytes);
+
+    virtual int restore_backup ();
+
+  protected:
+    virtual void do_remove ();
+
+    virtual void remove_backup ();
+
+    virtual int create_backup ();
+
+  private:
+    /// Pick up the contents last committed to the file.
+    void refresh ();
+
+    /// Append the changes to the file, if any, and force the file to
+    /// storage if @a sync is set.
+    int commit (bool sync);
+
+    /// The contents being read.
+    const std::string & contents ();
+
+    /// Copy @a size bytes at the current position.
+    void put (const char * bytes, size_t size);
+
+    /// Copy @a size bytes from the current position, returns false
+    /// if the contents are too short.
+    bool get (char * bytes, size_t size);
+
+    void put_uint64 (ACE_UINT64 i, size_t size);
+    ACE_UINT64 get_uint64 (size_t size);
+
+    /// Throw a Storable_Read_Exception if the state
+    /// is not good due to a read error.
+    void throw_on_read_error (Storable_State state);
+
+    Storable_Journal & journal_;
+    ACE_OS::ace_flock_t filelock_;
+    ACE_CString mode_;
+
+    /// The contents as of the last refresh or commit.
+    std::shared_ptr<const std::string> committed_;
+
+    /// The contents being written, a copy of <committed_> made on
+    /// the first write.
+    std::string contents_;
+    bool dirty_;
+
+    /// Set once <committed_> is up to date with the file.
+    bool refreshed_;
+
+    /// The read/write position.
+    size_t position_;
+  };
+
+  class TAO_Export Storable_JournalFactory : public Storable_Factory
+  {
+  public:
+    /// @param directory Directory to contain file passed in
+    /// create_stream (). The directory is assumed to already exist.
+    /// @param checkpoint_ratio A new checkpoint is written once the
+    /// changes appended to a file are @a checkpoint_ratio times as
+    /// large as its contents.
+    Storable_JournalFactory (const ACE_CString & directory,
+                             bool use_backup = Storable_Base::use_backup_default,
+                             unsigned int checkpoint_ratio = 1);
+
+    const ACE_CString & get_directory () const;
+
+    ~Storable_JournalFactory ();
+
+    /// Create the stream that can operate on a journal file
+    virtual Storable_Base *create_stream (const ACE_CString & file,
+                                          const char * mode,
+                                          bool = false);
+  private:
+    ACE_CString directory_;
+    bool use_backup_;
+    unsigned int checkpoint_ratio_;
+
+    /// The cached contents of the files, by path.
+    typedef ACE_Hash_Map_Manager_Ex<ACE_CString,
+                                    Storable_Journal *,
+                                    ACE_Hash<ACE_CString>,
+                                    ACE_Equal_To<ACE_CString>,
+                                    ACE_Null_Mutex> Journal_Map;
+    Journal_Map journals_;
+    TAO_SYNCH_MUTEX lock_;
+  };
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#include /**/ "ace/post.h"
+
+#endif /* STORABLE_JOURNALSTREAM_H */
@@ -49,6 +49,15 @@ public:
   {
   }
 
+  /// Move constructor takes over the string of @a rhs, which is left
+  /// holding a null pointer as after _retn() and may only be assigned
+  /// to or destroyed.
+  inline String_Manager_T (String_Manager_T<charT> &&rhs) noexcept :
+    ptr_ (rhs.ptr_)
+  {
+    rhs.ptr_ = 0;
+  }
+
   /// Constructor from const char* makes a copy.
   inline String_Manager_T (const character_type *s) :
     ptr_ (s_traits::duplicate (s))
@@ -69,6 +78,13 @@ public:
     return *this;
   }
 
+  /// Move assignment exchanges the strings, the one this managed is
+  /// released along with @a rhs.
+  inline String_Manager_T &operator= (String_Manager_T<charT> &&rhs) noexcept {
+    std::swap (this->ptr_, rhs.ptr_);
+    return *this;
+  }
+
   /// Assignment from var type will make a copy
   inline String_Manager_T &operator= (const typename s_traits::string_var& value) {
     // Strongly exception safe by means of copy and non-throwing swap
@@ -24,6 +24,7 @@
 #include "tao/operation_details.h"
 #include "tao/Transport_Descriptor_Interface.h"
 #include "tao/ORB_Time_Policy.h"
+#include "tao/Transport_Profile.h"
 
 #include "ace/OS_NS_sys_time.h"
 #include "ace/OS_NS_stdio.h"
@@ -155,6 +156,9 @@ TAO_Transport::TAO_Transport (CORBA::ULong tag,
 #if TAO_HAS_TRANSPORT_CURRENT == 1
   , stats_ (nullptr)
 #endif /* TAO_HAS_TRANSPORT_CURRENT == 1 */
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  , profile_ (nullptr)
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
   , flush_in_post_open_ (false)
 {
   ACE_NEW (this->messaging_object_,
@@ -177,6 +181,20 @@ TAO_Transport::TAO_Transport (CORBA::ULong tag,
                     TAO::Transport::Stats,
                     CORBA::NO_MEMORY ());
 #endif /* TAO_HAS_TRANSPORT_CURRENT == 1 */
+
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  // Only profile when asked to, the ORB keeps no profile otherwise.
+  TAO::Transport::Profile * const orb_profile =
+    this->orb_core_->transport_profile ();
+
+  if (orb_profile != nullptr)
+    {
+      ACE_NEW_THROW_EX (this->profile_,
+                        TAO::Transport::Profile,
+                        CORBA::NO_MEMORY ());
+      orb_profile->transport_opened ();
+    }
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
 }
 
 TAO_Transport::~TAO_Transport ()
@@ -217,6 +235,20 @@ TAO_Transport::~TAO_Transport ()
 #if TAO_HAS_TRANSPORT_CURRENT == 1
   delete this->stats_;
 #endif /* TAO_HAS_TRANSPORT_CURRENT == 1 */
+
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  if (this->profile_ != nullptr)
+    {
+      if (this->bidirectional_flag_ != -1)
+        this->profile_->count (TAO::Transport::Profile::BIDIR_TRANSPORTS);
+
+      TAO::Transport::Profile * const orb_profile =
+        this->orb_core_->transport_profile ();
+      orb_profile->merge (*this->profile_);
+      orb_profile->transport_closed ();
+      delete this->profile_;
+    }
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
 }
 
 void
@@ -1088,6 +1120,19 @@ TAO_Transport::drain_queue_i (TAO::Transport::Drain_Constraints const & dc)
   // If we are forced to send in the loop then we'll recompute the time.
   ACE_Time_Value now = ACE_High_Res_Timer::gettimeofday_hr ();
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  if (this->profile_ != nullptr)
+    {
+      ACE_UINT64 depth = 0;
+      for (TAO_Queued_Message *m = this->head_; m != nullptr; m = m->next ())
+        ++depth;
+
+      this->profile_->sample (
+        TAO::Transport::Profile::QUEUE_DEPTH, depth);
+      this->profile_->flush_begin (now);
+    }
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   while (i != nullptr)
     {
       if (i->is_expired (now))
@@ -1169,6 +1214,11 @@ TAO_Transport::drain_queue_i (TAO::Transport::Drain_Constraints const & dc)
           this->reset_flush_timer ();
         }
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+      if (this->profile_ != nullptr)
+        this->profile_->flush_end (ACE_High_Res_Timer::gettimeofday_hr ());
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
       return DR_QUEUE_EMPTY;
     }
 
@@ -1369,6 +1419,12 @@ TAO_Transport::send_message_shared_i (TAO_Stub *stub,
   size_t const message_length = message_block->length ();
 #endif /* TAO_HAS_TRANSPORT_CURRENT == 1 */
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  // Size the whole chain before it is handed over to be sent.
+  size_t const profiled_length =
+    this->profile_ != nullptr ? message_block->total_length () : 0;
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   switch (message_semantics.type_)
     {
       case TAO_Message_Semantics::TAO_TWOWAY_REQUEST:
@@ -1392,6 +1448,12 @@ TAO_Transport::send_message_shared_i (TAO_Stub *stub,
     this->stats_->messages_sent (message_length);
 #endif /* TAO_HAS_TRANSPORT_CURRENT == 1 */
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  if (ret != -1 && this->profile_ != nullptr)
+    this->profile_->sample (
+      TAO::Transport::Profile::SENT_MESSAGE_SIZE, profiled_length);
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   return ret;
 }
 
@@ -1937,6 +1999,12 @@ TAO_Transport::handle_input_missing_data (TAO_Resume_Handle &rh,
       return ACE_Utils::truncate_cast<int> (n);
     }
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  if (this->profile_ != nullptr)
+    this->profile_->sample (
+      TAO::Transport::Profile::READ_SIZE, n);
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   if (TAO_debug_level > 3)
     {
       TAOLIB_DEBUG ((LM_DEBUG,
@@ -2166,6 +2234,12 @@ TAO_Transport::handle_input_parse_data  (TAO_Resume_Handle &rh,
       return ACE_Utils::truncate_cast<int> (n);
     }
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  if (this->profile_ != nullptr)
+    this->profile_->sample (
+      TAO::Transport::Profile::READ_SIZE, n);
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   if (this->partial_message_ != nullptr && this->partial_message_->length () > 0)
     {
       this->partial_message_->reset ();
@@ -2463,6 +2537,12 @@ TAO_Transport::process_parsed_messages (TAO_Queued_Data *qd,
     this->stats_->messages_received (qd->msg_block ()->length ());
 #endif /* TAO_HAS_TRANSPORT_CURRENT == 1 */
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  if (this->profile_ != nullptr)
+    this->profile_->sample (TAO::Transport::Profile::RECEIVED_MESSAGE_SIZE,
+                            qd->msg_block ()->length ());
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   switch (qd->msg_type ())
   {
     case GIOP::CloseConnection:
@@ -2487,6 +2567,12 @@ TAO_Transport::process_parsed_messages (TAO_Queued_Data *qd,
       // request. This will open up the handle for other threads.
       rh.resume_handle ();
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+      if (this->profile_ != nullptr
+          && this->orb_core_->leader_follower ().is_client_leader_thread ())
+        this->profile_->count (TAO::Transport::Profile::NESTED_UPCALLS);
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
       if (this->messaging_object ()->process_request_message (this, qd) == -1)
         {
           // Return a "-1" so that the next stage can take care of
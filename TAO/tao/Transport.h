@@ -68,6 +68,12 @@ namespace TAO
     /// the "Transport Current" functionality.
     class Stats;
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+    /// Histograms of the transport's traffic, recorded when the ORB
+    /// is started with -ORBTransportProfile.
+    class Profile;
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   /**
    * @struct Drain_Constraints
    *
@@ -896,6 +902,11 @@ public:
   /// Transport statistics
   TAO::Transport::Stats* stats () const;
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  /// Transport profile, 0 unless the ORB profiles its transports.
+  TAO::Transport::Profile* profile () const;
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
 private:
   /// Helper method that returns the Transport Cache Manager.
   TAO::Transport_Cache_Manager &transport_cache_manager ();
@@ -1214,6 +1225,11 @@ private:
   TAO::Transport::Stats* stats_;
 #endif /* TAO_HAS_TRANSPORT_CURRENT == 1 */
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  /// Profile, added to the ORB's when the transport goes away.
+  TAO::Transport::Profile* profile_;
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   /// Indicate that flushing needs to be done in post_open()
   bool flush_in_post_open_;
 
@@ -202,6 +202,14 @@ TAO_Transport::sent_byte_count () const
   return this->sent_byte_count_;
 }
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+ACE_INLINE TAO::Transport::Profile*
+TAO_Transport::profile () const
+{
+  return this->profile_;
+}
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
 #if TAO_HAS_TRANSPORT_CURRENT == 1
 
 ACE_INLINE TAO::Transport::Stats*
@@ -0,0 +1,344 @@
+#include "tao/Transport_Profile.h"
+
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/OS_NS_string.h"
+#include "ace/OS_Memory.h"
+
+#include <memory>
+
+#if !defined (__ACE_INLINE__)
+# include "tao/Transport_Profile.inl"
+#endif /* ! __ACE_INLINE__ */
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace
+{
+  char const * const metric_names[] =
+    {
+      "sent_message_size",
+      "received_message_size",
+      "read_size",
+      "queue_depth",
+      "flush_time",
+      "reply_wait_time"
+    };
+
+  char const * const counter_names[] =
+    {
+      "read_waits",
+      "leader_follower_waits",
+      "reactor_waits",
+      "nested_upcalls",
+      "bidir_transports"
+    };
+
+  char const * const setting_names[] =
+    {
+      "sndsock",
+      "rcvsock",
+      "max_message_size",
+      "connection_cache_max",
+      "wait_spin_time"
+    };
+
+  char const profile_header[] = "# TAO transport profile";
+
+  /// Longest line of a profile, which a histogram of every bucket
+  /// still fits in.
+  size_t const max_line = 64 * 1024;
+
+  char const hex_digits[] = "0123456789abcdef";
+
+  ACE_UINT64
+  to_uint64 (char const *s, bool &ok)
+  {
+    if (s == nullptr)
+      {
+        ok = false;
+        return 0;
+      }
+
+    char *end = nullptr;
+    ACE_UINT64 const value = ACE_OS::strtoull (s, &end, 10);
+    ok = ok && end != s && *end == '\0';
+    return value;
+  }
+
+  int
+  from_hex (char c)
+  {
+    if (c >= '0' && c <= '9')
+      return c - '0';
+    if (c >= 'a' && c <= 'f')
+      return c - 'a' + 10;
+    return -1;
+  }
+}
+
+TAO::Transport::Profile::Profile ()
+  : histograms_ { { PRECISION, HIGHEST_VALUE },
+                  { PRECISION, HIGHEST_VALUE },
+                  { PRECISION, HIGHEST_VALUE },
+                  { PRECISION, HIGHEST_VALUE },
+                  { PRECISION, HIGHEST_VALUE },
+                  { PRECISION, HIGHEST_VALUE } }
+  , flush_start_ (ACE_Time_Value::zero)
+{
+  static_assert (METRICS == 6, "one initializer per histogram");
+
+  for (int i = 0; i != COUNTERS; ++i)
+    this->counters_[i].store (0, std::memory_order_relaxed);
+  for (int i = 0; i != SETTINGS; ++i)
+    this->settings_[i] = 0;
+  this->transports_.store (0, std::memory_order_relaxed);
+  this->open_transports_.store (0, std::memory_order_relaxed);
+  this->peak_transports_.store (0, std::memory_order_relaxed);
+}
+
+const char *
+TAO::Transport::Profile::name (Metric metric)
+{
+  return metric_names[metric];
+}
+
+const char *
+TAO::Transport::Profile::name (Counter counter)
+{
+  return counter_names[counter];
+}
+
+const char *
+TAO::Transport::Profile::name (Setting setting)
+{
+  return setting_names[setting];
+}
+
+void
+TAO::Transport::Profile::transport_opened ()
+{
+  this->transports_.fetch_add (1, std::memory_order_relaxed);
+
+  ACE_UINT64 const open =
+    this->open_transports_.fetch_add (1, std::memory_order_relaxed) + 1;
+
+  ACE_UINT64 peak = this->peak_transports_.load (std::memory_order_relaxed);
+  while (open > peak
+         && !this->peak_transports_.compare_exchange_weak (
+               peak, open, std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+TAO::Transport::Profile::transport_closed ()
+{
+  this->open_transports_.fetch_sub (1, std::memory_order_relaxed);
+}
+
+void
+TAO::Transport::Profile::merge (Profile const &other)
+{
+  {
+    ACE_GUARD (TAO_SYNCH_MUTEX, other_mon, other.lock_);
+    ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+
+    for (int i = 0; i != METRICS; ++i)
+      this->histograms_[i].accumulate (other.histograms_[i]);
+
+    for (int i = 0; i != SETTINGS; ++i)
+      {
+        if (this->settings_[i] == 0)
+          this->settings_[i] = other.settings_[i];
+      }
+  }
+
+  for (int i = 0; i != COUNTERS; ++i)
+    this->counters_[i].fetch_add (other.counter (static_cast<Counter> (i)),
+                                  std::memory_order_relaxed);
+
+  this->transports_.fetch_add (other.transports (),
+                               std::memory_order_relaxed);
+
+  ACE_UINT64 const other_peak = other.peak_transports ();
+  ACE_UINT64 peak = this->peak_transports_.load (std::memory_order_relaxed);
+  while (other_peak > peak
+         && !this->peak_transports_.compare_exchange_weak (
+               peak, other_peak, std::memory_order_relaxed))
+    {
+    }
+}
+
+int
+TAO::Transport::Profile::write (FILE *file) const
+{
+  if (ACE_OS::fprintf (file, "%s\n", profile_header) < 0)
+    return -1;
+
+  for (int i = 0; i != SETTINGS; ++i)
+    {
+      ACE_OS::fprintf (file,
+                       "setting %s " ACE_UINT64_FORMAT_SPECIFIER_ASCII "\n",
+                       setting_names[i],
+                       this->settings_[i]);
+    }
+
+  ACE_OS::fprintf (file,
+                   "transports " ACE_UINT64_FORMAT_SPECIFIER_ASCII
+                   " " ACE_UINT64_FORMAT_SPECIFIER_ASCII "\n",
+                   this->transports (),
+                   this->peak_transports ());
+
+  for (int i = 0; i != COUNTERS; ++i)
+    {
+      ACE_OS::fprintf (file,
+                       "counter %s " ACE_UINT64_FORMAT_SPECIFIER_ASCII "\n",
+                       counter_names[i],
+                       this->counter (static_cast<Counter> (i)));
+    }
+
+  ACE_GUARD_RETURN (TAO_SYNCH_MUTEX, ace_mon, this->lock_, -1);
+
+  // Each histogram as its ACE_HDR_Histogram encoding, in hex.
+  for (int m = 0; m != METRICS; ++m)
+    {
+      ACE_HDR_Histogram const &h = this->histograms_[m];
+      size_t const size = h.encode (nullptr, 0);
+
+      char *raw = nullptr;
+      ACE_NEW_RETURN (raw, char[size], -1);
+      std::unique_ptr<char[]> buffer (raw);
+      h.encode (buffer.get (), size);
+
+      ACE_OS::fprintf (file, "histogram %s ", metric_names[m]);
+      for (size_t i = 0; i != size; ++i)
+        {
+          unsigned char const byte =
+            static_cast<unsigned char> (buffer[i]);
+          ACE_OS::fprintf (file,
+                           "%c%c",
+                           hex_digits[byte >> 4],
+                           hex_digits[byte & 0xf]);
+        }
+      ACE_OS::fprintf (file, "\n");
+    }
+
+  return ACE_OS::fflush (file) == 0 ? 0 : -1;
+}
+
+int
+TAO::Transport::Profile::read (FILE *file)
+{
+  char *line = nullptr;
+  ACE_NEW_RETURN (line, char[max_line], -1);
+  std::unique_ptr<char[]> buffer (line);
+
+  if (ACE_OS::fgets (line, max_line, file) == nullptr
+      || ACE_OS::strncmp (line,
+                          profile_header,
+                          sizeof profile_header - 1) != 0)
+    return -1;
+
+  Profile read;
+  bool ok = true;
+
+  while (ok && ACE_OS::fgets (line, max_line, file) != nullptr)
+    {
+      // A line that did not fit is not one of ours.
+      if (ACE_OS::strlen (line) == max_line - 1
+          && line[max_line - 2] != '\n')
+        {
+          ok = false;
+          break;
+        }
+
+      char *lasts = nullptr;
+      char const *kind = ACE_OS::strtok_r (line, " \t\r\n", &lasts);
+
+      if (kind == nullptr || *kind == '#')
+        continue;
+
+      if (ACE_OS::strcmp (kind, "setting") == 0)
+        {
+          char const *name = ACE_OS::strtok_r (nullptr, " \t\r\n", &lasts);
+          ACE_UINT64 const value =
+            to_uint64 (ACE_OS::strtok_r (nullptr, " \t\r\n", &lasts), ok);
+
+          for (int i = 0; ok && name != nullptr && i != SETTINGS; ++i)
+            {
+              if (ACE_OS::strcmp (name, setting_names[i]) == 0)
+                read.settings_[i] = value;
+            }
+        }
+      else if (ACE_OS::strcmp (kind, "counter") == 0)
+        {
+          char const *name = ACE_OS::strtok_r (nullptr, " \t\r\n", &lasts);
+          ACE_UINT64 const value =
+            to_uint64 (ACE_OS::strtok_r (nullptr, " \t\r\n", &lasts), ok);
+
+          // Ignore the counters this version does not know about.
+          for (int i = 0; ok && name != nullptr && i != COUNTERS; ++i)
+            {
+              if (ACE_OS::strcmp (name, counter_names[i]) == 0)
+                read.counters_[i].store (value, std::memory_order_relaxed);
+            }
+        }
+      else if (ACE_OS::strcmp (kind, "transports") == 0)
+        {
+          ACE_UINT64 const transports =
+            to_uint64 (ACE_OS::strtok_r (nullptr, " \t\r\n", &lasts), ok);
+          ACE_UINT64 const peak =
+            to_uint64 (ACE_OS::strtok_r (nullptr, " \t\r\n", &lasts), ok);
+
+          read.transports_.store (transports, std::memory_order_relaxed);
+          read.peak_transports_.store (peak, std::memory_order_relaxed);
+        }
+      else if (ACE_OS::strcmp (kind, "histogram") == 0)
+        {
+          char const *name = ACE_OS::strtok_r (nullptr, " \t\r\n", &lasts);
+          char *hex = ACE_OS::strtok_r (nullptr, " \t\r\n", &lasts);
+
+          ACE_HDR_Histogram *h = nullptr;
+          for (int m = 0; name != nullptr && m != METRICS; ++m)
+            {
+              if (ACE_OS::strcmp (name, metric_names[m]) == 0)
+                h = &read.histograms_[m];
+            }
+
+          // Ignore the metrics this version does not know about.
+          if (h == nullptr)
+            continue;
+
+          size_t const length = hex == nullptr ? 0 : ACE_OS::strlen (hex);
+          if (length == 0 || length % 2 != 0)
+            {
+              ok = false;
+              break;
+            }
+
+          // Decode in place, each pair of digits makes one byte.
+          for (size_t i = 0; ok && i != length / 2; ++i)
+            {
+              int const high = from_hex (hex[2 * i]);
+              int const low = from_hex (hex[2 * i + 1]);
+              ok = high != -1 && low != -1;
+              hex[i] = static_cast<char> (high << 4 | low);
+            }
+
+          ok = ok && h->decode (hex, length / 2) == 0;
+        }
+    }
+
+  if (!ok)
+    return -1;
+
+  this->merge (read);
+  return 0;
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
@@ -0,0 +1,195 @@
+// -*- C++ -*-
+
+//=============================================================================
+/**
+ *  @file Transport_Profile.h
+ *
+ *  Histograms of what the transports of an ORB do, captured to tune
+ *  the ORB options for a given application.
+ */
+//=============================================================================
+
+#ifndef TAO_TRANSPORT_PROFILE_H
+#define TAO_TRANSPORT_PROFILE_H
+
+#include /**/ "ace/pre.h"
+
+#include "tao/orbconf.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+# pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+
+#include /**/ "tao/TAO_Export.h"
+#include "tao/Versioned_Namespace.h"
+#include "ace/Basic_Types.h"
+#include "ace/Guard_T.h"
+#include "ace/HDR_Histogram.h"
+#include "ace/Thread_Mutex.h"
+#include "ace/Time_Value.h"
+#include "ace/os_include/os_stdio.h"
+
+#include <atomic>
+
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace TAO
+{
+  namespace Transport
+  {
+    /**
+     * @class Profile
+     *
+     * @brief The histograms recorded for a transport, or merged for
+     * all the transports of an ORB.
+     *
+     * Enabled with the -ORBTransportProfile option, which names the
+     * file the profile of the ORB is written to when the ORB is
+     * destroyed.  The tao_transport_tuner utility reads that file and
+     * suggests ORB options.
+     *
+     * The histograms keep PRECISION bits of each sample, so their
+     * percentiles are within 1/16th of the exact value, and tell the
+     * values apart up to HIGHEST_VALUE, which bounds both the bytes
+     * and the microseconds recorded.
+     */
+    class TAO_Export Profile
+    {
+    public:
+      enum
+        {
+          PRECISION = 4,
+          HIGHEST_VALUE = ACE_UINT32_MAX
+        };
+
+      /// What is recorded.
+      enum Metric
+        {
+          /// Size of the GIOP messages sent, in bytes.
+          SENT_MESSAGE_SIZE,
+          /// Size of the GIOP messages received, in bytes.
+          RECEIVED_MESSAGE_SIZE,
+          /// Bytes returned by each read from the connection.
+          READ_SIZE,
+          /// Messages in the outgoing queue when it is flushed.
+          QUEUE_DEPTH,
+          /// Microseconds from the first attempt to flush the outgoing
+          /// queue until it is empty.
+          FLUSH_TIME,
+          /// Microseconds a client thread waits for a reply.
+          REPLY_WAIT_TIME,
+          METRICS
+        };
+
+      /// What is counted.
+      enum Counter
+        {
+          /// Replies waited for by each wait strategy.
+          READ_WAITS,
+          LEADER_FOLLOWER_WAITS,
+          REACTOR_WAITS,
+          /// Requests dispatched by a thread waiting for a reply as
+          /// the client leader.
+          NESTED_UPCALLS,
+          /// Transports that carried BiDir GIOP.
+          BIDIR_TRANSPORTS,
+          COUNTERS
+        };
+
+      /// ORB options in effect when the profile was captured.
+      enum Setting
+        {
+          SNDSOCK,
+          RCVSOCK,
+          MAX_MESSAGE_SIZE,
+          CONNECTION_CACHE_MAX,
+          WAIT_SPIN_TIME,
+          SETTINGS
+        };
+
+      Profile ();
+
+      static const char *name (Metric metric);
+      static const char *name (Counter counter);
+      static const char *name (Setting setting);
+
+      /// Record @a value in the histogram of @a metric.
+      void sample (Metric metric, ACE_UINT64 value);
+
+      /// The histogram of @a metric, to be read once nothing is
+      /// recorded in the profile any more.
+      ACE_HDR_Histogram const &histogram (Metric metric) const;
+
+      void count (Counter counter);
+      ACE_UINT64 counter (Counter counter) const;
+
+      ACE_UINT64 setting (Setting setting) const;
+      void setting (Setting setting, ACE_UINT64 value);
+
+      /// Count the transports, and the most open at the same time.
+      //@{
+      void transport_opened ();
+      void transport_closed ();
+      ACE_UINT64 transports () const;
+      ACE_UINT64 peak_transports () const;
+      //@}
+
+      /// Time the flushing of the outgoing queue of a transport.
+      /**
+       * Only used on the profile of a single transport, with the
+       * transport's handler lock held.  flush_begin() has no effect
+       * when a flush is already being timed.
+       */
+      //@{
+      void flush_begin (ACE_Time_Value const &now);
+      void flush_end (ACE_Time_Value const &now);
+      //@}
+
+      /// Add the samples of @a other, which is done when a transport
+      /// goes away.
+      void merge (Profile const &other);
+
+      /// Write the profile as text, return -1 on failure.
+      int write (FILE *file) const;
+
+      /// Add the samples of a profile written by write(), return -1 if
+      /// the file is not a profile.
+      int read (FILE *file);
+
+    private:
+      Profile (Profile const &) = delete;
+      Profile &operator= (Profile const &) = delete;
+
+      /// ACE_HDR_Histogram does no locking, so this serializes the
+      /// threads that record in, or merge into, the histograms.
+      mutable TAO_SYNCH_MUTEX lock_;
+
+      ACE_HDR_Histogram histograms_[METRICS];
+
+      std::atomic<ACE_UINT64> counters_[COUNTERS];
+
+      ACE_UINT64 settings_[SETTINGS];
+
+      std::atomic<ACE_UINT64> transports_;
+      std::atomic<ACE_UINT64> open_transports_;
+      std::atomic<ACE_UINT64> peak_transports_;
+
+      /// Start of the flush being timed, zero if none.
+      ACE_Time_Value flush_start_;
+    };
+  }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
+
+#if defined (__ACE_INLINE__)
+# include "tao/Transport_Profile.inl"
+#endif /* __ACE_INLINE__ */
+
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
+#include /**/ "ace/post.h"
+
+#endif /* TAO_TRANSPORT_PROFILE_H */
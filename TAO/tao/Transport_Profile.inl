@@ -0,0 +1,72 @@
+// -*- C++ -*-
+TAO_BEGIN_VERSIONED_NAMESPACE_DECL
+
+ACE_INLINE void
+TAO::Transport::Profile::sample (Metric metric, ACE_UINT64 value)
+{
+  ACE_GUARD (TAO_SYNCH_MUTEX, ace_mon, this->lock_);
+  this->histograms_[metric].sample (value);
+}
+
+ACE_INLINE ACE_HDR_Histogram const &
+TAO::Transport::Profile::histogram (Metric metric) const
+{
+  return this->histograms_[metric];
+}
+
+ACE_INLINE void
+TAO::Transport::Profile::count (Counter counter)
+{
+  this->counters_[counter].fetch_add (1, std::memory_order_relaxed);
+}
+
+ACE_INLINE ACE_UINT64
+TAO::Transport::Profile::counter (Counter counter) const
+{
+  return this->counters_[counter].load (std::memory_order_relaxed);
+}
+
+ACE_INLINE ACE_UINT64
+TAO::Transport::Profile::setting (Setting setting) const
+{
+  return this->settings_[setting];
+}
+
+ACE_INLINE void
+TAO::Transport::Profile::setting (Setting setting, ACE_UINT64 value)
+{
+  this->settings_[setting] = value;
+}
+
+ACE_INLINE ACE_UINT64
+TAO::Transport::Profile::transports () const
+{
+  return this->transports_.load (std::memory_order_relaxed);
+}
+
+ACE_INLINE ACE_UINT64
+TAO::Transport::Profile::peak_transports () const
+{
+  return this->peak_transports_.load (std::memory_order_relaxed);
+}
+
+ACE_INLINE void
+TAO::Transport::Profile::flush_begin (ACE_Time_Value const &now)
+{
+  if (this->flush_start_ == ACE_Time_Value::zero)
+    this->flush_start_ = now;
+}
+
+ACE_INLINE void
+TAO::Transport::Profile::flush_end (ACE_Time_Value const &now)
+{
+  if (this->flush_start_ != ACE_Time_Value::zero)
+    {
+      ACE_UINT64 usecs = 0;
+      (now - this->flush_start_).to_usec (usecs);
+      this->sample (FLUSH_TIME, usecs);
+      this->flush_start_ = ACE_Time_Value::zero;
+    }
+}
+
+TAO_END_VERSIONED_NAMESPACE_DECL
@@ -295,6 +295,30 @@ public:
     return * this;
   }
 
+  /// Take over the buffer or message block of @a rhs, leaving it
+  /// empty.
+  unbounded_value_sequence (unbounded_value_sequence && rhs) noexcept
+    : maximum_ (rhs.maximum_)
+    , length_ (rhs.length_)
+    , buffer_ (rhs.buffer_)
+    , release_ (rhs.release_)
+    , mb_ (rhs.mb_)
+  {
+    rhs.maximum_ = allocation_traits::default_maximum();
+    rhs.length_ = 0;
+    rhs.buffer_ = 0;
+    rhs.release_ = false;
+    rhs.mb_ = 0;
+  }
+
+  unbounded_value_sequence &
+  operator= (unbounded_value_sequence && rhs) noexcept
+  {
+    unbounded_value_sequence tmp(std::move(rhs));
+    swap(tmp);
+    return * this;
+  }
+
 private:
   /// The maximum number of elements the buffer can contain.
   CORBA::ULong maximum_;
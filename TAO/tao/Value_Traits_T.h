@@ -12,6 +12,7 @@
 #include /**/ "tao/Versioned_Namespace.h"
 
 #include <algorithm>
+#include <type_traits>
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -51,10 +52,28 @@ struct value_traits
     std::copy(begin, end, dst);
   }
 
-  // Allow MSVC++ >= 8 checked iterators to be used.
+  // Allow MSVC++ >= 8 checked iterators to be used.  The source
+  // range is discarded afterwards, so its elements are moved when that
+  // cannot throw, which keeps growing a sequence of structures with
+  // strings or nested sequences from deep copying each of them.
   template <typename iter>
   inline static void copy_swap_range(
       value_type * begin, value_type * end, iter dst)
+  {
+    copy_swap_range(begin, end, dst,
+      std::is_nothrow_move_assignable<value_type>());
+  }
+
+  template <typename iter>
+  inline static void copy_swap_range(
+      value_type * begin, value_type * end, iter dst, std::true_type)
+  {
+    std::move(begin, end, dst);
+  }
+
+  template <typename iter>
+  inline static void copy_swap_range(
+      value_type * begin, value_type * end, iter dst, std::false_type)
   {
     copy_range(begin, end, dst);
   }
@@ -17,6 +17,8 @@
 
 #include "ace/OS_Memory.h"
 
+#include <utility>
+
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 # pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
@@ -36,6 +38,7 @@ public:
   TAO_Var_Base_T ();
   TAO_Var_Base_T (T *);
   TAO_Var_Base_T (const TAO_Var_Base_T<T> &);
+  TAO_Var_Base_T (TAO_Var_Base_T<T> &&) noexcept;
 
   ~TAO_Var_Base_T ();
 
@@ -70,12 +73,14 @@ public:
   TAO_Fixed_Var_T ();
   TAO_Fixed_Var_T (T *);
   TAO_Fixed_Var_T (const TAO_Fixed_Var_T<T> &);
+  TAO_Fixed_Var_T (TAO_Fixed_Var_T<T> &&) noexcept;
 
   // Fixed-size types only.
   TAO_Fixed_Var_T (const T &);
 
   TAO_Fixed_Var_T & operator= (T *);
   TAO_Fixed_Var_T & operator= (const TAO_Fixed_Var_T<T> &);
+  TAO_Fixed_Var_T & operator= (TAO_Fixed_Var_T<T> &&) noexcept;
 
   // Fixed-size types only.
   TAO_Fixed_Var_T & operator= (const T &);
@@ -105,9 +110,11 @@ public:
   TAO_Var_Var_T ();
   TAO_Var_Var_T (T *);
   TAO_Var_Var_T (const TAO_Var_Var_T<T> &);
+  TAO_Var_Var_T (TAO_Var_Var_T<T> &&) noexcept;
 
   TAO_Var_Var_T & operator= (T *);
   TAO_Var_Var_T & operator= (const TAO_Var_Var_T<T> &);
+  TAO_Var_Var_T & operator= (TAO_Var_Var_T<T> &&) noexcept;
 
   operator const T & () const;
   operator T & ();
@@ -13,6 +13,14 @@ TAO_Var_Base_T<T>::TAO_Var_Base_T (T * p)
   : ptr_ (p)
 {}
 
+template<typename T>
+ACE_INLINE
+TAO_Var_Base_T<T>::TAO_Var_Base_T (TAO_Var_Base_T<T> && p) noexcept
+  : ptr_ (p.ptr_)
+{
+  p.ptr_ = nullptr;
+}
+
 template<typename T>
 ACE_INLINE
 TAO_Var_Base_T<T>::~TAO_Var_Base_T ()
@@ -86,6 +94,12 @@ TAO_Fixed_Var_T<T>::TAO_Fixed_Var_T (const TAO_Fixed_Var_T<T> & p)
   : TAO_Var_Base_T<T> (p)
 {}
 
+template<typename T>
+ACE_INLINE
+TAO_Fixed_Var_T<T>::TAO_Fixed_Var_T (TAO_Fixed_Var_T<T> && p) noexcept
+  : TAO_Var_Base_T<T> (std::move (p))
+{}
+
 // Fixed-size types only.
 template<typename T>
 ACE_INLINE
@@ -105,6 +119,20 @@ TAO_Fixed_Var_T<T>::operator= (T * p)
   return *this;
 }
 
+template<typename T>
+ACE_INLINE
+TAO_Fixed_Var_T<T> &
+TAO_Fixed_Var_T<T>::operator= (TAO_Fixed_Var_T<T> && p) noexcept
+{
+  if (this != &p)
+    {
+      delete this->ptr_;
+      this->ptr_ = p.ptr_;
+      p.ptr_ = nullptr;
+    }
+  return *this;
+}
+
 template<typename T>
 ACE_INLINE
 TAO_Fixed_Var_T<T>::operator const T & () const
@@ -178,6 +206,12 @@ TAO_Var_Var_T<T>::TAO_Var_Var_T (const TAO_Var_Var_T<T> & p)
   : TAO_Var_Base_T<T> (p)
 {}
 
+template<typename T>
+ACE_INLINE
+TAO_Var_Var_T<T>::TAO_Var_Var_T (TAO_Var_Var_T<T> && p) noexcept
+  : TAO_Var_Base_T<T> (std::move (p))
+{}
+
 template<typename T>
 ACE_INLINE
 TAO_Var_Var_T<T> &
@@ -188,6 +222,20 @@ TAO_Var_Var_T<T>::operator= (T * p)
   return *this;
 }
 
+template<typename T>
+ACE_INLINE
+TAO_Var_Var_T<T> &
+TAO_Var_Var_T<T>::operator= (TAO_Var_Var_T<T> && p) noexcept
+{
+  if (this != &p)
+    {
+      delete this->ptr_;
+      this->ptr_ = p.ptr_;
+      p.ptr_ = nullptr;
+    }
+  return *this;
+}
+
 template<typename T>
 ACE_INLINE
 TAO_Var_Var_T<T>::operator const T & () const
@@ -4,6 +4,8 @@
 #include "tao/Transport.h"
 #include "tao/Synch_Reply_Dispatcher.h"
 #include "tao/ORB_Core.h"
+#include "tao/Transport_Profile.h"
+#include "ace/High_Res_Timer.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -49,6 +51,25 @@ TAO_Wait_On_Leader_Follower::wait (ACE_Time_Value *max_wait_time,
 {
   TAO_Leader_Follower &leader_follower =
     this->transport_->orb_core ()->leader_follower ();
+
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  TAO::Transport::Profile * const profile = this->transport_->profile ();
+  if (profile != nullptr)
+    {
+      ACE_Time_Value const start = ACE_High_Res_Timer::gettimeofday_hr ();
+
+      int const result =
+        leader_follower.wait_for_event (&rd, this->transport_, max_wait_time);
+
+      ACE_UINT64 usecs = 0;
+      (ACE_High_Res_Timer::gettimeofday_hr () - start).to_usec (usecs);
+      profile->sample (TAO::Transport::Profile::REPLY_WAIT_TIME, usecs);
+      profile->count (TAO::Transport::Profile::LEADER_FOLLOWER_WAITS);
+
+      return result;
+    }
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   return leader_follower.wait_for_event (&rd, this->transport_, max_wait_time);
 }
 
@@ -3,8 +3,10 @@
 #include "tao/Transport.h"
 #include "tao/Synch_Reply_Dispatcher.h"
 #include "tao/ORB_Time_Policy.h"
+#include "tao/Transport_Profile.h"
 
 #include "ace/Reactor.h"
+#include "ace/High_Res_Timer.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -28,6 +30,13 @@ TAO_Wait_On_Reactor::wait (ACE_Time_Value *max_wait_time,
   TAO_Leader_Follower &leader_follower =
     this->transport_->orb_core ()->leader_follower ();
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  TAO::Transport::Profile * const profile = this->transport_->profile ();
+  ACE_Time_Value const start = profile != nullptr
+    ? ACE_High_Res_Timer::gettimeofday_hr ()
+    : ACE_Time_Value::zero;
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   // Do the event loop, till we fully receive a reply.
   int result = 0;
 
@@ -65,6 +74,16 @@ TAO_Wait_On_Reactor::wait (ACE_Time_Value *max_wait_time,
       return -1;
     }
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  if (profile != nullptr)
+    {
+      ACE_UINT64 usecs = 0;
+      (ACE_High_Res_Timer::gettimeofday_hr () - start).to_usec (usecs);
+      profile->sample (TAO::Transport::Profile::REPLY_WAIT_TIME, usecs);
+      profile->count (TAO::Transport::Profile::REACTOR_WAITS);
+    }
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   // Return an error if there was a problem receiving the reply.
   if (max_wait_time != nullptr)
     {
@@ -5,16 +5,64 @@
 #include "tao/Client_Strategy_Factory.h"
 #include "tao/ORB_Core.h"
 #include "tao/ORB_Time_Policy.h"
+#include "tao/Transport_Profile.h"
 #include "ace/Reactor.h"
+#include "ace/High_Res_Timer.h"
+#include "ace/ACE.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 // Constructor.
 TAO_Wait_On_Read::TAO_Wait_On_Read (TAO_Transport *transport)
   : TAO_Wait_Strategy (transport)
+  , spin_max_ (transport->orb_core ()->client_factory ()->wait_spin_time ())
+  , spin_ (spin_max_)
 {
 }
 
+void
+TAO_Wait_On_Read::spin (ACE_Time_Value const &start,
+                        ACE_Time_Value const *max_wait_time)
+{
+  ACE_Time_Value window (0, this->spin_);
+  if (max_wait_time != nullptr && *max_wait_time < window)
+    window = *max_wait_time;
+
+  ACE_Event_Handler * const eh = this->transport_->event_handler_i ();
+  if (eh == nullptr)
+    return;
+
+  ACE_HANDLE const handle = eh->get_handle ();
+  ACE_Time_Value const deadline = start + window;
+
+  // A poll with a zero timeout does not put us to sleep.
+  while (ACE::handle_read_ready (handle, &ACE_Time_Value::zero) == 0
+         && ACE_High_Res_Timer::gettimeofday_hr () < deadline)
+    {
+    }
+}
+
+void
+TAO_Wait_On_Read::adapt_spin (ACE_UINT64 usecs)
+{
+  // Move a quarter of the way towards twice the reply time, or
+  // towards the smallest window if the reply took longer than we
+  // are ever going to spin.  Keeping a small window lets us notice
+  // when the replies get quick again.
+  ACE_UINT64 const floor = this->spin_max_ / 16 + 1;
+  ACE_UINT64 target = usecs * 2;
+  if (usecs > this->spin_max_)
+    target = floor;
+  else if (target > this->spin_max_)
+    target = this->spin_max_;
+
+  ACE_INT64 const spin = static_cast<ACE_INT64> (this->spin_);
+  ACE_INT64 const next =
+    spin + (static_cast<ACE_INT64> (target) - spin) / 4;
+  this->spin_ =
+    static_cast<ACE_UINT32> (next < static_cast<ACE_INT64> (floor) ? floor : next);
+}
+
 int
 TAO_Wait_On_Read::sending_request (TAO_ORB_Core *orb_core,
                                    TAO_Message_Semantics msg_semantics)
@@ -71,6 +119,21 @@ TAO_Wait_On_Read::wait (ACE_Time_Value * max_wait_time,
 
   rd.state_changed (TAO_LF_Event::LFS_ACTIVE, leader_follower);
 
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  TAO::Transport::Profile * const profile = this->transport_->profile ();
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
+  ACE_Time_Value start;
+  if (this->spin_max_ != 0)
+    {
+      start = ACE_High_Res_Timer::gettimeofday_hr ();
+      this->spin (start, max_wait_time);
+    }
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+  else if (profile != nullptr)
+    start = ACE_High_Res_Timer::gettimeofday_hr ();
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
   // Do the same sort of looping that is done in other wait
   // strategies.
   int retval = 0;
@@ -98,6 +161,23 @@ TAO_Wait_On_Read::wait (ACE_Time_Value * max_wait_time,
 
   if (rd.successful (leader_follower))
      {
+       if (this->spin_max_ != 0)
+         {
+           ACE_UINT64 usecs = 0;
+           (ACE_High_Res_Timer::gettimeofday_hr () - start).to_usec (usecs);
+           this->adapt_spin (usecs);
+         }
+
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+       if (profile != nullptr)
+         {
+           ACE_UINT64 usecs = 0;
+           (ACE_High_Res_Timer::gettimeofday_hr () - start).to_usec (usecs);
+           profile->sample (TAO::Transport::Profile::REPLY_WAIT_TIME, usecs);
+           profile->count (TAO::Transport::Profile::READ_WAITS);
+         }
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */
+
        TAO_ORB_Core * const oc =
          this->transport_->orb_core ();
 
@@ -23,6 +23,14 @@ TAO_BEGIN_VERSIONED_NAMESPACE_DECL
  * @class TAO_Wait_On_Read
  *
  * Simply block on read() to wait for the reply.
+ *
+ * If the client strategy factory gives a spin time, the connection
+ * is first polled for a reply for a while, saving the cost of putting
+ * the thread to sleep and waking it up again when the reply comes in
+ * quickly.  The time spent polling adapts to how long the replies on
+ * the connection take: it settles at about twice the usual reply
+ * time, bounded by the spin time, and shrinks when replies take
+ * longer than that.
  */
 class TAO_Wait_On_Read :  public TAO_Wait_Strategy
 {
@@ -50,6 +58,21 @@ public:
 
   /*! @copydoc TAO_Wait_Strategy::can_process_upcalls() */
   bool can_process_upcalls () const override;
+
+private:
+  /// Poll the connection until it is readable or the spin window,
+  /// bounded by @a max_wait_time, runs out.
+  void spin (ACE_Time_Value const &start,
+             ACE_Time_Value const *max_wait_time);
+
+  /// Adapt the spin window to a reply that took @a usecs.
+  void adapt_spin (ACE_UINT64 usecs);
+
+  /// Longest spin window, in microseconds, 0 if we do not poll.
+  ACE_UINT32 const spin_max_;
+
+  /// Current spin window, in microseconds.
+  ACE_UINT32 spin_;
 };
 
 TAO_END_VERSIONED_NAMESPACE_DECL
@@ -26,6 +26,8 @@ TAO_Default_Client_Strategy_Factory::TAO_Default_Client_Strategy_Factory ()
   , wait_strategy_ (TAO_WAIT_ON_LEADER_FOLLOWER)
   , connect_strategy_ (TAO_LEADER_FOLLOWER_CONNECT)
   , rd_table_size_ (TAO_RD_TABLE_SIZE)
+  , rd_slots_ (TAO_RD_SLOT_TABLE_SIZE)
+  , wait_spin_time_ (TAO_WAIT_SPIN_TIME)
   , muxed_strategy_lock_type_ (TAO_THREAD_LOCK)
   , use_cleanup_options_ (false)
   , sync_scope_ (Messaging::SYNC_WITH_TRANSPORT)
@@ -214,6 +216,36 @@ TAO_Default_Client_Strategy_Factory::parse_args (int argc, ACE_TCHAR* argv[])
               this->rd_table_size_ = ACE_OS::atoi (argv[curarg]);
             }
         }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT("-ORBReplyDispatcherSlots"))
+               == 0)
+        {
+          curarg++;
+          if (curarg < argc)
+            {
+              int const slots = ACE_OS::atoi (argv[curarg]);
+              if (slots < 0)
+                this->report_option_value_error (
+                  ACE_TEXT("-ORBReplyDispatcherSlots"), argv[curarg]);
+              else
+                this->rd_slots_ = slots;
+            }
+        }
+      else if (ACE_OS::strcasecmp (argv[curarg],
+                                   ACE_TEXT("-ORBWaitSpinTime"))
+               == 0)
+        {
+          curarg++;
+          if (curarg < argc)
+            {
+              int const usecs = ACE_OS::atoi (argv[curarg]);
+              if (usecs < 0)
+                this->report_option_value_error (
+                  ACE_TEXT("-ORBWaitSpinTime"), argv[curarg]);
+              else
+                this->wait_spin_time_ = usecs;
+            }
+        }
       else if (ACE_OS::strcmp (argv[curarg],
                                ACE_TEXT("-ORBConnectionHandlerCleanup")) == 0)
          {
@@ -423,6 +455,18 @@ TAO_Default_Client_Strategy_Factory::reply_dispatcher_table_size () const
   return this->rd_table_size_;
 }
 
+int
+TAO_Default_Client_Strategy_Factory::reply_dispatcher_slots () const
+{
+  return this->rd_slots_;
+}
+
+int
+TAO_Default_Client_Strategy_Factory::wait_spin_time () const
+{
+  return this->wait_spin_time_;
+}
+
 TAO_Wait_Strategy *
 TAO_Default_Client_Strategy_Factory::create_wait_strategy (
   TAO_Transport *transport)
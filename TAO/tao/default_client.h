@@ -54,6 +54,8 @@ public:
   virtual TAO_Transport_Mux_Strategy *create_transport_mux_strategy (TAO_Transport *transport);
   virtual ACE_Lock *create_transport_mux_strategy_lock ();
   virtual int reply_dispatcher_table_size () const;
+  virtual int reply_dispatcher_slots () const;
+  virtual int wait_spin_time () const;
   virtual int allow_callback ();
   virtual TAO_Wait_Strategy *create_wait_strategy (TAO_Transport *transport);
   virtual TAO_Connect_Strategy *create_connect_strategy (TAO_ORB_Core *);
@@ -99,6 +101,13 @@ private:
   /// Size of the reply dispatcher table
   int rd_table_size_;
 
+  /// Number of slots of the reply dispatcher slot table
+  int rd_slots_;
+
+  /// Longest time the RW wait strategy polls for a reply, in
+  /// microseconds
+  int wait_spin_time_;
+
   /// Type of lock for the muxed_strategy
   Lock_Type muxed_strategy_lock_type_;
 
@@ -24,10 +24,12 @@
 #include "ace/Reactor.h"
 #include "ace/Malloc_T.h"
 #include "ace/Local_Memory_Pool.h"
+#include "ace/Slab_Allocator.h"
 #include "ace/OS_NS_string.h"
 #include "ace/OS_NS_strings.h"
 
 #include <memory>
+#include <atomic>
 
 #if !defined (__ACE_INLINE__)
 #include "tao/default_resource.inl"
@@ -35,6 +37,84 @@
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+/**
+ * The slab allocator of a resource factory.  The factory and each
+ * allocator that serves its requests from it hold a reference; the
+ * last of them to go deletes it, as the ORB core releases its CDR
+ * blocks after the factory is gone.
+ */
+class TAO_Shared_Slab_Allocator : public ACE_Slab_Allocator
+{
+public:
+  TAO_Shared_Slab_Allocator ()
+    : refcount_ (1)
+  {
+  }
+
+  void add_ref ()
+  {
+    ++this->refcount_;
+  }
+
+  void remove_ref ()
+  {
+    if (--this->refcount_ == 0)
+      delete this;
+  }
+
+private:
+  std::atomic<unsigned long> refcount_;
+};
+
+namespace
+{
+  /**
+   * Serves the requests of one of the CDR allocators from the slab
+   * allocator of the resource factory.  The thread lane resources
+   * delete the allocators they get, so each of them gets one of these
+   * rather than the shared allocator itself.
+   */
+  class Slab_Allocator_Ref : public ACE_New_Allocator
+  {
+  public:
+    explicit Slab_Allocator_Ref (TAO_Shared_Slab_Allocator &slab)
+      : slab_ (slab)
+    {
+      this->slab_.add_ref ();
+    }
+
+    ~Slab_Allocator_Ref () override
+    {
+      this->slab_.remove_ref ();
+    }
+
+    void *malloc (size_t nbytes) override
+    {
+      return this->slab_.malloc (nbytes);
+    }
+
+    void *calloc (size_t nbytes, char initial_value = '\0') override
+    {
+      return this->slab_.calloc (nbytes, initial_value);
+    }
+
+    void *calloc (size_t n_elem,
+                  size_t elem_size,
+                  char initial_value = '\0') override
+    {
+      return this->slab_.calloc (n_elem, elem_size, initial_value);
+    }
+
+    void free (void *ptr) override
+    {
+      this->slab_.free (ptr);
+    }
+
+  private:
+    TAO_Shared_Slab_Allocator &slab_;
+  };
+}
+
 
 TAO_Codeset_Parameters::TAO_Codeset_Parameters ()
   : translators_ ()
@@ -124,6 +204,12 @@ TAO_Default_Resource_Factory::TAO_Default_Resource_Factory ()
 #else
   , use_local_memory_pool_ (false)
 #endif
+#if TAO_USE_SLAB_ALLOCATOR == 1
+  , use_slab_allocator_ (true)
+#else
+  , use_slab_allocator_ (false)
+#endif
+  , slab_allocator_ (nullptr)
   , cached_connection_lock_type_ (TAO_THREAD_LOCK)
 #if defined (TAO_USE_BLOCKING_FLUSHING)
   , flushing_strategy_type_ (TAO_BLOCKING_FLUSHING)
@@ -163,6 +249,9 @@ TAO_Default_Resource_Factory::~TAO_Default_Resource_Factory ()
     CORBA::string_free (this->parser_names_[i]);
 
   delete [] this->parser_names_;
+
+  if (this->slab_allocator_ != nullptr)
+    this->slab_allocator_->remove_ref ();
 }
 
 
@@ -474,6 +563,23 @@ TAO_Default_Resource_Factory::init (int argc, ACE_TCHAR *argv[])
               }
           }
       }
+    else if (0 == ACE_OS::strcasecmp (argv[curarg],
+                                      ACE_TEXT("-ORBSlabAllocator")))
+      {
+        ++curarg;
+        if (curarg < argc)
+          {
+            int const tmp = ACE_OS::atoi (argv[curarg]);
+
+            if (tmp == 0)
+              this->use_slab_allocator_ = false;
+            else
+              this->use_slab_allocator_ = true;
+          }
+        else
+          this->report_option_value_error (ACE_TEXT("-ORBSlabAllocator"),
+                                           argv[curarg]);
+      }
     else if (0 == ACE_OS::strcasecmp (argv[curarg],
                                       ACE_TEXT("-ORBZeroCopyWrite")))
       {
@@ -809,6 +915,31 @@ TAO_Default_Resource_Factory::reclaim_reactor (ACE_Reactor *reactor)
 }
 
 
+ACE_Allocator *
+TAO_Default_Resource_Factory::slab_allocator ()
+{
+  {
+    ACE_GUARD_RETURN (TAO_SYNCH_MUTEX,
+                      ace_mon,
+                      this->slab_allocator_lock_,
+                      nullptr);
+
+    if (this->slab_allocator_ == nullptr)
+      {
+        ACE_NEW_RETURN (this->slab_allocator_,
+                        TAO_Shared_Slab_Allocator,
+                        nullptr);
+      }
+  }
+
+  ACE_Allocator *allocator = nullptr;
+  ACE_NEW_RETURN (allocator,
+                  Slab_Allocator_Ref (*this->slab_allocator_),
+                  nullptr);
+
+  return allocator;
+}
+
 typedef ACE_Malloc<ACE_LOCAL_MEMORY_POOL,TAO_SYNCH_MUTEX> LOCKED_MALLOC;
 typedef ACE_Allocator_Adapter<LOCKED_MALLOC> LOCKED_ALLOCATOR_POOL;
 typedef ACE_New_Allocator LOCKED_ALLOCATOR_NO_POOL;
@@ -826,7 +957,11 @@ ACE_Allocator *
 TAO_Default_Resource_Factory::input_cdr_dblock_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->use_slab_allocator_)
+  {
+    allocator = this->slab_allocator ();
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -846,7 +981,11 @@ ACE_Allocator *
 TAO_Default_Resource_Factory::input_cdr_buffer_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->use_slab_allocator_)
+  {
+    allocator = this->slab_allocator ();
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -866,7 +1005,11 @@ ACE_Allocator *
 TAO_Default_Resource_Factory::input_cdr_msgblock_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->use_slab_allocator_)
+  {
+    allocator = this->slab_allocator ();
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -892,7 +1035,11 @@ ACE_Allocator*
 TAO_Default_Resource_Factory::output_cdr_dblock_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->use_slab_allocator_)
+  {
+    allocator = this->slab_allocator ();
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
@@ -916,9 +1063,16 @@ TAO_Default_Resource_Factory::output_cdr_buffer_allocator ()
   switch (this->output_cdr_allocator_type_)
     {
     case LOCAL_MEMORY_POOL:
-      ACE_NEW_RETURN (allocator,
-                      LOCKED_ALLOCATOR_POOL,
-                      nullptr);
+      if (this->use_slab_allocator_)
+        {
+          allocator = this->slab_allocator ();
+        }
+      else
+        {
+          ACE_NEW_RETURN (allocator,
+                          LOCKED_ALLOCATOR_POOL,
+                          nullptr);
+        }
 
       break;
 
@@ -933,9 +1087,16 @@ TAO_Default_Resource_Factory::output_cdr_buffer_allocator ()
 
     case DEFAULT:
     default:
-      ACE_NEW_RETURN (allocator,
-                      LOCKED_ALLOCATOR_NO_POOL,
-                      nullptr);
+      if (this->use_slab_allocator_)
+        {
+          allocator = this->slab_allocator ();
+        }
+      else
+        {
+          ACE_NEW_RETURN (allocator,
+                          LOCKED_ALLOCATOR_NO_POOL,
+                          nullptr);
+        }
 
       break;
     }
@@ -947,7 +1108,11 @@ ACE_Allocator*
 TAO_Default_Resource_Factory::output_cdr_msgblock_allocator ()
 {
   ACE_Allocator *allocator = nullptr;
-  if (use_local_memory_pool_)
+  if (this->use_slab_allocator_)
+  {
+    allocator = this->slab_allocator ();
+  }
+  else if (use_local_memory_pool_)
   {
     ACE_NEW_RETURN (allocator,
                     LOCKED_ALLOCATOR_POOL,
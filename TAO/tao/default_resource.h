@@ -27,9 +27,12 @@ class ACE_Reactor_Impl;
 ACE_END_VERSIONED_NAMESPACE_DECL
 
 #include "ace/Timer_Queuefwd.h"
+#include "ace/Thread_Mutex.h"
 
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
+class TAO_Shared_Slab_Allocator;
+
 class TAO_Object_Adapter;
 class TAO_IOR_Parser;
 class TAO_LF_Strategy;
@@ -206,6 +209,10 @@ protected:
   void report_option_value_error (const ACE_TCHAR* option_name,
                                   const ACE_TCHAR* option_value);
 
+  /// Return a new allocator that serves its requests from the slab
+  /// allocator of this factory, creating that on first use.
+  ACE_Allocator *slab_allocator ();
+
 protected:
   /// The type of data blocks that the ORB should use
   int use_locked_data_blocks_;
@@ -283,6 +290,20 @@ protected:
   /// should use the local memory pool or not.
   bool use_local_memory_pool_;
 
+  /// This flag is used to determine whether the CDR allocators
+  /// should be slab allocators with per-thread caches, which takes
+  /// precedence over the local memory pool.
+  bool use_slab_allocator_;
+
+  /// The slab allocator shared by all the CDR allocators this factory
+  /// creates, so that the blocks of every kind come from one set of
+  /// size classes and one cache per thread.  It is reference counted,
+  /// as the allocators handed out may outlive this factory.
+  TAO_Shared_Slab_Allocator *slab_allocator_;
+
+  /// Protects the creation of slab_allocator_.
+  TAO_SYNCH_MUTEX slab_allocator_lock_;
+
 private:
   enum Lock_Type
   {
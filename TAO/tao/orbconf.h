@@ -105,6 +105,20 @@ const size_t TAO_DEFAULT_ADAPTER_REGISTRY_SIZE = 16;
 const size_t TAO_RD_TABLE_SIZE = 16;
 #endif  /* !TAO_RD_TABLE_SIZE */
 
+// The default number of slots of the request id indexed table a
+// muxed transport keeps its reply dispatchers in before it falls
+// back to the reply dispatcher table.  Zero disables the slot table.
+#if !defined (TAO_RD_SLOT_TABLE_SIZE)
+const size_t TAO_RD_SLOT_TABLE_SIZE = 1024;
+#endif  /* !TAO_RD_SLOT_TABLE_SIZE */
+
+// The default longest time, in microseconds, the RW wait strategy
+// busy-polls a connection for a reply before blocking in read().
+// Zero disables polling.
+#if !defined (TAO_WAIT_SPIN_TIME)
+const int TAO_WAIT_SPIN_TIME = 0;
+#endif  /* !TAO_WAIT_SPIN_TIME */
+
 // The default size of TAO's policy factory registry, i.e. the map
 // used as the underlying implementation for the
 // PortableInterceptor::ORBInitInfo::register_policy_factory() method.
@@ -171,6 +185,12 @@ const size_t TAO_DEFAULT_VALUE_FACTORY_TABLE_SIZE = 128;
 #define TAO_MAXBUFSIZE 1024
 #endif /* TAO_MAXBUFSIZE */
 
+// The largest block the fragments of a message are gathered in before
+// the message is consolidated.
+#if !defined (TAO_FRAGMENT_BLOCK_MAX)
+#define TAO_FRAGMENT_BLOCK_MAX (64 * 1024 * 1024)
+#endif /* TAO_FRAGMENT_BLOCK_MAX */
+
 #if !defined (TAO_CONNECTION_PURGING_STRATEGY)
 # define TAO_CONNECTION_PURGING_STRATEGY TAO_Resource_Factory::LRU
 #endif /* TAO_CONNECTION_PURGING_STRATEGY */
@@ -816,6 +836,12 @@ enum TAO_Policy_Scope
 #  define TAO_USE_LOCAL_MEMORY_POOL 1
 #endif /* TAO_USE_LOCAL_MEMORY_POOL */
 
+/// Use ACE_Slab_Allocator for the CDR buffers, data blocks and message
+/// blocks unless -ORBSlabAllocator says otherwise.
+#if !defined (TAO_USE_SLAB_ALLOCATOR)
+#  define TAO_USE_SLAB_ALLOCATOR 0
+#endif /* TAO_USE_SLAB_ALLOCATOR */
+
 #if !defined (TAO_USE_OUTPUT_CDR_MMAP_MEMORY_POOL)
 #  define TAO_USE_OUTPUT_CDR_MMAP_MEMORY_POOL 0
 #endif /* TAO_USE_LOCAL_MEMORY_POOL */
@@ -825,6 +851,11 @@ enum TAO_Policy_Scope
 #    define TAO_HAS_TRANSPORT_CURRENT 1
 #endif  /* ! TAO_HAS_TRANSPORT_CURRENT */
 
+/// Support the -ORBTransportProfile option by default
+#if !defined (TAO_HAS_TRANSPORT_PROFILE)
+#    define TAO_HAS_TRANSPORT_PROFILE 1
+#endif  /* ! TAO_HAS_TRANSPORT_PROFILE */
+
 #if !defined (TAO_HAS_DDL_PARSER)
 # define TAO_HAS_DDL_PARSER 1
 #endif
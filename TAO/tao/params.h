@@ -124,6 +124,16 @@ public:
   void max_message_size (ACE_CDR::ULong size);
   //@}
 
+  /**
+   * File the profile of the transports is written to when the ORB is
+   * destroyed, set with -ORBTransportProfile.  The transports are only
+   * profiled when it is set.
+   */
+  //@{
+  const char *transport_profile () const;
+  void transport_profile (const char *file);
+  //@}
+
   /// The ORB will use the dotted decimal notation for addresses. By
   /// default we use the full ascii names.
   int use_dotted_decimal_addresses () const;
@@ -348,6 +358,10 @@ private:
    */
   ACE_CDR::ULong max_message_size_;
 
+  /// File the transport profile is written to, empty if the
+  /// transports are not profiled.
+  CORBA::String_var transport_profile_;
+
   /// For selecting a address notation
   int use_dotted_decimal_addresses_;
 
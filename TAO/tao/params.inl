@@ -49,6 +49,18 @@ TAO_ORB_Parameters::max_message_size (ACE_CDR::ULong size)
   this->max_message_size_ = size;
 }
 
+ACE_INLINE const char *
+TAO_ORB_Parameters::transport_profile () const
+{
+  return this->transport_profile_.in ();
+}
+
+ACE_INLINE void
+TAO_ORB_Parameters::transport_profile (const char *file)
+{
+  this->transport_profile_ = CORBA::string_dup (file);
+}
+
 ACE_INLINE int
 TAO_ORB_Parameters::use_dotted_decimal_addresses () const
 {
@@ -14,6 +14,7 @@
 #include "test_macros.h"
 
 #include <sstream>
+#include <utility>
 
 template<typename charT>
 struct string_sequence_test_helpers
@@ -318,6 +319,82 @@ struct string_sequence_tester
     return 0;
   }
 
+  int test_move_constructor_values()
+  {
+    tested_sequence a;
+    a.length(16);
+    for(CORBA::ULong i = 0; i != 16; ++i)
+    {
+      a[i] = helper::to_string(i);
+    }
+    value_type const * buffer = a.get_buffer();
+
+    expected_calls d(tested_element_traits::duplicate_calls);
+    expected_calls r(tested_element_traits::release_calls);
+    expected_calls c(tested_allocation_traits::allocbuf_calls);
+
+    CORBA::ULong max = 0;
+    {
+      tested_sequence b(std::move(a));
+      // The strings change hands with the buffer, none is duplicated.
+      FAIL_RETURN_IF_NOT(d.expect(0), d);
+      FAIL_RETURN_IF_NOT(c.expect(0), c);
+      max = b.maximum();
+
+      CHECK_EQUAL(buffer, b.get_buffer());
+      CHECK_EQUAL(CORBA::ULong(16), b.length());
+      CHECK_EQUAL(CORBA::ULong(0), a.length());
+      for(CORBA::ULong i = 0; i != b.length(); ++i)
+      {
+        FAIL_RETURN_IF_NOT(helper::compare(i, b[i]),
+            "Mismatched elements at index=" << i);
+      }
+      FAIL_RETURN_IF_NOT(r.expect(0), r);
+    }
+    FAIL_RETURN_IF_NOT(r.expect(max), r);
+    return 0;
+  }
+
+  int test_move_assignment_values()
+  {
+    tested_sequence a;
+    a.length(16);
+    for(CORBA::ULong i = 0; i != 16; ++i)
+    {
+      a[i] = helper::to_string(i);
+    }
+    value_type const * buffer = a.get_buffer();
+
+    {
+      tested_sequence b;
+      b.length(4);
+      CORBA::ULong const old_max = b.maximum();
+
+      expected_calls d(tested_element_traits::duplicate_calls);
+      expected_calls r(tested_element_traits::release_calls);
+      b = std::move(a);
+      FAIL_RETURN_IF_NOT(d.expect(0), d);
+      // Only the strings b held before are released.
+      FAIL_RETURN_IF_NOT(r.expect(old_max), r);
+
+      CHECK_EQUAL(buffer, b.get_buffer());
+      CHECK_EQUAL(CORBA::ULong(16), b.length());
+      CHECK_EQUAL(CORBA::ULong(0), a.length());
+      for(CORBA::ULong i = 0; i != b.length(); ++i)
+      {
+        FAIL_RETURN_IF_NOT(helper::compare(i, b[i]),
+            "Mismatched elements at index=" << i);
+      }
+    }
+    expected_calls r(tested_element_traits::release_calls);
+    {
+      tested_sequence b(std::move(a));
+    }
+    // Nothing is left in the moved-from sequence.
+    FAIL_RETURN_IF_NOT(r.expect(0), r);
+    return 0;
+  }
+
   int test_exception_in_copy_constructor()
   {
     expected_calls f(tested_allocation_traits::freebuf_calls);
@@ -461,6 +538,8 @@ struct string_sequence_tester
   status += this->test_freebuf_releases_elements();
   status += this->test_assignment_from_default();
   status += this->test_assignment_values();
+  status += this->test_move_constructor_values();
+  status += this->test_move_assignment_values();
   status += this->test_exception_in_copy_constructor();
   status += this->test_exception_in_assignment();
   status += this->test_duplicate_exception_in_copy_constructor();
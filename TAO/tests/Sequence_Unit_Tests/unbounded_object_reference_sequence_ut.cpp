@@ -16,6 +16,8 @@
 
 #include "test_macros.h"
 
+#include <utility>
+
 
 using namespace TAO_VERSIONED_NAMESPACE_NAME::TAO;
 
@@ -192,6 +194,67 @@ struct Tester
     return 0;
   }
 
+  int test_move_constructor()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    expected_calls d(mock_reference::duplicate_calls);
+    expected_calls r(mock_reference::release_calls);
+    CORBA::ULong const l = 16;
+    {
+      tested_sequence x(l);
+      x.length(l);
+      for(CORBA::ULong i = 0; i != l; ++i)
+      {
+        x[i] = mock_reference::allocate(i);
+      }
+      value_type const * buffer = x.get_buffer();
+
+      a.reset(); d.reset(); r.reset();
+
+      tested_sequence y(std::move(x));
+      FAIL_RETURN_IF_NOT(a.expect(0), a);
+      FAIL_RETURN_IF_NOT(d.expect(0), d);
+      FAIL_RETURN_IF_NOT(r.expect(0), r);
+      CHECK_EQUAL(buffer, y.get_buffer());
+      CHECK_EQUAL(l, y.length());
+      CHECK_EQUAL(CORBA::ULong(0), x.length());
+      for(CORBA::ULong i = 0; i != l; ++i)
+      {
+        CHECK_EQUAL(int(i), y[i]->id());
+      }
+
+      tested_sequence z;
+      z = std::move(y);
+      FAIL_RETURN_IF_NOT(a.expect(0), a);
+      FAIL_RETURN_IF_NOT(d.expect(0), d);
+      CHECK_EQUAL(buffer, z.get_buffer());
+      CHECK_EQUAL(CORBA::ULong(0), y.length());
+    }
+    FAIL_RETURN_IF_NOT(r.expect(l), r);
+    FAIL_RETURN_IF_NOT(f.expect(1), f);
+    return 0;
+  }
+
+  int test_set_length_release_false_keeps_elements()
+  {
+    value_type * buffer = alloc_and_init_buffer();
+    expected_calls d(mock_reference::duplicate_calls);
+    {
+      tested_sequence x(8, 4, buffer, false);
+      x.length(16);
+      CHECK(buffer != x.get_buffer());
+      CHECK_EQUAL(true, x.release());
+      FAIL_RETURN_IF(check_values(x) != 0);
+      // The caller still owns the old buffer, so its references are
+      // duplicated rather than taken over.
+      FAIL_RETURN_IF_NOT(d.expect(4), d);
+    }
+    tested_sequence y(8, 4, buffer, true);
+    FAIL_RETURN_IF(check_values(y) != 0);
+    return 0;
+  }
+
   int test_copy_constructor_throw_duplicate()
   {
     expected_calls a(tested_allocation_traits::allocbuf_calls);
@@ -472,11 +535,13 @@ struct Tester
     status += this->test_buffer_constructor_release_false();
     status += this->test_copy_constructor_from_default();
     status += this->test_copy_constructor();
+    status += this->test_move_constructor();
     status += this->test_copy_constructor_throw_duplicate();
     status += this->test_set_length_less_than_maximum();
     status += this->test_set_length_more_than_maximum();
     status += this->test_set_length_copy_elements();
     status += this->test_set_length_throw();
+    status += this->test_set_length_release_false_keeps_elements();
     status += this->test_replace_release_true();
     status += this->test_replace_release_false();
     status += this->test_replace_release_default();
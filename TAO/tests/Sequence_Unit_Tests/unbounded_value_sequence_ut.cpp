@@ -23,6 +23,34 @@ typedef tested_sequence::element_traits tested_element_traits;
 typedef tested_sequence::allocation_traits tested_allocation_traits;
 typedef details::range_checking<int,true> range;
 
+/// Counts how the elements are carried over when a sequence grows.
+template<bool nothrow_move>
+struct counted_value
+{
+  counted_value() : value(0) {}
+  counted_value(counted_value const & rhs) : value(rhs.value) {}
+  counted_value & operator=(counted_value const & rhs)
+  {
+    value = rhs.value;
+    ++copies;
+    return *this;
+  }
+  counted_value & operator=(counted_value && rhs) noexcept(nothrow_move)
+  {
+    value = rhs.value;
+    rhs.value = -1;
+    ++moves;
+    return *this;
+  }
+
+  int value;
+  static int copies;
+  static int moves;
+};
+
+template<bool nothrow_move> int counted_value<nothrow_move>::copies = 0;
+template<bool nothrow_move> int counted_value<nothrow_move>::moves = 0;
+
 struct Tester
 {
   typedef tested_sequence::value_type value_type;
@@ -388,6 +416,42 @@ struct Tester
     return 0;
   }
 
+  /// Growing the buffer moves the old elements into the new one when
+  /// that cannot throw, and copies them otherwise.
+  template<bool nothrow_move>
+  int check_grow_elements()
+  {
+    typedef counted_value<nothrow_move> element;
+    unbounded_value_sequence<element> x(4);
+    x.length(4);
+    for(CORBA::ULong i = 0; i != 4; ++i) x[i].value = int(i + 1);
+
+    element::copies = 0;
+    element::moves = 0;
+    x.length(8);
+
+    CHECK_EQUAL(CORBA::ULong(8), x.length());
+    CHECK_EQUAL(nothrow_move ? 4 : 0, element::moves);
+    // The new elements are always initialized by copy.
+    CHECK_EQUAL(nothrow_move ? 4 : 8, element::copies);
+    for(CORBA::ULong i = 0; i != 4; ++i)
+    {
+      FAIL_RETURN_IF_NOT(x[i].value == int(i + 1),
+          "Mismatched elements at index " << i);
+    }
+    return 0;
+  }
+
+  int test_grow_moves_elements()
+  {
+    return check_grow_elements<true>();
+  }
+
+  int test_grow_copies_elements()
+  {
+    return check_grow_elements<false>();
+  }
+
   int test_all()
   {
     int status = 0;
@@ -408,6 +472,8 @@ struct Tester
     status += this->test_get_buffer_false();
     status += this->test_get_buffer_true_with_release_false();
     status += this->test_get_buffer_true_with_release_true();
+    status += this->test_grow_moves_elements();
+    status += this->test_grow_copies_elements();
     return status;
   }
   Tester() {}
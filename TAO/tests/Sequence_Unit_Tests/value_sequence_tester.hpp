@@ -12,6 +12,8 @@
 #include "test_macros.h"
 #include "tao/SystemException.h"
 
+#include <utility>
+
 TAO_BEGIN_VERSIONED_NAMESPACE_DECL
 
 template<class tested_sequence,
@@ -177,6 +179,70 @@ struct value_sequence_tester
     return 0;
   }
 
+  int test_move_constructor_values()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    {
+      tested_sequence x;
+      x.length(16);
+      for(CORBA::ULong i = 0; i != 16; ++i) x[i] = i*i;
+      value_type const * buffer = x.get_buffer();
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+
+      tested_sequence y(std::move(x));
+      // The buffer changes hands, nothing is allocated or copied.
+      FAIL_RETURN_IF_NOT(a.expect(0), a);
+      CHECK_EQUAL(buffer, y.get_buffer());
+      CHECK_EQUAL(CORBA::ULong(16), y.length());
+      CHECK_EQUAL(true, y.release());
+      for(CORBA::ULong i = 0; i != 16; ++i)
+      {
+        FAIL_RETURN_IF_NOT(y[i] == value_type(i*i),
+            "Mismatched elements at index " << i);
+      }
+      CHECK_EQUAL(CORBA::ULong(0), x.length());
+      CHECK_EQUAL(false, x.release());
+
+      // The moved-from sequence can be used again.
+      x.length(4);
+      FAIL_RETURN_IF_NOT(a.expect(1), a);
+    }
+    FAIL_RETURN_IF_NOT(f.expect(2), f);
+    return 0;
+  }
+
+  int test_move_assignment_values()
+  {
+    expected_calls a(tested_allocation_traits::allocbuf_calls);
+    expected_calls f(tested_allocation_traits::freebuf_calls);
+    {
+      tested_sequence x;
+      x.length(16);
+      for(CORBA::ULong i = 0; i != 16; ++i) x[i] = i*i;
+      value_type const * buffer = x.get_buffer();
+
+      tested_sequence y;
+      y.length(3);
+      FAIL_RETURN_IF_NOT(a.expect(2), a);
+
+      y = std::move(x);
+      // The old buffer of y is released, nothing is allocated.
+      FAIL_RETURN_IF_NOT(a.expect(0), a);
+      FAIL_RETURN_IF_NOT(f.expect(1), f);
+      CHECK_EQUAL(buffer, y.get_buffer());
+      CHECK_EQUAL(CORBA::ULong(16), y.length());
+      for(CORBA::ULong i = 0; i != 16; ++i)
+      {
+        FAIL_RETURN_IF_NOT(y[i] == value_type(i*i),
+            "Mismatched elements at index " << i);
+      }
+      CHECK_EQUAL(CORBA::ULong(0), x.length());
+    }
+    FAIL_RETURN_IF_NOT(f.expect(1), f);
+    return 0;
+  }
+
   int test_exception_in_copy_constructor()
   {
     expected_calls f(tested_allocation_traits::freebuf_calls);
@@ -242,6 +308,8 @@ struct value_sequence_tester
     status +=this->test_copy_constructor_values();
     status +=this->test_assignment_from_default();
     status +=this->test_assignment_values();
+    status +=this->test_move_constructor_values();
+    status +=this->test_move_assignment_values();
     status +=this->test_exception_in_copy_constructor();
     status +=this->test_exception_in_assignment();
     status +=this->test_get_buffer_const();
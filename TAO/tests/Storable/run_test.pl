@@ -69,34 +69,50 @@ if ($#ARGV >= 0) {
     }
 }
 
-$T1 = $test1->CreateProcess ("test", "-i 0 -n $num_loops");
+sub test_two_processes($)
+{
+    my $options = shift;
 
-my $test2 = PerlACE::TestTarget::create_target (2) || die "Create target 1 failed\n";
+    my $status = 0;
 
-$T2 = $test2->CreateProcess ("test", "-i 1 -n $num_loops -s $loop_sleep_msec");
+    my $T1 = $test1->CreateProcess ("test", "$options -i 0 -n $num_loops");
 
-$test1_status = $T1->Spawn ();
+    my $test2 = PerlACE::TestTarget::create_target (2) || die "Create target 2 failed\n";
 
-if ($test1_status != 0) {
-    print STDERR "ERROR: test 1 returned $test1_status\n";
-    $status = 1;
-}
+    my $T2 = $test2->CreateProcess ("test", "$options -i 1 -n $num_loops -s $loop_sleep_msec");
 
-$test2_status = $T2->SpawnWaitKill ($test2->ProcessStartWaitInterval());
+    my $test1_status = $T1->Spawn ();
 
-if ($test2_status != 0) {
-    print STDERR "ERROR: test 2 returned $test2_status\n";
-    $status = 1;
-}
+    if ($test1_status != 0) {
+        print STDERR "ERROR: test 1 $options returned $test1_status\n";
+        $status = 1;
+    }
+
+    my $test2_status = $T2->SpawnWaitKill ($test2->ProcessStartWaitInterval());
+
+    if ($test2_status != 0) {
+        print STDERR "ERROR: test 2 $options returned $test2_status\n";
+        $status = 1;
+    }
 
-$test1_status = $T1->WaitKill ($test1->ProcessStopWaitInterval());
+    $test1_status = $T1->WaitKill ($test1->ProcessStopWaitInterval());
 
-if ($test1_status != 0) {
-    print STDERR "ERROR: test 1 returned $test1_status\n";
-    $status = 1;
+    if ($test1_status != 0) {
+        print STDERR "ERROR: test 1 $options returned $test1_status\n";
+        $status = 1;
+    }
+
+    $test1->DeleteFile ($persistent_file);
+    $test1->DeleteFile ("$persistent_file.ckpt");
+    return $status;
 }
 
-$test1->DeleteFile ($persistent_file);
+# Flat files, then journals.
+foreach $options ("", "-j") {
+    if (test_two_processes ($options) != 0) {
+        $status = 1;
+    }
+}
 
 sub test_backup_recovery($)
 {
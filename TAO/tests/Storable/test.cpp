@@ -12,12 +12,14 @@
 #include "Savable.h"
 
 #include "tao/Storable_FlatFileStream.h"
+#include "tao/Storable_JournalStream.h"
 #include "tao/SystemException.h"
 
 #include "ace/Get_Opt.h"
 #include "ace/OS_NS_unistd.h"
 
 #include <iostream>
+#include <memory>
 
 const ACE_TCHAR *persistence_file = ACE_TEXT("test.dat");
 
@@ -25,11 +27,12 @@ int num_loops = 1;
 int sleep_msecs = 100;
 int write_index = 0;
 bool use_backup = false;
+bool use_journal = false;
 
 int
 parse_args (int argc, ACE_TCHAR *argv[])
 {
-  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:s:i:b"));
+  ACE_Get_Opt get_opts (argc, argv, ACE_TEXT("n:s:i:bj"));
   int c;
 
   while ((c = get_opts ()) != -1)
@@ -51,6 +54,10 @@ parse_args (int argc, ACE_TCHAR *argv[])
         use_backup = true;
         break;
 
+      case 'j':
+        use_journal = true;
+        break;
+
       case '?':
       default:
         ACE_ERROR_RETURN ((LM_ERROR,
@@ -59,6 +66,7 @@ parse_args (int argc, ACE_TCHAR *argv[])
                            ACE_TEXT("-s <milliseconds-to-sleep-in-loop> ")
                            ACE_TEXT("-i <index-used-for-writing> ")
                            ACE_TEXT("-b (use backup) ")
+                           ACE_TEXT("-j (use a journal) ")
                            ACE_TEXT("\n"),
                            argv [0]),
                           -1);
@@ -88,7 +96,12 @@ ACE_TMAIN(int argc, ACE_TCHAR *argv[])
 
   TAO::Storable_Base::use_backup_default = use_backup;
 
-  TAO::Storable_FlatFileFactory factory ("./");
+  std::unique_ptr<TAO::Storable_Factory> factory_holder;
+  if (use_journal)
+    factory_holder.reset (new TAO::Storable_JournalFactory ("./"));
+  else
+    factory_holder.reset (new TAO::Storable_FlatFileFactory ("./"));
+  TAO::Storable_Factory & factory = *factory_holder;
 
   ACE_CString str_write_value = "test_string";
   int int_write_value = -100;
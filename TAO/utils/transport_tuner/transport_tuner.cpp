@@ -0,0 +1,303 @@
+//=============================================================================
+/**
+ *  @file   transport_tuner.cpp
+ *
+ * Reads the transport profiles written by ORBs started with
+ * -ORBTransportProfile, prints what the transports did and suggests
+ * the ORB options that suit that traffic.
+ */
+//=============================================================================
+
+#include "tao/Transport_Profile.h"
+#include "ace/HDR_Histogram.h"
+#include "ace/Get_Opt.h"
+#include "ace/OS_NS_stdio.h"
+#include "ace/OS_NS_stdlib.h"
+#include "ace/Log_Msg.h"
+
+#if TAO_HAS_TRANSPORT_PROFILE == 1
+
+namespace
+{
+  typedef TAO::Transport::Profile Profile;
+  typedef ACE_HDR_Histogram Histogram;
+
+  /// Socket buffers are not worth shrinking below this, nor growing
+  /// beyond the limit most kernels allow without tuning.
+  ACE_UINT64 const min_socket_buffer = 64 * 1024;
+  ACE_UINT64 const max_socket_buffer = 4 * 1024 * 1024;
+
+  /// Messages this large are worth fragmenting, so the replies of
+  /// other requests are not stuck behind them.
+  ACE_UINT64 const large_message = 1024 * 1024;
+
+  /// Replies that usually come back quicker than this, in
+  /// microseconds, are worth polling for.
+  ACE_UINT64 const quick_reply = 100;
+
+  /// Formats a 64-bit value for printing with %s.
+  class Number
+  {
+  public:
+    explicit Number (ACE_UINT64 value)
+    {
+      ACE_OS::sprintf (this->text_, ACE_UINT64_FORMAT_SPECIFIER_ASCII, value);
+    }
+
+    char const *c_str () const
+    {
+      return this->text_;
+    }
+
+  private:
+    char text_[32];
+  };
+
+  ACE_UINT64
+  round_up (ACE_UINT64 value)
+  {
+    ACE_UINT64 n = 1;
+    while (n < value && n < max_socket_buffer)
+      n <<= 1;
+    return n;
+  }
+
+  ACE_UINT64
+  clamp (ACE_UINT64 value)
+  {
+    if (value < min_socket_buffer)
+      return min_socket_buffer;
+    if (value > max_socket_buffer)
+      return max_socket_buffer;
+    return value;
+  }
+
+  void
+  print_histogram (Profile const &profile, Profile::Metric metric)
+  {
+    Histogram const &h = profile.histogram (metric);
+    ACE_UINT64 const n = h.samples_count ();
+
+    ACE_OS::printf ("%-22s %12s", Profile::name (metric), Number (n).c_str ());
+
+    if (n == 0)
+      {
+        ACE_OS::printf ("\n");
+        return;
+      }
+
+    ACE_OS::printf (" %12s %12s %12s %12s %12s\n",
+                    Number (static_cast<ACE_UINT64> (h.mean ())).c_str (),
+                    Number (h.percentile (50.0)).c_str (),
+                    Number (h.percentile (99.0)).c_str (),
+                    Number (h.percentile (99.9)).c_str (),
+                    Number (h.max ()).c_str ());
+  }
+}
+
+int
+ACE_TMAIN (int argc, ACE_TCHAR *argv[])
+{
+  ACE_Get_Opt get_opt (argc, argv, ACE_TEXT ("q"));
+  bool quiet = false;
+  int opt;
+
+  while ((opt = get_opt ()) != EOF)
+    {
+      switch (opt)
+        {
+        case 'q':
+          quiet = true;
+          break;
+        case '?':
+        default:
+          ACE_ERROR_RETURN ((LM_ERROR,
+                             "Usage: %s [-q] <profile> [<profile> ...]\n"
+                             "  -q  only print the suggested options\n",
+                             argv[0]),
+                            1);
+        }
+    }
+
+  if (get_opt.opt_ind () == argc)
+    ACE_ERROR_RETURN ((LM_ERROR,
+                       "Usage: %s [-q] <profile> [<profile> ...]\n",
+                       argv[0]),
+                      1);
+
+  // The profiles of several processes, or runs, add up.
+  Profile profile;
+
+  for (int i = get_opt.opt_ind (); i != argc; ++i)
+    {
+      FILE *file = ACE_OS::fopen (argv[i], ACE_TEXT ("r"));
+
+      if (file == 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "Cannot open <%s>\n",
+                           argv[i]),
+                          1);
+
+      int const result = profile.read (file);
+      ACE_OS::fclose (file);
+
+      if (result != 0)
+        ACE_ERROR_RETURN ((LM_ERROR,
+                           "<%s> is not a transport profile\n",
+                           argv[i]),
+                          1);
+    }
+
+  if (!quiet)
+    {
+      ACE_OS::printf ("transports %s, at most %s at the same time\n\n",
+                      Number (profile.transports ()).c_str (),
+                      Number (profile.peak_transports ()).c_str ());
+
+      ACE_OS::printf ("%-22s %12s %12s %12s %12s %12s %12s\n",
+                      "", "samples", "mean", "p50", "p99", "p99.9", "max");
+
+      for (int m = 0; m != Profile::METRICS; ++m)
+        print_histogram (profile, static_cast<Profile::Metric> (m));
+
+      ACE_OS::printf ("\n");
+      ACE_OS::printf ("replies waited for: %s on read, %s on leader/follower, "
+                      "%s on the reactor\n",
+                      Number (profile.counter (Profile::READ_WAITS)).c_str (),
+                      Number (profile.counter (
+                        Profile::LEADER_FOLLOWER_WAITS)).c_str (),
+                      Number (profile.counter (
+                        Profile::REACTOR_WAITS)).c_str ());
+      ACE_OS::printf ("BiDir transports %s, nested upcalls %s\n\n",
+                      Number (profile.counter (
+                        Profile::BIDIR_TRANSPORTS)).c_str (),
+                      Number (profile.counter (
+                        Profile::NESTED_UPCALLS)).c_str ());
+    }
+
+  Histogram const &sent = profile.histogram (Profile::SENT_MESSAGE_SIZE);
+  Histogram const &received =
+    profile.histogram (Profile::RECEIVED_MESSAGE_SIZE);
+  Histogram const &queue = profile.histogram (Profile::QUEUE_DEPTH);
+  Histogram const &wait = profile.histogram (Profile::REPLY_WAIT_TIME);
+
+  int suggestions = 0;
+
+  // Room for the messages that queue up at the same time, so a flush
+  // usually completes in a single write.
+  if (sent.samples_count () != 0)
+    {
+      ACE_UINT64 const depth =
+        queue.samples_count () != 0 && queue.percentile (99.0) > 1
+        ? queue.percentile (99.0) : 1;
+      ACE_UINT64 const size =
+        clamp (round_up (sent.percentile (99.0) * depth));
+
+      if (size != profile.setting (Profile::SNDSOCK))
+        {
+          ACE_OS::printf ("-ORBSndSock %s\n", Number (size).c_str ());
+          ++suggestions;
+        }
+    }
+
+  // Room for two of the usual messages, so one can be read while the
+  // next comes in.
+  if (received.samples_count () != 0)
+    {
+      ACE_UINT64 const size =
+        clamp (round_up (received.percentile (99.0) * 2));
+
+      if (size != profile.setting (Profile::RCVSOCK))
+        {
+          ACE_OS::printf ("-ORBRcvSock %s\n", Number (size).c_str ());
+          ++suggestions;
+        }
+    }
+
+  // A few huge messages among small ones hold up the small ones
+  // unless they are sent in fragments.
+  if (profile.setting (Profile::MAX_MESSAGE_SIZE) == 0
+      && sent.max () > large_message
+      && sent.percentile (99.0) * 4 < sent.max ())
+    {
+      ACE_UINT64 size = round_up (sent.percentile (99.0));
+      if (size < min_socket_buffer)
+        size = min_socket_buffer;
+
+      ACE_OS::printf ("-ORBMaxMessageSize %s\n", Number (size).c_str ());
+      ++suggestions;
+    }
+
+  // Replies that come back within microseconds are cheaper to poll
+  // for than to sleep on, which only the RW wait strategy does.
+  if (wait.samples_count () != 0 && wait.percentile (50.0) < quick_reply)
+    {
+      ACE_UINT64 const spin = wait.percentile (90.0) * 2;
+      ACE_UINT64 const read_waits = profile.counter (Profile::READ_WAITS);
+
+      if (read_waits == wait.samples_count ())
+        {
+          // Already waiting on read, so only the polling is missing.
+          if (profile.setting (Profile::WAIT_SPIN_TIME) < spin)
+            {
+              ACE_OS::printf ("static Client_Strategy_Factory "
+                              "\"-ORBWaitStrategy rw -ORBWaitSpinTime %s\"\n",
+                              Number (spin).c_str ());
+              ++suggestions;
+            }
+        }
+      else if (!quiet)
+        {
+          // Switching to RW changes how the application behaves, so
+          // that is left to whoever knows it.
+          ACE_OS::printf ("Replies usually come back within %s usecs.  "
+                          "Polling for them needs\n"
+                          "-ORBWaitStrategy rw -ORBWaitSpinTime %s, but a "
+                          "thread that waits on read\n"
+                          "handles no other request: RW cannot be used with "
+                          "BiDir GIOP or nested\n"
+                          "upcalls, needs -ORBTransportMuxStrategy EXCLUSIVE "
+                          "and -ORBFlushingStrategy\n"
+                          "blocking, and only helps synchronous two way "
+                          "calls.\n",
+                          Number (wait.percentile (50.0)).c_str (),
+                          Number (spin).c_str ());
+
+          if (profile.counter (Profile::BIDIR_TRANSPORTS) != 0
+              || profile.counter (Profile::NESTED_UPCALLS) != 0)
+            ACE_OS::printf ("This application uses BiDir GIOP or takes "
+                            "nested upcalls, so RW does not suit it.\n");
+
+          ACE_OS::printf ("\n");
+        }
+    }
+
+  // Headroom above the most connections seen at the same time, so
+  // the cache is not purged under the usual load.
+  ACE_UINT64 const cache_max =
+    profile.setting (Profile::CONNECTION_CACHE_MAX);
+  if (cache_max != 0 && profile.peak_transports () * 4 > cache_max * 3)
+    {
+      ACE_OS::printf ("static Resource_Factory \"-ORBConnectionCacheMax %s\"\n",
+                      Number (profile.peak_transports () * 2).c_str ());
+      ++suggestions;
+    }
+
+  if (suggestions == 0 && !quiet)
+    ACE_OS::printf ("The ORB options suit this profile\n");
+
+  return 0;
+}
+
+#else
+
+int
+ACE_TMAIN (int, ACE_TCHAR *argv[])
+{
+  ACE_ERROR_RETURN ((LM_ERROR,
+                     "%s: TAO was built without TAO_HAS_TRANSPORT_PROFILE\n",
+                     argv[0]),
+                    1);
+}
+
+#endif /* TAO_HAS_TRANSPORT_PROFILE == 1 */